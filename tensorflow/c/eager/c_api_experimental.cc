@@ -51,6 +51,33 @@ void TFE_OpReset(TFE_Op* op_to_reset, const char* op_or_function_name,
   }
 }
 
+void TFE_ExecuteBatch(TFE_Op** ops, int num_ops, TFE_TensorHandle*** retvals,
+                      int* num_retvals, TF_Status* status) {
+  if (ops == nullptr) {
+    TF_SetStatus(status, TF_INVALID_ARGUMENT, "ops should not be nullptr");
+    return;
+  }
+  TF_SetStatus(status, TF_OK, "");
+  for (int i = 0; i < num_ops; ++i) {
+    if (ops[i] == nullptr) {
+      TF_SetStatus(status, TF_INVALID_ARGUMENT,
+                   tensorflow::strings::StrCat("op ", i, " of ", num_ops,
+                                               " should not be nullptr")
+                       .c_str());
+      return;
+    }
+    TFE_Execute(ops[i], retvals[i], &num_retvals[i], status);
+    if (TF_GetCode(status) != TF_OK) {
+      status->status = tensorflow::Status(
+          status->status.code(),
+          tensorflow::strings::StrCat("Failed to execute op ", i, " of ",
+                                      num_ops, " in the batch: ",
+                                      status->status.error_message()));
+      return;
+    }
+  }
+}
+
 void TFE_ContextEnableGraphCollection(TFE_Context* ctx) {
   tensorflow::unwrap(ctx)->SetShouldStoreGraphs(true);
 }
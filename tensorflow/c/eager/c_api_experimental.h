@@ -34,6 +34,21 @@ TF_CAPI_EXPORT extern void TFE_OpReset(TFE_Op* op_to_reset,
                                        const char* raw_device_name,
                                        TF_Status* status);
 
+// Executes `num_ops` prepared ops in submission order with a single call
+// across the C API boundary, so that language bindings can amortize their
+// per-call overhead over many ops. `ops[i]` behaves exactly as if it were
+// passed to TFE_Execute with `retvals[i]` and `num_retvals[i]`: on input
+// `num_retvals[i]` is the capacity of `retvals[i]` and on success it is set
+// to the actual number of outputs. If an op fails, `status` is set to that
+// op's error (annotated with the op's position in the batch) and the
+// remaining ops are not executed; outputs of the ops before the failing one
+// remain valid. Ops may be reused across batches with TFE_OpReset, and
+// `status` may be reused without resetting.
+TF_CAPI_EXPORT extern void TFE_ExecuteBatch(TFE_Op** ops, int num_ops,
+                                            TFE_TensorHandle*** retvals,
+                                            int* num_retvals,
+                                            TF_Status* status);
+
 // Enables only graph collection in RunMetadata on the functions executed from
 // this context.
 TF_CAPI_EXPORT extern void TFE_ContextEnableGraphCollection(TFE_Context* ctx);
@@ -364,6 +364,45 @@ void Executor_MatMul_CPU(bool async) {
 TEST(CAPI, Executor_MatMul_CPU) { Executor_MatMul_CPU(false); }
 TEST(CAPI, Executor_MatMul_CPUAsync) { Executor_MatMul_CPU(true); }
 
+TEST(CAPI, ExecuteBatch_MatMul_CPU) {
+  TF_Status* status = TF_NewStatus();
+  TFE_ContextOptions* opts = TFE_NewContextOptions();
+  TFE_Context* ctx = TFE_NewContext(opts, status);
+  CHECK_EQ(TF_OK, TF_GetCode(status)) << TF_Message(status);
+  TFE_DeleteContextOptions(opts);
+
+  TFE_TensorHandle* m = TestMatrixTensorHandle(ctx);
+  TFE_Op* ops[2] = {MatMulOp(ctx, m, m), MatMulOp(ctx, m, m)};
+  TFE_TensorHandle* first_retvals[1] = {nullptr};
+  TFE_TensorHandle* second_retvals[1] = {nullptr};
+  TFE_TensorHandle** retvals[2] = {first_retvals, second_retvals};
+  int num_retvals[2] = {1, 1};
+  TFE_ExecuteBatch(ops, 2, retvals, num_retvals, status);
+  ASSERT_EQ(TF_OK, TF_GetCode(status)) << TF_Message(status);
+  EXPECT_EQ(1, num_retvals[0]);
+  EXPECT_EQ(1, num_retvals[1]);
+  TFE_DeleteOp(ops[0]);
+  TFE_DeleteOp(ops[1]);
+  TFE_DeleteTensorHandle(m);
+
+  for (int i = 0; i < 2; ++i) {
+    TF_Tensor* t = TFE_TensorHandleResolve(retvals[i][0], status);
+    ASSERT_EQ(TF_OK, TF_GetCode(status)) << TF_Message(status);
+    TFE_DeleteTensorHandle(retvals[i][0]);
+    float product[4] = {0};
+    EXPECT_EQ(sizeof(product), TF_TensorByteSize(t));
+    memcpy(&product[0], TF_TensorData(t), TF_TensorByteSize(t));
+    TF_DeleteTensor(t);
+    EXPECT_EQ(7, product[0]);
+    EXPECT_EQ(10, product[1]);
+    EXPECT_EQ(15, product[2]);
+    EXPECT_EQ(22, product[3]);
+  }
+
+  TFE_DeleteContext(ctx);
+  TF_DeleteStatus(status);
+}
+
 void Deleter(void* data, size_t unused, void* tensor_handle) {
   TFE_DeleteTensorHandle(static_cast<TFE_TensorHandle*>(tensor_handle));
 }
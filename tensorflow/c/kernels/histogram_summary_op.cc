@@ -10,8 +10,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <atomic>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/c/kernels.h"
@@ -22,11 +25,14 @@ limitations under the License.
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/histogram/histogram.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/tstring.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace {
 
@@ -43,10 +49,39 @@ struct TFStatusDeleter {
 using Safe_TF_TensorPtr = std::unique_ptr<TF_Tensor, TFTensorDeleter>;
 using Safe_TF_StatusPtr = std::unique_ptr<TF_Status, TFStatusDeleter>;
 
+// Setting TF_HISTOGRAM_SUMMARY_SAMPLE_RATE=N (N > 1) switches the kernel to
+// an asynchronous sampled mode: every Nth invocation hands the values tensor
+// to a background closure that computes the histogram, and every invocation
+// emits the most recently completed histogram instead of computing one
+// inline.  The hot path is then a reference push plus a cached proto copy,
+// which keeps summary collection off the step critical path.  Returns 0 when
+// the mode is disabled.
+int64_t SampleRateFromEnv() {
+  int64_t sample_rate;
+  tensorflow::Status status = tensorflow::ReadInt64FromEnvVar(
+      "TF_HISTOGRAM_SUMMARY_SAMPLE_RATE", /*default_val=*/0, &sample_rate);
+  if (!status.ok()) {
+    LOG(ERROR) << "HistogramSummary: " << status.error_message();
+    return 0;
+  }
+  return sample_rate > 1 ? sample_rate : 0;
+}
+
+// The serialized Summary from the most recently completed background
+// histogram.  Shared between the kernel and in-flight closures so that a
+// closure outliving the kernel writes into valid memory.
+struct CachedSummary {
+  tensorflow::mutex mu;
+  tensorflow::tstring serialized TF_GUARDED_BY(mu);
+};
+
 // Used to pass the operation node name from kernel construction to
 // kernel computation.
 struct HistogramSummaryOp {
   std::string op_node_name;
+  int64_t sample_rate = 0;
+  std::atomic<int64_t> num_calls{0};
+  std::shared_ptr<CachedSummary> cache;
 };
 
 void* HistogramSummaryOp_Create(TF_OpKernelConstruction* ctx) {
@@ -54,6 +89,11 @@ void* HistogramSummaryOp_Create(TF_OpKernelConstruction* ctx) {
   TF_StringView string_view_name = TF_OpKernelConstruction_GetName(ctx);
   kernel->op_node_name =
       std::string(string_view_name.data, string_view_name.len);
+  static const int64_t sample_rate = SampleRateFromEnv();
+  kernel->sample_rate = sample_rate;
+  if (sample_rate > 0) {
+    kernel->cache = std::make_shared<CachedSummary>();
+  }
   return kernel;
 }
 
@@ -61,6 +101,39 @@ void HistogramSummaryOp_Delete(void* kernel) {
   delete static_cast<HistogramSummaryOp*>(kernel);
 }
 
+// Builds the serialized Summary proto for `values` under `tag`.  On failure
+// (non-finite input) fills `error` and returns false.
+template <typename T>
+bool ComputeHistogramSummary(const TF_Tensor* values, const std::string& tag,
+                             const std::string& op_node_name,
+                             tensorflow::tstring* serialized,
+                             std::string* error) {
+  // Cast values to array to access tensor elements by index
+  auto values_array = static_cast<const T*>(TF_TensorData(values));
+  tensorflow::histogram::Histogram histo;
+  for (int64_t i = 0; i < TF_TensorElementCount(values); ++i) {
+    const double double_val = static_cast<double>(values_array[i]);
+    if (Eigen::numext::isnan(double_val)) {
+      std::ostringstream err;
+      err << "Nan in summary histogram for: " << op_node_name;
+      *error = err.str();
+      return false;
+    } else if (Eigen::numext::isinf(double_val)) {
+      std::ostringstream err;
+      err << "Infinity in Histogram for: " << op_node_name;
+      *error = err.str();
+      return false;
+    }
+    histo.Add(double_val);
+  }
+  tensorflow::Summary s;
+  tensorflow::Summary::Value* v = s.add_value();
+  v->set_tag(tag.data(), tag.size());
+  histo.EncodeToProto(v->mutable_histo(), false /* Drop zero buckets */);
+  CHECK(SerializeToTString(s, serialized));
+  return true;
+}
+
 template <typename T>
 void HistogramSummaryOp_Compute(void* kernel, TF_OpKernelContext* ctx) {
   HistogramSummaryOp* k = static_cast<HistogramSummaryOp*>(kernel);
@@ -84,32 +157,50 @@ void HistogramSummaryOp_Compute(void* kernel, TF_OpKernelContext* ctx) {
     TF_OpKernelContext_Failure(ctx, status.get());
     return;
   }
-  // Cast values to array to access tensor elements by index
-  auto values_array = static_cast<T*>(TF_TensorData(safe_values_ptr.get()));
-  tensorflow::histogram::Histogram histo;
-  for (int64_t i = 0; i < TF_TensorElementCount(safe_values_ptr.get()); ++i) {
-    const double double_val = static_cast<double>(values_array[i]);
-    if (Eigen::numext::isnan(double_val)) {
-      std::ostringstream err;
-      err << "Nan in summary histogram for: " << k->op_node_name;
-      TF_SetStatus(status.get(), TF_INVALID_ARGUMENT, err.str().c_str());
-      TF_OpKernelContext_Failure(ctx, status.get());
-      return;
-    } else if (Eigen::numext::isinf(double_val)) {
-      std::ostringstream err;
-      err << "Infinity in Histogram for: " << k->op_node_name;
-      TF_SetStatus(status.get(), TF_INVALID_ARGUMENT, err.str().c_str());
+  const tensorflow::tstring& tag =
+      *(static_cast<tensorflow::tstring*>(TF_TensorData(safe_tags_ptr.get())));
+
+  tensorflow::tstring serialized;
+  if (k->sample_rate > 0) {
+    if (k->num_calls.fetch_add(1) % k->sample_rate == 0) {
+      // Hand the values tensor to a background closure.  The TF_Tensor holds
+      // a reference on the underlying buffer, so no copy of the data is made
+      // and a concurrent writer would trigger the usual copy-on-write.  A
+      // non-finite input cannot fail the step it was recorded in anymore, so
+      // it is reported as a warning and the sample is dropped.
+      TF_Tensor* values_ref = safe_values_ptr.release();
+      std::shared_ptr<CachedSummary> cache = k->cache;
+      std::string tag_copy(tag.data(), tag.size());
+      std::string op_node_name = k->op_node_name;
+      tensorflow::Env::Default()->SchedClosure(
+          [values_ref, cache, tag_copy, op_node_name]() {
+            Safe_TF_TensorPtr values(values_ref);
+            tensorflow::tstring serialized;
+            std::string error;
+            if (!ComputeHistogramSummary<T>(values.get(), tag_copy,
+                                            op_node_name, &serialized,
+                                            &error)) {
+              LOG(WARNING) << error;
+              return;
+            }
+            tensorflow::mutex_lock l(cache->mu);
+            cache->serialized = std::move(serialized);
+          });
+    }
+    // Emit the most recently completed histogram; empty until the first
+    // sampled computation finishes.
+    tensorflow::mutex_lock l(k->cache->mu);
+    serialized = k->cache->serialized;
+  } else {
+    std::string tag_copy(tag.data(), tag.size());
+    std::string error;
+    if (!ComputeHistogramSummary<T>(safe_values_ptr.get(), tag_copy,
+                                    k->op_node_name, &serialized, &error)) {
+      TF_SetStatus(status.get(), TF_INVALID_ARGUMENT, error.c_str());
       TF_OpKernelContext_Failure(ctx, status.get());
       return;
     }
-    histo.Add(double_val);
   }
-  tensorflow::Summary s;
-  tensorflow::Summary::Value* v = s.add_value();
-  const tensorflow::tstring& tag =
-      *(static_cast<tensorflow::tstring*>(TF_TensorData(safe_tags_ptr.get())));
-  v->set_tag(tag.data(), tag.size());
-  histo.EncodeToProto(v->mutable_histo(), false /* Drop zero buckets */);
 
   Safe_TF_TensorPtr summary_tensor(TF_AllocateOutput(
       /*context=*/ctx, /*index=*/0, /*dtype=*/TF_ExpectedOutputDataType(ctx, 0),
@@ -122,7 +213,7 @@ void HistogramSummaryOp_Compute(void* kernel, TF_OpKernelContext* ctx) {
   }
   tensorflow::tstring* output_tstring = reinterpret_cast<tensorflow::tstring*>(
       TF_TensorData(summary_tensor.get()));
-  CHECK(SerializeToTString(s, output_tstring));
+  *output_tstring = std::move(serialized);
 }
 
 template <typename T>
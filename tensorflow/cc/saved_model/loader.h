@@ -123,6 +123,22 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundle* const bundle);
 
+/// Like the above, but prunes the MetaGraphDef to the signatures named in
+/// `signature_keys` before the session is created: graph nodes that are not
+/// reachable from those signatures (or from the init op) are dropped, and
+/// only checkpoint values feeding the surviving variables are restored. For
+/// models that carry signatures that are not served (e.g. unserved heads of a
+/// multi-head model) this reduces both load time and memory footprint.
+/// Signatures absent from `signature_keys` are not available in the result.
+///
+/// Returns FAILED_PRECONDITION if the model's saver layout does not support
+/// pruning; such models must be loaded with the unpruned overload.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundle* const bundle);
+
 /// Loads a SavedModel from the specified export directory. The MetaGraphDef
 /// to be loaded is identified by the supplied tags, corresponding exactly to
 /// the set of tags used at SavedModel build time. Stores a SavedModel bundle
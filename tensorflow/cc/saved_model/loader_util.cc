@@ -15,11 +15,18 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/loader_util.h"
 
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "tensorflow/cc/saved_model/constants.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/protobuf_internal.h"
 
 namespace tensorflow {
@@ -91,5 +98,329 @@ Status GetAssetFileDefs(const MetaGraphDef& meta_graph_def,
   return OkStatus();
 }
 
+namespace {
+
+// Returns the node name from an input name in a NodeDef, i.e. strips a "^"
+// control-dependency prefix and a ":<port>" suffix.
+string NodeNameFromInput(const string& input_name) {
+  size_t start = (!input_name.empty() && input_name[0] == '^') ? 1 : 0;
+  size_t end = input_name.rfind(':');
+  if (end == string::npos || end < start) end = input_name.size();
+  return input_name.substr(start, end - start);
+}
+
+// Returns the output port referenced by an input name, or -1 for a control
+// dependency.
+int OutputPortFromInput(const string& input_name) {
+  if (!input_name.empty() && input_name[0] == '^') return -1;
+  size_t pos = input_name.rfind(':');
+  if (pos == string::npos) return 0;
+  int port = 0;
+  for (size_t i = pos + 1; i < input_name.size(); ++i) {
+    port = port * 10 + (input_name[i] - '0');
+  }
+  return port;
+}
+
+// Adds the node names a TensorInfo refers to (covering the dense, sparse and
+// composite encodings) to `node_names`.
+void CollectTensorInfoNodes(const TensorInfo& tensor_info,
+                            std::unordered_set<string>* node_names) {
+  switch (tensor_info.encoding_case()) {
+    case TensorInfo::kName:
+      node_names->insert(NodeNameFromInput(tensor_info.name()));
+      break;
+    case TensorInfo::kCooSparse:
+      node_names->insert(
+          NodeNameFromInput(tensor_info.coo_sparse().values_tensor_name()));
+      node_names->insert(
+          NodeNameFromInput(tensor_info.coo_sparse().indices_tensor_name()));
+      node_names->insert(NodeNameFromInput(
+          tensor_info.coo_sparse().dense_shape_tensor_name()));
+      break;
+    case TensorInfo::kCompositeTensor:
+      for (const auto& component : tensor_info.composite_tensor().components()) {
+        node_names->insert(NodeNameFromInput(component.name()));
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+bool IsVariableOp(const string& op) {
+  return op == "VariableV2" || op == "Variable" || op == "VarHandleOp";
+}
+
+// Adds `seeds` and every node reachable from them through (data and control)
+// inputs to `keep`.
+Status AddBackwardClosure(
+    const std::unordered_set<string>& seeds,
+    const std::unordered_map<string, const NodeDef*>& nodes_by_name,
+    std::unordered_set<string>* keep) {
+  std::deque<string> queue(seeds.begin(), seeds.end());
+  while (!queue.empty()) {
+    const string name = queue.front();
+    queue.pop_front();
+    if (!keep->insert(name).second) continue;
+    const auto it = nodes_by_name.find(name);
+    if (it == nodes_by_name.end()) {
+      return errors::FailedPrecondition(
+          "Signature or saver references unknown graph node: ", name);
+    }
+    for (const string& input : it->second->input()) {
+      queue.push_back(NodeNameFromInput(input));
+    }
+  }
+  return OkStatus();
+}
+
+// Rewrites a string Const node (a RestoreV2 tensor_names or shape_and_slices
+// input) so that only the entries at `used` old indices remain. Returns false
+// if the node does not have the expected form.
+bool NarrowStringConst(NodeDef* node, const std::vector<int>& old_to_new,
+                       int num_used) {
+  if (node->op() != "Const") return false;
+  auto it = node->mutable_attr()->find("value");
+  if (it == node->mutable_attr()->end() || !it->second.has_tensor()) {
+    return false;
+  }
+  TensorProto* tensor = it->second.mutable_tensor();
+  if (tensor->string_val_size() != static_cast<int>(old_to_new.size())) {
+    return false;
+  }
+  protobuf::RepeatedPtrField<string> narrowed;
+  for (int i = 0; i < tensor->string_val_size(); ++i) {
+    if (old_to_new[i] >= 0) *narrowed.Add() = tensor->string_val(i);
+  }
+  tensor->mutable_string_val()->Swap(&narrowed);
+  if (tensor->tensor_shape().dim_size() == 1) {
+    tensor->mutable_tensor_shape()->mutable_dim(0)->set_size(num_used);
+  }
+  return true;
+}
+
+}  // namespace
+
+Status PruneMetaGraphDef(const std::unordered_set<string>& signature_keys,
+                         const string& export_dir,
+                         MetaGraphDef* meta_graph_def,
+                         std::vector<string>* variable_restore_ops) {
+  variable_restore_ops->clear();
+  GraphDef* graph_def = meta_graph_def->mutable_graph_def();
+
+  std::unordered_map<string, const NodeDef*> nodes_by_name;
+  std::unordered_map<string, int> node_index_by_name;
+  nodes_by_name.reserve(graph_def->node_size());
+  for (int i = 0; i < graph_def->node_size(); ++i) {
+    const NodeDef& node = graph_def->node(i);
+    nodes_by_name[node.name()] = &node;
+    node_index_by_name[node.name()] = i;
+  }
+
+  // Seed the closure with the requested signatures' inputs and outputs, the
+  // init op, and the asset feed tensors.
+  std::unordered_set<string> seeds;
+  for (const string& key : signature_keys) {
+    const auto it = meta_graph_def->signature_def().find(key);
+    if (it == meta_graph_def->signature_def().end()) {
+      return errors::NotFound("Could not find SignatureDef with key: ", key);
+    }
+    for (const auto& input : it->second.inputs()) {
+      CollectTensorInfoNodes(input.second, &seeds);
+    }
+    for (const auto& output : it->second.outputs()) {
+      CollectTensorInfoNodes(output.second, &seeds);
+    }
+  }
+  string init_op_name;
+  TF_RETURN_IF_ERROR(GetInitOp(export_dir, *meta_graph_def, &init_op_name));
+  if (!init_op_name.empty()) {
+    seeds.insert(NodeNameFromInput(init_op_name));
+  }
+  std::vector<AssetFileDef> asset_file_defs;
+  TF_RETURN_IF_ERROR(GetAssetFileDefs(*meta_graph_def, &asset_file_defs));
+  for (const AssetFileDef& asset : asset_file_defs) {
+    seeds.insert(NodeNameFromInput(asset.tensor_info().name()));
+  }
+
+  std::unordered_set<string> keep;
+  TF_RETURN_IF_ERROR(AddBackwardClosure(seeds, nodes_by_name, &keep));
+
+  // Locate the saver's per-variable restore nodes for surviving variables:
+  // Assign/AssignVariableOp nodes outside the serving closure whose variable
+  // input survived and whose value comes from a RestoreV2 (possibly through
+  // an Identity).
+  bool any_kept_variable = false;
+  for (const string& name : keep) {
+    if (IsVariableOp(nodes_by_name[name]->op())) {
+      any_kept_variable = true;
+      break;
+    }
+  }
+  std::unordered_set<string> restore_seeds;
+  for (const NodeDef& node : graph_def->node()) {
+    if (node.op() != "Assign" && node.op() != "AssignVariableOp") continue;
+    if (keep.count(node.name()) > 0) continue;
+    if (node.input_size() < 2) continue;
+    const string variable_name = NodeNameFromInput(node.input(0));
+    const auto var_it = nodes_by_name.find(variable_name);
+    if (keep.count(variable_name) == 0 || var_it == nodes_by_name.end() ||
+        !IsVariableOp(var_it->second->op())) {
+      continue;
+    }
+    auto value_it = nodes_by_name.find(NodeNameFromInput(node.input(1)));
+    if (value_it == nodes_by_name.end()) continue;
+    const NodeDef* value_node = value_it->second;
+    if (value_node->op() == "Identity" && value_node->input_size() >= 1) {
+      value_it = nodes_by_name.find(NodeNameFromInput(value_node->input(0)));
+      if (value_it == nodes_by_name.end()) continue;
+      value_node = value_it->second;
+    }
+    if (value_node->op() != "RestoreV2") continue;
+    restore_seeds.insert(node.name());
+    variable_restore_ops->push_back(node.name());
+  }
+  if (restore_seeds.empty() && any_kept_variable &&
+      meta_graph_def->has_saver_def()) {
+    return errors::FailedPrecondition(
+        "Could not locate per-variable restore ops in the saver subgraph; "
+        "pruned loading supports standard Saver layouts only. Load the "
+        "SavedModel without signature pruning instead.");
+  }
+  TF_RETURN_IF_ERROR(AddBackwardClosure(restore_seeds, nodes_by_name, &keep));
+
+  // For every surviving RestoreV2 node, narrow its tensor_names and
+  // shape_and_slices inputs to the outputs that are actually consumed, so
+  // that entries for pruned variables are not read from the checkpoint. If a
+  // node does not match the standard saver layout it is left untouched, which
+  // is correct but restores more than necessary.
+  std::unordered_map<string, std::vector<int>> restore_remap;
+  std::unordered_map<string, std::unordered_set<int>> used_ports;
+  std::unordered_map<string, int> const_consumers;
+  for (const string& name : keep) {
+    const NodeDef* node = nodes_by_name[name];
+    for (const string& input : node->input()) {
+      const string input_node = NodeNameFromInput(input);
+      if (keep.count(input_node) == 0) continue;
+      const NodeDef* producer = nodes_by_name[input_node];
+      if (producer->op() == "RestoreV2") {
+        const int port = OutputPortFromInput(input);
+        if (port >= 0) used_ports[input_node].insert(port);
+      } else if (producer->op() == "Const") {
+        ++const_consumers[input_node];
+      }
+    }
+  }
+  for (const string& name : keep) {
+    if (nodes_by_name[name]->op() != "RestoreV2") continue;
+    NodeDef* node = graph_def->mutable_node(node_index_by_name[name]);
+    auto dtypes_it = node->mutable_attr()->find("dtypes");
+    if (dtypes_it == node->mutable_attr()->end()) continue;
+    AttrValue::ListValue* dtypes = dtypes_it->second.mutable_list();
+    const int num_outputs = dtypes->type_size();
+    const std::unordered_set<int>& used = used_ports[name];
+    if (static_cast<int>(used.size()) >= num_outputs) continue;
+    if (node->input_size() < 3) continue;
+    const string tensor_names_node = NodeNameFromInput(node->input(1));
+    const string shape_and_slices_node = NodeNameFromInput(node->input(2));
+    if (const_consumers[tensor_names_node] != 1 ||
+        const_consumers[shape_and_slices_node] != 1) {
+      LOG(WARNING) << "RestoreV2 node " << name
+                   << " shares its tensor_names input; not narrowing it.";
+      continue;
+    }
+    std::vector<int> old_to_new(num_outputs, -1);
+    int num_used = 0;
+    for (int i = 0; i < num_outputs; ++i) {
+      if (used.count(i) > 0) old_to_new[i] = num_used++;
+    }
+    NodeDef* tensor_names =
+        graph_def->mutable_node(node_index_by_name[tensor_names_node]);
+    NodeDef* shape_and_slices =
+        graph_def->mutable_node(node_index_by_name[shape_and_slices_node]);
+    if (!NarrowStringConst(tensor_names, old_to_new, num_used) ||
+        !NarrowStringConst(shape_and_slices, old_to_new, num_used)) {
+      LOG(WARNING) << "RestoreV2 node " << name
+                   << " does not have the standard saver layout; not "
+                      "narrowing it.";
+      continue;
+    }
+    protobuf::RepeatedField<int> narrowed_types;
+    for (int i = 0; i < num_outputs; ++i) {
+      if (old_to_new[i] >= 0) narrowed_types.Add(dtypes->type(i));
+    }
+    dtypes->mutable_type()->Swap(&narrowed_types);
+    auto shapes_it = node->mutable_attr()->find("_output_shapes");
+    if (shapes_it != node->mutable_attr()->end() &&
+        shapes_it->second.list().shape_size() == num_outputs) {
+      AttrValue narrowed_shapes;
+      for (int i = 0; i < num_outputs; ++i) {
+        if (old_to_new[i] >= 0) {
+          *narrowed_shapes.mutable_list()->add_shape() =
+              shapes_it->second.list().shape(i);
+        }
+      }
+      shapes_it->second = narrowed_shapes;
+    }
+    restore_remap[name].swap(old_to_new);
+  }
+
+  // Rebuild the node list with only the kept nodes, renumbering references to
+  // narrowed RestoreV2 outputs and dropping colocation constraints on pruned
+  // nodes.
+  protobuf::RepeatedPtrField<NodeDef> kept_nodes;
+  for (NodeDef& node : *graph_def->mutable_node()) {
+    if (keep.count(node.name()) == 0) continue;
+    for (string& input : *node.mutable_input()) {
+      const auto remap_it = restore_remap.find(NodeNameFromInput(input));
+      if (remap_it == restore_remap.end()) continue;
+      const int port = OutputPortFromInput(input);
+      if (port < 0) continue;
+      const int new_port = remap_it->second[port];
+      input = new_port == 0
+                  ? remap_it->first
+                  : strings::StrCat(remap_it->first, ":", new_port);
+    }
+    auto class_it = node.mutable_attr()->find("_class");
+    if (class_it != node.mutable_attr()->end()) {
+      AttrValue narrowed_class;
+      for (const string& loc : class_it->second.list().s()) {
+        if (loc.compare(0, 5, "loc:@") != 0 || keep.count(loc.substr(5)) > 0) {
+          narrowed_class.mutable_list()->add_s(loc);
+        }
+      }
+      if (narrowed_class.list().s_size() == 0) {
+        node.mutable_attr()->erase("_class");
+      } else {
+        class_it->second = narrowed_class;
+      }
+    }
+    *kept_nodes.Add() = std::move(node);
+  }
+  graph_def->mutable_node()->Swap(&kept_nodes);
+
+  // Drop the signatures that are not being served and prune node references
+  // to removed nodes from the collections.
+  auto* signature_defs = meta_graph_def->mutable_signature_def();
+  for (auto it = signature_defs->begin(); it != signature_defs->end();) {
+    if (signature_keys.count(it->first) == 0 &&
+        it->first != kSavedModelInitOpSignatureKey) {
+      it = signature_defs->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto& collection : *meta_graph_def->mutable_collection_def()) {
+    if (!collection.second.has_node_list()) continue;
+    protobuf::RepeatedPtrField<string> kept_values;
+    for (const string& value : collection.second.node_list().value()) {
+      if (keep.count(NodeNameFromInput(value)) > 0) *kept_values.Add() = value;
+    }
+    collection.second.mutable_node_list()->mutable_value()->Swap(&kept_values);
+  }
+  return OkStatus();
+}
+
 }  // namespace internal
 }  // namespace tensorflow
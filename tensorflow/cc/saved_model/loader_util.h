@@ -17,6 +17,8 @@ limitations under the License.
 #define TENSORFLOW_CC_SAVED_MODEL_LOADER_UTIL_H_
 
 #include <string>
+#include <unordered_set>
+#include <vector>
 
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
@@ -33,6 +35,26 @@ Status GetInitOp(const string& export_dir, const MetaGraphDef& meta_graph_def,
 Status GetAssetFileDefs(const MetaGraphDef& meta_graph_def,
                         std::vector<AssetFileDef>* asset_file_defs);
 
+// Prunes `meta_graph_def` to the closure of the signatures named in
+// `signature_keys`: only graph nodes reachable from those signatures' inputs
+// and outputs (plus the init op and asset feeds) are kept, and the saver's
+// restore subgraph is rewritten so that only checkpoint entries feeding
+// surviving variables are read. Signatures that were not requested are
+// removed from the signature def map. Where the saver layout allows, the
+// restore subgraph is additionally narrowed so that only checkpoint entries
+// feeding surviving variables are read from disk. On success,
+// `variable_restore_ops` is filled with the names of the per-variable restore
+// nodes that must be run in place of the saver's restore op; the pruned graph
+// no longer contains the original restore op.
+//
+// Returns FAILED_PRECONDITION if the saver layout is not recognized (i.e. the
+// per-variable restore nodes cannot be located); such models must be loaded
+// unpruned.
+Status PruneMetaGraphDef(const std::unordered_set<string>& signature_keys,
+                         const string& export_dir,
+                         MetaGraphDef* meta_graph_def,
+                         std::vector<string>* variable_restore_ops);
+
 }  // namespace internal
 }  // namespace tensorflow
 
@@ -174,6 +174,44 @@ TEST_F(LoaderTest, RestoreSession) {
   CheckSavedModelBundle(export_dir, actual_bundle);
 }
 
+TEST_F(LoaderTest, PruneToServedSignatures) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, {"regress_x_to_y"},
+                              &bundle));
+
+  // Only the requested signature is available and it behaves as in the
+  // unpruned model.
+  EXPECT_EQ(bundle.GetSignatures().count("regress_x_to_y"), 1);
+  EXPECT_EQ(bundle.GetSignatures().count("regress_x2_to_y3"), 0);
+  CheckSavedModelBundle(export_dir, bundle);
+
+  // Variable "c" only feeds the pruned signatures and was removed from the
+  // graph.
+  std::vector<Tensor> outputs;
+  EXPECT_FALSE(bundle.session->Run({}, {"c:0"}, {}, &outputs).ok());
+}
+
+TEST_F(LoaderTest, PruneToUnknownSignature) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  Status st = LoadSavedModel(session_options, run_options, export_dir,
+                             {kSavedModelTagServe}, {"missing_signature"},
+                             &bundle);
+  EXPECT_FALSE(st.ok());
+  EXPECT_NE(st.error_message().find("missing_signature"), std::string::npos)
+      << st.error_message();
+}
+
 TEST_F(LoaderTest, NoTagMatch) {
   SavedModelBundle bundle;
   RunOptions run_options;
@@ -148,6 +148,11 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
            &mark_for_compilation_flags->tf_xla_persistent_cache_directory,
            "If non-empty, JIT-compiled executables are saved to and loaded "
            "from the specified file system directory path. Empty by default."),
+      Flag("tf_xla_persistent_cache_read_only",
+           &mark_for_compilation_flags->tf_xla_persistent_cache_read_only,
+           "If true, the persistent cache directory is only read from; newly "
+           "JIT-compiled executables are not written back to it. Defaults to "
+           "false."),
       Flag("tf_xla_disable_strict_signature_checks",
            &mark_for_compilation_flags->tf_xla_disable_strict_signature_checks,
            "If true, entires loaded into the XLA compile cache will not have "
@@ -155,7 +160,18 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
       Flag("tf_xla_persistent_cache_prefix",
            &mark_for_compilation_flags->tf_xla_persistent_cache_prefix,
            "Specifies the persistance cache prefix. Default is "
-           "\"xla_compile_cache\"")};
+           "\"xla_compile_cache\""),
+      Flag("tf_xla_clustering_profile_path",
+           &mark_for_compilation_flags->tf_xla_clustering_profile_path,
+           "If non-empty, a serialized CostGraphDef holding measured per-node "
+           "execution times. Auto-clustering then only compiles clusters "
+           "whose measured runtime exceeds "
+           "tf_xla_profile_min_cluster_time_us. Empty by default."),
+      Flag("tf_xla_profile_min_cluster_time_us",
+           &mark_for_compilation_flags->tf_xla_profile_min_cluster_time_us,
+           "Minimum measured runtime, in microseconds, a cluster must account "
+           "for in the profile given by tf_xla_clustering_profile_path to be "
+           "worth compiling.")};
   flag_list->insert(flag_list->end(), new_flags.begin(), new_flags.end());
 }
 
@@ -203,9 +219,12 @@ void AllocateAndParseFlags() {
       ->tf_xla_disable_resource_variable_safety_checks_for_debugging = false;
   mark_for_compilation_flags->tf_xla_deterministic_cluster_names = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_directory = "";
+  mark_for_compilation_flags->tf_xla_persistent_cache_read_only = false;
   mark_for_compilation_flags->tf_xla_disable_strict_signature_checks = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_prefix =
       "xla_compile_cache";
+  mark_for_compilation_flags->tf_xla_clustering_profile_path = "";
+  mark_for_compilation_flags->tf_xla_profile_min_cluster_time_us = 100;
 
   device_flags = new XlaDeviceFlags;
   device_flags->tf_xla_compile_on_demand = false;
@@ -214,6 +233,7 @@ void AllocateAndParseFlags() {
   ops_flags = new XlaOpsCommonFlags;
   ops_flags->tf_xla_always_defer_compilation = false;
   ops_flags->tf_xla_async_compilation = false;
+  ops_flags->tf_xla_launch_async_compilation = false;
 
   jitter_flags = new IntroduceFloatingPointJitterPassFlags;
   jitter_flags->jitter_amount = 1e-5;
@@ -274,6 +294,11 @@ void AllocateAndParseFlags() {
             "When lazy compilation is enabled, asynchronous compilation starts "
             "the cluster compilation in the background, and the fallback path "
             "is executed until the compilation has finished."),
+       Flag("tf_xla_launch_async_compilation",
+            &ops_flags->tf_xla_launch_async_compilation,
+            "When true, XlaLaunch kernels compile new signatures in the "
+            "background and run the cluster through the regular TF executor "
+            "until the compiled executable is ready."),
 
        Flag("tf_introduce_floating_point_jitter_to_tensors",
             setter_for_jitter_tensor_names, "",
@@ -93,6 +93,11 @@ struct MarkForCompilationPassFlags {
   // specified file system directory path.
   std::string tf_xla_persistent_cache_directory;
 
+  // If true, the persistent cache is read-only: executables are loaded from
+  // tf_xla_persistent_cache_directory but newly compiled ones are not written
+  // back to it.
+  bool tf_xla_persistent_cache_read_only;
+
   // If true, entries loaded into the XLA compile cache will not have their
   // signatures checked strictly. This should generally not be disabled except
   // for debugging. Defaults to false.
@@ -100,6 +105,18 @@ struct MarkForCompilationPassFlags {
 
   // Specifies the persistance cache prefix. Default is "xla_compile_cache"
   string tf_xla_persistent_cache_prefix;
+
+  // If non-empty, points to a serialized CostGraphDef holding measured
+  // per-node execution times, e.g. collected via RunMetadata.cost_graph or
+  // the session's CostModelManager. When set, auto-clustering is profile
+  // guided: only clusters whose measured runtime exceeds
+  // tf_xla_profile_min_cluster_time_us are compiled.
+  std::string tf_xla_clustering_profile_path;
+
+  // Minimum measured runtime, in microseconds, a cluster must account for in
+  // the profile to be worth compiling. Only consulted when
+  // tf_xla_clustering_profile_path is set.
+  int64_t tf_xla_profile_min_cluster_time_us;
 };
 
 // Flags associated with the XLA bridge's xla_device module.
@@ -122,6 +139,11 @@ struct XlaOpsCommonFlags {
   // If true, _XlaCompile compiles the cluster asynchronously with respect to
   // the main execution. The fallback path is taken while compilation happens.
   bool tf_xla_async_compilation;
+  // If true, XlaLaunch kernels compile new signatures asynchronously and run
+  // the cluster through the regular TF executor until the compiled executable
+  // is ready. Note that the fallback executes the cluster's TF kernels, whose
+  // numerics may differ from the compiled executable's. Defaults to false.
+  bool tf_xla_launch_async_compilation;
 };
 
 // Flags for the build_xla_ops pass.
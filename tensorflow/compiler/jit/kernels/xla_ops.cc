@@ -24,6 +24,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
+#include "tensorflow/compiler/jit/defs.h"
 #include "tensorflow/compiler/jit/encapsulate_subgraphs_pass.h"
 #include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/xla_activity_listener.h"
@@ -438,12 +439,26 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
     variables_snapshot =
         std::move(compiler_args_and_variable_snapshots.variable_snapshots);
 
+    const XlaCompilationCache::CompileMode compile_mode =
+        GetXlaOpsCommonFlags().tf_xla_launch_async_compilation
+            ? XlaCompilationCache::CompileMode::kAsync
+            : XlaCompilationCache::CompileMode::kStrict;
+
     const Status s = CompileToLocalExecutable(
         ctx, function_, /*has_ref_vars=*/has_ref_vars_, platform_info_, args,
-        XlaCompilationCache::CompileMode::kStrict,
+        compile_mode,
         /*may_alias_resource_update=*/true, &client, &compilation_result,
         &executable);
     OP_REQUIRES_OK_ASYNC(ctx, s, done);
+
+    // Asynchronous compilation returns a nullptr executable without an error
+    // while the cluster compiles in the background. Run the cluster through
+    // the regular TF executor until the executable is ready.
+    if (executable == nullptr) {
+      DCHECK(compile_mode == XlaCompilationCache::CompileMode::kAsync);
+      RunFallbackFunction(ctx, std::move(done));
+      return;
+    }
   }
 
   // Continuation of the execution, may be run in a different thread.
@@ -549,6 +564,59 @@ void XlaLocalLaunchBase::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
   }
 }
 
+void XlaLocalLaunchBase::RunFallbackFunction(OpKernelContext* ctx,
+                                             DoneCallback done) {
+  VLOG(2) << "Executing fallback for " << function_.name()
+          << " while compilation is in progress";
+  FunctionLibraryRuntime* lib = ctx->function_library();
+  OP_REQUIRES_ASYNC(ctx, lib != nullptr,
+                    errors::Internal("No function library is provided."),
+                    done);
+
+  FunctionLibraryRuntime::Handle handle;
+  {
+    mutex_lock lock(fallback_handle_mu_);
+    if (fallback_handle_ == kInvalidHandle) {
+      NameAttrList func = function_;
+      // Clear the must-compile attribute so that the fallback instantiation
+      // yields a regular function call instead of another XlaLaunch kernel.
+      (*func.mutable_attr())[kXlaMustCompileAttr].set_b(false);
+      OP_REQUIRES_OK_ASYNC(
+          ctx,
+          lib->Instantiate(func.name(), AttrSlice(&func.attr()),
+                           &fallback_handle_),
+          done);
+    }
+    handle = fallback_handle_;
+  }
+
+  FunctionLibraryRuntime::Options opts;
+  opts.rendezvous = ctx->rendezvous();
+  opts.cancellation_manager = ctx->cancellation_manager();
+  opts.collective_executor = ctx->collective_executor();
+  opts.runner = ctx->runner();
+  opts.run_all_kernels_inline = ctx->run_all_kernels_inline();
+  opts.stats_collector = ctx->stats_collector();
+  opts.step_container = ctx->step_container();
+  std::vector<Tensor> args;
+  args.reserve(ctx->num_inputs());
+  for (int i = 0; i < ctx->num_inputs(); ++i) {
+    args.push_back(ctx->input(i));
+  }
+  std::vector<Tensor>* rets = new std::vector<Tensor>;
+  lib->Run(opts, handle, args, rets, [ctx, done, rets](const Status& status) {
+    if (!status.ok()) {
+      ctx->SetStatus(status);
+    } else {
+      for (size_t i = 0; i < rets->size(); ++i) {
+        ctx->set_output(i, std::move((*rets)[i]));
+      }
+    }
+    delete rets;
+    done();
+  });
+}
+
 namespace {
 // Helper static functions to construct parameters for
 // XlaLocalLaunchBase constructor from OpKernelConstruction.
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/compiler/jit/xla_platform_info.h"
 #include "tensorflow/compiler/xla/stream_executor/tf_allocator_adapter.h"
 #include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -57,6 +58,10 @@ class XlaLocalLaunchBase : public AsyncOpKernel {
   void ComputeAsync(OpKernelContext* ctx, DoneCallback done) override;
 
  protected:
+  // Runs the cluster's function through the regular TF executor. Used while
+  // asynchronous compilation of the cluster is still in progress.
+  void RunFallbackFunction(OpKernelContext* ctx, DoneCallback done);
+
   // Indexes of compile-time constant inputs
   const std::vector<int> constants_;
   // Indexes of resource inputs
@@ -66,6 +71,11 @@ class XlaLocalLaunchBase : public AsyncOpKernel {
   const XlaPlatformInfo platform_info_;
 
   bool has_ref_vars_;
+
+  // Function handle for the fallback path, instantiated on first use.
+  mutex fallback_handle_mu_;
+  FunctionLibraryRuntime::Handle fallback_handle_
+      TF_GUARDED_BY(fallback_handle_mu_) = kInvalidHandle;
 };
 
 // XlaLocalLaunchOp is used to replace a region of the TensorFlow graph
@@ -43,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/framework/bounds_check.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
 #include "tensorflow/core/framework/graph_def_util.h"
 #include "tensorflow/core/framework/memory_types.h"
 #include "tensorflow/core/framework/node_def.pb.h"
@@ -54,6 +55,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/statusor.h"
@@ -104,6 +106,16 @@ class MarkForCompilationPassImpl {
     int max_cluster_size;
     int min_cluster_size;
 
+    // If non-empty, a serialized CostGraphDef with measured per-node
+    // execution times. Clustering is then profile guided: only clusters
+    // whose measured runtime is at least `profile_min_cluster_time_us` are
+    // marked for compilation.
+    std::string clustering_profile_path;
+
+    // Minimum measured runtime, in microseconds, a cluster must account for
+    // in the profile to be worth compiling.
+    int64_t profile_min_cluster_time_us;
+
     // Compiler fuel for the auto-clustering algorithm.
     //
     // We decrement this value by one on every time we choose a compilation
@@ -137,13 +149,14 @@ class MarkForCompilationPassImpl {
    public:
     // Constructs a trivial cluster representing a single TF node.
     Cluster(int tf_graph_node_id, int effective_cluster_size,
-            bool has_functional_control_flow, DeviceSet devices,
-            std::optional<DeviceId> resource_op_device,
+            int64_t profiled_time_us, bool has_functional_control_flow,
+            DeviceSet devices, std::optional<DeviceId> resource_op_device,
             std::optional<int> resource_var_operation_node_id,
             std::optional<DeadnessPredicate> deadness_predicate,
             bool is_xla_compile_attr_true, std::optional<string> xla_scope)
         : cycles_graph_node_id_(tf_graph_node_id),
           effective_cluster_size_(effective_cluster_size),
+          profiled_time_us_(profiled_time_us),
           has_functional_control_flow_(has_functional_control_flow),
           devices_(std::move(devices)),
           resource_op_device_(resource_op_device),
@@ -181,6 +194,11 @@ class MarkForCompilationPassImpl {
     // The size of the cluster excluding constant and identity nodes.
     int effective_cluster_size() const { return effective_cluster_size_; }
 
+    // The total measured runtime of the cluster's nodes, in microseconds, as
+    // reported by the clustering profile. Zero when no profile is loaded or
+    // when none of the cluster's nodes appear in it.
+    int64_t profiled_time_us() const { return profiled_time_us_; }
+
     // True if the cluster has functional control flow like `If` and `While`.
     bool has_functional_control_flow() const {
       return has_functional_control_flow_;
@@ -239,6 +257,7 @@ class MarkForCompilationPassImpl {
     int cluster_size_ = 1;
     int cycles_graph_node_id_;
     int effective_cluster_size_;
+    int64_t profiled_time_us_;
     bool has_functional_control_flow_;
     DeviceSet devices_;
     std::optional<DeviceId> resource_op_device_;
@@ -335,6 +354,7 @@ class MarkForCompilationPassImpl {
   void VLogClusteringSummary();
 
   Cluster* MakeNewCluster(int cycles_graph_node_id, int effective_cluster_size,
+                          int64_t profiled_time_us,
                           bool has_functional_control_flow,
                           const DeviceSet& device_set,
                           std::optional<DeviceId> resource_op_device,
@@ -343,13 +363,17 @@ class MarkForCompilationPassImpl {
                           bool is_xla_compile_attr_true,
                           std::optional<string> xla_scope) {
     cluster_storage_.push_back(std::make_unique<Cluster>(
-        cycles_graph_node_id, effective_cluster_size,
+        cycles_graph_node_id, effective_cluster_size, profiled_time_us,
         has_functional_control_flow, device_set, resource_op_device,
         resource_var_operation_node_id, deadness_predicate,
         is_xla_compile_attr_true, xla_scope));
     return cluster_storage_.back().get();
   }
 
+  // Loads the measured per-node execution times from the CostGraphDef named
+  // by `debug_options_.clustering_profile_path`.
+  Status LoadClusteringProfile();
+
   std::optional<string> GetXlaScope(Node* n);
 
   // Returns the cluster for node `n`.  If two nodes, N1 and N2, are placed in
@@ -464,6 +488,10 @@ class MarkForCompilationPassImpl {
   std::unique_ptr<DeadnessAnalysis> deadness_analysis_;
   int64_t iteration_count_ = 0;
   absl::flat_hash_set<std::pair<int, int>> unsafe_resource_deps_;
+
+  // Measured per-node execution times in microseconds, keyed by node name.
+  // Empty unless a clustering profile was loaded.
+  absl::flat_hash_map<string, int64_t> profiled_time_us_by_node_;
 };
 
 std::vector<int> MarkForCompilationPassImpl::FindAlternatePathForDebugging(
@@ -562,6 +590,7 @@ void MarkForCompilationPassImpl::Cluster::Merge(Cluster* other) {
 
   cluster_size_ += other->cluster_size_;
   effective_cluster_size_ += other->effective_cluster_size_;
+  profiled_time_us_ += other->profiled_time_us_;
   has_functional_control_flow_ |= other->has_functional_control_flow_;
 
   devices_.UnionWith(other->devices_);
@@ -651,6 +680,10 @@ StatusOr<bool> MarkForCompilationPassImpl::Initialize() {
     TF_RETURN_IF_ERROR(DeadnessAnalysis::Run(*graph_, &deadness_analysis_));
   }
 
+  if (!debug_options_.clustering_profile_path.empty()) {
+    TF_RETURN_IF_ERROR(LoadClusteringProfile());
+  }
+
   // If the user is requesting deterministic cluster names compute a hash of the
   // input graph to provide a stable but unique prefix for the name.
   if (debug_options_.deterministic_cluster_names) {
@@ -664,6 +697,19 @@ StatusOr<bool> MarkForCompilationPassImpl::Initialize() {
   return true;
 }
 
+Status MarkForCompilationPassImpl::LoadClusteringProfile() {
+  CostGraphDef cost_graph;
+  TF_RETURN_IF_ERROR(ReadTextOrBinaryProto(
+      env_, debug_options_.clustering_profile_path, &cost_graph));
+  for (const CostGraphDef::Node& node : cost_graph.node()) {
+    profiled_time_us_by_node_[node.name()] += node.compute_cost();
+  }
+  VLOG(2) << "Loaded clustering profile covering "
+          << profiled_time_us_by_node_.size() << " nodes from "
+          << debug_options_.clustering_profile_path;
+  return OkStatus();
+}
+
 template <typename FnTy>
 StatusOr<bool> MarkForCompilationPassImpl::ForEachEdgeInPostOrder(FnTy fn) {
   bool changed = false;
@@ -956,6 +1002,20 @@ Status MarkForCompilationPassImpl::CreateClusters() {
       continue;
     }
 
+    // In profile-guided mode only compile clusters whose measured runtime
+    // clears the payoff threshold; compiling cold clusters costs compile time
+    // without a matching execution benefit. Clusters the user explicitly
+    // requested are exempt.
+    if (!debug_options_.clustering_profile_path.empty() &&
+        !cluster->is_xla_compile_attr_true() &&
+        cluster->profiled_time_us() <
+            debug_options_.profile_min_cluster_time_us) {
+      VLOG(3) << "Not clustering " << cluster->DebugString(*graph_)
+              << ": measured runtime " << cluster->profiled_time_us()
+              << "us is below the payoff threshold";
+      continue;
+    }
+
     // We assume that functional If and While nodes have at least
     // min_cluster_size non-trivial nodes in them.  It would be more principled
     // to (recursively) verify this fact, but that's probably not worth the
@@ -1108,6 +1168,16 @@ Status MarkForCompilationPassImpl::BuildInitialClusterSet() {
     int effective_cluster_size =
         (node->IsIdentity() || node->IsConstant()) ? 0 : 1;
 
+    // Nodes absent from the clustering profile were never observed executing
+    // and contribute no measured runtime.
+    int64_t profiled_time_us = 0;
+    if (!profiled_time_us_by_node_.empty()) {
+      auto it = profiled_time_us_by_node_.find(node->name());
+      if (it != profiled_time_us_by_node_.end()) {
+        profiled_time_us = it->second;
+      }
+    }
+
     bool has_functional_control_flow = node->IsWhileNode() || node->IsIfNode();
 
     std::optional<DeadnessPredicate> deadness_predicate;
@@ -1145,6 +1215,7 @@ Status MarkForCompilationPassImpl::BuildInitialClusterSet() {
     Cluster* new_cluster = MakeNewCluster(
         /*cycles_graph_node_id=*/node->id(),
         /*effective_cluster_size=*/effective_cluster_size,
+        /*profiled_time_us=*/profiled_time_us,
         /*has_functional_control_flow=*/has_functional_control_flow, devices,
         resource_op_device, resource_var_operation_node_id, deadness_predicate,
         /*is_xla_compile_attr_true=*/is_xla_compile_attr_true,
@@ -1880,6 +1951,9 @@ Status MarkForCompilationPass::Run(
       flags->tf_xla_deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.clustering_profile_path = flags->tf_xla_clustering_profile_path;
+  debug_options.profile_min_cluster_time_us =
+      flags->tf_xla_profile_min_cluster_time_us;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
@@ -1899,6 +1973,9 @@ Status MarkForCompilationPass::RunForTest(
   debug_options.deterministic_cluster_names = deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.clustering_profile_path = flags->tf_xla_clustering_profile_path;
+  debug_options.profile_min_cluster_time_us =
+      flags->tf_xla_profile_min_cluster_time_us;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
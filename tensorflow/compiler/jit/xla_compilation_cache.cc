@@ -159,7 +159,8 @@ XlaCompilationCache::XlaCompilationCache(Config config,
       device_type_(std::move(device_type)),
       disable_strict_signature_checks_(config.disable_strict_signature_checks),
       persistance_prefix_(config.persistance_prefix),
-      persistent_cache_directory_(config.persistent_cache_directory) {}
+      persistent_cache_directory_(config.persistent_cache_directory),
+      persistent_cache_read_only_(config.persistent_cache_read_only) {}
 
 XlaCompilationCache::~XlaCompilationCache() {
   // Ensure any use of our programs have completed by waiting for all stream
@@ -540,7 +541,7 @@ Status XlaCompilationCache::CompileStrict(
 
     // Caching is done regardless of the entry->compilation_status. To take
     // advantage of newer compilation code, a cache flush is required.
-    if (!persistent_cache_directory_.empty()) {
+    if (!persistent_cache_directory_.empty() && !persistent_cache_read_only_) {
       XLA_SCOPED_LOGGING_TIMER(absl::StrCat(
           "Serializing and saving cache entry: ", sig.HumanString()));
       TF_ASSIGN_OR_RETURN(XlaSerializedCacheEntry serialized_entry,
@@ -953,7 +954,18 @@ Status XlaCompilationCache::SaveSerializedEntry(
   TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(persistent_cache_directory_));
   const std::string file_path =
       GetFilePath(entry.key(), persistent_cache_directory_);
-  return WriteBinaryProto(env, file_path, entry);
+  // Write to a unique temporary file and rename it into place so that
+  // concurrent writers racing on a shared cache directory never expose a
+  // partially written entry to readers.
+  std::string temp_path =
+      io::JoinPath(persistent_cache_directory_,
+                   XlaSerializedCacheKeyToString(entry.key()));
+  if (!env->CreateUniqueFileName(&temp_path, ".pb.tmp")) {
+    return errors::Internal("Could not create a unique file inside ",
+                            persistent_cache_directory_);
+  }
+  TF_RETURN_IF_ERROR(WriteBinaryProto(env, temp_path, entry));
+  return env->RenameFile(temp_path, file_path);
 }
 
 StatusOr<std::optional<XlaSerializedCacheEntry>>
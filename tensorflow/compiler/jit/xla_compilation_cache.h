@@ -56,13 +56,16 @@ class XlaCompilationCache : public ResourceBase {
     Config() {}
     explicit Config(absl::string_view persistent_cache_directory,
                     bool disable_strict_signature_checks,
-                    absl::string_view persistance_prefix)
+                    absl::string_view persistance_prefix,
+                    bool persistent_cache_read_only = false)
         : persistent_cache_directory(persistent_cache_directory),
           disable_strict_signature_checks(disable_strict_signature_checks),
-          persistance_prefix(persistance_prefix) {}
+          persistance_prefix(persistance_prefix),
+          persistent_cache_read_only(persistent_cache_read_only) {}
 
     // If non-empty, JIT-compiled executables are saved to and loaded from the
-    // specified file system directory path.
+    // specified file system directory path. The path may name any registered
+    // filesystem (e.g. a gs:// bucket shared by a fleet of workers).
     std::string persistent_cache_directory;
 
     // Disable strict signature checks for entries loaded into the cache from
@@ -71,6 +74,11 @@ class XlaCompilationCache : public ResourceBase {
 
     // The cache persistence prefix to use if serializing/deserialzing entries.
     std::string persistance_prefix;
+
+    // If true, entries are loaded from the persistent cache directory but
+    // newly compiled executables are never written back to it. Useful when
+    // many workers share a pre-populated cache directory.
+    bool persistent_cache_read_only = false;
   };
   XlaCompilationCache(Config config, xla::LocalClient* client,
                       DeviceType device_type);
@@ -335,6 +343,10 @@ class XlaCompilationCache : public ResourceBase {
   // specified file system directory path.
   std::string persistent_cache_directory_;
 
+  // If true, the persistent cache directory is only read from, never written
+  // to.
+  bool persistent_cache_read_only_;
+
   TF_DISALLOW_COPY_AND_ASSIGN(XlaCompilationCache);
 };
 
@@ -20,10 +20,12 @@ limitations under the License.
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/strings/str_join.h"
 #include "tensorflow/compiler/tf2tensorrt/common/utils.h"
 #include "tensorflow/compiler/tf2tensorrt/convert/convert_nodes.h"
 #include "tensorflow/compiler/tf2tensorrt/convert/utils.h"
 #include "tensorflow/compiler/tf2tensorrt/utils/trt_allocator.h"
+#include "tensorflow/compiler/tf2tensorrt/utils/trt_engine_instance.pb.h"  // NOLINT
 #include "tensorflow/compiler/tf2tensorrt/utils/trt_engine_utils.h"
 #include "tensorflow/compiler/tf2tensorrt/utils/trt_logger.h"
 #include "tensorflow/compiler/tf2tensorrt/utils/trt_lru_cache.h"
@@ -40,8 +42,13 @@ limitations under the License.
 #include "tensorflow/core/grappler/clusters/utils.h"
 #include "tensorflow/core/grappler/clusters/virtual_cluster.h"
 #include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/lib/io/record_writer.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/stream_executor.h"
@@ -178,6 +185,21 @@ class TRTEngineOp : public AsyncOpKernel {
   Status GetEngineCacheResource(OpKernelContext* ctx,
                                 TRTEngineCacheResource** cache_res);
 
+  // Best-effort reuse of runtime-built engines across processes, enabled by
+  // pointing the TF_TRT_ENGINE_CACHE_DIR environment variable at a directory
+  // shared between replicas. Engines are keyed by the segment's network, the
+  // TensorRT version and the GPU's compute capability, so a replica only
+  // loads engines that are actually compatible with it.
+  Status MaybeLoadPersistedEngines(OpKernelContext* ctx,
+                                   TRTEngineCacheResource* cache_res);
+  Status MaybePersistEngine(OpKernelContext* ctx,
+                            const std::vector<TensorShape>& shapes,
+                            nvinfer1::ICudaEngine* engine);
+
+  // Returns the file path prefix identifying this op's engines in the shared
+  // engine store.
+  StatusOr<string> GetEnginePersistenceKey(const string& engine_cache_dir);
+
   // Returns a pair of 1) An EngineContext object that is compatible with the
   // input and 2) The index of the IExecutionContext compatible with the input.
   // If a cuda engine for the given input shapes can't be found, returns
@@ -1062,10 +1084,188 @@ Status TRTEngineOp::GetEngineCacheResource(OpKernelContext* ctx,
       std::string(kTfTrtContainerName), std::string(resource_name), cache_res,
       {[this, ctx](TRTEngineCacheResource** cr) -> Status {
         *cr = new TRTEngineCacheResource(ctx, this->max_cached_engines_);
+        // Loading persisted engines is best effort; a failure only costs a
+        // rebuild.
+        Status load_status = this->MaybeLoadPersistedEngines(ctx, *cr);
+        if (!load_status.ok()) {
+          LOG(WARNING) << "Failed to load persisted TRT engines for "
+                       << this->name() << ": " << load_status;
+        }
         return OkStatus();
       }});
 }
 
+namespace {
+
+// Directory of the engine store shared between processes, or the empty string
+// when engine persistence is disabled.
+string GetEngineCacheDir() {
+  string dir;
+  TF_CHECK_OK(ReadStringFromEnvVar("TF_TRT_ENGINE_CACHE_DIR", "", &dir));
+  return dir;
+}
+
+}  // namespace
+
+StatusOr<string> TRTEngineOp::GetEnginePersistenceKey(
+    const string& engine_cache_dir) {
+  int cuda_device_id = 0;
+  cudaDeviceProp device_prop;
+  cudaError_t cuda_error = cudaGetDevice(&cuda_device_id);
+  if (cuda_error != cudaSuccess) {
+    return errors::Internal("Unable to get current CUDA device: ",
+                            cudaGetErrorString(cuda_error));
+  }
+  cuda_error = cudaGetDeviceProperties(&device_prop, cuda_device_id);
+  if (cuda_error != cudaSuccess) {
+    return errors::Internal("Unable to query CUDA device properties: ",
+                            cudaGetErrorString(cuda_error));
+  }
+
+  // Use the same canonicalized op name as the engine cache resource.
+  absl::string_view op_name = name();
+  size_t last_slash = op_name.find_last_of('/');
+  if (last_slash != absl::string_view::npos) {
+    op_name.remove_prefix(last_slash + 1);
+  }
+
+  const uint64 network_hash =
+      Fingerprint64(segment_graph_def_.SerializeAsString());
+  return io::JoinPath(
+      engine_cache_dir,
+      absl::StrCat(op_name, ".", network_hash, ".trt",
+                   absl::StrJoin(GetLoadedTensorRTVersion(), "_"), ".sm",
+                   device_prop.major, device_prop.minor));
+}
+
+Status TRTEngineOp::MaybeLoadPersistedEngines(
+    OpKernelContext* ctx, TRTEngineCacheResource* cache_res) {
+  const string engine_cache_dir = GetEngineCacheDir();
+  if (engine_cache_dir.empty() || static_engine_ || calibration_mode_ ||
+      !cache_res->cache_.empty()) {
+    return OkStatus();
+  }
+  auto allocator = cache_res->allocator_.get();
+  if (allocator == nullptr) {
+    return errors::Internal(
+        "Not able to load persisted TRT engines when GPU allocator is empty.");
+  }
+  TF_ASSIGN_OR_RETURN(const string key,
+                      GetEnginePersistenceKey(engine_cache_dir));
+
+  std::vector<string> engine_files;
+  Env* env = ctx->env();
+  Status status =
+      env->GetMatchingPaths(absl::StrCat(key, ".*.engine"), &engine_files);
+  if (!status.ok() || engine_files.empty()) {
+    return OkStatus();
+  }
+  std::sort(engine_files.begin(), engine_files.end());
+
+  int num_loaded_engines = 0;
+  for (const string& engine_file : engine_files) {
+    std::unique_ptr<RandomAccessFile> file;
+    TF_RETURN_IF_ERROR(env->NewRandomAccessFile(engine_file, &file));
+    io::RecordReader reader(file.get());
+    uint64 offset = 0;
+    tstring record;
+    TF_RETURN_IF_ERROR(reader.ReadRecord(&offset, &record));
+
+    TRTEngineInstance engine_instance;
+    if (!engine_instance.ParseFromArray(record.data(), record.size())) {
+      LOG(WARNING) << "Skipping corrupt persisted TRT engine file "
+                   << engine_file;
+      continue;
+    }
+    std::vector<TensorShape> engine_input_shapes;
+    engine_input_shapes.reserve(engine_instance.input_shapes().size());
+    for (const TensorShapeProto& shape : engine_instance.input_shapes()) {
+      engine_input_shapes.emplace_back(shape);
+    }
+
+    TrtUniquePtrType<nvinfer1::IRuntime> infer(
+        nvinfer1::createInferRuntime(TRTEngineCacheResource::GetLogger()));
+    infer->setGpuAllocator(allocator);
+    TrtUniquePtrType<nvinfer1::ICudaEngine> engine(infer->deserializeCudaEngine(
+        engine_instance.serialized_engine().c_str(),
+        engine_instance.serialized_engine().size(), nullptr));
+    if (engine == nullptr) {
+      LOG(WARNING) << "Skipping persisted TRT engine file " << engine_file
+                   << " that failed to deserialize";
+      continue;
+    }
+    auto raw_engine = engine.get();
+    std::vector<ExecutionContext> ctx_vec;
+    if (num_loaded_engines == 0) {
+      // Restore profiles if there are any. Currently only 1 engine is allowed
+      // in dynamic mode therefore we call this only for the 0th engine. It is
+      // a no-op in implicit batch mode.
+      TF_RETURN_IF_ERROR(cache_res->profiles_.RestoreProfiles(
+          raw_engine, engine_input_shapes.size()));
+      TF_RETURN_IF_ERROR(
+          cache_res->profiles_.CreateExecutionContexts(raw_engine, &ctx_vec));
+    } else {
+      ctx_vec.push_back(ExecutionContext::Create(raw_engine));
+    }
+    cache_res->cache_.emplace(engine_input_shapes,
+                              std::make_unique<EngineContext>(
+                                  std::move(engine), std::move(ctx_vec)));
+    ++num_loaded_engines;
+  }
+  VLOG(1) << "Loaded " << num_loaded_engines
+          << " persisted TRT engines for op " << name() << " from "
+          << engine_cache_dir;
+  return OkStatus();
+}
+
+Status TRTEngineOp::MaybePersistEngine(OpKernelContext* ctx,
+                                       const std::vector<TensorShape>& shapes,
+                                       nvinfer1::ICudaEngine* engine) {
+  const string engine_cache_dir = GetEngineCacheDir();
+  if (engine_cache_dir.empty()) {
+    return OkStatus();
+  }
+  TF_ASSIGN_OR_RETURN(const string key,
+                      GetEnginePersistenceKey(engine_cache_dir));
+
+  TRTEngineInstance engine_instance;
+  for (const TensorShape& shape : shapes) {
+    shape.AsProto(engine_instance.add_input_shapes());
+  }
+  TrtUniquePtrType<nvinfer1::IHostMemory> engine_data(engine->serialize());
+  if (engine_data == nullptr) {
+    return errors::Internal("Engine serialization failed for ", name());
+  }
+  engine_instance.set_serialized_engine(
+      static_cast<const char*>(engine_data->data()), engine_data->size());
+
+  // One file per engine, named after the shapes it was built for. Write to a
+  // unique temporary file and rename it into place so replicas racing on the
+  // shared store never observe a partial engine.
+  const string file_path = absl::StrCat(
+      key, ".", Fingerprint64(TensorShapeUtils::ShapeListString(shapes)),
+      ".engine");
+  Env* env = ctx->env();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(engine_cache_dir));
+  string temp_path = file_path;
+  if (!env->CreateUniqueFileName(&temp_path, ".tmp")) {
+    return errors::Internal("Failed to create a unique file inside ",
+                            engine_cache_dir);
+  }
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_RETURN_IF_ERROR(env->NewWritableFile(temp_path, &file));
+    io::RecordWriter writer(file.get());
+    TF_RETURN_IF_ERROR(
+        writer.WriteRecord(engine_instance.SerializeAsString()));
+    TF_RETURN_IF_ERROR(writer.Close());
+    TF_RETURN_IF_ERROR(file->Close());
+  }
+  TF_RETURN_IF_ERROR(env->RenameFile(temp_path, file_path));
+  VLOG(1) << "Persisted TRT engine for op " << name() << " to " << file_path;
+  return OkStatus();
+}
+
 StatusOr<TrtUniquePtrType<nvinfer1::ICudaEngine>> TRTEngineOp::BuildEngine(
     const std::vector<TensorShape>& input_concrete_shapes, int batch_size,
     bool use_calibration, TRTInt8Calibrator* calibrator,
@@ -1283,6 +1483,14 @@ StatusOr<std::pair<EngineContext*, int>> TRTEngineOp::GetEngine(
     std::vector<ExecutionContext> exec_contexts;
     TF_RETURN_IF_ERROR(cache_res->profiles_.CreateExecutionContexts(
         engine.get(), &exec_contexts));
+    // Persisting the engine is best effort; a failure only means the next
+    // process has to rebuild it.
+    Status persist_status =
+        MaybePersistEngine(ctx, input_concrete_shapes, engine.get());
+    if (!persist_status.ok()) {
+      LOG(WARNING) << "Failed to persist TRT engine for " << name() << ": "
+                   << persist_status;
+    }
     cache.emplace(input_concrete_shapes,
                   std::make_unique<EngineContext>(std::move(engine),
                                                   std::move(exec_contexts)));
@@ -475,8 +475,7 @@ port::Status GpuExecutor::Launch(Stream* stream, const ThreadDim& thread_dims,
     }
   }
 
-  if (cuda_kernel->GetPreferredCacheConfig() !=
-      KernelCacheConfig::kNoPreference) {
+  if (cuda_kernel->CacheConfigNeedsUpdate()) {
     TF_RETURN_IF_ERROR(GpuDriver::FuncSetCacheConfig(
         cufunc, cuda_kernel->GetGpuCacheConfig()));
   }
@@ -781,12 +780,12 @@ void GpuExecutor::DeallocateTimer(Timer* timer) {
 
 bool GpuExecutor::CreateStreamDependency(Stream* dependent, Stream* other) {
   CUevent other_completed_event = *AsGpuStream(other)->completed_event();
-  bool ok = GpuDriver::RecordEvent(context_, other_completed_event,
-                                   AsGpuStreamValue(other))
-                .ok();
-  if (!ok) {
+  port::Status status = GpuDriver::RecordEvent(
+      context_, other_completed_event, AsGpuStreamValue(other));
+  if (!status.ok()) {
     LOG(ERROR) << "failed to record completion event; "
-                  "therefore, failed to create inter-stream dependency";
+                  "therefore, failed to create inter-stream dependency: "
+               << status;
     return false;
   }
 
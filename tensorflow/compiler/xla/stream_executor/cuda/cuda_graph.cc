@@ -0,0 +1,80 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/xla/stream_executor/cuda/cuda_graph.h"
+
+#include <memory>
+
+#include "absl/strings/str_cat.h"
+#include "tensorflow/compiler/xla/stream_executor/cuda/cuda_driver.h"
+#include "tensorflow/compiler/xla/stream_executor/platform/logging.h"
+
+namespace stream_executor {
+namespace gpu {
+
+CudaGraphExec::~CudaGraphExec() {
+  CUresult res = cuGraphExecDestroy(exec_);
+  if (res != CUDA_SUCCESS) {
+    LOG(ERROR) << "failed to destroy CUDA executable graph: " << ToString(res);
+  }
+}
+
+port::Status CudaGraphExec::Launch(GpuStreamHandle stream) {
+  CUresult res = cuGraphLaunch(exec_, stream);
+  if (res != CUDA_SUCCESS) {
+    return port::InternalError(
+        absl::StrCat("failed to launch CUDA graph: ", ToString(res)));
+  }
+  return ::tsl::OkStatus();
+}
+
+port::Status BeginStreamCapture(GpuStreamHandle stream) {
+  CUresult res =
+      cuStreamBeginCapture(stream, CU_STREAM_CAPTURE_MODE_THREAD_LOCAL);
+  if (res != CUDA_SUCCESS) {
+    return port::InternalError(
+        absl::StrCat("failed to begin stream capture: ", ToString(res)));
+  }
+  return ::tsl::OkStatus();
+}
+
+port::StatusOr<std::unique_ptr<CudaGraphExec>> EndStreamCaptureAndInstantiate(
+    GpuStreamHandle stream) {
+  CUgraph graph = nullptr;
+  CUresult res = cuStreamEndCapture(stream, &graph);
+  if (res != CUDA_SUCCESS) {
+    return port::InternalError(
+        absl::StrCat("failed to end stream capture: ", ToString(res)));
+  }
+
+  CUgraphExec exec = nullptr;
+  res = cuGraphInstantiate(&exec, graph, /*phErrorNode=*/nullptr,
+                           /*logBuffer=*/nullptr, /*bufferSize=*/0);
+  // The graph template is no longer needed once instantiation has been
+  // attempted.
+  CUresult destroy_res = cuGraphDestroy(graph);
+  if (destroy_res != CUDA_SUCCESS) {
+    LOG(ERROR) << "failed to destroy CUDA graph template: "
+               << ToString(destroy_res);
+  }
+  if (res != CUDA_SUCCESS) {
+    return port::InternalError(
+        absl::StrCat("failed to instantiate CUDA graph: ", ToString(res)));
+  }
+  return std::unique_ptr<CudaGraphExec>(new CudaGraphExec(exec));
+}
+
+}  // namespace gpu
+}  // namespace stream_executor
@@ -0,0 +1,65 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_XLA_STREAM_EXECUTOR_CUDA_CUDA_GRAPH_H_
+#define TENSORFLOW_COMPILER_XLA_STREAM_EXECUTOR_CUDA_CUDA_GRAPH_H_
+
+#include <memory>
+
+#include "third_party/gpus/cuda/include/cuda.h"
+#include "tensorflow/compiler/xla/stream_executor/gpu/gpu_types.h"
+#include "tensorflow/compiler/xla/stream_executor/lib/status.h"
+#include "tensorflow/compiler/xla/stream_executor/lib/statusor.h"
+#include "tensorflow/compiler/xla/stream_executor/platform/port.h"
+
+namespace stream_executor {
+namespace gpu {
+
+// An instantiated, executable CUDA graph. Wraps the CUgraphExec driver
+// handle and destroys it on deletion.
+class CudaGraphExec {
+ public:
+  ~CudaGraphExec();
+
+  // Enqueues a replay of the captured work on "stream".
+  port::Status Launch(GpuStreamHandle stream);
+
+ private:
+  friend port::StatusOr<std::unique_ptr<CudaGraphExec>>
+  EndStreamCaptureAndInstantiate(GpuStreamHandle stream);
+
+  explicit CudaGraphExec(CUgraphExec exec) : exec_(exec) {}
+
+  CUgraphExec exec_;
+
+  SE_DISALLOW_COPY_AND_ASSIGN(CudaGraphExec);
+};
+
+// Puts "stream" into capture mode: work enqueued on it is recorded into a
+// CUDA graph instead of being executed. Capture is thread-local, so work
+// enqueued on other streams by other threads is unaffected.
+port::Status BeginStreamCapture(GpuStreamHandle stream);
+
+// Ends capture on "stream" and instantiates the captured work as an
+// executable graph. Returns an error (and leaves the stream usable) if
+// anything enqueued during capture could not be captured, e.g. a host
+// callback or a synchronous memcpy.
+port::StatusOr<std::unique_ptr<CudaGraphExec>> EndStreamCaptureAndInstantiate(
+    GpuStreamHandle stream);
+
+}  // namespace gpu
+}  // namespace stream_executor
+
+#endif  // TENSORFLOW_COMPILER_XLA_STREAM_EXECUTOR_CUDA_CUDA_GRAPH_H_
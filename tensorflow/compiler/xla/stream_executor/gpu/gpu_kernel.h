@@ -22,6 +22,8 @@ limitations under the License.
 #ifndef TENSORFLOW_COMPILER_XLA_STREAM_EXECUTOR_GPU_GPU_KERNEL_H_
 #define TENSORFLOW_COMPILER_XLA_STREAM_EXECUTOR_GPU_GPU_KERNEL_H_
 
+#include <atomic>
+
 #include "tensorflow/compiler/xla/stream_executor/gpu/gpu_driver.h"
 #include "tensorflow/compiler/xla/stream_executor/kernel_cache_config.h"
 #include "tensorflow/compiler/xla/stream_executor/platform/logging.h"
@@ -79,12 +81,30 @@ class GpuKernel : public internal::KernelInterface {
   // CUfunc_cache.
   GpuFuncCachePreference GetGpuCacheConfig() const;
 
+  // Returns true iff the preferred cache configuration differs from the one
+  // last applied to the loaded function, and atomically records the
+  // preference as applied.  GpuExecutor::Launch uses this to issue the
+  // FuncSetCacheConfig driver call only when the preference changes rather
+  // than on every launch; a kNoPreference kernel never needs the call.  A
+  // race between concurrent launches at worst repeats the (idempotent)
+  // driver call.
+  bool CacheConfigNeedsUpdate() const {
+    const KernelCacheConfig preferred = preferred_cache_config_;
+    if (preferred == KernelCacheConfig::kNoPreference) return false;
+    return applied_cache_config_.exchange(preferred) != preferred;
+  }
+
  private:
   GpuFunctionHandle gpu_function_;  // Wrapped CUDA kernel handle.
   unsigned arity_;  // Number of formal parameters the kernel takes.
 
   // Preferred (but not required) cache configuration for this kernel.
   KernelCacheConfig preferred_cache_config_;
+
+  // Cache configuration last applied to gpu_function_ via
+  // FuncSetCacheConfig; see CacheConfigNeedsUpdate().
+  mutable std::atomic<KernelCacheConfig> applied_cache_config_{
+      KernelCacheConfig::kNoPreference};
 };
 
 // Given a platform-independent kernel datatype, returns the (const) internal
@@ -18,6 +18,7 @@ limitations under the License.
 #include <functional>
 #include <utility>
 
+#include "tensorflow/core/common_runtime/collective_reduce_fuser.h"
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -227,6 +228,25 @@ CollectiveAdapter* MakeCollectiveAdapter(Tensor* output, int num_chunks,
   }
 }
 
+BaseCollectiveExecutor::BaseCollectiveExecutor(
+    CollectiveExecutorMgrInterface* cem, CollectiveRemoteAccess* remote_access,
+    int64_t step_id, const DeviceMgr* dev_mgr,
+    std::shared_ptr<UnboundedWorkQueue> work_queue)
+    : CollectiveExecutor(cem),
+      step_id_(step_id),
+      dev_mgr_(dev_mgr),
+      remote_access_(remote_access),
+      work_queue_(std::move(work_queue)) {
+  const int64_t fusion_bytes = CollectiveReduceFuser::FusionBytesFromEnv();
+  if (fusion_bytes > 0 && work_queue_ != nullptr) {
+    reduce_fuser_ = std::make_shared<CollectiveReduceFuser>(
+        dev_mgr_, fusion_bytes,
+        [work_queue = work_queue_](std::function<void()> closure) {
+          work_queue->Schedule(std::move(closure));
+        });
+  }
+}
+
 BaseCollectiveExecutor::~BaseCollectiveExecutor() {}
 
 void BaseCollectiveExecutor::StartAbort(const Status& s) {
@@ -252,6 +272,9 @@ void BaseCollectiveExecutor::StartAbort(const Status& s) {
   if (cem_->GetNcclCommunicator() != nullptr) {
     cem_->GetNcclCommunicator()->StartAbort(status);
   }
+  if (reduce_fuser_ != nullptr) {
+    reduce_fuser_->Abort(status);
+  }
 }
 
 Status BaseCollectiveExecutor::GetStatus(const Status& s) {
@@ -302,6 +325,14 @@ void BaseCollectiveExecutor::ExecuteAsync(OpKernelContext* ctx,
         });
   }
 
+  if (reduce_fuser_ != nullptr &&
+      reduce_fuser_->MaybeEnqueue(ctx, col_params, done_safe)) {
+    // Like the ring algorithms, a fused reduction doesn't require
+    // non-overlapping collectives, so unblock anything ordered after it.
+    UnblockDependencies(*col_params);
+    return;
+  }
+
   Tensor* output = ctx->mutable_output(0);
   const Tensor* input = (col_params->instance.type == REDUCTION_COLLECTIVE ||
                          col_params->instance.type == GATHER_COLLECTIVE ||
@@ -453,6 +484,26 @@ Status BaseCollectiveExecutor::CreateCollective(
   }
 }
 
+/* static */
+const char* BaseCollectiveExecutor::SelectReductionCollective(
+    const CollectiveParams* cp) {
+  // Below this size the reduction is latency-bound rather than
+  // bandwidth-bound and the tree algorithm wins.  The crossover is not very
+  // sensitive; gradients that matter for the ring algorithm are megabytes.
+  static constexpr int64_t kTreeReduceMaxBytes = 256 * 1024;
+  if (cp->group.device_type != DeviceType(DEVICE_CPU)) return "RingReduce";
+  if (cp->group.num_tasks > 1) return "RingReduce";
+  // With two devices the tree degenerates to the same two transfers as the
+  // ring, so keep the better-exercised implementation.
+  if (cp->group.group_size <= 2) return "RingReduce";
+  if (cp->instance.impl_details.communication_hint == "ring") {
+    return "RingReduce";
+  }
+  const int64_t tensor_bytes = cp->instance.shape.num_elements() *
+                               DataTypeSize(cp->instance.data_type);
+  return tensor_bytes <= kTreeReduceMaxBytes ? "TreeReduce" : "RingReduce";
+}
+
 bool BaseCollectiveExecutor::CheckDependencies(
     const CollectiveParams& col_params) {
   for (int32_t instance : col_params.instance.impl_details.dependencies) {
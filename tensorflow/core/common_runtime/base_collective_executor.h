@@ -25,6 +25,7 @@ limitations under the License.
 
 namespace tensorflow {
 class CollectiveImplementation;
+class CollectiveReduceFuser;
 class DeviceMgr;
 class Device;
 
@@ -98,12 +99,7 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   BaseCollectiveExecutor(CollectiveExecutorMgrInterface* cem,
                          CollectiveRemoteAccess* remote_access, int64_t step_id,
                          const DeviceMgr* dev_mgr,
-                         std::shared_ptr<UnboundedWorkQueue> work_queue)
-      : CollectiveExecutor(cem),
-        step_id_(step_id),
-        dev_mgr_(dev_mgr),
-        remote_access_(remote_access),
-        work_queue_(std::move(work_queue)) {}
+                         std::shared_ptr<UnboundedWorkQueue> work_queue);
 
   ~BaseCollectiveExecutor() override;
 
@@ -124,6 +120,16 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
     work_queue_->Schedule(std::move(closure));
   }
 
+  // Returns the name of the registered collective implementation to use for
+  // an all-reduce with params `cp`, either "RingReduce" or "TreeReduce".
+  // Ring all-reduce is bandwidth-optimal, but costs 2*(group_size-1) serial
+  // communication steps; for the small tensors that dominate CPU training
+  // collectives, the latency of those steps is what matters and a binary
+  // tree over the local devices finishes in 2*ceil(log2(group_size)) steps.
+  // Selects "TreeReduce" only for small tensors between CPU devices on a
+  // single task, and never when the user hinted "ring" explicitly.
+  static const char* SelectReductionCollective(const CollectiveParams* cp);
+
   // If we need to enforce an ordering on any portion of collective
   // implementation, and the ordering is encoded via attribute on the collective
   // op, this function will block until all dependencies for this collective
@@ -148,6 +154,10 @@ class BaseCollectiveExecutor : public CollectiveExecutor {
   std::unordered_map<int32, int32> launched_ TF_GUARDED_BY(launch_mu_);
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
+  // Non-null iff TF_COLLECTIVE_REDUCE_FUSION_BYTES enables runtime fusion of
+  // small single-task CPU all-reduces.  Shared so in-flight flush closures
+  // can outlive this executor.
+  std::shared_ptr<CollectiveReduceFuser> reduce_fuser_;
 
  private:
   Status CreateCollective(const CollectiveParams& col_params,
@@ -0,0 +1,252 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/collective_reduce_fuser.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+namespace {
+// Upper bound on the latency added to a trailing partial buffer.  Launches
+// that fill the fusion threshold are flushed immediately and never wait.
+constexpr int64_t kFusionFlushDelayMicros = 200;
+}  // namespace
+
+CollectiveReduceFuser::CollectiveReduceFuser(
+    const DeviceMgr* dev_mgr, int64_t max_fusion_bytes,
+    std::function<void(std::function<void()>)> runner)
+    : dev_mgr_(dev_mgr),
+      max_fusion_bytes_(max_fusion_bytes),
+      runner_(std::move(runner)) {}
+
+CollectiveReduceFuser::~CollectiveReduceFuser() {
+  // A step cannot finish with collective launches outstanding, so normally
+  // nothing is buffered by now; fail anything left rather than hanging it.
+  Abort(errors::Cancelled("CollectiveReduceFuser destroyed"));
+}
+
+/* static */
+int64_t CollectiveReduceFuser::FusionBytesFromEnv() {
+  int64_t fusion_bytes = 0;
+  Status s = ReadInt64FromEnvVar("TF_COLLECTIVE_REDUCE_FUSION_BYTES", 0,
+                                 &fusion_bytes);
+  if (!s.ok() || fusion_bytes < 0) return 0;
+  return fusion_bytes;
+}
+
+bool CollectiveReduceFuser::MaybeEnqueue(OpKernelContext* ctx,
+                                         const CollectiveParams* col_params,
+                                         StatusCallback done) {
+  if (max_fusion_bytes_ <= 0) return false;
+  if (col_params->instance.type != REDUCTION_COLLECTIVE) return false;
+  // All members of a single-task group launch through this executor; that is
+  // what lets the fuser act on complete instances only, so never a partial
+  // set that could disagree with another process.
+  if (col_params->group.num_tasks > 1) return false;
+  if (col_params->group.device_type != DeviceType(DEVICE_CPU)) return false;
+  if (col_params->merge_op == nullptr) return false;
+  if (!DataTypeCanUseMemcpy(col_params->instance.data_type)) return false;
+  const Tensor* input = &ctx->input(0);
+  const int64_t bytes = input->TotalBytes();
+  if (bytes == 0 || bytes > max_fusion_bytes_) return false;
+
+  const int group_size = col_params->group.group_size;
+  const int rank = col_params->default_rank;
+  bool flush_now = false;
+  bool schedule_flush = false;
+  {
+    mutex_lock l(mu_);
+    if (!status_.ok()) return false;  // aborted; let the normal path report
+    Instance& inst = pending_[col_params->instance.instance_key];
+    if (inst.members.empty()) {
+      inst.instance_key = col_params->instance.instance_key;
+      inst.dtype = col_params->instance.data_type;
+      inst.bytes = bytes;
+      inst.elements = input->NumElements();
+      inst.reduction_kind = strings::StrCat(
+          col_params->merge_op->type_string(), "/",
+          col_params->final_op ? col_params->final_op->type_string() : "");
+      inst.members.resize(group_size);
+    }
+    DCHECK_EQ(inst.bytes, bytes);
+    DCHECK(inst.members[rank].ctx == nullptr);
+    Member& member = inst.members[rank];
+    member.ctx = ctx;
+    member.col_params = col_params;
+    member.input = input;
+    member.output = ctx->mutable_output(0);
+    member.done = std::move(done);
+    if (++inst.arrived == group_size) {
+      complete_.push_back(std::move(inst));
+      pending_.erase(col_params->instance.instance_key);
+      complete_bytes_ += bytes;
+      if (complete_bytes_ >= max_fusion_bytes_) {
+        flush_now = true;
+      } else if (!flush_scheduled_) {
+        flush_scheduled_ = true;
+        schedule_flush = true;
+      }
+    }
+  }
+  if (flush_now) {
+    runner_([self = shared_from_this()] { self->Flush(); });
+  } else if (schedule_flush) {
+    SchedNonBlockingClosureAfter(kFusionFlushDelayMicros,
+                                 [self = shared_from_this()] { self->Flush(); });
+  }
+  return true;
+}
+
+void CollectiveReduceFuser::Abort(const Status& s) {
+  std::vector<Instance> failed;
+  {
+    mutex_lock l(mu_);
+    if (!status_.ok()) return;
+    status_ = s;
+    for (auto& it : pending_) failed.push_back(std::move(it.second));
+    pending_.clear();
+    failed.insert(failed.end(), std::make_move_iterator(complete_.begin()),
+                  std::make_move_iterator(complete_.end()));
+    complete_.clear();
+    complete_bytes_ = 0;
+  }
+  for (const Instance& inst : failed) {
+    for (const Member& member : inst.members) {
+      if (member.done) member.done(s);
+    }
+  }
+}
+
+void CollectiveReduceFuser::Flush() {
+  std::vector<Instance> ready;
+  {
+    mutex_lock l(mu_);
+    ready.swap(complete_);
+    complete_bytes_ = 0;
+    flush_scheduled_ = false;
+  }
+  if (ready.empty()) return;
+  // Deterministic packing order, for debuggability only; correctness does not
+  // depend on which launches ended up in one flush.
+  std::sort(ready.begin(), ready.end(),
+            [](const Instance& a, const Instance& b) {
+              return a.instance_key < b.instance_key;
+            });
+  std::map<std::pair<DataType, string>, std::vector<Instance>> groups;
+  for (auto& inst : ready) {
+    groups[{inst.dtype, inst.reduction_kind}].push_back(std::move(inst));
+  }
+  for (const auto& it : groups) {
+    ReduceGroup(it.second);
+  }
+}
+
+void CollectiveReduceFuser::ReduceGroup(const std::vector<Instance>& group) {
+  const Member& member0 = group[0].members[0];
+  const CollectiveParams* cp0 = member0.col_params;
+  const int group_size = cp0->group.group_size;
+  const DataType dtype = group[0].dtype;
+
+  int64_t total_elements = 0;
+  int64_t total_bytes = 0;
+  for (const Instance& inst : group) {
+    total_elements += inst.elements;
+    total_bytes += inst.bytes;
+  }
+  VLOG(1) << "CollectiveReduceFuser reducing " << group.size()
+          << " instances, " << total_bytes << " bytes, group_size "
+          << group_size;
+
+  Status status;
+  Device* device = nullptr;
+  status.Update(dev_mgr_->LookupDevice(
+      cp0->group.members[0].device.name(), &device));
+
+  Tensor acc;
+  Tensor buf;
+  if (status.ok()) {
+    Allocator* allocator = device->GetAllocator(AllocatorAttributes());
+    acc = Tensor(allocator, dtype, TensorShape({total_elements}));
+    buf = Tensor(allocator, dtype, TensorShape({total_elements}));
+    if (!acc.IsInitialized() || !buf.IsInitialized()) {
+      status.Update(errors::ResourceExhausted(
+          "Failed to allocate fusion buffer of ", total_bytes, " bytes"));
+    }
+  }
+
+  // Pack one member rank's inputs into `dst` in group order.
+  auto pack = [&group](int rank, Tensor* dst) {
+    char* base = reinterpret_cast<char*>(DMAHelper::base(dst));
+    for (const Instance& inst : group) {
+      std::memcpy(base, DMAHelper::base(inst.members[rank].input), inst.bytes);
+      base += inst.bytes;
+    }
+  };
+
+  if (status.ok()) {
+    pack(0, &acc);
+    for (int rank = 1; rank < group_size && status.ok(); ++rank) {
+      pack(rank, &buf);
+      status.Update(collective_util::ComputeBinOp(
+          member0.ctx, CollectiveExecutor::CtxParams(member0.ctx), device,
+          cp0->merge_op, &acc, &buf));
+    }
+  }
+  if (status.ok() && cp0->final_op) {
+    // Applied once on the fused buffer, exactly as the per-tensor collective
+    // applies it once to each reduced tensor.
+    Allocator* allocator = device->GetAllocator(AllocatorAttributes());
+    std::unique_ptr<CollectiveAdapter> ca(
+        MakeCollectiveAdapter(&acc, 1, allocator));
+    Tensor group_size_tensor = ca->Scalar(group_size);
+    ca->ConsumeFinalValue(&acc);
+    status.Update(collective_util::ComputeBinOp(
+        member0.ctx, CollectiveExecutor::CtxParams(member0.ctx), device,
+        cp0->final_op, &acc, &group_size_tensor));
+  }
+
+  if (status.ok()) {
+    // Scatter the reduced buffer back to every member's output.
+    const char* base = reinterpret_cast<const char*>(DMAHelper::base(&acc));
+    for (const Instance& inst : group) {
+      for (const Member& member : inst.members) {
+        std::memcpy(DMAHelper::base(member.output), base, inst.bytes);
+      }
+      base += inst.bytes;
+    }
+  }
+  for (const Instance& inst : group) {
+    for (const Member& member : inst.members) {
+      member.done(status);
+    }
+  }
+}
+
+}  // namespace tensorflow
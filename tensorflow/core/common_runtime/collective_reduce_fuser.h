@@ -0,0 +1,118 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_REDUCE_FUSER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_REDUCE_FUSER_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+
+class DeviceMgr;
+
+// Runtime fusion stage for small single-task CPU all-reduces.
+//
+// Each gradient tensor launches its own collective instance, so a step with
+// hundreds of small gradients pays launch and rendezvous overhead per tensor.
+// Because all members of a single-task group pass through the same
+// `BaseCollectiveExecutor`, the fuser can observe every member's launch
+// directly: launches are buffered until every member of an instance has
+// arrived, complete instances are packed into one flat buffer per member
+// rank, the buffers are combined with the collective's merge_op (and final_op
+// once), and the result is scattered back to each member's output tensor.
+// One pass over a packed buffer replaces hundreds of per-tensor executions,
+// with no graph rewrite involved.
+//
+// Buffered bytes are flushed as soon as they reach the fusion threshold; a
+// short timer bounds the latency added to a trailing partial buffer.
+class CollectiveReduceFuser
+    : public std::enable_shared_from_this<CollectiveReduceFuser> {
+ public:
+  // `runner` is used to move packing and reduction work off the launching
+  // thread; it must outlive this object (the executor passes its own work
+  // queue).
+  CollectiveReduceFuser(const DeviceMgr* dev_mgr, int64_t max_fusion_bytes,
+                        std::function<void(std::function<void()>)> runner);
+  ~CollectiveReduceFuser();
+
+  // Returns the fusion threshold in bytes from the environment variable
+  // TF_COLLECTIVE_REDUCE_FUSION_BYTES, 0 (fusion disabled) if unset.
+  static int64_t FusionBytesFromEnv();
+
+  // Absorbs the launch of `col_params` on behalf of one group member and
+  // returns true if it is eligible for fusion, in which case `done` is
+  // invoked when the fused reduction completes.  Returns false, leaving the
+  // launch untouched, for anything that isn't a small dense single-task CPU
+  // reduction.
+  bool MaybeEnqueue(OpKernelContext* ctx, const CollectiveParams* col_params,
+                    StatusCallback done);
+
+  // Fails every buffered launch with `s`.  Called when the executor aborts.
+  void Abort(const Status& s);
+
+ private:
+  // One member's launch of a collective instance.
+  struct Member {
+    OpKernelContext* ctx = nullptr;
+    const CollectiveParams* col_params = nullptr;
+    const Tensor* input = nullptr;
+    Tensor* output = nullptr;
+    StatusCallback done;
+  };
+
+  // One collective instance, complete once all group members have arrived.
+  struct Instance {
+    int32 instance_key = 0;
+    DataType dtype = DT_INVALID;
+    int64_t bytes = 0;
+    int64_t elements = 0;
+    // merge_op/final_op type, e.g. "Add/Div"; instances are only fused with
+    // others applying the same reduction.
+    string reduction_kind;
+    int arrived = 0;
+    std::vector<Member> members;  // indexed by default_rank
+  };
+
+  // Moves all complete instances out of the buffer and reduces them,
+  // grouping by dtype and reduction kind.
+  void Flush();
+
+  // Packs, reduces and scatters one group of complete instances sharing
+  // dtype and reduction kind.  Calls every buffered done callback.
+  void ReduceGroup(const std::vector<Instance>& group);
+
+  const DeviceMgr* dev_mgr_;
+  const int64_t max_fusion_bytes_;
+  std::function<void(std::function<void()>)> runner_;
+
+  mutex mu_;
+  std::map<int32, Instance> pending_ TF_GUARDED_BY(mu_);
+  std::vector<Instance> complete_ TF_GUARDED_BY(mu_);
+  int64_t complete_bytes_ TF_GUARDED_BY(mu_) = 0;
+  bool flush_scheduled_ TF_GUARDED_BY(mu_) = false;
+  Status status_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_COLLECTIVE_REDUCE_FUSER_H_
@@ -0,0 +1,254 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/collective_reduce_fuser.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/framework/cancellation.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+constexpr int64_t kStepId = 100;
+
+std::unique_ptr<OpKernel> GetBinOpKernel(const string& op_name, DataType dtype,
+                                         const DeviceType& device_type,
+                                         DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder(op_name + "_node", op_name);
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  Status status;
+  std::unique_ptr<OpKernel> k = CreateOpKernel(
+      device_type, device, device->GetAllocator(AllocatorAttributes()),
+      node_def, TF_GRAPH_DEF_VERSION, &status);
+  TF_CHECK_OK(status);
+  return k;
+}
+
+// One group member's launch of one collective instance, with just enough of
+// an OpKernelContext for the fuser to read the input and bind the output,
+// mirroring how RunCollective() in collective_test_util builds one.  The
+// fuser intercepts launches before any collective implementation runs, so we
+// call MaybeEnqueue directly rather than going through RunCollective.
+class FakeLaunch {
+ public:
+  FakeLaunch(CollectiveTestEnv* env, int rank, int32 instance_key,
+             const TensorShape& shape)
+      : input_(DT_FLOAT, shape), output_(DT_FLOAT, shape) {
+    col_params_ = CreateCollectiveParams(*env, rank, "RingReduce",
+                                         REDUCTION_COLLECTIVE, DT_FLOAT, shape);
+    col_params_->instance.instance_key = instance_key;
+    string dev_name = col_params_->group.members[rank].device.name();
+    TF_CHECK_OK(env->device_mgr->LookupDevice(dev_name, &device_));
+    merge_op_ = GetBinOpKernel("Add", DT_FLOAT, env->device_type, device_);
+    final_op_ = GetBinOpKernel("Div", DT_FLOAT, env->device_type, device_);
+    col_params_->merge_op = merge_op_.get();
+    col_params_->final_op = final_op_.get();
+
+    op_params_.step_id = kStepId;
+    op_params_.device = device_;
+    op_params_.cancellation_manager = &cancellation_manager_;
+    inputs_.push_back(TensorValue(&input_));
+    op_params_.inputs = inputs_;
+    input_aa_ = {AllocatorAttributes()};
+    op_params_.input_alloc_attrs = input_aa_;
+    dev_ctx_ = new DeviceContext;
+    op_params_.op_device_context = dev_ctx_;
+    op_params_.forward_from_array = &forward_from_;
+    op_params_.output_attr_array = &generic_alloc_attr_;
+    op_params_.resource_manager = device_->resource_manager();
+    // set_output() checks the kernel's declared output type; the merge op
+    // declares the right one.
+    op_params_.op_kernel = merge_op_.get();
+    ctx_ = std::make_unique<OpKernelContext>(&op_params_, 1);
+    ctx_->set_output(0, output_);
+  }
+
+  ~FakeLaunch() { dev_ctx_->Unref(); }
+
+  void InitTensor(const std::function<void(Tensor*)>& init_f) {
+    init_f(&input_);
+  }
+
+  bool Enqueue(CollectiveReduceFuser* fuser) {
+    return fuser->MaybeEnqueue(ctx_.get(), col_params_.get(),
+                               [this](const Status& s) {
+                                 status_ = s;
+                                 done_ = true;
+                               });
+  }
+
+  const Tensor& output() { return *ctx_->mutable_output(0); }
+  bool done() const { return done_; }
+  const Status& status() const { return status_; }
+
+ private:
+  Tensor input_;
+  Tensor output_;
+  Device* device_;
+  core::RefCountPtr<CollectiveParams> col_params_;
+  std::unique_ptr<OpKernel> merge_op_;
+  std::unique_ptr<OpKernel> final_op_;
+  CancellationManager cancellation_manager_;
+  OpKernelContext::Params op_params_;
+  gtl::InlinedVector<TensorValue, 4> inputs_;
+  gtl::InlinedVector<AllocatorAttributes, 4> input_aa_;
+  DeviceContext* dev_ctx_;
+  int forward_from_ = 0;
+  AllocatorAttributes generic_alloc_attr_;
+  std::unique_ptr<OpKernelContext> ctx_;
+  Status status_;
+  std::atomic<bool> done_{false};
+};
+
+class CollectiveReduceFuserTest : public ::testing::Test {
+ protected:
+  void Init(int num_devices, int64_t max_fusion_bytes) {
+    test_env_ = CreateCollectiveTestEnv(/*num_workers=*/1, num_devices,
+                                        DEVICE_CPU);
+    // Flush closures run inline so a threshold-triggered flush completes
+    // before Enqueue returns; only the trailing-buffer timer is asynchronous.
+    fuser_ = std::make_shared<CollectiveReduceFuser>(
+        test_env_->device_mgr.get(), max_fusion_bytes,
+        [](std::function<void()> closure) { closure(); });
+  }
+
+  FakeLaunch* AddLaunch(int rank, int32 instance_key, int tensor_len) {
+    launches_.push_back(std::make_unique<FakeLaunch>(
+        test_env_.get(), rank, instance_key, TensorShape({tensor_len})));
+    return launches_.back().get();
+  }
+
+  void WaitForAllDone() {
+    for (int i = 0; i < 50000; ++i) {
+      bool all_done = true;
+      for (auto& launch : launches_) all_done = all_done && launch->done();
+      if (all_done) return;
+      Env::Default()->SleepForMicroseconds(100);
+    }
+    ADD_FAILURE() << "Timed out waiting for fused launches to complete";
+  }
+
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+  std::shared_ptr<CollectiveReduceFuser> fuser_;
+  std::vector<std::unique_ptr<FakeLaunch>> launches_;
+};
+
+TEST_F(CollectiveReduceFuserTest, FusesMultipleInstances) {
+  const int kLen = 16;  // 64 bytes per member per instance.
+  Init(/*num_devices=*/2, /*max_fusion_bytes=*/128);
+  std::vector<FakeLaunch*> launches;
+  for (int32 instance_key : {100, 101}) {
+    for (int rank = 0; rank < 2; ++rank) {
+      FakeLaunch* launch = AddLaunch(rank, instance_key, kLen);
+      launch->InitTensor([instance_key, rank](Tensor* t) {
+        for (int i = 0; i < t->NumElements(); ++i) {
+          t->flat<float>()(i) = (instance_key - 100 + 1) * (rank + 1) * i;
+        }
+      });
+      launches.push_back(launch);
+    }
+  }
+  for (FakeLaunch* launch : launches) {
+    EXPECT_TRUE(launch->Enqueue(fuser_.get()));
+  }
+  // The second complete instance reaches the 128 byte threshold and is
+  // flushed inline, so everything is done by now; the wait only covers the
+  // case where the trailing-buffer timer flushed the first instance early.
+  WaitForAllDone();
+  for (int32 instance_key : {100, 101}) {
+    // merge_op Add then final_op Div by group size: mean of ranks' inputs.
+    std::vector<float> expected(kLen);
+    for (int i = 0; i < kLen; ++i) {
+      expected[i] = (instance_key - 100 + 1) * (1 + 2) * i / 2.0f;
+    }
+    for (FakeLaunch* launch : launches) {
+      TF_EXPECT_OK(launch->status());
+    }
+    test::ExpectTensorEqual<float>(
+        test::AsTensor<float>(expected),
+        launches[(instance_key - 100) * 2]->output());
+    test::ExpectTensorEqual<float>(
+        test::AsTensor<float>(expected),
+        launches[(instance_key - 100) * 2 + 1]->output());
+  }
+}
+
+TEST_F(CollectiveReduceFuserTest, TimerFlushesTrailingPartialBuffer) {
+  Init(/*num_devices=*/2, /*max_fusion_bytes=*/1 << 20);
+  FakeLaunch* launch0 = AddLaunch(0, /*instance_key=*/100, /*tensor_len=*/8);
+  FakeLaunch* launch1 = AddLaunch(1, /*instance_key=*/100, /*tensor_len=*/8);
+  launch0->InitTensor([](Tensor* t) {
+    for (int i = 0; i < t->NumElements(); ++i) t->flat<float>()(i) = i;
+  });
+  launch1->InitTensor([](Tensor* t) {
+    for (int i = 0; i < t->NumElements(); ++i) t->flat<float>()(i) = 3 * i;
+  });
+  EXPECT_TRUE(launch0->Enqueue(fuser_.get()));
+  EXPECT_TRUE(launch1->Enqueue(fuser_.get()));
+  // Well under the threshold, so only the flush timer completes this.
+  WaitForAllDone();
+  TF_EXPECT_OK(launch0->status());
+  TF_EXPECT_OK(launch1->status());
+  std::vector<float> expected(8);
+  for (int i = 0; i < 8; ++i) expected[i] = 2.0f * i;
+  test::ExpectTensorEqual<float>(test::AsTensor<float>(expected),
+                                 launch0->output());
+  test::ExpectTensorEqual<float>(test::AsTensor<float>(expected),
+                                 launch1->output());
+}
+
+TEST_F(CollectiveReduceFuserTest, RejectsTensorLargerThanThreshold) {
+  Init(/*num_devices=*/2, /*max_fusion_bytes=*/128);
+  FakeLaunch* launch = AddLaunch(0, /*instance_key=*/100, /*tensor_len=*/64);
+  EXPECT_FALSE(launch->Enqueue(fuser_.get()));
+  EXPECT_FALSE(launch->done());
+}
+
+TEST_F(CollectiveReduceFuserTest, AbortFailsBufferedLaunches) {
+  Init(/*num_devices=*/2, /*max_fusion_bytes=*/1 << 20);
+  FakeLaunch* launch0 = AddLaunch(0, /*instance_key=*/100, /*tensor_len=*/8);
+  FakeLaunch* launch1 = AddLaunch(1, /*instance_key=*/100, /*tensor_len=*/8);
+  EXPECT_TRUE(launch0->Enqueue(fuser_.get()));
+  fuser_->Abort(errors::Aborted("test abort"));
+  EXPECT_TRUE(launch0->done());
+  EXPECT_TRUE(errors::IsAborted(launch0->status()));
+  // After an abort the fuser stands aside and launches take the normal path.
+  EXPECT_FALSE(launch1->Enqueue(fuser_.get()));
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/common_runtime/pinned_staging_buffer_pool.h"
 #include "tensorflow/core/framework/device_factory.h"
 #include "tensorflow/core/framework/variant_op_registry.h"
 #include "tensorflow/core/lib/core/errors.h"
@@ -44,6 +45,11 @@ struct RegistrationInfo {
   bool is_pluggable_device;
 };
 
+// Host tensors at least this large are staged through a pinned buffer when
+// they did not come from a GPU-compatible allocator. Below this size the
+// extra host memcpy costs more than the pageable-copy slowdown it avoids.
+constexpr size_t kMinBytesToStagePinned = 64 * 1024;
+
 // We use a vector instead of a map since we expect there to be very
 // few registrations.
 std::vector<RegistrationInfo>* MutableRegistry() {
@@ -288,6 +294,30 @@ void CopyTensor::ViaDMA(StringPiece edge_name, DeviceContext* send_dev_context,
   // E.g., cpu -> gpu
   if (!non_cpu_src && non_cpu_dst) {
     // Host to Device copy.
+    //
+    // Feeds and other host tensors that did not come from the GPU-compatible
+    // (pinned) allocator force the DMA engine through a pageable-memory slow
+    // path. For large enough tensors, staging through a pooled pinned buffer
+    // costs one extra host memcpy but roughly doubles the achievable
+    // host-to-device bandwidth.
+    if (!src_alloc_attr.gpu_compatible() && DMAHelper::CanUseDMA(input) &&
+        input->TotalBytes() >= kMinBytesToStagePinned) {
+      Tensor* staged = new Tensor;
+      if (PinnedStagingBufferPool::Get(cpu_allocator)
+              ->MakeStagingCopy(*input, staged)) {
+        // The staging tensor must stay alive until the device copy completes.
+        auto delete_and_done = [staged,
+                                done = std::move(done)](const Status& status) {
+          delete staged;
+          done(status);
+        };
+        CopyHostToDevice(staged, cpu_allocator, out_allocator, edge_name, dst,
+                         output, recv_dev_context, std::move(delete_and_done),
+                         sync_dst_compute);
+        return;
+      }
+      delete staged;
+    }
     CopyHostToDevice(input, cpu_allocator, out_allocator, edge_name, dst,
                      output, recv_dev_context, std::move(done),
                      sync_dst_compute);
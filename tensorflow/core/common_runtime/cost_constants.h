@@ -21,6 +21,7 @@ namespace tensorflow {
 // Types of per-request cost.
 inline constexpr char kTpuCostName[] = "tpu";
 inline constexpr char kGcuCostName[] = "gcu";
+inline constexpr char kCpuCostName[] = "cpu";
 inline constexpr char kNoOpCostName[] = "no_op";
 
 // Each type of per-request cost could have the following versions.
@@ -36,6 +37,14 @@ inline constexpr char kTpuWithSmearCostName[] = "tpu_with_smear";
 inline constexpr char kTpuNoSmearCostName[] = "tpu_no_smear";
 inline constexpr char kGcuWithSmearCostName[] = "gcu_with_smear";
 inline constexpr char kGcuNoSmearCostName[] = "gcu_no_smear";
+inline constexpr char kCpuWithSmearCostName[] = "cpu_with_smear";
+inline constexpr char kCpuNoSmearCostName[] = "cpu_no_smear";
+
+// Metrics recorded per request in addition to costs, describing how the
+// request was batched. Sizes are in units of the batching dimension.
+inline constexpr char kProcessedSizeMetricName[] = "processed_size";
+inline constexpr char kInputSizeMetricName[] = "input_size";
+inline constexpr char kPaddingSizeMetricName[] = "padding_size";
 
 }  // namespace tensorflow
 
@@ -0,0 +1,65 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/cpu_cost_measurement.h"
+
+#include <ctime>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_constants.h"
+#include "tensorflow/core/common_runtime/cost_measurement_registry.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Returns the CPU time consumed by the process so far, or zero on platforms
+// without a process CPU clock.
+absl::Duration ProcessCpuTime() {
+#if defined(_WIN32)
+  return absl::ZeroDuration();
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+    return absl::ZeroDuration();
+  }
+  return absl::Seconds(ts.tv_sec) + absl::Nanoseconds(ts.tv_nsec);
+#endif
+}
+
+}  // namespace
+
+CpuCostMeasurement::CpuCostMeasurement(const Context& context)
+    : CostMeasurement(context), start_cpu_time_(ProcessCpuTime()) {}
+
+absl::Duration CpuCostMeasurement::GetTotalCost() {
+  if (!cost_latched_) {
+    total_cost_ = ProcessCpuTime() - start_cpu_time_;
+    if (total_cost_ < absl::ZeroDuration()) {
+      total_cost_ = absl::ZeroDuration();
+    }
+    cost_latched_ = true;
+  }
+  return total_cost_;
+}
+
+absl::string_view CpuCostMeasurement::GetCostType() const {
+  return kCpuCostName;
+}
+
+REGISTER_COST_MEASUREMENT(kCpuCostName, CpuCostMeasurement);
+
+}  // namespace tensorflow
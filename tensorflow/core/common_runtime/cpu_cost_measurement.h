@@ -0,0 +1,51 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_measurement.h"
+
+namespace tensorflow {
+
+// Measures the CPU time consumed by the process between the construction of
+// this object and the first call to GetTotalCost().
+//
+// Because the delta covers every thread of the process, concurrent work that
+// is unrelated to the measured request or batch is included; the result
+// should be treated as a smeared estimate and attributed proportionally, the
+// same way batching splits accelerator costs.
+class CpuCostMeasurement : public CostMeasurement {
+ public:
+  explicit CpuCostMeasurement(const Context& context);
+
+  // Returns the process CPU time consumed since construction. The cost is
+  // latched on the first call; subsequent calls return the same value.
+  absl::Duration GetTotalCost() override;
+  absl::string_view GetCostType() const override;
+
+ private:
+  // Process CPU time at construction.
+  absl::Duration start_cpu_time_;
+  // Measured cost, latched by the first GetTotalCost() call.
+  absl::Duration total_cost_;
+  bool cost_latched_ = false;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_CPU_COST_MEASUREMENT_H_
@@ -0,0 +1,55 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/cpu_cost_measurement.h"
+
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_measurement.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(CpuCostMeasurementTest, CostIsNonNegative) {
+  CostMeasurement::Context context;
+  CpuCostMeasurement measurement(context);
+  // Burn some CPU so that the delta is measurable on platforms that support
+  // a process CPU clock.
+  volatile double sum = 0;
+  for (int i = 0; i < (1 << 20); ++i) {
+    sum += i;
+  }
+  EXPECT_GE(measurement.GetTotalCost(), absl::ZeroDuration());
+}
+
+TEST(CpuCostMeasurementTest, CostIsLatched) {
+  CostMeasurement::Context context;
+  CpuCostMeasurement measurement(context);
+  const absl::Duration first = measurement.GetTotalCost();
+  volatile double sum = 0;
+  for (int i = 0; i < (1 << 20); ++i) {
+    sum += i;
+  }
+  EXPECT_EQ(measurement.GetTotalCost(), first);
+}
+
+TEST(CpuCostMeasurementTest, CostType) {
+  CostMeasurement::Context context;
+  CpuCostMeasurement measurement(context);
+  EXPECT_EQ(measurement.GetCostType(), "cpu");
+}
+
+}  // namespace
+}  // namespace tensorflow
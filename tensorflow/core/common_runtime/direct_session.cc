@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
+#include "tensorflow/core/common_runtime/step_arena.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -50,6 +51,7 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/run_handler.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/graph.h"
@@ -444,8 +446,11 @@ Status DirectSession::ExtendLocked(GraphDef&& graph) {
     options.device_set = &device_set_;
     options.session_options = &options_;
     options.session_handle = session_handle_;
-    TF_RETURN_IF_ERROR(GraphExecutionState::MakeForBaseGraph(
-        std::move(graph), options, &execution_state_));
+    std::unique_ptr<GraphExecutionState> state;
+    TF_RETURN_IF_ERROR(
+        GraphExecutionState::MakeForBaseGraph(std::move(graph), options,
+                                              &state));
+    execution_state_ = std::move(state);
     // NOTE(mrry): The function library created here will be used for
     // all subsequent extensions of the graph. Also, note how using the copy
     // constructor of FunctionLibraryDefinition avoids duplicating the memory
@@ -458,12 +463,49 @@ Status DirectSession::ExtendLocked(GraphDef&& graph) {
     // TODO(mrry): Rewrite GraphExecutionState::Extend() to take `graph` by
     // value and move `graph` in here.
     TF_RETURN_IF_ERROR(execution_state_->Extend(graph, &state));
-    execution_state_.swap(state);
+    execution_state_ = std::move(state);
     TF_RETURN_IF_ERROR(flib_def_->AddLibrary(graph.library()));
   }
   return OkStatus();
 }
 
+Status DirectSession::Clone(std::unique_ptr<Session>* out_clone) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  if (factory_ == nullptr) {
+    return errors::Unimplemented(
+        "Clone is not supported for sessions created without a factory.");
+  }
+
+  Session* raw_clone = nullptr;
+  TF_RETURN_IF_ERROR(factory_->NewSession(options_, &raw_clone));
+  std::unique_ptr<Session> clone(raw_clone);
+  // The factory that created this session only makes DirectSessions.
+  DirectSession* direct_clone = static_cast<DirectSession*>(raw_clone);
+
+  {
+    mutex_lock l(graph_state_lock_);
+    if (finalized_) {
+      return errors::FailedPrecondition("Session has been finalized.");
+    }
+    if (!graph_created_) {
+      return errors::FailedPrecondition(
+          "Clone called before a graph was created.");
+    }
+    mutex_lock clone_l(direct_clone->graph_state_lock_);
+    // Both sessions point at one placed and pre-optimized base graph, so the
+    // clone pays neither placement nor pre-optimization cost.  Executors and
+    // their kernels are still built lazily per session, against the clone's
+    // own devices; that is what keeps variables and other stateful resources
+    // private to each session.
+    direct_clone->execution_state_ = execution_state_;
+    // The copy constructor shares the function bodies via shared_ptr members.
+    direct_clone->flib_def_.reset(new FunctionLibraryDefinition(*flib_def_));
+    direct_clone->graph_created_ = true;
+  }
+  *out_clone = std::move(clone);
+  return OkStatus();
+}
+
 Status DirectSession::Run(const NamedTensorList& inputs,
                           const std::vector<string>& output_names,
                           const std::vector<string>& target_nodes,
@@ -654,8 +696,15 @@ Status DirectSession::RunInternal(
   const bool can_execute_synchronously =
       executors_and_keys->items.size() == 1 && call_timeout == 0;
 
+  // Transient executor allocations for this step (e.g. async kernel state)
+  // are bump-allocated from this arena and reclaimed in bulk when the step
+  // completes. Blocks are allocated lazily, so steps that never touch the
+  // arena pay nothing.
+  StepArena step_arena;
+
   Executor::Args args;
   args.step_id = step_id;
+  args.step_arena = &step_arena;
   args.call_frame = call_frame;
   args.collective_executor =
       (run_state.collective_executor ? run_state.collective_executor->get()
@@ -843,6 +892,67 @@ Status DirectSession::Run(const RunOptions& run_options,
              run_metadata, thread::ThreadPoolOptions());
 }
 
+Status DirectSession::GetOrCreateRunPlan(
+    const NamedTensorList& inputs, const std::vector<string>& output_names,
+    ExecutorsAndKeys* executors_and_keys, std::shared_ptr<RunPlan>* plan) {
+  // Key on the exact (ordered) signature; the executors themselves are cached
+  // under a sorted key, so one ExecutorsAndKeys may serve several orderings.
+  string key;
+  key.reserve(64);
+  for (const auto& it : inputs) {
+    strings::StrAppend(&key, it.first, ",");
+  }
+  strings::StrAppend(&key, "->");
+  for (const string& name : output_names) {
+    strings::StrAppend(&key, name, ",");
+  }
+
+  {
+    tf_shared_lock l(executors_and_keys->run_plans_mu);
+    auto it = executors_and_keys->run_plans.find(key);
+    if (it != executors_and_keys->run_plans.end()) {
+      *plan = it->second;
+      return OkStatus();
+    }
+  }
+
+  auto fresh = std::make_shared<RunPlan>();
+  fresh->feed_slots.reserve(inputs.size());
+  for (const auto& it : inputs) {
+    auto slot = executors_and_keys->input_name_to_index.find(it.first);
+    if (slot == executors_and_keys->input_name_to_index.end()) {
+      return errors::Internal("Feed tensor '", it.first,
+                              "' has no slot in the executor's call frame.");
+    }
+    fresh->feed_slots.push_back(slot->second);
+  }
+  fresh->fetch_slots.reserve(output_names.size());
+  for (const string& name : output_names) {
+    auto slot = executors_and_keys->output_name_to_index.find(name);
+    if (slot == executors_and_keys->output_name_to_index.end()) {
+      return errors::Internal("Fetch tensor '", name,
+                              "' has no slot in the executor's call frame.");
+    }
+    fresh->fetch_slots.push_back(slot->second);
+  }
+  if (output_names.size() != executors_and_keys->output_name_to_index.size()) {
+    // Duplicate fetches: precompute, for each position, the first position
+    // naming the same tensor so Run() can alias instead of re-consuming.
+    fresh->first_indices.reserve(output_names.size());
+    for (const auto& name : output_names) {
+      fresh->first_indices.push_back(
+          std::find(output_names.begin(), output_names.end(), name) -
+          output_names.begin());
+    }
+  }
+
+  mutex_lock l(executors_and_keys->run_plans_mu);
+  auto insert_result = executors_and_keys->run_plans.emplace(key, fresh);
+  // If another thread won the race, use its plan; they are equivalent.
+  *plan = insert_result.first->second;
+  return OkStatus();
+}
+
 Status DirectSession::Run(const RunOptions& run_options,
                           const NamedTensorList& inputs,
                           const std::vector<string>& output_names,
@@ -878,20 +988,26 @@ Status DirectSession::Run(const RunOptions& run_options,
     collective_graph_key_ = executors_and_keys->collective_graph_key;
   }
 
+  // Look up (or build, on the first call with this signature) the pre-baked
+  // plan that maps the caller's feed/fetch order to call frame slots.
+  std::shared_ptr<RunPlan> run_plan;
+  TF_RETURN_IF_ERROR(
+      GetOrCreateRunPlan(inputs, output_names, executors_and_keys, &run_plan));
+
   // Configure a call frame for the step, which we use to feed and
   // fetch values to and from the executors.
   FunctionCallFrame call_frame(executors_and_keys->input_types,
                                executors_and_keys->output_types);
   gtl::InlinedVector<Tensor, 4> feed_args(inputs.size());
-  for (const auto& it : inputs) {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const auto& it = inputs[i];
     if (it.second.dtype() == DT_RESOURCE) {
       Tensor tensor_from_handle;
       TF_RETURN_IF_ERROR(
           ResourceHandleToInputTensor(it.second, &tensor_from_handle));
-      feed_args[executors_and_keys->input_name_to_index[it.first]] =
-          tensor_from_handle;
+      feed_args[run_plan->feed_slots[i]] = tensor_from_handle;
     } else {
-      feed_args[executors_and_keys->input_name_to_index[it.first]] = it.second;
+      feed_args[run_plan->feed_slots[i]] = it.second;
     }
   }
   const Status s = call_frame.SetArgs(feed_args);
@@ -921,28 +1037,16 @@ Status DirectSession::Run(const RunOptions& run_options,
     } else if (!s.ok()) {
       return s;
     }
-    const bool unique_outputs =
-        output_names.size() == executors_and_keys->output_name_to_index.size();
-    // first_indices[i] = j implies that j is the smallest value for which
-    // output_names[i] == output_names[j].
-    std::vector<int> first_indices;
-    if (!unique_outputs) {
-      first_indices.reserve(output_names.size());
-      for (const auto& name : output_names) {
-        first_indices.push_back(
-            std::find(output_names.begin(), output_names.end(), name) -
-            output_names.begin());
-      }
-    }
+    // first_indices (precomputed in the plan) is empty iff the fetches are
+    // unique.
+    const std::vector<int>& first_indices = run_plan->first_indices;
     outputs->clear();
     size_t output_size = 0;
     outputs->reserve(sorted_outputs.size());
     for (int i = 0; i < output_names.size(); ++i) {
-      const string& output_name = output_names[i];
       if (first_indices.empty() || first_indices[i] == i) {
         outputs->emplace_back(
-            std::move(sorted_outputs[executors_and_keys
-                                         ->output_name_to_index[output_name]]));
+            std::move(sorted_outputs[run_plan->fetch_slots[i]]));
       } else {
         outputs->push_back((*outputs)[first_indices[i]]);
       }
@@ -954,6 +1058,22 @@ Status DirectSession::Run(const RunOptions& run_options,
   return OkStatus();
 }
 
+Status DirectSession::WarmupSignature(const std::vector<string>& input_names,
+                                      const std::vector<string>& output_names,
+                                      const std::vector<string>& target_nodes) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  TF_RETURN_IF_ERROR(CheckGraphCreated("WarmupSignature()"));
+
+  // Building the executors is what prunes the graph to this signature and
+  // instantiates every kernel in it, so a warmed-up signature pays none of
+  // that cost on its first Run() call.
+  ExecutorsAndKeys* executors_and_keys;
+  DebugOptions debug_options;
+  RunStateArgs run_state_args(debug_options);
+  return GetOrCreateExecutors(input_names, output_names, target_nodes,
+                              &executors_and_keys, &run_state_args);
+}
+
 Status DirectSession::PRunSetup(const std::vector<string>& input_names,
                                 const std::vector<string>& output_names,
                                 const std::vector<string>& target_nodes,
@@ -1856,20 +1976,114 @@ void DirectSession::WaitForNotification(Notification* n, RunState* run_state,
   return OkStatus();
 }
 
+Status DirectSession::CreatePersistentTensorSlots(
+    const CallableOptions& callable_options, CallableOptions* out_options,
+    std::shared_ptr<PersistentTensorSlots>* out_slots) {
+  *out_options = callable_options;
+  auto slots = std::make_shared<PersistentTensorSlots>();
+  for (const auto& slot : callable_options.persistent_tensor_slot()) {
+    if (slot.feed().empty() || slot.fetch().empty()) {
+      return errors::InvalidArgument(
+          "Persistent tensor slots must name both a feed and a fetch tensor");
+    }
+    if (!DataTypeCanUseMemcpy(slot.dtype())) {
+      return errors::InvalidArgument(
+          "Persistent tensor slot for '", slot.feed(),
+          "' must have a plain-old-data type, got ",
+          DataTypeString(slot.dtype()));
+    }
+    const PartialTensorShape element_shape(slot.element_shape());
+    if (!element_shape.IsFullyDefined()) {
+      return errors::InvalidArgument(
+          "Persistent tensor slot for '", slot.feed(),
+          "' must have a fully defined element shape, got ",
+          element_shape.DebugString());
+    }
+    // The slot's feed and fetch become trailing arguments and return values
+    // of the executors; RunCallable() supplies and consumes them on behalf
+    // of the caller.
+    out_options->add_feed(slot.feed());
+    out_options->add_fetch(slot.fetch());
+  }
+  {
+    mutex_lock l(slots->mu);
+    slots->states.resize(callable_options.persistent_tensor_slot_size());
+  }
+  *out_slots = std::move(slots);
+  return OkStatus();
+}
+
+Status DirectSession::AppendToPersistentTensorSlot(
+    const CallableOptions::PersistentTensorSlot& slot, const Tensor& update,
+    PersistentTensorSlotState* state) {
+  if (update.dtype() != slot.dtype()) {
+    return errors::InvalidArgument(
+        "Persistent tensor slot update '", slot.fetch(), "' must have type ",
+        DataTypeString(slot.dtype()), ", got ",
+        DataTypeString(update.dtype()));
+  }
+  const TensorShape element_shape(slot.element_shape());
+  TensorShape update_element_shape = update.shape();
+  if (update.dims() >= 1) update_element_shape.RemoveDim(0);
+  if (update.dims() < 1 || update_element_shape != element_shape) {
+    return errors::InvalidArgument(
+        "Persistent tensor slot update '", slot.fetch(),
+        "' must have shape [n] + ", element_shape.DebugString(), ", got ",
+        update.shape().DebugString());
+  }
+  const int64_t rows = update.dim_size(0);
+  if (rows == 0) return OkStatus();
+
+  const int64_t row_bytes =
+      DataTypeSize(slot.dtype()) * element_shape.num_elements();
+  const int64_t capacity =
+      state->buffer.dims() > 0 ? state->buffer.dim_size(0) : 0;
+  if (state->length + rows > capacity) {
+    // Grow geometrically so appending a row is amortized O(row_bytes). Any
+    // in-flight step keeps the old buffer alive through its sliced view.
+    const int64_t new_capacity =
+        std::max<int64_t>(state->length + rows, 2 * capacity);
+    TensorShape buffer_shape = element_shape;
+    buffer_shape.InsertDim(0, new_capacity);
+    Tensor new_buffer(slot.dtype(), buffer_shape);
+    if (state->length > 0) {
+      memcpy(new_buffer.data(), state->buffer.data(),
+             state->length * row_bytes);
+    }
+    state->buffer = std::move(new_buffer);
+  }
+  // The fed view covers rows [0, length), so writing the new rows does not
+  // race with a concurrent step reading the accumulated value.
+  memcpy(static_cast<char*>(state->buffer.data()) + state->length * row_bytes,
+         update.data(), rows * row_bytes);
+  state->length += rows;
+  return OkStatus();
+}
+
 Status DirectSession::MakeCallable(const CallableOptions& callable_options,
                                    CallableHandle* out_handle) {
   TF_RETURN_IF_ERROR(CheckNotClosed());
   TF_RETURN_IF_ERROR(CheckGraphCreated("MakeCallable()"));
 
+  const CallableOptions* options = &callable_options;
+  CallableOptions options_with_slots;
+  std::shared_ptr<PersistentTensorSlots> slots;
+  if (callable_options.persistent_tensor_slot_size() > 0) {
+    TF_RETURN_IF_ERROR(CreatePersistentTensorSlots(
+        callable_options, &options_with_slots, &slots));
+    options = &options_with_slots;
+  }
+
   std::unique_ptr<ExecutorsAndKeys> ek;
   std::unique_ptr<FunctionInfo> func_info;
-  RunStateArgs run_state_args(callable_options.run_options().debug_options());
+  RunStateArgs run_state_args(options->run_options().debug_options());
   TF_RETURN_IF_ERROR(
-      CreateExecutors(callable_options, &ek, &func_info, &run_state_args));
+      CreateExecutors(*options, &ek, &func_info, &run_state_args));
   {
     mutex_lock l(callables_lock_);
     *out_handle = next_callable_handle_++;
-    callables_[*out_handle] = {std::move(ek), std::move(func_info)};
+    callables_[*out_handle] = {std::move(ek), std::move(func_info),
+                               std::move(slots)};
   }
   return OkStatus();
 }
@@ -1933,6 +2147,7 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
 
   // Check if we already have an executor for these arguments.
   std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
+  std::shared_ptr<PersistentTensorSlots> slots;
   const int64_t step_id = step_id_counter_.fetch_add(1);
 
   {
@@ -1941,6 +2156,7 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
       return errors::InvalidArgument("No such callable handle: ", handle);
     }
     executors_and_keys = callables_[handle].executors_and_keys;
+    slots = callables_[handle].persistent_tensor_slots;
   }
 
   if (!executors_and_keys) {
@@ -1954,10 +2170,15 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
   RunStateArgs run_state_args(debug_options);
 
   // Configure a call frame for the step, which we use to feed and
-  // fetch values to and from the executors.
-  if (feed_tensors.size() != executors_and_keys->input_types.size()) {
+  // fetch values to and from the executors. Persistent tensor slots occupy
+  // the trailing feed and fetch positions and are supplied and consumed
+  // here rather than by the caller.
+  const int num_slots =
+      executors_and_keys->callable_options.persistent_tensor_slot_size();
+  if (feed_tensors.size() + num_slots !=
+      executors_and_keys->input_types.size()) {
     return errors::InvalidArgument(
-        "Expected ", executors_and_keys->input_types.size(),
+        "Expected ", executors_and_keys->input_types.size() - num_slots,
         " feed tensors, but got ", feed_tensors.size());
   }
   if (fetch_tensors != nullptr) {
@@ -1979,9 +2200,9 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
   std::unique_ptr<std::vector<Tensor>> converted_feed_tensors;
   const std::vector<Tensor>* actual_feed_tensors;
 
-  if (TF_PREDICT_FALSE(any_resource_feeds)) {
+  if (TF_PREDICT_FALSE(any_resource_feeds || num_slots > 0)) {
     converted_feed_tensors = std::make_unique<std::vector<Tensor>>();
-    converted_feed_tensors->reserve(feed_tensors.size());
+    converted_feed_tensors->reserve(feed_tensors.size() + num_slots);
     for (const Tensor& t : feed_tensors) {
       if (t.dtype() == DT_RESOURCE) {
         converted_feed_tensors->emplace_back();
@@ -1991,6 +2212,24 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
         converted_feed_tensors->emplace_back(t);
       }
     }
+    if (num_slots > 0) {
+      // Feed each slot's accumulated value as a view of the session-owned
+      // buffer, so the history is not copied on every step.
+      mutex_lock l(slots->mu);
+      for (int i = 0; i < num_slots; ++i) {
+        PersistentTensorSlotState& state = slots->states[i];
+        if (state.length > 0) {
+          converted_feed_tensors->emplace_back(
+              state.buffer.Slice(0, state.length));
+        } else {
+          const auto& slot =
+              executors_and_keys->callable_options.persistent_tensor_slot(i);
+          TensorShape empty_shape(slot.element_shape());
+          empty_shape.InsertDim(0, 0);
+          converted_feed_tensors->emplace_back(slot.dtype(), empty_shape);
+        }
+      }
+    }
     actual_feed_tensors = converted_feed_tensors.get();
   } else {
     actual_feed_tensors = &feed_tensors;
@@ -2009,6 +2248,19 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
       step_id, executors_and_keys->callable_options.run_options(), &call_frame,
       executors_and_keys.get(), run_metadata, threadpool_options));
 
+  if (num_slots > 0) {
+    // The trailing fetches hold the rows to append; fold them into the
+    // slots and return only the caller's fetches.
+    const size_t num_caller_fetches = fetch_tensors->size() - num_slots;
+    mutex_lock l(slots->mu);
+    for (int i = 0; i < num_slots; ++i) {
+      TF_RETURN_IF_ERROR(AppendToPersistentTensorSlot(
+          executors_and_keys->callable_options.persistent_tensor_slot(i),
+          (*fetch_tensors)[num_caller_fetches + i], &slots->states[i]));
+    }
+    fetch_tensors->resize(num_caller_fetches);
+  }
+
   if (fetch_tensors != nullptr) {
     size_t output_size = 0;
     for (auto& tensor : *fetch_tensors) {
@@ -102,6 +102,14 @@ class DirectSession : public Session {
                             const std::vector<string>& output_names,
                             std::vector<Tensor>* outputs) override;
 
+  // Prebuilds the executors (and instantiates their kernels) for the given
+  // feed/fetch/target signature without running a step.
+  // NOTE: Experimental and subject to change.
+  ::tensorflow::Status WarmupSignature(
+      const std::vector<string>& input_names,
+      const std::vector<string>& output_names,
+      const std::vector<string>& target_nodes) override;
+
   // Reset clears 'containers' from the device_mgr of the DirectSession.
   // If 'containers' is empty, then Reset clears the default container.
   ::tensorflow::Status Reset(const std::vector<string>& containers);
@@ -135,6 +143,13 @@ class DirectSession : public Session {
 
   ::tensorflow::Status Finalize() override;
 
+  // Creates a session that shares this session's placed and pre-optimized
+  // graph, but owns its own devices, resource managers and executors. The
+  // clone therefore skips the per-session graph setup cost while keeping
+  // stateful resources (variables, iterators, ...) private.
+  // NOTE: Experimental and subject to change.
+  ::tensorflow::Status Clone(std::unique_ptr<Session>* out_clone) override;
+
   const SessionOptions& options() const { return options_; }
 
  private:
@@ -150,6 +165,22 @@ class DirectSession : public Session {
     std::unique_ptr<Executor> executor;
   };
 
+  // A RunPlan precomputes, once per (ordered) feed/fetch signature, the
+  // mapping from the caller's feed and fetch order to FunctionCallFrame
+  // slots, so that steady-state Run() setup is reduced to indexed copies
+  // instead of per-name hash lookups. Since GetOrCreateExecutors() caches
+  // executors under a *sorted* signature, one ExecutorsAndKeys may serve
+  // several caller orderings, each with its own plan.
+  struct RunPlan {
+    // feed_slots[i] is the call frame argument slot for the i-th feed.
+    std::vector<size_t> feed_slots;
+    // fetch_slots[i] is the call frame return value slot for the i-th fetch.
+    std::vector<size_t> fetch_slots;
+    // first_indices[i] = j implies that j is the smallest value for which
+    // output_names[i] == output_names[j]; empty when all fetches are unique.
+    std::vector<int> first_indices;
+  };
+
   // An ExecutorsAndKeys is created for a given set of feeds/fetches.
   // 'step_count' is the number of times this graph is executed.
   // 'graph' is the entire graph being executed. 'name_to_node'
@@ -176,6 +207,12 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // Pre-baked plans for Run() calls against this executor, keyed by the
+    // exact (ordered) feed/fetch signature. See RunPlan.
+    mutex run_plans_mu;
+    std::unordered_map<string, std::shared_ptr<RunPlan>> run_plans
+        TF_GUARDED_BY(run_plans_mu);
   };
 
   // A FunctionInfo object is created for every unique set of feeds/fetches.
@@ -238,6 +275,13 @@ class DirectSession : public Session {
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
   };
 
+  // Retrieves the pre-baked RunPlan for the given (ordered) feed/fetch
+  // signature from 'executors_and_keys', building and caching it on first
+  // use.
+  ::tensorflow::Status GetOrCreateRunPlan(
+      const NamedTensorList& inputs, const std::vector<string>& output_names,
+      ExecutorsAndKeys* executors_and_keys, std::shared_ptr<RunPlan>* plan);
+
   // Retrieves an already existing set of executors to run 'inputs' and
   // 'outputs', or creates and caches them for future use.
   ::tensorflow::Status GetOrCreateExecutors(
@@ -280,6 +324,35 @@ class DirectSession : public Session {
   ::tensorflow::Status ResourceHandleToInputTensor(
       const Tensor& resource_tensor, Tensor* retrieved_tensor);
 
+  // Accumulated value of one persistent tensor slot (see
+  // CallableOptions.persistent_tensor_slot). The first `length` rows of
+  // `buffer` hold the value; `buffer` grows geometrically along dimension 0
+  // so an append does not copy the history on every step.
+  struct PersistentTensorSlotState {
+    Tensor buffer;
+    int64_t length = 0;
+  };
+
+  // State backing the persistent tensor slots of one callable, shared with
+  // in-flight RunCallable() calls.
+  struct PersistentTensorSlots {
+    mutex mu;
+    std::vector<PersistentTensorSlotState> states TF_GUARDED_BY(mu);
+  };
+
+  // Validates the persistent tensor slots declared in `callable_options`,
+  // returns in `*out_options` a copy with every slot's feed and fetch
+  // appended to the regular feed and fetch lists, and in `*out_slots` the
+  // state backing the slots.
+  ::tensorflow::Status CreatePersistentTensorSlots(
+      const CallableOptions& callable_options, CallableOptions* out_options,
+      std::shared_ptr<PersistentTensorSlots>* out_slots);
+
+  // Appends the rows of `update` to `state` along dimension 0.
+  ::tensorflow::Status AppendToPersistentTensorSlot(
+      const CallableOptions::PersistentTensorSlot& slot, const Tensor& update,
+      PersistentTensorSlotState* state);
+
   // Feeds more inputs to the executors, triggering further execution.
   ::tensorflow::Status SendPRunInputs(
       const std::vector<std::pair<string, Tensor>>& inputs,
@@ -371,6 +444,9 @@ class DirectSession : public Session {
   struct Callable {
     std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
     std::shared_ptr<FunctionInfo> function_info;
+    // Non-null iff the callable declares persistent tensor slots. Owned by
+    // the callable, so ReleaseCallable() discards the accumulated values.
+    std::shared_ptr<PersistentTensorSlots> persistent_tensor_slots;
     ~Callable();
   };
   mutex callables_lock_;
@@ -396,8 +472,9 @@ class DirectSession : public Session {
   std::unordered_map<string, string> stateful_placements_
       TF_GUARDED_BY(graph_state_lock_);
 
-  // Execution_state; used when placing the entire graph.
-  std::unique_ptr<GraphExecutionState> execution_state_
+  // Execution_state; used when placing the entire graph.  Shared between a
+  // session and its clones (see Clone()); GraphExecutionState is thread-safe.
+  std::shared_ptr<GraphExecutionState> execution_state_
       TF_GUARDED_BY(graph_state_lock_);
 
   // The function library, before any rewrites or optimizations have been
@@ -153,6 +153,64 @@ TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork) {
   EXPECT_FLOAT_EQ(5.0, mat(0, 0));
 }
 
+TEST_F(DirectSessionMinusAXTest, WarmupSignature) {
+  Initialize({3, 2, -1, 0});
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+
+  // Warming up before the graph exists is an error.
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+  Status s = session->WarmupSignature({}, output_names, target_nodes);
+  EXPECT_FALSE(s.ok());
+
+  TF_ASSERT_OK(session->Create(def_));
+  TF_ASSERT_OK(session->WarmupSignature({}, output_names, target_nodes));
+
+  // A Run() with the warmed-up signature reuses the prebuilt executors and
+  // produces the usual results.
+  std::vector<std::pair<string, Tensor>> inputs;
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(session->Run(inputs, output_names, target_nodes, &outputs));
+
+  ASSERT_EQ(1, outputs.size());
+  auto mat = outputs[0].matrix<float>();
+  ASSERT_TRUE(outputs[0].IsInitialized());
+  EXPECT_FLOAT_EQ(5.0, mat(0, 0));
+}
+
+TEST_F(DirectSessionMinusAXTest, CloneRunsSharedGraph) {
+  Initialize({3, 2, -1, 0});
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+
+  // Cloning before the graph exists is an error.
+  std::unique_ptr<Session> clone;
+  Status s = session->Clone(&clone);
+  EXPECT_FALSE(s.ok());
+
+  TF_ASSERT_OK(session->Create(def_));
+  TF_ASSERT_OK(session->Clone(&clone));
+  ASSERT_TRUE(clone != nullptr);
+
+  // Both the original session and the clone run the shared graph.
+  std::vector<std::pair<string, Tensor>> inputs;
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+  for (Session* sess : {session.get(), clone.get()}) {
+    std::vector<Tensor> outputs;
+    TF_ASSERT_OK(sess->Run(inputs, output_names, target_nodes, &outputs));
+    ASSERT_EQ(1, outputs.size());
+    auto mat = outputs[0].matrix<float>();
+    ASSERT_TRUE(outputs[0].IsInitialized());
+    EXPECT_FLOAT_EQ(5.0, mat(0, 0));
+  }
+
+  // The clone already shares a graph, so creating another one is an error.
+  s = clone->Create(def_);
+  EXPECT_TRUE(errors::IsAlreadyExists(s));
+}
+
 TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork_Callable) {
   Initialize({3, 2, -1, 0});
   auto session = CreateSession();
@@ -551,6 +609,76 @@ TEST_F(DirectSessionMinusAXTest, TestFeed_Callable) {
   EXPECT_FLOAT_EQ(39.0, mat(1, 0));
 }
 
+TEST(DirectSessionPersistentTensorSlotTest, AppendsFetchedRowsAcrossRuns) {
+  Graph graph(OpRegistry::Global());
+
+  // `token` stands in for the new step's data and is fed by the caller;
+  // `cache` is fed by the session with the accumulated history. Identity
+  // nodes give the slot's fetch and the caller's fetch names that are
+  // distinct from the fed tensors.
+  Tensor zero(DT_FLOAT, TensorShape({1}));
+  zero.flat<float>()(0) = 0.0f;
+  Node* token = test::graph::Constant(&graph, zero);
+  Node* cache = test::graph::Constant(&graph, Tensor(DT_FLOAT, {0}));
+  Node* new_rows = test::graph::Identity(&graph, token);
+  Node* history = test::graph::Identity(&graph, cache);
+
+  GraphDef def;
+  graph.ToGraphDef(&def);
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+
+  CallableOptions callable_options;
+  callable_options.add_feed(token->name() + ":0");
+  callable_options.add_fetch(history->name() + ":0");
+  CallableOptions::PersistentTensorSlot* slot =
+      callable_options.add_persistent_tensor_slot();
+  slot->set_feed(cache->name() + ":0");
+  slot->set_fetch(new_rows->name() + ":0");
+  slot->set_dtype(DT_FLOAT);
+  slot->mutable_element_shape();  // Scalar rows: the cache has shape [n].
+
+  Session::CallableHandle handle;
+  TF_ASSERT_OK(session->MakeCallable(callable_options, &handle));
+
+  // Each step feeds only the new token; the fetched history holds the
+  // tokens of all previous steps.
+  for (int step = 0; step < 3; ++step) {
+    Tensor token_value(DT_FLOAT, TensorShape({1}));
+    token_value.flat<float>()(0) = static_cast<float>(step + 1);
+    std::vector<Tensor> outputs;
+    TF_ASSERT_OK(
+        session->RunCallable(handle, {token_value}, &outputs, nullptr));
+    ASSERT_EQ(1, outputs.size());
+    ASSERT_EQ(step, outputs[0].NumElements());
+    for (int i = 0; i < step; ++i) {
+      EXPECT_FLOAT_EQ(i + 1, outputs[0].flat<float>()(i));
+    }
+  }
+
+  // The slot is fed by the session, not the caller.
+  Tensor token_value(DT_FLOAT, TensorShape({1}));
+  token_value.flat<float>()(0) = 4.0f;
+  std::vector<Tensor> outputs;
+  Status s = session->RunCallable(handle, {token_value, token_value},
+                                  &outputs, nullptr);
+  EXPECT_TRUE(errors::IsInvalidArgument(s));
+
+  // Releasing the callable discards the accumulated value.
+  TF_ASSERT_OK(session->ReleaseCallable(handle));
+  TF_ASSERT_OK(session->MakeCallable(callable_options, &handle));
+  TF_ASSERT_OK(session->RunCallable(handle, {token_value}, &outputs, nullptr));
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_EQ(0, outputs[0].NumElements());
+  TF_ASSERT_OK(session->ReleaseCallable(handle));
+
+  // Slots must have a fully defined element shape.
+  slot->mutable_element_shape()->add_dim()->set_size(-1);
+  Status make_status = session->MakeCallable(callable_options, &handle);
+  EXPECT_TRUE(errors::IsInvalidArgument(make_status));
+}
+
 TEST_F(DirectSessionMinusAXTest, TestConcurrency) {
   Initialize({1, 2, 3, 4});
   auto session = CreateSession();
@@ -91,10 +91,32 @@ auto* eager_context_created =
     monitoring::Gauge<bool, 0>::New("/tensorflow/core/eager_context_created",
                                     "True if an eager context was created.");
 
+struct KernelCacheTeardownObservers {
+  mutex mu;
+  std::vector<void (*)(uint64)> observers TF_GUARDED_BY(mu);
+};
+
+KernelCacheTeardownObservers* GetKernelCacheTeardownObservers() {
+  static KernelCacheTeardownObservers* observers =
+      new KernelCacheTeardownObservers;
+  return observers;
+}
+
 }  // namespace
 
 const int64_t EagerContext::kGlobalRendezvousId = -1;
 
+uint64 EagerContext::NextKernelCacheContextId() {
+  static std::atomic<uint64> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void EagerContext::AddKernelCacheTeardownObserver(void (*observer)(uint64)) {
+  KernelCacheTeardownObservers* observers = GetKernelCacheTeardownObservers();
+  mutex_lock l(observers->mu);
+  observers->observers.push_back(observer);
+}
+
 // Find the rendezvous instance corresponding to the step id, or create a
 // new instance if not existing.
 IntraProcessRendezvous* EagerContext::LocalRendezvousTable::FindOrCreate(
@@ -164,7 +186,9 @@ EagerContext::EagerContext(
       num_active_steps_(0),
       step_container_(std::make_unique<ScopedStepContainer>(
           0, [this](const string& name) { ClearResourceContainer(name); })),
-      default_executor_(async, /*enable_streaming_enqueue=*/true),
+      default_executor_(async, /*enable_streaming_enqueue=*/true,
+                        ReadBoolFromEnvVar("TF_EAGER_PER_DEVICE_QUEUES",
+                                           false)),
       log_memory_(LogMemory::IsEnabled()),
       env_(opts.env),
       collective_executor_mgr_(collective_executor_mgr, /*owned=*/false),
@@ -486,6 +510,7 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
   mutex_lock ml(cache_mu_);
   default_executor_.WaitForAllPendingNodes().IgnoreError();
   kernel_cache_.clear();
+  kernel_cache_generation_.fetch_add(1, std::memory_order_acq_rel);
   for (auto& entry : registered_functions_) {
     entry.second->cached_kernel_keys->clear();
   }
@@ -627,6 +652,17 @@ void EagerContext::WaitForAndCloseRemoteContexts() {
 }
 
 EagerContext::~EagerContext() {
+  // Drop per-thread kernel cache entries first, so they do not hold kernel
+  // (and device) references past the teardown below.
+  {
+    KernelCacheTeardownObservers* observers =
+        GetKernelCacheTeardownObservers();
+    mutex_lock l(observers->mu);
+    for (void (*observer)(uint64) : observers->observers) {
+      observer(kernel_cache_context_id_);
+    }
+  }
+
   // TODO(iga): Add a separate API method to shutdown EagerContext so that we
   // don't send RPCs and block in destructor.
   WaitForAndCloseRemoteContexts();
@@ -1007,6 +1043,7 @@ Status EagerContext::RemoveFunction(const string& func) {
     for (auto& key : *registered_function->cached_kernel_keys) {
       kernel_cache_.erase(key);
     }
+    kernel_cache_generation_.fetch_add(1, std::memory_order_acq_rel);
     registered_functions_.erase(func);
   }
   registered_function->Unref();
@@ -265,6 +265,26 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
   void AddKernelToCache(Fprint128 cache_key, KernelAndDevice* kernel);
   void AddDeviceToCache(Fprint128 device_cache_key, Device* device);
 
+  // Generation counter for the kernel cache, bumped whenever cached kernels
+  // are invalidated. Lets per-thread kernel caches detect staleness without
+  // taking cache_mu_.
+  uint64 kernel_cache_generation() const {
+    return kernel_cache_generation_.load(std::memory_order_acquire);
+  }
+
+  // Process-unique id for this context, minted at construction. Per-thread
+  // kernel caches key their entries on it rather than on the context
+  // pointer, so a context allocated at the address of a destroyed one can
+  // never be mistaken for its predecessor.
+  uint64 kernel_cache_context_id() const { return kernel_cache_context_id_; }
+
+  // Registers `observer` to be called with a context's
+  // kernel_cache_context_id() when that context is destroyed. Lets
+  // per-thread kernel caches drop their entries (and the kernel references
+  // they hold) at context teardown instead of whenever the owning thread
+  // happens to touch another context. Observers are never deregistered.
+  static void AddKernelCacheTeardownObserver(void (*observer)(uint64));
+
   bool LogDevicePlacement() const { return log_device_placement_; }
   void SetLogDevicePlacement(bool enable) override {
     log_device_placement_ = enable;
@@ -721,6 +741,11 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
       kernel_cache_ TF_GUARDED_BY(cache_mu_);
   std::unordered_map<string, RegisteredFunction*> registered_functions_
       TF_GUARDED_BY(cache_mu_);
+  // Returns the next process-unique kernel cache context id.
+  static uint64 NextKernelCacheContextId();
+
+  std::atomic<uint64> kernel_cache_generation_{0};
+  const uint64 kernel_cache_context_id_ = NextKernelCacheContextId();
   absl::flat_hash_map<Fprint128, Device*, Fprint128Hasher> device_cache_
       TF_GUARDED_BY(device_cache_mu_);
 
@@ -69,6 +69,10 @@ class CopyToDeviceNode : public EagerNode {
 
   void Abort(Status status) override { dst_->Poison(status, dstd_); }
 
+  string DeviceName() const override {
+    return dstd_ == nullptr ? string() : dstd_->name();
+  }
+
   string DebugString() const override {
     string out = "[CopyToDeviceNode]";
     strings::StrAppend(&out, " src_tensor: ", src_->DebugString());
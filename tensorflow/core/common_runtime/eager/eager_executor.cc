@@ -31,7 +31,8 @@ bool IsAsyncWaitForRemoteFunctionEnabled() {
 }
 }  // namespace
 
-EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue)
+EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
+                             bool enable_per_device_queues)
     : next_node_id_(0),
       ok_(true),
       thread_(async ? tensorflow::Env::Default()->StartThread(
@@ -41,7 +42,8 @@ EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue)
       last_eager_client_(nullptr),
       enable_async_wait_for_remote_function_(
           IsAsyncWaitForRemoteFunctionEnabled()),
-      enable_streaming_enqueue_(enable_streaming_enqueue) {}
+      enable_streaming_enqueue_(enable_streaming_enqueue),
+      enable_per_device_queues_(async && enable_per_device_queues) {}
 
 EagerExecutor::~EagerExecutor() {
   tensorflow::mutex_lock l(node_queue_mutex_);
@@ -54,7 +56,34 @@ EagerExecutor::~EagerExecutor() {
   }
 }
 
+EagerExecutor* EagerExecutor::GetOrCreateDeviceExecutor(const string& device) {
+  mutex_lock l(device_executors_mu_);
+  std::unique_ptr<EagerExecutor>& executor = device_executors_[device];
+  if (executor == nullptr) {
+    // Device queues do not route further; their nodes run in enqueue order.
+    executor = std::make_unique<EagerExecutor>(
+        /*async=*/true, enable_streaming_enqueue_,
+        /*enable_per_device_queues=*/false);
+  }
+  return executor.get();
+}
+
 Status EagerExecutor::ShutDown() {
+  if (enable_per_device_queues_) {
+    std::vector<EagerExecutor*> device_executors;
+    {
+      mutex_lock l(device_executors_mu_);
+      device_executors.reserve(device_executors_.size());
+      for (auto& entry : device_executors_) {
+        device_executors.push_back(entry.second.get());
+      }
+    }
+    // Shut the device queues down first; nodes on the main queue may be
+    // waiting on tensor handles they produce.
+    for (EagerExecutor* executor : device_executors) {
+      executor->ShutDown().IgnoreError();
+    }
+  }
   {
     bool has_thread;
     Status status;
@@ -122,6 +151,17 @@ Status EagerExecutor::SyncExecute(EagerNode* node) {
 }
 
 Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
+  // Route nodes with a known device to a queue per device, so that
+  // independent per-device chains dispatch concurrently. Cross-queue
+  // dependencies are enforced by the input tensor handles: consumers block
+  // until their inputs are ready, and aborted producers poison them.
+  if (enable_per_device_queues_) {
+    const string device = node->DeviceName();
+    if (!device.empty()) {
+      return GetOrCreateDeviceExecutor(device)->AddOrExecute(std::move(node));
+    }
+  }
+
   Status status;
   core::RefCountPtr<NodeItem> item(new NodeItem);
   item->id = next_node_id_++;
@@ -171,6 +211,21 @@ Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
 }
 
 tensorflow::Status EagerExecutor::WaitForAllPendingNodes() {
+  if (enable_per_device_queues_) {
+    std::vector<EagerExecutor*> device_executors;
+    {
+      mutex_lock l(device_executors_mu_);
+      device_executors.reserve(device_executors_.size());
+      for (auto& entry : device_executors_) {
+        device_executors.push_back(entry.second.get());
+      }
+    }
+    // Wait without holding device_executors_mu_: aborted nodes may enqueue
+    // more operations onto this executor while draining.
+    for (EagerExecutor* executor : device_executors) {
+      TF_RETURN_IF_ERROR(executor->WaitForAllPendingNodes());
+    }
+  }
   tensorflow::mutex_lock l(node_queue_mutex_);
   return WaitForAllPendingNodesLocked(&l);
 }
@@ -193,6 +248,13 @@ tensorflow::Status EagerExecutor::WaitForAllPendingNodesLocked(
 }
 
 void EagerExecutor::ClearError() {
+  if (enable_per_device_queues_) {
+    mutex_lock l(device_executors_mu_);
+    for (auto& entry : device_executors_) {
+      entry.second->ClearError();
+    }
+  }
+
   // TODO(iga): Check state_ and return an error if it is not kActive.
   if (ok()) return;
 
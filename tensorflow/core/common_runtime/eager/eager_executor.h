@@ -21,6 +21,7 @@ limitations under the License.
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/device_factory.h"
@@ -75,6 +76,11 @@ class EagerNode {
 
   // Indicates whether a node failure should make the executor unusable.
   virtual bool Fatal() const { return true; }
+
+  // Name of the device this node dispatches work to, or empty if unknown.
+  // When per-device queues are enabled, nodes are routed to a queue per
+  // device name so that independent per-device chains execute concurrently.
+  virtual string DeviceName() const { return string(); }
 };
 
 class AsyncEagerNode : public EagerNode {
@@ -111,7 +117,15 @@ class AsyncRemoteExecuteNode : public AsyncEagerNode {
 // TODO(agarwal): Implement optimizations over EagerNode traces.
 class EagerExecutor {
  public:
-  explicit EagerExecutor(bool async, bool enable_streaming_enqueue = true);
+  // If `enable_per_device_queues` is true (async mode only), nodes that report
+  // a device via EagerNode::DeviceName() are routed to a dedicated async queue
+  // per device, so independent per-device chains dispatch concurrently instead
+  // of serializing through one ordered stream. Cross-queue dependencies are
+  // enforced by the input tensor handles themselves: consumers block until
+  // their inputs are ready, and aborted producers poison them. Nodes without a
+  // device name (e.g. remote execution nodes) stay on the main queue.
+  explicit EagerExecutor(bool async, bool enable_streaming_enqueue = true,
+                         bool enable_per_device_queues = false);
 
   ~EagerExecutor();
 
@@ -215,6 +229,10 @@ class EagerExecutor {
 
   Status WaitImpl(bool wait_all, uint64 node_id);
 
+  // Returns the executor responsible for nodes dispatching to `device`,
+  // creating it on first use. Only used when per-device queues are enabled.
+  EagerExecutor* GetOrCreateDeviceExecutor(const string& device);
+
   std::atomic<uint64> next_node_id_;
 
   mutable mutex node_queue_mutex_;
@@ -263,6 +281,17 @@ class EagerExecutor {
   // Enable sending remote executions through streaming enqueue.
   const bool enable_streaming_enqueue_;
 
+  // Route nodes with a known device to a dedicated queue per device.
+  const bool enable_per_device_queues_;
+
+  mutex device_executors_mu_;
+
+  // Async executors keyed by device name, created lazily. Entries are never
+  // removed before destruction, so the executors themselves can be used
+  // without holding device_executors_mu_.
+  std::unordered_map<string, std::unique_ptr<EagerExecutor>> device_executors_
+      TF_GUARDED_BY(device_executors_mu_);
+
   // Callbacks to run on destruction.
   std::unordered_map<intptr_t, std::vector<std::function<void()>>> cleanups_;
 };
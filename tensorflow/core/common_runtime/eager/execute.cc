@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/eager/execute.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <optional>
 #include <vector>
@@ -1042,6 +1043,125 @@ Status SetOpDevice(EagerContext& ctx, EagerOperation* op, Device** device) {
   return OkStatus();
 }
 
+// A small thread-local cache of resolved kernels, keyed by the same
+// fingerprint as EagerContext's kernel cache. In training loops the same op
+// signatures repeat almost every step, so lookups hit here and skip the
+// shared cache_mu_ lock in EagerContext::GetCachedKernel. Entries are keyed
+// on the context's process-unique kernel cache context id (never on its
+// pointer, which can be reused by a later context) and are dropped whenever
+// a different context is seen on this thread, the context's kernel cache
+// generation changes (cache clears and function removals bump it), or the
+// context is destroyed. Only primitive-op kernels are cached; function
+// kernels hold resources whose teardown must not outlive the context.
+//
+// Each cache is guarded by its own mutex: it is only ever contended when a
+// context teardown invalidates the caches of other threads, so the lock is
+// uncontended (a single atomic RMW) on the lookup fast path.
+class ThreadLocalKernelCache {
+ public:
+  ThreadLocalKernelCache() {
+    Registry* registry = GetRegistry();
+    mutex_lock l(registry->mu);
+    registry->caches.push_back(this);
+  }
+
+  ~ThreadLocalKernelCache() {
+    Registry* registry = GetRegistry();
+    mutex_lock l(registry->mu);
+    registry->caches.erase(std::find(registry->caches.begin(),
+                                     registry->caches.end(), this));
+  }
+
+  // Returns a new reference to the kernel cached for `cache_key`, or nullptr.
+  core::RefCountPtr<KernelAndDevice> Lookup(const EagerContext& ctx,
+                                            Fprint128 cache_key) {
+    mutex_lock l(mu_);
+    if (!SyncWithContext(ctx)) return nullptr;
+    Entry& entry = entries_[cache_key.low64 % kNumEntries];
+    if (entry.kernel == nullptr || !(entry.key == cache_key)) {
+      return nullptr;
+    }
+    core::RefCountPtr<KernelAndDevice> new_ref(entry.kernel.get());
+    new_ref->Ref();
+    return new_ref;
+  }
+
+  void Insert(const EagerContext& ctx, Fprint128 cache_key,
+              KernelAndDevice* kernel) {
+    mutex_lock l(mu_);
+    SyncWithContext(ctx);
+    Entry& entry = entries_[cache_key.low64 % kNumEntries];
+    core::RefCountPtr<KernelAndDevice> new_ref(kernel);
+    new_ref->Ref();
+    entry.key = cache_key;
+    entry.kernel = std::move(new_ref);
+  }
+
+  // Drops the entries cached from the context identified by `context_id` in
+  // every thread's cache. Registered as a teardown observer with
+  // EagerContext, so destroying a context cannot leave dangling kernels in
+  // per-thread caches.
+  static void InvalidateContext(uint64 context_id) {
+    Registry* registry = GetRegistry();
+    mutex_lock l(registry->mu);
+    for (ThreadLocalKernelCache* cache : registry->caches) {
+      mutex_lock entry_lock(cache->mu_);
+      if (cache->context_id_ == context_id) {
+        for (Entry& entry : cache->entries_) entry.kernel.reset();
+        cache->context_id_ = 0;
+      }
+    }
+  }
+
+  static ThreadLocalKernelCache* Get() {
+    static const bool observer_registered = []() {
+      EagerContext::AddKernelCacheTeardownObserver(
+          &ThreadLocalKernelCache::InvalidateContext);
+      return true;
+    }();
+    (void)observer_registered;
+    thread_local ThreadLocalKernelCache cache;
+    return &cache;
+  }
+
+ private:
+  struct Registry {
+    mutex mu;
+    std::vector<ThreadLocalKernelCache*> caches TF_GUARDED_BY(mu);
+  };
+
+  static Registry* GetRegistry() {
+    static Registry* registry = new Registry;
+    return registry;
+  }
+
+  // Drops all entries unless they were populated from `ctx` at its current
+  // kernel cache generation. Returns true iff existing entries are usable.
+  bool SyncWithContext(const EagerContext& ctx)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const uint64 context_id = ctx.kernel_cache_context_id();
+    const uint64 generation = ctx.kernel_cache_generation();
+    if (context_id == context_id_ && generation == generation_) return true;
+    for (Entry& entry : entries_) entry.kernel.reset();
+    context_id_ = context_id;
+    generation_ = generation;
+    return false;
+  }
+
+  static constexpr int kNumEntries = 64;
+  struct Entry {
+    Fprint128 key;
+    core::RefCountPtr<KernelAndDevice> kernel;
+  };
+
+  mutex mu_;
+  // 0 never identifies a live context.
+  uint64 context_id_ TF_GUARDED_BY(mu_) = 0;
+  uint64 generation_ TF_GUARDED_BY(mu_) = 0;
+  // Direct-mapped by the low bits of the fingerprint.
+  std::array<Entry, kNumEntries> entries_ TF_GUARDED_BY(mu_);
+};
+
 Fprint128 GetDeviceCacheKey(EagerOperation* op, const EagerContext& ctx) {
   Fprint128 device_cache_key = op->MutableAttrs()->CacheKey(op->DeviceName());
   device_cache_key =
@@ -1097,7 +1217,16 @@ Status GetOrCreateKernelAndDevice(
       GetKernelCacheKey(*op, op->MutableAttrs()->CacheKey(op->DeviceName()),
                         input_device_ptrs,
                         input_resource_variable_dtypes_and_shapes));
-  core::RefCountPtr<KernelAndDevice> kernel = ctx.GetCachedKernel(cache_key);
+  core::RefCountPtr<KernelAndDevice> kernel;
+  if (!op->is_function()) {
+    kernel = ThreadLocalKernelCache::Get()->Lookup(ctx, cache_key);
+  }
+  if (kernel == nullptr) {
+    kernel = ctx.GetCachedKernel(cache_key);
+    if (kernel != nullptr && !kernel->IsFunction()) {
+      ThreadLocalKernelCache::Get()->Insert(ctx, cache_key, kernel.get());
+    }
+  }
   AbstractOperationPtr wrapped_op_releaser;
   // We can eliminate some overhead by running simple functions using regular
   // CallOp kernel. However, it is tricky to figure out which functions should
@@ -1257,6 +1386,9 @@ Status GetOrCreateKernelAndDevice(
       TF_RETURN_IF_ERROR(OpDefForOp(op->Name().data(), &op_def));
       if (KernelCacheEnabled(*op_def)) {
         ctx.AddKernelToCache(cache_key, kernel.get());
+        if (!kernel->IsFunction()) {
+          ThreadLocalKernelCache::Get()->Insert(ctx, cache_key, kernel.get());
+        }
       }
     }
   }
@@ -228,6 +228,11 @@ class AsyncExecuteNode : public EagerNode {
     return out;
   }
 
+  std::string DeviceName() const override {
+    const Device* device = kernel_->device();
+    return device == nullptr ? std::string() : device->name();
+  }
+
  private:
   EagerContext* ctx_;
   absl::InlinedVector<TensorHandle*, 4> inputs_;
@@ -62,8 +62,51 @@ string SafeDeviceDebugString(Device* device) {
     return device->DebugString();
   }
 }
+
+// Per-thread free list recycling TensorHandle allocations. Handles are
+// created for every intermediate value of an eager computation and usually
+// freed a few ops later on the same thread, so a short free list keeps a
+// sequential chain of ops at O(1) heap allocations.
+struct TensorHandleFreeList {
+  static constexpr int kMaxFreeHandles = 16;
+
+  ~TensorHandleFreeList() {
+    for (int i = 0; i < num_free; ++i) {
+      ::operator delete(handles[i]);
+    }
+  }
+
+  void* handles[kMaxFreeHandles];
+  int num_free = 0;
+};
+
+TensorHandleFreeList* GetTensorHandleFreeList() {
+  thread_local TensorHandleFreeList free_list;
+  return &free_list;
+}
 }  // namespace
 
+void* TensorHandle::operator new(size_t size) {
+  if (size == sizeof(TensorHandle)) {
+    TensorHandleFreeList* free_list = GetTensorHandleFreeList();
+    if (free_list->num_free > 0) {
+      return free_list->handles[--free_list->num_free];
+    }
+  }
+  return ::operator new(size);
+}
+
+void TensorHandle::operator delete(void* ptr, size_t size) {
+  if (size == sizeof(TensorHandle)) {
+    TensorHandleFreeList* free_list = GetTensorHandleFreeList();
+    if (free_list->num_free < TensorHandleFreeList::kMaxFreeHandles) {
+      free_list->handles[free_list->num_free++] = ptr;
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
 TensorHandle::PackedTensorHandleData::PackedTensorHandleData(
     std::vector<TensorHandle*>&& handles, const TensorShape& shape)
     : handles_(std::move(handles)), shape_(shape) {
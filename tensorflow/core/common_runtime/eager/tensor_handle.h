@@ -119,6 +119,12 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
                                               EagerContext* ctx);
 #endif  // IS_MOBILE_PLATFORM
 
+  // Eager execution allocates and frees a TensorHandle for every intermediate
+  // value, so allocations are recycled through a per-thread free list. A
+  // sequential chain of N ops then performs O(1) heap allocations.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
   void Release() override;
 
   tensorflow::DataType DataType() const override;
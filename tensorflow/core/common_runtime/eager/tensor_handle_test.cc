@@ -66,6 +66,19 @@ TEST(TensorHandle_ShapeTest, AsyncShape) {
   ctx->Unref();
 }
 
+TEST(TensorHandle_AllocationTest, ReusesFreedHandleAllocations) {
+  Tensor t(DT_FLOAT, TensorShape({}));
+  t.scalar<float>()() = 27.0f;
+  TensorHandle* handle = TensorHandle::CreateLocalHandle(t);
+  TensorHandle* const freed = handle;
+  handle->Unref();
+  // The most recently freed allocation is reused by the next handle created
+  // on this thread.
+  handle = TensorHandle::CreateLocalHandle(t);
+  EXPECT_EQ(handle, freed);
+  handle->Unref();
+}
+
 static Device* CreateDevice(const char* type, const char* name,
                             bool is_local = true) {
   class FakeDevice : public Device {
@@ -29,11 +29,14 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/executor_factory.h"
 #include "tensorflow/core/common_runtime/graph_view.h"
 #include "tensorflow/core/common_runtime/immutable_executor_state.h"
+#include "tensorflow/core/common_runtime/op_sampling_profiler.h"
 #include "tensorflow/core/common_runtime/pending_counts.h"
 #include "tensorflow/core/common_runtime/propagator_state.h"
 #include "tensorflow/core/common_runtime/renamed_device.h"
 #include "tensorflow/core/common_runtime/simple_propagator_state.h"
+#include "tensorflow/core/common_runtime/step_arena.h"
 #include "tensorflow/core/common_runtime/step_stats_collector.h"
+#include "tensorflow/core/common_runtime/work_stealing_ready_queue.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/framework/collective.h"
@@ -60,6 +63,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
@@ -77,6 +81,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/core/util/determinism.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/managed_stack_trace.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
 
@@ -149,6 +154,10 @@ class ExecutorImpl : public Executor {
   Status Initialize(const Graph& graph) {
     TF_RETURN_IF_ERROR(immutable_state_.Initialize(graph));
     kernel_stats_.Initialize(immutable_state_.graph_view());
+    if (ShapeSpecializer::Enabled()) {
+      shape_specializer_ = std::make_unique<ShapeSpecializer>();
+      shape_specializer_->Initialize(immutable_state_.graph_view());
+    }
     return OkStatus();
   }
 
@@ -220,8 +229,94 @@ class ExecutorImpl : public Executor {
     std::unique_ptr<std::atomic_uint_fast64_t[]> cost_estimates_;
   };
 
+  // Tracks the input shapes each node executes with, and offers kernels the
+  // chance to specialize (via OpKernel::SpecializeForShape()) once a node has
+  // run with an identical shape signature for many consecutive executions.
+  // Only instantiated when TF_GRAPH_SHAPE_SPECIALIZATION=1, so graphs that do
+  // not opt in pay nothing.
+  class ShapeSpecializer {
+   public:
+    ShapeSpecializer() = default;
+
+    static bool Enabled() {
+      static const bool enabled = [] {
+        bool value = false;
+        TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPH_SHAPE_SPECIALIZATION",
+                                       /*default_val=*/false, &value));
+        return value;
+      }();
+      return enabled;
+    }
+
+    void Initialize(const GraphView& gview) {
+      profiles_ = std::make_unique<NodeProfile[]>(gview.num_nodes());
+    }
+
+    // Called with the inputs of a node that is about to run. Once the node
+    // has executed kStableExecutions times in a row with the same input
+    // shapes, asks the kernel to specialize for them. Profiling for a node
+    // stops (and the per-execution cost drops to one relaxed atomic load)
+    // as soon as the kernel has either specialized or declined.
+    void Observe(const NodeItem& item, const TensorValueVec& inputs) {
+      NodeProfile& profile = profiles_[item.node_id];
+      if (profile.done.load(std::memory_order_relaxed)) return;
+
+      uint64 signature = item.num_inputs;
+      for (const TensorValue& value : inputs) {
+        const Tensor* tensor = value.tensor;
+        if (tensor == nullptr) {
+          signature = Hash64Combine(signature, kMissingInputSignature);
+          continue;
+        }
+        signature = Hash64Combine(signature, tensor->dims());
+        for (int d = 0; d < tensor->dims(); ++d) {
+          signature = Hash64Combine(signature, tensor->dim_size(d));
+        }
+      }
+
+      mutex_lock l(profile.mu);
+      if (profile.done.load(std::memory_order_relaxed)) return;
+      if (signature != profile.signature) {
+        profile.signature = signature;
+        profile.hits = 1;
+        return;
+      }
+      if (++profile.hits < kStableExecutions) return;
+
+      gtl::InlinedVector<TensorShape, 4> shapes;
+      shapes.reserve(inputs.size());
+      for (const TensorValue& value : inputs) {
+        shapes.push_back(value.tensor != nullptr ? value.tensor->shape()
+                                                 : TensorShape());
+      }
+      if (item.kernel->SpecializeForShape(shapes) && VLOG_IS_ON(1)) {
+        VLOG(1) << "Specialized kernel for node " << item.kernel->name()
+                << " for stable input shapes";
+      }
+      // Whether or not the kernel specialized, there is nothing further to
+      // learn about this node; the kernel owns the mismatch fallback.
+      profile.done.store(true, std::memory_order_relaxed);
+    }
+
+   private:
+    // Number of consecutive executions with identical input shapes before a
+    // shape is considered stable enough to specialize for.
+    static constexpr int kStableExecutions = 64;
+    static constexpr uint64 kMissingInputSignature = 0xdeadbeefcafef00dULL;
+
+    struct NodeProfile {
+      mutex mu;
+      std::atomic<bool> done{false};
+      uint64 signature TF_GUARDED_BY(mu) = 0;
+      int hits TF_GUARDED_BY(mu) = 0;
+    };
+
+    std::unique_ptr<NodeProfile[]> profiles_;
+  };
+
   ImmutableExecutorState immutable_state_;
   KernelStats kernel_stats_;
+  std::unique_ptr<ShapeSpecializer> shape_specializer_;
 
   TF_DISALLOW_COPY_AND_ASSIGN(ExecutorImpl);
 };
@@ -280,7 +375,8 @@ class ExecutorState {
  public:
   ExecutorState(const Executor::Args& args,
                 const ImmutableExecutorState& immutable_state_,
-                ExecutorImpl::KernelStats* kernel_stats_);
+                ExecutorImpl::KernelStats* kernel_stats_,
+                ExecutorImpl::ShapeSpecializer* shape_specializer);
   ~ExecutorState();
 
   void RunAsync(Executor::DoneCallback done);
@@ -336,6 +432,28 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Variant of ScheduleReady() used when `ready_queue_` is set. Inexpensive
+  // nodes still go to 'inline_ready' (if non-null); everything else is pushed
+  // into the work-stealing deques instead of being dispatched one closure per
+  // node through `runner_`.
+  void ScheduleReadyLockFree(TaggedNodeSeq* ready,
+                             TaggedNodeReadyQueue* inline_ready);
+
+  // Reorders `nodes` so that nodes with higher "_scheduling_priority" hints
+  // (i.e. with the most critical-path work behind them) are dispatched first.
+  // Stable, so nodes with equal priority keep their original order. No-op on
+  // graphs without priority hints.
+  void SortByDescendingPriority(TaggedNodeSeq* nodes);
+
+  // Dispatches up to `max_new_workers` worker loops to drain `ready_queue_`,
+  // bounded by the number of free worker slots.
+  void EnsureReadyQueueWorkers(int max_new_workers);
+
+  // Body of a worker loop: pops (and steals) nodes from `ready_queue_` and
+  // processes them until the queue is drained. Registered as a deferred op so
+  // that Finish() cannot delete this ExecutorState while the loop is live.
+  void ReadyQueueWorkerLoop(int worker_id);
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
@@ -384,7 +502,10 @@ class ExecutorState {
   CallFrameInterface* call_frame_;
   const ImmutableExecutorState& immutable_state_;
   ExecutorImpl::KernelStats* const kernel_stats_;
+  // Null unless shape specialization is enabled. Not owned.
+  ExecutorImpl::ShapeSpecializer* const shape_specializer_;
   CancellationManager* cancellation_manager_;
+  StepArena* const step_arena_;
   CoordinationServiceAgent* coordination_service_agent_;
   absl::optional<ManagedStackTrace> stack_trace_ = absl::nullopt;
   // If not null, use this device to schedule intra-op operation
@@ -393,8 +514,26 @@ class ExecutorState {
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
 
+  // True iff the graph carries "_scheduling_priority" hints; gates the
+  // priority ordering in ScheduleReady()/ScheduleReadyLockFree().
+  const bool has_scheduling_priorities_;
+
   PropagatorStateType propagator_;
 
+  // Non-null iff `Args::use_lock_free_ready_queue` was set (and
+  // `run_all_kernels_inline` was not). See ScheduleReadyLockFree().
+  std::unique_ptr<WorkStealingReadyQueue<TaggedNode>> ready_queue_;
+
+  // Worker slot held by the current thread's ReadyQueueWorkerLoop(), or -1 if
+  // the thread is not a ready-queue worker. The slot is only valid for the
+  // queue identified by `ready_queue_worker_queue_id_`: these thread-locals
+  // are shared by all ExecutorState instances, and a worker of one executor
+  // can run another executor's ScheduleReadyLockFree() (e.g. via an inline
+  // rendezvous callback or a nested synchronous executor), where its slot
+  // grants nothing.
+  static thread_local int ready_queue_worker_id_;
+  static thread_local uint64 ready_queue_worker_queue_id_;
+
   // Invoked when the execution finishes.
   Executor::DoneCallback done_cb_;
 
@@ -413,7 +552,8 @@ class ExecutorState {
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::ExecutorState(
     const Executor::Args& args, const ImmutableExecutorState& immutable_state,
-    ExecutorImpl::KernelStats* kernel_stats)
+    ExecutorImpl::KernelStats* kernel_stats,
+    ExecutorImpl::ShapeSpecializer* shape_specializer)
     : vlog_(VLOG_IS_ON(1)),
       log_memory_(LogMemory::IsEnabled()),
       step_id_(args.step_id),
@@ -434,12 +574,15 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       call_frame_(args.call_frame),
       immutable_state_(immutable_state),
       kernel_stats_(kernel_stats),
+      shape_specializer_(shape_specializer),
       cancellation_manager_(args.cancellation_manager),
+      step_arena_(args.step_arena),
       coordination_service_agent_(args.coordination_service_agent),
       stack_trace_(args.stack_trace),
       runner_(args.runner),
       sync_on_finish_(args.sync_on_finish),
       run_all_kernels_inline_(args.run_all_kernels_inline),
+      has_scheduling_priorities_(immutable_state.has_scheduling_priorities()),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
   if (args.user_intra_op_threadpool != nullptr) {
@@ -447,8 +590,22 @@ ExecutorState<PropagatorStateType>::ExecutorState(
     user_device_ = RenamedDevice::NewRenamedDevice(
         device->name(), device, false, false, args.user_intra_op_threadpool);
   }
+  if (args.use_lock_free_ready_queue && !run_all_kernels_inline_) {
+    ready_queue_ = std::make_unique<WorkStealingReadyQueue<TaggedNode>>(
+        std::min(port::MaxParallelism(), 64));
+  }
 }
 
+template <class PropagatorStateType>
+thread_local int ExecutorState<PropagatorStateType>::ready_queue_worker_id_ =
+    -1;
+
+// 0 is never returned by WorkStealingReadyQueue::id(), so the initial value
+// matches no queue.
+template <class PropagatorStateType>
+thread_local uint64
+    ExecutorState<PropagatorStateType>::ready_queue_worker_queue_id_ = 0;
+
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::~ExecutorState() {
   if (device_context_) {
@@ -584,6 +741,7 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   OpKernel* op_kernel = item.kernel;
   Device* device = immutable_state_.params().device;
   const bool is_expensive = kernel_stats_->IsExpensive(item);
+  OpSamplingProfiler* const op_sampler = OpSamplingProfiler::Get();
 
   if (TF_PREDICT_FALSE(MightTrace(event_collector_, is_expensive))) {
     tracing::ScopedRegion region(tracing::EventCategory::kCompute,
@@ -598,6 +756,10 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   } else if (kernel_stats_->HasExpensiveMarker(item)) {
     KernelTimer timer;
     device->Compute(op_kernel, &ctx);
+    if (TF_PREDICT_FALSE(op_sampler != nullptr) && op_sampler->ShouldSample()) {
+      op_sampler->Record(op_kernel->name_view(), op_kernel->type_string_view(),
+                         timer.ElapsedCycles());
+    }
     // For expensive kernels, always update the cost estimate. For inexpensive
     // kernels, update the cost estimate with ~1/16 probability. This assumes
     // that the last 4 bits of the CPU cycle count is uniformly distributed.
@@ -606,6 +768,12 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
         timer.start_cycles % kKernelExecutionTrackingInvocationSkipCount == 0) {
       kernel_stats_->UpdateCostEstimate(item, timer.ElapsedCycles());
     }
+  } else if (TF_PREDICT_FALSE(op_sampler != nullptr) &&
+             op_sampler->ShouldSample()) {
+    KernelTimer timer;
+    device->Compute(op_kernel, &ctx);
+    op_sampler->Record(op_kernel->name_view(), op_kernel->type_string_view(),
+                       timer.ElapsedCycles());
   } else {
     device->Compute(op_kernel, &ctx);
   }
@@ -623,8 +791,13 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
     NodeExecStatsInterface* stats, activity_watcher::ActivityId activity_id) {
   AsyncOpKernel* async_kernel = item.kernel->AsAsync();
   DCHECK(async_kernel != nullptr);
+  // When a per-step arena was provided, the AsyncState is carved out of it
+  // and its storage is reclaimed in bulk when the step's arena is reset.
   AsyncState* state =
-      new AsyncState(params, tagged_node, &item, first_input, stats);
+      step_arena_ != nullptr
+          ? step_arena_->template New<AsyncState>(params, tagged_node, &item,
+                                                  first_input, stats)
+          : new AsyncState(params, tagged_node, &item, first_input, stats);
 
   auto done = [this, state, activity_id]() {
     Device* device = immutable_state_.params().device;
@@ -655,7 +828,11 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
     }
     outputs.clear();
     const bool completed = NodeDone(s, &ready, stats, nullptr);
-    delete state;
+    if (step_arena_ != nullptr) {
+      StepArena::Destroy(state);
+    } else {
+      delete state;
+    }
     if (completed) ScheduleFinish();
   };
   nodestats::SetOpStart(stats);
@@ -760,6 +937,11 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
   // Set the device_context for this device, if it exists.
   params.op_device_context = device_context_;
 
+  // Per-node device contexts, if the device assigns them (e.g. multi-stream
+  // GPU execution). Empty for the common single-context case.
+  const std::vector<DeviceContext*>& device_context_map =
+      immutable_state_.device_context_map();
+
   Status s;
   NodeExecStatsInterface* stats = nullptr;
 
@@ -859,12 +1041,22 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
         continue;
       }
 
+      if (TF_PREDICT_FALSE(shape_specializer_ != nullptr)) {
+        shape_specializer_->Observe(item, inputs);
+      }
+
       // Set up compute params.
+      params.op_device_context =
+          TF_PREDICT_FALSE(!device_context_map.empty()) &&
+                  device_context_map[id] != nullptr
+              ? device_context_map[id]
+              : device_context_;
       params.op_kernel = item.kernel;
       params.frame_iter = propagator_.GetFrameAndIter(tagged_node);
       params.is_input_dead = is_input_dead;
       params.output_attr_array = item.output_attrs();
       params.forward_from_array = item.forward_from();
+      params.preferred_forward_from_array = item.preferred_forward_from();
       params.outputs_required_array = item.outputs_required.get();
       params.inputs = inputs;
       params.input_alloc_attrs = input_alloc_attrs;
@@ -1211,6 +1403,17 @@ bool ExecutorState<PropagatorStateType>::NodeDone(
   }
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::SortByDescendingPriority(
+    TaggedNodeSeq* nodes) {
+  if (!has_scheduling_priorities_ || nodes->size() < 2) return;
+  std::stable_sort(nodes->begin(), nodes->end(),
+                   [](const TaggedNode& a, const TaggedNode& b) {
+                     return a.node_item->scheduling_priority >
+                            b.node_item->scheduling_priority;
+                   });
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleReady(
     TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready) {
@@ -1225,6 +1428,11 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
       profiler::GetTFTraceMeLevel(/*is_expensive=*/false));
   DCHECK(!ready->empty());
 
+  if (ready_queue_) {
+    ScheduleReadyLockFree(ready, inline_ready);
+    return;
+  }
+
   int64_t scheduled_nsec = 0;
   if (stats_collector_) {
     scheduled_nsec = nodestats::NowInNsec();
@@ -1250,7 +1458,9 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     const TaggedNode* curr_expensive_node = nullptr;
     TaggedNodeSeq expensive_nodes;
     if (inline_ready == nullptr) {
-      // Schedule to run all the ready ops in thread pool.
+      // Schedule to run all the ready ops in thread pool, most critical first
+      // so that thread-pool FIFO order matches graph criticality.
+      SortByDescendingPriority(ready);
       for (auto& tagged_node : *ready) {
         RunTask([=]() { Process(tagged_node, scheduled_nsec); },
                 /*sample_rate=*/ready->size());
@@ -1262,10 +1472,20 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
           // Inline this inexpensive node.
           inline_ready->push_back(tagged_node);
         } else {
+          // Keep the expensive node with the highest scheduling priority (the
+          // one with the most dependent work behind it, when the graph carries
+          // priority hints) for the current thread and dispatch the rest.
           if (curr_expensive_node) {
-            expensive_nodes.push_back(*curr_expensive_node);
+            if (item.scheduling_priority >
+                curr_expensive_node->node_item->scheduling_priority) {
+              expensive_nodes.push_back(*curr_expensive_node);
+              curr_expensive_node = &tagged_node;
+            } else {
+              expensive_nodes.push_back(tagged_node);
+            }
+          } else {
+            curr_expensive_node = &tagged_node;
           }
-          curr_expensive_node = &tagged_node;
         }
       }
     }
@@ -1279,6 +1499,10 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
       }
     }
     if (!expensive_nodes.empty()) {
+      // Dispatch the most critical expensive nodes first: the thread pool
+      // consumes closures roughly in submission order, so this starts the
+      // longest dependency chains as early as possible.
+      SortByDescendingPriority(&expensive_nodes);
       if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
         for (auto& tagged_node : expensive_nodes) {
           RunTask(std::bind(&ExecutorState::Process, this, tagged_node,
@@ -1323,6 +1547,126 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
   ready->clear();
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::ScheduleReadyLockFree(
+    TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready) {
+  // Only use the thread-local worker slot if it was acquired from *this*
+  // executor's queue; otherwise pushing would race with the real owner of
+  // that slot in our queue, and the worker accounting below would assume a
+  // drain that never comes. Foreign callers inject instead.
+  const int worker_id =
+      ready_queue_worker_queue_id_ == ready_queue_->id()
+          ? ready_queue_worker_id_
+          : -1;
+  // The per-worker deques pop in push order, so pushing the most critical
+  // nodes first makes them the first to be popped (or stolen).
+  SortByDescendingPriority(ready);
+  int num_pushed = 0;
+  for (auto& tagged_node : *ready) {
+    if (inline_ready != nullptr) {
+      const NodeItem& item = *tagged_node.node_item;
+      if (tagged_node.get_is_dead() || !kernel_stats_->IsExpensive(item)) {
+        // Inline this inexpensive node: it keeps running on the current
+        // worker's thread without round-tripping through the deques.
+        inline_ready->push_back(tagged_node);
+        continue;
+      }
+    }
+    if (worker_id >= 0) {
+      ready_queue_->Push(worker_id, tagged_node);
+    } else {
+      ready_queue_->Inject(tagged_node);
+    }
+    ++num_pushed;
+  }
+  ready->clear();
+  if (num_pushed > 0) {
+    // Pairs with the fence in ReadyQueueWorkerLoop() between releasing the
+    // worker slot and re-checking the queue: either the retiring worker sees
+    // our pushes in its re-check, or we see its released slot below and
+    // spawn a replacement. Without it, both sides can read stale values and
+    // strand the pushed nodes with no live worker.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // The current worker (if any) will drain its own deque; extra workers are
+    // only needed to pick up the surplus.
+    EnsureReadyQueueWorkers(worker_id >= 0 ? num_pushed - 1 : num_pushed);
+  }
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::EnsureReadyQueueWorkers(
+    int max_new_workers) {
+  for (int i = 0; i < max_new_workers; ++i) {
+    const int worker_id = ready_queue_->AcquireWorkerId();
+    if (worker_id < 0) return;  // Every worker slot is already occupied.
+    // Register the worker as a deferred op *before* scheduling it, so that
+    // the step cannot drain and Finish() delete this ExecutorState while the
+    // closure is queued but not yet running. ReadyQueueWorkerLoop() drops
+    // the count when it retires.
+    {
+      mutex_lock lock(num_deferred_ops_mu_);
+      num_deferred_ops_++;
+    }
+    RunTask([this, worker_id]() { ReadyQueueWorkerLoop(worker_id); });
+  }
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::ReadyQueueWorkerLoop(
+    const int worker_id) {
+  // This loop was registered as a deferred op by EnsureReadyQueueWorkers()
+  // when it was scheduled, so the final NodeDone() processed here (or on
+  // another worker) cannot trigger Finish() and delete this ExecutorState
+  // while we still touch `ready_queue_`.
+  //
+  // Save and restore the thread-local slot around the loop: if the runner
+  // executes closures inline, this loop may be nested inside another
+  // executor's worker loop, whose slot must be intact when it resumes.
+  const int saved_worker_id = ready_queue_worker_id_;
+  const uint64 saved_queue_id = ready_queue_worker_queue_id_;
+  ready_queue_worker_id_ = worker_id;
+  ready_queue_worker_queue_id_ = ready_queue_->id();
+
+  int64_t scheduled_nsec = 0;
+  if (stats_collector_) {
+    scheduled_nsec = nodestats::NowInNsec();
+  }
+  TaggedNode tagged_node;
+  while (ready_queue_->Pop(worker_id, &tagged_node)) {
+    Process(tagged_node, scheduled_nsec);
+  }
+
+  ready_queue_worker_id_ = saved_worker_id;
+  ready_queue_worker_queue_id_ = saved_queue_id;
+  WorkStealingReadyQueue<TaggedNode>* ready_queue = ready_queue_.get();
+  ready_queue->ReleaseWorkerId(worker_id);
+  // Pairs with the fence in ScheduleReadyLockFree(): a producer that pushed
+  // while all worker slots appeared taken must observe the slot released
+  // above, or we must observe its pushes in the re-check below; otherwise
+  // a node could be left in the queue with no live worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // A producer may have pushed between our final Pop() and the release above
+  // while all worker slots appeared taken; re-check before retiring.
+  // NOTE: `this` may be deleted as soon as the deferred count is dropped, so
+  // the re-check must happen first.
+  const bool respawn = !ready_queue->Empty();
+  if (respawn) {
+    EnsureReadyQueueWorkers(1);
+  }
+
+  bool finish_when_deferred_ops_done = false;
+  {
+    mutex_lock lock(num_deferred_ops_mu_);
+    num_deferred_ops_--;
+    if (num_deferred_ops_ == 0) {
+      finish_when_deferred_ops_done = finish_when_deferred_ops_done_;
+    }
+  }
+  // Invoke Finish if the graph processing has completed. Finish is always
+  // called exactly once per ExecutorState, either here or in ScheduleFinish.
+  if (finish_when_deferred_ops_done) Finish();
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleFinish() {
   // Checks condition to decide if needs to invoke Finish(). If there are
@@ -1461,14 +1805,17 @@ void ExecutorState<PropagatorStateType>::Finish() {
 void ExecutorImpl::RunAsync(const Args& args, DoneCallback done) {
   if (OpOrderDeterminismRequired()) {
     (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
-                                               &kernel_stats_))
+                                               &kernel_stats_,
+                                               shape_specializer_.get()))
         ->RunAsync(std::move(done));
   } else if (immutable_state_.requires_control_flow_support()) {
-    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_))
+    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_,
+                                        shape_specializer_.get()))
         ->RunAsync(std::move(done));
   } else {
     (new ExecutorState<SimplePropagatorState>(args, immutable_state_,
-                                              &kernel_stats_))
+                                              &kernel_stats_,
+                                              shape_specializer_.get()))
         ->RunAsync(std::move(done));
   }
 }
@@ -34,6 +34,7 @@ limitations under the License.
 
 namespace tensorflow {
 
+class StepArena;
 class StepStatsCollector;
 
 // Executor runs a graph computation.
@@ -118,6 +119,19 @@ class Executor {
     // If true, all kernels will be treated as "inexpensive", and hence executed
     // on the scheduling thread.
     bool run_all_kernels_inline = false;
+
+    // If true, ready nodes are distributed across lock-free per-worker
+    // work-stealing deques, drained by a bounded set of worker loops, instead
+    // of dispatching one closure per ready node through "runner". This
+    // reduces scheduler contention for graphs dominated by many small ops.
+    // Ignored when run_all_kernels_inline is set.
+    bool use_lock_free_ready_queue = false;
+
+    // If not null, transient executor allocations for this step (e.g. async
+    // kernel state) are served from this arena instead of the heap. The
+    // caller owns the arena and must keep it alive until "done" is invoked;
+    // it is typically reset once the step completes.
+    StepArena* step_arena = nullptr;
   };
   typedef std::function<void(const Status&)> DoneCallback;
   virtual void RunAsync(const Args& args, DoneCallback done) = 0;
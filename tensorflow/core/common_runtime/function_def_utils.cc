@@ -15,25 +15,130 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/function_def_utils.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/function_body.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op_def_util.h"
 #include "tensorflow/core/graph/control_flow.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Process-level cache of function macro expansions.  Model reloads mostly
+// carry FunctionDefs that are byte-identical to the previous version, so the
+// InstantiationResult produced by InstantiateFunction() is shared across
+// FunctionLibraryDefinitions and model versions.  Entries are immutable once
+// inserted.  Only the expansion is shared: the Graph built from it holds
+// library-specific state (op registry, stack traces) and is still constructed
+// per instantiation, as are kernels and executors downstream.
+class FunctionInstantiationCache {
+ public:
+  static FunctionInstantiationCache* Global() {
+    static FunctionInstantiationCache* cache =
+        new FunctionInstantiationCache;
+    return cache;
+  }
+
+  std::shared_ptr<const InstantiationResult> Lookup(uint64 key) {
+    mutex_lock l(mu_);
+    auto iter = cache_.find(key);
+    return iter != cache_.end() ? iter->second : nullptr;
+  }
+
+  void Insert(uint64 key,
+              std::shared_ptr<const InstantiationResult> result) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) {
+      // Processes that churn through many distinct functions (e.g. rolling
+      // over hundreds of model versions) would otherwise pin stale
+      // expansions forever. Dropping everything is rare and only costs
+      // re-instantiation on the next load.
+      cache_.clear();
+    }
+    cache_.emplace(key, std::move(result));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4096;
+
+  mutex mu_;
+  absl::flat_hash_map<uint64, std::shared_ptr<const InstantiationResult>>
+      cache_ TF_GUARDED_BY(mu_);
+};
+
+// Computes a fingerprint covering everything InstantiateFunction() consumes:
+// the function body, the instantiation attrs, and the signatures of the ops
+// and functions it calls (nested function signatures can differ between
+// libraries even when this function's definition is identical).  Sets
+// *cacheable to false when a signature cannot be resolved; instantiation will
+// then report the error through its own path.
+uint64 InstantiationCacheKey(
+    const FunctionDef& fdef, const AttrSlice& attrs,
+    const std::function<Status(const string&, const OpDef**)>& get_func_sig,
+    bool* cacheable) {
+  uint64 key = FunctionDefHash(fdef);
+
+  std::vector<std::pair<StringPiece, const AttrValue*>> sorted_attrs;
+  sorted_attrs.reserve(attrs.size());
+  for (const auto& attr : attrs) {
+    sorted_attrs.emplace_back(attr.first, &attr.second);
+  }
+  std::sort(sorted_attrs.begin(), sorted_attrs.end());
+  for (const auto& attr : sorted_attrs) {
+    key = Hash64Combine(key, Hash64(attr.first.data(), attr.first.size()));
+    key = Hash64Combine(key, AttrValueHash(*attr.second));
+  }
+
+  for (const NodeDef& node : fdef.node_def()) {
+    const OpDef* op_def = nullptr;
+    if (!get_func_sig(node.op(), &op_def).ok()) {
+      *cacheable = false;
+      return 0;
+    }
+    key = Hash64Combine(key, OpDefHash(*op_def));
+  }
+  *cacheable = true;
+  return key;
+}
+
+}  // namespace
+
 Status FunctionDefToBodyHelper(
     const FunctionDef& fdef, const AttrSlice& attrs,
     const FunctionLibraryDefinition* const lib_def,
     const std::function<Status(const string&, const OpDef**)>& get_func_sig,
     std::unique_ptr<FunctionBody>* fbody) {
-  // Instantiates the function template into a graph def.
-  InstantiationResult result;
-  TF_RETURN_IF_ERROR(InstantiateFunction(fdef, attrs, get_func_sig, &result));
+  // Instantiates the function template into a graph def, reusing the cached
+  // expansion when an identical function has been instantiated before (e.g.
+  // by a previous version of the same model).
+  bool cacheable = false;
+  const uint64 key =
+      InstantiationCacheKey(fdef, attrs, get_func_sig, &cacheable);
+  std::shared_ptr<const InstantiationResult> result;
+  if (cacheable) {
+    result = FunctionInstantiationCache::Global()->Lookup(key);
+  }
+  if (result == nullptr) {
+    auto owned = std::make_shared<InstantiationResult>();
+    TF_RETURN_IF_ERROR(
+        InstantiateFunction(fdef, attrs, get_func_sig, owned.get()));
+    if (cacheable) {
+      FunctionInstantiationCache::Global()->Insert(key, owned);
+    }
+    result = std::move(owned);
+  }
 
   auto graph = std::make_unique<Graph>(lib_def);
 
@@ -50,7 +155,7 @@ Status FunctionDefToBodyHelper(
   GraphConstructorOptions opts;
   opts.allow_internal_ops = true;
   opts.expect_device_spec = false;
-  TF_RETURN_IF_ERROR(ConvertNodeDefsToGraph(opts, result.nodes, graph.get()));
+  TF_RETURN_IF_ERROR(ConvertNodeDefsToGraph(opts, result->nodes, graph.get()));
 
   const StackTracesMap& stack_traces =
       lib_def->GetStackTraces(fdef.signature().name());
@@ -68,8 +173,8 @@ Status FunctionDefToBodyHelper(
   std::vector<ControlFlowInfo> dummy;
   TF_RETURN_IF_ERROR(BuildControlFlowInfo(graph.get(), &dummy));
 
-  *fbody = std::make_unique<FunctionBody>(fdef, result.arg_types,
-                                           result.ret_types, graph.release());
+  *fbody = std::make_unique<FunctionBody>(fdef, result->arg_types,
+                                          result->ret_types, graph.release());
   return OkStatus();
 }
 
@@ -611,6 +611,81 @@ TEST_F(FunctionLibraryRuntimeTest, XTimesNInLibDefAndDelayedInstantiation) {
   test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
 }
 
+TEST_F(FunctionLibraryRuntimeTest, PartitionedCallMemoizedResults) {
+  using FDH = ::tensorflow::FunctionDefHelper;
+
+  // Calls XTimesTwo through a PartitionedCall annotated with
+  // "_memoize_max_entries": repeated calls with equal inputs are served from
+  // the kernel's memo cache and must be indistinguishable from evaluation.
+  FunctionDef memoized_xt2 = FDH::Create(
+      "MemoizedXTimesTwo", {"x:float"}, {"z:float"}, {},
+      {{{"x_times_two"},
+        "PartitionedCall",
+        {"x"},
+        {{"Tin", DataTypeSlice({DT_FLOAT})},
+         {"Tout", DataTypeSlice({DT_FLOAT})},
+         {"f", FDH::FunctionRef("XTimesTwo", {{"T", DT_FLOAT}})},
+         {"_memoize_max_entries", 1}}}},
+      {{"z", "x_times_two:output:0"}});
+
+  Init({test::function::XTimesTwo(), memoized_xt2});
+
+  FunctionLibraryRuntime::Handle handle;
+  TF_CHECK_OK(Instantiate(flr0_, "MemoizedXTimesTwo", {}, &handle));
+
+  FunctionLibraryRuntime::Options opts;
+  auto x1 = test::AsTensor<float>({1, 2, 3, 4});
+  auto x2 = test::AsTensor<float>({5, 6, 7, 8});
+  Tensor y;
+  // The first call evaluates the function and caches its results.
+  TF_CHECK_OK(Run(flr0_, handle, opts, {x1}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
+  // The same input again is served from the memo cache.
+  TF_CHECK_OK(Run(flr0_, handle, opts, {x1}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
+  // A different input misses the cache and, with capacity 1, evicts the
+  // previous entry.
+  TF_CHECK_OK(Run(flr0_, handle, opts, {x2}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({10, 12, 14, 16}));
+  // The original input is recomputed correctly after its eviction.
+  TF_CHECK_OK(Run(flr0_, handle, opts, {x1}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
+
+  TF_CHECK_OK(flr0_->ReleaseHandle(handle));
+}
+
+TEST_F(FunctionLibraryRuntimeTest, PartitionedCallMemoizeRejectsStateful) {
+  using FDH = ::tensorflow::FunctionDefHelper;
+
+  // "_memoize_max_entries" may only be placed on calls to stateless
+  // functions; a called function with a stateful op must be rejected when
+  // the kernel instantiates it.
+  FunctionDef random_func = FDH::Define(
+      "RandomUniformWrapper", {}, {"y: int32"}, {},
+      {FDH::Const<int32>("shape", gtl::ArraySlice<int32>({1})),
+       FDH::Const<int32>("minval", 0), FDH::Const<int32>("maxval", 10),
+       {{"y"},
+        "RandomUniformInt",
+        {"shape", "minval", "maxval"},
+        {{"seed", 37}, {"seed2", 48}, {"Tout", DT_INT32}, {"T", DT_INT32}}}});
+  FunctionDef memoized_random = FDH::Create(
+      "MemoizedRandom", {}, {"z:int32"}, {},
+      {{{"call"},
+        "PartitionedCall",
+        {},
+        {{"Tin", DataTypeSlice({})},
+         {"Tout", DataTypeSlice({DT_INT32})},
+         {"f", FDH::FunctionRef("RandomUniformWrapper", {})},
+         {"_memoize_max_entries", 16}}}},
+      {{"z", "call:output:0"}});
+
+  Init({random_func, memoized_random});
+
+  Tensor y;
+  HasError(InstantiateAndRun(flr0_, "MemoizedRandom", {}, {}, {&y}),
+           error::INVALID_ARGUMENT, "memoization requires a stateless");
+}
+
 TEST_F(FunctionLibraryRuntimeTest, StateHandle) {
   auto T = DT_INT32;
 
@@ -711,6 +711,47 @@ class GPUBFCAllocatorPrivateMethodsTest_SubAllocatorSpecific
     EXPECT_EQ(1, num_chunks_in_bins);
   }
 
+  void TestReleaseFreeRegions() {
+    GPUBFCAllocator::Options options;
+    options.allow_growth = true;
+    // ReleaseFreeRegions is an explicit safe-point call, so it must work even
+    // with garbage collection disabled.
+    options.garbage_collection = false;
+
+    // Max of 2GiB, but starts out small.
+    GPUBFCAllocator a(CreateGPUMemAllocator(/*ignored*/ 0), 1LL << 31,
+                      "GPU_0_bfc", options);
+
+    // Allocate 128 raw pointers of 4 megs.
+    const size_t size = 1LL << 22;
+    std::vector<void*> initial_ptrs;
+    for (size_t s = 0; s < 128; s++) {
+      void* raw = a.AllocateRaw(1, size);
+      initial_ptrs.push_back(raw);
+    }
+
+    {
+      mutex_lock l(a.lock_);
+      // Make sure there are more than 1 regions in preparation for the test.
+      EXPECT_LT(1, a.region_manager_.regions().size());
+    }
+
+    // Deallocate all the memories except the last one.
+    for (size_t i = 0; i < initial_ptrs.size() - 1; i++) {
+      a.DeallocateRaw(initial_ptrs[i]);
+    }
+
+    // Release free regions; only the region holding the live chunk remains.
+    EXPECT_LT(0, a.ReleaseFreeRegions());
+    {
+      mutex_lock l(a.lock_);
+      EXPECT_EQ(1, a.region_manager_.regions().size());
+    }
+
+    // A second call finds nothing left to release.
+    EXPECT_EQ(0, a.ReleaseFreeRegions());
+  }
+
 #if CUDA_VERSION >= 10020
   // Counterpart to the GPUMemAllocator test suite TestRegionDeallocation tests.
   // Here we expect no deallocations because all allocations are coalesced into
@@ -756,6 +797,11 @@ TEST_F(GPUBFCAllocatorPrivateMethodsTest_SubAllocatorSpecific,
   TestRegionDeallocation();
 }
 
+TEST_F(GPUBFCAllocatorPrivateMethodsTest_SubAllocatorSpecific,
+       TestReleaseFreeRegions) {
+  TestReleaseFreeRegions();
+}
+
 #if CUDA_VERSION >= 10020
 TEST_F(GPUBFCAllocatorPrivateMethodsTest_SubAllocatorSpecific,
        TestNoRegionDeallocation) {
@@ -274,7 +274,20 @@ GpuCudaMallocAsyncAllocator::GpuCudaMallocAsyncAllocator(
 #endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED
 }
 
-GpuCudaMallocAsyncAllocator::~GpuCudaMallocAsyncAllocator() {}
+GpuCudaMallocAsyncAllocator::~GpuCudaMallocAsyncAllocator() {
+#if TF_CUDA_MALLOC_ASYNC_SUPPORTED
+  std::vector<void*> deferred;
+  {
+    mutex_lock lock(lock_);
+    deferred.swap(deferred_frees_);
+  }
+  if (!deferred.empty() && !StreamIsCapturing()) {
+    for (void* deferred_ptr : deferred) {
+      FreeAndUpdateStats(deferred_ptr);
+    }
+  }
+#endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED
+}
 
 void* GpuCudaMallocAsyncAllocator::AllocateRaw(size_t alignment,
                                                size_t num_bytes) {
@@ -287,6 +300,25 @@ void* GpuCudaMallocAsyncAllocator::AllocateRaw(size_t alignment,
         << " See previous errors.";
   }
   se::cuda::ScopedActivateExecutorContext scoped_activation{stream_exec_};
+
+  // Release frees that were deferred during a CUDA graph capture, so the
+  // pool can reuse their memory for this allocation.
+  bool has_deferred_frees;
+  {
+    mutex_lock lock(lock_);
+    has_deferred_frees = !deferred_frees_.empty();
+  }
+  if (has_deferred_frees && !StreamIsCapturing()) {
+    std::vector<void*> deferred;
+    {
+      mutex_lock lock(lock_);
+      deferred.swap(deferred_frees_);
+    }
+    for (void* deferred_ptr : deferred) {
+      FreeAndUpdateStats(deferred_ptr);
+    }
+  }
+
   void* ptr = nullptr;
   if (auto result =
           cuMemAllocFromPoolAsync(reinterpret_cast<CUdeviceptr*>(&ptr),
@@ -329,6 +361,43 @@ void* GpuCudaMallocAsyncAllocator::AllocateRaw(size_t alignment,
 void GpuCudaMallocAsyncAllocator::DeallocateRaw(void* ptr) {
 #if TF_CUDA_MALLOC_ASYNC_SUPPORTED
   if (ptr == nullptr) return;
+
+  if (StreamIsCapturing()) {
+    // Freeing on a capturing stream would record the free into the CUDA
+    // graph and replay it on every launch. Hold the pointer until capture
+    // ends; it stays accounted as in use until then.
+    mutex_lock lock(lock_);
+    deferred_frees_.push_back(ptr);
+    return;
+  }
+
+  // Release anything that was queued while the stream was capturing.
+  std::vector<void*> deferred;
+  {
+    mutex_lock lock(lock_);
+    deferred.swap(deferred_frees_);
+  }
+  for (void* deferred_ptr : deferred) {
+    FreeAndUpdateStats(deferred_ptr);
+  }
+
+  FreeAndUpdateStats(ptr);
+#endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED
+}
+
+bool GpuCudaMallocAsyncAllocator::StreamIsCapturing() const {
+#if TF_CUDA_MALLOC_ASYNC_SUPPORTED
+  if (cuda_stream_ == nullptr) return false;
+  CUstreamCaptureStatus status = CU_STREAM_CAPTURE_STATUS_NONE;
+  if (cuStreamIsCapturing(cuda_stream_, &status)) return false;
+  return status != CU_STREAM_CAPTURE_STATUS_NONE;
+#else   // TF_CUDA_MALLOC_ASYNC_SUPPORTED
+  return false;
+#endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED
+}
+
+void GpuCudaMallocAsyncAllocator::FreeAndUpdateStats(void* ptr) {
+#if TF_CUDA_MALLOC_ASYNC_SUPPORTED
   if (auto result = cuMemFreeAsync(reinterpret_cast<const CUdeviceptr&>(ptr),
                                    cuda_stream_)) {
     if (result == CUDA_ERROR_DEINITIALIZED) {
@@ -380,7 +449,23 @@ size_t GpuCudaMallocAsyncAllocator::AllocatedSize(const void* ptr) const {
 std::optional<tsl::AllocatorStats> GpuCudaMallocAsyncAllocator::GetStats() {
   if (!stats_) return std::nullopt;
   mutex_lock l(lock_);
-  return *stats_;
+  tsl::AllocatorStats stats = *stats_;
+#if TF_CUDA_MALLOC_ASYNC_SUPPORTED && CUDA_VERSION >= 11030
+  // Report the memory the driver pool holds from the system, for parity with
+  // the reserved/peak-reserved accounting of the BFC allocator.
+  if (pool_ != nullptr) {
+    cuuint64_t mem_reserved_current = 0;
+    cuuint64_t mem_reserved_high = 0;
+    if (!cuMemPoolGetAttribute(pool_, CU_MEMPOOL_ATTR_RESERVED_MEM_CURRENT,
+                               &mem_reserved_current) &&
+        !cuMemPoolGetAttribute(pool_, CU_MEMPOOL_ATTR_RESERVED_MEM_HIGH,
+                               &mem_reserved_high)) {
+      stats.bytes_reserved = static_cast<int64_t>(mem_reserved_current);
+      stats.peak_bytes_reserved = static_cast<int64_t>(mem_reserved_high);
+    }
+  }
+#endif  // TF_CUDA_MALLOC_ASYNC_SUPPORTED && CUDA_VERSION >= 11030
+  return stats;
 }
 
 bool GpuCudaMallocAsyncAllocator::ClearStats() {
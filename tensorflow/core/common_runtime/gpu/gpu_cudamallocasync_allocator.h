@@ -19,6 +19,7 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/compiler/xla/stream_executor/stream_executor.h"
@@ -93,6 +94,11 @@ class GpuCudaMallocAsyncAllocator : public tsl::Allocator {
   // - If CUDA_VERSION >= 11030, print cudaMallocAsync statistics.
   void PrintAllocatorStatistics();
 
+  // Returns true while `cuda_stream_` is recording a CUDA graph. Frees
+  // issued during capture are deferred until capture ends; see
+  // DeallocateRaw().
+  bool StreamIsCapturing() const;
+
   static int GetInstantiatedCountTestOnly() { return number_instantiated_; }
 
   tsl::AllocatorMemoryType GetMemoryType() const override {
@@ -127,10 +133,20 @@ class GpuCudaMallocAsyncAllocator : public tsl::Allocator {
   TF_DISALLOW_COPY_AND_ASSIGN(GpuCudaMallocAsyncAllocator);
 
   // Stats.
+  // Frees the given pointer on `cuda_stream_` and updates the stats. The
+  // stream must not be capturing.
+  void FreeAndUpdateStats(void* ptr);
+
   // Structures mutable after construction
   mutable tsl::mutex lock_;
   std::unique_ptr<tsl::AllocatorStats> stats_ TF_PT_GUARDED_BY(lock_);
   absl::flat_hash_map<const void*, size_t> size_map_ TF_GUARDED_BY(lock_);
+
+  // Pointers whose free was requested while the stream was capturing a CUDA
+  // graph. Recording the free into the graph would replay it on every graph
+  // launch, so these are held (and still accounted as in use) until the
+  // first allocation or deallocation after capture ends.
+  std::vector<void*> deferred_frees_ TF_GUARDED_BY(lock_);
 };
 
 }  // namespace tensorflow
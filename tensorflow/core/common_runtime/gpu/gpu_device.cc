@@ -44,6 +44,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_init.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_process_state.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_assignment.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_util.h"
 #include "tensorflow/core/common_runtime/gpu_device_context.h"
 #include "tensorflow/core/common_runtime/local_device.h"
@@ -77,6 +78,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/stream_executor_util.h"
@@ -403,14 +405,18 @@ BaseGPUDevice::BaseGPUDevice(const SessionOptions& options, const string& name,
 
 BaseGPUDevice::~BaseGPUDevice() {
   delete accelerator_device_info_;
-  if (scratch_) gpu_allocator_->DeallocateRaw(scratch_);
+  for (char* scratch : scratch_) gpu_allocator_->DeallocateRaw(scratch);
+  {
+    mutex_lock l(multi_stream_context_mu_);
+    for (auto& entry : multi_stream_contexts_) entry.second->Unref();
+  }
   device_context_->Unref();
 }
 
 // This should be idempotent if already initialized.
 Status BaseGPUDevice::InitScratchBuffers() {
   mutex_lock l(scratch_init_mutex_);
-  if (!scratch_) {
+  while (static_cast<int>(scratch_.size()) < num_compute_streams_) {
     DCHECK(stream_);
     size_t scratch_buffer_size = Eigen::kGpuScratchSize + sizeof(unsigned int);
     profiler::ScopedMemoryDebugAnnotation op_annotation("ScratchBuffer");
@@ -425,7 +431,7 @@ Status BaseGPUDevice::InitScratchBuffers() {
         se::DeviceMemoryBase(scratch_buffer, scratch_buffer_size));
     TF_RETURN_IF_ERROR(executor_->SynchronousMemZero(
         &mem, Eigen::kGpuScratchSize + sizeof(unsigned int)));
-    scratch_ = static_cast<char*>(scratch_buffer);
+    scratch_.push_back(static_cast<char*>(scratch_buffer));
   }
   return OkStatus();
 }
@@ -440,14 +446,48 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
 
   executor_ = executor_status.value();
 
+  // If TF_AUTOTUNE_CACHE_PATH is set, seed the autotune maps from the cache
+  // recorded by a previous run so the first steps skip re-benchmarking.
+  EnableAutotuneCacheFromEnv();
+
   stream_ = StreamGroupFactory::Global().GetOrCreate(
       tf_device_id_, 0, executor_, options.config.gpu_options());
 
+  // Number of compute streams to spread independent graph branches over.
+  // This mode is experimental: with more than one compute stream, memory
+  // freed on one stream may be reused on another, so it should be paired
+  // with GPUOptions.experimental.timestamped_allocator.
+  int64_t max_compute_streams = 1;
+  TF_RETURN_IF_ERROR(ReadInt64FromEnvVar("TF_GPU_MAX_COMPUTE_STREAMS", 1,
+                                         &max_compute_streams));
+  if (max_compute_streams < 1 || max_compute_streams > kMaxComputeStreams) {
+    LOG(ERROR) << "Illegal TF_GPU_MAX_COMPUTE_STREAMS=" << max_compute_streams
+               << " set to 1 instead.";
+    max_compute_streams = 1;
+  }
+  num_compute_streams_ = max_compute_streams;
+  stream_groups_.push_back(stream_);
+  for (int i = 1; i < num_compute_streams_; ++i) {
+    stream_groups_.push_back(StreamGroupFactory::Global().GetOrCreate(
+        tf_device_id_, i, executor_, options.config.gpu_options()));
+  }
+  if (num_compute_streams_ > 1) {
+    LOG(INFO) << "Using " << num_compute_streams_ << " compute streams for "
+              << name();
+    if (!options.config.gpu_options().experimental().timestamped_allocator()) {
+      LOG(WARNING) << "TF_GPU_MAX_COMPUTE_STREAMS > 1 without "
+                      "GPUOptions.experimental.timestamped_allocator; memory "
+                      "freed on one compute stream may be reused on another "
+                      "before the freeing kernel has completed.";
+    }
+  }
+
   // Get an allocator that allocates pinned memory on host.
   AllocatorAttributes attr;
   attr.set_on_host(true);
   attr.set_gpu_compatible(true);
   Allocator* host_memory_allocator = GetAllocator(attr);
+  host_memory_allocator_ = host_memory_allocator;
 
   device_context_ =
       new GPUDeviceContext(0, stream_->compute,
@@ -668,6 +708,11 @@ void BaseGPUDevice::Compute(OpKernel* op_kernel, OpKernelContext* context) {
       kernel_tracker_->PauseWhilePendingExceeds(pending_cap_);
     }
   }
+  // In multi-stream mode, order this op's kernels after the work its
+  // cross-stream inputs were produced by.
+  for (se::Stream* dependency : gpu_device_context->wait_on_streams()) {
+    stream->ThenWaitFor(dependency);
+  }
   ScopedActivateExecutorContext scoped_activation{stream->parent()};
   profiler::ScopedMemoryDebugAnnotation op_annotation(
       op_kernel->name_view().data(), context->step_id());
@@ -728,11 +773,14 @@ Status BaseGPUDevice::Sync() {
 
   // Device::Sync is supposed to block until all operations queued on the device
   // at the time of the call have completed.  On GPUs, only operations enqueued
-  // on the compute stream can remain pending after the (Async)OpKernel that
+  // on the compute streams can remain pending after the (Async)OpKernel that
   // enqueued the operation has completed.  We do use other streams for copies
   // and collectives, but in those cases the (Async)OpKernels themselves block
   // until the queued operation has finished.
-  return stream_->compute->BlockHostUntilDone();
+  for (StreamGroup* group : stream_groups_) {
+    TF_RETURN_IF_ERROR(group->compute->BlockHostUntilDone());
+  }
+  return OkStatus();
 }
 
 void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
@@ -762,6 +810,11 @@ void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
     };
   }
 
+  // In multi-stream mode, order this op's kernels after the work its
+  // cross-stream inputs were produced by.
+  for (se::Stream* dependency : gpu_device_context->wait_on_streams()) {
+    stream->ThenWaitFor(dependency);
+  }
   ScopedActivateExecutorContext scoped_activation{stream->parent()};
   op_kernel->ComputeAsync(context, std::move(done));
 }
@@ -1157,11 +1210,14 @@ void BaseGPUDevice::ReinitializeDevice(OpKernelContext* context,
   ConcretePerOpGpuDevice* concrete_device =
       static_cast<ConcretePerOpGpuDevice*>(device);
   DCHECK(concrete_device);
-  DCHECK_EQ(stream_id, 0);
+  DCHECK_GE(stream_id, 0);
+  DCHECK_LT(stream_id, static_cast<int>(stream_groups_.size()));
   const gpuStream_t* gpu_stream = reinterpret_cast<const gpuStream_t*>(
-      stream_->compute->implementation()->GpuStreamMemberHack());
+      stream_groups_[stream_id]
+          ->compute->implementation()
+          ->GpuStreamMemberHack());
   concrete_device->Reinitialize(context, gpu_stream, tf_device_id_, allocator,
-                                scratch_);
+                                scratch_[stream_id]);
 }
 
 PerOpGpuDevice* BaseGPUDevice::MakeGpuDevice() {
@@ -1178,7 +1234,7 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
     const int stream_id = gpu_dc->stream_id();
     VLOG(1) << "  eigen_gpu_device(" << dc << ") => stream[" << stream_id
             << "]";
-    CHECK_EQ(stream_id, 0);
+    CHECK_LT(stream_id, num_compute_streams_);
     ReinitializeDevice(context, device, stream_id, allocator);
   } else {
     ReinitializeDevice(context, device, 0, allocator);
@@ -1186,6 +1242,66 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
   return OkStatus();
 }
 
+Status BaseGPUDevice::FillContextMap(
+    const Graph* graph, std::vector<DeviceContext*>* device_context_map) {
+  if (num_compute_streams_ <= 1) {
+    return OkStatus();
+  }
+  VLOG(2) << "FillContextMap for " << name() << " with "
+          << num_compute_streams_ << " compute streams";
+
+  gpu_stream_assignment::AssignStreamsOpts opts;
+  opts.max_streams = num_compute_streams_;
+  std::unordered_map<int, int> node_to_stream_id;
+  TF_RETURN_IF_ERROR(
+      gpu_stream_assignment::AssignStreams(graph, opts, &node_to_stream_id));
+
+  device_context_map->resize(graph->num_node_ids(), nullptr);
+  for (Node* n : graph->nodes()) {
+    auto it = node_to_stream_id.find(n->id());
+    if (it == node_to_stream_id.end()) continue;
+    const int stream_id = it->second;
+    // Record which other compute streams feed this node, so its kernels can
+    // be ordered after the work that produces their inputs. Control edges
+    // are included: they may sequence a read after a cross-stream update.
+    uint32 wait_mask = 0;
+    for (const Edge* e : n->in_edges()) {
+      auto src_it = node_to_stream_id.find(e->src()->id());
+      if (src_it != node_to_stream_id.end() && src_it->second != stream_id) {
+        wait_mask |= 1u << src_it->second;
+      }
+    }
+    (*device_context_map)[n->id()] =
+        GetOrCreateMultiStreamContext(stream_id, wait_mask);
+  }
+  return OkStatus();
+}
+
+GPUDeviceContext* BaseGPUDevice::GetOrCreateMultiStreamContext(
+    int stream_id, uint32 wait_mask) {
+  mutex_lock l(multi_stream_context_mu_);
+  GPUDeviceContext*& context =
+      multi_stream_contexts_[std::make_pair(stream_id, wait_mask)];
+  if (context == nullptr) {
+    StreamGroup* group = stream_groups_[stream_id];
+    context = new GPUDeviceContext(
+        stream_id, group->compute,
+#if TENSORFLOW_USE_ROCM
+        group->nccl,
+#endif
+        group->host_to_device, group->device_to_host, group->device_to_device,
+        host_memory_allocator_);
+    gtl::InlinedVector<se::Stream*, 4> wait_on_streams;
+    for (int i = 0; i < num_compute_streams_; ++i) {
+      if (wait_mask & (1u << i)) {
+        wait_on_streams.push_back(stream_groups_[i]->compute);
+      }
+    }
+    context->set_wait_on_streams(std::move(wait_on_streams));
+  }
+  return context;
+}
+
 Allocator* BaseGPUDevice::GetScopedAllocator(AllocatorAttributes attr,
                                              int64_t step_id) {
   if (attr.scope_id > 0) {
@@ -20,9 +20,11 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_DEVICE_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_DEVICE_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
@@ -108,6 +110,13 @@ class BaseGPUDevice : public LocalDevice {
                                DeviceContext* dc,
                                Allocator* allocator) override;
 
+  // Assigns independent branches of "graph" to separate compute streams when
+  // multi-stream mode is enabled (see TF_GPU_MAX_COMPUTE_STREAMS in Init());
+  // otherwise leaves the map empty so every op uses the default context.
+  Status FillContextMap(
+      const Graph* graph,
+      std::vector<DeviceContext*>* device_context_map) override;
+
   // Returns the platform GPU id of this device within the native driver system;
   // e.g., for CUDA and ROCm this is the ordinal of the GPU within the system.
   int gpu_id() const {
@@ -169,10 +178,24 @@ class BaseGPUDevice : public LocalDevice {
   };
   class StreamGroupFactory;
 
+  // Upper bound on TF_GPU_MAX_COMPUTE_STREAMS.
+  static constexpr int kMaxComputeStreams = 4;
+
   StreamGroup* stream_;
+  // All compute stream groups used by this device; element 0 is stream_.
+  // Extra entries exist only in multi-stream mode.
+  gtl::InlinedVector<StreamGroup*, 4> stream_groups_;
+  int num_compute_streams_ = 1;
   mutex scratch_init_mutex_;
-  char* scratch_ = nullptr;
+  // Eigen scratch buffers, one per compute stream.
+  gtl::InlinedVector<char*, 4> scratch_;
   GPUDeviceContext* device_context_;
+  // Contexts for the (compute stream, cross-stream wait set) pairs in use in
+  // multi-stream mode, lazily created by FillContextMap. Each holds one ref.
+  mutex multi_stream_context_mu_;
+  std::map<std::pair<int, uint32>, GPUDeviceContext*> multi_stream_contexts_
+      TF_GUARDED_BY(multi_stream_context_mu_);
+  Allocator* host_memory_allocator_ = nullptr;  // not owned
   DeviceBase::AcceleratorDeviceInfo* accelerator_device_info_ = nullptr;
   mutex trace_mu_;
   TfDeviceId tf_device_id_;
@@ -190,6 +213,12 @@ class BaseGPUDevice : public LocalDevice {
   void ReinitializeDevice(OpKernelContext* context, PerOpGpuDevice* device,
                           int stream_id, Allocator* allocator);
 
+  // Returns the context for ops assigned to compute stream "stream_id" whose
+  // cross-stream input producers are given by "wait_mask" (bit i set means a
+  // wait on compute stream i must precede the op). Creates it on first use.
+  GPUDeviceContext* GetOrCreateMultiStreamContext(int stream_id,
+                                                  uint32 wait_mask);
+
   std::string ComputeOpKernelDebugString(const OpKernel& op_kernel,
                                          const int& stream_id);
 
@@ -0,0 +1,109 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_graph_replay_cache.h"
+
+#include <utility>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/logging.h"
+
+#if GOOGLE_CUDA
+#include "tensorflow/compiler/xla/stream_executor/cuda/cuda_graph.h"
+#include "tensorflow/compiler/xla/stream_executor/gpu/gpu_stream.h"
+#endif  // GOOGLE_CUDA
+
+namespace tensorflow {
+
+GpuGraphReplayCache::~GpuGraphReplayCache() = default;
+
+/* static */ uint64 GpuGraphReplayCache::ShapeSignature(
+    gtl::ArraySlice<TensorShape> shapes) {
+  uint64 signature = shapes.size();
+  for (const TensorShape& shape : shapes) {
+    signature = Hash64Combine(signature, shape.dims());
+    for (int d = 0; d < shape.dims(); ++d) {
+      signature = Hash64Combine(signature, shape.dim_size(d));
+    }
+  }
+  return signature;
+}
+
+Status GpuGraphReplayCache::RunOrReplay(
+    uint64 signature, se::Stream* stream,
+    const std::function<Status()>& launch_fn, bool* replayed) {
+  *replayed = false;
+#if GOOGLE_CUDA
+  {
+    mutex_lock l(mu_);
+    Entry& entry = entries_[signature];
+    if (entry.exec != nullptr) {
+      TF_RETURN_IF_ERROR(
+          entry.exec->Launch(se::gpu::AsGpuStreamValue(stream)));
+      *replayed = true;
+      return OkStatus();
+    }
+    if (entry.uncapturable) {
+      return launch_fn();
+    }
+  }
+
+  // First call for this signature: try to capture the work "launch_fn"
+  // enqueues. Capture is attempted outside the lock; if two threads race on
+  // the same signature the first result to be inserted wins.
+  se::gpu::GpuStreamHandle stream_handle = se::gpu::AsGpuStreamValue(stream);
+  auto mark_uncapturable = [this, signature](const Status& cause) {
+    VLOG(1) << "CUDA graph capture failed for signature " << signature
+            << ", falling back to normal execution: " << cause;
+    mutex_lock l(mu_);
+    entries_[signature].uncapturable = true;
+  };
+
+  Status begin = se::gpu::BeginStreamCapture(stream_handle);
+  if (!begin.ok()) {
+    mark_uncapturable(begin);
+    return launch_fn();
+  }
+  Status launched = launch_fn();
+  auto exec_or = se::gpu::EndStreamCaptureAndInstantiate(stream_handle);
+  if (!launched.ok()) {
+    // The step itself failed; report that rather than any capture error, and
+    // leave the signature capturable in case the failure was transient.
+    return launched;
+  }
+  if (!exec_or.ok()) {
+    // The work was recorded, not executed, so the step still has to run.
+    mark_uncapturable(exec_or.status());
+    return launch_fn();
+  }
+
+  std::unique_ptr<se::gpu::CudaGraphExec> exec =
+      std::move(exec_or).value();
+  TF_RETURN_IF_ERROR(exec->Launch(stream_handle));
+  {
+    mutex_lock l(mu_);
+    Entry& entry = entries_[signature];
+    if (entry.exec == nullptr && !entry.uncapturable) {
+      entry.exec = std::move(exec);
+    }
+  }
+  return OkStatus();
+#else
+  return launch_fn();
+#endif  // GOOGLE_CUDA
+}
+
+}  // namespace tensorflow
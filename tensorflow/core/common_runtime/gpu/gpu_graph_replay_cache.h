@@ -0,0 +1,92 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
+
+#include <functional>
+#include <memory>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stream_executor.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace stream_executor {
+namespace gpu {
+class CudaGraphExec;
+}  // namespace gpu
+}  // namespace stream_executor
+
+namespace tensorflow {
+
+// Caches instantiated CUDA graphs keyed by an input shape signature, so that
+// a static sequence of device work recorded once can be replayed on later
+// steps with the same shapes at a fraction of the launch overhead.
+//
+// Usage: compute a signature for the step's inputs with ShapeSignature(),
+// then wrap the code that enqueues device work in RunOrReplay(). The first
+// call for a signature runs "launch_fn" under stream capture and
+// instantiates the recorded work; later calls with the same signature skip
+// "launch_fn" entirely and replay the instantiated graph. If capture fails
+// (e.g. the enqueued work includes a host callback or a synchronous memcpy),
+// the signature is permanently marked uncapturable and every call for it
+// runs "launch_fn" directly.
+//
+// "launch_fn" must enqueue work only on the supplied stream, and the work it
+// enqueues must be identical for every step with the same signature: same
+// kernels, same launch parameters and, critically, same device addresses.
+// Callers are responsible for ensuring buffer stability across steps.
+//
+// This class is thread-safe. On builds without CUDA, RunOrReplay() simply
+// invokes "launch_fn".
+class GpuGraphReplayCache {
+ public:
+  GpuGraphReplayCache() = default;
+  ~GpuGraphReplayCache();
+
+  // Returns a signature covering "shapes", suitable as a RunOrReplay() key.
+  // Callers should fold any other replay-relevant state (e.g. dtypes) into
+  // the key themselves.
+  static uint64 ShapeSignature(gtl::ArraySlice<TensorShape> shapes);
+
+  // Runs or replays one step's device work on "stream" (see class comment).
+  // Sets "*replayed" to true iff an already-captured graph was replayed, in
+  // which case "launch_fn" was not invoked.
+  Status RunOrReplay(uint64 signature, se::Stream* stream,
+                     const std::function<Status()>& launch_fn, bool* replayed);
+
+ private:
+  struct Entry {
+    // Null while a capture attempt has not yet succeeded.
+    std::unique_ptr<stream_executor::gpu::CudaGraphExec> exec;
+    // Set after a failed capture; suppresses further attempts.
+    bool uncapturable = false;
+  };
+
+  mutex mu_;
+  absl::flat_hash_map<uint64, Entry> entries_ TF_GUARDED_BY(mu_);
+
+  TF_DISALLOW_COPY_AND_ASSIGN(GpuGraphReplayCache);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_REPLAY_CACHE_H_
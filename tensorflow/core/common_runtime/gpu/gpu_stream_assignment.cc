@@ -0,0 +1,88 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_assignment.h"
+
+#include <vector>
+
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+namespace gpu_stream_assignment {
+namespace {
+
+// Returns true if "consumer" is the only node receiving data outputs of
+// "producer".
+bool IsSoleDataConsumer(const Node* producer, const Node* consumer) {
+  int num_data_edges = 0;
+  for (const Edge* e : producer->out_edges()) {
+    if (e->IsControlEdge()) continue;
+    if (e->dst() != consumer) return false;
+    ++num_data_edges;
+  }
+  return num_data_edges > 0;
+}
+
+}  // namespace
+
+Status AssignStreams(const Graph* graph, const AssignStreamsOpts& opts,
+                     std::unordered_map<int, int>* node_to_stream_id) {
+  if (graph == nullptr || node_to_stream_id == nullptr) {
+    return errors::InvalidArgument("Bad graph argument supplied.");
+  }
+  if (opts.max_streams < 1) {
+    return errors::InvalidArgument("Illegal max_streams=", opts.max_streams,
+                                   "; must be >= 1.");
+  }
+
+  // Topological order, so producers are assigned before their consumers.
+  std::vector<Node*> order;
+  GetReversePostOrder(*graph, &order);
+
+  int next_stream = 0;
+  for (const Node* n : order) {
+    if (!n->IsOp()) continue;  // Skip Source and Sink.
+
+    // Stay on the stream of a producer for which this node is the only data
+    // consumer, so that linear chains of ops share one stream.
+    int stream_id = -1;
+    for (const Edge* e : n->in_edges()) {
+      if (e->IsControlEdge()) continue;
+      auto it = node_to_stream_id->find(e->src()->id());
+      if (it == node_to_stream_id->end()) continue;
+      if (IsSoleDataConsumer(e->src(), n)) {
+        stream_id = it->second;
+        break;
+      }
+    }
+
+    // Otherwise this node starts an independent branch: either it has no
+    // assigned data inputs, or every one of them fans out to other branches
+    // too. Spread branch roots across the available streams round-robin.
+    if (stream_id == -1) {
+      stream_id = next_stream;
+      next_stream = (next_stream + 1) % opts.max_streams;
+    }
+
+    VLOG(2) << "Assigned stream " << stream_id << " to node " << n->name();
+    (*node_to_stream_id)[n->id()] = stream_id;
+  }
+  return OkStatus();
+}
+
+}  // namespace gpu_stream_assignment
+}  // namespace tensorflow
@@ -0,0 +1,48 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ASSIGNMENT_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ASSIGNMENT_H_
+
+#include <unordered_map>
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace gpu_stream_assignment {
+
+struct AssignStreamsOpts {
+  // Number of compute streams available; assigned stream ids are in
+  // [0, max_streams).
+  int32 max_streams = 1;
+};
+
+// Assigns a compute stream id to every op node in "graph" and records the
+// assignment in "*node_to_stream_id", keyed by node id.
+//
+// Nodes stay on the stream of a producer for which they are the only data
+// consumer, so a linear chain of ops shares one stream. A node whose
+// assigned data inputs all fan out to other consumers (or that has none)
+// starts an independent branch, and such branches are spread across the
+// available streams round-robin. Cross-stream edges in the result must be
+// ordered by the caller with event-based stream waits.
+Status AssignStreams(const Graph* graph, const AssignStreamsOpts& opts,
+                     std::unordered_map<int, int>* node_to_stream_id);
+
+}  // namespace gpu_stream_assignment
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ASSIGNMENT_H_
@@ -0,0 +1,101 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_assignment.h"
+
+#include <unordered_map>
+
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+Node* ScalarConstant(Graph* g) {
+  Tensor t(DT_FLOAT, TensorShape({}));
+  t.scalar<float>()() = 1.0f;
+  return test::graph::Constant(g, t);
+}
+
+TEST(GpuStreamAssignmentTest, LinearChainSharesOneStream) {
+  Graph g(OpRegistry::Global());
+  Node* a = ScalarConstant(&g);
+  Node* b = test::graph::Identity(&g, a);
+  Node* c = test::graph::Identity(&g, b);
+
+  gpu_stream_assignment::AssignStreamsOpts opts;
+  opts.max_streams = 4;
+  std::unordered_map<int, int> assignment;
+  TF_ASSERT_OK(gpu_stream_assignment::AssignStreams(&g, opts, &assignment));
+
+  EXPECT_EQ(assignment[a->id()], assignment[b->id()]);
+  EXPECT_EQ(assignment[b->id()], assignment[c->id()]);
+}
+
+TEST(GpuStreamAssignmentTest, FanOutBranchesUseSeparateStreams) {
+  Graph g(OpRegistry::Global());
+  Node* a = ScalarConstant(&g);
+  Node* b = test::graph::Unary(&g, "Exp", a);
+  Node* c = test::graph::Unary(&g, "Exp", a);
+  Node* d = test::graph::Add(&g, b, c);
+
+  gpu_stream_assignment::AssignStreamsOpts opts;
+  opts.max_streams = 2;
+  std::unordered_map<int, int> assignment;
+  TF_ASSERT_OK(gpu_stream_assignment::AssignStreams(&g, opts, &assignment));
+
+  // The two branches reading the shared constant run on different streams,
+  // and the join inherits the stream of one of its sole-consumed inputs.
+  EXPECT_NE(assignment[b->id()], assignment[c->id()]);
+  EXPECT_TRUE(assignment[d->id()] == assignment[b->id()] ||
+              assignment[d->id()] == assignment[c->id()]);
+}
+
+TEST(GpuStreamAssignmentTest, RespectsMaxStreams) {
+  Graph g(OpRegistry::Global());
+  Node* a = ScalarConstant(&g);
+  for (int i = 0; i < 8; ++i) {
+    test::graph::Unary(&g, "Exp", a);
+  }
+
+  gpu_stream_assignment::AssignStreamsOpts opts;
+  opts.max_streams = 3;
+  std::unordered_map<int, int> assignment;
+  TF_ASSERT_OK(gpu_stream_assignment::AssignStreams(&g, opts, &assignment));
+
+  for (const auto& entry : assignment) {
+    EXPECT_GE(entry.second, 0);
+    EXPECT_LT(entry.second, opts.max_streams);
+  }
+}
+
+TEST(GpuStreamAssignmentTest, RejectsBadArguments) {
+  Graph g(OpRegistry::Global());
+  std::unordered_map<int, int> assignment;
+  gpu_stream_assignment::AssignStreamsOpts opts;
+  EXPECT_FALSE(
+      gpu_stream_assignment::AssignStreams(nullptr, opts, &assignment).ok());
+  opts.max_streams = 0;
+  EXPECT_FALSE(
+      gpu_stream_assignment::AssignStreams(&g, opts, &assignment).ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
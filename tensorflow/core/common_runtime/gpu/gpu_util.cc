@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stream_executor.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 // IMPLEMENTATION NOTE:
@@ -183,6 +184,32 @@ void GPUUtil::SetProtoFromGPU(const Tensor& tensor, Device* dev,
       });
 }
 
+// Whether an intra-host device-to-device copy completes through a device
+// event instead of a host callback.  When enabled, the receiving device's
+// compute stream waits on the copy stream, so the copy done callback can be
+// invoked as soon as the copy is enqueued: every kernel later launched on
+// the receiver's compute stream is ordered after the copy by the event, and
+// the host round trip through EventMgr is off the critical path.  The
+// sender's buffer is still kept alive until the copy has finished.
+//
+// This assumes all consumers of the received tensor are ordered against the
+// receiving device's compute stream, which holds for the stock GPU runtime
+// (kernels run on the compute stream and the copy streams wait on it) but
+// not necessarily for setups that run kernels on multiple compute streams,
+// so it is opt-in.
+static bool UseDeviceEventForDeviceToDeviceCopy() {
+  static bool result = [] {
+    bool value = false;
+    Status status = ReadBoolFromEnvVar("TF_GPU_DEVICE_TO_DEVICE_USE_EVENT",
+                                       false, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << status;
+    }
+    return value;
+  }();
+  return result;
+}
+
 // static
 void GPUUtil::DeviceToDeviceCopy(
     DeviceContext* send_dev_context, DeviceContext* recv_dev_context,
@@ -209,6 +236,7 @@ void GPUUtil::DeviceToDeviceCopy(
   send_device_to_device_stream->ThenWaitFor(send_stream);
 
   const int64_t total_bytes = input->TotalBytes();
+  bool ordered_on_device = false;
   if (total_bytes > 0) {
     void* src_ptr = GetBase(input);
     DeviceMemoryBase gpu_src_ptr(src_ptr, total_bytes);
@@ -230,19 +258,41 @@ void GPUUtil::DeviceToDeviceCopy(
     VLOG(2) << "src_ptr " << src_ptr << " dst_ptr " << dst_ptr;
     send_device_to_device_stream->ThenMemcpy(&gpu_dst_ptr, gpu_src_ptr,
                                              total_bytes);
+    if (UseDeviceEventForDeviceToDeviceCopy()) {
+      // Hand the buffer to the consuming device by ordering its compute
+      // stream after the copy with a device event; see the comment on
+      // UseDeviceEventForDeviceToDeviceCopy().
+      recv_stream->ThenWaitFor(send_device_to_device_stream);
+      ordered_on_device = true;
+    }
   }
 
   // Use of input may outlive stack scope, so keep a ref.
   TensorReference input_ref(*input);
-  dev_info->event_mgr->ThenExecute(
-      send_device_to_device_stream,
-      [done, send_device_to_device_stream, input_ref]() {
-        input_ref.Unref();
-        if (!send_device_to_device_stream->ok()) {
-          LOG(FATAL) << "GPU->GPU Memcpy failed";
-        }
-        done(OkStatus());
-      });
+  if (ordered_on_device) {
+    // The receiver is ordered after the copy by the device event above, so
+    // the copy is complete as far as the consumer is concerned; only the
+    // release of the sender's buffer has to wait for the copy to finish.
+    dev_info->event_mgr->ThenExecute(
+        send_device_to_device_stream, [send_device_to_device_stream,
+                                       input_ref]() {
+          input_ref.Unref();
+          if (!send_device_to_device_stream->ok()) {
+            LOG(FATAL) << "GPU->GPU Memcpy failed";
+          }
+        });
+    done(OkStatus());
+  } else {
+    dev_info->event_mgr->ThenExecute(
+        send_device_to_device_stream,
+        [done, send_device_to_device_stream, input_ref]() {
+          input_ref.Unref();
+          if (!send_device_to_device_stream->ok()) {
+            LOG(FATAL) << "GPU->GPU Memcpy failed";
+          }
+          done(OkStatus());
+        });
+  }
   send_dev_context->MaintainLifetimeOnStream(input,
                                              send_device_to_device_stream);
 }
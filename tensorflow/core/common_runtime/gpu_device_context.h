@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_DEVICE_CONTEXT_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_DEVICE_CONTEXT_H_
 
+#include <utility>
+
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
@@ -64,6 +66,17 @@ class GPUDeviceContext : public DeviceContext {
     return host_memory_allocator_;
   }
 
+  // In multi-compute-stream mode, the streams whose prior work the ops
+  // assigned to this context consume values from. The device enqueues a wait
+  // on each of them before launching such an op on stream(). Empty for
+  // single-stream execution.
+  void set_wait_on_streams(gtl::InlinedVector<se::Stream*, 4> streams) {
+    wait_on_streams_ = std::move(streams);
+  }
+  const gtl::InlinedVector<se::Stream*, 4>& wait_on_streams() const {
+    return wait_on_streams_;
+  }
+
   void CopyCPUTensorToDevice(const Tensor* cpu_tensor, Device* device,
                              Tensor* device_tensor, StatusCallback done,
                              bool sync_dst_compute) const override;
@@ -97,6 +110,8 @@ class GPUDeviceContext : public DeviceContext {
   se::Stream* device_to_host_stream_;
   // Streams to use for copying data between GPUs.
   gtl::InlinedVector<se::Stream*, 4> device_to_device_stream_;
+  // Compute streams this context's ops have cross-stream dependencies on.
+  gtl::InlinedVector<se::Stream*, 4> wait_on_streams_;
   // The allocator to use for allocating pinned host memory.
   // Not owned.
   Allocator* host_memory_allocator_;
@@ -45,9 +45,13 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/scanner.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/threadpool.h"
 #include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
@@ -58,6 +62,10 @@ namespace {
 // can skip expensive duplicates check in 'AddControlEdge'.
 static constexpr const bool kDoNotCheckDuplicates = true;
 
+// Minimum number of NodeDefs before op lookup and attr validation are sharded
+// across a thread pool; below this the pool setup costs more than it saves.
+static constexpr int kMinNodesForParallelValidation = 10000;
+
 inline bool IsMerge(const NodeDef& node_def) {
   return node_def.op() == "Merge" || node_def.op() == "RefMerge" ||
          node_def.op() == "_XlaMerge";
@@ -210,6 +218,7 @@ class GraphConstructor {
   Status ValidateInputMapAndControlDependencies();
   Status BuildNodeIndex();
   Status InitFromEdges();
+  Status PreValidateNodeDefsInParallel();
   Status Convert();
   Status AddBackEdges();
   Status UpdateVersionDef();
@@ -349,6 +358,15 @@ class GraphConstructor {
   // still need to be converted.
   std::vector<int> pending_count_;
 
+  // Filled in by PreValidateNodeDefsInParallel(): the OpDef for each index
+  // within node_defs_, so Convert() can skip the registry lookup. Empty when
+  // the parallel pre-pass did not run.
+  std::vector<const OpDef*> cached_op_defs_;
+
+  // True iff PreValidateNodeDefsInParallel() already validated every NodeDef,
+  // in which case Convert() skips per-node validation.
+  bool nodes_prevalidated_ = false;
+
   // Mapping between index within node_defs_ and the index within node_defs_ of
   // all nodes it outputs to.
   std::vector<gtl::InlinedVector<int, 4>> outputs_;
@@ -1114,6 +1132,55 @@ void GraphConstructor::PrintCycles() {
   }
 }
 
+Status GraphConstructor::PreValidateNodeDefsInParallel() {
+  // Op lookup and attr validation dominate conversion time for large graphs
+  // and only read the immutable NodeDefs and the (thread-safe) op registry,
+  // so they are sharded across a thread pool here; the sequential topological
+  // pass in Convert() then skips them. Only the non-importing path qualifies,
+  // since importing rewrites node defs (prefixes, input remapping) before
+  // validating them.
+  const int num_nodes = node_def_count();
+  cached_op_defs_.assign(num_nodes, nullptr);
+
+  thread::ThreadPool pool(Env::Default(), "graph_constructor_validate",
+                          port::NumSchedulableCPUs());
+  mutex mu;
+  Status status;
+  pool.ParallelFor(
+      num_nodes, /*cost_per_unit=*/1000, [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          const NodeDef& node_def = get_node_def(i);
+          const OpDef* op_def;
+          Status s = g_->op_registry()->LookUpOpDef(node_def.op(), &op_def);
+          if (s.ok()) {
+            cached_op_defs_[i] = op_def;
+            if (opts_.validate_nodes) {
+              if (opts_.add_default_attributes) {
+                // Convert() adds the defaults to the node def it consumes;
+                // here they are only needed to make validation pass.
+                NodeDef node_with_defaults = node_def;
+                AddDefaultsToNodeDef(*op_def, &node_with_defaults);
+                s = ValidateNodeDef(node_with_defaults, *op_def);
+              } else {
+                s = ValidateNodeDef(node_def, *op_def);
+              }
+            }
+          }
+          if (!s.ok()) {
+            mutex_lock l(mu);
+            status.Update(s);
+            return;
+          }
+        }
+      });
+  {
+    mutex_lock l(mu);
+    TF_RETURN_IF_ERROR(status);
+  }
+  nodes_prevalidated_ = opts_.validate_nodes;
+  return OkStatus();
+}
+
 Status GraphConstructor::Convert() {
   // Import functions before adding nodes, since imported nodes may refer to
   // functions
@@ -1123,6 +1190,10 @@ Status GraphConstructor::Convert() {
     TF_RETURN_IF_ERROR(g_->AddFunctionLibrary(*library()));
   }
 
+  if (!opts_.importing && node_def_count() >= kMinNodesForParallelValidation) {
+    TF_RETURN_IF_ERROR(PreValidateNodeDefsInParallel());
+  }
+
   std::vector<InputInfo> inputs;
   int processed = 0;
 
@@ -1236,13 +1307,17 @@ Status GraphConstructor::Convert() {
     if (opts_.importing) {
       TF_RETURN_IF_ERROR(ModifyNodeDefForImport(&node_def));
     } else {
-      const OpDef* op_def;
-      TF_RETURN_IF_ERROR(
-          g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+      const OpDef* op_def =
+          o < static_cast<int>(cached_op_defs_.size()) ? cached_op_defs_[o]
+                                                       : nullptr;
+      if (op_def == nullptr) {
+        TF_RETURN_IF_ERROR(
+            g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+      }
       if (opts_.add_default_attributes) {
         AddDefaultsToNodeDef(*op_def, &node_def);
       }
-      if (opts_.validate_nodes) {
+      if (opts_.validate_nodes && !nodes_prevalidated_) {
         TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *op_def));
       }
     }
@@ -2823,6 +2823,47 @@ TEST_F(GraphConstructorTest, CopyGraph) {
   EXPECT_EQ(dst.versions().bad_consumers(0), bad);
 }
 
+// Large graphs take the sharded op-lookup/validation path in Convert(); the
+// result must be identical to the sequential path.
+TEST_F(GraphConstructorTest, LargeGraphUsesParallelValidation) {
+  const int kNumChains = 6000;
+  gdef_.Clear();
+  for (int i = 0; i < kNumChains; ++i) {
+    NodeDef* input = gdef_.add_node();
+    input->set_name(strings::StrCat("input_", i));
+    input->set_op("TestInput");
+    NodeDef* mul = gdef_.add_node();
+    mul->set_name(strings::StrCat("mul_", i));
+    mul->set_op("TestMul");
+    mul->add_input(strings::StrCat("input_", i, ":0"));
+    mul->add_input(strings::StrCat("input_", i, ":1"));
+  }
+
+  GraphConstructorOptions opts;
+  TF_ASSERT_OK(ConvertGraphDefToGraph(opts, gdef_, &graph_));
+  EXPECT_EQ(graph_.num_op_nodes(), kNumChains * 2);
+}
+
+TEST_F(GraphConstructorTest, LargeGraphParallelValidationReportsErrors) {
+  const int kNumNodes = 12000;
+  gdef_.Clear();
+  for (int i = 0; i < kNumNodes; ++i) {
+    NodeDef* node = gdef_.add_node();
+    node->set_name(strings::StrCat("node_", i));
+    node->set_op("TestParams");
+  }
+  NodeDef* bad = gdef_.add_node();
+  bad->set_name("bad");
+  bad->set_op("ABC");
+  (*bad->mutable_attr())["unknown_attr"].set_i(1);
+
+  GraphConstructorOptions opts;
+  Status status = ConvertGraphDefToGraph(opts, gdef_, &graph_);
+  EXPECT_FALSE(status.ok());
+  EXPECT_TRUE(status.error_message().find("unknown_attr") != string::npos)
+      << status;
+}
+
 // Confirms that graph def version in the graph reaches the shape inference
 // function.
 TEST_F(GraphConstructorTest, GraphDefVersionUsedForShapeInference) {
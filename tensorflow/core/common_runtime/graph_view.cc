@@ -60,6 +60,7 @@ GraphView::~GraphView() {
     }
   }
   delete[] node_offsets_;
+  delete[] hot_items_;
   delete[] space_;
 }
 
@@ -99,6 +100,7 @@ size_t GraphView::NodeItemBytes(const Node* n) {
             sizeof(ControlEdgeInfo)                // output_control_edges[...]
       + num_outputs * sizeof(AllocatorAttributes)  // output_attr[...]
       + num_outputs * sizeof(int)                  // forward_from[num_outputs]
+      + num_outputs * sizeof(int)                  // preferred_forward_from[..]
       + num_inputs * sizeof(uint8)                 // input_type[num_inputs]
       + num_outputs * sizeof(uint8);               // output_type[num_outputs]
   static constexpr size_t kItemAlignment = sizeof(NodeItem*);
@@ -205,11 +207,15 @@ char* GraphView::InitializeNode(char* ptr, const Node* n) {
     std::vector<int> forward_input;
     Status fwd_status =
         GetNodeAttr(n->attrs(), "_forward_input", &forward_input);
+    std::vector<int> preferred_forward_input;
+    Status preferred_fwd_status = GetNodeAttr(
+        n->attrs(), "_preferred_forward_input", &preferred_forward_input);
     std::vector<int> scoped_allocator_attrs;
     Status sa_status =
         GetNodeAttr(n->attrs(), "_scoped_allocator", &scoped_allocator_attrs);
 
     int* forward_from = item->forward_from_base();
+    int* preferred_forward_from = item->preferred_forward_from_base();
     uint8* output_types = item->output_type_base();
     for (int i = 0; i < num_outputs; ++i) {
       output_types[i] = static_cast<uint8>(n->output_type(i));
@@ -238,6 +244,19 @@ char* GraphView::InitializeNode(char* ptr, const Node* n) {
           }
         }
       }
+      // A best-effort buffer reuse hint only applies to outputs without a
+      // hard forwarding or ScopedAllocator reservation.
+      preferred_forward_from[i] = OpKernelContext::Params::kNoReservation;
+      if (preferred_fwd_status.ok() &&
+          forward_from[i] == OpKernelContext::Params::kNoReservation) {
+        DCHECK_EQ(preferred_forward_input.size() % 2, 0);
+        for (int j = 0; j < preferred_forward_input.size(); j += 2) {
+          if (preferred_forward_input[j + 1] == i) {
+            preferred_forward_from[i] = preferred_forward_input[j];
+            break;
+          }
+        }
+      }
     }
   }
 
@@ -285,6 +304,20 @@ Status GraphView::Initialize(const Graph* g) {
     }
   }
   CHECK_EQ(ptr, space_ + total_bytes);
+
+  // Gather the fields the propagation inner loop reads per edge destination
+  // into a dense table, so activating a node does not have to pull in its
+  // full variable-length record.
+  hot_items_ = new NodeItemHot[num_nodes];
+  for (int32_t id = 0; id < num_nodes; ++id) {
+    NodeItem* item = node(id);
+    if (item == nullptr) continue;
+    NodeItemHot& hot = hot_items_[id];
+    hot.item = item;
+    hot.num_inputs = item->num_inputs;
+    hot.is_merge = item->is_merge;
+    hot.is_control_trigger = item->is_control_trigger;
+  }
   return OkStatus();
 }
 
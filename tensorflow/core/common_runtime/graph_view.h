@@ -92,6 +92,11 @@ struct NodeItem {
   // If the kernel is a Const op, this containts points to the constant tensor.
   const Tensor* const_tensor = nullptr;
 
+  // Scheduling priority hint (higher runs sooner), taken from the node's
+  // "_scheduling_priority" attr written by grappler's parallelism advisor.
+  // Zero when the graph carries no hints.
+  int64_t scheduling_priority = 0;
+
   // Cached values of node->num_inputs() and node->num_outputs(), to
   // avoid levels of indirection.
   int num_inputs;
@@ -144,6 +149,17 @@ struct NodeItem {
   // 0... for forward from that input.
   const int* forward_from() const { return forward_from_base(); }
 
+  // Return array of input indices whose buffer each output should
+  // preferably reuse, taken from the node's "_preferred_forward_input"
+  // attr written by a grappler memory plan:
+  // kNoReservation (-1) for no hint.
+  // 0... to try forwarding from that input.
+  // Unlike forward_from() this is advisory; allocation proceeds normally
+  // when the input buffer cannot be reused.
+  const int* preferred_forward_from() const {
+    return preferred_forward_from_base();
+  }
+
   string DebugString() const;
 
  private:
@@ -157,6 +173,7 @@ struct NodeItem {
   //   ControlEdgeInfo     out_control_edges[num_output_control_edges];
   //   AllocatorAttributes output_attr[num_outputs];
   //   int                 forward_from[num_outputs];
+  //   int                 preferred_forward_from[num_outputs];
   //   uint8               input_type[num_inputs];
   //   uint8               output_type[num_outputs];
 
@@ -186,23 +203,47 @@ struct NodeItem {
                                       num_output_control_edges +
                                   sizeof(AllocatorAttributes) * num_outputs);
   }
+  int* preferred_forward_from_base() const {
+    return reinterpret_cast<int*>(var() + sizeof(EdgeInfo) * num_output_edges +
+                                  sizeof(ControlEdgeInfo) *
+                                      num_output_control_edges +
+                                  sizeof(AllocatorAttributes) * num_outputs +
+                                  sizeof(int) * num_outputs);
+  }
   uint8* input_type_base() const {
     return reinterpret_cast<uint8*>(
         var() + sizeof(EdgeInfo) * num_output_edges +
         sizeof(ControlEdgeInfo) * num_output_control_edges +
-        sizeof(AllocatorAttributes) * num_outputs + sizeof(int) * num_outputs);
+        sizeof(AllocatorAttributes) * num_outputs +
+        2 * sizeof(int) * num_outputs);
   }
   uint8* output_type_base() const {
     return reinterpret_cast<uint8*>(
         var() + sizeof(EdgeInfo) * num_output_edges +
         sizeof(ControlEdgeInfo) * num_output_control_edges +
-        sizeof(AllocatorAttributes) * num_outputs + sizeof(int) * num_outputs +
-        sizeof(uint8) * num_inputs);
+        sizeof(AllocatorAttributes) * num_outputs +
+        2 * sizeof(int) * num_outputs + sizeof(uint8) * num_inputs);
   }
 
   TF_DISALLOW_COPY_AND_ASSIGN(NodeItem);
 };
 
+// Dense per-node summary of the `NodeItem` fields the propagation inner loop
+// reads for each edge destination.  Activating a node needs only a couple of
+// flags, its input count and the item pointer for the ready queue, so reading
+// them through this compact table instead of each destination's full
+// variable-length record keeps the loop's working set small on large graphs.
+struct NodeItemHot {
+  // Equal to GraphView::node(id); nullptr if the node does not exist.
+  NodeItem* item = nullptr;
+  // Copy of item->num_inputs.
+  int32 num_inputs = 0;
+  // Copy of item->is_merge.
+  bool is_merge = false;
+  // Copy of item->is_control_trigger.
+  bool is_control_trigger = false;
+};
+
 // Immutable view of a Graph organized for efficient execution.
 //
 // TODO(b/152651962): Add independent unit tests for this class.
@@ -237,6 +278,15 @@ class GraphView {
     return *reinterpret_cast<NodeItem*>(space_ + node_offsets_[id]);
   }
 
+  // Returns the hot-field summary of the node with the given `id`.
+  //
+  // REQUIRES: `id` must be in [0, num_nodes()).
+  const NodeItemHot& hot(int32_t id) const {
+    DCHECK_GE(id, 0);
+    DCHECK_LT(id, num_nodes_);
+    return hot_items_[id];
+  }
+
   int32 num_nodes() const { return num_nodes_; }
 
  private:
@@ -247,6 +297,8 @@ class GraphView {
   uint32* node_offsets_ = nullptr;  // array of size "num_nodes_"
   // node_offsets_[id] holds the byte offset for node w/ "id" in space_
 
+  NodeItemHot* hot_items_ = nullptr;  // array of size "num_nodes_"
+
   char* space_;  // NodeItem objects are allocated here
 
   TF_DISALLOW_COPY_AND_ASSIGN(GraphView);
@@ -33,6 +33,7 @@ limitations under the License.
 
 namespace tensorflow {
 
+class DeviceContext;
 class Graph;
 
 // Represents the state of an executor (graph and control flow information)
@@ -92,6 +93,12 @@ class ImmutableExecutorState {
   }
   const std::vector<const NodeItem*>& root_nodes() const { return root_nodes_; }
 
+  // Per-node device contexts supplied by Device::FillContextMap, indexed by
+  // node id. Empty when every node uses the device's default context.
+  const std::vector<DeviceContext*>& device_context_map() const {
+    return device_context_map_;
+  }
+
   const FrameInfo& get_root_frame_info() const { return *root_frame_info_; }
 
   const FrameInfo& get_enter_frame_info(const NodeItem& node_item) const {
@@ -101,6 +108,13 @@ class ImmutableExecutorState {
 
   bool requires_control_flow_support() const { return requires_control_flow_; }
 
+  // True iff any node in the graph carries a nonzero "_scheduling_priority"
+  // hint. When false, the executor can skip priority-ordering its ready
+  // queues, since every node compares equal.
+  bool has_scheduling_priorities() const {
+    return has_scheduling_priorities_;
+  }
+
   // Copies the pending counts for nodes in this graph to the given array.
   //
   // This method provides a more efficient way of initializing
@@ -132,11 +146,16 @@ class ImmutableExecutorState {
   LocalExecutorParams params_;
   GraphView gview_;
   bool requires_control_flow_;
+  bool has_scheduling_priorities_ = false;
   std::vector<PendingCounts::Handle> pending_ids_;
 
   // Root nodes (with no in edges) that should form the initial ready queue
   std::vector<const NodeItem*> root_nodes_;
 
+  // Per-node device contexts from Device::FillContextMap, indexed by node id.
+  // Not owned. Empty unless the device assigns contexts per node.
+  std::vector<DeviceContext*> device_context_map_;
+
   // Mapping from frame name to static information about the frame.
   // TODO(yuanbyu): We could cache it along with the graph so to avoid
   // the overhead of constructing it for each executor instance.
@@ -20,6 +20,7 @@ limitations under the License.
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/core/common_runtime/process_state.h"
 #include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/common_runtime/spinning_thread_pool.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_feature_guard.h"
@@ -87,11 +88,27 @@ struct LocalDevice::EigenThreadPoolInfo {
     ThreadOptions thread_opts;
     thread_opts.numa_node = numa_node;
     eigen_worker_threads_.num_threads = intra_op_parallelism_threads;
-    eigen_worker_threads_.workers = new thread::ThreadPool(
-        options.env, thread_opts, strings::StrCat("numa_", numa_node, "_Eigen"),
-        intra_op_parallelism_threads,
-        !options.config.experimental().disable_thread_spinning(),
-        /*allocator=*/nullptr);
+    const int64_t spin_duration_us =
+        options.config.experimental().intra_op_thread_spin_duration_us();
+    if (spin_duration_us > 0 &&
+        !options.config.experimental().disable_thread_spinning()) {
+      // Latency-critical configuration: idle workers busy-poll for
+      // `spin_duration_us` before parking, so ops dispatched to a recently
+      // idle pool skip the per-worker wakeup.
+      spinning_pool_.reset(new SpinningThreadPool(
+          options.env, thread_opts,
+          strings::StrCat("numa_", numa_node, "_Eigen"),
+          intra_op_parallelism_threads, spin_duration_us));
+      eigen_worker_threads_.workers =
+          new thread::ThreadPool(spinning_pool_.get());
+    } else {
+      eigen_worker_threads_.workers = new thread::ThreadPool(
+          options.env, thread_opts,
+          strings::StrCat("numa_", numa_node, "_Eigen"),
+          intra_op_parallelism_threads,
+          !options.config.experimental().disable_thread_spinning(),
+          /*allocator=*/nullptr);
+    }
     Eigen::ThreadPoolInterface* threadpool =
         eigen_worker_threads_.workers->AsEigenThreadPool();
     if (allocator != nullptr) {
@@ -103,12 +120,14 @@ struct LocalDevice::EigenThreadPoolInfo {
 
   ~EigenThreadPoolInfo() {
     eigen_device_.reset();
+    // `workers` may wrap `spinning_pool_`, so it must be deleted first.
     delete eigen_worker_threads_.workers;
   }
 
   DeviceBase::CpuWorkerThreads eigen_worker_threads_;
   std::unique_ptr<Eigen::ThreadPoolDevice> eigen_device_;
   std::unique_ptr<EigenAllocator> eigen_allocator_;
+  std::unique_ptr<SpinningThreadPool> spinning_pool_;
 };
 
 LocalDevice::LocalDevice(const SessionOptions& options,
@@ -0,0 +1,203 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/numa_bfc_allocator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/numa.h"
+
+namespace tensorflow {
+
+class NumaBFCAllocator::RegionRecordingSubAllocator : public SubAllocator {
+ public:
+  RegionRecordingSubAllocator(NumaBFCAllocator* owner, int node,
+                              const std::vector<Visitor>& alloc_visitors,
+                              const std::vector<Visitor>& free_visitors)
+      : SubAllocator({}, {}),
+        owner_(owner),
+        node_(node),
+        delegate_(node, alloc_visitors, free_visitors) {}
+
+  void* Alloc(size_t alignment, size_t num_bytes,
+              size_t* bytes_received) override {
+    void* ptr = delegate_.Alloc(alignment, num_bytes, bytes_received);
+    if (ptr != nullptr) {
+      owner_->AddRegion(ptr, *bytes_received, node_);
+    }
+    return ptr;
+  }
+
+  void Free(void* ptr, size_t num_bytes) override {
+    if (ptr != nullptr) {
+      owner_->RemoveRegion(ptr);
+    }
+    delegate_.Free(ptr, num_bytes);
+  }
+
+  bool SupportsCoalescing() const override {
+    return delegate_.SupportsCoalescing();
+  }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return delegate_.GetMemoryType();
+  }
+
+ private:
+  NumaBFCAllocator* const owner_;
+  const int node_;
+  BasicCPUAllocator delegate_;
+};
+
+NumaBFCAllocator::NumaBFCAllocator(
+    size_t total_memory, const string& name, const BFCAllocator::Options& opts,
+    const std::vector<SubAllocator::Visitor>& alloc_visitors,
+    const std::vector<SubAllocator::Visitor>& free_visitors)
+    : name_(name),
+      regions_(std::make_shared<const std::vector<Region>>()) {
+  const int num_nodes = std::max(1, port::NUMANumNodes());
+  const size_t per_node_memory = total_memory / num_nodes;
+  pools_.reserve(num_nodes);
+  for (int node = 0; node < num_nodes; ++node) {
+    pools_.push_back(std::make_unique<BFCAllocator>(
+        absl::make_unique<RegionRecordingSubAllocator>(
+            this, node, alloc_visitors, free_visitors),
+        per_node_memory, strings::StrCat(name, "_node", node), opts));
+  }
+  VLOG(1) << "NumaBFCAllocator " << name_ << " partitioned across "
+          << num_nodes << " NUMA nodes, " << per_node_memory
+          << " bytes per node";
+}
+
+NumaBFCAllocator::~NumaBFCAllocator() {}
+
+int NumaBFCAllocator::LocalNode() const {
+  int node = port::NUMAGetThreadNodeAffinity();
+  if (node != port::kNUMANoAffinity && node < num_nodes()) {
+    return node;
+  }
+  // Threads without an affinity are spread round-robin across the sub-pools
+  // and then stick to their assignment, so a given thread keeps hitting one
+  // pool (and one mutex).
+  static thread_local int assigned_node = -1;
+  if (assigned_node < 0) {
+    assigned_node =
+        next_node_.fetch_add(1, std::memory_order_relaxed) % num_nodes();
+  }
+  return assigned_node;
+}
+
+void* NumaBFCAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  const int local = LocalNode();
+  void* ptr = pools_[local]->AllocateRaw(alignment, num_bytes);
+  if (TF_PREDICT_TRUE(ptr != nullptr)) return ptr;
+  // Local pool exhausted: steal from the other nodes before reporting OOM.
+  for (int i = 1; i < num_nodes(); ++i) {
+    const int node = (local + i) % num_nodes();
+    ptr = pools_[node]->AllocateRaw(alignment, num_bytes);
+    if (ptr != nullptr) {
+      VLOG(2) << Name() << ": node " << local << " exhausted, allocated "
+              << num_bytes << " bytes from node " << node;
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+void NumaBFCAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  const int node = NodeForPointer(ptr);
+  CHECK_GE(node, 0) << "DeallocateRaw of pointer not owned by " << Name();
+  pools_[node]->DeallocateRaw(ptr);
+}
+
+size_t NumaBFCAllocator::RequestedSize(const void* ptr) const {
+  const int node = NodeForPointer(ptr);
+  CHECK_GE(node, 0);
+  return pools_[node]->RequestedSize(ptr);
+}
+
+size_t NumaBFCAllocator::AllocatedSize(const void* ptr) const {
+  const int node = NodeForPointer(ptr);
+  CHECK_GE(node, 0);
+  return pools_[node]->AllocatedSize(ptr);
+}
+
+absl::optional<AllocatorStats> NumaBFCAllocator::GetStats() {
+  AllocatorStats merged;
+  for (auto& pool : pools_) {
+    absl::optional<AllocatorStats> stats = pool->GetStats();
+    if (!stats) continue;
+    merged.num_allocs += stats->num_allocs;
+    merged.bytes_in_use += stats->bytes_in_use;
+    merged.peak_bytes_in_use += stats->peak_bytes_in_use;
+    merged.largest_alloc_size =
+        std::max(merged.largest_alloc_size, stats->largest_alloc_size);
+    if (stats->bytes_limit) {
+      merged.bytes_limit =
+          merged.bytes_limit.value_or(0) + *stats->bytes_limit;
+    }
+    merged.bytes_reserved += stats->bytes_reserved;
+    merged.peak_bytes_reserved += stats->peak_bytes_reserved;
+  }
+  return merged;
+}
+
+bool NumaBFCAllocator::ClearStats() {
+  bool ok = true;
+  for (auto& pool : pools_) {
+    ok = pool->ClearStats() && ok;
+  }
+  return ok;
+}
+
+int NumaBFCAllocator::NodeForPointer(const void* ptr) const {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+  std::shared_ptr<const std::vector<Region>> regions =
+      std::atomic_load(&regions_);
+  for (const Region& region : *regions) {
+    if (address >= region.base && address < region.base + region.size) {
+      return region.node;
+    }
+  }
+  return -1;
+}
+
+void NumaBFCAllocator::AddRegion(void* ptr, size_t size, int node) {
+  mutex_lock l(regions_mu_);
+  auto updated = std::make_shared<std::vector<Region>>(*regions_);
+  updated->push_back({reinterpret_cast<uintptr_t>(ptr), size, node});
+  std::atomic_store(&regions_,
+                    std::shared_ptr<const std::vector<Region>>(updated));
+}
+
+void NumaBFCAllocator::RemoveRegion(void* ptr) {
+  const uintptr_t base = reinterpret_cast<uintptr_t>(ptr);
+  mutex_lock l(regions_mu_);
+  auto updated = std::make_shared<std::vector<Region>>(*regions_);
+  updated->erase(std::remove_if(updated->begin(), updated->end(),
+                                [base](const Region& region) {
+                                  return region.base == base;
+                                }),
+                 updated->end());
+  std::atomic_store(&regions_,
+                    std::shared_ptr<const std::vector<Region>>(updated));
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,113 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_NUMA_BFC_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_NUMA_BFC_ALLOCATOR_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A NUMA-partitioned CPU allocator: one BFCAllocator sub-pool per NUMA node,
+// each backed by memory pinned to that node. A thread allocates from the
+// sub-pool of the node it runs on (so op scratch and output buffers are
+// node-local), and only falls over to the other nodes' sub-pools when its
+// local pool cannot satisfy the request. This both removes the single
+// allocator mutex as a cross-socket serialization point and avoids handing
+// out remote memory on multi-socket machines.
+//
+// Deallocation is routed back to the owning sub-pool by looking the pointer
+// up in the set of memory regions the sub-pools have extended into; the
+// region list changes only when a sub-pool grows, so lookups are a read of an
+// atomically swapped snapshot plus a short scan.
+//
+// This class is thread-safe.
+class NumaBFCAllocator : public Allocator {
+ public:
+  // `total_memory` is split evenly across the per-node sub-pools. The
+  // visitors are forwarded to each sub-pool's underlying BasicCPUAllocator.
+  NumaBFCAllocator(size_t total_memory, const string& name,
+                   const BFCAllocator::Options& opts,
+                   const std::vector<SubAllocator::Visitor>& alloc_visitors,
+                   const std::vector<SubAllocator::Visitor>& free_visitors);
+  ~NumaBFCAllocator() override;
+
+  string Name() override { return name_; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  bool TracksAllocationSizes() const override { return true; }
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+
+  absl::optional<AllocatorStats> GetStats() override;
+  bool ClearStats() override;
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return AllocatorMemoryType::kHostPageable;
+  }
+
+  int num_nodes() const { return static_cast<int>(pools_.size()); }
+
+ private:
+  // A SubAllocator that delegates to a node-pinned BasicCPUAllocator and
+  // records every region handed to the owning sub-pool, so that pointers can
+  // later be routed back to it.
+  class RegionRecordingSubAllocator;
+
+  struct Region {
+    uintptr_t base;
+    size_t size;
+    int node;
+  };
+
+  // Returns the sub-pool index preferred by the calling thread.
+  int LocalNode() const;
+
+  // Returns the index of the sub-pool owning `ptr`, or -1 if unknown.
+  int NodeForPointer(const void* ptr) const;
+
+  // Called by RegionRecordingSubAllocator under `regions_mu_`.
+  void AddRegion(void* ptr, size_t size, int node);
+  void RemoveRegion(void* ptr);
+
+  const string name_;
+  std::vector<std::unique_ptr<BFCAllocator>> pools_;
+
+  // Round-robin assignment for threads without a NUMA affinity.
+  mutable std::atomic<uint32> next_node_{0};
+
+  // Snapshot of the regions backing the sub-pools. Replaced wholesale (under
+  // `regions_mu_`) whenever a sub-pool grows or shrinks; readers load the
+  // shared_ptr without taking the lock.
+  mutable mutex regions_mu_;
+  std::shared_ptr<const std::vector<Region>> regions_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(NumaBFCAllocator);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_NUMA_BFC_ALLOCATOR_H_
@@ -0,0 +1,105 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/op_sampling_profiler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+thread_local int64_t OpSamplingProfiler::countdown_ = 0;
+thread_local OpSamplingProfiler::ThreadBuffer OpSamplingProfiler::buffer_;
+
+OpSamplingProfiler::ThreadBuffer::~ThreadBuffer() {
+  if (pending > 0) {
+    // The singleton is never destroyed, so it outlives every thread buffer.
+    OpSamplingProfiler* profiler = OpSamplingProfiler::Get();
+    if (profiler != nullptr) profiler->Flush(this);
+  }
+}
+
+/* static */ OpSamplingProfiler* OpSamplingProfiler::Get() {
+  static OpSamplingProfiler* const instance = []() -> OpSamplingProfiler* {
+    int64_t sample_rate = 0;
+    Status s =
+        ReadInt64FromEnvVar("TF_OP_PROFILER_SAMPLE_RATE", 0, &sample_rate);
+    if (!s.ok()) {
+      LOG(WARNING) << "Op sampling profiler disabled: " << s.error_message();
+      return nullptr;
+    }
+    if (sample_rate <= 0) return nullptr;
+    LOG(INFO) << "Op sampling profiler enabled, sampling 1 in " << sample_rate
+              << " kernel invocations per thread.";
+    return new OpSamplingProfiler(sample_rate);
+  }();
+  return instance;
+}
+
+void OpSamplingProfiler::Record(StringPiece op_name, StringPiece op_type,
+                                uint64 elapsed_cycles) {
+  Totals& totals = buffer_.stats[std::make_pair(string(op_name),
+                                                string(op_type))];
+  totals.count++;
+  totals.total_cycles += elapsed_cycles;
+  if (++buffer_.pending >= kFlushInterval) {
+    Flush(&buffer_);
+  }
+}
+
+void OpSamplingProfiler::Flush(ThreadBuffer* buffer) {
+  {
+    mutex_lock l(mu_);
+    for (const auto& entry : buffer->stats) {
+      Totals& totals = totals_[entry.first];
+      totals.count += entry.second.count;
+      totals.total_cycles += entry.second.total_cycles;
+    }
+  }
+  buffer->stats.clear();
+  buffer->pending = 0;
+}
+
+std::vector<OpSamplingProfiler::OpStats> OpSamplingProfiler::Snapshot() {
+  if (buffer_.pending > 0) Flush(&buffer_);
+  std::vector<OpStats> result;
+  {
+    mutex_lock l(mu_);
+    result.reserve(totals_.size());
+    for (const auto& entry : totals_) {
+      OpStats stats;
+      stats.op_name = entry.first.first;
+      stats.op_type = entry.first.second;
+      stats.count = entry.second.count;
+      stats.total_cycles = entry.second.total_cycles;
+      result.push_back(std::move(stats));
+    }
+  }
+  // Deterministic order, most expensive first, for export and logging.
+  std::sort(result.begin(), result.end(),
+            [](const OpStats& a, const OpStats& b) {
+              if (a.total_cycles != b.total_cycles) {
+                return a.total_cycles > b.total_cycles;
+              }
+              return a.op_name < b.op_name;
+            });
+  return result;
+}
+
+}  // namespace tensorflow
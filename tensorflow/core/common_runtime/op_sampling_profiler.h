@@ -0,0 +1,119 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_OP_SAMPLING_PROFILER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_OP_SAMPLING_PROFILER_H_
+
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stringpiece.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Sampling profiler for continuous per-op CPU latency attribution.
+//
+// Collecting full RunMetadata through StepStatsCollector is too expensive to
+// leave enabled outside of one-off traced steps.  This class instead samples
+// one in every TF_OP_PROFILER_SAMPLE_RATE synchronous kernel invocations per
+// executor thread, reusing the cycle counter the executor already reads for
+// its expensive-kernel cost estimates.  Samples are aggregated per
+// {op name, op type} in thread-local buffers and merged into a process-wide
+// table every kFlushInterval samples, so the hot path never takes a lock.
+//
+// The cumulative table is exported through the profiler service by the
+// op_sampling_collector backend (profiler/backends/cpu), which snapshots it
+// at session start and stop and emits the delta as an XPlane.
+class OpSamplingProfiler {
+ public:
+  // Cumulative totals for one op, aggregated across threads.
+  struct OpStats {
+    string op_name;
+    string op_type;
+    uint64 count = 0;
+    uint64 total_cycles = 0;
+  };
+
+  // Returns the process-wide profiler, or nullptr when sampling is disabled
+  // (TF_OP_PROFILER_SAMPLE_RATE unset or not a positive integer).  The
+  // environment variable is read once on first call.
+  static OpSamplingProfiler* Get();
+
+  // Returns true once every sample_rate() calls on the calling thread.
+  // Cheap enough for the executor's per-node dispatch path: a decrement and
+  // branch on a thread-local countdown.
+  bool ShouldSample() {
+    if (TF_PREDICT_TRUE(--countdown_ > 0)) return false;
+    countdown_ = sample_rate_;
+    return true;
+  }
+
+  // Accounts `elapsed_cycles` spent in one sampled invocation of the kernel
+  // named `op_name` with type `op_type`.  Must only be called after
+  // ShouldSample() returned true.
+  void Record(StringPiece op_name, StringPiece op_type, uint64 elapsed_cycles);
+
+  // Flushes the calling thread's buffer and returns the per-op totals
+  // accumulated since process start.  Samples recorded by other threads
+  // become visible after their next periodic flush, which in steady state
+  // lags by at most kFlushInterval samples per thread.
+  std::vector<OpStats> Snapshot();
+
+  int64_t sample_rate() const { return sample_rate_; }
+
+ private:
+  friend class OpSamplingProfilerTest;
+
+  struct Totals {
+    uint64 count = 0;
+    uint64 total_cycles = 0;
+  };
+  // Keyed by {op name, op type}.
+  using StatsMap = absl::flat_hash_map<std::pair<string, string>, Totals>;
+
+  // Buffer merged into the global table every kFlushInterval samples and on
+  // thread exit.
+  struct ThreadBuffer {
+    StatsMap stats;
+    int64_t pending = 0;
+    ~ThreadBuffer();
+  };
+
+  static constexpr int64_t kFlushInterval = 512;
+
+  explicit OpSamplingProfiler(int64_t sample_rate)
+      : sample_rate_(sample_rate) {}
+
+  void Flush(ThreadBuffer* buffer);
+
+  static thread_local int64_t countdown_;
+  static thread_local ThreadBuffer buffer_;
+
+  const int64_t sample_rate_;
+
+  mutex mu_;
+  StatsMap totals_ TF_GUARDED_BY(mu_);
+
+  TF_DISALLOW_COPY_AND_ASSIGN(OpSamplingProfiler);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_OP_SAMPLING_PROFILER_H_
@@ -0,0 +1,70 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/op_sampling_profiler.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+
+// Friend of OpSamplingProfiler; constructs instances directly rather than
+// going through the environment-gated singleton.
+class OpSamplingProfilerTest : public ::testing::Test {
+ protected:
+  static std::unique_ptr<OpSamplingProfiler> MakeProfiler(int64_t sample_rate) {
+    return std::unique_ptr<OpSamplingProfiler>(
+        new OpSamplingProfiler(sample_rate));
+  }
+};
+
+TEST_F(OpSamplingProfilerTest, ShouldSampleOncePerRate) {
+  auto profiler = MakeProfiler(/*sample_rate=*/5);
+  int samples = 0;
+  for (int i = 0; i < 3 * 5; ++i) {
+    if (profiler->ShouldSample()) ++samples;
+  }
+  EXPECT_EQ(samples, 3);
+}
+
+TEST_F(OpSamplingProfilerTest, RecordAggregatesPerOp) {
+  auto profiler = MakeProfiler(/*sample_rate=*/1);
+  profiler->Record("matmul_1", "MatMul", 100);
+  profiler->Record("matmul_1", "MatMul", 300);
+  profiler->Record("relu_1", "Relu", 50);
+  std::vector<OpSamplingProfiler::OpStats> snapshot = profiler->Snapshot();
+  ASSERT_EQ(snapshot.size(), 2);
+  // Sorted by total cycles, most expensive first.
+  EXPECT_EQ(snapshot[0].op_name, "matmul_1");
+  EXPECT_EQ(snapshot[0].op_type, "MatMul");
+  EXPECT_EQ(snapshot[0].count, 2);
+  EXPECT_EQ(snapshot[0].total_cycles, 400);
+  EXPECT_EQ(snapshot[1].op_name, "relu_1");
+  EXPECT_EQ(snapshot[1].count, 1);
+}
+
+TEST_F(OpSamplingProfilerTest, SnapshotIsCumulative) {
+  auto profiler = MakeProfiler(/*sample_rate=*/1);
+  profiler->Record("add_1", "AddV2", 10);
+  EXPECT_EQ(profiler->Snapshot().size(), 1);
+  profiler->Record("add_1", "AddV2", 10);
+  std::vector<OpSamplingProfiler::OpStats> snapshot = profiler->Snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].count, 2);
+  EXPECT_EQ(snapshot[0].total_cycles, 20);
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,120 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/pinned_staging_buffer_pool.h"
+
+#include <cstring>
+
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+
+namespace tensorflow {
+
+// Hands a pooled buffer to a Tensor and returns it to the pool when the last
+// reference to the Tensor goes away.
+class PinnedStagingBufferPool::StagingBuffer : public TensorBuffer {
+ public:
+  StagingBuffer(PinnedStagingBufferPool* pool, void* data, size_t size)
+      : TensorBuffer(data), pool_(pool), size_(size) {}
+
+  ~StagingBuffer() override { pool_->Release(data(), size_); }
+
+  size_t size() const override { return size_; }
+
+  TensorBuffer* root_buffer() override { return this; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocated_bytes(size_);
+  }
+
+ private:
+  PinnedStagingBufferPool* const pool_;
+  const size_t size_;
+};
+
+/* static */
+PinnedStagingBufferPool* PinnedStagingBufferPool::Get(Allocator* allocator) {
+  static mutex* pools_mu = new mutex;
+  static auto* pools =
+      new absl::flat_hash_map<Allocator*, PinnedStagingBufferPool*>;
+  mutex_lock l(*pools_mu);
+  auto it = pools->find(allocator);
+  if (it == pools->end()) {
+    it = pools->emplace(allocator, new PinnedStagingBufferPool(allocator))
+             .first;
+  }
+  return it->second;
+}
+
+PinnedStagingBufferPool::PinnedStagingBufferPool(Allocator* allocator)
+    : allocator_(allocator) {}
+
+PinnedStagingBufferPool::~PinnedStagingBufferPool() {
+  mutex_lock l(mu_);
+  for (auto& size_class : free_buffers_) {
+    for (void* ptr : size_class.second) {
+      allocator_->DeallocateRaw(ptr);
+    }
+  }
+  free_buffers_.clear();
+  idle_bytes_ = 0;
+}
+
+bool PinnedStagingBufferPool::MakeStagingCopy(const Tensor& src,
+                                              Tensor* staged) {
+  const size_t num_bytes = src.TotalBytes();
+  if (num_bytes == 0) return false;
+  size_t rounded_bytes = 0;
+  void* data = Acquire(num_bytes, &rounded_bytes);
+  if (data == nullptr) return false;
+  memcpy(data, DMAHelper::base(&src), num_bytes);
+  auto* buf = new StagingBuffer(this, data, rounded_bytes);
+  *staged = Tensor(src.dtype(), src.shape(), buf);
+  buf->Unref();  // The tensor holds the remaining reference.
+  return true;
+}
+
+void* PinnedStagingBufferPool::Acquire(size_t num_bytes,
+                                       size_t* rounded_bytes) {
+  size_t rounded = kMinBufferBytes;
+  while (rounded < num_bytes) rounded <<= 1;
+  *rounded_bytes = rounded;
+  if (rounded <= kMaxBufferBytes) {
+    mutex_lock l(mu_);
+    auto it = free_buffers_.find(rounded);
+    if (it != free_buffers_.end() && !it->second.empty()) {
+      void* ptr = it->second.back();
+      it->second.pop_back();
+      idle_bytes_ -= rounded;
+      return ptr;
+    }
+  }
+  return allocator_->AllocateRaw(Allocator::kAllocatorAlignment, rounded);
+}
+
+void PinnedStagingBufferPool::Release(void* ptr, size_t rounded_bytes) {
+  if (rounded_bytes <= kMaxBufferBytes) {
+    mutex_lock l(mu_);
+    if (idle_bytes_ + rounded_bytes <= kMaxPoolBytes) {
+      free_buffers_[rounded_bytes].push_back(ptr);
+      idle_bytes_ += rounded_bytes;
+      return;
+    }
+  }
+  allocator_->DeallocateRaw(ptr);
+}
+
+}  // namespace tensorflow
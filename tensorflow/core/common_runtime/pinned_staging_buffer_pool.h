@@ -0,0 +1,95 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_PINNED_STAGING_BUFFER_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_PINNED_STAGING_BUFFER_POOL_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// A pool of reusable staging buffers carved from a GPU-compatible (pinned)
+// host allocator. Host tensors that were not allocated from a pinned
+// allocator (feeds, most notably) force the DMA engine through a
+// pageable-memory slow path that roughly halves host-to-device bandwidth;
+// copying them into a pinned staging buffer first and DMA-ing from there is
+// a net win for all but the smallest tensors.
+//
+// Buffers are grouped into power-of-two size classes and returned to the
+// pool when the staging tensor that owns them is destroyed. The pool retains
+// at most kMaxPoolBytes of idle buffers; beyond that, released buffers are
+// freed back to the allocator. Requests larger than kMaxBufferBytes are
+// allocated and freed directly, without pooling.
+//
+// This class is thread-safe.
+class PinnedStagingBufferPool {
+ public:
+  // Returns the process-wide pool backed by "allocator". Both the pool and
+  // "allocator" must live for the remainder of the process.
+  static PinnedStagingBufferPool* Get(Allocator* allocator);
+
+  // Copies the contents of "src" into a staging tensor backed by a pooled
+  // pinned buffer and assigns it to "*staged". Returns false without
+  // modifying "*staged" if "src" is empty or a buffer could not be obtained
+  // (e.g. the allocator is out of pinned memory), in which case the caller
+  // should fall back to copying from "src" directly.
+  //
+  // REQUIRES: DMAHelper::CanUseDMA(&src)
+  bool MakeStagingCopy(const Tensor& src, Tensor* staged);
+
+ private:
+  friend class PinnedStagingBufferPoolTest;
+
+  static constexpr size_t kMinBufferBytes = 4096;      // 4 KiB
+  static constexpr size_t kMaxBufferBytes = 64 << 20;  // 64 MiB
+
+  // Upper bound on idle (pooled but unused) buffer bytes.
+  static constexpr size_t kMaxPoolBytes = 256 << 20;  // 256 MiB
+
+  class StagingBuffer;
+
+  explicit PinnedStagingBufferPool(Allocator* allocator);
+  ~PinnedStagingBufferPool();
+
+  // Returns a buffer of at least "num_bytes", rounded up to the size class
+  // recorded in "*rounded_bytes", or nullptr on allocation failure.
+  void* Acquire(size_t num_bytes, size_t* rounded_bytes);
+
+  // Returns "ptr" (previously obtained from Acquire, with the rounded size
+  // Acquire reported) to the pool, or frees it if the pool is at capacity.
+  void Release(void* ptr, size_t rounded_bytes);
+
+  Allocator* const allocator_;
+
+  mutex mu_;
+  // Idle buffers, keyed by size class.
+  absl::flat_hash_map<size_t, std::vector<void*>> free_buffers_
+      TF_GUARDED_BY(mu_);
+  size_t idle_bytes_ TF_GUARDED_BY(mu_) = 0;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(PinnedStagingBufferPool);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_PINNED_STAGING_BUFFER_POOL_H_
@@ -0,0 +1,82 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/pinned_staging_buffer_pool.h"
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+
+class PinnedStagingBufferPoolTest : public ::testing::Test {
+ protected:
+  PinnedStagingBufferPoolTest()
+      : pool_(new PinnedStagingBufferPool(cpu_allocator())) {}
+  ~PinnedStagingBufferPoolTest() override { delete pool_; }
+
+  size_t IdleBytes() {
+    mutex_lock l(pool_->mu_);
+    return pool_->idle_bytes_;
+  }
+
+  static Tensor MakeTensor() {
+    Tensor t(DT_FLOAT, TensorShape({64, 64}));
+    for (int64_t i = 0; i < t.NumElements(); ++i) {
+      t.flat<float>()(i) = static_cast<float>(i);
+    }
+    return t;
+  }
+
+  PinnedStagingBufferPool* pool_;
+};
+
+TEST_F(PinnedStagingBufferPoolTest, StagingCopyPreservesContents) {
+  const Tensor src = MakeTensor();
+  Tensor staged;
+  ASSERT_TRUE(pool_->MakeStagingCopy(src, &staged));
+  EXPECT_EQ(src.dtype(), staged.dtype());
+  EXPECT_EQ(src.shape(), staged.shape());
+  EXPECT_NE(src.data(), staged.data());
+  test::ExpectTensorEqual<float>(src, staged);
+}
+
+TEST_F(PinnedStagingBufferPoolTest, ReusesReleasedBuffers) {
+  const Tensor src = MakeTensor();
+  void* first_data = nullptr;
+  {
+    Tensor staged;
+    ASSERT_TRUE(pool_->MakeStagingCopy(src, &staged));
+    first_data = staged.data();
+    EXPECT_EQ(IdleBytes(), 0);
+  }
+  // The buffer went back to the pool and is handed out again for a
+  // same-sized request.
+  EXPECT_GT(IdleBytes(), 0);
+  Tensor staged;
+  ASSERT_TRUE(pool_->MakeStagingCopy(src, &staged));
+  EXPECT_EQ(staged.data(), first_data);
+  EXPECT_EQ(IdleBytes(), 0);
+}
+
+TEST_F(PinnedStagingBufferPoolTest, EmptyTensorIsNotStaged) {
+  Tensor src(DT_FLOAT, TensorShape({0}));
+  Tensor staged;
+  EXPECT_FALSE(pool_->MakeStagingCopy(src, &staged));
+}
+
+}  // namespace tensorflow
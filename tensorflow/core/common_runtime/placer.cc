@@ -15,7 +15,11 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/placer.h"
 
+#include <algorithm>
 #include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/colocation_graph.h"
@@ -28,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/util/dump_graph.h"
 #include "tensorflow/core/util/port.h"
 
@@ -139,6 +144,130 @@ Status AssignAndLog(int assigned_device, Node* node,
   return OkStatus();
 }
 
+// Memoizes placement results across Placer runs.  Loading many structurally
+// identical graphs (e.g. the same model with different weights) re-solves
+// identical placement constraint problems from scratch; this cache keys the
+// fully resolved per-node device assignment on a fingerprint of everything
+// that determines the outcome and replays it on later runs.  Entries record
+// device names rather than Device pointers, so they stay valid across
+// sessions that register equivalent device sets.
+class PlacementCache {
+ public:
+  // Device assignment for every node id in the fingerprinted graph, indexed
+  // by node id.  Ids the placer does not assign (source/sink) stay empty.
+  typedef std::vector<string> Assignments;
+
+  static PlacementCache* Global() {
+    static PlacementCache* cache = new PlacementCache;
+    return cache;
+  }
+
+  std::shared_ptr<const Assignments> Lookup(uint64 fingerprint) {
+    mutex_lock l(mu_);
+    auto it = cache_.find(fingerprint);
+    if (it == cache_.end()) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  void Insert(uint64 fingerprint, std::shared_ptr<const Assignments> value) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) {
+      cache_.clear();
+    }
+    cache_.emplace(fingerprint, std::move(value));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 64;
+
+  mutex mu_;
+  std::unordered_map<uint64, std::shared_ptr<const Assignments>> cache_
+      TF_GUARDED_BY(mu_);
+};
+
+// Computes a fingerprint covering every input that determines the outcome of
+// Placer::Run: per-node identity, attributes, requested and pre-assigned
+// devices, the graph edges, the function library, the available devices and
+// the placement flags.  The placement heuristics are deterministic functions
+// of these inputs, so two graphs with equal fingerprints resolve to the same
+// assignment.
+uint64 PlacementFingerprint(const Graph& graph, const string& function_name,
+                            const FunctionLibraryDefinition* flib_def,
+                            const DeviceSet* devices,
+                            const Device* default_local_device,
+                            bool allow_soft_placement) {
+  uint64 h = Hash64(function_name);
+  h = Hash64Combine(h, allow_soft_placement ? 1 : 0);
+  if (default_local_device != nullptr) {
+    h = Hash64Combine(h, Hash64(default_local_device->name()));
+  }
+
+  std::vector<string> device_names;
+  device_names.reserve(devices->devices().size());
+  for (const Device* device : devices->devices()) {
+    device_names.push_back(device->name());
+  }
+  std::sort(device_names.begin(), device_names.end());
+  for (const string& name : device_names) {
+    h = Hash64Combine(h, Hash64(name));
+  }
+
+  if (flib_def != nullptr) {
+    // Function bodies influence placement of function-calling nodes.
+    std::vector<string> function_names = flib_def->ListFunctionNames();
+    std::sort(function_names.begin(), function_names.end());
+    for (const string& name : function_names) {
+      h = Hash64Combine(h, Hash64(name));
+      const FunctionDef* fdef = flib_def->Find(name);
+      if (fdef != nullptr) {
+        h = Hash64Combine(h, FunctionDefHash(*fdef));
+      }
+    }
+  }
+
+  std::vector<std::pair<const string*, const AttrValue*>> attrs;
+  std::vector<std::tuple<int, int, int>> in_edges;
+  for (const Node* node : graph.nodes()) {
+    h = Hash64Combine(h, node->id());
+    h = Hash64Combine(h, Hash64(node->name()));
+    h = Hash64Combine(h, Hash64(node->type_string()));
+    h = Hash64Combine(h, Hash64(node->requested_device()));
+    if (node->has_assigned_device_name()) {
+      h = Hash64Combine(h, Hash64(node->assigned_device_name()));
+    }
+
+    // Attribute values determine kernel availability and colocation
+    // constraints; hash them in sorted order since map order is undefined.
+    attrs.clear();
+    for (const auto& attr : node->attrs()) {
+      attrs.emplace_back(&attr.first, &attr.second);
+    }
+    std::sort(attrs.begin(), attrs.end(),
+              [](const std::pair<const string*, const AttrValue*>& a,
+                 const std::pair<const string*, const AttrValue*>& b) {
+                return *a.first < *b.first;
+              });
+    for (const auto& attr : attrs) {
+      h = Hash64Combine(h, Hash64(*attr.first));
+      h = Hash64Combine(h, AttrValueHash(*attr.second));
+    }
+
+    in_edges.clear();
+    for (const Edge* e : node->in_edges()) {
+      in_edges.emplace_back(e->src()->id(), e->src_output(), e->dst_input());
+    }
+    std::sort(in_edges.begin(), in_edges.end());
+    for (const auto& e : in_edges) {
+      h = Hash64Combine(
+          h, Hash64Combine(std::get<0>(e),
+                           Hash64Combine(std::get<1>(e), std::get<2>(e))));
+    }
+  }
+  return h;
+}
+
 }  // namespace
 
 Placer::Placer(Graph* graph, const string& function_name,
@@ -181,6 +310,29 @@ Status Placer::Run() {
     }
   }
 
+  const uint64 placement_fingerprint =
+      PlacementFingerprint(*graph_, function_name_, flib_def_, devices_,
+                           default_local_device_, allow_soft_placement_);
+  std::shared_ptr<const PlacementCache::Assignments> cached =
+      PlacementCache::Global()->Lookup(placement_fingerprint);
+  if (cached != nullptr &&
+      cached->size() == static_cast<size_t>(graph_->num_node_ids())) {
+    // A structurally identical graph was placed before; replay its
+    // assignment instead of re-solving the constraint problem.  The
+    // fingerprint guarantees the same problem was solved successfully, so
+    // the colocation checks do not have to be repeated.
+    for (Node* node : graph_->op_nodes()) {
+      if (!node->has_assigned_device_name()) {
+        node->set_assigned_device_name((*cached)[node->id()]);
+      }
+      LogDeviceAssignment(node, log_device_placement_);
+    }
+    if (VLOG_IS_ON(3)) {
+      DumpGraphToFile("placer_output", *graph_, nullptr);
+    }
+    return OkStatus();
+  }
+
   FunctionStack stack(function_name_);
   ColocationGraph colocation_graph(graph_, stack, flib_def_, devices_,
                                    default_local_device_, allow_soft_placement_,
@@ -299,6 +451,14 @@ Status Placer::Run() {
                                     log_device_placement_));
   }
 
+  auto assignments = std::make_shared<PlacementCache::Assignments>(
+      graph_->num_node_ids());
+  for (const Node* node : graph_->op_nodes()) {
+    (*assignments)[node->id()] = node->assigned_device_name();
+  }
+  PlacementCache::Global()->Insert(placement_fingerprint,
+                                   std::move(assignments));
+
   if (VLOG_IS_ON(3)) {
     DumpGraphToFile("placer_output", *graph_, nullptr);
     DumpColocationGraph("colocation_graph", colocation_graph);
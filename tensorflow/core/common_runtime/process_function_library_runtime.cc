@@ -1121,6 +1121,14 @@ Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
         counter.DecrementCount();
         return;
       }
+      comp_data->arg_indices_are_identity = true;
+      for (int idx = 0; idx < comp_data->arg_indices.size(); ++idx) {
+        const FunctionArgIndex& arg_index = comp_data->arg_indices[idx];
+        if (arg_index.index != idx || arg_index.sub_index >= 0) {
+          comp_data->arg_indices_are_identity = false;
+          break;
+        }
+      }
       FunctionDef shard;
       status->Update(
           GraphToFunctionDef(*subgraph, unique_name, control_ret, &shard));
@@ -1706,6 +1714,15 @@ Status ProcessFunctionLibraryRuntime::GetComponentArgs(
     const gtl::ArraySlice<Tensor> args,
     const ProcessFunctionLibraryRuntime::ComponentFunctionData& comp_data,
     ProcessFunctionLibraryRuntime::InternalArgs* comp_args) {
+  // Fast path: the component consumes the caller's arguments verbatim, so the
+  // per-slot gather below reduces to one bulk copy of the argument span.
+  if (comp_data.arg_indices_are_identity &&
+      comp_data.arg_indices.size() <= args.size()) {
+    comp_args->args.assign(args.begin(),
+                           args.begin() + comp_data.arg_indices.size());
+    return OkStatus();
+  }
+  comp_args->args.reserve(comp_data.arg_indices.size());
   // "Index"s of _Arg nodes are unique when all arguments are local Tensors.
   for (const auto& it : comp_data.arg_indices) {
     if (it.index >= args.size()) {
@@ -1738,6 +1755,7 @@ Status ProcessFunctionLibraryRuntime::GetComponentArgs(
     const FunctionArgsInterface& args,
     const ProcessFunctionLibraryRuntime::ComponentFunctionData& comp_data,
     ProcessFunctionLibraryRuntime::InternalArgs* comp_args) {
+  comp_args->args.reserve(comp_data.arg_indices.size());
   for (int i = 0; i < comp_data.arg_indices.size(); ++i) {
     const FunctionArgIndex index = comp_data.arg_indices.at(i);
     Tensor tensor;
@@ -1793,6 +1811,7 @@ void ProcessFunctionLibraryRuntime::Run(
                                std::move(done), std::move(get_component_args));
   }
   std::vector<FunctionArg> local_args;
+  local_args.reserve(args.size());
   for (const auto& tensor : args) {
     local_args.push_back(tensor);
   }
@@ -281,6 +281,11 @@ class ProcessFunctionLibraryRuntime {
     // function.  The i-th return value of the component function goes to the
     // `ret_indices[i]`-th return value of the multi-device function.
     std::vector<int> ret_indices;
+    // True iff arg_indices is the identity mapping {0, ..., n-1} with no
+    // resource sub-indices, i.e. the component consumes the multi-device
+    // function's arguments verbatim. Precomputed at instantiation so per-call
+    // argument marshalling can copy the argument span wholesale.
+    bool arg_indices_are_identity = false;
     // arg_alloc_attrs[i] are the allocator attributes of the i-th argument to
     // the component function.
     std::vector<AllocatorAttributes> arg_alloc_attrs;
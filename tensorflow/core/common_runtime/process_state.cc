@@ -21,6 +21,7 @@ limitations under the License.
 
 #include "absl/base/call_once.h"
 #include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/common_runtime/numa_bfc_allocator.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/log_memory.h"
@@ -28,10 +29,50 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
+namespace {
+
+// Adapts an Allocator to the SubAllocator interface so that a PoolAllocator
+// can be layered in front of it. Owns the underlying allocator unless told
+// otherwise (the process-wide default CPU allocator is static and must not
+// be deleted).
+class AllocatorBackedSubAllocator : public SubAllocator {
+ public:
+  AllocatorBackedSubAllocator(Allocator* underlying, bool owns_underlying)
+      : SubAllocator({}, {}),
+        underlying_(underlying),
+        owns_underlying_(owns_underlying) {}
+
+  ~AllocatorBackedSubAllocator() override {
+    if (owns_underlying_) delete underlying_;
+  }
+
+  void* Alloc(size_t alignment, size_t num_bytes,
+              size_t* bytes_received) override {
+    *bytes_received = num_bytes;
+    return underlying_->AllocateRaw(alignment, num_bytes);
+  }
+
+  void Free(void* ptr, size_t num_bytes) override {
+    underlying_->DeallocateRaw(ptr);
+  }
+
+  bool SupportsCoalescing() const override { return false; }
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return underlying_->GetMemoryType();
+  }
+
+ private:
+  Allocator* const underlying_;
+  const bool owns_underlying_;
+};
+
+}  // namespace
 
 /*static*/ ProcessState* ProcessState::singleton() {
   static ProcessState* instance = new ProcessState;
@@ -82,6 +123,17 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
     if (!status.ok()) {
       LOG(ERROR) << "GetCPUAllocator: " << status.error_message();
     }
+    // On multi-socket machines the BFC pool can optionally be partitioned
+    // into per-NUMA-node sub-pools so threads allocate node-local memory and
+    // stop serializing on one allocator mutex.
+    bool numa_partitioned = false;
+    status = ReadBoolFromEnvVar("TF_CPU_BFC_NUMA_PARTITIONED",
+                                /*default_val=*/false, &numa_partitioned);
+    if (!status.ok()) {
+      LOG(ERROR) << "GetCPUAllocator: " << status.error_message();
+    }
+    numa_partitioned =
+        numa_partitioned && numa_enabled_ && port::NUMANumNodes() > 1;
     Allocator* allocator = nullptr;
     SubAllocator* sub_allocator =
         (numa_enabled_ || alloc_visitors_defined || use_bfc_allocator)
@@ -103,12 +155,24 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
 
       BFCAllocator::Options allocator_opts;
       allocator_opts.allow_growth = true;
-      allocator = new BFCAllocator(
-          absl::WrapUnique(sub_allocator), cpu_mem_limit,
-          /*name=*/"bfc_cpu_allocator_for_gpu", allocator_opts);
 
-      VLOG(2) << "Using BFCAllocator with memory limit of "
-              << cpu_mem_limit_in_mb << " MB for ProcessState CPU allocator";
+      if (numa_partitioned) {
+        // NumaBFCAllocator builds one node-pinned sub-allocator per NUMA
+        // node internally.
+        delete sub_allocator;
+        sub_allocator = nullptr;
+        allocator = new NumaBFCAllocator(
+            cpu_mem_limit, /*name=*/"numa_bfc_cpu_allocator_for_gpu",
+            allocator_opts, cpu_alloc_visitors_, cpu_free_visitors_);
+        VLOG(2) << "Using NUMA-partitioned BFCAllocator with memory limit of "
+                << cpu_mem_limit_in_mb << " MB for ProcessState CPU allocator";
+      } else {
+        allocator = new BFCAllocator(
+            absl::WrapUnique(sub_allocator), cpu_mem_limit,
+            /*name=*/"bfc_cpu_allocator_for_gpu", allocator_opts);
+        VLOG(2) << "Using BFCAllocator with memory limit of "
+                << cpu_mem_limit_in_mb << " MB for ProcessState CPU allocator";
+      }
     } else if (sub_allocator) {
       DCHECK(sub_allocator);
       allocator =
@@ -121,6 +185,28 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
       DCHECK(!sub_allocator);
       allocator = cpu_allocator_base();
     }
+    // Fixed-shape training loops request the same buffer sizes every step, so
+    // an exact-size LRU pool in front of the chosen allocator turns most
+    // steady-state allocations into a hash lookup, bypassing bin search (BFC)
+    // or malloc. Off by default; the limit caps how many freed buffers are
+    // retained, so it should be at least the number of distinct intermediate
+    // buffers live in one step.
+    int64_t tensor_pool_size_limit = 0;
+    status = ReadInt64FromEnvVar("TF_CPU_TENSOR_POOL_SIZE_LIMIT",
+                                 /*default_val=*/0, &tensor_pool_size_limit);
+    if (!status.ok()) {
+      LOG(ERROR) << "GetCPUAllocator: " << status.error_message();
+    }
+    if (tensor_pool_size_limit > 0) {
+      const bool owns_underlying = allocator != cpu_allocator_base();
+      allocator = new PoolAllocator(
+          /*pool_size_limit=*/tensor_pool_size_limit, /*auto_resize=*/false,
+          new AllocatorBackedSubAllocator(allocator, owns_underlying),
+          new NoopRounder, "cpu_tensor_pool");
+      VLOG(2) << "Layering exact-size PoolAllocator of limit "
+              << tensor_pool_size_limit
+              << " in front of ProcessState CPU allocator";
+    }
     if (LogMemory::IsEnabled() && !allocator->TracksAllocationSizes()) {
       // Wrap the allocator to track allocation ids for better logging
       // at the cost of performance.
@@ -132,7 +218,8 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
       cpu_allocators_cached_.fetch_add(1, std::memory_order_release);
     }
     if (!sub_allocator) {
-      DCHECK(cpu_alloc_visitors_.empty() && cpu_free_visitors_.empty());
+      DCHECK(numa_partitioned ||
+             (cpu_alloc_visitors_.empty() && cpu_free_visitors_.empty()));
     }
   }
   return cpu_allocators_[numa_node];
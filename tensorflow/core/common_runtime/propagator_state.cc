@@ -426,7 +426,7 @@ int PropagatorState::FrameState::ActivateNodesFastPathInternal(
 #define MAYBE_ADD_TO_READY(dst_id, adjust_result)         \
   do {                                                    \
     if (!(adjust_result.pending_count > 0)) {             \
-      const NodeItem* dst_item = &gview.node_ref(dst_id); \
+      const NodeItem* dst_item = gview.hot(dst_id).item;  \
       TaggedNode& t = ready->emplace_back();              \
       t.node_item = dst_item;                             \
       t.input_frame = this;                               \
@@ -479,16 +479,16 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
     const NodeItem* item, const bool is_dead, IterationState* iter_state,
     EntryVector* outputs, TaggedNodeSeq* ready) {
   // If any of the edge destinations is a merge or a control trigger node,
-  // we need to read each destination NodeItem to determine what action
+  // we need to read each destination's hot fields to determine what action
   // to take.
   const GraphView& gview = immutable_state.graph_view();
   int activated = 0;
-  auto maybe_add_to_ready = [&](int dst_id, const NodeItem* dst_item,
+  auto maybe_add_to_ready = [&](int dst_id, const NodeItemHot& dst_hot,
                                 bool dst_ready, bool dst_dead) {
     // Add dst to the ready queue if it's ready
     if (dst_ready) {
-      if (dst_item->is_control_trigger) dst_dead = false;
-      ready->emplace_back(dst_item, this, iter_state, dst_dead);
+      if (dst_hot.is_control_trigger) dst_dead = false;
+      ready->emplace_back(dst_hot.item, this, iter_state, dst_dead);
       activated++;
     }
   };
@@ -497,7 +497,7 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
 
   for (const EdgeInfo& e : item->output_edges()) {
     const int dst_id = e.dst_id;
-    const NodeItem* dst_item = &gview.node_ref(dst_id);
+    const NodeItemHot& dst_hot = gview.hot(dst_id);
     const PendingCounts::Handle dst_pending_id =
         immutable_state.pending_ids()[dst_id];
     const int src_slot = e.output_slot;
@@ -505,7 +505,7 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
     bool dst_dead = false;
     bool dst_ready = false;
 
-    if (dst_item->is_merge) {
+    if (dst_hot.is_merge) {
       // A merge node is ready if all control inputs have arrived and either
       // a) a live data input becomes available or b) all data inputs are
       // dead. For Merge, pending's LSB is set iff a live data input has
@@ -546,7 +546,7 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
             atomic
                 ? iter_state->adjust_for_increment_dead_atomic(dst_pending_id)
                 : iter_state->adjust_for_increment_dead(dst_pending_id);
-        dst_dead = (adjust_result.dead_count == dst_item->num_inputs) ||
+        dst_dead = (adjust_result.dead_count == dst_hot.num_inputs) ||
                    item->is_enter;
         dst_ready = (adjust_result.pending_count == 1) && dst_dead;
       }
@@ -574,18 +574,18 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
       dst_ready = !(adjust_result.pending_count > 0);
     }
 
-    maybe_add_to_ready(dst_id, dst_item, dst_ready, dst_dead);
+    maybe_add_to_ready(dst_id, dst_hot, dst_ready, dst_dead);
   }
 
   for (const ControlEdgeInfo& e : item->output_control_edges()) {
     const int dst_id = e.dst_id;
-    const NodeItem* dst_item = &gview.node_ref(dst_id);
+    const NodeItemHot& dst_hot = gview.hot(dst_id);
     const PendingCounts::Handle dst_pending_id =
         immutable_state.pending_ids()[dst_id];
 
     bool dst_dead;
     bool dst_ready;
-    if (dst_item->is_merge) {
+    if (dst_hot.is_merge) {
       // A merge node is ready if all control inputs have arrived and either
       // a) a live data input becomes available or b) all data inputs are
       // dead. For Merge, pending's LSB is set iff a live data input has
@@ -596,7 +596,7 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
                  : iter_state->adjust_for_decrement_pending(
                        dst_pending_id,
                        /*decrement_pending=*/2);
-      dst_dead = (adjust_result.dead_count == dst_item->num_inputs);
+      dst_dead = (adjust_result.dead_count == dst_hot.num_inputs);
       dst_ready = (adjust_result.pending_count == 0) ||
                   ((adjust_result.pending_count == 1) && dst_dead);
     } else {
@@ -608,7 +608,7 @@ int PropagatorState::FrameState::ActivateNodesSlowPathInternal(
       dst_dead = adjust_result.dead_count > 0;
       dst_ready = adjust_result.pending_count == 0;
     }
-    maybe_add_to_ready(dst_id, dst_item, dst_ready, dst_dead);
+    maybe_add_to_ready(dst_id, dst_hot, dst_ready, dst_dead);
   }
 
   return activated;
@@ -39,11 +39,25 @@ class RequestCost {
   // rpc request, when all the costs have been collected.
   absl::flat_hash_map<std::string, absl::Duration> GetCosts() const;
 
+  // Records non-duration metrics (e.g. batch sizes or memory consumption).
+  // The inputs should be pairs of metric name and value. Unlike costs,
+  // recording a metric overwrites any previously recorded value of the same
+  // name. It's thread-safe, and can be called from different threads.
+  void RecordMetrics(
+      const std::vector<std::pair<absl::string_view, double>>& metrics);
+
+  // Gets all metrics for processing an rpc request.
+  // It's thread-safe. It's expected to be called at the end of processing an
+  // rpc request, when all the metrics have been collected.
+  absl::flat_hash_map<std::string, double> GetMetrics() const;
+
  private:
   mutable absl::Mutex mutex_;
   // Map from cost type to cost.
   absl::flat_hash_map<std::string, absl::Duration> cost_map_
       ABSL_GUARDED_BY(mutex_);
+  // Map from metric name to value.
+  absl::flat_hash_map<std::string, double> metric_map_ ABSL_GUARDED_BY(mutex_);
 };
 
 }  // namespace tensorflow
@@ -48,5 +48,21 @@ TEST(RequestCostTest, Basic) {
                                    Pair("cpu_v2", absl::Milliseconds(44))));
 }
 
+TEST(RequestCostTest, RecordMetrics) {
+  RequestCost request_cost;
+
+  request_cost.RecordMetrics({{"processed_size", 8}, {"input_size", 3}});
+  EXPECT_THAT(
+      request_cost.GetMetrics(),
+      UnorderedElementsAre(Pair("processed_size", 8), Pair("input_size", 3)));
+
+  // Unlike costs, recording a metric again overwrites its previous value.
+  request_cost.RecordMetrics({{"input_size", 5}, {"padding_size", 2}});
+  EXPECT_THAT(request_cost.GetMetrics(),
+              UnorderedElementsAre(Pair("processed_size", 8),
+                                   Pair("input_size", 5),
+                                   Pair("padding_size", 2)));
+}
+
 }  // namespace
 }  // namespace tensorflow
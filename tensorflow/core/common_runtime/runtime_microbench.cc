@@ -0,0 +1,196 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Consolidated microbenchmarks for the runtime primitives the executor is
+// built on: node dispatch, rendezvous send/recv, BFC allocation under
+// contention and inter-op thread pool wakeup.  Kept in one binary so a single
+// run characterizes the runtime; for regression tracking run with
+//
+//   runtime_microbench --benchmark_format=json
+//
+// and diff the per-benchmark real_time/items_per_second fields.
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/bfc_allocator.h"
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/framework/control_flow.h"
+#include "tensorflow/core/framework/rendezvous.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/numa.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+
+namespace tensorflow {
+namespace {
+
+// Executor dispatch latency as a function of graph width: `width` independent
+// NoOps joined by one sink NoOp, so the propagation loop activates `width`
+// nodes from one completion and the ready queue sees maximum parallelism.
+void BM_ExecutorDispatchWidth(::testing::benchmark::State& state) {
+  const int width = state.range(0);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  std::vector<Node*> level;
+  level.reserve(width);
+  for (int i = 0; i < width; ++i) {
+    level.push_back(test::graph::NoOp(g, {}));
+  }
+  test::graph::NoOp(g, level);
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+
+  state.SetLabel(strings::StrCat("Width = ", width));
+  state.SetItemsProcessed(static_cast<int64_t>(width + 1) *
+                          state.iterations());
+}
+
+BENCHMARK(BM_ExecutorDispatchWidth)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
+
+Rendezvous::ParsedKey MakeKey(const string& name) {
+  const string device = "/job:localhost/replica:0/task:0/device:CPU:0";
+  Rendezvous::ParsedKey key;
+  TF_CHECK_OK(Rendezvous::ParseKey(
+      Rendezvous::CreateKey(device, /*src_incarnation=*/1, device, name,
+                            FrameAndIter(0, 0)),
+      &key));
+  return key;
+}
+
+// Same-thread rendezvous throughput: `tensors` sends followed by `tensors`
+// recvs per iteration, the pattern the executor's partitions produce when
+// producer and consumer land on the same inter-op thread.
+void BM_RendezvousSendRecv(::testing::benchmark::State& state) {
+  const int tensors = state.range(0);
+  Rendezvous* rendez = NewLocalRendezvous();
+  std::vector<Rendezvous::ParsedKey> keys;
+  keys.reserve(tensors);
+  for (int i = 0; i < tensors; ++i) {
+    keys.push_back(MakeKey(strings::StrCat("t", i)));
+  }
+  const Tensor val = test::AsScalar<float>(1.0);
+  Rendezvous::Args args;
+
+  for (auto s : state) {
+    for (int i = 0; i < tensors; ++i) {
+      TF_CHECK_OK(rendez->Send(keys[i], args, val, /*is_dead=*/false));
+    }
+    for (int i = 0; i < tensors; ++i) {
+      Tensor out;
+      bool is_dead = false;
+      TF_CHECK_OK(rendez->Recv(keys[i], args, &out, &is_dead));
+    }
+  }
+  rendez->Unref();
+
+  state.SetItemsProcessed(static_cast<int64_t>(tensors) * state.iterations());
+}
+
+BENCHMARK(BM_RendezvousSendRecv)->UseRealTime()->Arg(1)->Arg(16)->Arg(256);
+
+// Cross-thread rendezvous handoff: each iteration schedules the send on
+// another thread and blocks in Recv, measuring the full producer-to-consumer
+// path including the consumer wakeup.
+void BM_RendezvousCrossThread(::testing::benchmark::State& state) {
+  Rendezvous* rendez = NewLocalRendezvous();
+  const Rendezvous::ParsedKey key = MakeKey("t0");
+  const Tensor val = test::AsScalar<float>(1.0);
+  Rendezvous::Args args;
+  thread::ThreadPool pool(Env::Default(), "sender", 1);
+
+  for (auto s : state) {
+    pool.Schedule([rendez, &key, &args, &val]() {
+      TF_CHECK_OK(rendez->Send(key, args, val, /*is_dead=*/false));
+    });
+    Tensor out;
+    bool is_dead = false;
+    TF_CHECK_OK(rendez->Recv(key, args, &out, &is_dead));
+  }
+  rendez->Unref();
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_RendezvousCrossThread)->UseRealTime();
+
+// BFC allocation/deallocation throughput.  The allocator is shared by all
+// benchmark threads, so the multi-threaded variants measure contention on
+// the allocator's central lock, which is what kernels on the inter-op pool
+// see on allocation-heavy graphs.
+void BM_BFCAllocation(::testing::benchmark::State& state) {
+  static BFCAllocator* allocator = []() {
+    BFCAllocator::Options opts;
+    return new BFCAllocator(
+        std::make_unique<BasicCPUAllocator>(
+            port::kNUMANoAffinity, std::vector<SubAllocator::Visitor>(),
+            std::vector<SubAllocator::Visitor>()),
+        /*total_memory=*/1LL << 30, "bfc_microbench", opts);
+  }();
+  // Cycle through the size classes a typical inference graph mixes:
+  // small metadata, activations, and a large buffer.
+  constexpr size_t kSizes[] = {64, 256, 4096, 1 << 16, 1 << 20};
+  constexpr int kNumSizes = sizeof(kSizes) / sizeof(kSizes[0]);
+
+  int i = 0;
+  for (auto s : state) {
+    void* ptr = allocator->AllocateRaw(64, kSizes[i % kNumSizes]);
+    CHECK(ptr != nullptr);
+    allocator->DeallocateRaw(ptr);
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BFCAllocation)
+    ->UseRealTime()
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16);
+
+// Inter-op pool wakeup latency: schedule an empty closure and wait for it,
+// measuring the round trip from Schedule() to the closure running on an idle
+// pool of `threads` workers.
+void BM_InterOpPoolWakeup(::testing::benchmark::State& state) {
+  const int threads = state.range(0);
+  thread::ThreadPool pool(Env::Default(), "wakeup", threads);
+
+  for (auto s : state) {
+    Notification done;
+    pool.Schedule([&done]() { done.Notify(); });
+    done.WaitForNotification();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_InterOpPoolWakeup)->UseRealTime()->Arg(1)->Arg(4)->Arg(16);
+
+}  // namespace
+}  // namespace tensorflow
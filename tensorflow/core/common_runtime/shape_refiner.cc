@@ -14,14 +14,17 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/shape_refiner.h"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/eval_const_tensor.h"
 #include "tensorflow/core/common_runtime/function_utils.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/node_def.pb.h"
@@ -31,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/hash.h"
 
 namespace tensorflow {
 
@@ -261,8 +265,59 @@ Status ShapeRefiner::AddNodeInternal(
   std::unique_ptr<ExtendedInferenceContext> ec(
       new ExtendedInferenceContext(std::move(ic), node));
 
-  // Run the shape inference function, and return if there was an error.
-  TF_RETURN_IF_ERROR(RunShapeFn(node, op_reg_data, ec.get(), outer_context));
+  // Replicated subgraphs run the same shape function on the same input shapes
+  // over and over; if an identically-fingerprinted instance has already been
+  // inferred, copy its output shapes instead of re-running the function.
+  uint64 fingerprint = 0;
+  const bool cache_eligible =
+      op_reg_data->shape_inference_fn != nullptr &&
+      !(function_library_ && IsFunctionCall(*function_library_, *node)) &&
+      TryComputeShapeFingerprint(node, ec->get_context(), &fingerprint);
+  bool found_in_cache = false;
+  if (cache_eligible) {
+    auto iter = shape_cache_.find(fingerprint);
+    if (iter != shape_cache_.end()) {
+      InferenceContext* c = ec->get_context();
+      if (iter->second.size() == static_cast<size_t>(c->num_outputs())) {
+        for (int i = 0; i < c->num_outputs(); ++i) {
+          ShapeHandle shape;
+          TF_RETURN_IF_ERROR(
+              c->MakeShapeFromShapeProto(iter->second[i], &shape));
+          c->set_output(i, shape);
+        }
+        found_in_cache = true;
+      }
+    }
+  }
+
+  if (!found_in_cache) {
+    // Run the shape inference function, and return if there was an error.
+    TF_RETURN_IF_ERROR(RunShapeFn(node, op_reg_data, ec.get(), outer_context));
+
+    // Memoize the result, unless the shape function consumed input values
+    // (requested input tensors) or produced handle data, neither of which the
+    // fingerprint captures.
+    InferenceContext* c = ec->get_context();
+    bool cacheable = cache_eligible;
+    for (int i = 0; cacheable && i < c->num_inputs(); ++i) {
+      if (c->requested_input_tensor(i) ||
+          c->requested_input_tensor_as_partial_shape(i)) {
+        cacheable = false;
+      }
+    }
+    for (int i = 0; cacheable && i < c->num_outputs(); ++i) {
+      if (c->output_handle_shapes_and_types(i) != nullptr) {
+        cacheable = false;
+      }
+    }
+    if (cacheable) {
+      std::vector<TensorShapeProto> output_shapes(c->num_outputs());
+      for (int i = 0; i < c->num_outputs(); ++i) {
+        c->ShapeHandleToProto(c->output(i), &output_shapes[i]);
+      }
+      shape_cache_.emplace(fingerprint, std::move(output_shapes));
+    }
+  }
 
   // Store the resulting context object in the map.
   node_to_context_[node].swap(ec);
@@ -785,6 +840,37 @@ Status ShapeRefiner::RunShapeFn(const Node* node,
   return OkStatus();
 }
 
+bool ShapeRefiner::TryComputeShapeFingerprint(const Node* node,
+                                              InferenceContext* ic,
+                                              uint64* fingerprint) {
+  uint64 fp = Hash64(node->type_string());
+
+  // Attributes, visited in a deterministic order.
+  std::vector<std::pair<StringPiece, const AttrValue*>> attrs;
+  for (const auto& attr : node->attrs()) {
+    attrs.emplace_back(attr.first, &attr.second);
+  }
+  std::sort(attrs.begin(), attrs.end());
+  for (const auto& attr : attrs) {
+    fp = Hash64Combine(fp, Hash64(attr.first.data(), attr.first.size()));
+    fp = Hash64Combine(fp, AttrValueHash(*attr.second));
+  }
+
+  for (int i = 0; i < ic->num_inputs(); ++i) {
+    if (ic->input_handle_shapes_and_types(i) != nullptr) {
+      // Resource and variant inputs carry handle data the fingerprint does
+      // not capture.
+      return false;
+    }
+    TensorShapeProto shape_proto;
+    ic->ShapeHandleToProto(ic->input(i), &shape_proto);
+    fp = Hash64Combine(fp, Hash64(shape_proto.SerializeAsString()));
+  }
+
+  *fingerprint = fp;
+  return true;
+}
+
 bool ShapeRefiner::SameDefinedShape(InferenceContext* c, ShapeHandle s0,
                                     ShapeHandle s1) {
   if (s0.SameHandle(s1)) {
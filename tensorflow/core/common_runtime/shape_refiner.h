@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/graph_runner.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/macros.h"
@@ -290,6 +291,14 @@ class ShapeRefiner {
                     ExtendedInferenceContext* ec,
                     shape_inference::InferenceContext* outer_context = nullptr);
 
+  // Computes a fingerprint of 'node''s op, attributes and the input shapes
+  // already stored in 'ic', used to key the shape-function memoization cache.
+  // Returns false if the node's inference result may depend on more than
+  // those (inputs carrying handle data), in which case the cache is bypassed.
+  bool TryComputeShapeFingerprint(const Node* node,
+                                  shape_inference::InferenceContext* ic,
+                                  uint64* fingerprint);
+
   int32 graph_def_version_;
   const OpRegistryInterface* const ops_registry_;
 
@@ -326,6 +335,14 @@ class ShapeRefiner {
                       hash<const FunctionDef*>>
       functions_;
 
+  // Memoized shape function results, keyed by a fingerprint of (op, attrs,
+  // input shapes). Graphs stamped out from identical layers run identical
+  // shape functions thousands of times; replicas after the first copy their
+  // output shapes from this cache. Nodes whose results may depend on more
+  // than the fingerprint captures (function calls, value-dependent shape
+  // functions, handle data) are never cached.
+  absl::flat_hash_map<uint64, std::vector<TensorShapeProto>> shape_cache_;
+
   TF_DISALLOW_COPY_AND_ASSIGN(ShapeRefiner);
 };
 
@@ -61,6 +61,11 @@ class ShapeRefinerTest : public ::testing::Test {
 
   static constexpr int64_t kMaxTensorSize = ShapeRefiner::kMaxTensorSize;
 
+  // Gives access to the private shape function memoization cache.
+  size_t NumShapeCacheEntries(const ShapeRefiner& m) {
+    return m.shape_cache_.size();
+  }
+
   void TestStridedSlice(const PartialTensorShape& input_shape, int begin,
                         int end, int stride, const char* expected,
                         int begin_mask = 0, int end_mask = 0,
@@ -151,6 +156,29 @@ TEST_F(ShapeRefinerTest, MatMul) {
   EXPECT_SHAPE("[2,2]", m, mm, 0);
 }
 
+TEST_F(ShapeRefinerTest, MemoizesIdenticalShapeFunctions) {
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, OpRegistry::Global());
+
+  Scope root = Scope::NewRootScope();
+  auto a = ops::Const(root, {{1.0f}, {2.0f}});
+  auto b = ops::Const(root, {{1.0f, 2.0f}});
+  auto mm1 = ops::MatMul(root, a, b);
+  auto mm2 = ops::MatMul(root, a, b);
+
+  TF_ASSERT_OK(m.AddNode(a.node()));
+  TF_ASSERT_OK(m.AddNode(b.node()));
+  TF_ASSERT_OK(m.AddNode(mm1.node()));
+  const size_t entries_after_first = NumShapeCacheEntries(m);
+
+  // The second MatMul has the same op, attrs and input shapes as the first,
+  // so its result comes from the cache instead of adding a new entry.
+  TF_ASSERT_OK(m.AddNode(mm2.node()));
+  EXPECT_EQ(NumShapeCacheEntries(m), entries_after_first);
+
+  EXPECT_SHAPE("[2,2]", m, mm1, 0);
+  EXPECT_SHAPE("[2,2]", m, mm2, 0);
+}
+
 TEST_F(ShapeRefinerTest, BadShapes) {
   ShapeRefiner m(TF_GRAPH_DEF_VERSION, OpRegistry::Global());
   Scope root = Scope::NewRootScope();
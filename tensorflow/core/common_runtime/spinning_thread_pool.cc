@@ -0,0 +1,137 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/spinning_thread_pool.h"
+
+#include <thread>
+#include <utility>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env_time.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Identifies the calling thread's pool and worker slot. A thread belongs to
+// at most one SpinningThreadPool for its entire lifetime.
+thread_local SpinningThreadPool* current_pool = nullptr;
+thread_local int current_worker_id = -1;
+
+}  // namespace
+
+SpinningThreadPool::SpinningThreadPool(Env* env,
+                                       const ThreadOptions& thread_options,
+                                       const string& name, int num_threads,
+                                       int64_t spin_duration_us)
+    : num_threads_(num_threads), spin_duration_us_(spin_duration_us) {
+  CHECK_GE(num_threads_, 1);
+  CHECK_GE(spin_duration_us_, 0);
+  threads_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    threads_.emplace_back(env->StartThread(
+        thread_options, strings::StrCat(name, "_", i),
+        [this, i]() { WorkerLoop(i); }));
+  }
+}
+
+SpinningThreadPool::~SpinningThreadPool() {
+  {
+    mutex_lock l(park_mu_);
+    cancelled_ = true;
+    park_cv_.notify_all();
+  }
+  // Joins the workers. Each worker drains the queue before observing the
+  // cancellation, so tasks scheduled before destruction still run.
+  threads_.clear();
+}
+
+void SpinningThreadPool::Schedule(std::function<void()> fn) {
+  DCHECK(fn != nullptr);
+  {
+    mutex_lock l(queue_mu_);
+    queue_.push_back(std::move(fn));
+  }
+  // The increment must be sequenced before the `num_parked_` read: a parking
+  // worker increments `num_parked_` and then re-checks `queue_size_`, so with
+  // both operations sequentially consistent at least one side observes the
+  // other and the wakeup cannot be lost.
+  queue_size_.fetch_add(1);
+  if (num_parked_.load() > 0) {
+    mutex_lock l(park_mu_);
+    park_cv_.notify_one();
+  }
+}
+
+int SpinningThreadPool::CurrentThreadId() const {
+  return current_pool == this ? current_worker_id : -1;
+}
+
+bool SpinningThreadPool::PopTask(std::function<void()>* task) {
+  if (queue_size_.load(std::memory_order_relaxed) == 0) return false;
+  mutex_lock l(queue_mu_);
+  if (queue_.empty()) return false;
+  *task = std::move(queue_.front());
+  queue_.pop_front();
+  queue_size_.fetch_sub(1);
+  return true;
+}
+
+void SpinningThreadPool::WorkerLoop(int worker_id) {
+  current_pool = this;
+  current_worker_id = worker_id;
+  std::function<void()> task;
+  while (true) {
+    if (PopTask(&task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    // Busy-poll for up to `spin_duration_us_` before parking; a task that
+    // arrives inside the window is picked up without a futex wakeup.
+    const uint64 spin_deadline = EnvTime::NowMicros() + spin_duration_us_;
+    bool found = false;
+    while (EnvTime::NowMicros() < spin_deadline) {
+      if (queue_size_.load(std::memory_order_relaxed) > 0 && PopTask(&task)) {
+        found = true;
+        break;
+      }
+      std::this_thread::yield();
+    }
+    if (found) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    {
+      mutex_lock l(park_mu_);
+      num_parked_.fetch_add(1);
+      // Re-check the queue after advertising as parked (see Schedule).
+      if (queue_size_.load() == 0) {
+        if (cancelled_) {
+          num_parked_.fetch_sub(1);
+          return;
+        }
+        park_cv_.wait(l);
+      }
+      num_parked_.fetch_sub(1);
+      // On cancellation keep looping until the queue is drained; the next
+      // park attempt exits once it finds the queue empty.
+    }
+  }
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,86 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/spinning_thread_pool.h"
+
+#include <atomic>
+
+#include "tensorflow/core/lib/core/blocking_counter.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(SpinningThreadPool, RunsAllScheduledTasks) {
+  SpinningThreadPool pool(Env::Default(), ThreadOptions(), "spin_test", 4,
+                          /*spin_duration_us=*/100);
+  constexpr int kNumTasks = 1000;
+  std::atomic<int> count(0);
+  BlockingCounter done(kNumTasks);
+  for (int i = 0; i < kNumTasks; ++i) {
+    pool.Schedule([&count, &done]() {
+      count.fetch_add(1);
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  EXPECT_EQ(kNumTasks, count.load());
+}
+
+TEST(SpinningThreadPool, WakesParkedWorkers) {
+  // A spin window of zero forces every idle worker to park immediately, so
+  // each burst below exercises the park/notify handshake.
+  SpinningThreadPool pool(Env::Default(), ThreadOptions(), "spin_test", 2,
+                          /*spin_duration_us=*/0);
+  for (int burst = 0; burst < 100; ++burst) {
+    Env::Default()->SleepForMicroseconds(100);
+    BlockingCounter done(4);
+    for (int i = 0; i < 4; ++i) {
+      pool.Schedule([&done]() { done.DecrementCount(); });
+    }
+    done.Wait();
+  }
+}
+
+TEST(SpinningThreadPool, CurrentThreadId) {
+  SpinningThreadPool pool(Env::Default(), ThreadOptions(), "spin_test", 3,
+                          /*spin_duration_us=*/100);
+  EXPECT_EQ(-1, pool.CurrentThreadId());
+  std::atomic<bool> id_in_range(false);
+  BlockingCounter done(1);
+  pool.Schedule([&pool, &id_in_range, &done]() {
+    const int id = pool.CurrentThreadId();
+    id_in_range = id >= 0 && id < pool.NumThreads();
+    done.DecrementCount();
+  });
+  done.Wait();
+  EXPECT_TRUE(id_in_range.load());
+}
+
+TEST(SpinningThreadPool, DrainsQueueOnDestruction) {
+  std::atomic<int> count(0);
+  {
+    SpinningThreadPool pool(Env::Default(), ThreadOptions(), "spin_test", 1,
+                            /*spin_duration_us=*/0);
+    for (int i = 0; i < 100; ++i) {
+      pool.Schedule([&count]() { count.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(100, count.load());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,182 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/static_memory_planner.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+
+namespace tensorflow {
+
+StaticMemoryPlanner::StaticMemoryPlanner(size_t alignment)
+    : alignment_(alignment) {
+  DCHECK_GT(alignment, 0);
+  DCHECK_EQ(alignment & (alignment - 1), 0) << "alignment must be a power of 2";
+}
+
+Status StaticMemoryPlanner::Plan(absl::Span<const TensorUsageRecord> records,
+                                 std::vector<size_t>* offsets) {
+  const auto align_up = [this](size_t bytes) {
+    return (bytes + alignment_ - 1) & ~(alignment_ - 1);
+  };
+
+  offsets->assign(records.size(), 0);
+  arena_bytes_ = 0;
+
+  // Place large tensors first so small ones fill the gaps they leave.
+  std::vector<size_t> placement_order(records.size());
+  std::iota(placement_order.begin(), placement_order.end(), 0);
+  std::sort(placement_order.begin(), placement_order.end(),
+            [&records](size_t a, size_t b) {
+              if (records[a].bytes != records[b].bytes) {
+                return records[a].bytes > records[b].bytes;
+              }
+              if (records[a].first_use != records[b].first_use) {
+                return records[a].first_use < records[b].first_use;
+              }
+              return a < b;
+            });
+
+  // Tensors placed so far, with their assigned offsets.
+  struct Placement {
+    size_t offset;
+    size_t bytes;
+    int32 first_use;
+    int32 last_use;
+  };
+  std::vector<Placement> placements;
+  placements.reserve(records.size());
+
+  for (size_t idx : placement_order) {
+    const TensorUsageRecord& record = records[idx];
+    if (record.first_use < 0 || record.last_use < record.first_use) {
+      return errors::InvalidArgument("Invalid tensor lifetime [",
+                                     record.first_use, ", ", record.last_use,
+                                     "]");
+    }
+    if (record.bytes == 0) {
+      continue;
+    }
+
+    // Collect the already placed tensors whose lifetimes overlap this one,
+    // in offset order; only those constrain where this tensor may go.
+    std::vector<const Placement*> live;
+    for (const Placement& placement : placements) {
+      if (placement.first_use <= record.last_use &&
+          record.first_use <= placement.last_use) {
+        live.push_back(&placement);
+      }
+    }
+    std::sort(live.begin(), live.end(),
+              [](const Placement* a, const Placement* b) {
+                return a->offset < b->offset;
+              });
+
+    // Take the lowest aligned gap between live tensors that fits.
+    size_t candidate = 0;
+    for (const Placement* placement : live) {
+      if (candidate + record.bytes <= placement->offset) {
+        break;
+      }
+      candidate = std::max(candidate,
+                           align_up(placement->offset + placement->bytes));
+    }
+
+    (*offsets)[idx] = candidate;
+    placements.push_back(
+        {candidate, record.bytes, record.first_use, record.last_use});
+    arena_bytes_ = std::max(arena_bytes_, candidate + record.bytes);
+  }
+
+  arena_bytes_ = align_up(arena_bytes_);
+  return OkStatus();
+}
+
+Status ComputeTensorUsageRecords(const Graph& graph,
+                                 const std::vector<Node*>& order,
+                                 std::vector<TensorUsageRecord>* records,
+                                 std::vector<PlannedTensorId>* tensor_ids) {
+  records->clear();
+  tensor_ids->clear();
+
+  absl::flat_hash_map<int, int32> position_by_node_id;
+  position_by_node_id.reserve(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    position_by_node_id[order[i]->id()] = static_cast<int32>(i);
+  }
+
+  for (size_t i = 0; i < order.size(); ++i) {
+    const Node* node = order[i];
+    if (node->IsSource() || node->IsSink() || node->IsConstant() ||
+        node->IsArg() || node->IsRetval()) {
+      continue;
+    }
+    std::vector<PartialTensorShape> shapes;
+    bool have_shapes = false;
+    for (int slot = 0; slot < node->num_outputs(); ++slot) {
+      const DataType dtype = node->output_type(slot);
+      // Ref, resource, variant and string tensors do not have a statically
+      // known payload size; the executor keeps allocating those dynamically.
+      if (IsRefType(dtype) || !DataTypeCanUseMemcpy(dtype)) {
+        continue;
+      }
+      if (!have_shapes) {
+        if (!GetNodeAttr(node->attrs(), "_output_shapes", &shapes).ok()) {
+          return errors::InvalidArgument(
+              "Node '", node->name(),
+              "' carries no _output_shapes attribute; memory planning "
+              "requires a fixed-shape graph");
+        }
+        have_shapes = true;
+      }
+      if (slot >= static_cast<int>(shapes.size()) ||
+          !shapes[slot].IsFullyDefined()) {
+        return errors::InvalidArgument(
+            "Output ", slot, " of node '", node->name(),
+            "' does not have a statically known shape; memory planning "
+            "requires a fixed-shape graph");
+      }
+      TensorUsageRecord record;
+      record.bytes = static_cast<size_t>(shapes[slot].num_elements()) *
+                     DataTypeSize(dtype);
+      record.first_use = static_cast<int32>(i);
+      record.last_use = record.first_use;
+      for (const Edge* edge : node->out_edges()) {
+        if (edge->IsControlEdge() || edge->src_output() != slot) {
+          continue;
+        }
+        auto it = position_by_node_id.find(edge->dst()->id());
+        if (it == position_by_node_id.end()) {
+          return errors::InvalidArgument("Node '", edge->dst()->name(),
+                                         "' consumes '", node->name(),
+                                         "' but is not in the execution "
+                                         "order");
+        }
+        record.last_use = std::max(record.last_use, it->second);
+      }
+      records->push_back(record);
+      tensor_ids->push_back({node->id(), slot});
+    }
+  }
+  return OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,91 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_MEMORY_PLANNER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_MEMORY_PLANNER_H_
+
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+
+// Describes one intermediate tensor of a fixed-shape graph for memory
+// planning purposes: its size in bytes and the interval of execution-order
+// positions during which its buffer must stay live.
+struct TensorUsageRecord {
+  size_t bytes = 0;
+  // Position, in a fixed execution order, of the producing node.
+  int32 first_use = 0;
+  // Position of the last consuming node; equals first_use if unconsumed.
+  int32 last_use = 0;
+};
+
+// Identifies the graph tensor a TensorUsageRecord was computed from.
+struct PlannedTensorId {
+  int node_id = -1;
+  int output_slot = -1;
+};
+
+// Assigns offsets inside a single arena slab to a set of tensors with
+// statically known sizes and lifetimes, reusing memory between tensors whose
+// lifetimes do not overlap.  Unlike BFC this runs once ahead of execution, so
+// a step that draws all of its intermediates from the planned arena performs
+// no allocator calls and its peak memory is known exactly.
+//
+// Offsets are assigned largest-tensor-first into the lowest-aligned gap whose
+// occupants' lifetimes do not overlap the tensor's, the same greedy-by-size
+// strategy TFLite's ArenaPlanner uses.  The result is deterministic for a
+// given set of records.
+class StaticMemoryPlanner {
+ public:
+  // All assigned offsets are multiples of `alignment`, which must be a power
+  // of two.
+  explicit StaticMemoryPlanner(
+      size_t alignment = Allocator::kAllocatorAlignment);
+
+  // Assigns an arena offset to every record.  On success (*offsets)[i] is the
+  // offset of records[i] and arena_bytes() is the total slab size required.
+  // Records of zero bytes are all placed at offset zero.
+  Status Plan(absl::Span<const TensorUsageRecord> records,
+              std::vector<size_t>* offsets);
+
+  // Total arena size required by the most recent successful Plan() call.
+  size_t arena_bytes() const { return arena_bytes_; }
+
+ private:
+  const size_t alignment_;
+  size_t arena_bytes_ = 0;
+};
+
+// Computes a usage record for every plannable output tensor of `order`, which
+// must be a valid execution order of `graph`'s nodes.  A tensor is plannable
+// if its dtype is memcpy-compatible (not a string, resource, variant or ref
+// type) and its shape is statically known through the node's "_output_shapes"
+// attribute; outputs of constants, arguments and retvals are excluded since
+// the executor does not allocate them per step.  Returns an error if a
+// plannable node lacks statically known output shapes, i.e. the graph is not
+// a fixed-shape graph.  `tensor_ids` identifies the tensor each record in
+// `records` describes.
+Status ComputeTensorUsageRecords(const Graph& graph,
+                                 const std::vector<Node*>& order,
+                                 std::vector<TensorUsageRecord>* records,
+                                 std::vector<PlannedTensorId>* tensor_ids);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STATIC_MEMORY_PLANNER_H_
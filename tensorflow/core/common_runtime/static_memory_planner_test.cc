@@ -0,0 +1,176 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/static_memory_planner.h"
+
+#include <vector>
+
+#include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(StaticMemoryPlannerTest, NonOverlappingLifetimesShareMemory) {
+  StaticMemoryPlanner planner;
+  std::vector<TensorUsageRecord> records = {
+      {/*bytes=*/1024, /*first_use=*/0, /*last_use=*/1},
+      {/*bytes=*/1024, /*first_use=*/2, /*last_use=*/3},
+  };
+  std::vector<size_t> offsets;
+  TF_ASSERT_OK(planner.Plan(records, &offsets));
+  EXPECT_EQ(offsets[0], offsets[1]);
+  EXPECT_EQ(planner.arena_bytes(), 1024);
+}
+
+TEST(StaticMemoryPlannerTest, OverlappingLifetimesGetDisjointRanges) {
+  StaticMemoryPlanner planner;
+  std::vector<TensorUsageRecord> records = {
+      {/*bytes=*/1024, /*first_use=*/0, /*last_use=*/2},
+      {/*bytes=*/1024, /*first_use=*/1, /*last_use=*/3},
+  };
+  std::vector<size_t> offsets;
+  TF_ASSERT_OK(planner.Plan(records, &offsets));
+  EXPECT_NE(offsets[0], offsets[1]);
+  EXPECT_EQ(planner.arena_bytes(), 2048);
+}
+
+TEST(StaticMemoryPlannerTest, SmallTensorsFillGapsLeftByLargeOnes) {
+  StaticMemoryPlanner planner;
+  std::vector<TensorUsageRecord> records = {
+      {/*bytes=*/1024, /*first_use=*/0, /*last_use=*/4},
+      {/*bytes=*/512, /*first_use=*/1, /*last_use=*/2},
+      {/*bytes=*/512, /*first_use=*/3, /*last_use=*/4},
+  };
+  std::vector<size_t> offsets;
+  TF_ASSERT_OK(planner.Plan(records, &offsets));
+  // The two small tensors never coexist, so they reuse the same range above
+  // the large one.
+  EXPECT_EQ(offsets[1], offsets[2]);
+  EXPECT_EQ(planner.arena_bytes(), 1536);
+}
+
+TEST(StaticMemoryPlannerTest, OffsetsAreAligned) {
+  StaticMemoryPlanner planner(/*alignment=*/64);
+  std::vector<TensorUsageRecord> records = {
+      {/*bytes=*/100, /*first_use=*/0, /*last_use=*/2},
+      {/*bytes=*/100, /*first_use=*/1, /*last_use=*/3},
+      {/*bytes=*/100, /*first_use=*/2, /*last_use=*/4},
+  };
+  std::vector<size_t> offsets;
+  TF_ASSERT_OK(planner.Plan(records, &offsets));
+  for (size_t offset : offsets) {
+    EXPECT_EQ(offset % 64, 0);
+  }
+  EXPECT_EQ(planner.arena_bytes() % 64, 0);
+}
+
+TEST(StaticMemoryPlannerTest, RejectsInvalidLifetime) {
+  StaticMemoryPlanner planner;
+  std::vector<TensorUsageRecord> records = {
+      {/*bytes=*/1024, /*first_use=*/3, /*last_use=*/1},
+  };
+  std::vector<size_t> offsets;
+  EXPECT_FALSE(planner.Plan(records, &offsets).ok());
+}
+
+AttrValue OutputShapesAttr(std::initializer_list<int64_t> dims) {
+  AttrValue value;
+  TensorShapeProto* shape = value.mutable_list()->add_shape();
+  for (int64_t dim : dims) {
+    shape->add_dim()->set_size(dim);
+  }
+  return value;
+}
+
+TEST(ComputeTensorUsageRecordsTest, ComputesLifetimesFromGraph) {
+  // a -> b -> c -> d, with a also feeding d directly.
+  GraphDef graph_def = test::function::GDef({
+      test::function::NDef("a", "Placeholder", {},
+                           {{"dtype", DT_FLOAT},
+                            {"_output_shapes", OutputShapesAttr({4})}}),
+      test::function::NDef(
+          "b", "Relu", {"a"},
+          {{"T", DT_FLOAT}, {"_output_shapes", OutputShapesAttr({4})}}),
+      test::function::NDef(
+          "c", "Relu", {"b"},
+          {{"T", DT_FLOAT}, {"_output_shapes", OutputShapesAttr({4})}}),
+      test::function::NDef(
+          "d", "Add", {"a", "c"},
+          {{"T", DT_FLOAT}, {"_output_shapes", OutputShapesAttr({4})}}),
+  });
+  Graph graph(OpRegistry::Global());
+  TF_ASSERT_OK(ConvertGraphDefToGraph({}, graph_def, &graph));
+
+  std::vector<Node*> order;
+  GetReversePostOrder(graph, &order, NodeComparatorName());
+
+  std::vector<TensorUsageRecord> records;
+  std::vector<PlannedTensorId> tensor_ids;
+  TF_ASSERT_OK(ComputeTensorUsageRecords(graph, order, &records, &tensor_ids));
+  ASSERT_EQ(records.size(), 4);
+  ASSERT_EQ(tensor_ids.size(), 4);
+
+  const auto record_for = [&](const string& name) {
+    for (size_t i = 0; i < tensor_ids.size(); ++i) {
+      if (graph.FindNodeId(tensor_ids[i].node_id)->name() == name) {
+        return records[i];
+      }
+    }
+    ADD_FAILURE() << "No record for node " << name;
+    return TensorUsageRecord();
+  };
+  const auto position_of = [&](const string& name) {
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (order[i]->name() == name) return static_cast<int32>(i);
+    }
+    ADD_FAILURE() << "No node named " << name;
+    return int32{-1};
+  };
+
+  // Every tensor holds 4 floats.
+  EXPECT_EQ(record_for("a").bytes, 16);
+  // "a" stays live until "d" consumes it; "b" dies once "c" has run.
+  EXPECT_EQ(record_for("a").first_use, position_of("a"));
+  EXPECT_EQ(record_for("a").last_use, position_of("d"));
+  EXPECT_EQ(record_for("b").last_use, position_of("c"));
+  // "d" is unconsumed, so its lifetime collapses to its own position.
+  EXPECT_EQ(record_for("d").first_use, record_for("d").last_use);
+}
+
+TEST(ComputeTensorUsageRecordsTest, RejectsGraphWithoutStaticShapes) {
+  GraphDef graph_def = test::function::GDef({
+      test::function::NDef("a", "Placeholder", {}, {{"dtype", DT_FLOAT}}),
+      test::function::NDef("b", "Relu", {"a"}, {{"T", DT_FLOAT}}),
+  });
+  Graph graph(OpRegistry::Global());
+  TF_ASSERT_OK(ConvertGraphDefToGraph({}, graph_def, &graph));
+
+  std::vector<Node*> order;
+  GetReversePostOrder(graph, &order, NodeComparatorName());
+
+  std::vector<TensorUsageRecord> records;
+  std::vector<PlannedTensorId> tensor_ids;
+  EXPECT_FALSE(
+      ComputeTensorUsageRecords(graph, order, &records, &tensor_ids).ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,106 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/step_arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mem.h"
+
+namespace tensorflow {
+
+StepArena::StepArena(size_t block_size) : min_block_size_(block_size) {
+  DCHECK_GT(block_size, 0);
+}
+
+StepArena::~StepArena() {
+  Block* block = current_.load(std::memory_order_relaxed);
+  while (block != nullptr) {
+    Block* next = block->next;
+    port::AlignedFree(block);
+    block = next;
+  }
+}
+
+/* static */ StepArena::Block* StepArena::NewBlock(size_t payload_bytes,
+                                                   Block* next) {
+  Block* block = static_cast<Block*>(port::AlignedMalloc(
+      sizeof(Block) + payload_bytes, alignof(std::max_align_t)));
+  CHECK(block != nullptr);
+  block->next = next;
+  block->capacity = payload_bytes;
+  block->offset.store(0, std::memory_order_relaxed);
+  return block;
+}
+
+/* static */ void* StepArena::TryAlloc(Block* block, size_t size,
+                                       size_t alignment) {
+  // Over-reserve by (alignment - 1) so the returned pointer can be aligned
+  // within the reservation regardless of where the bump lands.
+  const size_t reserve = size + alignment - 1;
+  const size_t start = block->offset.fetch_add(reserve,
+                                               std::memory_order_relaxed);
+  if (start + reserve > block->capacity) return nullptr;
+  const uintptr_t raw =
+      reinterpret_cast<uintptr_t>(block->payload()) + start;
+  return reinterpret_cast<void*>((raw + alignment - 1) & ~(alignment - 1));
+}
+
+void* StepArena::Alloc(size_t size, size_t alignment) {
+  DCHECK_EQ(alignment & (alignment - 1), 0) << "alignment must be 2^N";
+  bytes_allocated_.fetch_add(size, std::memory_order_relaxed);
+
+  Block* block = current_.load(std::memory_order_acquire);
+  if (block != nullptr) {
+    void* result = TryAlloc(block, size, alignment);
+    if (TF_PREDICT_TRUE(result != nullptr)) return result;
+  }
+
+  mutex_lock l(block_mu_);
+  // Another thread may have chained a fresh block while we waited.
+  Block* latest = current_.load(std::memory_order_relaxed);
+  if (latest != block) {
+    void* result = TryAlloc(latest, size, alignment);
+    if (result != nullptr) return result;
+  }
+  // Double the block size as the step grows, and always leave room for
+  // oversized requests.
+  size_t payload = std::max(min_block_size_,
+                            latest != nullptr ? latest->capacity * 2 : 0);
+  payload = std::max(payload, size + alignment - 1);
+  Block* fresh = NewBlock(payload, latest);
+  void* result = TryAlloc(fresh, size, alignment);
+  DCHECK(result != nullptr);
+  current_.store(fresh, std::memory_order_release);
+  return result;
+}
+
+void StepArena::Reset() {
+  Block* block = current_.load(std::memory_order_relaxed);
+  if (block == nullptr) return;
+  // Keep the newest (largest) block; release the rest.
+  Block* older = block->next;
+  while (older != nullptr) {
+    Block* next = older->next;
+    port::AlignedFree(older);
+    older = next;
+  }
+  block->next = nullptr;
+  block->offset.store(0, std::memory_order_relaxed);
+  bytes_allocated_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace tensorflow
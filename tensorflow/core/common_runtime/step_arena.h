@@ -0,0 +1,112 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A bump allocator for transient per-step objects in the executor (e.g.
+// AsyncState instances). All memory is reclaimed in bulk when the arena is
+// reset or destroyed at the end of the step, so the thousands of short-lived
+// allocations made while a step is in flight never reach the heap allocator
+// individually.
+//
+// Allocation is thread-safe and lock-free in the common case: threads bump a
+// shared offset in the current block with a fetch_add, and only fall back to a
+// mutex when a fresh block must be chained on. Blocks are allocated lazily, so
+// constructing an arena that ends up unused costs nothing but the object
+// itself.
+//
+// The arena does not run destructors: callers that place non-trivially
+// destructible objects in it must invoke StepArena::Destroy() before the
+// arena is reset or destroyed.
+class StepArena {
+ public:
+  static constexpr size_t kDefaultBlockSize = 64 << 10;  // 64KiB
+
+  explicit StepArena(size_t block_size = kDefaultBlockSize);
+  ~StepArena();
+
+  // Returns `size` bytes aligned to `alignment` (a power of two). The memory
+  // stays valid until Reset() or destruction.
+  void* Alloc(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  // Constructs a T in the arena. Pair with Destroy() for non-trivially
+  // destructible types.
+  template <typename T, typename... CtorArgs>
+  T* New(CtorArgs&&... args) {
+    return new (Alloc(sizeof(T), alignof(T)))
+        T(std::forward<CtorArgs>(args)...);
+  }
+
+  // Runs the destructor of an arena-constructed object. The storage itself is
+  // only reclaimed by Reset().
+  template <typename T>
+  static void Destroy(T* object) {
+    if (object != nullptr) object->~T();
+  }
+
+  // Rewinds the arena for reuse by the next step, keeping the most recently
+  // (i.e. largest) allocated block to amortize block churn across steps.
+  //
+  // REQUIRES: no concurrent Alloc() calls, and all objects with non-trivial
+  // destructors have been passed to Destroy().
+  void Reset();
+
+  // Total bytes handed out since construction or the last Reset().
+  size_t bytes_allocated() const {
+    return bytes_allocated_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // A block is a single malloc'ed region; the payload follows the header.
+  struct Block {
+    Block* next;      // Older block, or nullptr.
+    size_t capacity;  // Payload bytes available.
+    std::atomic<size_t> offset;  // Next unused payload byte.
+
+    char* payload() { return reinterpret_cast<char*>(this + 1); }
+  };
+
+  static Block* NewBlock(size_t payload_bytes, Block* next);
+
+  // Attempts to carve `size` bytes out of `block` without locking.
+  static void* TryAlloc(Block* block, size_t size, size_t alignment);
+
+  const size_t min_block_size_;
+
+  // Most recent block; older blocks are reachable through `next`. Readers
+  // load the pointer without the lock; only block chaining takes it.
+  std::atomic<Block*> current_{nullptr};
+  mutex block_mu_;
+
+  std::atomic<size_t> bytes_allocated_{0};
+
+  TF_DISALLOW_COPY_AND_ASSIGN(StepArena);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_STEP_ARENA_H_
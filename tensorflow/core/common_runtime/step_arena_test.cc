@@ -0,0 +1,110 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/step_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(StepArenaTest, AllocReturnsAlignedDistinctMemory) {
+  StepArena arena(/*block_size=*/256);
+  void* a = arena.Alloc(100, 64);
+  void* b = arena.Alloc(100, 64);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % 64, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0);
+  // Writes must not overlap.
+  memset(a, 0xAA, 100);
+  memset(b, 0xBB, 100);
+  EXPECT_EQ(static_cast<unsigned char*>(a)[99], 0xAA);
+}
+
+TEST(StepArenaTest, GrowsBeyondOneBlock) {
+  StepArena arena(/*block_size=*/128);
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(arena.Alloc(64));
+    memset(ptrs.back(), i, 64);
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(static_cast<unsigned char*>(ptrs[i])[0], i);
+  }
+  EXPECT_GE(arena.bytes_allocated(), 100 * 64);
+}
+
+TEST(StepArenaTest, OversizedRequest) {
+  StepArena arena(/*block_size=*/64);
+  void* p = arena.Alloc(1 << 20);
+  memset(p, 0, 1 << 20);  // Must be fully addressable.
+}
+
+TEST(StepArenaTest, ResetRewindsForReuse) {
+  StepArena arena(/*block_size=*/128);
+  for (int i = 0; i < 10; ++i) arena.Alloc(64);
+  arena.Reset();
+  EXPECT_EQ(arena.bytes_allocated(), 0);
+  void* p = arena.Alloc(64);
+  EXPECT_NE(p, nullptr);
+}
+
+TEST(StepArenaTest, NewAndDestroy) {
+  struct Tracked {
+    explicit Tracked(int* counter) : counter(counter) { ++*counter; }
+    ~Tracked() { --*counter; }
+    int* counter;
+  };
+  int live = 0;
+  StepArena arena;
+  Tracked* t = arena.New<Tracked>(&live);
+  EXPECT_EQ(live, 1);
+  StepArena::Destroy(t);
+  EXPECT_EQ(live, 0);
+}
+
+TEST(StepArenaTest, ConcurrentAlloc) {
+  constexpr int kThreads = 8;
+  constexpr int kAllocsPerThread = 2000;
+  StepArena arena(/*block_size=*/1024);
+  std::vector<std::vector<int*>> ptrs(kThreads);
+  {
+    thread::ThreadPool pool(Env::Default(), "test", kThreads);
+    for (int t = 0; t < kThreads; ++t) {
+      pool.Schedule([&arena, &ptrs, t]() {
+        for (int i = 0; i < kAllocsPerThread; ++i) {
+          int* p = static_cast<int*>(arena.Alloc(sizeof(int), alignof(int)));
+          *p = t;
+          ptrs[t].push_back(p);
+        }
+      });
+    }
+  }
+  // Every thread's writes must have landed in non-overlapping memory.
+  for (int t = 0; t < kThreads; ++t) {
+    ASSERT_EQ(ptrs[t].size(), kAllocsPerThread);
+    for (int* p : ptrs[t]) {
+      EXPECT_EQ(*p, t);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,293 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/tree_reducer.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/device_base.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+// Phases of the algorithm, used to disambiguate BufRendezvous keys for the
+// two transfers that happen over each tree edge.
+constexpr char kUpPhase[] = "up";
+constexpr char kDownPhase[] = "down";
+
+// Key to be used for BufRendezvous by TreeReducer.
+string TreeReduceBufKey(const string& exec_key, const char* phase,
+                        int src_rank, int dst_rank) {
+  // TODO(b/78352018): Try a denser format, e.g. a 64 or 128 bit hash.
+  return strings::StrCat(exec_key, ":", phase, ":", src_rank, ":", dst_rank);
+}
+}  // namespace
+
+TreeReducer::TreeReducer()
+    : col_ctx_(nullptr), col_params_(nullptr), done_(nullptr) {}
+
+Status TreeReducer::InitializeCollectiveParams(CollectiveParams* col_params) {
+  CHECK_EQ(col_params->instance.type, REDUCTION_COLLECTIVE);
+  CHECK_EQ(col_params->instance.impl_details.collective_name, "TreeReduce");
+  if (col_params->group.num_tasks > 1) {
+    return errors::InvalidArgument(
+        "TreeReduce is only supported within a single task but group has ",
+        col_params->group.num_tasks, " tasks");
+  }
+  if (col_params->group.device_type != DeviceType(DEVICE_CPU)) {
+    return errors::InvalidArgument(
+        "TreeReduce is only supported between CPU devices but got device "
+        "type ",
+        col_params->group.device_type.type_string());
+  }
+  return OkStatus();
+}
+
+Status TreeReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  CHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+void TreeReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  // Like `RingReducer`, `TreeReducer` doesn't require non-overlapping
+  // collectives, so unblock any collective that is blocked on this instance.
+  col_ctx_->col_exec->UnblockDependencies(*col_params_);
+
+  done_ = std::move(done);
+
+  // Start by copying input to output if they're not already the same, i.e. if
+  // we're not computing in-place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    // We are running in a blockable thread and the callback can't block so
+    // just wait here on the copy.
+    Notification note;
+    Status status;
+    profiler::TraceMe activity("MemCpyAsync", profiler::TraceMeLevel::kInfo);
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [&note, &status](const Status& s) {
+          status.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status.ok()) {
+      done_(status);
+      return;
+    }
+  }
+  RunTree();
+}
+
+// The tree is the implicit binary heap ordering over ranks: rank r is the
+// parent of ranks 2r+1 and 2r+2, and rank 0 is the root.
+
+/* static */
+int TreeReducer::TreeParent(int rank) {
+  return (rank == 0) ? -1 : (rank - 1) / 2;
+}
+
+/* static */
+void TreeReducer::TreeChildren(int rank, int group_size,
+                               std::vector<int>* children) {
+  children->clear();
+  for (int child = 2 * rank + 1; child <= 2 * rank + 2; ++child) {
+    if (child < group_size) children->push_back(child);
+  }
+}
+
+// Executes the reduction as two sweeps over a binary tree of all devices.
+// In the up sweep every device receives the partial sum of each child's
+// subtree, merges them into its own value and sends the combined value to its
+// parent, so the root ends up holding the full reduction.  The root applies
+// final_op once, then the down sweep broadcasts the result back along the
+// same edges.
+void TreeReducer::RunTree() {
+  const int my_rank = col_params_->default_rank;
+  const int group_size = col_params_->group.group_size;
+  std::vector<int> children;
+  TreeChildren(my_rank, group_size, &children);
+  VLOG(1) << "TreeReducer::RunTree device=" << col_ctx_->device_name
+          << " rank=" << my_rank << " group_size=" << group_size;
+
+  AllocatorAttributes attr = col_ctx_->op_ctx->output_alloc_attr(0);
+  Allocator* allocator = col_ctx_->device->GetAllocator(attr);
+
+  // Up sweep: receive the children's subtree sums concurrently, then fold
+  // them into this device's value in rank order so that every device applies
+  // merge_op in a deterministic order.
+  if (!children.empty()) {
+    std::vector<Tensor> child_values;
+    child_values.reserve(children.size());
+    for (size_t i = 0; i < children.size(); ++i) {
+      child_values.emplace_back(allocator, col_ctx_->output->dtype(),
+                                col_ctx_->output->shape());
+    }
+    {
+      profiler::TraceMe activity("ReceiveChildValues",
+                                 profiler::TraceMeLevel::kInfo);
+      mutex mu;  // also guards status_ while callbacks are pending
+      int pending_count = children.size();
+      condition_variable all_done;
+      for (size_t i = 0; i < children.size(); ++i) {
+        DispatchRecv(children[i], kUpPhase, &child_values[i],
+                     [this, &mu, &pending_count, &all_done](const Status& s) {
+                       mutex_lock l(mu);
+                       status_.Update(s);
+                       --pending_count;
+                       if (pending_count == 0) all_done.notify_all();
+                     });
+      }
+      mutex_lock l(mu);
+      while (pending_count > 0) all_done.wait(l);
+    }
+    for (size_t i = 0; i < children.size() && status_.ok(); ++i) {
+      status_.Update(collective_util::ComputeBinOp(
+          col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+          col_params_->merge_op, col_ctx_->output, &child_values[i]));
+    }
+  }
+
+  if (my_rank > 0) {
+    // Forward the subtree sum to the parent, then wait for the fully reduced
+    // value to come back down.
+    if (status_.ok()) {
+      profiler::TraceMe activity("SendToParent",
+                                 profiler::TraceMeLevel::kInfo);
+      Notification note;
+      DispatchSend(TreeParent(my_rank), kUpPhase, col_ctx_->output,
+                   [this, &note](const Status& s) {
+                     status_.Update(s);
+                     note.Notify();
+                   });
+      note.WaitForNotification();
+    }
+    if (status_.ok()) {
+      profiler::TraceMe activity("ReceiveFinalValue",
+                                 profiler::TraceMeLevel::kInfo);
+      Notification note;
+      DispatchRecv(TreeParent(my_rank), kDownPhase, col_ctx_->output,
+                   [this, &note](const Status& s) {
+                     status_.Update(s);
+                     note.Notify();
+                   });
+      note.WaitForNotification();
+    }
+  } else if (status_.ok() && col_params_->final_op) {
+    // The root applies final_op (e.g. division by group size for Mean) once,
+    // before the result goes back down; the other devices receive the final
+    // value directly.
+    std::unique_ptr<CollectiveAdapter> ca(
+        MakeCollectiveAdapter(col_ctx_->output, 1, allocator));
+    Tensor group_size_tensor = ca->Scalar(group_size);
+    ca->ConsumeFinalValue(col_ctx_->output);
+    status_.Update(collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->final_op, col_ctx_->output, &group_size_tensor));
+  }
+
+  // Down sweep: forward the final value to the children.
+  if (status_.ok() && !children.empty()) {
+    profiler::TraceMe activity("ForwardFinalValue",
+                               profiler::TraceMeLevel::kInfo);
+    mutex mu;
+    int pending_count = children.size();
+    condition_variable all_done;
+    for (int child : children) {
+      DispatchSend(child, kDownPhase, col_ctx_->output,
+                   [this, &mu, &pending_count, &all_done](const Status& s) {
+                     mutex_lock l(mu);
+                     status_.Update(s);
+                     --pending_count;
+                     if (pending_count == 0) all_done.notify_all();
+                   });
+    }
+    mutex_lock l(mu);
+    while (pending_count > 0) all_done.wait(l);
+  }
+
+  VLOG(2) << "device=" << col_ctx_->device_name << " return status " << status_;
+  done_(status_);
+}
+
+void TreeReducer::DispatchSend(int dst_rank, const char* phase,
+                               const Tensor* src_tensor,
+                               const StatusCallback& done) {
+  string send_buf_key = TreeReduceBufKey(col_ctx_->exec_key, phase,
+                                         col_params_->default_rank, dst_rank);
+  VLOG(3) << "DispatchSend " << send_buf_key << " from_device "
+          << col_ctx_->device_name << " to_device "
+          << col_params_->group.members[dst_rank].device.name()
+          << " phase=" << phase << " dst_rank=" << dst_rank;
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[dst_rank].device.name(),
+      col_params_->group.members[dst_rank].task, send_buf_key, col_ctx_->device,
+      col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), src_tensor,
+      col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+      done);
+}
+
+void TreeReducer::DispatchRecv(int src_rank, const char* phase,
+                               Tensor* dst_tensor, const StatusCallback& done) {
+  string recv_buf_key = TreeReduceBufKey(col_ctx_->exec_key, phase, src_rank,
+                                         col_params_->default_rank);
+  VLOG(3) << "DispatchRecv " << recv_buf_key << " from_device "
+          << col_params_->group.members[src_rank].device.name() << " to_device "
+          << col_ctx_->device_name << " phase=" << phase
+          << " src_rank=" << src_rank;
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_rank].device.name(),
+      col_params_->group.members[src_rank].task,
+      col_params_->group.members[src_rank].is_local, recv_buf_key,
+      col_ctx_->device, col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), dst_tensor,
+      col_ctx_->device_locality, 0 /*stream_index*/,
+      col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+namespace {
+REGISTER_COLLECTIVE(TreeReduce, TreeReducer);
+}  // namespace
+
+}  // namespace tensorflow
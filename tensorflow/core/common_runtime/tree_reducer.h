@@ -0,0 +1,83 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_TREE_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_TREE_REDUCER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+
+namespace tensorflow {
+
+// Binary-tree implementation of collective all-reduce between CPU devices on
+// a single task.  Partial sums flow up the tree with merge_op applied at each
+// interior node, final_op runs once at the root, and the result is broadcast
+// back down the same tree.  Compared to ring all-reduce this completes in
+// 2*ceil(log2(group_size)) latency-bound steps instead of 2*(group_size-1),
+// which wins for the small tensors that dominate CPU training collectives.
+// `BaseCollectiveExecutor::SelectReductionCollective` decides when to prefer
+// this implementation over `RingReducer`.
+class TreeReducer : public CollectiveImplementationInterface {
+ public:
+  TreeReducer();
+  ~TreeReducer() override = default;
+
+  // TreeReduce needs no subdivisions; this only validates that the group is
+  // confined to CPU devices on a single task.
+  Status InitializeCollectiveParams(CollectiveParams* col_params) override;
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality.  Also saves the CollectiveContext in this object.
+  Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Begins async execution of the tree reduce algorithm.
+  // Must be called in a blockable thread.
+  // TODO(b/80529858): remove the previous warning when we have a dedicated
+  // collective threadpool.
+  void Run(StatusCallback done) override;
+
+  // Returns the rank of the parent of `rank` in the tree, -1 for the root.
+  static int TreeParent(int rank);
+
+  // Populates `children` with the ranks of the children of `rank`.
+  static void TreeChildren(int rank, int group_size,
+                           std::vector<int>* children);
+
+ private:
+  // Sends `src_tensor` asynchronously from this device to the device at
+  // `dst_rank`.  `phase` disambiguates the up and down passes in the
+  // rendezvous key.  Calls `done` upon completion.
+  void DispatchSend(int dst_rank, const char* phase, const Tensor* src_tensor,
+                    const StatusCallback& done);
+
+  // Receives a tensor into the memory buffer owned by `dst_tensor` at this
+  // device from the device at `src_rank`.  Calls `done` upon completion.
+  void DispatchRecv(int src_rank, const char* phase, Tensor* dst_tensor,
+                    const StatusCallback& done);
+
+  // Executes the up-and-down tree reduction defined by this op.
+  void RunTree();
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  StatusCallback done_;
+  Status status_;
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_TREE_REDUCER_H_
@@ -0,0 +1,230 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/tree_reducer.h"
+
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+std::unique_ptr<OpKernel> GetBinOpKernel(const string& op_name, DataType dtype,
+                                         const DeviceType& device_type,
+                                         DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder(op_name + "_node", op_name);
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  Status status;
+  std::unique_ptr<OpKernel> k = CreateOpKernel(
+      device_type, device, device->GetAllocator(AllocatorAttributes()),
+      node_def, TF_GRAPH_DEF_VERSION, &status);
+  TF_CHECK_OK(status);
+  return k;
+}
+
+class TreeReducerTest : public ::testing::Test {
+ protected:
+  void Init(int num_devices, DataType dtype, const TensorShape& shape) {
+    test_env_ = CreateCollectiveTestEnv(/*num_workers=*/1, num_devices,
+                                        DEVICE_CPU);
+    for (int di = 0; di < num_devices; ++di) {
+      instances_.push_back(
+          std::make_unique<DeviceInstance>(di, dtype, shape, test_env_.get()));
+    }
+  }
+
+  void Reduce() {
+    std::atomic<int> done(0);
+    for (auto& di : instances_) {
+      SchedClosure([&di, &done] {
+        di->DoReduce();
+        ++done;
+      });
+    }
+    while (done < static_cast<int>(instances_.size())) {
+      Env::Default()->SleepForMicroseconds(1000);
+    }
+  }
+
+  template <typename T>
+  void RunTest(DataType dtype, int num_devices, int tensor_len) {
+    Init(num_devices, dtype, TensorShape({tensor_len}));
+    std::vector<T> expected(tensor_len);
+    for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+      instances_[di]->InitTensor([&expected, di](Tensor* t) {
+        for (size_t i = 0; i < t->NumElements(); ++i) {
+          float value = pow(10, static_cast<double>(di)) * i;
+          t->flat<T>()(i) = static_cast<T>(value);
+          expected[i] += static_cast<T>(value);
+        }
+      });
+    }
+    Reduce();
+    // Confirm that every device computed the same correct reduction value.
+    for (int i = 0; i < tensor_len; ++i) {
+      expected[i] /= static_cast<T>(num_devices);
+    }
+    for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+      TF_EXPECT_OK(instances_[di]->status_);
+      test::ExpectTensorEqual<T>(test::AsTensor<T>(expected),
+                                 instances_[di]->tensor());
+    }
+  }
+
+  class DeviceInstance {
+   public:
+    DeviceInstance(int rank, DataType dtype, const TensorShape& shape,
+                   CollectiveTestEnv* test_env)
+        : test_env_(test_env), tensor_(dtype, shape) {
+      col_params_ = CreateCollectiveParams(*test_env_, rank, "TreeReduce",
+                                           REDUCTION_COLLECTIVE, dtype, shape);
+      string dev_name = col_params_->group.members[rank].device.name();
+      TF_CHECK_OK(test_env_->device_mgr->LookupDevice(dev_name, &device_))
+          << "Couldn't find device " << dev_name
+          << " existing devices: " << test_env_->device_mgr->DebugString();
+      merge_op_ = GetBinOpKernel("Add", col_params_->instance.data_type,
+                                 test_env_->device_type, device_);
+      final_op_ = GetBinOpKernel("Div", col_params_->instance.data_type,
+                                 test_env_->device_type, device_);
+      col_params_->merge_op = merge_op_.get();
+      col_params_->final_op = final_op_.get();
+    }
+
+    void InitTensor(const std::function<void(Tensor*)>& init_f) {
+      init_f(&tensor_);
+    }
+
+    void DoReduce() {
+      status_ = RunCollective(test_env_, col_params_.get(), device_, &tensor_,
+                              &tensor_);
+    }
+
+    const Tensor& tensor() { return tensor_; }
+
+    CollectiveTestEnv* test_env_;
+    Tensor tensor_;
+    Device* device_;
+    core::RefCountPtr<CollectiveParams> col_params_;
+    std::unique_ptr<OpKernel> merge_op_;
+    std::unique_ptr<OpKernel> final_op_;
+    Status status_;
+  };
+
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+  std::vector<std::unique_ptr<DeviceInstance>> instances_;
+};
+
+TEST_F(TreeReducerTest, TreeTopology) {
+  EXPECT_EQ(-1, TreeReducer::TreeParent(0));
+  EXPECT_EQ(0, TreeReducer::TreeParent(1));
+  EXPECT_EQ(0, TreeReducer::TreeParent(2));
+  EXPECT_EQ(1, TreeReducer::TreeParent(3));
+  EXPECT_EQ(3, TreeReducer::TreeParent(7));
+
+  std::vector<int> children;
+  TreeReducer::TreeChildren(0, 8, &children);
+  EXPECT_EQ(std::vector<int>({1, 2}), children);
+  TreeReducer::TreeChildren(2, 8, &children);
+  EXPECT_EQ(std::vector<int>({5, 6}), children);
+  TreeReducer::TreeChildren(3, 8, &children);
+  EXPECT_EQ(std::vector<int>({7}), children);
+  TreeReducer::TreeChildren(4, 8, &children);
+  EXPECT_TRUE(children.empty());
+}
+
+TEST_F(TreeReducerTest, InitializeParams) {
+  auto test_env = CreateCollectiveTestEnv(/*num_workers=*/1,
+                                          /*num_devices=*/8, DEVICE_CPU);
+  auto cp =
+      CreateCollectiveParams(*test_env, /*rank=*/0, "TreeReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({16}));
+  core::RefCountPtr<TreeReducer> reducer(new TreeReducer());
+  TF_EXPECT_OK(reducer->InitializeCollectiveParams(cp.get()));
+}
+
+TEST_F(TreeReducerTest, InitializeParamsMultiTask) {
+  auto test_env = CreateCollectiveTestEnv(/*num_workers=*/2,
+                                          /*num_devices=*/4, DEVICE_CPU);
+  auto cp =
+      CreateCollectiveParams(*test_env, /*rank=*/0, "TreeReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({16}));
+  core::RefCountPtr<TreeReducer> reducer(new TreeReducer());
+  EXPECT_TRUE(errors::IsInvalidArgument(
+      reducer->InitializeCollectiveParams(cp.get())));
+}
+
+TEST_F(TreeReducerTest, SelectReductionCollective) {
+  auto test_env = CreateCollectiveTestEnv(/*num_workers=*/1,
+                                          /*num_devices=*/8, DEVICE_CPU);
+  auto cp = CreateCollectiveParams(*test_env, /*rank=*/0, "TreeReduce",
+                                   REDUCTION_COLLECTIVE, DT_FLOAT,
+                                   TensorShape({1024}));
+  // Small single-task CPU reduction prefers the tree.
+  EXPECT_STREQ("TreeReduce",
+               BaseCollectiveExecutor::SelectReductionCollective(cp.get()));
+  // An explicit ring hint wins.
+  cp->instance.impl_details.communication_hint = "ring";
+  EXPECT_STREQ("RingReduce",
+               BaseCollectiveExecutor::SelectReductionCollective(cp.get()));
+  cp->instance.impl_details.communication_hint = "auto";
+  // Large tensors are bandwidth-bound and stay on the ring.
+  cp->instance.shape = TensorShape({1024 * 1024});
+  EXPECT_STREQ("RingReduce",
+               BaseCollectiveExecutor::SelectReductionCollective(cp.get()));
+}
+
+// Full reductions: device counts cover a balanced tree (7), an unbalanced
+// tree (6), a chain (3), and the degenerate pair.
+TEST_F(TreeReducerTest, CpuFloatLen16Dev7) { RunTest<float>(DT_FLOAT, 7, 16); }
+
+TEST_F(TreeReducerTest, CpuFloatLen1001Dev6) {
+  RunTest<float>(DT_FLOAT, 6, 1001);
+}
+
+TEST_F(TreeReducerTest, CpuFloatLen1Dev3) { RunTest<float>(DT_FLOAT, 3, 1); }
+
+TEST_F(TreeReducerTest, CpuFloatLen128Dev2) {
+  RunTest<float>(DT_FLOAT, 2, 128);
+}
+
+TEST_F(TreeReducerTest, CpuDoubleLen64Dev5) {
+  RunTest<double>(DT_DOUBLE, 5, 64);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,235 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_READY_QUEUE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_READY_QUEUE_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A work-stealing ready queue for scheduling small units of work (e.g. ready
+// nodes in `ExecutorState`) across a bounded set of worker loops without
+// serializing on a mutex in steady state.
+//
+// The queue maintains one bounded ring deque per worker slot. A worker pushes
+// newly-ready items into its own deque and pops from it locally; when its
+// deque runs dry it steals from the other workers' deques. Each ring slot
+// carries a sequence number (in the style of a Chase-Lev deque with bounded
+// storage), so pushes and pops are a handful of atomic operations and never
+// take a lock. Threads that are not registered workers (e.g. the thread that
+// activates the root nodes, or an async kernel's completion callback) submit
+// through `Inject`, which appends to a mutex-protected overflow list that
+// workers consult only after an unsuccessful steal sweep.
+//
+// `T` must be trivially copyable; items are stored by value in the rings.
+//
+// This class is thread-safe.
+template <typename T>
+class WorkStealingReadyQueue {
+ public:
+  static constexpr int64_t kDefaultPerWorkerCapacity = 1024;
+
+  explicit WorkStealingReadyQueue(
+      int num_workers, int64_t per_worker_capacity = kDefaultPerWorkerCapacity)
+      : num_workers_(num_workers), capacity_(per_worker_capacity) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "WorkStealingReadyQueue requires a trivially copyable type");
+    DCHECK_GT(num_workers_, 0);
+    DCHECK_EQ(capacity_ & (capacity_ - 1), 0) << "capacity must be 2^N";
+    deques_.reserve(num_workers_);
+    for (int i = 0; i < num_workers_; ++i) {
+      deques_.push_back(std::make_unique<Deque>(capacity_));
+    }
+    worker_active_ = std::make_unique<std::atomic<bool>[]>(num_workers_);
+    for (int i = 0; i < num_workers_; ++i) {
+      worker_active_[i].store(false, std::memory_order_relaxed);
+    }
+  }
+
+  int num_workers() const { return num_workers_; }
+
+  // Process-unique id of this queue. Callers that cache a worker id in
+  // thread-local storage must record this id alongside it and re-validate
+  // before calling `Push`/`Pop`: a worker id acquired from one queue grants
+  // no slot in any other.
+  uint64 id() const { return id_; }
+
+  // Pushes `item` into worker `worker_id`'s deque. Falls back to `Inject` if
+  // the deque is full. Must only be called from the thread that acquired
+  // `worker_id`.
+  void Push(int worker_id, const T& item) {
+    DCHECK_GE(worker_id, 0);
+    DCHECK_LT(worker_id, num_workers_);
+    if (TF_PREDICT_FALSE(!TryPush(deques_[worker_id].get(), item))) {
+      Inject(item);
+    }
+  }
+
+  // Submits `item` from a thread that does not hold a worker slot.
+  void Inject(const T& item) {
+    mutex_lock l(overflow_mu_);
+    overflow_.push_back(item);
+    overflow_size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Pops the next item for worker `worker_id`: first from its own deque, then
+  // by stealing from the other workers, and finally from the overflow list.
+  // Returns false if no work was found anywhere.
+  bool Pop(int worker_id, T* item) {
+    DCHECK_GE(worker_id, 0);
+    DCHECK_LT(worker_id, num_workers_);
+    if (TF_PREDICT_TRUE(TryPop(deques_[worker_id].get(), item))) return true;
+    for (int i = 1; i < num_workers_; ++i) {
+      const int victim = (worker_id + i) % num_workers_;
+      if (TryPop(deques_[victim].get(), item)) return true;
+    }
+    if (overflow_size_.load(std::memory_order_relaxed) > 0) {
+      mutex_lock l(overflow_mu_);
+      if (!overflow_.empty()) {
+        *item = overflow_.front();
+        overflow_.pop_front();
+        overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Returns true if every deque and the overflow list appeared empty at some
+  // point during the call. Approximate under concurrent pushes; callers use it
+  // only as a hint to avoid spawning idle workers.
+  bool Empty() const {
+    for (int i = 0; i < num_workers_; ++i) {
+      const Deque* d = deques_[i].get();
+      if (d->head.load(std::memory_order_relaxed) !=
+          d->tail.load(std::memory_order_relaxed)) {
+        return false;
+      }
+    }
+    return overflow_size_.load(std::memory_order_relaxed) == 0;
+  }
+
+  // Claims an unused worker slot, returning its id, or -1 if all slots are
+  // taken (i.e. enough worker loops are already running).
+  int AcquireWorkerId() {
+    for (int i = 0; i < num_workers_; ++i) {
+      bool expected = false;
+      if (!worker_active_[i].load(std::memory_order_relaxed) &&
+          worker_active_[i].compare_exchange_strong(
+              expected, true, std::memory_order_acquire)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // Releases a slot previously returned by `AcquireWorkerId`. The caller must
+  // not call `Push` or `Pop` with `worker_id` afterwards.
+  void ReleaseWorkerId(int worker_id) {
+    DCHECK_GE(worker_id, 0);
+    DCHECK_LT(worker_id, num_workers_);
+    DCHECK(worker_active_[worker_id].load(std::memory_order_relaxed));
+    worker_active_[worker_id].store(false, std::memory_order_release);
+  }
+
+ private:
+  static uint64 NextQueueId() {
+    static std::atomic<uint64> next_id{1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // A bounded ring deque. `head` is advanced only by the owning worker's
+  // pushes; `tail` is advanced by any consumer via CAS. Each slot's sequence
+  // number encodes whether it holds a published item for the current lap,
+  // which makes the consume path safe against concurrent reuse of slots.
+  struct Slot {
+    std::atomic<int64_t> sequence;
+    T value;
+  };
+
+  struct Deque {
+    explicit Deque(int64_t capacity) : slots(new Slot[capacity]) {
+      for (int64_t i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<int64_t> head{0};  // Next push position.
+    alignas(64) std::atomic<int64_t> tail{0};  // Next pop position.
+  };
+
+  bool TryPush(Deque* d, const T& item) {
+    const int64_t mask = capacity_ - 1;
+    const int64_t h = d->head.load(std::memory_order_relaxed);
+    Slot* slot = &d->slots[h & mask];
+    // The slot is free for lap `h` iff its sequence has caught up to `h`.
+    if (slot->sequence.load(std::memory_order_acquire) != h) return false;
+    slot->value = item;
+    slot->sequence.store(h + 1, std::memory_order_release);
+    d->head.store(h + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool TryPop(Deque* d, T* item) {
+    const int64_t mask = capacity_ - 1;
+    int64_t t = d->tail.load(std::memory_order_relaxed);
+    while (true) {
+      Slot* slot = &d->slots[t & mask];
+      const int64_t seq = slot->sequence.load(std::memory_order_acquire);
+      const int64_t diff = seq - (t + 1);
+      if (diff == 0) {
+        if (d->tail.compare_exchange_weak(t, t + 1,
+                                          std::memory_order_relaxed)) {
+          *item = slot->value;
+          // Mark the slot free for the next lap of pushes.
+          slot->sequence.store(t + capacity_, std::memory_order_release);
+          return true;
+        }
+        // `t` was reloaded by the failed CAS; retry at the new tail.
+      } else if (diff < 0) {
+        return false;  // Not yet published: the deque is empty.
+      } else {
+        t = d->tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  const uint64 id_ = NextQueueId();
+  const int num_workers_;
+  const int64_t capacity_;
+  std::vector<std::unique_ptr<Deque>> deques_;
+  std::unique_ptr<std::atomic<bool>[]> worker_active_;
+
+  mutex overflow_mu_;
+  std::deque<T> overflow_ TF_GUARDED_BY(overflow_mu_);
+  std::atomic<int64_t> overflow_size_{0};
+
+  TF_DISALLOW_COPY_AND_ASSIGN(WorkStealingReadyQueue);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_WORK_STEALING_READY_QUEUE_H_
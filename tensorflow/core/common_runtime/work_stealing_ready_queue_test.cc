@@ -0,0 +1,113 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/work_stealing_ready_queue.h"
+
+#include <atomic>
+#include <vector>
+
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(WorkStealingReadyQueue, PushPopSingleWorker) {
+  WorkStealingReadyQueue<int> queue(/*num_workers=*/1,
+                                    /*per_worker_capacity=*/8);
+  int item = -1;
+  EXPECT_FALSE(queue.Pop(0, &item));
+  for (int i = 0; i < 5; ++i) queue.Push(0, i);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(queue.Pop(0, &item));
+    EXPECT_EQ(item, i);
+  }
+  EXPECT_FALSE(queue.Pop(0, &item));
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WorkStealingReadyQueue, OverflowsIntoInjectList) {
+  WorkStealingReadyQueue<int> queue(/*num_workers=*/1,
+                                    /*per_worker_capacity=*/4);
+  // Push more items than the ring can hold: the surplus must survive via the
+  // overflow list and still come back out.
+  for (int i = 0; i < 10; ++i) queue.Push(0, i);
+  std::vector<bool> seen(10, false);
+  int item = -1;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.Pop(0, &item));
+    ASSERT_GE(item, 0);
+    ASSERT_LT(item, 10);
+    EXPECT_FALSE(seen[item]);
+    seen[item] = true;
+  }
+  EXPECT_FALSE(queue.Pop(0, &item));
+}
+
+TEST(WorkStealingReadyQueue, StealsFromOtherWorkers) {
+  WorkStealingReadyQueue<int> queue(/*num_workers=*/2,
+                                    /*per_worker_capacity=*/8);
+  queue.Push(0, 42);
+  int item = -1;
+  // Worker 1 has nothing local; it must steal worker 0's item.
+  ASSERT_TRUE(queue.Pop(1, &item));
+  EXPECT_EQ(item, 42);
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WorkStealingReadyQueue, WorkerIdAcquisition) {
+  WorkStealingReadyQueue<int> queue(/*num_workers=*/2);
+  const int a = queue.AcquireWorkerId();
+  const int b = queue.AcquireWorkerId();
+  EXPECT_NE(a, b);
+  EXPECT_EQ(queue.AcquireWorkerId(), -1);
+  queue.ReleaseWorkerId(a);
+  EXPECT_EQ(queue.AcquireWorkerId(), a);
+}
+
+TEST(WorkStealingReadyQueue, ConcurrentProducersAndConsumers) {
+  constexpr int kNumWorkers = 4;
+  constexpr int kItemsPerProducer = 10000;
+  WorkStealingReadyQueue<int> queue(kNumWorkers,
+                                    /*per_worker_capacity=*/64);
+  std::atomic<int64_t> sum{0};
+  std::atomic<int> popped{0};
+  {
+    thread::ThreadPool pool(Env::Default(), "test", 2 * kNumWorkers);
+    for (int w = 0; w < kNumWorkers; ++w) {
+      pool.Schedule([&queue, w]() {
+        for (int i = 0; i < kItemsPerProducer; ++i) {
+          queue.Push(w, i);
+        }
+      });
+      pool.Schedule([&queue, &sum, &popped, w]() {
+        int item;
+        while (popped.load() < kNumWorkers * kItemsPerProducer) {
+          if (queue.Pop(w, &item)) {
+            sum.fetch_add(item);
+            popped.fetch_add(1);
+          }
+        }
+      });
+    }
+  }
+  EXPECT_EQ(popped.load(), kNumWorkers * kItemsPerProducer);
+  const int64_t expected_sum = static_cast<int64_t>(kNumWorkers) *
+                               kItemsPerProducer * (kItemsPerProducer - 1) / 2;
+  EXPECT_EQ(sum.load(), expected_sum);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,202 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/arena_shuffle_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/data/compression_utils.h"
+#include "tensorflow/core/data/dataset.pb.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/strcat.h"
+
+namespace tensorflow {
+namespace data {
+
+ArenaShuffleBuffer::ArenaShuffleBuffer(size_t num_slots, size_t block_bytes)
+    : block_bytes_(std::max<size_t>(block_bytes, 1)) {
+  entries_.resize(num_slots);
+}
+
+ArenaShuffleBuffer::~ArenaShuffleBuffer() {
+  if (env_ == nullptr) {
+    return;
+  }
+  for (const Block& block : blocks_) {
+    if (!block.file.empty()) {
+      env_->DeleteFile(block.file).IgnoreError();
+    }
+  }
+}
+
+Status ArenaShuffleBuffer::EnableSpilling(Env* env,
+                                          const std::string& directory,
+                                          size_t max_resident_blocks) {
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(directory));
+  env_ = env;
+  spill_directory_ = directory;
+  max_resident_blocks_ = std::max<size_t>(max_resident_blocks, 1);
+  spill_file_id_ = random::New64();
+  return OkStatus();
+}
+
+Status ArenaShuffleBuffer::Put(size_t slot,
+                               const std::vector<Tensor>& element) {
+  if (slot >= entries_.size()) {
+    return errors::InvalidArgument("Slot ", slot, " is out of range for a ",
+                                   "buffer with ", entries_.size(), " slots.");
+  }
+  CompressedElement compressed;
+  TF_RETURN_IF_ERROR(CompressElement(element, &compressed));
+  std::string serialized;
+  if (!compressed.SerializeToString(&serialized)) {
+    return errors::Internal("Failed to serialize compressed element.");
+  }
+  Entry entry;
+  TF_RETURN_IF_ERROR(Append(serialized, &entry));
+  Release(&entries_[slot]);
+  entries_[slot] = entry;
+  return OkStatus();
+}
+
+Status ArenaShuffleBuffer::Get(size_t slot,
+                               std::vector<Tensor>* element) const {
+  if (!Contains(slot)) {
+    return errors::NotFound("Slot ", slot, " is empty.");
+  }
+  std::string serialized;
+  TF_RETURN_IF_ERROR(ReadEntry(entries_[slot], &serialized));
+  CompressedElement compressed;
+  if (!compressed.ParseFromString(serialized)) {
+    return errors::Internal("Failed to parse compressed element in slot ",
+                            slot, ".");
+  }
+  return UncompressElement(compressed, element);
+}
+
+Status ArenaShuffleBuffer::Extract(size_t slot, std::vector<Tensor>* element) {
+  TF_RETURN_IF_ERROR(Get(slot, element));
+  Release(&entries_[slot]);
+  return OkStatus();
+}
+
+void ArenaShuffleBuffer::Swap(size_t slot, size_t other) {
+  std::swap(entries_[slot], entries_[other]);
+}
+
+bool ArenaShuffleBuffer::Contains(size_t slot) const {
+  return slot < entries_.size() && entries_[slot].block >= 0;
+}
+
+Status ArenaShuffleBuffer::Append(const std::string& serialized, Entry* entry) {
+  if (open_block_ < 0 ||
+      blocks_[open_block_].written_bytes + serialized.size() >
+          blocks_[open_block_].data.size()) {
+    // Seal the open block, releasing the unused tail of its storage.
+    if (open_block_ >= 0) {
+      blocks_[open_block_].data.resize(blocks_[open_block_].written_bytes);
+      open_block_ = -1;
+      TF_RETURN_IF_ERROR(MaybeSpillBlocks());
+    }
+    blocks_.emplace_back();
+    open_block_ = blocks_.size() - 1;
+    // Records larger than the block size get a dedicated block.
+    blocks_[open_block_].data.resize(
+        std::max(block_bytes_, serialized.size()));
+  }
+  Block& block = blocks_[open_block_];
+  std::memcpy(&block.data[block.written_bytes], serialized.data(),
+              serialized.size());
+  entry->block = open_block_;
+  entry->offset = block.written_bytes;
+  entry->size = serialized.size();
+  block.written_bytes += serialized.size();
+  block.live_bytes += serialized.size();
+  return OkStatus();
+}
+
+void ArenaShuffleBuffer::Release(Entry* entry) {
+  if (entry->block < 0) {
+    return;
+  }
+  Block& block = blocks_[entry->block];
+  block.live_bytes -= entry->size;
+  if (entry->block != open_block_ && block.live_bytes == 0) {
+    // All bytes in the block are dead; release its storage.
+    std::string().swap(block.data);
+    block.spilled = false;
+    if (!block.file.empty()) {
+      env_->DeleteFile(block.file).IgnoreError();
+      block.file.clear();
+    }
+  }
+  *entry = Entry();
+}
+
+Status ArenaShuffleBuffer::ReadEntry(const Entry& entry,
+                                     std::string* serialized) const {
+  Block& block = blocks_[entry.block];
+  if (block.spilled) {
+    // Read the block back into memory. `MaybeSpillBlocks` may spill this or
+    // another block again, so copy the record out before rebalancing.
+    TF_RETURN_IF_ERROR(ReadFileToString(env_, block.file, &block.data));
+    block.spilled = false;
+    serialized->assign(block.data.data() + entry.offset, entry.size);
+    return const_cast<ArenaShuffleBuffer*>(this)->MaybeSpillBlocks();
+  }
+  serialized->assign(block.data.data() + entry.offset, entry.size);
+  return OkStatus();
+}
+
+Status ArenaShuffleBuffer::MaybeSpillBlocks() {
+  if (env_ == nullptr) {
+    return OkStatus();
+  }
+  size_t num_resident = 0;
+  for (int64_t i = 0; i < static_cast<int64_t>(blocks_.size()); ++i) {
+    if (i != open_block_ && !blocks_[i].data.empty()) {
+      ++num_resident;
+    }
+  }
+  // Spill sealed blocks in the order they were written; for a shuffle window,
+  // the oldest blocks hold the elements least likely to be accessed soon.
+  for (int64_t i = 0;
+       num_resident > max_resident_blocks_ &&
+       i < static_cast<int64_t>(blocks_.size());
+       ++i) {
+    if (i == open_block_ || blocks_[i].data.empty()) {
+      continue;
+    }
+    Block& block = blocks_[i];
+    if (block.file.empty()) {
+      block.file = io::JoinPath(
+          spill_directory_,
+          strings::StrCat("arena_block_", spill_file_id_, "_", i));
+      TF_RETURN_IF_ERROR(WriteStringToFile(env_, block.file, block.data));
+    }
+    std::string().swap(block.data);
+    block.spilled = true;
+    --num_resident;
+  }
+  return OkStatus();
+}
+
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,128 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_ARENA_SHUFFLE_BUFFER_H_
+#define TENSORFLOW_CORE_DATA_ARENA_SHUFFLE_BUFFER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/status.h"
+
+namespace tensorflow {
+namespace data {
+
+// A slot-addressed buffer of dataset elements which stores the elements in
+// serialized form inside large contiguous arena blocks.
+//
+// Each slot holds at most one element and is represented by a small handle
+// pointing into a block, so moving elements between slots only moves handles.
+// This avoids the per-element allocation churn of buffering
+// `std::vector<Tensor>` objects directly, which matters for large shuffle
+// buffers where millions of small elements fragment the heap.
+//
+// Blocks are append-only: overwriting or extracting an element marks its bytes
+// as dead, and a block's storage is released once all of its bytes are dead.
+// Optionally, sealed blocks beyond a resident limit are spilled to local disk
+// and read back on access.
+//
+// This class is not thread-safe.
+class ArenaShuffleBuffer {
+ public:
+  // Creates a buffer with `num_slots` element slots, allocating arena blocks
+  // of `block_bytes` bytes each.
+  ArenaShuffleBuffer(size_t num_slots, size_t block_bytes);
+  ~ArenaShuffleBuffer();
+
+  ArenaShuffleBuffer(const ArenaShuffleBuffer&) = delete;
+  ArenaShuffleBuffer& operator=(const ArenaShuffleBuffer&) = delete;
+
+  // Enables spilling of sealed blocks to files under `directory` whenever more
+  // than `max_resident_blocks` full blocks are held in memory. Spilled blocks
+  // are transparently read back when one of their elements is accessed.
+  Status EnableSpilling(Env* env, const std::string& directory,
+                        size_t max_resident_blocks);
+
+  // Serializes `element` into the arena and stores it in `slot`, replacing the
+  // slot's previous element, if any.
+  Status Put(size_t slot, const std::vector<Tensor>& element);
+
+  // Reads the element stored in `slot` without removing it. Returns a NotFound
+  // error if the slot is empty.
+  Status Get(size_t slot, std::vector<Tensor>* element) const;
+
+  // Reads the element stored in `slot` and empties the slot. Returns a
+  // NotFound error if the slot is empty.
+  Status Extract(size_t slot, std::vector<Tensor>* element);
+
+  // Exchanges the contents of `slot` and `other`. Only the slot handles are
+  // swapped; no element data is moved.
+  void Swap(size_t slot, size_t other);
+
+  // Returns true if `slot` holds an element.
+  bool Contains(size_t slot) const;
+
+  size_t num_slots() const { return entries_.size(); }
+
+ private:
+  // Handle of a serialized element within the arena.
+  struct Entry {
+    int64_t block = -1;  // Index into `blocks_`, or -1 if the slot is empty.
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  struct Block {
+    std::string data;          // Resident bytes; empty if spilled or freed.
+    size_t written_bytes = 0;  // Append cursor; blocks are append-only.
+    size_t live_bytes = 0;     // Bytes referenced by live entries.
+    bool spilled = false;
+    std::string file;  // Path of the spill file, if `spilled`.
+  };
+
+  // Appends `serialized` to the open block, allocating a new block if needed,
+  // and fills in `entry` with its location.
+  Status Append(const std::string& serialized, Entry* entry);
+
+  // Marks the bytes of `entry` as dead and releases the storage of its block
+  // if no live bytes remain.
+  void Release(Entry* entry);
+
+  // Copies the bytes of `entry` into `serialized`, reading its block back from
+  // disk if it has been spilled.
+  Status ReadEntry(const Entry& entry, std::string* serialized) const;
+
+  // Spills the oldest resident sealed blocks until at most
+  // `max_resident_blocks_` of them remain in memory.
+  Status MaybeSpillBlocks();
+
+  const size_t block_bytes_;
+  std::vector<Entry> entries_;
+  mutable std::vector<Block> blocks_;
+  int64_t open_block_ = -1;
+
+  // Spilling configuration; spilling is enabled iff `env_` is non-null.
+  Env* env_ = nullptr;
+  std::string spill_directory_;
+  size_t max_resident_blocks_ = 0;
+  uint64_t spill_file_id_ = 0;
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_ARENA_SHUFFLE_BUFFER_H_
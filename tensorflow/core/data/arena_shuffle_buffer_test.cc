@@ -0,0 +1,131 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/arena_shuffle_buffer.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/error_codes.pb.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+std::vector<Tensor> TestElement(int64_t value) {
+  Tensor number(DT_INT64, TensorShape({}));
+  number.scalar<int64_t>()() = value;
+  Tensor text(DT_STRING, TensorShape({}));
+  text.scalar<tstring>()() = strings::StrCat("element_", value);
+  return {number, text};
+}
+
+void ExpectElementEquals(const std::vector<Tensor>& element, int64_t value) {
+  ASSERT_EQ(element.size(), 2);
+  EXPECT_EQ(element[0].scalar<int64_t>()(), value);
+  EXPECT_EQ(element[1].scalar<tstring>()(),
+            strings::StrCat("element_", value));
+}
+
+TEST(ArenaShuffleBufferTest, PutGetRoundTrip) {
+  ArenaShuffleBuffer buffer(/*num_slots=*/10, /*block_bytes=*/1024);
+  for (int64_t i = 0; i < 10; ++i) {
+    TF_ASSERT_OK(buffer.Put(i, TestElement(i)));
+  }
+  for (int64_t i = 0; i < 10; ++i) {
+    std::vector<Tensor> element;
+    TF_ASSERT_OK(buffer.Get(i, &element));
+    ExpectElementEquals(element, i);
+  }
+}
+
+TEST(ArenaShuffleBufferTest, OverwriteSlot) {
+  ArenaShuffleBuffer buffer(/*num_slots=*/1, /*block_bytes=*/64);
+  TF_ASSERT_OK(buffer.Put(0, TestElement(1)));
+  TF_ASSERT_OK(buffer.Put(0, TestElement(2)));
+  std::vector<Tensor> element;
+  TF_ASSERT_OK(buffer.Get(0, &element));
+  ExpectElementEquals(element, 2);
+}
+
+TEST(ArenaShuffleBufferTest, ExtractEmptiesSlot) {
+  ArenaShuffleBuffer buffer(/*num_slots=*/1, /*block_bytes=*/1024);
+  TF_ASSERT_OK(buffer.Put(0, TestElement(7)));
+  EXPECT_TRUE(buffer.Contains(0));
+  std::vector<Tensor> element;
+  TF_ASSERT_OK(buffer.Extract(0, &element));
+  ExpectElementEquals(element, 7);
+  EXPECT_FALSE(buffer.Contains(0));
+  EXPECT_EQ(error::NOT_FOUND, buffer.Get(0, &element).code());
+}
+
+TEST(ArenaShuffleBufferTest, SwapMovesHandles) {
+  ArenaShuffleBuffer buffer(/*num_slots=*/3, /*block_bytes=*/1024);
+  TF_ASSERT_OK(buffer.Put(0, TestElement(1)));
+  TF_ASSERT_OK(buffer.Put(1, TestElement(2)));
+  buffer.Swap(0, 1);
+  std::vector<Tensor> element;
+  TF_ASSERT_OK(buffer.Get(0, &element));
+  ExpectElementEquals(element, 2);
+  TF_ASSERT_OK(buffer.Get(1, &element));
+  ExpectElementEquals(element, 1);
+  // Swapping with an empty slot moves the element.
+  buffer.Swap(0, 2);
+  EXPECT_FALSE(buffer.Contains(0));
+  TF_ASSERT_OK(buffer.Get(2, &element));
+  ExpectElementEquals(element, 2);
+}
+
+TEST(ArenaShuffleBufferTest, OutOfRangeSlot) {
+  ArenaShuffleBuffer buffer(/*num_slots=*/1, /*block_bytes=*/1024);
+  EXPECT_EQ(error::INVALID_ARGUMENT, buffer.Put(1, TestElement(0)).code());
+}
+
+TEST(ArenaShuffleBufferTest, SpillAndReadBack) {
+  // Use tiny blocks so that many blocks are created and spilled.
+  ArenaShuffleBuffer buffer(/*num_slots=*/100, /*block_bytes=*/128);
+  std::string spill_dir = io::JoinPath(
+      testing::TmpDir(), strings::StrCat("arena_spill_", random::New64()));
+  TF_ASSERT_OK(buffer.EnableSpilling(Env::Default(), spill_dir,
+                                     /*max_resident_blocks=*/1));
+  for (int64_t i = 0; i < 100; ++i) {
+    TF_ASSERT_OK(buffer.Put(i, TestElement(i)));
+  }
+  for (int64_t i = 0; i < 100; ++i) {
+    std::vector<Tensor> element;
+    TF_ASSERT_OK(buffer.Get(i, &element));
+    ExpectElementEquals(element, i);
+  }
+  // Extracting all elements deletes the spill files.
+  for (int64_t i = 0; i < 100; ++i) {
+    std::vector<Tensor> element;
+    TF_ASSERT_OK(buffer.Extract(i, &element));
+  }
+  std::vector<std::string> children;
+  TF_ASSERT_OK(Env::Default()->GetChildren(spill_dir, &children));
+  EXPECT_TRUE(children.empty());
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -225,6 +225,45 @@ Status CreateShortCircuitInfo(OpKernelConstruction* ctx,
   return OkStatus();
 }
 
+// Maximum number of ops in a function eligible for inline execution on the
+// calling thread.
+constexpr int kInlineExecutionMaxOps = 8;
+
+// Returns whether `fdef` is a small straight-line function consisting solely
+// of stateless primitive ops, making it cheap enough that executor dispatch
+// overhead would dominate its useful work. Such functions are executed inline
+// on the calling thread using the single-threaded executor.
+bool IsCheapInlineFunction(const FunctionLibraryDefinition& lib_def,
+                           const FunctionDef& fdef) {
+  if (fdef.node_def_size() > kInlineExecutionMaxOps) {
+    return false;
+  }
+  for (const auto& node : fdef.node_def()) {
+    // Nested function calls and control flow may suspend execution and can be
+    // backed by asynchronous kernels, neither of which the single-threaded
+    // executor supports.
+    if (lib_def.Find(node.op()) != nullptr) {
+      return false;
+    }
+    for (const auto& attr : node.attr()) {
+      if (attr.second.has_func() || attr.second.list().func_size() > 0) {
+        return false;
+      }
+    }
+    // Internal ops (e.g. `_Send` and `_Recv`) may communicate across devices
+    // and execute asynchronously.
+    if (node.op().empty() || node.op()[0] == '_') {
+      return false;
+    }
+    const OpDef* op_def;
+    Status s = lib_def.LookUpOpDef(node.op(), &op_def);
+    if (!s.ok() || op_def->is_stateful()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Status CreateFunctionLibraryDefinition(
     const FunctionLibraryDefinition* lib_def, const string& func_name,
     std::unique_ptr<FunctionLibraryDefinition>* result) {
@@ -549,6 +588,16 @@ Status CapturedFunction::Instantiate(
   } else {
     if (!metadata_->use_inter_op_parallelism()) {
       inst_opts.executor_type = "SINGLE_THREADED_EXECUTOR";
+    } else {
+      // Trivial functions (e.g. a map function applying a couple of stateless
+      // ops) pay more for executor setup than for the work itself, so run
+      // them inline on the calling thread instead.
+      const FunctionDef* fdef;
+      Status s = LookupFunction(*metadata_->lib_def(),
+                                metadata_->func().name(), &fdef);
+      if (s.ok() && IsCheapInlineFunction(*metadata_->lib_def(), *fdef)) {
+        inst_opts.executor_type = "SINGLE_THREADED_EXECUTOR";
+      }
     }
   }
   inst_opts.is_multi_device_function = metadata_->use_multi_device_function();
@@ -16,10 +16,13 @@ limitations under the License.
 
 #include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/lib/core/coding.h"
 #include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/types.h"
 
@@ -169,5 +172,290 @@ Status UncompressElement(const CompressedElement& compressed,
   return OkStatus();
 }
 
+namespace {
+
+CompressedColumn::Encoding ColumnEncoding(DataType dtype) {
+  if (dtype == DT_INT64) {
+    return CompressedColumn::DELTA_INT64;
+  }
+  if (dtype == DT_STRING) {
+    return CompressedColumn::STRING_DICTIONARY;
+  }
+  if (DataTypeCanUseMemcpy(dtype)) {
+    return CompressedColumn::PLAIN;
+  }
+  return CompressedColumn::TENSOR_PROTO;
+}
+
+// Encodes the component at `component_index` of every element into `encoded`,
+// using the layout described in `CompressedColumn::Encoding`.
+Status EncodeColumn(const std::vector<std::vector<Tensor>>& elements,
+                    int component_index, CompressedColumn::Encoding encoding,
+                    tstring* encoded) {
+  switch (encoding) {
+    case CompressedColumn::PLAIN:
+    case CompressedColumn::DELTA_INT64: {
+      for (const std::vector<Tensor>& element : elements) {
+        StringPiece data = element[component_index].tensor_data();
+        encoded->append(data.data(), data.size());
+      }
+      if (encoding == CompressedColumn::DELTA_INT64) {
+        int64_t* values = reinterpret_cast<int64_t*>(encoded->mdata());
+        for (size_t i = encoded->size() / sizeof(int64_t); i > 1; --i) {
+          values[i - 1] -= values[i - 2];
+        }
+      }
+      break;
+    }
+    case CompressedColumn::STRING_DICTIONARY: {
+      // Unique strings in order of first occurrence, then one dictionary
+      // index per value.
+      std::vector<tstring> dictionary;
+      absl::flat_hash_map<tstring, uint64> dictionary_indices;
+      std::vector<uint64> indices;
+      for (const std::vector<Tensor>& element : elements) {
+        const auto& values = element[component_index].flat<tstring>();
+        for (int i = 0; i < values.size(); ++i) {
+          auto inserted = dictionary_indices.insert(
+              {values(i), dictionary_indices.size()});
+          if (inserted.second) {
+            dictionary.push_back(values(i));
+          }
+          indices.push_back(inserted.first->second);
+        }
+      }
+      core::PutVarint64(encoded, dictionary.size());
+      for (const tstring& value : dictionary) {
+        core::PutVarint64(encoded, value.size());
+        encoded->append(value.data(), value.size());
+      }
+      for (uint64 index : indices) {
+        core::PutVarint64(encoded, index);
+      }
+      break;
+    }
+    case CompressedColumn::TENSOR_PROTO: {
+      for (const std::vector<Tensor>& element : elements) {
+        TensorProto proto;
+        element[component_index].AsProtoTensorContent(&proto);
+        std::string serialized;
+        if (!proto.SerializeToString(&serialized)) {
+          return errors::Internal("Failed to serialize TensorProto.");
+        }
+        core::PutVarint64(encoded, serialized.size());
+        encoded->append(serialized);
+      }
+      break;
+    }
+    default:
+      return errors::Internal("Unrecognized column encoding: ", encoding);
+  }
+  return OkStatus();
+}
+
+// Decodes one column into the component at `component_index` of the elements
+// in `out`, which has already been sized to hold the batch. May modify
+// `encoded` in place while decoding.
+Status DecodeColumn(const CompressedColumn& column, tstring* encoded,
+                    int component_index,
+                    std::vector<std::vector<Tensor>>* out) {
+  const DataType dtype = column.dtype();
+  switch (column.encoding()) {
+    case CompressedColumn::PLAIN:
+    case CompressedColumn::DELTA_INT64: {
+      if (column.encoding() == CompressedColumn::DELTA_INT64) {
+        if (dtype != DT_INT64 || encoded->size() % sizeof(int64_t) != 0) {
+          return errors::Internal("Malformed delta-encoded column.");
+        }
+        int64_t* values = reinterpret_cast<int64_t*>(encoded->mdata());
+        for (size_t i = 1; i < encoded->size() / sizeof(int64_t); ++i) {
+          values[i] += values[i - 1];
+        }
+      } else if (!DataTypeCanUseMemcpy(dtype)) {
+        return errors::Internal("Plain-encoded column with dtype ",
+                                DataTypeString(dtype),
+                                " which has no flat byte representation.");
+      }
+      size_t pos = 0;
+      for (size_t i = 0; i < out->size(); ++i) {
+        Tensor tensor(dtype, column.tensor_shape(i));
+        TensorBuffer* buffer = DMAHelper::buffer(&tensor);
+        const size_t size = buffer ? buffer->size() : 0;
+        if (pos + size > encoded->size()) {
+          return errors::Internal(
+              "Column data is shorter than its tensor shapes suggest.");
+        }
+        if (buffer) {
+          memcpy(buffer->data(), encoded->data() + pos, size);
+        }
+        pos += size;
+        (*out)[i][component_index] = std::move(tensor);
+      }
+      if (pos != encoded->size()) {
+        return errors::Internal(
+            "Column data is longer than its tensor shapes suggest.");
+      }
+      break;
+    }
+    case CompressedColumn::STRING_DICTIONARY: {
+      if (dtype != DT_STRING) {
+        return errors::Internal("Dictionary-encoded column with dtype ",
+                                DataTypeString(dtype), ".");
+      }
+      StringPiece input(encoded->data(), encoded->size());
+      uint64 dictionary_size;
+      if (!core::GetVarint64(&input, &dictionary_size) ||
+          dictionary_size > input.size()) {
+        return errors::Internal("Malformed string dictionary.");
+      }
+      std::vector<tstring> dictionary;
+      dictionary.reserve(dictionary_size);
+      for (uint64 i = 0; i < dictionary_size; ++i) {
+        uint64 size;
+        if (!core::GetVarint64(&input, &size) || size > input.size()) {
+          return errors::Internal("Malformed string dictionary entry.");
+        }
+        dictionary.emplace_back(input.data(), size);
+        input.remove_prefix(size);
+      }
+      for (size_t i = 0; i < out->size(); ++i) {
+        Tensor tensor(DT_STRING, column.tensor_shape(i));
+        auto values = tensor.flat<tstring>();
+        for (int j = 0; j < values.size(); ++j) {
+          uint64 index;
+          if (!core::GetVarint64(&input, &index) ||
+              index >= dictionary.size()) {
+            return errors::Internal("Malformed string dictionary index.");
+          }
+          values(j) = dictionary[index];
+        }
+        (*out)[i][component_index] = std::move(tensor);
+      }
+      break;
+    }
+    case CompressedColumn::TENSOR_PROTO: {
+      StringPiece input(encoded->data(), encoded->size());
+      for (size_t i = 0; i < out->size(); ++i) {
+        uint64 size;
+        if (!core::GetVarint64(&input, &size) || size > input.size()) {
+          return errors::Internal("Malformed serialized tensor column.");
+        }
+        TensorProto proto;
+        if (!proto.ParseFromArray(input.data(), size)) {
+          return errors::Internal("Could not parse TensorProto");
+        }
+        input.remove_prefix(size);
+        Tensor tensor;
+        if (!tensor.FromProto(proto)) {
+          return errors::Internal("Could not parse Tensor");
+        }
+        (*out)[i][component_index] = std::move(tensor);
+      }
+      break;
+    }
+    default:
+      return errors::Internal("Unrecognized column encoding: ",
+                              column.encoding());
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status CompressElementBatch(const std::vector<std::vector<Tensor>>& elements,
+                            CompressedElementBatch* out) {
+  if (elements.empty()) {
+    return errors::InvalidArgument("Cannot compress an empty batch.");
+  }
+  const size_t num_components = elements.front().size();
+  for (const std::vector<Tensor>& element : elements) {
+    if (element.size() != num_components) {
+      return errors::InvalidArgument(
+          "All elements in a batch must have the same number of components; "
+          "got both ",
+          num_components, " and ", element.size(), ".");
+    }
+    for (size_t i = 0; i < num_components; ++i) {
+      if (element[i].dtype() != elements.front()[i].dtype()) {
+        return errors::InvalidArgument(
+            "Component ", i, " has mismatched dtypes across the batch: ",
+            DataTypeString(elements.front()[i].dtype()), " vs. ",
+            DataTypeString(element[i].dtype()), ".");
+      }
+    }
+  }
+  out->set_num_elements(elements.size());
+  for (size_t i = 0; i < num_components; ++i) {
+    CompressedColumn* column = out->add_columns();
+    const DataType dtype = elements.front()[i].dtype();
+    const CompressedColumn::Encoding encoding = ColumnEncoding(dtype);
+    column->set_dtype(dtype);
+    column->set_encoding(encoding);
+    for (const std::vector<Tensor>& element : elements) {
+      element[i].shape().AsProto(column->add_tensor_shape());
+    }
+    tstring encoded;
+    TF_RETURN_IF_ERROR(EncodeColumn(elements, i, encoding, &encoded));
+    if (encoded.size() > kuint32max) {
+      return errors::OutOfRange("Encountered a column of size ",
+                                encoded.size(),
+                                ", exceeding the 4GB Snappy limit.");
+    }
+    column->set_uncompressed_bytes(encoded.size());
+    if (!port::Snappy_Compress(encoded.data(), encoded.size(),
+                               column->mutable_data())) {
+      return errors::Internal("Failed to compress using snappy.");
+    }
+    VLOG(3) << "Compressed column " << i << " from " << encoded.size()
+            << " bytes to " << column->data().size() << " bytes";
+  }
+  return OkStatus();
+}
+
+Status UncompressElementBatch(const CompressedElementBatch& compressed,
+                              std::vector<std::vector<Tensor>>* out) {
+  const int64_t num_elements = compressed.num_elements();
+  if (num_elements < 0) {
+    return errors::Internal("Invalid batch size: ", num_elements);
+  }
+  out->clear();
+  out->resize(num_elements);
+  for (std::vector<Tensor>& element : *out) {
+    element.resize(compressed.columns_size());
+  }
+  for (int i = 0; i < compressed.columns_size(); ++i) {
+    const CompressedColumn& column = compressed.columns(i);
+    if (column.tensor_shape_size() != num_elements) {
+      return errors::Internal("Column ", i, " stores ",
+                              column.tensor_shape_size(),
+                              " tensors, but the batch has ", num_elements,
+                              " elements.");
+    }
+    size_t uncompressed_size;
+    if (!port::Snappy_GetUncompressedLength(column.data().data(),
+                                            column.data().size(),
+                                            &uncompressed_size)) {
+      return errors::Internal(
+          "Could not get snappy uncompressed length. Compressed data size: ",
+          column.data().size());
+    }
+    if (uncompressed_size !=
+        static_cast<size_t>(column.uncompressed_bytes())) {
+      return errors::Internal(
+          "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
+          " whereas the column metadata suggests ",
+          column.uncompressed_bytes());
+    }
+    tstring encoded;
+    encoded.resize_uninitialized(uncompressed_size);
+    if (!port::Snappy_Uncompress(column.data().data(), column.data().size(),
+                                 encoded.mdata())) {
+      return errors::Internal("Failed to perform snappy decompression.");
+    }
+    TF_RETURN_IF_ERROR(DecodeColumn(column, &encoded, i, out));
+  }
+  return OkStatus();
+}
+
 }  // namespace data
 }  // namespace tensorflow
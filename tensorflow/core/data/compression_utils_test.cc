@@ -50,6 +50,73 @@ TEST_P(ParameterizedCompressionUtilsTest, RoundTrip) {
       ExpectEqual(element, round_trip_element, /*compare_order=*/true));
 }
 
+TEST_P(ParameterizedCompressionUtilsTest, BatchRoundTrip) {
+  // Compress a batch of three copies of the element column-major.
+  std::vector<std::vector<Tensor>> elements(3, GetParam());
+  CompressedElementBatch compressed;
+  TF_ASSERT_OK(CompressElementBatch(elements, &compressed));
+  std::vector<std::vector<Tensor>> round_trip_elements;
+  TF_ASSERT_OK(UncompressElementBatch(compressed, &round_trip_elements));
+  ASSERT_EQ(round_trip_elements.size(), elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    TF_EXPECT_OK(ExpectEqual(elements[i], round_trip_elements[i],
+                             /*compare_order=*/true));
+  }
+}
+
+TEST(CompressionUtilsTest, BatchWithVariedShapesAndValues) {
+  std::vector<std::vector<Tensor>> elements = {
+      {CreateTensor<int64_t>(TensorShape{3}, {10, 11, 12}),
+       CreateTensor<tstring>(TensorShape{2}, {"hello", "world"}),
+       CreateTensor<float>(TensorShape{2, 2}, {1.0, 2.0, 3.0, 4.0})},
+      {CreateTensor<int64_t>(TensorShape{1}, {13}),
+       CreateTensor<tstring>(TensorShape{3}, {"world", "hello", "hello"}),
+       CreateTensor<float>(TensorShape{1, 2}, {5.0, 6.0})},
+  };
+  CompressedElementBatch compressed;
+  TF_ASSERT_OK(CompressElementBatch(elements, &compressed));
+  EXPECT_EQ(compressed.num_elements(), 2);
+  ASSERT_EQ(compressed.columns_size(), 3);
+  EXPECT_EQ(compressed.columns(0).encoding(), CompressedColumn::DELTA_INT64);
+  EXPECT_EQ(compressed.columns(1).encoding(),
+            CompressedColumn::STRING_DICTIONARY);
+  EXPECT_EQ(compressed.columns(2).encoding(), CompressedColumn::PLAIN);
+  std::vector<std::vector<Tensor>> round_trip_elements;
+  TF_ASSERT_OK(UncompressElementBatch(compressed, &round_trip_elements));
+  ASSERT_EQ(round_trip_elements.size(), elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    TF_EXPECT_OK(DatasetOpsTestBase::ExpectEqual(
+        elements[i], round_trip_elements[i], /*compare_order=*/true));
+  }
+}
+
+TEST(CompressionUtilsTest, BatchMismatchedArity) {
+  std::vector<std::vector<Tensor>> elements = {
+      CreateTensors<int64_t>(TensorShape{1}, {{1}, {2}}),
+      CreateTensors<int64_t>(TensorShape{1}, {{3}}),
+  };
+  CompressedElementBatch compressed;
+  EXPECT_THAT(CompressElementBatch(elements, &compressed),
+              StatusIs(error::INVALID_ARGUMENT,
+                       HasSubstr("same number of components")));
+}
+
+TEST(CompressionUtilsTest, BatchMismatchedDtypes) {
+  std::vector<std::vector<Tensor>> elements = {
+      {CreateTensor<int64_t>(TensorShape{1}, {1})},
+      {CreateTensor<tstring>(TensorShape{1}, {"a"})},
+  };
+  CompressedElementBatch compressed;
+  EXPECT_THAT(CompressElementBatch(elements, &compressed),
+              StatusIs(error::INVALID_ARGUMENT, HasSubstr("mismatched")));
+}
+
+TEST(CompressionUtilsTest, EmptyBatch) {
+  CompressedElementBatch compressed;
+  EXPECT_THAT(CompressElementBatch({}, &compressed),
+              StatusIs(error::INVALID_ARGUMENT, HasSubstr("empty batch")));
+}
+
 std::vector<std::vector<Tensor>> TestCases() {
   return {
       CreateTensors<int64_t>(TensorShape{1}, {{1}}),           // int64
@@ -0,0 +1,169 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/element_arena_allocator.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr char kName[] = "element_arena";
+
+// Blocks smaller than this defeat the purpose of batching allocations.
+constexpr size_t kMinBlockBytes = 4096;
+
+// Rounds `x` up to a multiple of `alignment`, which must be a power of two.
+size_t RoundUp(size_t x, size_t alignment) {
+  return (x + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+// static
+Allocator* ElementArenaAllocator::Wrap(Allocator* base, size_t block_bytes) {
+  static mutex* mu = new mutex;
+  static auto* arenas = new std::map<Allocator*, ElementArenaAllocator*>;
+  if (base == nullptr || base->Name() == kName) {
+    return base;
+  }
+  mutex_lock l(*mu);
+  ElementArenaAllocator*& arena = (*arenas)[base];
+  if (arena == nullptr) {
+    arena = new ElementArenaAllocator(base, block_bytes);
+  }
+  return arena;
+}
+
+ElementArenaAllocator::ElementArenaAllocator(Allocator* base,
+                                             size_t block_bytes)
+    : base_(base), block_bytes_(std::max(block_bytes, kMinBlockBytes)) {}
+
+ElementArenaAllocator::~ElementArenaAllocator() {
+  mutex_lock l(mu_);
+  for (auto& block : blocks_) {
+    base_->DeallocateRaw(block->data);
+  }
+}
+
+std::string ElementArenaAllocator::Name() { return kName; }
+
+void* ElementArenaAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  const size_t data_alignment = std::max(alignment, kAllocatorAlignment);
+  if (num_bytes == 0 || num_bytes > block_bytes_ / 2 ||
+      data_alignment > block_bytes_ / 2) {
+    return AllocateFromBase(alignment, num_bytes);
+  }
+  mutex_lock l(mu_);
+  // The data pointer must leave room for a `Header` in front of it; rounding
+  // `offset + data_alignment` up keeps at least `data_alignment` (>= 64)
+  // bytes between the previous allocation and the data pointer.
+  if (current_ != nullptr) {
+    const size_t data_offset =
+        RoundUp(current_->offset + data_alignment, data_alignment);
+    if (data_offset + num_bytes > current_->size) {
+      SealCurrentBlock();
+    }
+  }
+  if (current_ == nullptr) {
+    if (!free_blocks_.empty()) {
+      current_ = free_blocks_.back();
+      free_blocks_.pop_back();
+      current_->offset = 0;
+      current_->sealed = false;
+      current_->in_free_list = false;
+    } else {
+      char* data = static_cast<char*>(
+          base_->AllocateRaw(kAllocatorAlignment, block_bytes_));
+      if (data == nullptr) {
+        return nullptr;
+      }
+      auto block = std::make_unique<Block>();
+      block->data = data;
+      block->size = block_bytes_;
+      current_ = block.get();
+      blocks_.push_back(std::move(block));
+    }
+  }
+  const size_t data_offset =
+      RoundUp(current_->offset + data_alignment, data_alignment);
+  char* data = current_->data + data_offset;
+  Header header{current_, nullptr};
+  memcpy(data - sizeof(Header), &header, sizeof(Header));
+  current_->offset = data_offset + num_bytes;
+  current_->outstanding.fetch_add(1, std::memory_order_relaxed);
+  return data;
+}
+
+void ElementArenaAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  Header header;
+  memcpy(&header, static_cast<char*>(ptr) - sizeof(Header), sizeof(Header));
+  if (header.block == nullptr) {
+    base_->DeallocateRaw(header.base_ptr);
+    return;
+  }
+  if (header.block->outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    RecycleBlock(header.block);
+  }
+}
+
+void* ElementArenaAllocator::AllocateFromBase(size_t alignment,
+                                              size_t num_bytes) {
+  // `header_space` is a multiple of `alignment`, so the data pointer keeps
+  // the requested alignment and leaves room for the header in front.
+  const size_t data_alignment = std::max(alignment, kAllocatorAlignment);
+  const size_t header_space = std::max(data_alignment, sizeof(Header));
+  void* base_ptr = base_->AllocateRaw(data_alignment, header_space + num_bytes);
+  if (base_ptr == nullptr) {
+    return nullptr;
+  }
+  char* data = static_cast<char*>(base_ptr) + header_space;
+  Header header{nullptr, base_ptr};
+  memcpy(data - sizeof(Header), &header, sizeof(Header));
+  return data;
+}
+
+void ElementArenaAllocator::RecycleBlock(Block* block) {
+  mutex_lock l(mu_);
+  // A racing allocation can only target the current block, which is never
+  // sealed, so a sealed block with no outstanding allocations is quiescent.
+  if (!block->sealed || block->in_free_list ||
+      block->outstanding.load(std::memory_order_acquire) != 0) {
+    return;
+  }
+  block->offset = 0;
+  block->in_free_list = true;
+  free_blocks_.push_back(block);
+}
+
+void ElementArenaAllocator::SealCurrentBlock() {
+  current_->sealed = true;
+  if (current_->outstanding.load(std::memory_order_acquire) == 0) {
+    current_->offset = 0;
+    current_->in_free_list = true;
+    free_blocks_.push_back(current_);
+  }
+  current_ = nullptr;
+}
+
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,123 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_ELEMENT_ARENA_ALLOCATOR_H_
+#define TENSORFLOW_CORE_DATA_ELEMENT_ARENA_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+namespace data {
+
+// An `Allocator` with region semantics for tf.data element tensors.
+//
+// Allocations are carved out of large blocks obtained from a base allocator
+// using a bump pointer. Each block tracks the number of outstanding
+// allocations; when the last allocation of a sealed block is freed, the whole
+// block is recycled for reuse instead of being returned to the base allocator.
+// In the steady state neither the producer-side allocation nor the
+// consumer-side release touches the base allocator, which eliminates the
+// cross-thread lock traffic of per-tensor malloc/free pairs between pipeline
+// stages.
+//
+// Allocations larger than half a block are forwarded to the base allocator.
+//
+// Instances returned by `Wrap` have process lifetime, so tensor buffers may
+// safely outlive the iterator that allocated them.
+//
+// This class is thread-safe.
+class ElementArenaAllocator : public Allocator {
+ public:
+  // Returns a process-lifetime arena allocator that draws blocks of
+  // `block_bytes` from `base`, creating it on first use. `base` must outlive
+  // the process. Returns `base` unchanged if it is already an arena.
+  static Allocator* Wrap(Allocator* base, size_t block_bytes);
+
+  std::string Name() override;
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+
+  void DeallocateRaw(void* ptr) override;
+
+  AllocatorMemoryType GetMemoryType() const override {
+    return base_->GetMemoryType();
+  }
+
+ private:
+  struct Block {
+    char* data = nullptr;
+    size_t size = 0;
+    // Bump offset of the next allocation. Only mutated while the block is
+    // current, under the arena mutex.
+    size_t offset = 0;
+    // Number of allocations carved from this block that have not been freed.
+    std::atomic<int64_t> outstanding{0};
+    // True once the block stopped accepting new allocations. Guarded by the
+    // arena mutex.
+    bool sealed = false;
+    // True while the block is parked on `free_blocks_`. Guarded by the arena
+    // mutex.
+    bool in_free_list = false;
+  };
+
+  // Placed immediately before every pointer handed out by the arena. `block`
+  // is null for allocations forwarded to the base allocator, in which case
+  // `base_ptr` holds the pointer to return to it.
+  struct Header {
+    Block* block;
+    void* base_ptr;
+  };
+
+  ElementArenaAllocator(Allocator* base, size_t block_bytes);
+  ~ElementArenaAllocator() override;
+
+  // Allocates from the base allocator, reserving room for a `Header` in front
+  // of the returned pointer.
+  void* AllocateFromBase(size_t alignment, size_t num_bytes);
+
+  // Parks `block` on the free list if it is sealed and has no outstanding
+  // allocations.
+  void RecycleBlock(Block* block);
+
+  // Seals the current block and parks it on the free list if it is already
+  // empty.
+  void SealCurrentBlock() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Allocator* const base_;
+  const size_t block_bytes_;
+
+  mutex mu_;
+  // All blocks ever created, for ownership.
+  std::vector<std::unique_ptr<Block>> blocks_ TF_GUARDED_BY(mu_);
+  // The block new allocations are carved from. May be null.
+  Block* current_ TF_GUARDED_BY(mu_) = nullptr;
+  // Sealed blocks with no outstanding allocations, ready for reuse.
+  std::vector<Block*> free_blocks_ TF_GUARDED_BY(mu_);
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ElementArenaAllocator);
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_ELEMENT_ARENA_ALLOCATOR_H_
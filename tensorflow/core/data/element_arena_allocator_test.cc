@@ -0,0 +1,118 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/element_arena_allocator.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr size_t kBlockBytes = 1 << 16;
+
+// Counts the calls that reach the base allocator.
+class CountingAllocator : public Allocator {
+ public:
+  string Name() override { return "counting"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    ++num_allocates_;
+    return cpu_allocator()->AllocateRaw(alignment, num_bytes);
+  }
+
+  void DeallocateRaw(void* ptr) override {
+    ++num_deallocates_;
+    cpu_allocator()->DeallocateRaw(ptr);
+  }
+
+  int64_t num_allocates_ = 0;
+  int64_t num_deallocates_ = 0;
+};
+
+TEST(ElementArenaAllocatorTest, WrapReturnsProcessLifetimeSingleton) {
+  static CountingAllocator* base = new CountingAllocator();
+  Allocator* arena = ElementArenaAllocator::Wrap(base, kBlockBytes);
+  ASSERT_NE(arena, nullptr);
+  EXPECT_NE(arena, base);
+  EXPECT_EQ(ElementArenaAllocator::Wrap(base, kBlockBytes), arena);
+  // Wrapping an arena is a no-op.
+  EXPECT_EQ(ElementArenaAllocator::Wrap(arena, kBlockBytes), arena);
+}
+
+TEST(ElementArenaAllocatorTest, AllocationsAreAlignedAndWritable) {
+  static CountingAllocator* base = new CountingAllocator();
+  Allocator* arena = ElementArenaAllocator::Wrap(base, kBlockBytes);
+  std::vector<void*> ptrs;
+  for (size_t num_bytes : {1, 13, 64, 1000, 4096}) {
+    void* ptr = arena->AllocateRaw(Allocator::kAllocatorAlignment, num_bytes);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) %
+                  Allocator::kAllocatorAlignment,
+              0);
+    memset(ptr, 0xab, num_bytes);
+    ptrs.push_back(ptr);
+  }
+  for (void* ptr : ptrs) {
+    arena->DeallocateRaw(ptr);
+  }
+}
+
+TEST(ElementArenaAllocatorTest, RecyclesBlocksInSteadyState) {
+  static CountingAllocator* base = new CountingAllocator();
+  Allocator* arena = ElementArenaAllocator::Wrap(base, kBlockBytes);
+  // Warm up so the arena owns enough blocks for one wave.
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 100; ++i) {
+    ptrs.push_back(arena->AllocateRaw(Allocator::kAllocatorAlignment, 1000));
+  }
+  for (void* ptr : ptrs) {
+    arena->DeallocateRaw(ptr);
+  }
+  const int64_t allocates_after_warmup = base->num_allocates_;
+  for (int wave = 0; wave < 10; ++wave) {
+    ptrs.clear();
+    for (int i = 0; i < 100; ++i) {
+      ptrs.push_back(arena->AllocateRaw(Allocator::kAllocatorAlignment, 1000));
+    }
+    for (void* ptr : ptrs) {
+      arena->DeallocateRaw(ptr);
+    }
+  }
+  // All waves are served from recycled blocks.
+  EXPECT_EQ(base->num_allocates_, allocates_after_warmup);
+}
+
+TEST(ElementArenaAllocatorTest, ForwardsLargeAllocations) {
+  static CountingAllocator* base = new CountingAllocator();
+  Allocator* arena = ElementArenaAllocator::Wrap(base, kBlockBytes);
+  const int64_t allocates_before = base->num_allocates_;
+  void* ptr =
+      arena->AllocateRaw(Allocator::kAllocatorAlignment, kBlockBytes * 2);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(base->num_allocates_, allocates_before + 1);
+  memset(ptr, 0xcd, kBlockBytes * 2);
+  arena->DeallocateRaw(ptr);
+  EXPECT_EQ(base->num_deallocates_, 1);
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,203 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Replays a serialized tf.data pipeline under controlled conditions, without
+// a training job around it.
+//
+// The input is a dataset graph as written by
+// `tensorflow/core/data/serialization_utils.cc` (e.g. via
+// `tf.data.experimental.serialize`), in binary or text proto form.  The tool
+// builds the pipeline with the standalone tf.data runtime, pulls a
+// configurable number of elements, and reports end-to-end throughput plus the
+// per-iterator-node time breakdown collected by the autotuning
+// `model::Model`.
+//
+// Example:
+//
+//   replay_benchmark --dataset_graph=/tmp/pipeline.pb \
+//       --num_elements=10000 --warmup_elements=100 --inter_op_threads=8
+//
+// Pass --model_proto_out to also write the raw ModelProto for offline
+// analysis.  The model breakdown requires autotuning, which is on unless the
+// pipeline's options disable it.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/data/standalone.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/model.h"
+#include "tensorflow/core/framework/model.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+struct Options {
+  string dataset_graph;
+  string model_proto_out;
+  int64_t num_elements = 1000;
+  int64_t warmup_elements = 0;
+  int32_t inter_op_threads = 0;  // 0 means the runtime default.
+  int32_t intra_op_threads = 0;
+};
+
+Status LoadGraph(const string& path, GraphDef* graph_def) {
+  if (str_util::EndsWith(path, ".pbtxt")) {
+    return ReadTextProto(Env::Default(), path, graph_def);
+  }
+  return ReadBinaryProto(Env::Default(), path, graph_def);
+}
+
+// Prints one line per iterator node, children before parents, with the
+// node's total processing time and per-element cost.  Processing time is
+// cumulative per node (it includes time recorded by the node itself, not its
+// inputs), so the rows sum to the pipeline's total CPU time.
+void PrintModelBreakdown(const ModelProto& proto) {
+  std::vector<const ModelProto::Node*> nodes;
+  nodes.reserve(proto.nodes_size());
+  for (const auto& entry : proto.nodes()) {
+    nodes.push_back(&entry.second);
+  }
+  std::sort(nodes.begin(), nodes.end(),
+            [](const ModelProto::Node* a, const ModelProto::Node* b) {
+              if (a->processing_time() != b->processing_time()) {
+                return a->processing_time() > b->processing_time();
+              }
+              return a->name() < b->name();
+            });
+  printf("%-40s %12s %15s %15s\n", "iterator node", "elements",
+         "total time (ms)", "ns per element");
+  for (const ModelProto::Node* node : nodes) {
+    const double total_ms = node->processing_time() / 1.0e6;
+    const double ns_per_element =
+        node->num_elements() > 0
+            ? static_cast<double>(node->processing_time()) /
+                  node->num_elements()
+            : 0.0;
+    printf("%-40s %12lld %15.3f %15.1f\n", node->name().c_str(),
+           static_cast<long long>(node->num_elements()), total_ms,  // NOLINT
+           ns_per_element);
+  }
+}
+
+Status Run(const Options& opts) {
+  GraphDef graph_def;
+  TF_RETURN_IF_ERROR(LoadGraph(opts.dataset_graph, &graph_def));
+
+  standalone::Dataset::Params params;
+  ConfigProto* config = &params.session_options.config;
+  if (opts.inter_op_threads > 0) {
+    config->set_inter_op_parallelism_threads(opts.inter_op_threads);
+  }
+  if (opts.intra_op_threads > 0) {
+    config->set_intra_op_parallelism_threads(opts.intra_op_threads);
+  }
+
+  std::unique_ptr<standalone::Dataset> dataset;
+  TF_RETURN_IF_ERROR(
+      standalone::Dataset::FromGraph(params, graph_def, &dataset));
+  std::unique_ptr<standalone::Iterator> iterator;
+  TF_RETURN_IF_ERROR(dataset->MakeIterator(&iterator));
+
+  Env* env = Env::Default();
+  bool end_of_input = false;
+  int64_t produced = 0;
+  for (int64_t i = 0; i < opts.warmup_elements && !end_of_input; ++i) {
+    std::vector<Tensor> element;
+    TF_RETURN_IF_ERROR(iterator->GetNext(&element, &end_of_input));
+  }
+
+  const uint64 start_usec = env->NowMicros();
+  while (produced < opts.num_elements && !end_of_input) {
+    std::vector<Tensor> element;
+    TF_RETURN_IF_ERROR(iterator->GetNext(&element, &end_of_input));
+    if (!end_of_input) ++produced;
+  }
+  const uint64 elapsed_usec = env->NowMicros() - start_usec;
+
+  const double elapsed_sec = elapsed_usec / 1.0e6;
+  printf("Replayed %lld elements in %.3f s (%.1f elements/s, %.1f us/element)",
+         static_cast<long long>(produced), elapsed_sec,  // NOLINT
+         elapsed_sec > 0 ? produced / elapsed_sec : 0.0,
+         produced > 0 ? static_cast<double>(elapsed_usec) / produced : 0.0);
+  printf("%s\n", end_of_input ? " [end of input]" : "");
+
+  std::shared_ptr<model::Model> model = iterator->model();
+  if (model == nullptr) {
+    printf(
+        "No per-node breakdown: the pipeline's options disable autotuning.\n");
+    return OkStatus();
+  }
+  ModelProto model_proto;
+  TF_RETURN_IF_ERROR(model->ToProto(&model_proto));
+  PrintModelBreakdown(model_proto);
+  if (!opts.model_proto_out.empty()) {
+    TF_RETURN_IF_ERROR(
+        WriteBinaryProto(Env::Default(), opts.model_proto_out, model_proto));
+    printf("Wrote ModelProto to %s\n", opts.model_proto_out.c_str());
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+int Main(int argc, char** argv) {
+  Options opts;
+  std::vector<Flag> flag_list = {
+      Flag("dataset_graph", &opts.dataset_graph,
+           "path to the serialized dataset GraphDef (.pb or .pbtxt)"),
+      Flag("num_elements", &opts.num_elements,
+           "number of elements to replay"),
+      Flag("warmup_elements", &opts.warmup_elements,
+           "elements to pull before timing starts"),
+      Flag("inter_op_threads", &opts.inter_op_threads,
+           "inter-op thread pool size (0 = runtime default)"),
+      Flag("intra_op_threads", &opts.intra_op_threads,
+           "intra-op thread pool size (0 = runtime default)"),
+      Flag("model_proto_out", &opts.model_proto_out,
+           "if set, write the collected ModelProto here"),
+  };
+  const string usage = Flags::Usage(argv[0], flag_list);
+  if (!Flags::Parse(&argc, argv, flag_list) || opts.dataset_graph.empty()) {
+    LOG(ERROR) << usage;
+    return -1;
+  }
+  port::InitMain(argv[0], &argc, &argv);
+
+  Status s = Run(opts);
+  if (!s.ok()) {
+    LOG(ERROR) << "Replay failed: " << s.error_message();
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace data
+}  // namespace tensorflow
+
+int main(int argc, char** argv) {
+  return tensorflow::data::Main(argc, argv);
+}
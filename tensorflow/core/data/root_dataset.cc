@@ -21,6 +21,7 @@ limitations under the License.
 #include <utility>
 
 #include "tensorflow/core/data/dataset_utils.h"
+#include "tensorflow/core/data/element_arena_allocator.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/rewrite_utils.h"
 #include "tensorflow/core/framework/model.pb.h"
@@ -28,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -46,6 +48,13 @@ constexpr char kRamBudget[] = "ram_budget_megabytes";
 constexpr char kRamUsage[] = "ram_usage_megabytes";
 constexpr char kMaxBufferBytes[] = "max_buffered_megabytes";
 
+// If set to a positive number of bytes, element tensors produced by the
+// pipeline are allocated from a process-lifetime arena that carves them out of
+// blocks of this size and recycles whole blocks once all tensors allocated
+// from them have been consumed. See `ElementArenaAllocator`.
+constexpr char kElementArenaBlockBytesEnv[] =
+    "TF_DATA_ELEMENT_ARENA_BLOCK_BYTES";
+
 // If value `x` matches `y`, returns default value `z`. Otherwise, return `x`.
 inline int64_t value_or_default(int64_t x, int64_t y, int64_t z) {
   return x == y ? z : x;
@@ -155,12 +164,29 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
       thread_pool_ = std::make_unique<thread::ThreadPool>(
           Env::Default(), ThreadOptions{}, "data_private_threadpool",
           threadpool_size_);
+      // The runner is independent of the upstream context, so build it once
+      // here instead of re-wrapping it for every `GetNext` call.
+      runner_ = [pool = thread_pool_.get()](std::function<void()> c) {
+        pool->Schedule(std::move(c));
+      };
+      if (dataset()->params_.max_intra_op_parallelism >= 0) {
+        runner_ = RunnerWithMaxParallelism(std::move(runner_),
+                                           max_intra_op_parallelism_);
+      }
+    }
+    Status s = ReadInt64FromEnvVar(kElementArenaBlockBytesEnv,
+                                   /*default_val=*/0, &arena_block_bytes_);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to read " << kElementArenaBlockBytesEnv << ": "
+                   << s.error_message();
     }
     cancellation_manager_ = std::make_unique<CancellationManager>();
   }
 
   ~Iterator() override { cancellation_manager_->StartCancel(); }
 
+  std::shared_ptr<model::Model> model() const override { return model_; }
+
   Status Initialize(IteratorContext* ctx) override {
     return dataset()->input_->MakeIterator(IteratorContext(CreateParams(ctx)),
                                            this, prefix(), &input_impl_);
@@ -240,15 +266,21 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
       params.model = model_;
     }
     if (dataset()->params_.private_threadpool_size >= 0) {
-      params.runner = [pool = thread_pool_.get()](std::function<void()> c) {
-        pool->Schedule(std::move(c));
-      };
+      // `runner_` already folds in the max intra-op parallelism override.
+      params.runner = runner_;
       params.runner_threadpool_size = threadpool_size_;
-    }
-    if (dataset()->params_.max_intra_op_parallelism >= 0) {
+    } else if (dataset()->params_.max_intra_op_parallelism >= 0) {
       params.runner =
           RunnerWithMaxParallelism(params.runner, max_intra_op_parallelism_);
     }
+    if (arena_block_bytes_ > 0 && params.allocator_getter) {
+      params.allocator_getter = [block_bytes = arena_block_bytes_,
+                                 getter = std::move(params.allocator_getter)](
+                                    AllocatorAttributes attrs) {
+        return ElementArenaAllocator::Wrap(getter(attrs),
+                                           static_cast<size_t>(block_bytes));
+      };
+    }
     params.options = &dataset()->options();
     return params;
   }
@@ -279,6 +311,12 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
   int64_t max_intra_op_parallelism_;
   int64_t threadpool_size_;
   std::unique_ptr<thread::ThreadPool> thread_pool_;
+  // Runner that schedules work onto `thread_pool_`, with the max intra-op
+  // parallelism override applied. Only set when a private thread pool is
+  // configured.
+  std::function<void(std::function<void()>)> runner_;
+  // Block size of the element arena allocator; zero disables the arena.
+  int64_t arena_block_bytes_ = 0;
 
   // The end time of the previous `GetNextInternal` call.
   uint64_t end_time_usec_ TF_GUARDED_BY(mu_) = 0;
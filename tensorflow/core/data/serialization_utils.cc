@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/data/serialization_utils.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,7 +28,9 @@ limitations under the License.
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/graph/graph_def_builder.h"
+#include "tensorflow/core/platform/fingerprint.h"
 
 namespace tensorflow {
 namespace data {
@@ -102,6 +107,65 @@ Status FindStatefulOps(const GraphDef& graph_def,
   return OkStatus();
 }
 
+// Serialized state of a single iterator, indexed by checkpoint key. Each entry
+// holds the checkpointed tensor along with its serialized TensorProto, which
+// is used to compare and fingerprint entries.
+struct IteratorStateEntries {
+  // Checkpoint keys in the order in which they appear in the metadata.
+  std::vector<string> keys;
+  std::map<string, std::pair<const Tensor*, string>> entries;
+};
+
+// Indexes the serialized iterator state `data` by iterator name and checkpoint
+// key. Returns an error if the metadata of any of the VariantTensorData
+// objects is malformed.
+Status ParseIteratorState(const std::vector<const VariantTensorData*>& data,
+                          std::map<string, IteratorStateEntries>* state) {
+  for (const VariantTensorData* d : data) {
+    std::vector<string> keys = str_util::Split(
+        d->metadata_string(), kDelimiter, str_util::SkipEmpty());
+    if (keys.empty()) {
+      return errors::InvalidArgument(
+          "Iterator state metadata is missing an iterator name.");
+    }
+    const string name = keys[0];
+    if (d->tensors_size() != static_cast<int>(keys.size()) - 1) {
+      return errors::InvalidArgument("Iterator state for ", name, " has ",
+                                     keys.size() - 1, " keys but ",
+                                     d->tensors_size(), " tensors.");
+    }
+    if (state->count(name) > 0) {
+      return errors::InvalidArgument("Duplicate iterator name: ", name);
+    }
+    IteratorStateEntries& entries = (*state)[name];
+    for (size_t i = 1; i < keys.size(); ++i) {
+      const Tensor& tensor = d->tensors(i - 1);
+      TensorProto proto;
+      tensor.AsProtoTensorContent(&proto);
+      entries.keys.push_back(keys[i]);
+      entries.entries[keys[i]] =
+          std::make_pair(&tensor, proto.SerializeAsString());
+    }
+  }
+  return OkStatus();
+}
+
+uint64 FingerprintIteratorState(
+    const std::map<string, IteratorStateEntries>& state) {
+  uint64 fingerprint = Fingerprint64("IteratorState");
+  for (const auto& iterator : state) {
+    fingerprint = FingerprintCat64(fingerprint, Fingerprint64(iterator.first));
+    // Iterate over the entries in sorted key order so that the fingerprint
+    // does not depend on the order in which the entries were written.
+    for (const auto& entry : iterator.second.entries) {
+      fingerprint = FingerprintCat64(fingerprint, Fingerprint64(entry.first));
+      fingerprint =
+          FingerprintCat64(fingerprint, Fingerprint64(entry.second.second));
+    }
+  }
+  return fingerprint;
+}
+
 }  // namespace
 
 Status ReadElementsFromCheckpoint(IteratorContext* ctx,
@@ -419,6 +483,151 @@ Status VariantTensorDataWriter::WriteDatasetInternal(
   return OkStatus();
 }
 
+uint64 IteratorStateFingerprint(
+    const std::vector<const VariantTensorData*>& data) {
+  std::map<string, IteratorStateEntries> state;
+  if (ParseIteratorState(data, &state).ok()) {
+    return FingerprintIteratorState(state);
+  }
+  // Fall back to fingerprinting the raw serialized form in a deterministic
+  // order if the metadata cannot be parsed.
+  std::vector<string> serialized;
+  serialized.reserve(data.size());
+  for (const VariantTensorData* d : data) {
+    serialized.push_back(d->SerializeAsString());
+  }
+  std::sort(serialized.begin(), serialized.end());
+  uint64 fingerprint = Fingerprint64("IteratorState");
+  for (const string& s : serialized) {
+    fingerprint = FingerprintCat64(fingerprint, Fingerprint64(s));
+  }
+  return fingerprint;
+}
+
+Status ComputeIteratorStateDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& state,
+    IteratorStateDelta* delta) {
+  std::map<string, IteratorStateEntries> base_state;
+  std::map<string, IteratorStateEntries> new_state;
+  TF_RETURN_IF_ERROR(ParseIteratorState(base, &base_state));
+  TF_RETURN_IF_ERROR(ParseIteratorState(state, &new_state));
+  delta->base_fingerprint = FingerprintIteratorState(base_state);
+  delta->iterators.clear();
+  delta->deleted_iterators.clear();
+  for (const auto& iterator : new_state) {
+    const string& name = iterator.first;
+    auto base_it = base_state.find(name);
+    IteratorStateDelta::IteratorDelta iterator_delta;
+    for (const string& key : iterator.second.keys) {
+      const auto& entry = iterator.second.entries.at(key);
+      if (base_it != base_state.end()) {
+        auto entry_it = base_it->second.entries.find(key);
+        if (entry_it != base_it->second.entries.end() &&
+            entry_it->second.second == entry.second) {
+          // The entry is unchanged.
+          continue;
+        }
+      }
+      iterator_delta.updated[key] = *entry.first;
+    }
+    if (base_it != base_state.end()) {
+      for (const string& key : base_it->second.keys) {
+        if (iterator.second.entries.count(key) == 0) {
+          iterator_delta.deleted.push_back(key);
+        }
+      }
+    }
+    if (!iterator_delta.updated.empty() || !iterator_delta.deleted.empty()) {
+      delta->iterators[name] = std::move(iterator_delta);
+    }
+  }
+  for (const auto& iterator : base_state) {
+    if (new_state.count(iterator.first) == 0) {
+      delta->deleted_iterators.push_back(iterator.first);
+    }
+  }
+  return OkStatus();
+}
+
+Status ApplyIteratorStateDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const IteratorStateDelta& delta,
+    std::vector<std::unique_ptr<VariantTensorData>>* result) {
+  std::map<string, IteratorStateEntries> base_state;
+  TF_RETURN_IF_ERROR(ParseIteratorState(base, &base_state));
+  uint64 base_fingerprint = FingerprintIteratorState(base_state);
+  if (base_fingerprint != delta.base_fingerprint) {
+    return errors::InvalidArgument(
+        "Cannot apply iterator state delta: the delta was computed against a "
+        "state with fingerprint ",
+        delta.base_fingerprint, " but the base state has fingerprint ",
+        base_fingerprint, ".");
+  }
+  const std::set<string> deleted_iterators(delta.deleted_iterators.begin(),
+                                           delta.deleted_iterators.end());
+  // Merged state, mapping each iterator name to its ordered entries.
+  std::map<string, std::vector<std::pair<string, Tensor>>> merged;
+  for (const auto& iterator : base_state) {
+    const string& name = iterator.first;
+    if (deleted_iterators.count(name) > 0) {
+      continue;
+    }
+    auto delta_it = delta.iterators.find(name);
+    std::set<string> deleted_keys;
+    if (delta_it != delta.iterators.end()) {
+      deleted_keys.insert(delta_it->second.deleted.begin(),
+                          delta_it->second.deleted.end());
+    }
+    std::vector<std::pair<string, Tensor>>& entries = merged[name];
+    for (const string& key : iterator.second.keys) {
+      if (deleted_keys.count(key) > 0) {
+        continue;
+      }
+      if (delta_it != delta.iterators.end()) {
+        auto updated_it = delta_it->second.updated.find(key);
+        if (updated_it != delta_it->second.updated.end()) {
+          entries.push_back(std::make_pair(key, updated_it->second));
+          continue;
+        }
+      }
+      entries.push_back(
+          std::make_pair(key, *iterator.second.entries.at(key).first));
+    }
+    if (delta_it != delta.iterators.end()) {
+      // Append entries added by the delta.
+      for (const auto& updated : delta_it->second.updated) {
+        if (iterator.second.entries.count(updated.first) == 0) {
+          entries.push_back(updated);
+        }
+      }
+    }
+  }
+  // Add iterators which do not exist in the base state.
+  for (const auto& iterator : delta.iterators) {
+    if (base_state.count(iterator.first) > 0 ||
+        deleted_iterators.count(iterator.first) > 0) {
+      continue;
+    }
+    std::vector<std::pair<string, Tensor>>& entries = merged[iterator.first];
+    for (const auto& updated : iterator.second.updated) {
+      entries.push_back(updated);
+    }
+  }
+  for (const auto& iterator : merged) {
+    auto data = std::make_unique<VariantTensorData>();
+    data->set_type_name("tensorflow::Iterator");
+    string metadata = iterator.first;
+    for (const auto& entry : iterator.second) {
+      strings::StrAppend(&metadata, kDelimiter, entry.first);
+      *(data->add_tensors()) = entry.second;
+    }
+    data->set_metadata(metadata);
+    result->push_back(std::move(data));
+  }
+  return OkStatus();
+}
+
 Status AsGraphDefForRewrite(OpKernelContext* ctx, const DatasetBase* input,
                             std::vector<std::pair<string, Tensor>>* input_list,
                             GraphDef* result, string* dataset_node) {
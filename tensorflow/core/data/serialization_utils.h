@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DATA_SERIALIZATION_UTILS_H_
 #define TENSORFLOW_CORE_DATA_SERIALIZATION_UTILS_H_
 
+#include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -120,6 +123,55 @@ class VariantTensorDataWriter : public IteratorStateWriter {
   std::map<string, std::vector<string>> keys_;
 };
 
+// Represents the difference between two serialized iterator states at the
+// granularity of individual checkpoint entries. Deltas are typically much
+// smaller than full states for iterators with large, slowly-changing state
+// such as shuffle buffers, so writing deltas instead of full states avoids
+// long checkpoint stalls.
+struct IteratorStateDelta {
+  // Delta for the state of a single iterator.
+  struct IteratorDelta {
+    // Entries whose values changed or that were added relative to the base
+    // state, keyed by checkpoint key.
+    std::map<string, Tensor> updated;
+    // Keys present in the base state but absent from the new state.
+    std::vector<string> deleted;
+  };
+
+  // Fingerprint of the base state the delta was computed against.
+  // `ApplyIteratorStateDelta` refuses to apply a delta to a base state with a
+  // different fingerprint.
+  uint64 base_fingerprint = 0;
+  // Per-iterator deltas, keyed by iterator name. Iterators absent from this
+  // map are unchanged.
+  std::map<string, IteratorDelta> iterators;
+  // Names of iterators present in the base state but absent from the new
+  // state.
+  std::vector<string> deleted_iterators;
+};
+
+// Returns a fingerprint of the serialized iterator state `data`. The
+// fingerprint covers iterator names, checkpoint keys, and tensor values, and
+// does not depend on the order of the VariantTensorData objects.
+uint64 IteratorStateFingerprint(
+    const std::vector<const VariantTensorData*>& data);
+
+// Computes the delta that transforms the serialized iterator state `base` into
+// `state`. Both states must have been produced by `VariantTensorDataWriter`.
+Status ComputeIteratorStateDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const std::vector<const VariantTensorData*>& state,
+    IteratorStateDelta* delta);
+
+// Reconstructs a full serialized iterator state by applying `delta` to `base`.
+// Returns an InvalidArgument error if `delta` was computed against a state
+// with a different fingerprint than `base`. The result can be read back with
+// `VariantTensorDataReader`.
+Status ApplyIteratorStateDelta(
+    const std::vector<const VariantTensorData*>& base,
+    const IteratorStateDelta& delta,
+    std::vector<std::unique_ptr<VariantTensorData>>* result);
+
 // Returns a GraphDef representation of the given dataset.
 Status AsGraphDef(const DatasetBase* dataset,
                   SerializationContext&& serialization_ctx,
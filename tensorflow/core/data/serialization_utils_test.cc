@@ -201,6 +201,85 @@ TEST(SerializationUtilsTest, VariantTensorDataNonExistentKeyIteratorName) {
       reader.ReadTensor("Iterator", "NonExistentKey", &val_tensor).code());
 }
 
+TEST(SerializationUtilsTest, IteratorStateDeltaRoundTrip) {
+  VariantTensorDataWriter base_writer;
+  TF_ASSERT_OK(base_writer.WriteScalar(full_name("unchanged"), 1));
+  TF_ASSERT_OK(base_writer.WriteScalar(full_name("changed"), 2));
+  TF_ASSERT_OK(base_writer.WriteScalar(full_name("deleted"), 3));
+  std::vector<const VariantTensorData*> base;
+  base_writer.GetData(&base);
+
+  VariantTensorDataWriter new_writer;
+  TF_ASSERT_OK(new_writer.WriteScalar(full_name("unchanged"), 1));
+  TF_ASSERT_OK(new_writer.WriteScalar(full_name("changed"), 20));
+  TF_ASSERT_OK(new_writer.WriteScalar(full_name("added"), 4));
+  std::vector<const VariantTensorData*> state;
+  new_writer.GetData(&state);
+
+  IteratorStateDelta delta;
+  TF_ASSERT_OK(ComputeIteratorStateDelta(base, state, &delta));
+  ASSERT_EQ(delta.iterators.size(), 1);
+  const IteratorStateDelta::IteratorDelta& iterator_delta =
+      delta.iterators.begin()->second;
+  EXPECT_EQ(iterator_delta.updated.size(), 2);
+  EXPECT_EQ(iterator_delta.deleted.size(), 1);
+  EXPECT_TRUE(delta.deleted_iterators.empty());
+
+  std::vector<std::unique_ptr<VariantTensorData>> merged;
+  TF_ASSERT_OK(ApplyIteratorStateDelta(base, delta, &merged));
+  std::vector<const VariantTensorData*> merged_data;
+  for (const auto& d : merged) {
+    merged_data.push_back(d.get());
+  }
+  VariantTensorDataReader reader(merged_data);
+  int64_t val;
+  TF_ASSERT_OK(reader.ReadScalar(full_name("unchanged"), &val));
+  EXPECT_EQ(val, 1);
+  TF_ASSERT_OK(reader.ReadScalar(full_name("changed"), &val));
+  EXPECT_EQ(val, 20);
+  TF_ASSERT_OK(reader.ReadScalar(full_name("added"), &val));
+  EXPECT_EQ(val, 4);
+  EXPECT_FALSE(reader.Contains(full_name("deleted")));
+  EXPECT_EQ(IteratorStateFingerprint(merged_data),
+            IteratorStateFingerprint(state));
+}
+
+TEST(SerializationUtilsTest, IteratorStateDeltaIdenticalStates) {
+  VariantTensorDataWriter base_writer;
+  TF_ASSERT_OK(base_writer.WriteScalar(full_name("key"), 1));
+  std::vector<const VariantTensorData*> base;
+  base_writer.GetData(&base);
+
+  VariantTensorDataWriter new_writer;
+  TF_ASSERT_OK(new_writer.WriteScalar(full_name("key"), 1));
+  std::vector<const VariantTensorData*> state;
+  new_writer.GetData(&state);
+
+  EXPECT_EQ(IteratorStateFingerprint(base), IteratorStateFingerprint(state));
+  IteratorStateDelta delta;
+  TF_ASSERT_OK(ComputeIteratorStateDelta(base, state, &delta));
+  EXPECT_TRUE(delta.iterators.empty());
+  EXPECT_TRUE(delta.deleted_iterators.empty());
+}
+
+TEST(SerializationUtilsTest, IteratorStateDeltaFingerprintMismatch) {
+  VariantTensorDataWriter base_writer;
+  TF_ASSERT_OK(base_writer.WriteScalar(full_name("key"), 1));
+  std::vector<const VariantTensorData*> base;
+  base_writer.GetData(&base);
+
+  VariantTensorDataWriter new_writer;
+  TF_ASSERT_OK(new_writer.WriteScalar(full_name("key"), 2));
+  std::vector<const VariantTensorData*> state;
+  new_writer.GetData(&state);
+
+  IteratorStateDelta delta;
+  TF_ASSERT_OK(ComputeIteratorStateDelta(base, state, &delta));
+  std::vector<std::unique_ptr<VariantTensorData>> merged;
+  EXPECT_EQ(error::INVALID_ARGUMENT,
+            ApplyIteratorStateDelta(state, delta, &merged).code());
+}
+
 TEST(SerializationUtilsTest, VariantTensorDataWriteAfterFlushing) {
   VariantTensorDataWriter writer;
   TF_ASSERT_OK(writer.WriteScalar(full_name("Int64"), 24));
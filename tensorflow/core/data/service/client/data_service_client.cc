@@ -49,11 +49,24 @@ limitations under the License.
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
 namespace {
 
+// Environment variables configuring per-task request pipelining and hedged
+// reads. See the corresponding member comments in `DataServiceClient`.
+constexpr const char kPipelineWindowEnv[] =
+    "TF_DATA_SERVICE_CLIENT_PIPELINE_WINDOW";
+constexpr const char kHedgedRequestsEnv[] =
+    "TF_DATA_SERVICE_CLIENT_HEDGED_REQUESTS";
+
+// Number of request latency samples required before hedging, and a floor on
+// the hedging threshold so that fast local reads aren't hedged needlessly.
+constexpr int64_t kMinHedgeSamples = 64;
+constexpr int64_t kMinHedgeTimeMicros = 1000;
+
 bool IsColocatedTask(const TaskInfo& task) {
   return absl::c_any_of(task.worker_tags(), [](std::string_view worker_tag) {
     return absl::AsciiStrToUpper(worker_tag) == kColocatedWorkerTag;
@@ -64,7 +77,25 @@ bool IsColocatedTask(const TaskInfo& task) {
 
 DataServiceClient::DataServiceClient(const DataServiceParams& params)
     : params_(params),
-      max_outstanding_requests_(params.max_outstanding_requests) {}
+      max_outstanding_requests_(params.max_outstanding_requests) {
+  Status s = ReadInt64FromEnvVar(kPipelineWindowEnv, /*default_val=*/1,
+                                 &max_requests_per_task_);
+  if (s.ok()) {
+    s = ReadInt64FromEnvVar(kHedgedRequestsEnv, /*default_val=*/0,
+                            &max_hedged_requests_);
+  }
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to parse tf.data service client configuration: " << s;
+  }
+  max_requests_per_task_ = std::max<int64_t>(max_requests_per_task_, 1);
+  max_hedged_requests_ = std::max<int64_t>(max_hedged_requests_, 0);
+  if (IsCoordinatedRead()) {
+    // Coordinated reads require strict per-round ordering, which rules out
+    // pipelining multiple rounds per task and hedged reads.
+    max_requests_per_task_ = 1;
+    max_hedged_requests_ = 0;
+  }
+}
 
 DataServiceClient::~DataServiceClient() {
   VLOG(2) << "Destroying data service client for iteration id "
@@ -464,8 +495,16 @@ void DataServiceClient::UpdateBufferSize() TF_LOCKS_EXCLUDED(mu_) {
 
 void DataServiceClient::UpdateWorkerThreads() TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
-  const int64_t max_num_threads =
+  int64_t max_num_threads =
       std::min<int64_t>(tasks_.size(), max_outstanding_requests_);
+  if (!IsCoordinatedRead()) {
+    // With per-task pipelining, each task may have up to
+    // `max_requests_per_task_` requests in flight, and hedged requests may
+    // temporarily exceed `max_outstanding_requests_`.
+    max_num_threads =
+        std::min<int64_t>(tasks_.size() * max_requests_per_task_,
+                          max_outstanding_requests_ + max_hedged_requests_);
+  }
   while (num_running_worker_threads_ < max_num_threads && !cancelled_ &&
          status_.ok()) {
     num_running_worker_threads_++;
@@ -489,13 +528,19 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
   });
   VLOG(1) << "Starting worker thread";
   std::shared_ptr<Task> task_to_process;
+  int64_t request_start_micros = 0;
   while (true) {
     std::shared_ptr<Result> result;
     {
       mutex_lock l(mu_);
       if (task_to_process) {
-        task_to_process->in_use = false;
+        task_to_process->in_flight--;
         --outstanding_requests_;
+        inflight_request_starts_.erase(
+            inflight_request_starts_.find(request_start_micros));
+        latency_histogram_.Add(Env::Default()->NowMicros() -
+                               request_start_micros);
+        ++num_latency_samples_;
         task_to_process = nullptr;
         worker_thread_cv_.notify_one();
       }
@@ -509,11 +554,25 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
                   << task_to_process->info.ShortDebugString();
           break;
         }
-        worker_thread_cv_.wait(l);
+        const int64_t hedge_time_micros = HedgeTimeMicros();
+        if (max_hedged_requests_ > 0 && hedge_time_micros != kint64max &&
+            !inflight_request_starts_.empty()) {
+          // Wake up when the oldest in-flight request crosses the hedging
+          // threshold, so this thread can issue a hedged request.
+          const int64_t wait_micros = std::max<int64_t>(
+              *inflight_request_starts_.begin() + hedge_time_micros -
+                  Env::Default()->NowMicros(),
+              kMinHedgeTimeMicros);
+          worker_thread_cv_.wait_for(l, std::chrono::microseconds(wait_micros));
+        } else {
+          worker_thread_cv_.wait(l);
+        }
       }
       DCHECK(task_to_process != nullptr);
-      task_to_process->in_use = true;
+      task_to_process->in_flight++;
       ++outstanding_requests_;
+      request_start_micros = Env::Default()->NowMicros();
+      inflight_request_starts_.insert(request_start_micros);
       if (IsCoordinatedRead()) {
         // Reserve a spot in the results_ queue.
         results_.push(std::make_shared<Result>());
@@ -533,8 +592,10 @@ void DataServiceClient::RunWorkerThread(std::function<void()> done)
       mutex_lock l(mu_);
       VLOG(1) << "Failed to get element from worker "
               << task_to_process->info.worker_address() << ": " << s;
-      task_to_process->in_use = false;
+      task_to_process->in_flight--;
       --outstanding_requests_;
+      inflight_request_starts_.erase(
+          inflight_request_starts_.find(request_start_micros));
       status_ = errors::CreateWithUpdatedMessage(
           s, absl::StrCat("Failed to get element from worker ",
                           task_to_process->info.worker_address(), ": ",
@@ -556,7 +617,39 @@ bool DataServiceClient::ShouldProcessTask() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   // Otherwise, results aren't added to `results_` until the data has been
   // successfully retrieved. We need to count requests already added to
   // `results_` as well as in-progress requests.
-  return results_.size() + outstanding_requests_ < max_outstanding_requests_;
+  if (results_.size() + outstanding_requests_ < max_outstanding_requests_) {
+    return true;
+  }
+  // Allow a bounded number of hedged requests beyond
+  // `max_outstanding_requests_` while in-flight requests have outlived the
+  // typical request latency, so a straggling worker doesn't stall `GetNext`.
+  if (max_hedged_requests_ == 0 || inflight_request_starts_.empty()) {
+    return false;
+  }
+  const int64_t hedge_time_micros = HedgeTimeMicros();
+  if (hedge_time_micros == kint64max) {
+    return false;
+  }
+  const int64_t slow_since = Env::Default()->NowMicros() - hedge_time_micros;
+  int64_t num_slow_requests = 0;
+  for (const int64_t start_micros : inflight_request_starts_) {
+    if (start_micros > slow_since) {
+      break;
+    }
+    ++num_slow_requests;
+  }
+  return results_.size() + outstanding_requests_ <
+         max_outstanding_requests_ +
+             std::min(num_slow_requests, max_hedged_requests_);
+}
+
+int64_t DataServiceClient::HedgeTimeMicros() const
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  if (num_latency_samples_ < kMinHedgeSamples) {
+    return kint64max;
+  }
+  return std::max<int64_t>(latency_histogram_.Percentile(95),
+                           kMinHedgeTimeMicros);
 }
 
 // Searches for a task to process, visiting tasks in-order and giving every
@@ -570,21 +663,22 @@ std::shared_ptr<DataServiceClient::Task> DataServiceClient::GetTaskToProcess()
   for (int i = 0; i < tasks_.size(); ++i) {
     std::shared_ptr<Task>& task = tasks_[next_task_index_];
     if (IsCoordinatedRead() &&
-        (task->in_use ||
+        (task->in_flight > 0 ||
          current_round_ >= round_robin_round_limit_.value_or(
                                std::numeric_limits<int64_t>::max()))) {
-      VLOG(4) << "No round robin task found. in_use: " << task->in_use
+      VLOG(4) << "No round robin task found. in_flight: " << task->in_flight
               << ". current_round: " << current_round_
               << ". round_robin_round_limit: "
               << round_robin_round_limit_.value_or(-1);
       return nullptr;
     }
-    if (current_round_ < task->info.starting_round() || task->in_use ||
-        task->end_of_sequence || task->removed) {
+    if (current_round_ < task->info.starting_round() ||
+        task->in_flight >= max_requests_per_task_ || task->end_of_sequence ||
+        task->removed) {
       VLOG(3) << "Skipping task " << next_task_index_
               << ". starting round: " << task->info.starting_round()
               << ". current round: " << current_round_
-              << ". task->in_use: " << task->in_use
+              << ". task->in_flight: " << task->in_flight
               << ". end_of_sequence: " << task->end_of_sequence
               << ". task->removed: " << task->removed;
       AdvanceTaskIndex();
@@ -19,6 +19,7 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <queue>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/worker_client.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/histogram/histogram.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
@@ -93,8 +95,9 @@ class DataServiceClient {
     // deleted from `tasks_` on the next dispatcher heartbeat.
     bool removed = false;
     bool skipped_previous_round = false;
-    // Indicates whether a worker thread is currently processing the task.
-    bool in_use TF_GUARDED_BY(&DataServiceClient::mu_) = false;
+    // The number of in-flight `GetElement` requests worker threads are
+    // currently processing for the task.
+    int64_t in_flight TF_GUARDED_BY(&DataServiceClient::mu_) = 0;
     // Indicates whether the worker has returned end_of_sequence for the task.
     bool end_of_sequence TF_GUARDED_BY(&DataServiceClient::mu_) = false;
   };
@@ -145,6 +148,10 @@ class DataServiceClient {
   // Reports whether we can request another element without violating
   // `max_outstanding_requests_`.
   bool ShouldProcessTask();
+  // Returns how long a request may be in flight before we hedge it by
+  // requesting an element from another task, based on the latency of past
+  // requests. Returns kint64max while there are too few samples to decide.
+  int64_t HedgeTimeMicros() const;
   // Searches for a task to process, visiting tasks in-order and giving every
   // task a chance to proceed.
   std::shared_ptr<Task> GetTaskToProcess();
@@ -180,6 +187,27 @@ class DataServiceClient {
   // elements as well as completed requests which haven't yet been produced.
   int64_t max_outstanding_requests_ TF_GUARDED_BY(mu_);
 
+  // Maximum number of `GetElement` requests to pipeline per task. Read from
+  // the TF_DATA_SERVICE_CLIENT_PIPELINE_WINDOW environment variable in the
+  // constructor; always 1 for coordinated reads, which require strict
+  // per-round ordering.
+  int64_t max_requests_per_task_ = 1;
+
+  // Maximum number of hedged requests that may be in flight beyond
+  // `max_outstanding_requests_` while other requests are slow. Read from the
+  // TF_DATA_SERVICE_CLIENT_HEDGED_REQUESTS environment variable in the
+  // constructor; 0 disables hedging.
+  int64_t max_hedged_requests_ = 0;
+
+  // Start times (in microseconds) of in-flight `GetElement` requests, used
+  // to find requests which have outlived the typical request latency.
+  std::multiset<int64_t> inflight_request_starts_ TF_GUARDED_BY(mu_);
+
+  // Latencies of successful `GetElement` requests, used to compute the
+  // hedging threshold.
+  histogram::Histogram latency_histogram_ TF_GUARDED_BY(mu_);
+  int64_t num_latency_samples_ TF_GUARDED_BY(mu_) = 0;
+
   // The number of threads in `worker_threads_` which are still running.
   int64_t num_running_worker_threads_ TF_GUARDED_BY(mu_) = 0;
 
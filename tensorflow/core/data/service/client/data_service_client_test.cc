@@ -151,6 +151,30 @@ TEST(DataServiceClientTest, DynamicSharding) {
   client.Cancel();
 }
 
+TEST(DataServiceClientTest, PipelinedAndHedgedReads) {
+  // Pipeline multiple requests per task and allow hedged reads. All elements
+  // should still be produced exactly once.
+  setenv("TF_DATA_SERVICE_CLIENT_PIPELINE_WINDOW", "4", /*overwrite=*/1);
+  setenv("TF_DATA_SERVICE_CLIENT_HEDGED_REQUESTS", "2", /*overwrite=*/1);
+
+  TestCluster test_cluster(/*num_workers=*/3);
+  TF_ASSERT_OK(test_cluster.Initialize());
+  DatasetClient<int64_t> test_dataset(test_cluster);
+  TF_ASSERT_OK_AND_ASSIGN(std::string dataset_id,
+                          test_dataset.RegisterDataset(RangeDataset(20)));
+
+  DataServiceParams params = GetDataServiceParams(
+      dataset_id, test_cluster.DispatcherAddress(), ProcessingModeDef::DYNAMIC);
+  DataServiceClient client(params);
+  TF_ASSERT_OK(client.Initialize());
+  EXPECT_THAT(GetResults<int64_t>(client),
+              IsOkAndHolds(UnorderedElementsAreArray(Range(20))));
+  client.Cancel();
+
+  unsetenv("TF_DATA_SERVICE_CLIENT_PIPELINE_WINDOW");
+  unsetenv("TF_DATA_SERVICE_CLIENT_HEDGED_REQUESTS");
+}
+
 TEST(DataServiceClientTest, StaticSharding) {
   TestCluster test_cluster(/*num_workers=*/3);
   TF_ASSERT_OK(test_cluster.Initialize());
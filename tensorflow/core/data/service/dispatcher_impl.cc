@@ -29,6 +29,7 @@ limitations under the License.
 #include "grpcpp/create_channel.h"
 #include "grpcpp/impl/codegen/server_context.h"
 #include "grpcpp/security/credentials.h"
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/memory/memory.h"
@@ -777,6 +778,8 @@ Status DataServiceDispatcherImpl::CreateIteration(
 
 Status DataServiceDispatcherImpl::CreateTasksForWorker(
     const std::string& worker_address) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  std::shared_ptr<const Worker> worker;
+  TF_RETURN_IF_ERROR(state_.WorkerFromAddress(worker_address, worker));
   std::vector<std::shared_ptr<const Iteration>> iterations =
       state_.ListIterations();
   for (const auto& iteration : iterations) {
@@ -787,6 +790,20 @@ Status DataServiceDispatcherImpl::CreateTasksForWorker(
       TF_RETURN_IF_ERROR(CreatePendingTask(iteration, worker_address));
       continue;
     }
+    std::vector<std::string> locality_hints;
+    TF_RETURN_IF_ERROR(LocalityHintsForIteration(iteration, locality_hints));
+    if (!MatchesLocalityHints(worker->tags, locality_hints) &&
+        absl::c_any_of(state_.ListWorkers(),
+                       [&](const std::shared_ptr<const Worker>& w) {
+                         return MatchesLocalityHints(w->tags, locality_hints);
+                       })) {
+      // Another worker satisfies the dataset's locality hints; leave this
+      // iteration to the matching workers.
+      VLOG(2) << "Not creating a task for iteration "
+              << iteration->DebugString() << " on worker " << worker_address
+              << ": worker tags do not match the dataset's locality hints.";
+      continue;
+    }
     std::shared_ptr<const Task> task;
     TF_RETURN_IF_ERROR(CreateTask(iteration, worker_address, task));
   }
@@ -808,11 +825,62 @@ Status DataServiceDispatcherImpl::AcquireIterationClientId(
   return OkStatus();
 }
 
+Status DataServiceDispatcherImpl::LocalityHintsForIteration(
+    std::shared_ptr<const Iteration> iteration, std::vector<std::string>& hints)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  std::shared_ptr<const Dataset> dataset;
+  TF_RETURN_IF_ERROR(state_.DatasetFromId(iteration->job->dataset_id, dataset));
+  hints.assign(dataset->metadata.locality_hints().begin(),
+               dataset->metadata.locality_hints().end());
+  return OkStatus();
+}
+
+Status DataServiceDispatcherImpl::WorkersForIteration(
+    std::shared_ptr<const Iteration> iteration,
+    std::vector<std::shared_ptr<const Worker>>& workers)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  workers = state_.ListWorkers();
+  if (iteration->job->num_consumers.has_value()) {
+    // Coordinated reads require a task on every worker so that consumers can
+    // keep their rounds aligned.
+    return OkStatus();
+  }
+  std::vector<std::string> locality_hints;
+  TF_RETURN_IF_ERROR(LocalityHintsForIteration(iteration, locality_hints));
+  if (locality_hints.empty()) {
+    return OkStatus();
+  }
+  std::vector<WorkerPlacementCandidate> candidates;
+  candidates.reserve(workers.size());
+  absl::flat_hash_map<std::string, std::shared_ptr<const Worker>>
+      workers_by_address;
+  for (const auto& worker : workers) {
+    WorkerPlacementCandidate candidate;
+    candidate.address = worker->address;
+    candidate.tags = worker->tags;
+    std::vector<std::shared_ptr<const Task>> tasks;
+    Status s = state_.TasksForWorker(worker->address, tasks);
+    if (s.ok()) {
+      candidate.active_tasks = tasks.size();
+    }
+    candidates.push_back(std::move(candidate));
+    workers_by_address[worker->address] = worker;
+  }
+  size_t num_placed = task_placement_policy_.Place(locality_hints, candidates);
+  workers.clear();
+  workers.reserve(num_placed);
+  for (size_t i = 0; i < num_placed; ++i) {
+    workers.push_back(workers_by_address[candidates[i].address]);
+  }
+  return OkStatus();
+}
+
 Status DataServiceDispatcherImpl::CreateTasksForIteration(
     std::shared_ptr<const Iteration> iteration,
     std::vector<std::shared_ptr<const Task>>& tasks)
     TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  std::vector<std::shared_ptr<const Worker>> workers = state_.ListWorkers();
+  std::vector<std::shared_ptr<const Worker>> workers;
+  TF_RETURN_IF_ERROR(WorkersForIteration(iteration, workers));
   tasks.clear();
   tasks.reserve(workers.size());
   for (const auto& worker : workers) {
@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/dispatcher.pb.h"
 #include "tensorflow/core/data/service/dispatcher_state.h"
 #include "tensorflow/core/data/service/export.pb.h"
+#include "tensorflow/core/data/service/task_placement.h"
 #include "tensorflow/core/data/service/task_remover.h"
 #include "tensorflow/core/data/service/worker.grpc.pb.h"
 #include "tensorflow/core/framework/dataset.h"
@@ -244,13 +245,24 @@ class DataServiceDispatcherImpl {
   Status AcquireIterationClientId(
       const std::shared_ptr<const DispatcherState::Iteration>& iteration,
       int64_t& iteration_client_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
-  // Creates one task for each worker, for the given iteration. The created
-  // tasks are stored in `tasks`. This method only updates dispatcher metadata
-  // with the new tasks, but doesn't assign the tasks to the workers.
+  // Creates one task per selected worker, for the given iteration. The
+  // created tasks are stored in `tasks`. This method only updates dispatcher
+  // metadata with the new tasks, but doesn't assign the tasks to the workers.
   Status CreateTasksForIteration(
       std::shared_ptr<const DispatcherState::Iteration> iteration,
       std::vector<std::shared_ptr<const DispatcherState::Task>>& tasks)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Stores the locality hints of the dataset read by `iteration` in `hints`.
+  Status LocalityHintsForIteration(
+      std::shared_ptr<const DispatcherState::Iteration> iteration,
+      std::vector<std::string>& hints) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Stores the workers that should run tasks for `iteration` in `workers`,
+  // most preferred first, taking the dataset's locality hints and current
+  // worker load into account.
+  Status WorkersForIteration(
+      std::shared_ptr<const DispatcherState::Iteration> iteration,
+      std::vector<std::shared_ptr<const DispatcherState::Worker>>& workers)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // Creates a new task for an iteration. The created task may be either pending
   // or active.
@@ -318,6 +330,8 @@ class DataServiceDispatcherImpl {
 
   const experimental::DispatcherConfig config_;
   Env* env_;
+  // Policy deciding which workers run the tasks of a new iteration.
+  const LocalityAwareTaskPlacementPolicy task_placement_policy_;
 
   mutable mutex mu_;
   bool started_ TF_GUARDED_BY(mu_) = false;
@@ -0,0 +1,286 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#if !defined(PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !defined(PLATFORM_WINDOWS)
+
+#include "absl/memory/memory.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x74666461746173686dULL;  // "tfdatashm"
+constexpr uint64_t kSegmentVersion = 1;
+
+// Header at the start of every segment, followed by `capacity_bytes` of
+// payload space. The atomics are shared between the writer process and reader
+// processes, so they must be lock-free.
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t capacity_bytes;
+  // The highest sequence number whose payload is fully written. Readers must
+  // not read records with a higher sequence.
+  std::atomic<uint64_t> published_sequence;
+  // The lowest sequence number whose payload is still intact. The writer
+  // advances this before overwriting a record's bytes; readers check it after
+  // copying a payload to detect torn reads.
+  std::atomic<uint64_t> oldest_live_sequence;
+};
+
+static_assert(std::is_trivially_destructible<SegmentHeader>::value,
+              "SegmentHeader must be trivially destructible to live in "
+              "shared memory.");
+
+SegmentHeader* Header(void* base) { return static_cast<SegmentHeader*>(base); }
+
+char* DataArea(void* base) {
+  return static_cast<char*>(base) + sizeof(SegmentHeader);
+}
+
+}  // namespace
+
+SharedMemoryRingBufferWriter::SharedMemoryRingBufferWriter(
+    std::string segment_name, void* base, size_t capacity_bytes)
+    : segment_name_(std::move(segment_name)),
+      base_(base),
+      capacity_bytes_(capacity_bytes) {}
+
+StatusOr<std::unique_ptr<SharedMemoryRingBufferWriter>>
+SharedMemoryRingBufferWriter::Create(const std::string& segment_name,
+                                     size_t capacity_bytes) {
+#if defined(PLATFORM_WINDOWS)
+  return errors::Unimplemented(
+      "Shared-memory ring buffers are not supported on this platform.");
+#else
+  if (segment_name.empty() || segment_name.front() != '/') {
+    return errors::InvalidArgument(
+        "Shared-memory segment names must begin with '/'. Got: ",
+        segment_name);
+  }
+  if (capacity_bytes == 0) {
+    return errors::InvalidArgument(
+        "Shared-memory ring buffer capacity must be greater than 0.");
+  }
+  int fd = shm_open(segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR,
+                    S_IRUSR | S_IWUSR);
+  if (fd < 0) {
+    return errors::Internal("Failed to create shared-memory segment ",
+                            segment_name, ": ", strerror(errno));
+  }
+  size_t segment_bytes = sizeof(SegmentHeader) + capacity_bytes;
+  if (ftruncate(fd, segment_bytes) != 0) {
+    close(fd);
+    shm_unlink(segment_name.c_str());
+    return errors::Internal("Failed to size shared-memory segment ",
+                            segment_name, " to ", segment_bytes,
+                            " bytes: ", strerror(errno));
+  }
+  void* base =
+      mmap(nullptr, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(segment_name.c_str());
+    return errors::Internal("Failed to map shared-memory segment ",
+                            segment_name, ": ", strerror(errno));
+  }
+  SegmentHeader* header = Header(base);
+  header->capacity_bytes = capacity_bytes;
+  header->published_sequence.store(0, std::memory_order_relaxed);
+  header->oldest_live_sequence.store(1, std::memory_order_relaxed);
+  header->version = kSegmentVersion;
+  // Set the magic last so readers never see a partially initialized header.
+  header->magic = kSegmentMagic;
+  VLOG(1) << "Created shared-memory ring buffer " << segment_name << " with "
+          << capacity_bytes << " bytes of payload space.";
+  return absl::WrapUnique(
+      new SharedMemoryRingBufferWriter(segment_name, base, capacity_bytes));
+#endif  // defined(PLATFORM_WINDOWS)
+}
+
+SharedMemoryRingBufferWriter::~SharedMemoryRingBufferWriter() {
+#if !defined(PLATFORM_WINDOWS)
+  munmap(base_, sizeof(SegmentHeader) + capacity_bytes_);
+  shm_unlink(segment_name_.c_str());
+#endif  // !defined(PLATFORM_WINDOWS)
+}
+
+void SharedMemoryRingBufferWriter::RetireOverlapping(uint64_t offset,
+                                                     uint64_t size) {
+  uint64_t max_retired_sequence = 0;
+  auto it = live_records_.begin();
+  while (it != live_records_.end()) {
+    if (it->offset < offset + size && offset < it->offset + it->size) {
+      max_retired_sequence = std::max(max_retired_sequence, it->sequence);
+      it = live_records_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (max_retired_sequence > 0) {
+    // Publish the retirement before the overwrite so readers copying the old
+    // bytes concurrently will notice.
+    Header(base_)->oldest_live_sequence.store(max_retired_sequence + 1,
+                                              std::memory_order_release);
+    // A release store only orders the accesses *before* it; the caller's
+    // overwriting memcpy comes after. The fence keeps the new payload bytes
+    // from becoming visible before the retirement store, pairing with the
+    // acquire fence in SharedMemoryRingBufferReader::Read(); without it a
+    // reader could copy torn bytes and still pass its re-check.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+StatusOr<SharedMemoryRecordHandle> SharedMemoryRingBufferWriter::Write(
+    StringPiece data) {
+  if (data.size() > capacity_bytes_) {
+    return errors::InvalidArgument(
+        "Record of ", data.size(),
+        " bytes does not fit in shared-memory ring buffer of capacity ",
+        capacity_bytes_, " bytes.");
+  }
+  if (next_offset_ + data.size() > capacity_bytes_) {
+    // Wrap around; retire any records in the tail we are skipping.
+    RetireOverlapping(next_offset_, capacity_bytes_ - next_offset_);
+    next_offset_ = 0;
+  }
+  RetireOverlapping(next_offset_, data.size());
+  std::memcpy(DataArea(base_) + next_offset_, data.data(), data.size());
+  SharedMemoryRecordHandle handle;
+  handle.segment_name = segment_name_;
+  handle.offset = next_offset_;
+  handle.size = data.size();
+  handle.sequence = next_sequence_;
+  live_records_.push_back(LiveRecord{handle.offset, handle.size,
+                                     handle.sequence});
+  next_offset_ += data.size();
+  ++next_sequence_;
+  // Publish the payload before the handle becomes readable.
+  Header(base_)->published_sequence.store(handle.sequence,
+                                          std::memory_order_release);
+  return handle;
+}
+
+SharedMemoryRingBufferReader::SharedMemoryRingBufferReader(
+    std::string segment_name, void* base, size_t capacity_bytes)
+    : segment_name_(std::move(segment_name)),
+      base_(base),
+      capacity_bytes_(capacity_bytes) {}
+
+StatusOr<std::unique_ptr<SharedMemoryRingBufferReader>>
+SharedMemoryRingBufferReader::Attach(const std::string& segment_name) {
+#if defined(PLATFORM_WINDOWS)
+  return errors::Unimplemented(
+      "Shared-memory ring buffers are not supported on this platform.");
+#else
+  if (segment_name.empty() || segment_name.front() != '/') {
+    return errors::InvalidArgument(
+        "Shared-memory segment names must begin with '/'. Got: ",
+        segment_name);
+  }
+  int fd = shm_open(segment_name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return errors::NotFound("Failed to open shared-memory segment ",
+                            segment_name, ": ", strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+    close(fd);
+    return errors::Internal("Shared-memory segment ", segment_name,
+                            " is smaller than its header.");
+  }
+  void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return errors::Internal("Failed to map shared-memory segment ",
+                            segment_name, ": ", strerror(errno));
+  }
+  SegmentHeader* header = Header(base);
+  if (header->magic != kSegmentMagic || header->version != kSegmentVersion) {
+    size_t segment_bytes = st.st_size;
+    munmap(base, segment_bytes);
+    return errors::FailedPrecondition(
+        "Shared-memory segment ", segment_name,
+        " is not a tf.data ring buffer or has an incompatible version.");
+  }
+  size_t capacity_bytes = header->capacity_bytes;
+  if (sizeof(SegmentHeader) + capacity_bytes >
+      static_cast<size_t>(st.st_size)) {
+    munmap(base, st.st_size);
+    return errors::Internal("Shared-memory segment ", segment_name,
+                            " is smaller than its declared capacity.");
+  }
+  VLOG(1) << "Attached to shared-memory ring buffer " << segment_name << ".";
+  return absl::WrapUnique(
+      new SharedMemoryRingBufferReader(segment_name, base, capacity_bytes));
+#endif  // defined(PLATFORM_WINDOWS)
+}
+
+SharedMemoryRingBufferReader::~SharedMemoryRingBufferReader() {
+#if !defined(PLATFORM_WINDOWS)
+  munmap(base_, sizeof(SegmentHeader) + capacity_bytes_);
+#endif  // !defined(PLATFORM_WINDOWS)
+}
+
+Status SharedMemoryRingBufferReader::Read(
+    const SharedMemoryRecordHandle& handle, tstring& out) const {
+  // Checked in two comparisons so a corrupt handle cannot wrap
+  // `offset + size` around uint64 and slip past the bounds check.
+  if (handle.size > capacity_bytes_ ||
+      handle.offset > capacity_bytes_ - handle.size) {
+    return errors::InvalidArgument(
+        "Shared-memory record at offset ", handle.offset, " with size ",
+        handle.size, " exceeds ring buffer capacity ", capacity_bytes_, ".");
+  }
+  SegmentHeader* header = Header(base_);
+  if (header->published_sequence.load(std::memory_order_acquire) <
+      handle.sequence) {
+    return errors::Aborted("Shared-memory record ", handle.sequence,
+                           " has not been published yet.");
+  }
+  out.resize_uninitialized(handle.size);
+  std::memcpy(out.mdata(), DataArea(base_) + handle.offset, handle.size);
+  // Order the payload reads above before the re-check below (an acquire
+  // load by itself only orders the accesses after it). Pairs with the fence
+  // in the writer's RetireOverlapping().
+  std::atomic_thread_fence(std::memory_order_acquire);
+  // If the record was retired while we copied it, the bytes may be torn.
+  if (header->oldest_live_sequence.load(std::memory_order_acquire) >
+      handle.sequence) {
+    return errors::Aborted("Shared-memory record ", handle.sequence,
+                           " has been overwritten by newer writes.");
+  }
+  return OkStatus();
+}
+
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,129 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_RING_BUFFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_RING_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/stringpiece.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace data {
+
+// A record stored in a shared-memory ring buffer. Handles are produced by
+// `SharedMemoryRingBufferWriter::Write` and are meant to be sent to same-host
+// readers over an RPC channel used only for coordination.
+struct SharedMemoryRecordHandle {
+  // The name of the shared-memory segment holding the record.
+  std::string segment_name;
+  // Byte offset of the record payload within the segment's data area.
+  uint64_t offset = 0;
+  // Size of the record payload in bytes.
+  uint64_t size = 0;
+  // Monotonically increasing sequence number identifying the record. Readers
+  // use it to detect records that have since been overwritten.
+  uint64_t sequence = 0;
+};
+
+// Single-writer ring buffer backed by a POSIX shared-memory segment. The
+// writer appends serialized records; same-host readers map the segment and
+// copy records out by handle. Old records are overwritten once the ring wraps,
+// so readers must tolerate `errors::Aborted` for records they read too late.
+//
+// The writer is not thread-safe; readers may read concurrently with the writer
+// and with each other. Shared-memory segments are only supported on POSIX
+// platforms; on other platforms, `Create` returns an Unimplemented error.
+class SharedMemoryRingBufferWriter {
+ public:
+  // Creates a shared-memory segment named `segment_name` (which must begin
+  // with '/') holding a ring buffer with `capacity_bytes` of payload space.
+  static StatusOr<std::unique_ptr<SharedMemoryRingBufferWriter>> Create(
+      const std::string& segment_name, size_t capacity_bytes);
+  // Unmaps and unlinks the segment. Readers that already mapped the segment
+  // keep their mapping until they are destroyed.
+  ~SharedMemoryRingBufferWriter();
+  SharedMemoryRingBufferWriter(const SharedMemoryRingBufferWriter&) = delete;
+  SharedMemoryRingBufferWriter& operator=(const SharedMemoryRingBufferWriter&) =
+      delete;
+
+  // Copies `data` into the ring buffer, overwriting the oldest records if
+  // there is not enough free space, and returns a handle for readers. Returns
+  // InvalidArgument if `data` is larger than the ring's capacity.
+  StatusOr<SharedMemoryRecordHandle> Write(StringPiece data);
+
+  const std::string& segment_name() const { return segment_name_; }
+
+ private:
+  SharedMemoryRingBufferWriter(std::string segment_name, void* base,
+                               size_t capacity_bytes);
+
+  // A live record within the ring, tracked so the writer knows which
+  // sequences are retired when their bytes are overwritten.
+  struct LiveRecord {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t sequence;
+  };
+
+  // Retires all live records overlapping [offset, offset + size).
+  void RetireOverlapping(uint64_t offset, uint64_t size);
+
+  const std::string segment_name_;
+  void* const base_;
+  const size_t capacity_bytes_;
+  uint64_t next_offset_ = 0;
+  uint64_t next_sequence_ = 1;
+  std::deque<LiveRecord> live_records_;
+};
+
+// Read-only view of a ring buffer created by `SharedMemoryRingBufferWriter`,
+// typically in a different process on the same host. Thread-safe.
+class SharedMemoryRingBufferReader {
+ public:
+  // Maps the shared-memory segment named `segment_name`. Returns NotFound if
+  // no such segment exists on this host.
+  static StatusOr<std::unique_ptr<SharedMemoryRingBufferReader>> Attach(
+      const std::string& segment_name);
+  ~SharedMemoryRingBufferReader();
+  SharedMemoryRingBufferReader(const SharedMemoryRingBufferReader&) = delete;
+  SharedMemoryRingBufferReader& operator=(const SharedMemoryRingBufferReader&) =
+      delete;
+
+  // Copies the record identified by `handle` into `out`. Returns Aborted if
+  // the record has been overwritten by newer writes, in which case the caller
+  // should re-request the data over the coordination channel.
+  Status Read(const SharedMemoryRecordHandle& handle, tstring& out) const;
+
+ private:
+  SharedMemoryRingBufferReader(std::string segment_name, void* base,
+                               size_t capacity_bytes);
+
+  const std::string segment_name_;
+  void* const base_;
+  const size_t capacity_bytes_;
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHARED_MEMORY_RING_BUFFER_H_
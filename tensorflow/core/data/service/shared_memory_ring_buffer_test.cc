@@ -0,0 +1,113 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shared_memory_ring_buffer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/status_matchers.h"
+#include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+using ::tensorflow::testing::StatusIs;
+
+std::string TestSegmentName() {
+  return strings::StrCat("/tf_data_test_", random::New64());
+}
+
+TEST(SharedMemoryRingBufferTest, WriteThenRead) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<SharedMemoryRingBufferWriter> writer,
+      SharedMemoryRingBufferWriter::Create(TestSegmentName(), 1024));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<SharedMemoryRingBufferReader> reader,
+      SharedMemoryRingBufferReader::Attach(writer->segment_name()));
+
+  std::vector<std::string> records = {"hello", "", "world",
+                                      std::string(100, 'x')};
+  std::vector<SharedMemoryRecordHandle> handles;
+  for (const std::string& record : records) {
+    TF_ASSERT_OK_AND_ASSIGN(SharedMemoryRecordHandle handle,
+                            writer->Write(record));
+    handles.push_back(handle);
+  }
+  for (size_t i = 0; i < records.size(); ++i) {
+    tstring data;
+    TF_ASSERT_OK(reader->Read(handles[i], data));
+    EXPECT_EQ(data, records[i]);
+  }
+}
+
+TEST(SharedMemoryRingBufferTest, OverwrittenRecordsAreAborted) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<SharedMemoryRingBufferWriter> writer,
+      SharedMemoryRingBufferWriter::Create(TestSegmentName(), 10));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<SharedMemoryRingBufferReader> reader,
+      SharedMemoryRingBufferReader::Attach(writer->segment_name()));
+
+  TF_ASSERT_OK_AND_ASSIGN(SharedMemoryRecordHandle first,
+                          writer->Write("aaaaaa"));
+  // Wraps around and overwrites the first record.
+  TF_ASSERT_OK_AND_ASSIGN(SharedMemoryRecordHandle second,
+                          writer->Write("bbbbbb"));
+
+  tstring data;
+  EXPECT_THAT(reader->Read(first, data), StatusIs(error::ABORTED));
+  TF_ASSERT_OK(reader->Read(second, data));
+  EXPECT_EQ(data, "bbbbbb");
+}
+
+TEST(SharedMemoryRingBufferTest, RecordLargerThanCapacity) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<SharedMemoryRingBufferWriter> writer,
+      SharedMemoryRingBufferWriter::Create(TestSegmentName(), 10));
+  EXPECT_THAT(writer->Write(std::string(11, 'x')).status(),
+              StatusIs(error::INVALID_ARGUMENT));
+}
+
+TEST(SharedMemoryRingBufferTest, AttachMissingSegment) {
+  EXPECT_THAT(SharedMemoryRingBufferReader::Attach(TestSegmentName()).status(),
+              StatusIs(error::NOT_FOUND));
+}
+
+TEST(SharedMemoryRingBufferTest, InvalidSegmentName) {
+  EXPECT_THAT(
+      SharedMemoryRingBufferWriter::Create("missing_leading_slash", 10)
+          .status(),
+      StatusIs(error::INVALID_ARGUMENT));
+}
+
+TEST(SharedMemoryRingBufferTest, SegmentIsUnlinkedOnDestruction) {
+  std::string segment_name = TestSegmentName();
+  {
+    TF_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<SharedMemoryRingBufferWriter> writer,
+        SharedMemoryRingBufferWriter::Create(segment_name, 10));
+  }
+  EXPECT_THAT(SharedMemoryRingBufferReader::Attach(segment_name).status(),
+              StatusIs(error::NOT_FOUND));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,75 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/task_placement.h"
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+
+namespace tensorflow {
+namespace data {
+
+bool MatchesLocalityHints(const std::vector<std::string>& tags,
+                          const std::vector<std::string>& locality_hints) {
+  if (locality_hints.empty()) {
+    return true;
+  }
+  for (const std::string& hint : locality_hints) {
+    if (std::find(tags.begin(), tags.end(), hint) != tags.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t LocalityAwareTaskPlacementPolicy::Place(
+    const std::vector<std::string>& locality_hints,
+    std::vector<WorkerPlacementCandidate>& candidates) const {
+  absl::flat_hash_set<std::string> hints(locality_hints.begin(),
+                                         locality_hints.end());
+  auto num_matching_hints = [&hints](const WorkerPlacementCandidate& c) {
+    size_t matches = 0;
+    for (const std::string& tag : c.tags) {
+      if (hints.contains(tag)) {
+        ++matches;
+      }
+    }
+    return matches;
+  };
+  std::sort(candidates.begin(), candidates.end(),
+            [&](const WorkerPlacementCandidate& a,
+                const WorkerPlacementCandidate& b) {
+              return std::make_tuple(num_matching_hints(b), a.active_tasks,
+                                     a.address) <
+                     std::make_tuple(num_matching_hints(a), b.active_tasks,
+                                     b.address);
+            });
+  if (hints.empty() || candidates.empty() ||
+      num_matching_hints(candidates.front()) == 0) {
+    return candidates.size();
+  }
+  size_t num_placed = 0;
+  while (num_placed < candidates.size() &&
+         num_matching_hints(candidates[num_placed]) > 0) {
+    ++num_placed;
+  }
+  return num_placed;
+}
+
+}  // namespace data
+}  // namespace tensorflow
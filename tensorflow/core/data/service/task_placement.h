@@ -0,0 +1,72 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_TASK_PLACEMENT_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_TASK_PLACEMENT_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace data {
+
+// A candidate worker for placing a new task.
+struct WorkerPlacementCandidate {
+  // The worker's address.
+  std::string address;
+  // Tags attached to the worker at registration. Tags double as locality
+  // hints, e.g. a file system, region, or cache identifier.
+  std::vector<std::string> tags;
+  // The number of tasks currently assigned to the worker.
+  int64_t active_tasks = 0;
+};
+
+// Returns whether a worker with `tags` matches at least one of
+// `locality_hints`. An empty hint list matches every worker.
+bool MatchesLocalityHints(const std::vector<std::string>& tags,
+                          const std::vector<std::string>& locality_hints);
+
+// Interface for policies deciding which workers should run the tasks of an
+// iteration. Implementations must be thread-safe.
+class TaskPlacementPolicy {
+ public:
+  virtual ~TaskPlacementPolicy() = default;
+
+  // Orders `candidates` from most to least preferred for a dataset whose
+  // source data is described by `locality_hints`, and returns how many of the
+  // leading candidates the dispatcher should place tasks on.
+  virtual size_t Place(
+      const std::vector<std::string>& locality_hints,
+      std::vector<WorkerPlacementCandidate>& candidates) const = 0;
+};
+
+// The default placement policy. Workers whose tags match more locality hints
+// come first; ties are broken by lower active task count, then by address for
+// determinism. When any candidate matches the hints, placement is restricted
+// to the matching candidates; when none do, all candidates are used so that
+// a dataset never loses workers to a misconfigured hint.
+class LocalityAwareTaskPlacementPolicy : public TaskPlacementPolicy {
+ public:
+  size_t Place(
+      const std::vector<std::string>& locality_hints,
+      std::vector<WorkerPlacementCandidate>& candidates) const override;
+};
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_TASK_PLACEMENT_H_
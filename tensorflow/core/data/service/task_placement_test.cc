@@ -0,0 +1,95 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/task_placement.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+WorkerPlacementCandidate Candidate(const std::string& address,
+                                   const std::vector<std::string>& tags,
+                                   int64_t active_tasks) {
+  WorkerPlacementCandidate candidate;
+  candidate.address = address;
+  candidate.tags = tags;
+  candidate.active_tasks = active_tasks;
+  return candidate;
+}
+
+TEST(TaskPlacementTest, MatchesLocalityHints) {
+  EXPECT_TRUE(MatchesLocalityHints(/*tags=*/{}, /*locality_hints=*/{}));
+  EXPECT_TRUE(MatchesLocalityHints(/*tags=*/{"region_a"},
+                                   /*locality_hints=*/{}));
+  EXPECT_TRUE(MatchesLocalityHints(/*tags=*/{"region_a", "ssd"},
+                                   /*locality_hints=*/{"region_a"}));
+  EXPECT_FALSE(MatchesLocalityHints(/*tags=*/{"region_b"},
+                                    /*locality_hints=*/{"region_a"}));
+  EXPECT_FALSE(MatchesLocalityHints(/*tags=*/{},
+                                    /*locality_hints=*/{"region_a"}));
+}
+
+TEST(TaskPlacementTest, EmptyHintsPlaceOnAllWorkers) {
+  LocalityAwareTaskPlacementPolicy policy;
+  std::vector<WorkerPlacementCandidate> candidates = {
+      Candidate("worker_b", {"region_b"}, /*active_tasks=*/5),
+      Candidate("worker_a", {"region_a"}, /*active_tasks=*/0),
+  };
+  EXPECT_EQ(policy.Place(/*locality_hints=*/{}, candidates), 2);
+}
+
+TEST(TaskPlacementTest, MatchingWorkersComeFirst) {
+  LocalityAwareTaskPlacementPolicy policy;
+  std::vector<WorkerPlacementCandidate> candidates = {
+      Candidate("worker_a", {"region_a"}, /*active_tasks=*/0),
+      Candidate("worker_b", {"region_b"}, /*active_tasks=*/0),
+      Candidate("worker_c", {"region_b", "ssd"}, /*active_tasks=*/0),
+  };
+  EXPECT_EQ(policy.Place(/*locality_hints=*/{"region_b", "ssd"}, candidates),
+            2);
+  EXPECT_EQ(candidates[0].address, "worker_c");
+  EXPECT_EQ(candidates[1].address, "worker_b");
+  EXPECT_EQ(candidates[2].address, "worker_a");
+}
+
+TEST(TaskPlacementTest, TiesBrokenByLoadThenAddress) {
+  LocalityAwareTaskPlacementPolicy policy;
+  std::vector<WorkerPlacementCandidate> candidates = {
+      Candidate("worker_c", {"region_a"}, /*active_tasks=*/2),
+      Candidate("worker_b", {"region_a"}, /*active_tasks=*/0),
+      Candidate("worker_a", {"region_a"}, /*active_tasks=*/0),
+  };
+  EXPECT_EQ(policy.Place(/*locality_hints=*/{"region_a"}, candidates), 3);
+  EXPECT_EQ(candidates[0].address, "worker_a");
+  EXPECT_EQ(candidates[1].address, "worker_b");
+  EXPECT_EQ(candidates[2].address, "worker_c");
+}
+
+TEST(TaskPlacementTest, FallsBackToAllWorkersWhenNoneMatch) {
+  LocalityAwareTaskPlacementPolicy policy;
+  std::vector<WorkerPlacementCandidate> candidates = {
+      Candidate("worker_a", {"region_a"}, /*active_tasks=*/0),
+      Candidate("worker_b", {"region_b"}, /*active_tasks=*/0),
+  };
+  EXPECT_EQ(policy.Place(/*locality_hints=*/{"region_c"}, candidates), 2);
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -32,6 +32,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/credentials_factory.h"
 #include "tensorflow/core/data/service/data_transfer.h"
 #include "tensorflow/core/data/service/grpc_util.h"
+#include "tensorflow/core/data/service/shared_memory_ring_buffer.h"
 #include "tensorflow/core/data/service/worker.grpc.pb.h"
 #include "tensorflow/core/data/service/worker.pb.h"
 #include "tensorflow/core/data/service/worker_impl.h"
@@ -101,47 +102,65 @@ class GrpcDataTransferClient : public DataTransferClient {
                     GetElementResult& result) override {
     VLOG(3) << "GetElement for task " << req.task_id() << " from gRPC worker "
             << "server.";
-    {
-      mutex_lock l(mu_);
-      if (cancelled_) {
-        return errors::Cancelled("Client was cancelled.");
+    GetElementRequest request = req;
+    while (true) {
+      {
+        mutex_lock l(mu_);
+        if (cancelled_) {
+          return errors::Cancelled("Client was cancelled.");
+        }
+        request.set_allow_shared_memory(shm_reader_ != nullptr);
       }
-    }
-    grpc::ClientContext ctx;
-    {
-      mutex_lock l(mu_);
-      active_contexts_.insert(&ctx);
-    }
-    GetElementResponse resp;
-    grpc::Status s = stub_->GetElement(&ctx, req, &resp);
-    result.end_of_sequence = resp.end_of_sequence();
-    result.skip = resp.skip_task();
-    switch (resp.element_case()) {
-      case GetElementResponse::kCompressed: {
-        Tensor tensor(DT_VARIANT, TensorShape{});
-        tensor.scalar<Variant>()() = std::move(resp.compressed());
-        result.components.push_back(tensor);
-        break;
+      grpc::ClientContext ctx;
+      {
+        mutex_lock l(mu_);
+        active_contexts_.insert(&ctx);
       }
-      case GetElementResponse::kUncompressed:
-        for (const auto& component : resp.uncompressed().components()) {
-          result.components.emplace_back();
-          if (!result.components.back().FromProto(component)) {
-            return errors::Internal("Failed to parse tensor.");
+      GetElementResponse resp;
+      grpc::Status s = stub_->GetElement(&ctx, request, &resp);
+      {
+        mutex_lock l(mu_);
+        active_contexts_.erase(&ctx);
+      }
+      if (!s.ok()) {
+        return grpc_util::WrapError("Failed to get element", s);
+      }
+      MaybeAttachSharedMemory(resp);
+      result.end_of_sequence = resp.end_of_sequence();
+      result.skip = resp.skip_task();
+      switch (resp.element_case()) {
+        case GetElementResponse::kCompressed: {
+          Tensor tensor(DT_VARIANT, TensorShape{});
+          tensor.scalar<Variant>()() = std::move(resp.compressed());
+          result.components.push_back(tensor);
+          break;
+        }
+        case GetElementResponse::kUncompressed:
+          for (const auto& component : resp.uncompressed().components()) {
+            result.components.emplace_back();
+            if (!result.components.back().FromProto(component)) {
+              return errors::Internal("Failed to parse tensor.");
+            }
           }
+          break;
+        case GetElementResponse::kSharedMemory: {
+          Status read_status =
+              ReadSharedMemoryElement(resp.shared_memory(), result);
+          if (errors::IsAborted(read_status)) {
+            // The record was overwritten before we could read it. Request
+            // again; the worker will serve a newer element.
+            VLOG(1) << "Retrying GetElement for task " << req.task_id() << ": "
+                    << read_status;
+            continue;
+          }
+          TF_RETURN_IF_ERROR(read_status);
+          break;
         }
-        break;
-      case GetElementResponse::ELEMENT_NOT_SET:
-        break;
-    }
-    {
-      mutex_lock l(mu_);
-      active_contexts_.erase(&ctx);
-    }
-    if (!s.ok()) {
-      return grpc_util::WrapError("Failed to get element", s);
+        case GetElementResponse::ELEMENT_NOT_SET:
+          break;
+      }
+      return OkStatus();
     }
-    return OkStatus();
   }
 
   void TryCancel() override {
@@ -154,12 +173,70 @@ class GrpcDataTransferClient : public DataTransferClient {
   }
 
  private:
+  // If the worker advertises a shared-memory segment we haven't tried to map
+  // yet, attempts to map it. Mapping fails when the worker runs on a different
+  // host; in that case elements keep being sent inline.
+  void MaybeAttachSharedMemory(const GetElementResponse& resp)
+      TF_LOCKS_EXCLUDED(mu_) {
+    if (resp.shm_segment_name().empty()) {
+      return;
+    }
+    mutex_lock l(mu_);
+    if (shm_reader_ != nullptr || shm_attach_failed_) {
+      return;
+    }
+    StatusOr<std::unique_ptr<SharedMemoryRingBufferReader>> reader =
+        SharedMemoryRingBufferReader::Attach(resp.shm_segment_name());
+    if (reader.ok()) {
+      VLOG(1) << "Reading elements through shared-memory segment "
+              << resp.shm_segment_name() << ".";
+      shm_reader_ = *std::move(reader);
+    } else {
+      VLOG(1) << "Worker is not reachable through shared memory: "
+              << reader.status();
+      shm_attach_failed_ = true;
+    }
+  }
+
+  // Copies the element referenced by `element` out of the worker's
+  // shared-memory ring buffer into `result`.
+  Status ReadSharedMemoryElement(const SharedMemoryElement& element,
+                                 GetElementResult& result)
+      TF_LOCKS_EXCLUDED(mu_) {
+    mutex_lock l(mu_);
+    if (shm_reader_ == nullptr) {
+      return errors::Internal(
+          "Received a shared-memory element without a mapped segment.");
+    }
+    SharedMemoryRecordHandle handle;
+    handle.offset = element.offset();
+    handle.size = element.size();
+    handle.sequence = element.sequence();
+    tstring data;
+    TF_RETURN_IF_ERROR(shm_reader_->Read(handle, data));
+    CompressedElement compressed;
+    if (!compressed.ParseFromArray(data.data(), data.size())) {
+      return errors::Internal(
+          "Failed to parse compressed element from shared memory.");
+    }
+    Tensor tensor(DT_VARIANT, TensorShape{});
+    tensor.scalar<Variant>()() = std::move(compressed);
+    result.components.push_back(tensor);
+    return OkStatus();
+  }
+
   mutex mu_;
   std::unique_ptr<WorkerService::Stub> stub_;
   // Set of all currently active clients contexts. Used to support
   // cancellation.
   absl::flat_hash_set<::grpc::ClientContext*> active_contexts_
       TF_GUARDED_BY(mu_);
+  // Reader for the worker's shared-memory ring buffer. Null until the worker
+  // advertises a segment and it is successfully mapped.
+  std::unique_ptr<SharedMemoryRingBufferReader> shm_reader_ TF_GUARDED_BY(mu_);
+  // True if mapping the worker's shared-memory segment failed, e.g. because
+  // the worker runs on a different host.
+  bool shm_attach_failed_ TF_GUARDED_BY(mu_) = false;
   // Indicates that the client has been cancelled, so no further requests should
   // be accepted.
   bool cancelled_ TF_GUARDED_BY(mu_) = false;
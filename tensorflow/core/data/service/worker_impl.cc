@@ -23,6 +23,7 @@ limitations under the License.
 #include "grpcpp/create_channel.h"
 #include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
@@ -40,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/dispatcher_client.h"
 #include "tensorflow/core/data/service/export.pb.h"
 #include "tensorflow/core/data/service/grpc_util.h"
+#include "tensorflow/core/data/service/shared_memory_ring_buffer.h"
 #include "tensorflow/core/data/service/split_provider.h"
 #include "tensorflow/core/data/service/task_runner.h"
 #include "tensorflow/core/data/service/utils.h"
@@ -58,10 +60,12 @@ limitations under the License.
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/snappy.h"
 #include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/protobuf/service_config.pb.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -71,6 +75,12 @@ constexpr absl::Duration kRetryInterval = absl::Seconds(5);
 constexpr absl::Duration kDefaultHeartBeatInterval = absl::Seconds(30);
 constexpr absl::Duration kDefaultDispatcherTimeout = absl::Hours(1);
 
+// Size in bytes of the shared-memory ring buffer used to serve cached
+// elements to same-host clients. 0 (the default) disables shared-memory
+// transfer.
+constexpr const char kShmTransferBytesEnv[] =
+    "TF_DATA_SERVICE_SHM_TRANSFER_BYTES";
+
 using WorkerConfig = experimental::WorkerConfig;
 
 // Moves the element into the response. If the tensor contains a single
@@ -171,6 +181,25 @@ Status DataServiceWorkerImpl::Start(const std::string& worker_address,
       config_.dispatcher_address(), config_.protocol());
   TF_RETURN_IF_ERROR(dispatcher_->Initialize());
 
+  int64_t shm_transfer_bytes = 0;
+  TF_RETURN_IF_ERROR(ReadInt64FromEnvVar(kShmTransferBytesEnv,
+                                         /*default_val=*/0,
+                                         &shm_transfer_bytes));
+  if (shm_transfer_bytes > 0) {
+    std::string segment_name =
+        absl::StrCat("/tf_data_worker_", random::New64());
+    StatusOr<std::unique_ptr<SharedMemoryRingBufferWriter>> shm_writer =
+        SharedMemoryRingBufferWriter::Create(segment_name, shm_transfer_bytes);
+    if (shm_writer.ok()) {
+      mutex_lock l(shm_mu_);
+      shm_writer_ = *std::move(shm_writer);
+    } else {
+      // Shared memory is an optimization; fall back to inline responses.
+      LOG(WARNING) << "Failed to enable shared-memory element transfer: "
+                   << shm_writer.status();
+    }
+  }
+
   Status s = Heartbeat();
   while (!s.ok()) {
     if (!IsPreemptedError(s)) {
@@ -423,6 +452,38 @@ Status DataServiceWorkerImpl::GetElement(const GetElementRequest* request,
         MoveElementToResponse(std::move(result.components), *response));
     VLOG(3) << "Producing an element for task " << request->task_id();
   }
+  TF_RETURN_IF_ERROR(MaybeMoveElementToSharedMemory(*request, *response));
+  return OkStatus();
+}
+
+Status DataServiceWorkerImpl::MaybeMoveElementToSharedMemory(
+    const GetElementRequest& request, GetElementResponse& response)
+    TF_LOCKS_EXCLUDED(shm_mu_) {
+  mutex_lock l(shm_mu_);
+  if (shm_writer_ == nullptr) {
+    return OkStatus();
+  }
+  // Advertise the segment so same-host clients can map it and opt in.
+  response.set_shm_segment_name(shm_writer_->segment_name());
+  if (!request.allow_shared_memory() ||
+      response.element_case() != GetElementResponse::kCompressed) {
+    return OkStatus();
+  }
+  std::string serialized;
+  if (!response.compressed().SerializeToString(&serialized)) {
+    return errors::Internal(
+        "Failed to serialize compressed element for shared-memory transfer.");
+  }
+  StatusOr<SharedMemoryRecordHandle> handle = shm_writer_->Write(serialized);
+  if (!handle.ok()) {
+    // The element may be larger than the ring; send it inline instead.
+    VLOG(1) << "Falling back to inline element transfer: " << handle.status();
+    return OkStatus();
+  }
+  SharedMemoryElement* shared_memory = response.mutable_shared_memory();
+  shared_memory->set_offset(handle->offset);
+  shared_memory->set_size(handle->size);
+  shared_memory->set_sequence(handle->sequence);
   return OkStatus();
 }
 
@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/data/service/dispatcher.grpc.pb.h"
 #include "tensorflow/core/data/service/dispatcher_client.h"
 #include "tensorflow/core/data/service/export.pb.h"
+#include "tensorflow/core/data/service/shared_memory_ring_buffer.h"
 #include "tensorflow/core/data/service/task_runner.h"
 #include "tensorflow/core/data/service/worker.pb.h"
 #include "tensorflow/core/data/standalone.h"
@@ -121,6 +122,13 @@ class DataServiceWorkerImpl {
   // Creates an iterator for `dataset`.
   StatusOr<std::unique_ptr<standalone::Iterator>> MakeDatasetIterator(
       standalone::Dataset& dataset, const TaskDef& task_def) const;
+  // If shared-memory transfer is enabled, publishes the response's compressed
+  // element into the shared-memory ring buffer and replaces it with a
+  // `SharedMemoryElement` handle. No-op if the response holds no compressed
+  // element or the client has not mapped the segment.
+  Status MaybeMoveElementToSharedMemory(const GetElementRequest& request,
+                                        GetElementResponse& response)
+      TF_LOCKS_EXCLUDED(shm_mu_);
 
   const experimental::WorkerConfig config_;
   // Worker Borg job UID for telemetry. -1 if not supported.
@@ -150,6 +158,13 @@ class DataServiceWorkerImpl {
   condition_variable heartbeat_cv_ TF_GUARDED_BY(mu_);
   CancellationManager cancellation_manager_;
 
+  // Shared-memory ring buffer for serving cached elements to same-host
+  // clients without loopback serialization. Null if shared-memory transfer is
+  // disabled.
+  mutable mutex shm_mu_;
+  std::unique_ptr<SharedMemoryRingBufferWriter> shm_writer_
+      TF_GUARDED_BY(shm_mu_);
+
   // A thread for notifying the dispatcher when tasks complete.
   std::unique_ptr<Thread> task_completion_thread_;
   // A thread for performing regular heartbeats to the dispatcher.
@@ -42,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/snapshot.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_inputbuffer.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_outputbuffer.h"
 
@@ -150,6 +151,24 @@ Status TFRecordWriter::WriteTensors(const std::vector<Tensor>& tensors) {
   return OkStatus();
 }
 
+Status TFRecordWriter::EncodeTensors(const std::vector<Tensor>& tensors,
+                                     std::vector<tstring>* records) const {
+  for (const auto& tensor : tensors) {
+    TensorProto proto;
+    tensor.AsProtoTensorContent(&proto);
+    records->emplace_back(proto.SerializeAsString());
+  }
+  return OkStatus();
+}
+
+Status TFRecordWriter::WriteRecords(const std::vector<tstring>& records) {
+  for (const auto& record : records) {
+    TF_RETURN_IF_ERROR(record_writer_->WriteRecord(
+        StringPiece(record.data(), record.size())));
+  }
+  return OkStatus();
+}
+
 Status TFRecordWriter::Sync() {
   TF_RETURN_IF_ERROR(record_writer_->Flush());
   return dest_->Flush();
@@ -297,6 +316,79 @@ Status CustomWriter::WriteTensors(const std::vector<Tensor>& tensors) {
   return OkStatus();
 }
 
+Status CustomWriter::EncodeTensors(const std::vector<Tensor>& tensors,
+                                   std::vector<tstring>* records) const {
+  if (compression_type_ != io::compression::kSnappy) {
+    experimental::SnapshotRecord record;
+    for (const auto& tensor : tensors) {
+      TensorProto* t = record.add_tensor();
+      tensor.AsProtoTensorContent(t);
+    }
+    records->emplace_back(record.SerializeAsString());
+    return OkStatus();
+  }
+
+  std::vector<const TensorBuffer*> tensor_buffers;
+  tensor_buffers.reserve(num_simple_);
+  std::vector<TensorProto> tensor_protos;
+  tensor_protos.reserve(num_complex_);
+  experimental::SnapshotTensorMetadata metadata;
+  int64_t total_size = 0;
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    const Tensor& tensor = tensors[i];
+    experimental::TensorMetadata* tensor_metadata =
+        metadata.add_tensor_metadata();
+    tensor.shape().AsProto(tensor_metadata->mutable_tensor_shape());
+    int64_t size = 0;
+    if (simple_tensor_mask_[i]) {
+      auto tensor_buffer = DMAHelper::buffer(&tensor);
+      tensor_buffers.push_back(tensor_buffer);
+      size = tensor_buffer->size();
+    } else {
+      TensorProto proto;
+      tensor.AsProtoTensorContent(&proto);
+      size = proto.ByteSizeLong();
+      tensor_protos.push_back(std::move(proto));
+    }
+    tensor_metadata->set_tensor_size_bytes(size);
+    total_size += size;
+  }
+
+  std::vector<char> uncompressed(total_size);
+  char* position = uncompressed.data();
+  int buffer_index = 0;
+  int proto_index = 0;
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    const auto& tensor_metadata = metadata.tensor_metadata(i);
+    if (simple_tensor_mask_[i]) {
+      memcpy(position, tensor_buffers[buffer_index]->data(),
+             tensor_metadata.tensor_size_bytes());
+      buffer_index++;
+    } else {
+      tensor_protos[proto_index].SerializeToArray(
+          position, tensor_metadata.tensor_size_bytes());
+      proto_index++;
+    }
+    position += tensor_metadata.tensor_size_bytes();
+  }
+  DCHECK_EQ(position, uncompressed.data() + total_size);
+
+  string output;
+  if (!tsl::port::Snappy_Compress(uncompressed.data(), total_size, &output)) {
+    return errors::Internal("Failed to compress using snappy.");
+  }
+  records->emplace_back(metadata.SerializeAsString());
+  records->emplace_back(std::move(output));
+  return OkStatus();
+}
+
+Status CustomWriter::WriteRecords(const std::vector<tstring>& records) {
+  for (const auto& record : records) {
+    TF_RETURN_IF_ERROR(WriteRecord(StringPiece(record.data(), record.size())));
+  }
+  return OkStatus();
+}
+
 Status CustomWriter::Sync() { return dest_->Sync(); }
 
 Status CustomWriter::Close() {
@@ -1029,66 +1121,197 @@ Status DetermineOpState(const std::string& mode_string, bool file_exists,
   }
 }
 
+namespace {
+
+// Number of threads encoding snapshot elements per `AsyncWriter`.
+constexpr const char kSnapshotEncoderThreadsEnv[] =
+    "TF_DATA_SNAPSHOT_ENCODER_THREADS";
+constexpr int64_t kDefaultSnapshotEncoderThreads = 2;
+// Number of bytes an `AsyncWriter` buffers ahead of its IO thread before
+// `Write` blocks.
+constexpr const char kSnapshotWriterBufferBytesEnv[] =
+    "TF_DATA_SNAPSHOT_WRITER_BUFFER_BYTES";
+constexpr int64_t kDefaultSnapshotWriterBufferBytes = 256 << 20;  // 256MB.
+
+}  // namespace
+
 AsyncWriter::AsyncWriter(Env* env, int64_t file_index,
                          const std::string& shard_directory,
                          uint64 checkpoint_id, const std::string& compression,
                          int64_t version, const DataTypeVector& output_types,
                          std::function<void(Status)> done) {
-  thread_ = absl::WrapUnique(env->StartThread(
+  int64_t num_encoder_threads = kDefaultSnapshotEncoderThreads;
+  Status s =
+      ReadInt64FromEnvVar(kSnapshotEncoderThreadsEnv,
+                          kDefaultSnapshotEncoderThreads, &num_encoder_threads);
+  int64_t max_buffered_bytes = kDefaultSnapshotWriterBufferBytes;
+  s.Update(ReadInt64FromEnvVar(kSnapshotWriterBufferBytesEnv,
+                               kDefaultSnapshotWriterBufferBytes,
+                               &max_buffered_bytes));
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to read snapshot writer configuration: " << s;
+  }
+  num_encoder_threads = std::max<int64_t>(num_encoder_threads, 1);
+  max_buffered_bytes_ = std::max<int64_t>(max_buffered_bytes, 1);
+  num_active_encoders_ = num_encoder_threads;
+  threads_.reserve(num_encoder_threads + 1);
+  for (int64_t i = 0; i < num_encoder_threads; ++i) {
+    threads_.push_back(absl::WrapUnique(env->StartThread(
+        ThreadOptions(), absl::StrCat("snapshot_encoder_", file_index, "_", i),
+        [this] { EncoderThread(); })));
+  }
+  threads_.push_back(absl::WrapUnique(env->StartThread(
       ThreadOptions(), absl::StrCat("writer_thread_", file_index),
       [this, env, shard_directory, checkpoint_id, compression, version,
        &output_types, done = std::move(done)] {
         done(WriterThread(env, shard_directory, checkpoint_id, compression,
                           version, output_types));
-      }));
+      })));
 }
 
 void AsyncWriter::Write(const std::vector<Tensor>& tensors) {
   mutex_lock l(mu_);
-  ElementOrEOF element;
-  element.value = tensors;
-  deque_.push_back(std::move(element));
+  while (!failed_ && input_bytes_ >= max_buffered_bytes_) {
+    cv_.wait(l);
+  }
+  if (failed_) {
+    // The writer already failed; the error is reported through `done`.
+    return;
+  }
+  SequencedElement element;
+  element.sequence = next_sequence_++;
+  element.element.value = tensors;
+  for (const Tensor& tensor : tensors) {
+    element.size_bytes += tensor.TotalBytes();
+  }
+  input_bytes_ += element.size_bytes;
+  input_.push_back(std::move(element));
+  cv_.notify_all();
 }
 
 void AsyncWriter::SignalEOF() {
   mutex_lock l(mu_);
-  ElementOrEOF be;
-  be.end_of_sequence = true;
-  deque_.push_back(std::move(be));
+  SequencedElement element;
+  element.sequence = next_sequence_++;
+  element.element.end_of_sequence = true;
+  eof_sequence_ = element.sequence;
+  input_.push_back(std::move(element));
+  cv_.notify_all();
 }
 
-void AsyncWriter::Consume(ElementOrEOF* be) {
+void AsyncWriter::Fail() {
   mutex_lock l(mu_);
-  mu_.Await(tensorflow::Condition(this, &AsyncWriter::ElementAvailable));
-  *be = deque_.front();
-  deque_.pop_front();
+  failed_ = true;
+  input_.clear();
+  input_bytes_ = 0;
+  cv_.notify_all();
 }
 
-bool AsyncWriter::ElementAvailable() { return !deque_.empty(); }
+void AsyncWriter::EncoderThread() {
+  {
+    // Wait until the IO thread has created the writer (or failed to).
+    mutex_lock l(mu_);
+    while (writer_ == nullptr && !failed_) {
+      cv_.wait(l);
+    }
+  }
+  while (true) {
+    SequencedElement element;
+    Writer* writer = nullptr;
+    {
+      mutex_lock l(mu_);
+      while (input_.empty() && !failed_ && eof_sequence_ < 0) {
+        cv_.wait(l);
+      }
+      if (input_.empty()) {
+        // Either the writer failed or the end-of-input marker has already
+        // been dequeued by another encoder.
+        break;
+      }
+      element = std::move(input_.front());
+      input_.pop_front();
+      writer = writer_;
+    }
+    EncodedElement encoded;
+    encoded.size_bytes = element.size_bytes;
+    if (!element.element.end_of_sequence) {
+      encoded.status = writer->EncodeTensors(element.element.value,
+                                             &encoded.records);
+      if (errors::IsUnimplemented(encoded.status)) {
+        // The writer's format only supports encoding on the IO thread.
+        encoded.status = OkStatus();
+        encoded.records.clear();
+        encoded.raw = std::move(element.element.value);
+        encoded.use_raw = true;
+      }
+    }
+    mutex_lock l(mu_);
+    encoded_[element.sequence] = std::move(encoded);
+    cv_.notify_all();
+  }
+  mutex_lock l(mu_);
+  --num_active_encoders_;
+  cv_.notify_all();
+}
 
 Status AsyncWriter::WriterThread(Env* env, const std::string& shard_directory,
                                  uint64 checkpoint_id,
                                  const std::string& compression,
                                  int64_t version, DataTypeVector output_types) {
   std::unique_ptr<snapshot_util::Writer> writer;
-  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(shard_directory));
-
-  TF_RETURN_IF_ERROR(snapshot_util::Writer::Create(
-      env, GetCheckpointFileName(shard_directory, checkpoint_id), compression,
-      version, std::move(output_types), &writer));
-
-  while (true) {
-    ElementOrEOF be;
-    Consume(&be);
-
-    if (be.end_of_sequence) {
-      TF_RETURN_IF_ERROR(writer->Close());
+  Status status = env->RecursivelyCreateDir(shard_directory);
+  if (status.ok()) {
+    status = snapshot_util::Writer::Create(
+        env, GetCheckpointFileName(shard_directory, checkpoint_id), compression,
+        version, std::move(output_types), &writer);
+  }
+  if (status.ok()) {
+    mutex_lock l(mu_);
+    writer_ = writer.get();
+    cv_.notify_all();
+  }
+  int64_t next_write_sequence = 0;
+  while (status.ok()) {
+    EncodedElement element;
+    bool end_of_sequence = false;
+    {
+      mutex_lock l(mu_);
+      while (encoded_.find(next_write_sequence) == encoded_.end()) {
+        cv_.wait(l);
+      }
+      auto it = encoded_.find(next_write_sequence);
+      element = std::move(it->second);
+      encoded_.erase(it);
+      end_of_sequence = next_write_sequence == eof_sequence_;
+      ++next_write_sequence;
+    }
+    if (end_of_sequence) {
+      status = writer->Close();
       break;
     }
-
-    TF_RETURN_IF_ERROR(writer->WriteTensors(be.value));
+    status = element.status;
+    if (status.ok()) {
+      if (element.use_raw) {
+        status = writer->WriteTensors(element.raw);
+      } else {
+        status = writer->WriteRecords(element.records);
+      }
+    }
+    mutex_lock l(mu_);
+    input_bytes_ -= element.size_bytes;
+    cv_.notify_all();
   }
-  return OkStatus();
+  if (!status.ok()) {
+    Fail();
+  }
+  // Wait for the encoder threads to finish before destroying the writer they
+  // may still be encoding with.
+  mutex_lock l(mu_);
+  while (num_active_encoders_ > 0) {
+    cv_.wait(l);
+  }
+  writer_ = nullptr;
+  return status;
 }
 
 namespace {
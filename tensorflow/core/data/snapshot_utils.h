@@ -16,6 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DATA_SNAPSHOT_UTILS_H_
 #define TENSORFLOW_CORE_DATA_SNAPSHOT_UTILS_H_
 
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -25,6 +31,7 @@ limitations under the License.
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/record_writer.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
@@ -82,6 +89,26 @@ class Writer {
   // Writes a vector of tensors to the snapshot writer file.
   virtual Status WriteTensors(const std::vector<Tensor>& tensors) = 0;
 
+  // Serializes (and, depending on the format, compresses) `tensors` into the
+  // writer's on-disk record format without touching the underlying file. The
+  // resulting records must be passed to `WriteRecords` in the same order
+  // elements were produced. Must be thread-safe, so that encoding can run on
+  // multiple threads concurrently with `WriteRecords`. Returns Unimplemented
+  // if the writer does not support encoding off the writer thread.
+  virtual Status EncodeTensors(const std::vector<Tensor>& tensors,
+                               std::vector<tstring>* records) const {
+    return errors::Unimplemented(
+        "This snapshot writer does not support encoding elements off the "
+        "writer thread.");
+  }
+
+  // Appends records previously produced by `EncodeTensors` to the snapshot
+  // file. Unlike `EncodeTensors`, this must be called from a single thread.
+  virtual Status WriteRecords(const std::vector<tstring>& records) {
+    return errors::Unimplemented(
+        "This snapshot writer does not support writing pre-encoded records.");
+  }
+
   // Flushes any in-memory buffers to disk.
   virtual Status Sync() = 0;
 
@@ -103,6 +130,11 @@ class TFRecordWriter : public Writer {
 
   Status WriteTensors(const std::vector<Tensor>& tensors) override;
 
+  Status EncodeTensors(const std::vector<Tensor>& tensors,
+                       std::vector<tstring>* records) const override;
+
+  Status WriteRecords(const std::vector<tstring>& records) override;
+
   Status Sync() override;
 
   Status Close() override;
@@ -135,6 +167,11 @@ class CustomWriter : public Writer {
 
   Status WriteTensors(const std::vector<Tensor>& tensors) override;
 
+  Status EncodeTensors(const std::vector<Tensor>& tensors,
+                       std::vector<tstring>* records) const override;
+
+  Status WriteRecords(const std::vector<tstring>& records) override;
+
   Status Sync() override;
 
   Status Close() override;
@@ -338,6 +375,12 @@ struct ElementOrEOF {
 // AsyncWriter provides API for asynchronously writing dataset elements
 // (each represented as a vector of tensors) to a file.
 //
+// Elements are encoded (serialized and, for compressed formats, compressed)
+// by a pool of encoder threads and appended to the snapshot file in element
+// order by a dedicated IO thread, so dataset iteration is not blocked on
+// compression or disk writes. `Write` applies back-pressure by blocking once
+// the number of buffered bytes reaches the writer's limit.
+//
 // The expected use of this API is:
 //
 // std::unique_ptr<AsyncWriter> writer = absl_make_unique<AsyncWriter>(...);
@@ -356,8 +399,8 @@ class AsyncWriter {
                        const DataTypeVector& output_types,
                        std::function<void(Status)> done);
 
-  // Writes the given tensors. The method is non-blocking and returns without
-  // waiting for the element to be written.
+  // Enqueues the given tensors for writing. Blocks while the writer's buffer
+  // of pending elements is full, applying back-pressure to the producer.
   void Write(const std::vector<Tensor>& tensors) TF_LOCKS_EXCLUDED(mu_);
 
   // Signals the end of input. The method is non-blocking and returns without
@@ -365,21 +408,69 @@ class AsyncWriter {
   void SignalEOF() TF_LOCKS_EXCLUDED(mu_);
 
  private:
-  void Consume(ElementOrEOF* be) TF_LOCKS_EXCLUDED(mu_);
-  bool ElementAvailable() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // A dataset element queued for encoding, tagged with its position in the
+  // stream so the IO thread can restore element order.
+  struct SequencedElement {
+    int64_t sequence = 0;
+    ElementOrEOF element;
+    size_t size_bytes = 0;
+  };
+
+  // An element that has been encoded and is waiting to be written by the IO
+  // thread. If the writer's format does not support encoding off the IO
+  // thread, `records` is empty and the IO thread falls back to
+  // `Writer::WriteTensors` on `raw`.
+  struct EncodedElement {
+    Status status;
+    std::vector<tstring> records;
+    std::vector<Tensor> raw;
+    bool use_raw = false;
+    size_t size_bytes = 0;
+  };
+
+  // Encodes queued elements until end of input or failure.
+  void EncoderThread() TF_LOCKS_EXCLUDED(mu_);
+  // Creates the snapshot file and writes encoded elements in element order.
   Status WriterThread(Env* env, const std::string& shard_directory,
                       uint64 checkpoint_id, const std::string& compression,
-                      int64_t version, DataTypeVector output_types);
+                      int64_t version, DataTypeVector output_types)
+      TF_LOCKS_EXCLUDED(mu_);
+  // Marks the writer as failed, unblocking the producer and encoder threads.
+  void Fail() TF_LOCKS_EXCLUDED(mu_);
 
   mutex mu_;
-  std::deque<ElementOrEOF> deque_ TF_GUARDED_BY(mu_);
+  condition_variable cv_;
+  // Elements waiting to be encoded, in element order.
+  std::deque<SequencedElement> input_ TF_GUARDED_BY(mu_);
+  // Bytes admitted by `Write` that the IO thread hasn't written yet. Used for
+  // back-pressure on the producer.
+  size_t input_bytes_ TF_GUARDED_BY(mu_) = 0;
+  // Encoded elements waiting to be written, keyed by sequence number so the
+  // IO thread can write them in element order.
+  std::map<int64_t, EncodedElement> encoded_ TF_GUARDED_BY(mu_);
+  // The sequence number assigned to the next `Write` or `SignalEOF` call.
+  int64_t next_sequence_ TF_GUARDED_BY(mu_) = 0;
+  // The sequence number of the end-of-input marker, or -1 if `SignalEOF`
+  // hasn't been called yet.
+  int64_t eof_sequence_ TF_GUARDED_BY(mu_) = -1;
+  // The snapshot writer, owned by the IO thread and shared with the encoder
+  // threads once created. Only `EncodeTensors` may be called on it off the IO
+  // thread.
+  Writer* writer_ TF_GUARDED_BY(mu_) = nullptr;
+  // Set when writer creation, encoding, or writing fails. Once failed, the
+  // writer discards further input.
+  bool failed_ TF_GUARDED_BY(mu_) = false;
+  // Maximum number of bytes buffered in `input_` before `Write` blocks.
+  size_t max_buffered_bytes_;
+  // Number of encoder threads that have not yet exited.
+  int num_active_encoders_ TF_GUARDED_BY(mu_) = 0;
 
   // This has to be last. During destruction, we need to make sure that the
-  // Thread object is destroyed first as its destructor blocks on thread
+  // Thread objects are destroyed first as their destructors block on thread
   // completion. If there are other member variables after this, they may get
-  // destroyed first before the thread finishes, potentially causing the
-  // thread to access invalid memory.
-  std::unique_ptr<Thread> thread_;
+  // destroyed first before the threads finish, potentially causing the
+  // threads to access invalid memory.
+  std::vector<std::unique_ptr<Thread>> threads_;
 };
 
 }  // namespace snapshot_util
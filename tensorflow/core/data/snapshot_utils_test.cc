@@ -91,6 +91,108 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kSnappy, 2);
 }
 
+void ExpectTensorsEqual(const std::vector<Tensor>& expected,
+                        const std::vector<Tensor>& actual) {
+  EXPECT_EQ(expected.size(), actual.size());
+  for (int j = 0; j < actual.size(); ++j) {
+    TensorProto proto;
+    TensorProto read_proto;
+
+    expected[j].AsProtoTensorContent(&proto);
+    actual[j].AsProtoTensorContent(&read_proto);
+
+    std::string proto_serialized, read_proto_serialized;
+    proto.AppendToString(&proto_serialized);
+    read_proto.AppendToString(&read_proto_serialized);
+    EXPECT_EQ(proto_serialized, read_proto_serialized);
+  }
+}
+
+// Verifies that elements encoded off the writer thread with `EncodeTensors`
+// and appended with `WriteRecords` can be read back like elements written
+// with `WriteTensors`.
+void SnapshotEncodedRoundTrip(std::string compression_type, int version) {
+  std::vector<Tensor> tensors;
+  tensorflow::DataTypeVector dtypes;
+  GenerateTensorVector(dtypes, tensors);
+
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(tensorflow::Env::Default(), filename,
+                              compression_type, version, dtypes, &writer));
+
+  for (int i = 0; i < 10; ++i) {
+    std::vector<tstring> records;
+    TF_ASSERT_OK(writer->EncodeTensors(tensors, &records));
+    TF_ASSERT_OK(writer->WriteRecords(records));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  std::unique_ptr<Reader> reader;
+  TF_ASSERT_OK(Reader::Create(Env::Default(), filename, compression_type,
+                              version, dtypes, &reader));
+
+  for (int i = 0; i < 10; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader->ReadTensors(&read_tensors));
+    ExpectTensorsEqual(tensors, read_tensors);
+  }
+
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+}
+
+TEST(SnapshotUtilTest, EncodedRoundTripTest) {
+  SnapshotEncodedRoundTrip(io::compression::kNone, 1);
+  SnapshotEncodedRoundTrip(io::compression::kGzip, 1);
+  SnapshotEncodedRoundTrip(io::compression::kSnappy, 1);
+
+  SnapshotEncodedRoundTrip(io::compression::kNone, 2);
+  SnapshotEncodedRoundTrip(io::compression::kGzip, 2);
+  SnapshotEncodedRoundTrip(io::compression::kSnappy, 2);
+}
+
+void AsyncWriterRoundTrip(std::string compression_type, int version) {
+  std::vector<Tensor> tensors;
+  tensorflow::DataTypeVector dtypes;
+  GenerateTensorVector(dtypes, tensors);
+
+  std::string shard_directory =
+      io::JoinPath(testing::TmpDir(), "async_writer_round_trip");
+  Status writer_status;
+  {
+    AsyncWriter writer(Env::Default(), /*file_index=*/0, shard_directory,
+                       /*checkpoint_id=*/0, compression_type, version, dtypes,
+                       [&writer_status](Status s) { writer_status = s; });
+    for (int i = 0; i < 100; ++i) {
+      writer.Write(tensors);
+    }
+    writer.SignalEOF();
+    // Destroying the writer joins the encoder and IO threads.
+  }
+  TF_ASSERT_OK(writer_status);
+
+  std::unique_ptr<Reader> reader;
+  TF_ASSERT_OK(Reader::Create(Env::Default(),
+                              GetCheckpointFileName(shard_directory, 0),
+                              compression_type, version, dtypes, &reader));
+  for (int i = 0; i < 100; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader->ReadTensors(&read_tensors));
+    ExpectTensorsEqual(tensors, read_tensors);
+  }
+
+  int64_t undeleted_files, undeleted_dirs;
+  TF_ASSERT_OK(Env::Default()->DeleteRecursively(
+      shard_directory, &undeleted_files, &undeleted_dirs));
+}
+
+TEST(SnapshotUtilTest, AsyncWriterRoundTripTest) {
+  AsyncWriterRoundTrip(io::compression::kSnappy, 1);
+  AsyncWriterRoundTrip(io::compression::kSnappy, 2);
+}
+
 void SnapshotReaderBenchmarkLoop(::testing::benchmark::State& state,
                                  std::string compression_type, int version) {
   tensorflow::DataTypeVector dtypes;
@@ -74,6 +74,10 @@ class Iterator {
   // indication of whether the end of the input pipeline has been reached.
   Status GetNext(std::vector<Tensor>* outputs, bool* end_of_input);
 
+  // Returns the autotuning model instrumenting this iterator, or nullptr when
+  // the pipeline's options disable autotuning.
+  std::shared_ptr<model::Model> model() const;
+
  private:
   friend class Dataset;
 
@@ -301,6 +301,26 @@ TEST(Scalar, Standalone) {
   }
 }
 
+TEST(Model, Standalone) {
+  GraphDef graph_def;
+  protobuf::TextFormat::ParseFromString(kMapGraphProto, &graph_def);
+  std::unique_ptr<Dataset> dataset;
+  TF_EXPECT_OK(Dataset::FromGraph({}, graph_def, &dataset));
+  std::unique_ptr<Iterator> iterator;
+  TF_EXPECT_OK(dataset->MakeIterator(&iterator));
+  // Autotuning is on by default, so the root iterator exposes the model
+  // instrumenting the pipeline.
+  ASSERT_NE(iterator->model(), nullptr);
+  bool end_of_input = false;
+  while (!end_of_input) {
+    std::vector<tensorflow::Tensor> outputs;
+    TF_EXPECT_OK(iterator->GetNext(&outputs, &end_of_input));
+  }
+  ModelProto model_proto;
+  TF_EXPECT_OK(iterator->model()->ToProto(&model_proto));
+  EXPECT_GT(model_proto.nodes_size(), 0);
+}
+
 }  // namespace
 }  // namespace standalone
 }  // namespace data
@@ -34,6 +34,9 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/call_options.h"
 #include "tensorflow/core/distributed_runtime/coordination/coordination_client.h"
 #include "tensorflow/core/distributed_runtime/coordination/coordination_service_error_util.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/macros.h"
@@ -54,6 +57,7 @@ constexpr int kDefaultHeartbeatTimeoutMs = 10 * 1000;  // 10 seconds
 constexpr int kServiceToClientTimeoutMs = 10 * 1000;   // 10 seconds
 constexpr size_t kOngoingBarriersSoftLimit = 20;
 constexpr char kHealthCheckThread[] = "CoordinationServiceHealthCheck";
+constexpr char kCallbackFanOutThread[] = "CoordinationServiceFanOut";
 
 std::string GetTaskName(absl::string_view job_name, int task_id) {
   return strings::StrCat("/job:", job_name, "/replica:", 0, "/task:", task_id);
@@ -166,6 +170,30 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
                                 CoordinatedTaskEqual>& tasks_at_barrier,
       int64_t cluster_size);
   bool isRecoverableJob(const absl::string_view task_name) const;
+  // Invokes the given notification callbacks on the fan-out thread pool and
+  // blocks until all of them have completed, then clears `callbacks`.  The
+  // callbacks typically complete one pending RPC each, so dispatching them in
+  // parallel avoids serializing the fan-out to every participant of a large
+  // barrier or key-value watch; blocking keeps the delivery guarantees of the
+  // serial loop it replaces.
+  template <typename Callback, typename Arg>
+  void FanOutCallbacks(std::vector<Callback>* callbacks, const Arg& arg) {
+    if (callbacks->size() <= 1) {
+      for (const auto& callback : *callbacks) {
+        callback(arg);
+      }
+    } else {
+      BlockingCounter pending(callbacks->size());
+      for (const auto& callback : *callbacks) {
+        callback_pool_.Schedule([&callback, &arg, &pending]() {
+          callback(arg);
+          pending.DecrementCount();
+        });
+      }
+      pending.Wait();
+    }
+    callbacks->clear();
+  }
 
   class TaskState {
    public:
@@ -256,6 +284,8 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
 
   absl::flat_hash_set<std::string> recoverable_jobs_;
 
+  thread::ThreadPool callback_pool_;
+
   TF_DISALLOW_COPY_AND_ASSIGN(CoordinationServiceStandaloneImpl);
 };
 
@@ -339,7 +369,8 @@ CoordinationServiceStandaloneImpl::CoordinationServiceStandaloneImpl(
                    : kDefaultHeartbeatTimeoutMs;
       }()),
       shutdown_barrier_timeout_(
-          absl::Milliseconds(config.shutdown_barrier_timeout_in_ms())) {
+          absl::Milliseconds(config.shutdown_barrier_timeout_in_ms())),
+      callback_pool_(env, kCallbackFanOutThread, port::MaxParallelism()) {
   recoverable_jobs_ = absl::flat_hash_set<std::string>(
       config.recoverable_jobs().cbegin(), config.recoverable_jobs().cend());
   for (const auto& job : config.coordinated_job_list()) {
@@ -811,19 +842,23 @@ std::string NormalizeKey(const StringPiece orig_key) {
 Status CoordinationServiceStandaloneImpl::InsertKeyValue(
     const std::string& key, const std::string& value) {
   const std::string& norm_key = NormalizeKey(key);
-  mutex_lock l(kv_mu_);
-  if (kv_store_.find(norm_key) != kv_store_.end()) {
-    return MakeCoordinationError(
-        errors::AlreadyExists("Config key ", key, " already exists."));
-  }
-  kv_store_.emplace(norm_key, value);
-  auto iter = get_cb_.find(norm_key);
-  if (iter != get_cb_.end()) {
-    for (const auto& cb : iter->second) {
-      cb(value);
+  // Assemble the pending watch callbacks under the lock, but notify them
+  // outside of it so that slow subscribers do not block other store accesses.
+  std::vector<StatusOrValueCallback> callbacks;
+  {
+    mutex_lock l(kv_mu_);
+    if (kv_store_.find(norm_key) != kv_store_.end()) {
+      return MakeCoordinationError(
+          errors::AlreadyExists("Config key ", key, " already exists."));
+    }
+    kv_store_.emplace(norm_key, value);
+    auto iter = get_cb_.find(norm_key);
+    if (iter != get_cb_.end()) {
+      callbacks.swap(iter->second);
+      get_cb_.erase(iter);
     }
-    get_cb_.erase(iter);
   }
+  FanOutCallbacks(&callbacks, StatusOr<std::string>(value));
   return OkStatus();
 }
 
@@ -1116,10 +1151,7 @@ void CoordinationServiceStandaloneImpl::PassBarrier(
   // Note: barrier_id shouldn't be referenced after this line as its lifetime
   // may be tied to one of the callbacks.
   // Propagate results to participating tasks.
-  for (const auto& callback : barrier->done_callbacks) {
-    callback(result);
-  }
-  barrier->done_callbacks.clear();
+  FanOutCallbacks(&barrier->done_callbacks, result);
 }
 
 bool CoordinationServiceStandaloneImpl::ValidateTaskArgs(
@@ -15,7 +15,11 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/graph_mgr.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/build_graph_options.h"
@@ -43,8 +47,10 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_partition.h"
 #include "tensorflow/core/graph/validate.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/tracing.h"
@@ -101,6 +107,87 @@ static Status ValidateGraphDefForDevices(const GraphDef& gdef) {
   return OkStatus();
 }
 
+namespace {
+
+// Process-level cache of fully partitioned and optimized per-device graphs,
+// shared across the GraphMgr instances of all worker sessions.  Multi-tenant
+// hosts register the same subgraph once per session, and partitioning,
+// post-partitioning passes and graph optimization dominate registration cost
+// while depending only on the graph def, the options and the devices.
+// Executors, kernels and function runtimes are deliberately not shared: they
+// bake in the session's OpSegment and rendezvous wiring, which is what keeps
+// per-session resources isolated.
+//
+// The cache is keyed by a 128-bit fingerprint: a 64-bit key collision would
+// silently hand one tenant another tenant's per-device graphs, and this
+// cache is shared across every worker session in the process.
+class PartitionedGraphCache {
+ public:
+  using Subgraphs = std::unordered_map<string, std::shared_ptr<const Graph>>;
+
+  static PartitionedGraphCache* Global() {
+    static PartitionedGraphCache* cache = new PartitionedGraphCache;
+    return cache;
+  }
+
+  std::shared_ptr<const Subgraphs> Lookup(const Fprint128& key) {
+    mutex_lock l(mu_);
+    auto iter = cache_.find(key);
+    return iter != cache_.end() ? iter->second : nullptr;
+  }
+
+  void Insert(const Fprint128& key,
+              std::shared_ptr<const Subgraphs> subgraphs) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) {
+      // Tenants come and go; occasionally dropping everything beats pinning
+      // graphs for sessions that no longer exist.
+      cache_.clear();
+    }
+    cache_.emplace(key, std::move(subgraphs));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 256;
+
+  mutex mu_;
+  std::unordered_map<Fprint128, std::shared_ptr<const Subgraphs>,
+                     Fprint128Hasher>
+      cache_ TF_GUARDED_BY(mu_);
+};
+
+inline Fprint128 FingerprintCat128(const Fprint128& a, const Fprint128& b) {
+  return {FingerprintCat64(a.low64, b.low64),
+          FingerprintCat64(a.high64, b.high64)};
+}
+
+// Fingerprints a registration request.  Two registrations may share
+// partitioned graphs only when the graph def, the options that influence
+// partitioning and optimization, and the devices (including incarnations,
+// which partitioning embeds in Send/Recv attrs) all match.
+Fprint128 RegistrationFingerprint(const GraphDef& gdef,
+                                  const GraphOptions& graph_options,
+                                  const ConfigProto& config_proto,
+                                  const DeviceMgr* device_mgr) {
+  Fprint128 key = Fingerprint128(gdef.SerializeAsString());
+  key = FingerprintCat128(key,
+                          Fingerprint128(graph_options.SerializeAsString()));
+  key = FingerprintCat128(key,
+                          Fingerprint128(config_proto.SerializeAsString()));
+  std::vector<std::pair<string, uint64>> devices;
+  for (Device* device : device_mgr->ListDevices()) {
+    devices.emplace_back(device->name(), device->attributes().incarnation());
+  }
+  std::sort(devices.begin(), devices.end());
+  for (const auto& device : devices) {
+    key = FingerprintCat128(key, Fingerprint128(device.first));
+    key = FingerprintCat128(key, Fprint128{device.second, device.second});
+  }
+  return key;
+}
+
+}  // namespace
+
 Status GraphMgr::DecorateAndPublishGraphForDebug(
     const DebugOptions& debug_options, Graph* graph, Device* device) {
   std::unique_ptr<DebugGraphDecoratorInterface> decorator;
@@ -156,71 +243,124 @@ Status GraphMgr::InitItem(const string& handle, const GraphDef& gdef,
             return OkStatus();
           }}));
 
-  // Constructs the graph out of "gdef".
-  Graph graph(OpRegistry::Global());
-  GraphConstructorOptions opts;
-  opts.allow_internal_ops = true;
-  opts.expect_device_spec = true;
-  opts.validate_nodes = true;
-  TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(opts, gdef, &graph));
-
-  // Splits "graph" into multiple subgraphs by device names.
-  std::unordered_map<string, GraphDef> partitions;
-  PartitionOptions popts;
-  popts.node_to_loc = SplitByDevice;
-  popts.new_name = [this](const string& prefix) {
-    mutex_lock l(mu_);
-    return strings::StrCat(prefix, "_G", next_id_++);
-  };
-  popts.get_incarnation = [this](const string& name) -> int64 {
-    Device* device = nullptr;
-    Status s = device_mgr_->LookupDevice(name, &device);
-    if (s.ok()) {
-      return device->attributes().incarnation();
-    } else {
-      return PartitionOptions::kIllegalIncarnation;
-    }
-  };
-  popts.flib_def = item->lib_def.get();
-  popts.control_flow_added = true;
-  popts.scheduling_for_recvs = graph_options.enable_recv_scheduling();
-  TF_RETURN_IF_ERROR(Partition(popts, &graph, &partitions));
-  if (popts.scheduling_for_recvs) {
-    TF_RETURN_IF_ERROR(AddControlEdges(popts, &partitions));
+  // Reuses previously built partitions when an identical graph was
+  // registered before, possibly by another worker session.  Graphs carrying
+  // debug watches or cost models stay on the full path: both record
+  // per-item state into the subgraphs.
+  const bool cacheable = debug_options.debug_tensor_watch_opts().empty() &&
+                         graph_options.build_cost_model() == 0;
+  Fprint128 cache_key{0, 0};
+  std::shared_ptr<const PartitionedGraphCache::Subgraphs> subgraphs;
+  if (cacheable) {
+    cache_key = RegistrationFingerprint(gdef, graph_options, config_proto,
+                                        device_mgr_);
+    subgraphs = PartitionedGraphCache::Global()->Lookup(cache_key);
   }
 
-  std::unordered_map<string, std::unique_ptr<Graph>> partition_graphs;
-  for (auto& partition : partitions) {
-    std::unique_ptr<Graph> device_graph(new Graph(OpRegistry::Global()));
-    GraphConstructorOptions device_opts;
-    // There are internal operations (e.g., send/recv) that we now allow.
-    device_opts.allow_internal_ops = true;
-    device_opts.expect_device_spec = true;
-    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
-        device_opts, std::move(partition.second), device_graph.get()));
-    partition_graphs.emplace(partition.first, std::move(device_graph));
-  }
+  if (subgraphs == nullptr) {
+    // Constructs the graph out of "gdef".
+    Graph graph(OpRegistry::Global());
+    GraphConstructorOptions opts;
+    opts.allow_internal_ops = true;
+    opts.expect_device_spec = true;
+    opts.validate_nodes = true;
+    TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(opts, gdef, &graph));
+
+    // Splits "graph" into multiple subgraphs by device names.
+    std::unordered_map<string, GraphDef> partitions;
+    PartitionOptions popts;
+    popts.node_to_loc = SplitByDevice;
+    popts.new_name = [](const string& prefix) {
+      // Names must be unique process-wide, not just per GraphMgr: the
+      // resulting subgraphs may be adopted by other worker sessions, and
+      // OpSegment caches stateful kernels per (session, node name).
+      static std::atomic<int64_t> next_node_id{0};
+      return strings::StrCat(prefix, "_G", next_node_id++);
+    };
+    popts.get_incarnation = [this](const string& name) -> int64 {
+      Device* device = nullptr;
+      Status s = device_mgr_->LookupDevice(name, &device);
+      if (s.ok()) {
+        return device->attributes().incarnation();
+      } else {
+        return PartitionOptions::kIllegalIncarnation;
+      }
+    };
+    popts.flib_def = item->lib_def.get();
+    popts.control_flow_added = true;
+    popts.scheduling_for_recvs = graph_options.enable_recv_scheduling();
+    TF_RETURN_IF_ERROR(Partition(popts, &graph, &partitions));
+    if (popts.scheduling_for_recvs) {
+      TF_RETURN_IF_ERROR(AddControlEdges(popts, &partitions));
+    }
+
+    std::unordered_map<string, std::unique_ptr<Graph>> partition_graphs;
+    for (auto& partition : partitions) {
+      std::unique_ptr<Graph> device_graph(new Graph(OpRegistry::Global()));
+      GraphConstructorOptions device_opts;
+      // There are internal operations (e.g., send/recv) that we now allow.
+      device_opts.allow_internal_ops = true;
+      device_opts.expect_device_spec = true;
+      TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
+          device_opts, std::move(partition.second), device_graph.get()));
+      partition_graphs.emplace(partition.first, std::move(device_graph));
+    }
+
+    GraphOptimizationPassOptions optimization_options;
+    optimization_options.flib_def = item->lib_def.get();
+    optimization_options.partition_graphs = &partition_graphs;
+    TF_RETURN_IF_ERROR(OptimizationPassRegistry::Global()->RunGrouping(
+        OptimizationPassRegistry::POST_PARTITIONING, optimization_options));
+
+    const auto& optimizer_opts = graph_options.optimizer_options();
+    GraphOptimizer optimizer(optimizer_opts);
+    auto built = std::make_shared<PartitionedGraphCache::Subgraphs>();
+    for (auto& p : partition_graphs) {
+      const string& device_name = p.first;
+      std::unique_ptr<Graph>& subgraph = p.second;
+
+      // Find the device.
+      Device* device = nullptr;
+      TF_RETURN_IF_ERROR(device_mgr_->LookupDevice(device_name, &device));
+
+      // Give the device an opportunity to rewrite its subgraph.
+      TF_RETURN_IF_ERROR(device->MaybeRewriteGraph(&subgraph));
+
+      FunctionLibraryRuntime* lib = item->proc_flr->GetFLR(device->name());
+      if (lib == nullptr) {
+        return errors::InvalidArgument("Cannot find FLR for device: ",
+                                       device->name());
+      }
 
-  GraphOptimizationPassOptions optimization_options;
-  optimization_options.flib_def = item->lib_def.get();
-  optimization_options.partition_graphs = &partition_graphs;
-  TF_RETURN_IF_ERROR(OptimizationPassRegistry::Global()->RunGrouping(
-      OptimizationPassRegistry::POST_PARTITIONING, optimization_options));
+      optimizer.Optimize(lib, worker_env_->env, device, &subgraph,
+                         GraphOptimizer::Options());
+
+      // TensorFlow Debugger (tfdbg) inserts debug nodes in the graph.
+      if (!debug_options.debug_tensor_watch_opts().empty()) {
+        TF_RETURN_IF_ERROR(DecorateAndPublishGraphForDebug(
+            debug_options, subgraph.get(), device));
+      }
+
+      TF_RETURN_IF_ERROR(EnsureMemoryTypes(DeviceType(device->device_type()),
+                                           device->name(), subgraph.get()));
+      (*built)[device_name] = std::shared_ptr<const Graph>(std::move(subgraph));
+    }
+    if (cacheable) {
+      PartitionedGraphCache::Global()->Insert(cache_key, built);
+    }
+    subgraphs = std::move(built);
+  }
 
   LocalExecutorParams params;
 
-  item->units.reserve(partitions.size());
+  item->units.reserve(subgraphs->size());
   item->graph_mgr = this;
-  const auto& optimizer_opts = graph_options.optimizer_options();
-  GraphOptimizer optimizer(optimizer_opts);
-  for (auto& p : partition_graphs) {
-    const string& device_name = p.first;
-    std::unique_ptr<Graph>& subgraph = p.second;
+  for (const auto& p : *subgraphs) {
     item->units.resize(item->units.size() + 1);
     ExecutionUnit* unit = &(item->units.back());
 
     // Find the device.
-    Status s = device_mgr_->LookupDevice(device_name, &unit->device);
+    Status s = device_mgr_->LookupDevice(p.first, &unit->device);
     if (!s.ok()) {
       // Remove the empty unit from the item as the item destructor wants all
       // units to have valid devices.
@@ -228,9 +368,6 @@ Status GraphMgr::InitItem(const string& handle, const GraphDef& gdef,
       return s;
     }
 
-    // Give the device an opportunity to rewrite its subgraph.
-    TF_RETURN_IF_ERROR(unit->device->MaybeRewriteGraph(&subgraph));
-
     // Top-level nodes in the graph uses the op segment to cache
     // kernels. Therefore, as long as the executor is alive, we need
     // to ensure the kernels cached for the session are alive.
@@ -272,19 +409,7 @@ Status GraphMgr::InitItem(const string& handle, const GraphDef& gdef,
       }
     };
 
-    optimizer.Optimize(lib, worker_env_->env, params.device, &subgraph,
-                       GraphOptimizer::Options());
-
-    // TensorFlow Debugger (tfdbg) inserts debug nodes in the graph.
-    if (!debug_options.debug_tensor_watch_opts().empty()) {
-      TF_RETURN_IF_ERROR(DecorateAndPublishGraphForDebug(
-          debug_options, subgraph.get(), params.device));
-    }
-
-    TF_RETURN_IF_ERROR(
-        EnsureMemoryTypes(DeviceType(unit->device->device_type()),
-                          unit->device->name(), subgraph.get()));
-    unit->graph = std::move(subgraph);
+    unit->graph = p.second;
     unit->build_cost_model = graph_options.build_cost_model();
     if (unit->build_cost_model > 0) {
       skip_cost_models_ = false;
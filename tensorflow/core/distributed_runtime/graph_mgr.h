@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_GRAPH_MGR_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_GRAPH_MGR_H_
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -112,7 +113,9 @@ class GraphMgr {
   typedef GraphMgr ME;
 
   struct ExecutionUnit {
-    std::unique_ptr<Graph> graph = nullptr;
+    // The partitioned, optimized subgraph.  May be shared with items
+    // registered by other worker sessions; immutable once built.
+    std::shared_ptr<const Graph> graph = nullptr;
     Device* device = nullptr;               // not owned.
     Executor* root = nullptr;               // not owned.
     FunctionLibraryRuntime* lib = nullptr;  // not owned.
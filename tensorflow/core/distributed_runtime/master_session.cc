@@ -18,7 +18,9 @@ limitations under the License.
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -34,7 +36,9 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/worker_interface.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/cost_graph.pb.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/graph_def_util.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/node_def_util.h"
@@ -49,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
@@ -56,6 +61,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/mutex.h"
@@ -67,6 +73,138 @@ limitations under the License.
 
 namespace tensorflow {
 
+namespace {
+
+// Process-level cache of graph partitions, shared across master sessions.
+// Parameter-server style jobs repeatedly register the same client graph --
+// across sessions, and across feed/fetch sets that prune to the same
+// subgraph -- and Partition() is expensive on large graphs.  Entries are
+// immutable once inserted.
+//
+// The cache is keyed by a 128-bit fingerprint: a 64-bit key collision would
+// silently hand one session another model's partitioned graphs, and this
+// cache is shared across every session in the process.
+class GraphPartitionCache {
+ public:
+  using Partitions = std::unordered_map<string, GraphDef>;
+
+  static GraphPartitionCache* Global() {
+    static GraphPartitionCache* cache = new GraphPartitionCache;
+    return cache;
+  }
+
+  std::shared_ptr<const Partitions> Lookup(const Fprint128& key) {
+    mutex_lock l(mu_);
+    auto iter = cache_.find(key);
+    return iter != cache_.end() ? iter->second : nullptr;
+  }
+
+  void Insert(const Fprint128& key,
+              std::shared_ptr<const Partitions> partitions) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) {
+      // Keeps long-lived masters that see many distinct graphs from pinning
+      // stale partitions forever; a rare re-partition after a flush is cheap
+      // relative to the steady-state savings.
+      cache_.clear();
+    }
+    cache_.emplace(key, std::move(partitions));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 256;
+
+  mutex mu_;
+  std::unordered_map<Fprint128, std::shared_ptr<const Partitions>,
+                     Fprint128Hasher>
+      cache_ TF_GUARDED_BY(mu_);
+};
+
+inline Fprint128 FingerprintCat128(const Fprint128& a, const Fprint128& b) {
+  return {FingerprintCat64(a.low64, b.low64),
+          FingerprintCat64(a.high64, b.high64)};
+}
+
+inline Fprint128 FingerprintCat128(const Fprint128& a, const uint64 b) {
+  return FingerprintCat128(a, Fprint128{b, b});
+}
+
+inline Fprint128 FingerprintCat128(const Fprint128& a, const StringPiece s) {
+  return FingerprintCat128(a, Fingerprint128(s));
+}
+
+// Computes a 128-bit fingerprint covering everything the master's
+// partitioning consumes: the client graph's nodes, attrs, placements and
+// edges, the incarnations of the devices the graph is placed on (a restarted
+// worker must not be handed partitions that embed its old incarnation), the
+// function library, and the session option that alters Send/Recv dtypes.
+// Sets *cacheable to false when a device incarnation cannot be resolved;
+// Partition() will then surface the error through its own path.
+Fprint128 GraphPartitionFingerprint(const Graph& graph,
+                                    const FunctionLibraryDefinition* flib_def,
+                                    const PartitionOptions& popts,
+                                    bool enable_bfloat16_sendrecv,
+                                    bool* cacheable) {
+  Fprint128 key{static_cast<uint64>(graph.versions().producer()),
+                static_cast<uint64>(graph.versions().min_consumer())};
+  key = FingerprintCat128(key, enable_bfloat16_sendrecv ? 1 : 0);
+
+  std::set<string> device_names;
+  for (const Node* n : graph.nodes()) {
+    key = FingerprintCat128(key, n->id());
+    key = FingerprintCat128(key, n->name());
+    key = FingerprintCat128(key, n->type_string());
+    key = FingerprintCat128(key, n->assigned_device_name());
+    if (n->IsOp() && !n->assigned_device_name().empty()) {
+      device_names.insert(n->assigned_device_name());
+    }
+
+    std::vector<std::pair<StringPiece, const AttrValue*>> sorted_attrs;
+    for (const auto& attr : n->attrs()) {
+      sorted_attrs.emplace_back(attr.first, &attr.second);
+    }
+    std::sort(sorted_attrs.begin(), sorted_attrs.end());
+    for (const auto& attr : sorted_attrs) {
+      key = FingerprintCat128(key, attr.first);
+      key = FingerprintCat128(key, AttrValueHash(*attr.second));
+    }
+
+    std::vector<std::tuple<int, int, int>> in_edges;
+    in_edges.reserve(n->in_edges().size());
+    for (const Edge* e : n->in_edges()) {
+      in_edges.emplace_back(e->src()->id(), e->src_output(), e->dst_input());
+    }
+    std::sort(in_edges.begin(), in_edges.end());
+    for (const auto& edge : in_edges) {
+      key = FingerprintCat128(key, std::get<0>(edge));
+      key = FingerprintCat128(key, std::get<1>(edge));
+      key = FingerprintCat128(key, std::get<2>(edge));
+    }
+  }
+
+  for (const string& name : device_names) {
+    const uint64 incarnation = popts.get_incarnation(name);
+    if (incarnation == PartitionOptions::kIllegalIncarnation) {
+      *cacheable = false;
+      return {0, 0};
+    }
+    key = FingerprintCat128(key, incarnation);
+  }
+
+  if (flib_def != nullptr) {
+    std::vector<string> function_names = flib_def->ListFunctionNames();
+    std::sort(function_names.begin(), function_names.end());
+    for (const string& name : function_names) {
+      key = FingerprintCat128(key, name);
+      key = FingerprintCat128(key, FunctionDefHash(*flib_def->Find(name)));
+    }
+  }
+  *cacheable = true;
+  return key;
+}
+
+}  // namespace
+
 // MasterSession wraps ClientGraph in a reference counted object.
 // This way, MasterSession can clear up the cache mapping Run requests to
 // compiled graphs while the compiled graph is still being used.
@@ -273,6 +411,13 @@ class MasterSession::ReffedClientGraph : public core::RefCounted {
     // this partition on the worker.
     string graph_handle;
 
+    // Prebuilt RunGraph request holding the fields that are identical for
+    // every step on this partition (graph handle, session handle, and, for
+    // non-partial runs, the recv keys).  Built once after registration;
+    // per-step requests are initialized from it and only fill in their
+    // deltas (step id, request id, executor options, and feeds).
+    RunGraphRequest run_graph_skeleton;
+
     Part() : feed_key(3), key_fetch(3) {}
   };
 
@@ -437,10 +582,34 @@ Status MasterSession::ReffedClientGraph::DoBuildPartitions(
     // execution_state_->MergeFromGlobal(&cost_model);
     SlackAnalysis sa(&client_graph->graph, &cost_model);
     sa.ComputeAsap(&popts.start_times);
+    // The recorded start times depend on the cost model, so these
+    // partitions are not safely reusable.
+    return Partition(popts, &client_graph->graph, out_partitions);
+  }
+
+  // Reuse previously computed partitions when an identical client graph was
+  // partitioned before, possibly by another session.
+  bool cacheable = false;
+  const Fprint128 key = GraphPartitionFingerprint(
+      client_graph->graph, popts.flib_def, popts,
+      session_opts_.config.graph_options().enable_bfloat16_sendrecv(),
+      &cacheable);
+  if (cacheable) {
+    auto cached = GraphPartitionCache::Global()->Lookup(key);
+    if (cached != nullptr) {
+      *out_partitions = *cached;
+      return OkStatus();
+    }
   }
 
   // Partition the graph.
-  return Partition(popts, &client_graph->graph, out_partitions);
+  TF_RETURN_IF_ERROR(Partition(popts, &client_graph->graph, out_partitions));
+  if (cacheable) {
+    GraphPartitionCache::Global()->Insert(
+        key,
+        std::make_shared<GraphPartitionCache::Partitions>(*out_partitions));
+  }
+  return OkStatus();
 }
 
 Status MasterSession::ReffedClientGraph::DoRegisterPartitions(
@@ -500,6 +669,23 @@ Status MasterSession::ReffedClientGraph::DoRegisterPartitions(
     s.Update(c->status);
     partitions_[i].graph_handle = c->resp.graph_handle();
   }
+  if (s.ok()) {
+    for (Part& part : partitions_) {
+      RunGraphRequest* skeleton = &part.run_graph_skeleton;
+      skeleton->set_session_handle(session_handle_);
+      skeleton->set_create_worker_session_called(!should_deregister_);
+      skeleton->set_graph_handle(part.graph_handle);
+      skeleton->set_is_partial(is_partial_);
+      skeleton->set_store_errors_in_response_body(true);
+      // In the partial case, the recv keys depend on the fetches provided
+      // in each step's request, so they are added per step instead.
+      if (!is_partial_) {
+        for (const auto& key_fetch : part.key_fetch) {
+          skeleton->add_recv_key(key_fetch.first);
+        }
+      }
+    }
+  }
   return s;
 }
 
@@ -679,16 +865,15 @@ Status MasterSession::ReffedClientGraph::RunPartitionsHelper(
     c->worker_name = &part.name;
     c->req.reset(part.worker->CreateRunGraphRequest());
     c->resp.reset(part.worker->CreateRunGraphResponse());
+    // The immutable fields (graph handle, session handle, and, in the
+    // non-partial case, the recv keys) were captured in the skeleton when
+    // the partition was registered; only the per-step deltas remain.
+    c->req->InitializeFromSkeleton(part.run_graph_skeleton);
     if (is_partial_) {
-      c->req->set_is_partial(is_partial_);
       c->req->set_is_last_partial_run(is_last_partial_run);
     }
-    c->req->set_session_handle(session_handle_);
-    c->req->set_create_worker_session_called(!should_deregister_);
-    c->req->set_graph_handle(part.graph_handle);
     c->req->set_step_id(step_id);
     *c->req->mutable_exec_opts() = exec_opts;
-    c->req->set_store_errors_in_response_body(true);
     c->req->set_request_id(GetUniqueRequestId());
     // If any feeds are provided, send the feed values together
     // in the RunGraph request.
@@ -729,10 +914,7 @@ Status MasterSession::ReffedClientGraph::RunPartitionsHelper(
         TF_RETURN_IF_ERROR(
             AddSendFromClientRequest(req, c->req.get(), feed_index, key));
       }
-      for (const auto& key_fetch : part.key_fetch) {
-        const string& key = key_fetch.first;
-        c->req->add_recv_key(key);
-      }
+      // The recv keys were already copied in from the skeleton.
     }
   }
 
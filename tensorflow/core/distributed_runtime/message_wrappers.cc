@@ -288,6 +288,23 @@ string ProtoRunStepRequest::DebugString() const {
 
 const RunStepRequest& ProtoRunStepRequest::ToProto() const { return *request_; }
 
+void InMemoryRunGraphRequest::InitializeFromSkeleton(
+    const RunGraphRequest& skeleton) {
+  DCHECK_EQ(skeleton.send_size(), 0);
+  session_handle_ = skeleton.session_handle();
+  create_worker_session_called_ = skeleton.create_worker_session_called();
+  graph_handle_ = skeleton.graph_handle();
+  step_id_ = skeleton.step_id();
+  exec_opts_ = skeleton.exec_opts();
+  sends_.clear();
+  recvs_.assign(skeleton.recv_key().begin(), skeleton.recv_key().end());
+  is_partial_ = skeleton.is_partial();
+  is_last_partial_run_ = skeleton.is_last_partial_run();
+  store_errors_in_response_body_ = skeleton.store_errors_in_response_body();
+  request_id_ = skeleton.request_id();
+  proto_version_.reset();
+}
+
 const string& InMemoryRunGraphRequest::session_handle() const {
   return session_handle_;
 }
@@ -423,6 +440,12 @@ const RunGraphRequest& InMemoryRunGraphRequest::ToProto() const {
   return *proto_version_;
 }
 
+void MutableProtoRunGraphRequest::InitializeFromSkeleton(
+    const RunGraphRequest& skeleton) {
+  DCHECK_EQ(skeleton.send_size(), 0);
+  request_ = skeleton;
+}
+
 const string& MutableProtoRunGraphRequest::session_handle() const {
   return request_.session_handle();
 }
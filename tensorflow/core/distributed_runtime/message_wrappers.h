@@ -306,6 +306,14 @@ class RunGraphRequestWrapper {
 // See `RunGraphRequestWrapper` above for a description of the fields.
 class MutableRunGraphRequestWrapper : public RunGraphRequestWrapper {
  public:
+  // Initializes this request from `skeleton`, which holds the fields that
+  // are identical for every step on a registered graph (session handle,
+  // graph handle, recv keys, etc.), leaving only the per-step fields (step
+  // id, request id, executor options, and feeds) to be filled in.  Any
+  // previous contents of this request are discarded.  `skeleton` must not
+  // contain feed tensors.
+  virtual void InitializeFromSkeleton(const RunGraphRequest& skeleton) = 0;
+
   virtual void set_session_handle(const string& handle) = 0;
   virtual void set_create_worker_session_called(bool called) = 0;
   virtual void set_graph_handle(const string& handle) = 0;
@@ -348,6 +356,7 @@ class InMemoryRunGraphRequest : public MutableRunGraphRequestWrapper {
   int64_t request_id() const override;
 
   // MutableRunGraphRequestWrapper methods.
+  void InitializeFromSkeleton(const RunGraphRequest& skeleton) override;
   void set_session_handle(const string& handle) override;
   void set_create_worker_session_called(bool called) override;
   void set_graph_handle(const string& handle) override;
@@ -408,6 +417,7 @@ class MutableProtoRunGraphRequest : public MutableRunGraphRequestWrapper {
   const RunGraphRequest& ToProto() const override;
 
   // MutableRunGraphRequestWrapper methods.
+  void InitializeFromSkeleton(const RunGraphRequest& skeleton) override;
   void set_session_handle(const string& handle) override;
   void set_create_worker_session_called(bool called) override;
   void set_graph_handle(const string& handle) override;
@@ -236,6 +236,45 @@ TEST(MessageWrappers, RunGraphRequest_Basic) {
   }
 }
 
+TEST(MessageWrappers, RunGraphRequest_InitializeFromSkeleton) {
+  RunGraphRequest skeleton;
+  skeleton.set_session_handle("session_handle");
+  skeleton.set_create_worker_session_called(true);
+  skeleton.set_graph_handle("graph_handle");
+  skeleton.add_recv_key("recv_2");
+  skeleton.add_recv_key("recv_3");
+  skeleton.set_store_errors_in_response_body(true);
+
+  auto check = [&skeleton](MutableRunGraphRequestWrapper* request) {
+    // Pre-populate some state to verify that it is discarded.
+    request->set_step_id(7);
+    request->add_recv_key("stale_recv");
+    request->InitializeFromSkeleton(skeleton);
+    EXPECT_EQ("session_handle", request->session_handle());
+    EXPECT_TRUE(request->create_worker_session_called());
+    EXPECT_EQ("graph_handle", request->graph_handle());
+    EXPECT_EQ(0, request->step_id());
+    EXPECT_EQ(0, request->num_sends());
+    ASSERT_EQ(2, request->num_recvs());
+    EXPECT_EQ("recv_2", request->recv_key(0));
+    EXPECT_EQ("recv_3", request->recv_key(1));
+    EXPECT_FALSE(request->is_partial());
+    EXPECT_TRUE(request->store_errors_in_response_body());
+    // The per-step deltas are applied after initialization.
+    request->set_step_id(13);
+    EXPECT_EQ(13, request->step_id());
+  };
+
+  {
+    InMemoryRunGraphRequest request;
+    check(&request);
+  }
+  {
+    MutableProtoRunGraphRequest request;
+    check(&request);
+  }
+}
+
 TEST(MessageWrappers, RunGraphResponse_Basic) {
   InMemoryRunGraphResponse in_memory_response;
   BuildRunGraphResponse(&in_memory_response);
@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_client.h"
 
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "grpcpp/generic/generic_stub.h"
 #include "tensorflow/core/distributed_runtime/call_options.h"
@@ -177,14 +180,28 @@ class GrpcEagerClient : public EagerClient {
     VLOG(1) << "Sending RPC to close remote eager context "
             << request->DebugString();
 
-    mutex_lock l(mu_);
-    const auto& it = enqueue_dispatchers_.find(request->context_id());
-    if (it != enqueue_dispatchers_.end()) {
-      it->second.CancelCall();
-      enqueue_dispatchers_.erase(it);
-    } else if (EnableStreaming()) {
-      LOG(ERROR) << "Remote EagerContext with id " << request->context_id()
-                 << " does not seem to exist.";
+    std::vector<StreamingEnqueueState::PendingCall> pending_calls;
+    {
+      mutex_lock l(mu_);
+      const auto& it = enqueue_dispatchers_.find(request->context_id());
+      if (it != enqueue_dispatchers_.end()) {
+        it->second->CancelCall();
+        enqueue_dispatchers_.erase(it);
+      } else if (EnableStreaming()) {
+        LOG(ERROR) << "Remote EagerContext with id " << request->context_id()
+                   << " does not seem to exist.";
+      }
+      auto state_it = enqueue_states_.find(request->context_id());
+      if (state_it != enqueue_states_.end()) {
+        pending_calls.swap(state_it->second.calls);
+        enqueue_states_.erase(state_it);
+      }
+    }
+    // Ops that were batched but not yet written to the stream fail the same
+    // way in-flight streaming requests fail when the call is cancelled.
+    for (StreamingEnqueueState::PendingCall& call : pending_calls) {
+      call.done(errors::Cancelled("Remote eager context with id ",
+                                  request->context_id(), " was closed."));
     }
   }
 
@@ -199,19 +216,48 @@ class GrpcEagerClient : public EagerClient {
     // 2. The flag set in the eager executor.
     // Streaming enqueue is allowed only when the both are enabled.
     if (EnableStreaming() && enable_streaming_enqueue) {
-      mutex_lock l(mu_);
-      auto it = enqueue_dispatchers_.find(request->context_id());
-      if (it == enqueue_dispatchers_.end()) {
-        auto it_and_bool = enqueue_dispatchers_.emplace(
-            std::piecewise_construct,
-            std::forward_as_tuple(request->context_id()),
-            std::forward_as_tuple(
-                &stub_, cq_,
-                "/tensorflow.eager.EagerService/StreamingEnqueue"));
-        it = it_and_bool.first;
+      const uint64 context_id = request->context_id();
+      std::shared_ptr<StreamingRPCDispatcher<EnqueueResponse>> dispatcher;
+      {
+        mutex_lock l(mu_);
+        auto it = enqueue_dispatchers_.find(context_id);
+        if (it == enqueue_dispatchers_.end()) {
+          it = enqueue_dispatchers_
+                   .emplace(context_id,
+                            std::make_shared<
+                                StreamingRPCDispatcher<EnqueueResponse>>(
+                                &stub_, cq_,
+                                "/tensorflow.eager.EagerService/"
+                                "StreamingEnqueue"))
+                   .first;
+        }
+        dispatcher = it->second;
+        StreamingEnqueueState& state = enqueue_states_[context_id];
+        if (state.inflight) {
+          // An earlier request on this channel is still awaiting its
+          // response. Fold this call into the next batched EnqueueRequest
+          // instead of writing another message to the stream; it is sent
+          // by FlushStreamingEnqueue once that response arrives.
+          state.request.set_context_id(context_id);
+          state.request.mutable_queue()->MergeFrom(request->queue());
+          state.calls.push_back(
+              {response, request->queue_size(), std::move(done_wrapped)});
+          return;
+        }
+        state.inflight = true;
       }
       // TODO(haoyuzhang): Consider supporting cancellation for streaming RPC?
-      it->second.SendNextRequest(*request, response, std::move(done_wrapped));
+      dispatcher->SendNextRequest(
+          *request, response,
+          [this, context_id, done_wrapped = std::move(done_wrapped)](
+              const Status& status) {
+            // Send any ops batched up while this request was in flight
+            // before completing the caller, so the next stream write is
+            // issued as early as possible. `done_wrapped` holds a
+            // reference on `this`, keeping the client alive here.
+            FlushStreamingEnqueue(context_id);
+            done_wrapped(status);
+          });
     } else {
       Notification n;
       Status status;
@@ -226,6 +272,83 @@ class GrpcEagerClient : public EagerClient {
   }
 
  private:
+  // Op batching state for the streaming enqueue channel of one remote
+  // context. While an EnqueueRequest is awaiting its response, subsequent
+  // requests are folded into `request` and written to the stream as a
+  // single EnqueueRequest once that response arrives. This amortizes the
+  // per-message overhead when many small ops are enqueued back-to-back,
+  // while an idle channel still sends its first op immediately.
+  struct StreamingEnqueueState {
+    // One entry per StreamingEnqueueAsync call folded into `request`.
+    struct PendingCall {
+      // Caller-owned response, filled with this call's slice of the
+      // batched response.
+      EnqueueResponse* response;
+      // Number of queue items the caller contributed to `request`.
+      int num_items;
+      StatusCallback done;
+    };
+    // Ops accumulated for the next EnqueueRequest on the stream.
+    EnqueueRequest request;
+    std::vector<PendingCall> calls;
+    // True while an EnqueueRequest has been written to the stream and its
+    // response has not yet been received.
+    bool inflight = false;
+  };
+
+  // Called when a streaming enqueue response arrives. Writes the ops
+  // batched up while that request was in flight, if any, to the stream as
+  // one EnqueueRequest and hands each folded call its slice of the
+  // batched response when it completes.
+  void FlushStreamingEnqueue(uint64 context_id) {
+    std::shared_ptr<StreamingRPCDispatcher<EnqueueResponse>> dispatcher;
+    auto request = std::make_shared<EnqueueRequest>();
+    std::vector<StreamingEnqueueState::PendingCall> calls;
+    {
+      mutex_lock l(mu_);
+      auto it = enqueue_states_.find(context_id);
+      if (it == enqueue_states_.end()) {
+        // The context was closed while the response was in flight.
+        return;
+      }
+      StreamingEnqueueState& state = it->second;
+      auto dispatcher_it = enqueue_dispatchers_.find(context_id);
+      if (state.calls.empty() ||
+          dispatcher_it == enqueue_dispatchers_.end()) {
+        state.inflight = false;
+        return;
+      }
+      dispatcher = dispatcher_it->second;
+      request->Swap(&state.request);
+      calls.swap(state.calls);
+      // `state.inflight` stays true for the request sent below.
+    }
+    auto batched_response = std::make_shared<EnqueueResponse>();
+    dispatcher->SendNextRequest(
+        *request, batched_response.get(),
+        [this, context_id, batched_response, calls = std::move(calls)](
+            const Status& status) {
+          FlushStreamingEnqueue(context_id);
+          // The server produces one queue_response per queue item, in
+          // order, so each call's responses start where the previous
+          // call's ended.
+          int offset = 0;
+          for (const StreamingEnqueueState::PendingCall& call : calls) {
+            if (status.ok()) {
+              for (int i = 0;
+                   i < call.num_items &&
+                   offset + i < batched_response->queue_response_size();
+                   ++i) {
+                *call.response->add_queue_response() =
+                    batched_response->queue_response(offset + i);
+              }
+            }
+            offset += call.num_items;
+            call.done(status);
+          }
+        });
+  }
+
   ::grpc::GenericStub stub_;
   const GrpcEagerClientThread* thread_;
   const string target_;
@@ -234,8 +357,12 @@ class GrpcEagerClient : public EagerClient {
 
   mutable mutex mu_;
 
-  std::unordered_map<uint64, StreamingRPCDispatcher<EnqueueResponse>>
+  std::unordered_map<uint64,
+                     std::shared_ptr<StreamingRPCDispatcher<EnqueueResponse>>>
       enqueue_dispatchers_ TF_GUARDED_BY(mu_);
+  // Per-context batching state for the streaming enqueue channel.
+  std::unordered_map<uint64, StreamingEnqueueState> enqueue_states_
+      TF_GUARDED_BY(mu_);
 
   StatusCallback callback_wrapper(StatusCallback done) {
     Ref();
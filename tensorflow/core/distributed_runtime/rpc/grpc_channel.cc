@@ -103,7 +103,9 @@ const ::grpc::ChannelArguments* GetDefaultChannelArguments() {
 
 }  // namespace
 
-::grpc::ChannelArguments GetChannelArguments(const RPCOptions* rpc_options) {
+::grpc::ChannelArguments GetChannelArguments(
+    const RPCOptions* rpc_options,
+    const GrpcChannelSpec::ChannelOptions& channel_options) {
   // TODO(mrry): Implement secure channels.
   ::grpc::ChannelArguments args = *GetDefaultChannelArguments();
   args.SetInt(GRPC_ARG_MAX_MESSAGE_LENGTH, std::numeric_limits<int32>::max());
@@ -134,16 +136,27 @@ const ::grpc::ChannelArguments* GetDefaultChannelArguments() {
       args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, true);
     }
   }
+  if (channel_options.max_concurrent_streams > 0) {
+    VLOG(5) << "Limiting concurrent HTTP/2 streams to "
+            << channel_options.max_concurrent_streams;
+    args.SetInt(GRPC_ARG_MAX_CONCURRENT_STREAMS,
+                channel_options.max_concurrent_streams);
+  }
+  if (channel_options.use_local_subchannel_pool) {
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, true);
+  }
   return args;
 }
 
-Status NewHostPortGrpcChannel(const string& target,
-                              const RPCOptions* rpc_options,
-                              SharedGrpcChannelPtr* channel_pointer) {
+Status NewHostPortGrpcChannel(
+    const string& target, const RPCOptions* rpc_options,
+    SharedGrpcChannelPtr* channel_pointer,
+    const GrpcChannelSpec::ChannelOptions& channel_options) {
   // Minimally ensure that the target is valid
   TF_RETURN_IF_ERROR(ValidateHostPortPair(target));
 
-  ::grpc::ChannelArguments args = GetChannelArguments(rpc_options);
+  ::grpc::ChannelArguments args =
+      GetChannelArguments(rpc_options, channel_options);
   *channel_pointer = ::grpc::CreateCustomChannel(
       "dns:///" + target, ::grpc::InsecureChannelCredentials(), args);
   return OkStatus();
@@ -151,10 +164,15 @@ Status NewHostPortGrpcChannel(const string& target,
 
 ChannelCreationFunction ConvertToChannelCreationFunction(
     const std::function<Status(string, const RPCOptions*,
-                               SharedGrpcChannelPtr*)>& new_channel_func_ptr) {
-  return [new_channel_func_ptr](const string& target) -> SharedGrpcChannelPtr {
+                               SharedGrpcChannelPtr*,
+                               const GrpcChannelSpec::ChannelOptions&)>&
+        new_channel_func_ptr,
+    const GrpcChannelSpec::ChannelOptions& channel_options) {
+  return [new_channel_func_ptr,
+          channel_options](const string& target) -> SharedGrpcChannelPtr {
     SharedGrpcChannelPtr channel_ptr;
-    if (new_channel_func_ptr(target, /*rpc_options=*/nullptr, &channel_ptr)
+    if (new_channel_func_ptr(target, /*rpc_options=*/nullptr, &channel_ptr,
+                             channel_options)
             .ok()) {
       return channel_ptr;
     } else {
@@ -42,6 +42,21 @@ class GrpcChannelSpec {
     const std::map<int, string> host_ports;
   };
 
+  // HTTP/2 stream multiplexing configuration applied to every channel
+  // created from this spec.  Zero/false values leave the gRPC defaults
+  // untouched, so a default-constructed ChannelOptions is a no-op.
+  struct ChannelOptions {
+    // Advertised limit on the number of RPCs multiplexed concurrently onto
+    // one HTTP/2 connection (GRPC_ARG_MAX_CONCURRENT_STREAMS).  When a
+    // worker talks to many peers over few connections, lowering this bounds
+    // head-of-line blocking between large tensor transfers.
+    int32 max_concurrent_streams = 0;
+    // Gives each channel its own subchannel pool, so that
+    // RPCOptions.num_channels_per_target yields genuinely distinct TCP
+    // connections instead of all channels multiplexing one subchannel.
+    bool use_local_subchannel_pool = false;
+  };
+
   Status AddHostPortsJob(const string& job_id,
                          const std::vector<string>& host_ports);
 
@@ -52,9 +67,16 @@ class GrpcChannelSpec {
     return host_ports_jobs_;
   }
 
+  void set_channel_options(const ChannelOptions& channel_options) {
+    channel_options_ = channel_options;
+  }
+
+  const ChannelOptions& channel_options() const { return channel_options_; }
+
  private:
   std::vector<HostPortsJob> host_ports_jobs_;
   std::set<string> job_ids_;
+  ChannelOptions channel_options_;
 };
 
 class GrpcChannelCache {
@@ -87,15 +109,27 @@ GrpcChannelCache* NewGrpcChannelCache(
 
 // Below here are internal-only functions.
 
-::grpc::ChannelArguments GetChannelArguments(const RPCOptions* rpc_options);
+::grpc::ChannelArguments GetChannelArguments(
+    const RPCOptions* rpc_options,
+    const GrpcChannelSpec::ChannelOptions& channel_options =
+        GrpcChannelSpec::ChannelOptions());
 
+// The returned function applies `channel_options` (typically taken from
+// GrpcChannelSpec::channel_options()) to every channel it creates.
 ChannelCreationFunction ConvertToChannelCreationFunction(
     const std::function<Status(string, const RPCOptions*,
-                               SharedGrpcChannelPtr*)>& new_channel_func_ptr);
+                               SharedGrpcChannelPtr*,
+                               const GrpcChannelSpec::ChannelOptions&)>&
+        new_channel_func_ptr,
+    const GrpcChannelSpec::ChannelOptions& channel_options =
+        GrpcChannelSpec::ChannelOptions());
 
 Status NewHostPortGrpcChannel(const string& target,
                               const RPCOptions* rpc_options,
-                              SharedGrpcChannelPtr* channel_pointer);
+                              SharedGrpcChannelPtr* channel_pointer,
+                              const GrpcChannelSpec::ChannelOptions&
+                                  channel_options =
+                                      GrpcChannelSpec::ChannelOptions());
 
 }  // namespace tensorflow
 
@@ -394,4 +394,26 @@ TEST(GrpcChannelTest, NewHostPortGrpcChannelValidation) {
           .ok());
 }
 
+TEST(GrpcChannelTest, ChannelOptions) {
+  GrpcChannelSpec spec;
+  EXPECT_EQ(0, spec.channel_options().max_concurrent_streams);
+  EXPECT_FALSE(spec.channel_options().use_local_subchannel_pool);
+
+  GrpcChannelSpec::ChannelOptions channel_options;
+  channel_options.max_concurrent_streams = 16;
+  channel_options.use_local_subchannel_pool = true;
+  spec.set_channel_options(channel_options);
+  EXPECT_EQ(16, spec.channel_options().max_concurrent_streams);
+  EXPECT_TRUE(spec.channel_options().use_local_subchannel_pool);
+
+  // Channel creation accepts the spec's options.
+  SharedGrpcChannelPtr mock_ptr;
+  EXPECT_TRUE(NewHostPortGrpcChannel("127.0.0.1:2222", /*rpc_options=*/nullptr,
+                                     &mock_ptr, spec.channel_options())
+                  .ok());
+  ChannelCreationFunction channel_func = ConvertToChannelCreationFunction(
+      NewHostPortGrpcChannel, spec.channel_options());
+  EXPECT_NE(nullptr, channel_func("127.0.0.1:2222"));
+}
+
 }  // namespace tensorflow
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_remote_worker.h"
 
+#include <atomic>
 #include <utility>
 
 #include "grpcpp/generic/generic_stub.h"
@@ -45,10 +46,12 @@ class GrpcRemoteWorker : public WorkerInterface {
   explicit GrpcRemoteWorker(SharedGrpcChannelPtr channel,
                             ::grpc::CompletionQueue* completion_queue,
                             thread::ThreadPool* callback_threadpool,
-                            WorkerCacheLogger* logger, const string& target)
+                            WorkerCacheLogger* logger, const string& target,
+                            std::atomic<int64_t>* inflight_rpcs)
       : channel_(std::move(channel)),
         stub_(channel_),
         cq_(completion_queue),
+        inflight_rpcs_(inflight_rpcs),
         callback_threadpool_(callback_threadpool),
         getstatus_(Method(GrpcWorkerMethod::kGetStatus)),
         createworkersession_(Method(GrpcWorkerMethod::kCreateWorkerSession)),
@@ -106,13 +109,16 @@ class GrpcRemoteWorker : public WorkerInterface {
 
   void RunGraphAsync(CallOptions* call_opts, const RunGraphRequest* request,
                      RunGraphResponse* response, StatusCallback done) override {
-    IssueRequest(request, response, rungraph_, std::move(done), call_opts);
+    IssueRequest(request, response, rungraph_,
+                 TimeRpc("RunGraph", response, std::move(done)), call_opts);
   }
   void RunGraphAsync(CallOptions* call_opts, RunGraphRequestWrapper* request,
                      MutableRunGraphResponseWrapper* response,
                      StatusCallback done) override {
-    IssueRequest(&request->ToProto(), get_proto_from_wrapper(response),
-                 rungraph_, std::move(done), call_opts);
+    RunGraphResponse* response_proto = get_proto_from_wrapper(response);
+    IssueRequest(&request->ToProto(), response_proto, rungraph_,
+                 TimeRpc("RunGraph", response_proto, std::move(done)),
+                 call_opts);
   }
 
   void CleanupGraphAsync(const CleanupGraphRequest* request,
@@ -204,11 +210,13 @@ class GrpcRemoteWorker : public WorkerInterface {
 
     auto callback = [this, request, response, done, start_usec,
                      logging_active](Status s) {
+      int64_t end_usec = Env::Default()->NowMicros();
+      int64_t bytes = s.ok() ? response->tensor().TotalBytes() : 0;
+      logger_->RecordRpcStats("RecvTensor", target_, end_usec - start_usec,
+                              bytes);
       if (logging_active) {
         if (logger_->LoggingActive()) {
-          int64_t end_usec = Env::Default()->NowMicros();
           int64_t step_id = request->step_id();
-          int64_t bytes = response->tensor().TotalBytes();
           int64_t send_start_usec = start_usec;
           // If a send start time was reported by the other side, use
           // that instead.  Maybe we should mark the display if we're using
@@ -274,19 +282,50 @@ class GrpcRemoteWorker : public WorkerInterface {
                     StatusCallback done, CallOptions* call_opts = nullptr,
                     bool fail_fast = true) {
     new RPCState<protobuf::Message>(
-        &stub_, cq_, method, *request, response, std::move(done), call_opts,
-        callback_threadpool_, MaxRetries(), fail_fast, &target_);
+        &stub_, cq_, method, *request, response,
+        CountInflight(std::move(done)), call_opts, callback_threadpool_,
+        MaxRetries(), fail_fast, &target_);
   }
 
   void IssueRequest(const protobuf::Message* request, TensorResponse* response,
                     const ::grpc::string& method, StatusCallback done,
                     CallOptions* call_opts = nullptr) {
     new RPCState<TensorResponse>(&stub_, cq_, method, *request, response,
-                                 std::move(done), call_opts,
+                                 CountInflight(std::move(done)), call_opts,
                                  callback_threadpool_, MaxRetries(),
                                  /*fail_fast=*/true, &target_);
   }
 
+  // Wraps `done` so that the RPC's latency and response payload size are
+  // recorded in always-on per-target metrics when it completes.  Latency is
+  // recorded for failed RPCs too; payload size only on success.
+  StatusCallback TimeRpc(const char* method, protobuf::Message* response,
+                         StatusCallback done) {
+    int64_t start_usec = Env::Default()->NowMicros();
+    return [this, method, response, start_usec,
+            done = std::move(done)](const Status& s) {
+      int64_t elapsed_usecs = Env::Default()->NowMicros() - start_usec;
+      logger_->RecordRpcStats(
+          method, target_, elapsed_usecs,
+          s.ok() ? static_cast<int64_t>(response->ByteSizeLong()) : 0);
+      // Note done() can delete this worker object, so we need to call done()
+      // last.
+      done(s);
+    };
+  }
+
+  // Counts the RPC against this worker's completion queue while it is in
+  // flight, so GrpcWorkerEnv can size its polling to actual load.
+  StatusCallback CountInflight(StatusCallback done) {
+    if (inflight_rpcs_ == nullptr) return done;
+    inflight_rpcs_->fetch_add(1, std::memory_order_relaxed);
+    std::atomic<int64_t>* counter = inflight_rpcs_;
+    return [counter, done = std::move(done)](const Status& s) {
+      counter->fetch_sub(1, std::memory_order_relaxed);
+      done(s);
+    };
+  }
+
   void IssueMarkRecvFinishedRequest(int64_t request_id) {
     VLOG(2) << "Send MarkRecvFinishedRequest for request " << request_id;
     MarkRecvFinishedRequest request;
@@ -311,6 +350,7 @@ class GrpcRemoteWorker : public WorkerInterface {
   SharedGrpcChannelPtr channel_;
   ::grpc::GenericStub stub_;
   ::grpc::CompletionQueue* cq_;
+  std::atomic<int64_t>* inflight_rpcs_;  // Not owned; may be null.
   thread::ThreadPool* callback_threadpool_;
 
   const ::grpc::string getstatus_;
@@ -341,9 +381,11 @@ WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
                                      ::grpc::CompletionQueue* completion_queue,
                                      thread::ThreadPool* callback_threadpool,
                                      WorkerCacheLogger* logger,
-                                     const string& target) {
+                                     const string& target,
+                                     std::atomic<int64_t>* inflight_rpcs) {
   return new GrpcRemoteWorker(std::move(channel), completion_queue,
-                              callback_threadpool, logger, target);
+                              callback_threadpool, logger, target,
+                              inflight_rpcs);
 }
 
 }  // namespace tensorflow
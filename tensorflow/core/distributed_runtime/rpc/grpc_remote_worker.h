@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_REMOTE_WORKER_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_REMOTE_WORKER_H_
 
+#include <atomic>
 #include <memory>
 
 #include "grpcpp/completion_queue.h"
@@ -26,11 +27,15 @@ namespace tensorflow {
 class WorkerCacheLogger;
 class WorkerInterface;
 
+// If non-null, `inflight_rpcs` is incremented while each RPC issued by the
+// returned worker is outstanding; GrpcWorkerEnv uses it to size its
+// completion-queue polling to actual load.
 WorkerInterface* NewGrpcRemoteWorker(SharedGrpcChannelPtr channel,
                                      ::grpc::CompletionQueue* completion_queue,
                                      thread::ThreadPool* callback_threadpool,
                                      WorkerCacheLogger* logger,
-                                     const string& target);
+                                     const string& target,
+                                     std::atomic<int64_t>* inflight_rpcs = nullptr);
 
 }  // namespace tensorflow
 
@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/server_lib.h"
 #include "tensorflow/core/distributed_runtime/worker_cache_wrapper.h"
 #include "tensorflow/core/distributed_runtime/worker_env.h"
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/strings/strcat.h"
@@ -412,6 +413,15 @@ Status GrpcServer::WorkerCacheFactory(const WorkerCacheFactoryOptions& options,
   }
   *worker_cache = NewGrpcWorkerCacheWithLocalWorker(
       channel_cache, grpc_worker_env(), worker_impl(), name_prefix);
+  if (WorkerTransport::HasRegisteredTransports()) {
+    // Route peers claimed by a registered transport (e.g. a shared-memory
+    // channel to a same-host worker) around the gRPC stack.
+    *worker_cache = new TransportSelectingWorkerCache(
+        *worker_cache, name_prefix, host_port,
+        [channel_cache](const string& target) {
+          return channel_cache->TranslateTask(target);
+        });
+  }
   return OkStatus();
 }
 
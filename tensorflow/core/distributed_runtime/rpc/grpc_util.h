@@ -57,7 +57,22 @@ class GrpcByteSource : public TensorResponse::Source {
     return stream_;
   }
 
+  core::RefCounted* AcquireContentsRef() override {
+    return new ByteBufferRef(buffer_);
+  }
+
  private:
+  // Holds a reference on the slices of a ByteBuffer so that tensor data
+  // parsed out of it may alias the receive buffer after the RPC's own
+  // ByteBuffer is destroyed.
+  class ByteBufferRef : public core::RefCounted {
+   public:
+    explicit ByteBufferRef(::grpc::ByteBuffer* buffer) : buffer_(*buffer) {}
+
+   private:
+    ::grpc::ByteBuffer buffer_;
+  };
+
   void DeleteStream() {
     if (stream_) {
       stream_->~Reader();
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_cache.h"
 
+#include <algorithm>
+#include <limits>
+#include <memory>
+
 #include "tensorflow/core/distributed_runtime/rpc/coordination/grpc_coordination_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/eager/grpc_eager_client.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_remote_worker.h"
@@ -39,8 +43,7 @@ class GrpcWorkerCache : public WorkerCachePartial {
       : local_target_(local_target),
         local_worker_(local_worker),
         channel_cache_(channel_cache),
-        worker_env_(worker_env),
-        next_round_robin_assignment_(0) {}
+        worker_env_(worker_env) {}
 
   void ListWorkers(std::vector<string>* workers) const override {
     channel_cache_->ListWorkers(workers);
@@ -62,7 +65,8 @@ class GrpcWorkerCache : public WorkerCachePartial {
       size_t index = AssignWorkerToThread(target);
       return NewGrpcRemoteWorker(
           channel, worker_env_->GetCompletionQueue(index),
-          worker_env_->GetThreadPool(), &logger_, target);
+          worker_env_->GetThreadPool(), &logger_, target,
+          worker_env_->GetInflightCounter(index));
     }
   }
 
@@ -98,15 +102,14 @@ class GrpcWorkerCache : public WorkerCachePartial {
 
  private:
   size_t AssignWorkerToThread(const string& target) {
-    // Round-robin target assignment, but keeps the same target on the same
+    // Least-loaded target assignment, but keeps the same target on the same
     // polling thread always, as this is important for gRPC performance
     mutex_lock lock(assignment_mu_);
     auto it = target_assignments_.find(target);
     if (it == target_assignments_.end()) {
       it = target_assignments_
                .insert(std::make_pair(target,
-                                      (next_round_robin_assignment_++) %
-                                          worker_env_->CompletionQueueSize()))
+                                      worker_env_->AssignCompletionQueue()))
                .first;
     }
     return it->second;
@@ -121,19 +124,62 @@ class GrpcWorkerCache : public WorkerCachePartial {
   mutex assignment_mu_;
   std::unordered_map<std::string, size_t> target_assignments_
       TF_GUARDED_BY(assignment_mu_);
-  size_t next_round_robin_assignment_ TF_GUARDED_BY(assignment_mu_);
 };
 
 }  // namespace
 
-GrpcWorkerEnv::GrpcWorkerEnv(size_t num_completion_queues, size_t num_threads)
+// A completion queue counts as saturated once this many RPCs are in flight
+// on it; AssignCompletionQueue starts another polling thread rather than
+// piling more load onto saturated queues.
+static const int64_t kInflightRpcsPerQueue = 32;
+
+GrpcWorkerEnv::GrpcWorkerEnv(size_t num_completion_queues, size_t num_threads,
+                             size_t min_completion_queues)
     : threadpool_(new thread::ThreadPool(
           Env::Default(), ThreadOptions(), "GrpcWorkerEnvQueues", num_threads,
           /*low_latency_hint=*/false, /*allocator=*/nullptr)),
-      threads_(num_completion_queues) {}
+      threads_(num_completion_queues),
+      num_active_(min_completion_queues == 0
+                      ? num_completion_queues
+                      : std::min(min_completion_queues,
+                                 num_completion_queues)) {
+  mutex_lock l(queues_mu_);
+  for (size_t i = 0; i < num_active_; ++i) {
+    threads_[i] = std::make_unique<GrpcWorkerCacheThread>();
+  }
+}
 
 GrpcWorkerEnv::~GrpcWorkerEnv() { threads_.clear(); }
 
+size_t GrpcWorkerEnv::CompletionQueueSize() const {
+  mutex_lock l(queues_mu_);
+  return num_active_;
+}
+
+size_t GrpcWorkerEnv::AssignCompletionQueue() {
+  mutex_lock l(queues_mu_);
+  size_t best = 0;
+  int64_t best_inflight = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < num_active_; ++i) {
+    const int64_t inflight =
+        threads_[i]->inflight_rpcs()->load(std::memory_order_relaxed);
+    if (inflight < best_inflight) {
+      best = i;
+      best_inflight = inflight;
+    }
+  }
+  if (best_inflight >= kInflightRpcsPerQueue &&
+      num_active_ < threads_.size()) {
+    best = num_active_;
+    threads_[best] = std::make_unique<GrpcWorkerCacheThread>();
+    ++num_active_;
+    VLOG(1) << "Started gRPC worker cache completion queue " << best
+            << " (least-loaded queue had " << best_inflight
+            << " RPCs in flight)";
+  }
+  return best;
+}
+
 GrpcWorkerEnv::GrpcWorkerCacheThread::GrpcWorkerCacheThread() {
   thread_.reset(Env::Default()->StartThread(
       ThreadOptions(), "GrpcWorkerEnvPool", [this]() {
@@ -165,7 +211,17 @@ GrpcWorkerEnv* CreateGrpcWorkerEnv() {
   if (!status.ok()) {
     LOG(ERROR) << "Error parsing TF_GRPC_WORKER_CACHE_THREADS: " << status;
   }
-  return new GrpcWorkerEnv(num_completion_queues, num_threads);
+  // Only this many polling threads start up front; the rest (up to
+  // TF_GRPC_WORKER_CACHE_QUEUES) start on demand as in-flight RPC counts
+  // grow, so small deployments don't pay for large-cluster defaults.
+  int64_t min_completion_queues;
+  status = ReadInt64FromEnvVar("TF_GRPC_WORKER_CACHE_MIN_QUEUES", 8,
+                               &min_completion_queues);
+  if (!status.ok()) {
+    LOG(ERROR) << "Error parsing TF_GRPC_WORKER_CACHE_MIN_QUEUES: " << status;
+  }
+  return new GrpcWorkerEnv(num_completion_queues, num_threads,
+                           min_completion_queues);
 }
 
 WorkerCacheInterface* NewGrpcWorkerCache(std::shared_ptr<GrpcChannelCache> cc,
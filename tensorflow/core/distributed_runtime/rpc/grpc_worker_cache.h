@@ -16,28 +16,49 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_WORKER_CACHE_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_WORKER_CACHE_H_
 
+#include <atomic>
+
 #include "tensorflow/core/distributed_runtime/rpc/grpc_channel.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_client_cq_tag.h"
 #include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/threadpool.h"
 
 namespace tensorflow {
 
 class GrpcWorkerEnv {
  public:
-  GrpcWorkerEnv(size_t num_completion_queues, size_t num_threads);
+  // Starts `min_completion_queues` completion-queue polling threads
+  // immediately, and grows on demand up to `num_completion_queues` as
+  // in-flight RPC counts rise (see AssignCompletionQueue).  A
+  // `min_completion_queues` of 0 starts all queues eagerly.
+  GrpcWorkerEnv(size_t num_completion_queues, size_t num_threads,
+                size_t min_completion_queues = 0);
 
   ~GrpcWorkerEnv();
 
   thread::ThreadPool* GetThreadPool() const { return threadpool_.get(); }
 
-  size_t CompletionQueueSize() const { return threads_.size(); }
+  size_t CompletionQueueSize() const;
 
   ::grpc::CompletionQueue* GetCompletionQueue(size_t index) const {
-    return threads_.at(index).completion_queue();
+    return threads_.at(index)->completion_queue();
+  }
+
+  // Returns the number of RPCs currently in flight on the queue at `index`.
+  // The counter is maintained by the workers created against the queue.
+  std::atomic<int64_t>* GetInflightCounter(size_t index) const {
+    return threads_.at(index)->inflight_rpcs();
   }
 
+  // Returns the index of the active completion queue with the fewest RPCs
+  // in flight.  When even the least-loaded queue is saturated and not all
+  // queues have been started, starts another polling thread first, so the
+  // number of pollers tracks actual RPC concurrency instead of cluster
+  // size.
+  size_t AssignCompletionQueue();
+
  private:
   // Thread wrapping class that drives work over a single gRPC
   // CompletionQueue.
@@ -51,13 +72,21 @@ class GrpcWorkerEnv {
       return &completion_queue_;
     }
 
+    std::atomic<int64_t>* inflight_rpcs() const { return &inflight_rpcs_; }
+
    private:
     mutable ::grpc::CompletionQueue completion_queue_;
+    mutable std::atomic<int64_t> inflight_rpcs_{0};
     std::unique_ptr<Thread> thread_;
   };
 
   std::unique_ptr<thread::ThreadPool> threadpool_;
-  std::vector<GrpcWorkerCacheThread> threads_;
+  // Sized to the maximum number of completion queues; entries at index >=
+  // num_active_ are null until activated by AssignCompletionQueue.
+  std::vector<std::unique_ptr<GrpcWorkerCacheThread>> threads_;
+
+  mutable mutex queues_mu_;
+  size_t num_active_ TF_GUARDED_BY(queues_mu_);
 };
 
 // Create a GrpcWorkerEnv instance that can be used as argument to create
@@ -84,4 +84,32 @@ TEST(GrpcWorkerCacheTest, DestructWorkerCacheInThreadPool) {
   n.WaitForNotification();
 }
 
+TEST(GrpcWorkerCacheTest, AdaptiveCompletionQueues) {
+  // Start with one active completion queue out of a maximum of three.
+  GrpcWorkerEnv grpc_worker_env(/*num_completion_queues=*/3,
+                                /*num_threads=*/2,
+                                /*min_completion_queues=*/1);
+  EXPECT_EQ(1, grpc_worker_env.CompletionQueueSize());
+
+  // While the only queue is lightly loaded, new targets stay on it.
+  EXPECT_EQ(0, grpc_worker_env.AssignCompletionQueue());
+  EXPECT_EQ(1, grpc_worker_env.CompletionQueueSize());
+
+  // Once the least-loaded queue is saturated, another queue is started and
+  // gets the next assignment; later assignments prefer the idle queue.
+  grpc_worker_env.GetInflightCounter(0)->store(1000);
+  EXPECT_EQ(1, grpc_worker_env.AssignCompletionQueue());
+  EXPECT_EQ(2, grpc_worker_env.CompletionQueueSize());
+  EXPECT_EQ(1, grpc_worker_env.AssignCompletionQueue());
+  EXPECT_EQ(2, grpc_worker_env.CompletionQueueSize());
+
+  // Growth stops at num_completion_queues.
+  grpc_worker_env.GetInflightCounter(1)->store(1000);
+  EXPECT_EQ(2, grpc_worker_env.AssignCompletionQueue());
+  EXPECT_EQ(3, grpc_worker_env.CompletionQueueSize());
+  grpc_worker_env.GetInflightCounter(2)->store(999);
+  EXPECT_EQ(2, grpc_worker_env.AssignCompletionQueue());
+  EXPECT_EQ(3, grpc_worker_env.CompletionQueueSize());
+}
+
 }  // namespace tensorflow
@@ -18,15 +18,48 @@ limitations under the License.
 #include "google/protobuf/any.pb.h"
 
 #include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Minimum tensor_content size for which we try to alias the transport's
+// receive buffer instead of copying; mirrors kLargeTensorBytes on the
+// grpc_tensor_coding send side.
+static const int kMinContentBytesForSharing = 1024;
+
+// TensorBuffer backed by a transport-owned chunk of memory.  Holds a
+// reference that keeps the transport buffer alive for as long as any
+// tensor aliases it.
+class TransportOwnedBuffer : public TensorBuffer {
+ public:
+  TransportOwnedBuffer(void* data, size_t len, core::RefCounted* owner)
+      : TensorBuffer(data), len_(len), owner_(owner) {}
+  ~TransportOwnedBuffer() override { owner_->Unref(); }
+
+  size_t size() const override { return len_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(len_);
+    proto->set_allocator_name("transport_owned");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t len_;
+  core::RefCounted* const owner_;
+};
+
+}  // namespace
+
 TensorResponse::Source::~Source() {}
 
 void TensorResponse::Clear() {
   on_host_ = false;
+  can_share_transport_buffer_ = false;
   device_ = nullptr;
   alloc_attrs_ = AllocatorAttributes();
   allocator_ = nullptr;
@@ -47,6 +80,12 @@ void TensorResponse::InitAlloc(DeviceBase* d, const AllocatorAttributes& aa) {
   if (alloc_attrs_.on_host() || da.device_type() == "CPU") {
     on_host_ = true;
   }
+  // Transport buffers are plain host memory; tensors that must satisfy
+  // stronger allocation requirements (e.g. pinned memory for later DMA to
+  // an accelerator) always get a copy.
+  can_share_transport_buffer_ = da.device_type() == "CPU" &&
+                                !alloc_attrs_.gpu_compatible() &&
+                                !alloc_attrs_.nic_compatible();
   allocator_ = device_->GetAllocator(alloc_attrs_);
 }
 
@@ -144,7 +183,8 @@ bool ReadNestedMessage(protobuf::io::CodedInputStream* input,
 }  // namespace
 
 bool TensorResponse::ParseTensorSubmessage(
-    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta) {
+    protobuf::io::CodedInputStream* input, Source* source,
+    TensorProto* tensor_meta) {
   bool seen_tensor_content = false;
   while (true) {
     auto p = input->ReadTagWithCutoff(127);
@@ -195,12 +235,36 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
+        // Zero-copy path: when the transport can share ownership of its
+        // receive buffer and the entire tensor content is contiguous and
+        // suitably aligned within it, alias the bytes in place instead of
+        // copying them into a freshly allocated tensor.
+        if (can_share_transport_buffer_ && source != nullptr &&
+            num_bytes > kMinContentBytesForSharing &&
+            static_cast<int64_t>(num_bytes) ==
+                shape.num_elements() * DataTypeSize(tensor_meta->dtype())) {
+          const void* data = nullptr;
+          int size = 0;
+          if (input->GetDirectBufferPointer(&data, &size) &&
+              size >= num_bytes &&
+              reinterpret_cast<uintptr_t>(data) % EIGEN_MAX_ALIGN_BYTES == 0) {
+            core::RefCounted* owner = source->AcquireContentsRef();
+            if (owner != nullptr) {
+              TensorBuffer* buf = new TransportOwnedBuffer(
+                  const_cast<void*>(data), static_cast<size_t>(num_bytes),
+                  owner);
+              tensor_ = Tensor(tensor_meta->dtype(), shape, buf);
+              buf->Unref();
+              input->Skip(num_bytes);
+              break;
+            }
+          }
+        }
+        // Copy fallback: the transport can't share ownership, or the content
+        // isn't contiguous or aligned in its receive buffer.
         Tensor t(allocator_, tensor_meta->dtype(), shape);
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
-        // TODO(jeff,sanjay): Figure out a way to avoid this copy if
-        // the underlying ZeroCopyInputStream data is properly aligned
-        // and compatible with what allocator_ wants.
         if (!input->ReadRaw(const_cast<char*>(buf.data()), num_bytes))
           return false;
         tensor_ = std::move(t);
@@ -233,7 +297,7 @@ bool TensorResponse::ParseFast(Source* source) {
         std::pair<protobuf::io::CodedInputStream::Limit, int> p =
             input.IncrementRecursionDepthAndPushLimit(length);
         if (p.second < 0 ||
-            !ParseTensorSubmessage(&input, meta_.mutable_tensor())) {
+            !ParseTensorSubmessage(&input, source, meta_.mutable_tensor())) {
           return false;
         }
         if (!input.DecrementRecursionDepthAndPopLimit(p.first)) {
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/types.h"
@@ -63,6 +64,14 @@ class TensorResponse {
     // Ownership of the returned stream is retained by the Source and
     // should not be deleted by the caller.
     virtual ::tensorflow::protobuf::io::ZeroCopyInputStream* contents() = 0;
+
+    // If the data yielded by contents() lives in reference-counted transport
+    // buffers, returns a new reference that keeps those buffers (and hence
+    // the bytes previously yielded by contents()) alive; the caller must
+    // Unref() it once it no longer needs the bytes.  Returns nullptr when
+    // the transport cannot share ownership, in which case callers must copy
+    // any data they wish to retain.
+    virtual core::RefCounted* AcquireContentsRef() { return nullptr; }
   };
 
   // Parse the RecvTensorResponse encoded in the data yielded by
@@ -92,11 +101,14 @@ class TensorResponse {
 
  private:
   bool ParseTensorSubmessage(protobuf::io::CodedInputStream* input,
-                             TensorProto* tensor_meta);
+                             Source* source, TensorProto* tensor_meta);
   bool ParseFast(Source* source);
   bool ParseSlow(Source* source);
 
   bool on_host_ = false;
+  // True if parsed tensor contents may alias the transport's receive buffer
+  // instead of being copied into a freshly allocated tensor.
+  bool can_share_transport_buffer_ = false;
   DeviceBase* device_ = nullptr;
   AllocatorAttributes alloc_attrs_;
   Allocator* allocator_ = nullptr;
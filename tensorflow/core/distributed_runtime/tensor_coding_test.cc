@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include <cstring>
+#include <memory>
+#include <vector>
+
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -72,6 +76,38 @@ class StringSource : public TensorResponse::Source {
   int block_size_;
 };
 
+// Source whose backing bytes are reference counted, as a gRPC receive
+// buffer's are; lets tests exercise the zero-copy tensor_content path.
+class RefCountedSource : public TensorResponse::Source {
+ public:
+  RefCountedSource(const char* data, size_t size, bool* released)
+      : data_(data), size_(size), released_(released) {}
+
+  protobuf::io::ZeroCopyInputStream* contents() override {
+    stream_.reset(new protobuf::io::ArrayInputStream(data_, size_, -1));
+    return stream_.get();
+  }
+
+  core::RefCounted* AcquireContentsRef() override {
+    return new Ref(released_);
+  }
+
+ private:
+  class Ref : public core::RefCounted {
+   public:
+    explicit Ref(bool* released) : released_(released) {}
+    ~Ref() override { *released_ = true; }
+
+   private:
+    bool* const released_;
+  };
+
+  const char* data_;
+  size_t size_;
+  bool* released_;
+  std::unique_ptr<protobuf::io::ArrayInputStream> stream_;
+};
+
 class TensorResponseTest : public ::testing::Test {
  public:
   void Validate(const Tensor& src, bool is_dead, bool use_tensor_content) {
@@ -156,6 +192,88 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+// Builds an encoded RecvTensorResponse holding kSharingTestElems 'Z' bytes
+// of tensor content and copies it into *storage so that the content begins
+// at (start of encoding + extra_shift) modulo EIGEN_MAX_ALIGN_BYTES.
+// Returns the start of the encoding, and the content's offset within it in
+// *content_offset.
+static const int kSharingTestElems = 2048;
+char* MakeShiftedTensorTestCase(size_t extra_shift, std::vector<char>* storage,
+                                size_t* encoded_size, size_t* content_offset) {
+  Tensor src(DT_INT8, TensorShape({kSharingTestElems}));
+  std::vector<int8> v(kSharingTestElems, 'Z');
+  test::FillValues<int8>(&src, v);
+  RecvTensorResponse proto;
+  proto.set_is_dead(false);
+  proto.set_send_start_micros(123456);
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+
+  string pattern(kSharingTestElems, 'Z');
+  size_t offset = encoded.find(pattern);
+  CHECK_NE(offset, string::npos);
+  storage->resize(encoded.size() + 2 * EIGEN_MAX_ALIGN_BYTES);
+  char* base = storage->data();
+  size_t shift =
+      (EIGEN_MAX_ALIGN_BYTES + extra_shift -
+       (reinterpret_cast<uintptr_t>(base) + offset) % EIGEN_MAX_ALIGN_BYTES) %
+      EIGEN_MAX_ALIGN_BYTES;
+  char* start = base + shift;
+  memcpy(start, encoded.data(), encoded.size());
+  *encoded_size = encoded.size();
+  *content_offset = offset;
+  return start;
+}
+
+TEST_F(TensorResponseTest, SharesAlignedTransportBuffer) {
+  std::vector<char> storage;
+  size_t encoded_size, content_offset;
+  char* start = MakeShiftedTensorTestCase(/*extra_shift=*/0, &storage,
+                                          &encoded_size, &content_offset);
+
+  bool released = false;
+  RefCountedSource source(start, encoded_size, &released);
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+  Status s = response.ParseFrom(&source);
+  EXPECT_TRUE(s.ok());
+
+  const Tensor& result = response.tensor();
+  EXPECT_EQ(result.dtype(), DT_INT8);
+  EXPECT_EQ(result.NumElements(), kSharingTestElems);
+  // The tensor aliases the receive buffer rather than owning a copy, and
+  // holds a reference on it.
+  EXPECT_EQ(result.tensor_data().data(), start + content_offset);
+  EXPECT_FALSE(released);
+  response.Clear();
+  EXPECT_TRUE(released);
+}
+
+TEST_F(TensorResponseTest, CopiesUnalignedTransportBuffer) {
+  std::vector<char> storage;
+  size_t encoded_size, content_offset;
+  char* start = MakeShiftedTensorTestCase(/*extra_shift=*/1, &storage,
+                                          &encoded_size, &content_offset);
+
+  bool released = false;
+  RefCountedSource source(start, encoded_size, &released);
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+  Status s = response.ParseFrom(&source);
+  EXPECT_TRUE(s.ok());
+
+  const Tensor& result = response.tensor();
+  EXPECT_EQ(result.NumElements(), kSharingTestElems);
+  // Misaligned content falls back to a copy and takes no buffer reference.
+  EXPECT_NE(result.tensor_data().data(), start + content_offset);
+  EXPECT_EQ(0, memcmp(result.tensor_data().data(), start + content_offset,
+                      kSharingTestElems));
+  EXPECT_FALSE(released);
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
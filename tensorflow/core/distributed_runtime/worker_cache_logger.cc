@@ -82,6 +82,30 @@ void WorkerCacheLogger::Save(const string& device, int64_t step_id,
   }
 }
 
+void WorkerCacheLogger::RecordRpcStats(const string& method,
+                                       const string& target,
+                                       int64_t elapsed_usecs, int64_t bytes) {
+  RpcStatsCells cells;
+  {
+    const string key = strings::StrCat(method, "/", target);
+    mutex_lock l(stats_mu_);
+    auto it = stats_cells_.find(key);
+    if (it == stats_cells_.end()) {
+      it = stats_cells_
+               .emplace(key,
+                        RpcStatsCells{
+                            metrics::GetWorkerRpcLatencyHistogram(method,
+                                                                  target),
+                            metrics::GetWorkerRpcBytesReceivedCounter(method,
+                                                                      target)})
+               .first;
+    }
+    cells = it->second;
+  }
+  cells.latency_usecs->Add(elapsed_usecs);
+  if (bytes > 0) cells.bytes_received->IncrementBy(bytes);
+}
+
 void WorkerCacheLogger::RecordRecvTensor(int64_t step_id, int64_t start_usecs,
                                          int64_t end_usecs,
                                          const string& tensor_name,
@@ -19,6 +19,7 @@ limitations under the License.
 #include <string>
 #include <unordered_map>
 
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/step_stats.pb.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/thread_annotations.h"
@@ -68,6 +69,13 @@ class WorkerCacheLogger {
                           int64_t bytes, const string& details,
                           const string& transfer_method_name);
 
+  // Records the latency and payload size of a completed RPC to `target` in
+  // always-on monitoring metrics.  Unlike the step-stats logging above, this
+  // does not depend on logging being enabled and is cheap enough to call on
+  // every RPC.
+  void RecordRpcStats(const string& method, const string& target,
+                      int64_t elapsed_usecs, int64_t bytes);
+
  private:
   mutex count_mu_;
   int32 want_logging_count_ TF_GUARDED_BY(count_mu_) = 0;
@@ -80,6 +88,16 @@ class WorkerCacheLogger {
   mutex mu_;
   LogMap log_map_ TF_GUARDED_BY(mu_);
 
+  // Monitoring cells cached by "<method>/<target>" so that recording per-RPC
+  // stats does not repeatedly look up the metric registry.
+  struct RpcStatsCells {
+    monitoring::SamplerCell* latency_usecs;
+    monitoring::CounterCell* bytes_received;
+  };
+  mutex stats_mu_;
+  std::unordered_map<string, RpcStatsCells> stats_cells_
+      TF_GUARDED_BY(stats_mu_);
+
   // Records "ns" in log_map_ under the given device and step.
   void Save(const string& device, int64_t step_id, NodeExecStats* ns);
 
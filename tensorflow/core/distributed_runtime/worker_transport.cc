@@ -0,0 +1,134 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
+
+#include <utility>
+
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+namespace {
+
+mutex* get_worker_transport_lock() {
+  static mutex worker_transport_lock(LINKER_INITIALIZED);
+  return &worker_transport_lock;
+}
+
+// Registration order is preserved so that selection among transports that
+// claim the same peer is deterministic.
+typedef std::vector<std::pair<string, WorkerTransport*>> WorkerTransports;
+WorkerTransports* worker_transports() {
+  static WorkerTransports* transports = new WorkerTransports;
+  return transports;
+}
+
+// Strips the ":port" suffix from a "host:port" string, normalizing loopback
+// names; returns the empty string if there is no host part.
+string HostPart(const string& host_port) {
+  auto colon_index = host_port.find_last_of(':');
+  string host = host_port.substr(0, colon_index);
+  if (host == "localhost" || host == "127.0.0.1" || host == "[::1]") {
+    return "localhost";
+  }
+  return host;
+}
+
+}  // namespace
+
+/* static */
+void WorkerTransport::Register(const string& transport_name,
+                               WorkerTransport* transport) {
+  mutex_lock l(*get_worker_transport_lock());
+  for (const auto& entry : *worker_transports()) {
+    if (entry.first == transport_name) {
+      LOG(ERROR) << "Two worker transports are being registered under "
+                 << transport_name;
+      return;
+    }
+  }
+  worker_transports()->push_back({transport_name, transport});
+}
+
+/* static */
+WorkerTransport* WorkerTransport::GetForPeer(const string& target,
+                                             const string& local_host_port,
+                                             const string& peer_host_port) {
+  mutex_lock l(*get_worker_transport_lock());
+  for (const auto& entry : *worker_transports()) {
+    if (entry.second->SupportsPeer(target, local_host_port, peer_host_port)) {
+      return entry.second;
+    }
+  }
+  return nullptr;
+}
+
+/* static */
+bool WorkerTransport::HasRegisteredTransports() {
+  mutex_lock l(*get_worker_transport_lock());
+  return !worker_transports()->empty();
+}
+
+/* static */
+bool WorkerTransport::IsSameHost(const string& a, const string& b) {
+  const string host_a = HostPart(a);
+  const string host_b = HostPart(b);
+  // An empty or wildcard host identifies no particular machine.
+  if (host_a.empty() || host_b.empty() || host_a == "0.0.0.0" ||
+      host_b == "0.0.0.0") {
+    return false;
+  }
+  return host_a == host_b;
+}
+
+WorkerInterface* TransportSelectingWorkerCache::GetOrCreateWorker(
+    const string& target) {
+  // The wrapped cache already short-circuits the local worker; transports
+  // only ever replace the channel to a different process.
+  if (target != local_target_) {
+    WorkerTransport* transport = WorkerTransport::GetForPeer(
+        target, local_host_port_, translate_task_(target));
+    if (transport != nullptr) {
+      WorkerInterface* worker = transport->CreateWorker(target);
+      if (worker != nullptr) {
+        mutex_lock l(mu_);
+        transport_workers_[worker] = transport;
+        return worker;
+      }
+    }
+  }
+  return WorkerCacheWrapper::GetOrCreateWorker(target);
+}
+
+void TransportSelectingWorkerCache::ReleaseWorker(const string& target,
+                                                  WorkerInterface* worker) {
+  WorkerTransport* transport = nullptr;
+  {
+    mutex_lock l(mu_);
+    auto it = transport_workers_.find(worker);
+    if (it != transport_workers_.end()) {
+      transport = it->second;
+      transport_workers_.erase(it);
+    }
+  }
+  if (transport != nullptr) {
+    transport->ReleaseWorker(target, worker);
+    return;
+  }
+  WorkerCacheWrapper::ReleaseWorker(target, worker);
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,128 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/distributed_runtime/worker_cache_wrapper.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+class WorkerInterface;
+
+// A WorkerTransport provides an alternate channel to a peer task that
+// bypasses the default gRPC stack when it can reach the peer more
+// efficiently, e.g. a shared-memory ring between workers co-located on one
+// host.  Transports register themselves in a process-global registry, and
+// TransportSelectingWorkerCache (below) consults the registry for each peer,
+// falling back to the wrapped gRPC cache when no transport claims it.  The
+// substitution happens entirely below WorkerCacheInterface, so it is
+// invisible to RpcRendezvousMgr and everything else that exchanges tensors
+// through WorkerInterface.
+class WorkerTransport {
+ public:
+  virtual ~WorkerTransport() {}
+
+  // Returns true if this transport can reach the task named "target"
+  // (e.g. "/job:ps/replica:0/task:3").  `local_host_port` is the address
+  // this process's worker service is bound to and `peer_host_port` is the
+  // peer's advertised address.  Transports that communicate through
+  // host-local mechanisms should accept only same-host peers; see
+  // IsSameHost() below.
+  virtual bool SupportsPeer(const string& target, const string& local_host_port,
+                            const string& peer_host_port) = 0;
+
+  // Returns a WorkerInterface that reaches "target" over this transport, or
+  // nullptr if the channel cannot be established (e.g. the peer does not
+  // advertise the transport's endpoint), in which case the caller falls
+  // back to the default transport.  The returned worker must be returned
+  // with ReleaseWorker().
+  virtual WorkerInterface* CreateWorker(const string& target) = 0;
+
+  // Release a worker previously returned by this->CreateWorker(target).
+  virtual void ReleaseWorker(const string& target, WorkerInterface* worker) {
+    // Subclasses may override to reuse worker objects.
+    delete worker;
+  }
+
+  // For each WorkerTransport subclass, an instance of that class must be
+  // registered by calling this method.  The `transport_name` must be unique
+  // to the transport.  The registry does not take ownership.
+  static void Register(const string& transport_name,
+                       WorkerTransport* transport);
+
+  // Returns the first registered transport (in registration order) claiming
+  // the given peer, or nullptr if none does.
+  static WorkerTransport* GetForPeer(const string& target,
+                                     const string& local_host_port,
+                                     const string& peer_host_port);
+
+  // Returns true iff any transport has been registered; lets callers skip
+  // the selection layer entirely in the common all-gRPC deployment.
+  static bool HasRegisteredTransports();
+
+  // Returns true if "host:port" strings `a` and `b` name the same host,
+  // treating "localhost" and the loopback address as equivalent.  Returns
+  // false when either host part is empty or a wildcard, since a wildcard
+  // bind address identifies no particular host.
+  static bool IsSameHost(const string& a, const string& b);
+};
+
+// WorkerCacheInterface that routes each peer through the first registered
+// WorkerTransport claiming it, and delegates everything else (including the
+// local worker and all peers no transport claims) to the wrapped cache.
+class TransportSelectingWorkerCache : public WorkerCacheWrapper {
+ public:
+  // `translate_task` maps a task name to its advertised host:port address,
+  // as GrpcChannelCache::TranslateTask does.  Takes ownership of `wrapped`.
+  TransportSelectingWorkerCache(
+      WorkerCacheInterface* wrapped, const string& local_target,
+      const string& local_host_port,
+      std::function<string(const string&)> translate_task)
+      : WorkerCacheWrapper(wrapped),
+        owned_wrapped_(wrapped),
+        local_target_(local_target),
+        local_host_port_(local_host_port),
+        translate_task_(std::move(translate_task)) {}
+
+  WorkerInterface* GetOrCreateWorker(const string& target) override;
+
+  void ReleaseWorker(const string& target, WorkerInterface* worker) override;
+
+ private:
+  std::unique_ptr<WorkerCacheInterface> owned_wrapped_;
+  const string local_target_;
+  const string local_host_port_;
+  std::function<string(const string&)> translate_task_;
+
+  mutex mu_;
+  // Workers handed out by a transport, so ReleaseWorker can route them back
+  // to it rather than to the wrapped cache.
+  std::unordered_map<WorkerInterface*, WorkerTransport*> transport_workers_
+      TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
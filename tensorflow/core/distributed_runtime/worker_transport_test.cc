@@ -0,0 +1,135 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
+
+#include <string>
+
+#include "tensorflow/core/distributed_runtime/test_utils.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class FakeTransportWorker : public TestWorkerInterface {};
+
+// Transport that claims every same-host peer, handing out
+// FakeTransportWorker instances.
+class FakeTransport : public WorkerTransport {
+ public:
+  bool SupportsPeer(const string& target, const string& local_host_port,
+                    const string& peer_host_port) override {
+    return IsSameHost(local_host_port, peer_host_port);
+  }
+
+  WorkerInterface* CreateWorker(const string& target) override {
+    if (fail_create) return nullptr;
+    ++live_workers;
+    return new FakeTransportWorker;
+  }
+
+  void ReleaseWorker(const string& target, WorkerInterface* worker) override {
+    --live_workers;
+    delete worker;
+  }
+
+  int live_workers = 0;
+  bool fail_create = false;
+};
+
+// Registration is process-global, so all tests share one instance.
+FakeTransport* GetFakeTransport() {
+  static FakeTransport* transport = []() {
+    auto* t = new FakeTransport;
+    WorkerTransport::Register("fake", t);
+    return t;
+  }();
+  return transport;
+}
+
+const char kLocalTarget[] = "/job:worker/replica:0/task:0";
+const char kSameHostTarget[] = "/job:worker/replica:0/task:1";
+const char kRemoteTarget[] = "/job:worker/replica:0/task:2";
+
+string TranslateTask(const string& target) {
+  if (target == kLocalTarget) return "hosta:1111";
+  if (target == kSameHostTarget) return "hosta:2222";
+  return "hostb:1111";
+}
+
+TEST(WorkerTransportTest, IsSameHost) {
+  EXPECT_TRUE(WorkerTransport::IsSameHost("hosta:1111", "hosta:2222"));
+  EXPECT_TRUE(WorkerTransport::IsSameHost("localhost:1111", "127.0.0.1:2222"));
+  EXPECT_FALSE(WorkerTransport::IsSameHost("hosta:1111", "hostb:1111"));
+  // Wildcard and empty hosts identify no particular machine.
+  EXPECT_FALSE(WorkerTransport::IsSameHost("0.0.0.0:1111", "0.0.0.0:2222"));
+  EXPECT_FALSE(WorkerTransport::IsSameHost(":1111", ":1111"));
+}
+
+TEST(WorkerTransportTest, HasRegisteredTransports) {
+  GetFakeTransport();
+  EXPECT_TRUE(WorkerTransport::HasRegisteredTransports());
+}
+
+TEST(WorkerTransportTest, RoutesSameHostPeersThroughTransport) {
+  FakeTransport* transport = GetFakeTransport();
+  auto* wrapped = new TestWorkerCache;
+  FakeTransportWorker remote_worker;
+  wrapped->AddWorker(kRemoteTarget, &remote_worker);
+  TransportSelectingWorkerCache cache(wrapped, kLocalTarget, "hosta:1111",
+                                      TranslateTask);
+
+  // A same-host peer goes through the transport...
+  WorkerInterface* worker = cache.GetOrCreateWorker(kSameHostTarget);
+  ASSERT_NE(worker, nullptr);
+  EXPECT_EQ(transport->live_workers, 1);
+  // ...and is released back to it.
+  cache.ReleaseWorker(kSameHostTarget, worker);
+  EXPECT_EQ(transport->live_workers, 0);
+
+  // A remote peer falls through to the wrapped cache.
+  EXPECT_EQ(cache.GetOrCreateWorker(kRemoteTarget), &remote_worker);
+  EXPECT_EQ(transport->live_workers, 0);
+  cache.ReleaseWorker(kRemoteTarget, &remote_worker);
+}
+
+TEST(WorkerTransportTest, LocalTargetIsNeverDiverted) {
+  FakeTransport* transport = GetFakeTransport();
+  auto* wrapped = new TestWorkerCache;
+  FakeTransportWorker local_worker;
+  wrapped->AddWorker(kLocalTarget, &local_worker);
+  TransportSelectingWorkerCache cache(wrapped, kLocalTarget, "hosta:1111",
+                                      TranslateTask);
+
+  EXPECT_EQ(cache.GetOrCreateWorker(kLocalTarget), &local_worker);
+  EXPECT_EQ(transport->live_workers, 0);
+}
+
+TEST(WorkerTransportTest, FallsBackWhenTransportCannotConnect) {
+  FakeTransport* transport = GetFakeTransport();
+  auto* wrapped = new TestWorkerCache;
+  FakeTransportWorker same_host_worker;
+  wrapped->AddWorker(kSameHostTarget, &same_host_worker);
+  TransportSelectingWorkerCache cache(wrapped, kLocalTarget, "hosta:1111",
+                                      TranslateTask);
+
+  transport->fail_create = true;
+  EXPECT_EQ(cache.GetOrCreateWorker(kSameHostTarget), &same_host_worker);
+  EXPECT_EQ(transport->live_workers, 0);
+  transport->fail_create = false;
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -512,7 +512,7 @@ class IteratorContext {
     return params_.allocator_getter(attrs);
   }
 
-  std::function<Allocator*(AllocatorAttributes)> allocator_getter() {
+  const std::function<Allocator*(AllocatorAttributes)>& allocator_getter() {
     return params_.allocator_getter;
   }
 
@@ -548,11 +548,11 @@ class IteratorContext {
 
   int32 runner_threadpool_size() { return params_.runner_threadpool_size; }
 
-  std::vector<std::shared_ptr<SplitProvider>> split_providers() {
+  const std::vector<std::shared_ptr<SplitProvider>>& split_providers() {
     return params_.split_providers;
   }
 
-  std::shared_ptr<StatsAggregator> stats_aggregator() {
+  const std::shared_ptr<StatsAggregator>& stats_aggregator() {
     return params_.stats_aggregator;
   }
 
@@ -750,6 +750,12 @@ class IteratorBase {
   // this iterator.
   virtual const string& prefix() const = 0;
 
+  // Returns the autotuning model instrumenting this iterator tree, if the
+  // iterator maintains one. Currently only the root iterator created by
+  // `FinalizeDataset` does, and only when autotuning is enabled; all other
+  // iterators return nullptr.
+  virtual std::shared_ptr<model::Model> model() const { return nullptr; }
+
   // Performs initialization that needs to happen outside of a constructor to
   // properly propagate errors.
   virtual Status Initialize(IteratorContext* ctx) { return OkStatus(); }
@@ -31,6 +31,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/control_flow.h"
@@ -151,6 +152,18 @@ class Device : public DeviceBase {
     return OkStatus();
   }
 
+  // Fills "*device_context_map" with a DeviceContext* for each node in
+  // "graph", indexed by node id, or leaves it empty if every node should use
+  // the context returned by TryGetDeviceContext(). Entries may be nullptr
+  // for nodes that should use the default context.
+  //
+  // The returned contexts are owned by the device and remain valid for the
+  // device's lifetime; callers must not unref them.
+  virtual Status FillContextMap(
+      const Graph* graph, std::vector<DeviceContext*>* device_context_map) {
+    return OkStatus();
+  }
+
   // Returns the op segment of this device.  The caller can reuse op
   // kernels registered for the same session running on this device.
   OpSegment* op_segment() { return &op_seg_; }
@@ -14,7 +14,10 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/framework/function_handle_cache.h"
 
-#include "tensorflow/core/lib/gtl/map_util.h"
+#include <memory>
+#include <utility>
+
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 
@@ -23,7 +26,8 @@ namespace tensorflow {
 FunctionHandleCache::FunctionHandleCache(FunctionLibraryRuntime* lib)
     : lib_(lib),
       state_handle_(
-          strings::Printf("%lld", static_cast<long long>(random::New64()))) {}
+          strings::Printf("%lld", static_cast<long long>(random::New64()))),
+      snapshot_(std::make_shared<const HandleMap>()) {}
 
 FunctionHandleCache::~FunctionHandleCache() {
   Status s = Clear();
@@ -37,29 +41,48 @@ Status FunctionHandleCache::Instantiate(
     FunctionLibraryRuntime::InstantiateOptions options,
     FunctionLibraryRuntime::Handle* handle) {
   string key = Canonicalize(function_name, attrs, options);
-  FunctionLibraryRuntime::Handle h;
   {
-    tf_shared_lock l(mu_);
-    h = gtl::FindWithDefault(handles_, key, kInvalidHandle);
+    std::shared_ptr<const HandleMap> snapshot = Snapshot();
+    auto iter = snapshot->find(key);
+    if (iter != snapshot->end()) {
+      *handle = iter->second;
+      return OkStatus();
+    }
+  }
+  // Instantiation is serialized per shard so that concurrent requests for the
+  // same function run the instantiation once, while requests for different
+  // functions proceed in parallel on other shards.
+  Shard& shard = shards_[Hash64(key) & (kNumShards - 1)];
+  mutex_lock shard_lock(shard.mu);
+  {
+    // Re-check: another thread may have published the handle while this one
+    // waited for the shard lock.
+    std::shared_ptr<const HandleMap> snapshot = Snapshot();
+    auto iter = snapshot->find(key);
+    if (iter != snapshot->end()) {
+      *handle = iter->second;
+      return OkStatus();
+    }
   }
-  if (h == kInvalidHandle) {
-    options.state_handle = state_handle_;
-    TF_RETURN_IF_ERROR(
-        lib_->Instantiate(function_name, attrs, options, handle));
+  options.state_handle = state_handle_;
+  TF_RETURN_IF_ERROR(lib_->Instantiate(function_name, attrs, options, handle));
+  {
     mutex_lock l(mu_);
-    handles_[key] = *handle;
-  } else {
-    *handle = h;
+    auto updated = std::make_shared<HandleMap>(*snapshot_);
+    (*updated)[key] = *handle;
+    std::atomic_store(&snapshot_,
+                      std::shared_ptr<const HandleMap>(std::move(updated)));
   }
   return OkStatus();
 }
 
 Status FunctionHandleCache::Clear() {
   mutex_lock l(mu_);
-  for (const auto& entry : handles_) {
+  std::shared_ptr<const HandleMap> snapshot = snapshot_;
+  std::atomic_store(&snapshot_, std::make_shared<const HandleMap>());
+  for (const auto& entry : *snapshot) {
     TF_RETURN_IF_ERROR(lib_->ReleaseHandle(entry.second));
   }
-  handles_.clear();
   return OkStatus();
 }
 
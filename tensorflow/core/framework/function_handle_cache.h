@@ -15,13 +15,23 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_FUNCTION_HANDLE_CACHE_H_
 #define TENSORFLOW_CORE_FRAMEWORK_FUNCTION_HANDLE_CACHE_H_
 
+#include <array>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "tensorflow/core/framework/function.h"
 
 namespace tensorflow {
 
 // Thread-safe data structure for caching function instantiations.
+//
+// Lookups are lock-free once a function has been instantiated: readers follow
+// an atomic snapshot pointer to an immutable map, so concurrent worker
+// threads (e.g. tf.data parallel map workers) do not contend on a mutex for
+// the common hit path.  Instantiation of missing functions is serialized per
+// key shard, so distinct functions can be instantiated concurrently while
+// duplicate requests for the same function are deduplicated.
 class FunctionHandleCache {
  public:
   explicit FunctionHandleCache(FunctionLibraryRuntime* lib);
@@ -43,11 +53,31 @@ class FunctionHandleCache {
   Status Clear();
 
  private:
-  mutex mu_;
+  using HandleMap =
+      std::unordered_map<string, FunctionLibraryRuntime::Handle>;
+
+  // Number of instantiation locks. Must be a power of two.
+  static constexpr int kNumShards = 8;
+
+  struct Shard {
+    mutex mu;
+  };
+
+  // Returns the current snapshot of the handle map.
+  std::shared_ptr<const HandleMap> Snapshot() const {
+    return std::atomic_load(&snapshot_);
+  }
+
   FunctionLibraryRuntime* lib_ = nullptr;  // not owned
   const string state_handle_;
-  std::unordered_map<string, FunctionLibraryRuntime::Handle> handles_
-      TF_GUARDED_BY(mu_);
+
+  // Serializes snapshot publication and Clear().
+  mutex mu_;
+  // Immutable map of instantiated handles; replaced wholesale (copy, insert,
+  // atomic store) when a new function is instantiated.
+  std::shared_ptr<const HandleMap> snapshot_;
+  // Instantiation locks, sharded by the hash of the canonicalized key.
+  std::array<Shard, kNumShards> shards_;
 };
 
 }  // namespace tensorflow
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/types.h"
@@ -121,12 +122,19 @@ LocalRendezvous::~LocalRendezvous() {
 
 namespace {
 uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
+
+// Keys produced by Rendezvous::ParseKey carry a memoized hash; only keys
+// assembled by hand (hash zero) pay for hashing here.
+uint64 KeyHash(const Rendezvous::ParsedKey& key) {
+  const uint64 hash = key.FullKeyHash();
+  return TF_PREDICT_TRUE(hash != 0) ? hash : KeyHash(key.FullKey());
+}
 }  // namespace
 
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
                              const Rendezvous::Args& send_args,
                              const Tensor& val, const bool is_dead) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Send " << this << " " << key_hash << " " << key.FullKey();
 
   if (is_dead) {
@@ -199,7 +207,7 @@ Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
 void LocalRendezvous::RecvAsync(const Rendezvous::ParsedKey& key,
                                 const Rendezvous::Args& recv_args,
                                 Rendezvous::DoneCallback done) {
-  uint64 key_hash = KeyHash(key.FullKey());
+  uint64 key_hash = KeyHash(key);
   DVLOG(2) << "Recv " << this << " " << key_hash << " " << key.FullKey();
 
   auto s = status();
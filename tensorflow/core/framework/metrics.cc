@@ -65,6 +65,18 @@ auto* graph_unused_outputs = tsl::monitoring::Counter<1>::New(
     "/tensorflow/core/graph_unused_outputs",
     "The number of unused outputs for ops of a given type.", "name");
 
+auto* worker_rpc_latency_usecs_histogram = tsl::monitoring::Sampler<2>::New(
+    {"/tensorflow/core/distributed_runtime/worker_rpc_latency_usecs",
+     "Latency (in microseconds) of worker RPCs, by method and remote target.",
+     "method", "target"},
+    // Power of 2 with bucket count 27 (> 67 seconds).
+    {tsl::monitoring::Buckets::Exponential(1, 2, 27)});
+
+auto* worker_rpc_bytes_received_counter = tsl::monitoring::Counter<2>::New(
+    "/tensorflow/core/distributed_runtime/worker_rpc_bytes_received",
+    "Payload bytes received by worker RPCs, by method and remote target.",
+    "method", "target");
+
 auto* tf_data_autotune_counter = tsl::monitoring::Counter<1>::New(
     "/tensorflow/data/autotune", "tf.data autotuning", "name");
 
@@ -175,6 +187,25 @@ auto* tf_data_model_gauge =
     tsl::monitoring::Gauge<std::function<std::string()>, 1>::New(
         "/tensorflow/data/model", "tf.data autotuning model proto.", "id");
 
+auto* tf_data_node_buffered_elements_gauge =
+    tsl::monitoring::Gauge<int64_t, 2>::New(
+        "/tensorflow/data/node/buffered_elements",
+        "Number of elements currently buffered by a tf.data iterator node.",
+        "id", "name");
+
+auto* tf_data_node_buffered_bytes_gauge =
+    tsl::monitoring::Gauge<int64_t, 2>::New(
+        "/tensorflow/data/node/buffered_bytes",
+        "Number of bytes currently buffered by a tf.data iterator node.", "id",
+        "name");
+
+auto* tf_data_node_processing_time_gauge =
+    tsl::monitoring::Gauge<int64_t, 2>::New(
+        "/tensorflow/data/node/processing_time",
+        "Cumulative self processing time (in nanoseconds) of a tf.data "
+        "iterator node.",
+        "id", "name");
+
 auto* tf_data_auto_shard = tsl::monitoring::Gauge<int64, 2>::New(
     "/tensorflow/data/autoshard", "tf.data autoshard statistics.", "id",
     "name");
@@ -304,6 +335,21 @@ tsl::monitoring::GaugeCell<std::function<std::string()>>* GetTFDataModelGauge(
   return tf_data_model_gauge->GetCell(id);
 }
 
+tsl::monitoring::GaugeCell<int64_t>* GetTFDataNodeBufferedElementsGauge(
+    const string& id, const string& name) {
+  return tf_data_node_buffered_elements_gauge->GetCell(id, name);
+}
+
+tsl::monitoring::GaugeCell<int64_t>* GetTFDataNodeBufferedBytesGauge(
+    const string& id, const string& name) {
+  return tf_data_node_buffered_bytes_gauge->GetCell(id, name);
+}
+
+tsl::monitoring::GaugeCell<int64_t>* GetTFDataNodeProcessingTimeGauge(
+    const string& id, const string& name) {
+  return tf_data_node_processing_time_gauge->GetCell(id, name);
+}
+
 void RecordTFDataBytesFetched(int64_t num_bytes) {
   tf_data_bytes_fetched_counter->GetCell()->IncrementBy(num_bytes);
 }
@@ -521,6 +567,16 @@ void RecordUnusedOutput(const string& op_name) {
   graph_unused_outputs->GetCell(op_name)->IncrementBy(1);
 }
 
+tsl::monitoring::SamplerCell* GetWorkerRpcLatencyHistogram(
+    const string& method, const string& target) {
+  return worker_rpc_latency_usecs_histogram->GetCell(method, target);
+}
+
+tsl::monitoring::CounterCell* GetWorkerRpcBytesReceivedCounter(
+    const string& method, const string& target) {
+  return worker_rpc_bytes_received_counter->GetCell(method, target);
+}
+
 void IncrementTestCounter(const string& name, const string& label) {
   test_counters->GetCell(name, label)->IncrementBy(1);
 }
@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset_options.pb.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/types.h"
@@ -65,6 +66,30 @@ monitoring::CounterCell* GetTFDataElementsCounter(const string& name);
 monitoring::GaugeCell<std::function<std::string()>>* GetTFDataModelGauge(
     const string& id);
 
+// Returns a gauge that can be used to record the number of elements currently
+// buffered by an iterator node of the performance model.
+//
+// The `id` argument represents the (unique) model ID and the `name` argument
+// identifies the node within the model.
+monitoring::GaugeCell<int64_t>* GetTFDataNodeBufferedElementsGauge(
+    const string& id, const string& name);
+
+// Returns a gauge that can be used to record the number of bytes currently
+// buffered by an iterator node of the performance model.
+//
+// The `id` argument represents the (unique) model ID and the `name` argument
+// identifies the node within the model.
+monitoring::GaugeCell<int64_t>* GetTFDataNodeBufferedBytesGauge(
+    const string& id, const string& name);
+
+// Returns a gauge that can be used to record the cumulative self processing
+// time (in nanoseconds) of an iterator node of the performance model.
+//
+// The `id` argument represents the (unique) model ID and the `name` argument
+// identifies the node within the model.
+monitoring::GaugeCell<int64_t>* GetTFDataNodeProcessingTimeGauge(
+    const string& id, const string& name);
+
 // Records the number of bytes fetched from tf.data.Dataset iterator.
 void RecordTFDataBytesFetched(int64_t num_bytes);
 
@@ -169,6 +194,22 @@ void RecordGraphOutputTensors(const size_t size);
 // Records the number of cores requested by graphs with XLA SPMD enabled.
 void RecordTPUXlaSpmdCoresPerReplica(int64_t cores_per_replica);
 
+// Returns a histogram that can be used to record the latency (in microseconds)
+// of worker RPCs issued to a remote target.
+//
+// The `method` argument identifies the RPC method (e.g. "RecvTensor" or
+// "RunGraph") and the `target` argument identifies the remote worker.
+monitoring::SamplerCell* GetWorkerRpcLatencyHistogram(const string& method,
+                                                      const string& target);
+
+// Returns a counter that can be used to record the number of payload bytes
+// received by worker RPCs issued to a remote target.
+//
+// The `method` argument identifies the RPC method (e.g. "RecvTensor" or
+// "RunGraph") and the `target` argument identifies the remote worker.
+monitoring::CounterCell* GetWorkerRpcBytesReceivedCounter(
+    const string& method, const string& target);
+
 void UpdateGraphExecTime(const uint64 running_time_usecs);
 void UpdateGraphPendingQueueLength(uint64 len);
 
@@ -28,6 +28,8 @@ limitations under the License.
 #include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/lib/traceme_encode.h"
 
 namespace tensorflow {
 namespace data {
@@ -2114,9 +2116,9 @@ Status Node::FromProto(ModelProto::Node node_proto,
 
 Model::Model()
     : optimization_period_ms_(kOptimizationPeriodMinMs),
+      model_id_(strings::StrCat(reinterpret_cast<uint64>(this))),
       safe_to_collect_metrics_(std::make_shared<GuardedBool>(true)) {
-  model_gauge_cell_ = metrics::GetTFDataModelGauge(
-      strings::StrCat(reinterpret_cast<uint64>(this)));
+  model_gauge_cell_ = metrics::GetTFDataModelGauge(model_id_);
   // Capture `safe_to_collect_metrics_` by value to avoid use-after-free issues
   // when the callback is invoked after the model has been destroyed.
   model_gauge_cell_->Set(
@@ -2165,12 +2167,38 @@ void Model::FlushMetrics() {
     auto node = queue.front();
     queue.pop_front();
     node->FlushMetrics();
+    PublishNodeMetrics(node.get());
     for (auto input : node->inputs()) {
       queue.push_back(input);
     }
   }
 }
 
+void Model::PublishNodeMetrics(Node* node) {
+  const string node_name = node->long_name();
+  const int64_t processing_time = node->processing_time();
+  metrics::GetTFDataNodeProcessingTimeGauge(model_id_, node_name)
+      ->Set(processing_time);
+  // Only asynchronous nodes (e.g. prefetch or parallel map) maintain buffers;
+  // publishing buffer gauges for synchronous nodes would only add noise.
+  if (!node->IsAsync()) return;
+  const int64_t buffered_elements = node->buffered_elements();
+  const int64_t buffered_bytes = node->buffered_bytes();
+  metrics::GetTFDataNodeBufferedElementsGauge(model_id_, node_name)
+      ->Set(buffered_elements);
+  metrics::GetTFDataNodeBufferedBytesGauge(model_id_, node_name)
+      ->Set(buffered_bytes);
+  profiler::TraceMe::InstantActivity(
+      [&] {
+        return profiler::TraceMeEncode(
+            "BufferOccupancy", {{"node", node_name},
+                                {"buffered_elements", buffered_elements},
+                                {"buffered_bytes", buffered_bytes},
+                                {"processing_time_ns", processing_time}});
+      },
+      profiler::kInfo);
+}
+
 void Model::Optimize(AutotuneAlgorithm algorithm, int64_t cpu_budget,
                      int64_t ram_budget, double model_input_time,
                      CancellationManager* cancellation_manager) {
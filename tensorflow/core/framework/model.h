@@ -883,6 +883,13 @@ class Model {
   // Flushes metrics recorded by the model.
   void FlushMetrics() TF_LOCKS_EXCLUDED(mu_);
 
+  // Publishes the given node's live state (buffer occupancy and cumulative
+  // processing time) to per-node monitoring gauges and, when a trace is
+  // active, as an instant profiler event. Called periodically from the
+  // optimization loop so buffer occupancy forms a time series without a
+  // tracing session attached.
+  void PublishNodeMetrics(Node* node);
+
   // This optimization algorithm starts by setting all tunable parallelism
   // parameters to the minimum value. It then improves current parameters by
   // making a step in the direction opposite to the gradient of `OutputTime` and
@@ -970,6 +977,8 @@ class Model {
   // running optimizations.
   int64_t optimization_period_ms_ TF_GUARDED_BY(mu_);
 
+  // Identifies this model in per-model monitoring gauges.
+  const std::string model_id_;
   // Gauge cell that can be used to collect the state of the model.
   monitoring::GaugeCell<std::function<std::string()>>* model_gauge_cell_ =
       nullptr;
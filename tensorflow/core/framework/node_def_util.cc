@@ -163,6 +163,15 @@ const AttrValue* AttrSlice::Find(StringPiece attr_name) const {
   // changes so that it supports efficient lookups using StringPiece instead of
   // const string&, then this code could be changed to use attrs()->find()
   // again.
+  //
+  // For attribute-heavy nodes, such as instantiated functions carrying their
+  // instantiation attributes, the scan degrades to a long chain of string
+  // comparisons per lookup; beyond a small size the hashed lookup wins even
+  // with the temporary key allocation.
+  static constexpr size_t kMaxAttrsForLinearScan = 8;
+  if (attrs()->size() > kMaxAttrsForLinearScan) {
+    return FindByString(string(attr_name));
+  }
 
   for (const auto& attr : *attrs()) {
     if (attr.first == attr_name) {
@@ -342,7 +351,9 @@ DEFINE_GET_ATTR(NameAttrList, func, "func", emplace_back, v, ;);
 #undef DEFINE_GET_ATTR
 
 bool HasNodeAttr(const NodeDef& node_def, StringPiece attr_name) {
-  return node_def.attr().find(string(attr_name)) != node_def.attr().end();
+  // Use AttrSlice::Find to avoid allocating a temporary string for the
+  // google::protobuf::Map lookup; see the comment on that method.
+  return AttrSlice(node_def).Find(attr_name) != nullptr;
 }
 
 static const string& kEmptyString = *new string();
@@ -804,6 +804,20 @@ Status OpKernelContext::allocate_output(int index, const TensorShape& shape,
           attr.scope_id,
           " more than once.  Try turning off the ScopedAllocator optimizer.");
     }
+  } else if (params_->preferred_forward_from_array != nullptr &&
+             params_->preferred_forward_from_array[index] >= 0) {
+    // A grappler memory plan identified an input whose buffer can hold this
+    // output.  The hint is best-effort: forward_input re-checks the type,
+    // size, memory type and exclusive ownership of the buffer, so we fall
+    // through to a fresh allocation when the buffer cannot be reused.
+    std::unique_ptr<Tensor> forwarded =
+        forward_input(params_->preferred_forward_from_array[index], index,
+                      type, shape, output_memory_type(index), attr);
+    if (forwarded != nullptr) {
+      outputs_[index] = TensorValue(forwarded.release());
+      *output = outputs_[index].tensor;
+      return OkStatus();
+    }
   }
   profiler::ScopedMemoryDebugAnnotation op_annotation(
       op_kernel().name_view().data(), step_id(), "output", type,
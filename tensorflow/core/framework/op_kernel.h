@@ -154,6 +154,20 @@ class OpKernel {
   // Returns a pointer to the tensor stored inside constant ops.
   virtual const Tensor* const_tensor() const { return nullptr; }
 
+  // Called by the runtime when this kernel's node has executed with the same
+  // input shapes for many consecutive runs. A kernel that benefits from
+  // knowing its shapes statically (e.g. fixed-size contractions or unrolled
+  // copies) may build an implementation specialized for `input_shapes`, cache
+  // it internally, and return true; Compute() must then use it only when the
+  // actual inputs match and fall back to the generic code path otherwise.
+  // Called at most once per node; the default declines to specialize.
+  //
+  // Like Compute(), this may run concurrently with Compute() calls from other
+  // executions of the same graph, so implementations must be thread-safe.
+  virtual bool SpecializeForShape(gtl::ArraySlice<TensorShape> input_shapes) {
+    return false;
+  }
+
   // Accessors.
   const NodeDef& def() const { return props_->node_def; }
   const std::string& name() const { return props_->node_def.name(); }
@@ -670,6 +684,14 @@ class OpKernelContext {
     // Values in [0,...) represent reservations for the indexed output.
     const int* forward_from_array = nullptr;
 
+    // Best-effort buffer reuse hints computed by a grappler memory plan.
+    // Values in [0,...) name an input whose buffer allocate_output should
+    // try to reuse for the indexed output, enabling in-place chains across
+    // ops that do not know about each other.  Unlike forward_from_array this
+    // is advisory: when the input buffer cannot be reused (e.g. it is shared
+    // or its type or size does not match) the output is allocated normally.
+    const int* preferred_forward_from_array = nullptr;
+
     // For tracking actively running deferred ops.
     std::function<void()> inc_num_deferred_ops_function;
     std::function<void()> dec_num_deferred_ops_function;
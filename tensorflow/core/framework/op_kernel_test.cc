@@ -479,6 +479,67 @@ TEST_F(OpKernelTest, ScopedAllocationTest) {
   EXPECT_EQ(sa_device->num_allocations(true), 1);
 }
 
+// Test that allocate_output reuses the hinted input buffer when a
+// preferred_forward_from hint is present and the buffer is exclusively owned.
+TEST_F(OpKernelTest, PreferredForwardInputHint) {
+  Env* env = Env::Default();
+  OpKernelContext::Params params;
+  DummyDevice device(env);
+  params.device = &device;
+  Status status;
+  std::unique_ptr<OpKernel> op(
+      CreateOpKernel(DEVICE_CPU, params.device, cpu_allocator(),
+                     CreateNodeDef("Test4", {DT_FLOAT}), TF_GRAPH_DEF_VERSION,
+                     &status));
+  TF_ASSERT_OK(status);
+  params.op_kernel = op.get();
+  AllocatorAttributes alloc_attrs;
+  std::vector<AllocatorAttributes> output_alloc_attrs({alloc_attrs});
+  params.output_attr_array = output_alloc_attrs.data();
+  std::vector<int> preferred_forward_from({0});
+  params.preferred_forward_from_array = preferred_forward_from.data();
+  Tensor a(DT_FLOAT, TensorShape({4}));
+  gtl::InlinedVector<TensorValue, 4> inputs{TensorValue(&a)};
+  params.inputs = inputs;
+  auto ctx = absl::make_unique<OpKernelContext>(&params);
+
+  Tensor* out = nullptr;
+  TF_ASSERT_OK(ctx->allocate_output(0, TensorShape({4}), &out));
+  EXPECT_EQ(out->tensor_data().data(), a.tensor_data().data());
+}
+
+// Test that a preferred_forward_from hint is ignored when the input buffer is
+// shared, in which case the output must be allocated normally.
+TEST_F(OpKernelTest, PreferredForwardInputHintSharedBuffer) {
+  Env* env = Env::Default();
+  OpKernelContext::Params params;
+  DummyDevice device(env);
+  params.device = &device;
+  Status status;
+  std::unique_ptr<OpKernel> op(
+      CreateOpKernel(DEVICE_CPU, params.device, cpu_allocator(),
+                     CreateNodeDef("Test4", {DT_FLOAT}), TF_GRAPH_DEF_VERSION,
+                     &status));
+  TF_ASSERT_OK(status);
+  params.op_kernel = op.get();
+  AllocatorAttributes alloc_attrs;
+  std::vector<AllocatorAttributes> output_alloc_attrs({alloc_attrs});
+  params.output_attr_array = output_alloc_attrs.data();
+  std::vector<int> preferred_forward_from({0});
+  params.preferred_forward_from_array = preferred_forward_from.data();
+  Tensor a(DT_FLOAT, TensorShape({4}));
+  // Another tensor still references the input buffer, as when a pending
+  // consumer has not yet run.
+  Tensor b = a;
+  gtl::InlinedVector<TensorValue, 4> inputs{TensorValue(&a)};
+  params.inputs = inputs;
+  auto ctx = absl::make_unique<OpKernelContext>(&params);
+
+  Tensor* out = nullptr;
+  TF_ASSERT_OK(ctx->allocate_output(0, TensorShape({4}), &out));
+  EXPECT_NE(out->tensor_data().data(), a.tensor_data().data());
+}
+
 REGISTER_OP("BuildCPU");
 REGISTER_KERNEL_BUILDER(Name("BuildCPU").Device(DEVICE_CPU), DummyKernel);
 
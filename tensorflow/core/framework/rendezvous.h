@@ -70,11 +70,17 @@ class RendezvousInterface {
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
 
+    // Hash of FullKey(), memoized by ParseKey() so that per-step Send/Recv
+    // calls reusing a parsed key (e.g. the cached keys in SendOp/RecvOp)
+    // don't re-hash the key string. Zero for keys that were never parsed.
+    uint64 FullKeyHash() const { return hash_; }
+
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    uint64 hash_ = 0;
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
@@ -16,9 +16,14 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/framework/resource_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/array_slice.h"
 
 // Forward declarations to avoid introducing a dependency on headers in
 // "tensorflow/core/graph/...".
@@ -79,6 +84,8 @@ class Var : public ResourceBase {
     // move frees the buffer of the tensor after unused goes out of scope.
     Tensor unused = std::move(tensor_);
     is_initialized = false;
+    ClearSnapshot();
+    if (dirty_row_tracking()) RecordAllRowsDirty();
   }
 
   Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override;
@@ -103,9 +110,75 @@ class Var : public ResourceBase {
   // so desired.
   std::atomic<bool> copy_on_read_mode{false};
 
+  // Lock-free read snapshots: when a process opts in (see ReadVariableOp),
+  // dense writes publish the freshly written tensor here and dense reads
+  // return it after an atomic load, without touching mu(). The snapshot
+  // aliases the variable's buffer, so the regular copy-on-write machinery
+  // makes in-place updates copy the buffer first and the snapshot stays
+  // immutable; readers that still hold an old snapshot keep its buffer alive
+  // until they are done, which is what retires replaced buffers safely.
+  // Never set while in copy-on-read mode.
+  std::shared_ptr<const Tensor> snapshot() const {
+    return std::atomic_load(&snapshot_);
+  }
+  void InstallSnapshot(const Tensor& value) {
+    std::atomic_store(&snapshot_,
+                      std::make_shared<const Tensor>(value));
+  }
+  void ClearSnapshot() {
+    std::atomic_store(&snapshot_, std::shared_ptr<const Tensor>());
+  }
+
+  // Row-granularity dirty tracking for delta checkpointing of sparsely
+  // updated variables (e.g. embedding tables). Off until a saver calls
+  // EnableDirtyRowTracking(); from then on scatter updates record the
+  // first-dimension rows they touch and dense writes mark every row dirty.
+  // The tracker starts out (and resets to) fully dirty, so the first delta
+  // after enabling always covers the whole tensor. Update kernels that
+  // mutate the variable without recording are not supported while tracking
+  // is enabled; conservative callers can always RecordAllRowsDirty().
+  //
+  // The tracker has its own lock so that "hogwild" scatter updates running
+  // under a shared variable lock can record rows concurrently.
+  void EnableDirtyRowTracking() {
+    mutex_lock l(dirty_rows_mu_);
+    all_rows_dirty_ = true;
+    dirty_rows_.clear();
+    dirty_row_tracking_.store(true, std::memory_order_release);
+  }
+  bool dirty_row_tracking() const {
+    return dirty_row_tracking_.load(std::memory_order_acquire);
+  }
+  void RecordDirtyRows(gtl::ArraySlice<int64_t> rows) {
+    mutex_lock l(dirty_rows_mu_);
+    if (all_rows_dirty_) return;
+    dirty_rows_.insert(rows.begin(), rows.end());
+  }
+  void RecordAllRowsDirty() {
+    mutex_lock l(dirty_rows_mu_);
+    all_rows_dirty_ = true;
+    dirty_rows_.clear();
+  }
+  // Moves the dirty state out and resets the tracker to clean. If
+  // "*all_rows_dirty" is returned true, every row must be considered dirty
+  // and "*rows" is left empty.
+  void ConsumeDirtyRows(std::vector<int64_t>* rows, bool* all_rows_dirty) {
+    mutex_lock l(dirty_rows_mu_);
+    *all_rows_dirty = all_rows_dirty_;
+    rows->assign(dirty_rows_.begin(), dirty_rows_.end());
+    all_rows_dirty_ = false;
+    dirty_rows_.clear();
+  }
+
  private:
   mutex mu_;
   Tensor tensor_;
+  std::shared_ptr<const Tensor> snapshot_;
+
+  std::atomic<bool> dirty_row_tracking_{false};
+  mutex dirty_rows_mu_;
+  bool all_rows_dirty_ TF_GUARDED_BY(dirty_rows_mu_) = false;
+  absl::flat_hash_set<int64_t> dirty_rows_ TF_GUARDED_BY(dirty_rows_mu_);
 
   ~Var() override {}
   TF_DISALLOW_COPY_AND_ASSIGN(Var);
@@ -44,6 +44,13 @@ static constexpr int32_t kMaxConcurrentHandlers = 128;
 typedef typename internal::RunHandlerEnvironment::Task Task;
 typedef Eigen::RunQueue<Task, 1024> Queue;
 
+// Returns true if a request with deadline `a` (in microseconds since the unix
+// epoch, zero meaning no deadline) is more urgent than one with deadline `b`.
+// Requests without a deadline sort after every request that has one.
+bool DeadlineBefore(int64_t a, int64_t b) {
+  return a != 0 && (b == 0 || a < b);
+}
+
 }  // namespace
 
 namespace internal {
@@ -749,6 +756,8 @@ class RunHandler::Impl {
 
   int64_t priority() { return options_.priority(); }
 
+  int64_t deadline_micros() { return options_.deadline_micros(); }
+
  private:
   class ThreadPoolInterfaceWrapper : public thread::ThreadPoolInterface {
    public:
@@ -875,11 +884,19 @@ class RunHandlerPool::Impl {
       num_active_requests = sorted_active_handlers_.size() + 1;
       thread_work_sources->resize(num_active_requests);
       int priority = options.priority();
+      int64_t deadline_micros = options.deadline_micros();
       auto it = sorted_active_handlers_.cbegin();
       bool new_handler_inserted = false;
       for (int i = 0; i < num_active_requests; ++i) {
-        if (!new_handler_inserted && (it == sorted_active_handlers_.cend() ||
-                                      priority > (*it)->priority())) {
+        // Priority is the primary ordering; within a priority class a request
+        // with an earlier deadline is scheduled ahead of requests with later
+        // or no deadlines, so e.g. interactive steps jump the queue of batch
+        // steps admitted at the same priority.
+        if (!new_handler_inserted &&
+            (it == sorted_active_handlers_.cend() ||
+             priority > (*it)->priority() ||
+             (priority == (*it)->priority() &&
+              DeadlineBefore(deadline_micros, (*it)->deadline_micros())))) {
           sorted_active_handlers_.insert(it, handler_impl);
           new_handler_inserted = true;
           // Point to the newly added handler.
@@ -935,6 +952,16 @@ class RunHandlerPool::Impl {
     return ret;
   }
 
+  std::vector<int64_t> GetActiveHandlerStepIdsForTesting()
+      TF_LOCKS_EXCLUDED(mu_) {
+    mutex_lock l(mu_);
+    std::vector<int64_t> ret;
+    for (const auto& handler_impl : sorted_active_handlers_) {
+      ret.push_back(handler_impl->step_id());
+    }
+    return ret;
+  }
+
  private:
   void RecomputePoolStats(
       int num_active_requests, uint64 version,
@@ -1104,6 +1131,10 @@ std::vector<int64_t> RunHandlerPool::GetActiveHandlerPrioritiesForTesting()
   return impl_->GetActiveHandlerPrioritiesForTesting();
 }
 
+std::vector<int64_t> RunHandlerPool::GetActiveHandlerStepIdsForTesting() const {
+  return impl_->GetActiveHandlerStepIdsForTesting();
+}
+
 RunHandler::RunHandler(Impl* impl) : impl_(impl) {}
 
 void RunHandler::ScheduleInterOpClosure(std::function<void()> fn) {
@@ -113,6 +113,43 @@ TEST(RunHandlerUtilTest, PrioritySchedulingTest) {
   EXPECT_EQ(sorted_active_list[3], 1);
 }
 
+TEST(RunHandlerUtilTest, DeadlineSchedulingTest) {
+  int num_threads = 2;
+  std::unique_ptr<RunHandlerPool> pool(
+      new RunHandlerPool(num_threads, num_threads));
+
+  RunOptions::Experimental::RunHandlerPoolOptions options =
+      RunOptions::Experimental::RunHandlerPoolOptions();
+  // Three requests with the same priority: one batch step without a deadline
+  // and two interactive steps with deadlines.
+  options.set_priority(1);
+  auto handler1 = pool->Get(/*step_id=*/1, /*timeout_in_ms=*/0, options);
+  options.set_deadline_micros(2000);
+  auto handler2 = pool->Get(/*step_id=*/2, /*timeout_in_ms=*/0, options);
+  options.set_deadline_micros(1000);
+  auto handler3 = pool->Get(/*step_id=*/3, /*timeout_in_ms=*/0, options);
+
+  // Within a priority class, earlier deadlines are scheduled first and
+  // requests without a deadline go last.
+  std::vector<int64_t> sorted_step_ids =
+      pool->GetActiveHandlerStepIdsForTesting();
+  EXPECT_EQ(sorted_step_ids.size(), 3);
+  EXPECT_EQ(sorted_step_ids[0], 3);
+  EXPECT_EQ(sorted_step_ids[1], 2);
+  EXPECT_EQ(sorted_step_ids[2], 1);
+
+  // Priority still dominates the deadline hint.
+  options.set_priority(2);
+  options.set_deadline_micros(5000);
+  auto handler4 = pool->Get(/*step_id=*/4, /*timeout_in_ms=*/0, options);
+  sorted_step_ids = pool->GetActiveHandlerStepIdsForTesting();
+  EXPECT_EQ(sorted_step_ids.size(), 4);
+  EXPECT_EQ(sorted_step_ids[0], 4);
+  EXPECT_EQ(sorted_step_ids[1], 3);
+  EXPECT_EQ(sorted_step_ids[2], 2);
+  EXPECT_EQ(sorted_step_ids[3], 1);
+}
+
 TEST(RunHandlerThreadPool, EnqueueTask) {
   Eigen::MaxSizeVector<mutex> waiters_mu(2);
   waiters_mu.resize(2);
@@ -0,0 +1,131 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_FRAMEWORK_SCRATCH_BUFFER_H_
+#define TENSORFLOW_CORE_FRAMEWORK_SCRATCH_BUFFER_H_
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// A scratch workspace cached in a device's resource manager, so that kernels
+// which need a temporary buffer on every invocation (im2col patches,
+// reduction workspaces, ...) reuse one allocation instead of taking a round
+// trip through the allocator on each step.  The buffer only ever grows, and
+// it uses malloc and free to avoid the time cost of initializing the memory.
+//
+// This generalizes the fixed-size Im2ColBufferResource in kernels/conv_ops.h
+// to arbitrary element types and monotonically growing capacities.
+class ScratchBufferResource : public ResourceBase {
+ public:
+  ScratchBufferResource() = default;
+  ~ScratchBufferResource() override { port::Free(data_); }
+
+  string DebugString() const override { return "ScratchBufferResource"; }
+
+ private:
+  template <typename T>
+  friend class ScratchBufferHandle;
+
+  // This mutex ensures that only a single operation at a time is able to use
+  // the buffer memory held by this resource.
+  mutex mu_;
+  void* data_ TF_GUARDED_BY(mu_) = nullptr;
+  size_t capacity_bytes_ TF_GUARDED_BY(mu_) = 0;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ScratchBufferResource);
+};
+
+// Exclusive typed view of a ScratchBufferResource.  While the handle is
+// alive no other invocation can use the same buffer, so kernels should let
+// it go out of scope as soon as the scratch data is dead.  The memory is
+// uninitialized and its contents do not persist across acquisitions.
+template <typename T>
+class ScratchBufferHandle {
+ public:
+  ScratchBufferHandle() = default;
+  ~ScratchBufferHandle() TF_NO_THREAD_SAFETY_ANALYSIS {
+    if (resource_ != nullptr) {
+      resource_->mu_.unlock();
+      resource_->Unref();
+    }
+  }
+
+  // Valid for the lifetime of the handle.
+  T* data() const TF_NO_THREAD_SAFETY_ANALYSIS {
+    return static_cast<T*>(resource_->data_);
+  }
+  int64_t num_elements() const { return num_elements_; }
+
+ private:
+  template <typename U>
+  friend Status GetScratchBuffer(OpKernelContext* ctx, StringPiece name,
+                                 int64_t num_elements,
+                                 ScratchBufferHandle<U>* handle);
+
+  // Takes over the caller's reference on `resource` and holds its mutex
+  // until destruction, growing the buffer to `num_elements` if needed.
+  void Acquire(ScratchBufferResource* resource,
+               int64_t num_elements) TF_NO_THREAD_SAFETY_ANALYSIS {
+    resource_ = resource;
+    num_elements_ = num_elements;
+    resource_->mu_.lock();
+    const size_t bytes = num_elements * sizeof(T);
+    if (bytes > resource_->capacity_bytes_) {
+      // The previous contents are dead, so free-then-malloc instead of
+      // realloc to skip the copy.
+      port::Free(resource_->data_);
+      resource_->data_ = port::Malloc(bytes);
+      resource_->capacity_bytes_ = bytes;
+    }
+  }
+
+  ScratchBufferResource* resource_ = nullptr;
+  int64_t num_elements_ = 0;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ScratchBufferHandle);
+};
+
+// Points `handle` at a scratch buffer with room for at least `num_elements`
+// elements of type T, cached in the device's resource manager under the
+// calling kernel's node name plus `name` (so one kernel may use several
+// distinct scratch buffers).  Each (kernel, device) pair reuses its own
+// buffer across steps.  Concurrent invocations of the same kernel serialize
+// on the buffer; kernels for which that matters should use allocate_temp
+// instead.
+template <typename T>
+Status GetScratchBuffer(OpKernelContext* ctx, StringPiece name,
+                        int64_t num_elements, ScratchBufferHandle<T>* handle) {
+  ScratchBufferResource* resource;
+  TF_RETURN_IF_ERROR(
+      ctx->resource_manager()->LookupOrCreate<ScratchBufferResource>(
+          "scratch_buffers",
+          strings::StrCat(ctx->op_kernel().name(), "/", name), &resource,
+          [](ScratchBufferResource** created) {
+            *created = new ScratchBufferResource();
+            return OkStatus();
+          }));
+  handle->Acquire(resource, num_elements);
+  return OkStatus();
+}
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_FRAMEWORK_SCRATCH_BUFFER_H_
@@ -160,6 +160,89 @@ bool MemoryLoggingEnabled() {
   return memory_logging_enabled;
 }
 
+// Small-tensor fast path.
+//
+// Scalar and tiny rank-1 host tensors (Shape/Size outputs, stack indices,
+// loop counters) dominate allocator traffic in control-flow-heavy graphs.
+// SmallBuffer packs the TensorBuffer object and up to kPayloadBytes of
+// payload into a single cache-line-aligned block, and recycles dead blocks
+// through a bounded per-thread free list, so those tensors normally touch
+// neither malloc nor the device allocator at all. The tensors themselves
+// keep ordinary ref-counted buffer semantics (SharesBufferWith, aliasing
+// checks, etc. are unaffected).
+class SmallBuffer : public TensorBuffer {
+ public:
+  static constexpr size_t kPayloadBytes = 64;
+
+  explicit SmallBuffer(size_t size) : TensorBuffer(payload_), size_(size) {}
+  ~SmallBuffer() override {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  bool OwnsMemory() const override { return true; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size_));
+    proto->set_allocator_name("small_tensor_buffer");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
+ private:
+  size_t size_;
+  // Aligned as strictly as allocator-backed tensor data so Eigen kernels can
+  // make the same vectorization assumptions.
+  alignas(Allocator::kAllocatorAlignment) char payload_[kPayloadBytes];
+};
+
+// A bounded per-thread cache of dead SmallBuffer blocks. Blocks may be freed
+// on a different thread than they were allocated on; they simply migrate to
+// that thread's cache.
+struct SmallBufferFreeList {
+  static constexpr int kMaxEntries = 256;
+  void* entries[kMaxEntries];
+  int size = 0;
+
+  ~SmallBufferFreeList() {
+    for (int i = 0; i < size; ++i) port::AlignedFree(entries[i]);
+  }
+};
+
+thread_local SmallBufferFreeList small_buffer_free_list;
+
+void* SmallBuffer::operator new(size_t size) {
+  DCHECK_EQ(size, sizeof(SmallBuffer));
+  SmallBufferFreeList& cache = small_buffer_free_list;
+  if (cache.size > 0) {
+    return cache.entries[--cache.size];
+  }
+  return port::AlignedMalloc(sizeof(SmallBuffer),
+                             Allocator::kAllocatorAlignment);
+}
+
+void SmallBuffer::operator delete(void* ptr) {
+  SmallBufferFreeList& cache = small_buffer_free_list;
+  if (cache.size < SmallBufferFreeList::kMaxEntries) {
+    cache.entries[cache.size++] = ptr;
+  } else {
+    port::AlignedFree(ptr);
+  }
+}
+
+// Returns true if a tensor of `num_bytes` of type `type` allocated from `a`
+// can be backed by a SmallBuffer. Restricted to plain pageable host memory
+// with no size tracking or stats so that memory attribution stays accurate
+// whenever anyone is watching.
+bool UseSmallBuffer(Allocator* a, DataType type, size_t num_bytes) {
+  return num_bytes > 0 && num_bytes <= SmallBuffer::kPayloadBytes &&
+         DataTypeCanUseMemcpy(type) && !a->AllocatesOpaqueHandle() &&
+         !a->TracksAllocationSizes() &&
+         a->GetMemoryType() == AllocatorMemoryType::kHostPageable &&
+         !CPUAllocatorStatsEnabled() && !MemoryLoggingEnabled();
+}
+
 // A set of helper functions depending on T.
 template <typename T>
 struct Helper {
@@ -820,7 +903,12 @@ Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape)
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    const size_t num_bytes = shape_.num_elements() * DataTypeSize(type);
+    if (UseSmallBuffer(a, type, num_bytes)) {
+      buf_ = new SmallBuffer(num_bytes);
+    } else {
+      CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    }
   }
   if (MemoryLoggingEnabled() && buf_ != nullptr && buf_->data() != nullptr) {
     LogMemory::RecordTensorAllocation("Unknown", LogMemory::UNKNOWN_STEP_ID,
@@ -834,7 +922,15 @@ Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape,
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements(), allocation_attr));
+    const size_t num_bytes = shape_.num_elements() * DataTypeSize(type);
+    if (!allocation_attr.allocation_will_be_logged &&
+        allocation_attr.freed_by_func == nullptr &&
+        UseSmallBuffer(a, type, num_bytes)) {
+      buf_ = new SmallBuffer(num_bytes);
+    } else {
+      CASES(type,
+            buf_ = new Buffer<T>(a, shape.num_elements(), allocation_attr));
+    }
   }
   if (MemoryLoggingEnabled() && !allocation_attr.allocation_will_be_logged &&
       buf_ != nullptr && buf_->data() != nullptr) {
@@ -853,6 +949,73 @@ Status Tensor::BuildTensor(DataType type, const TensorShape& shape,
   return OkStatus();
 }
 
+namespace {
+
+// Backing store for Tensor::FromCallerOwnedBuffer: a view of caller memory
+// that invokes the caller's deleter when the last reference goes away.
+class BorrowedTensorBuffer : public TensorBuffer {
+ public:
+  BorrowedTensorBuffer(void* data, size_t len,
+                       std::function<void(void*, size_t)> deleter)
+      : TensorBuffer(data), len_(len), deleter_(std::move(deleter)) {}
+
+  ~BorrowedTensorBuffer() override {
+    if (deleter_) {
+      deleter_(data(), len_);
+    }
+  }
+
+  size_t size() const override { return len_; }
+  TensorBuffer* root_buffer() override { return this; }
+  bool OwnsMemory() const override { return false; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(len_));
+    proto->set_allocator_name("caller_owned");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+
+ private:
+  const size_t len_;
+  const std::function<void(void*, size_t)> deleter_;
+};
+
+}  // namespace
+
+Status Tensor::FromCallerOwnedBuffer(
+    DataType type, const TensorShape& shape, void* data, size_t len,
+    std::function<void(void* data, size_t len)> deleter, Tensor* out_tensor) {
+  if (!DataTypeCanUseMemcpy(type)) {
+    return errors::InvalidArgument(
+        "Cannot wrap a caller-owned buffer as a tensor of type ",
+        DataTypeString(type));
+  }
+  if (data == nullptr && shape.num_elements() > 0) {
+    return errors::InvalidArgument(
+        "Cannot wrap a null buffer as a non-empty tensor");
+  }
+  if (reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment !=
+      0) {
+    return errors::InvalidArgument(
+        "Caller-owned buffer must be aligned to ",
+        Allocator::kAllocatorAlignment, " bytes; got pointer ",
+        reinterpret_cast<uintptr_t>(data));
+  }
+  const size_t expected_len =
+      shape.num_elements() * DataTypeSize(BaseType(type));
+  if (len != expected_len) {
+    return errors::InvalidArgument("Buffer of ", len,
+                                   " bytes does not match tensor of shape ",
+                                   shape.DebugString(), " which requires ",
+                                   expected_len, " bytes");
+  }
+  *out_tensor = Tensor(
+      type, shape,
+      core::RefCountPtr<TensorBuffer>(
+          new BorrowedTensorBuffer(data, len, std::move(deleter))));
+  return OkStatus();
+}
+
 // NOTE(mrry): The default allocator for a Tensor (when none is specified) is
 // the default CPU allocator for NUMA zone 0. Accessing that currently involves
 // acquiring a lock, which guards initialization of the per-NUMA zone
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_FRAMEWORK_TENSOR_H_
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -184,6 +185,25 @@ class Tensor {
   static Status BuildTensor(DataType type, const TensorShape& shape,
                             Tensor* out_tensor);
 
+  /// \brief Wraps a caller-owned buffer as a tensor's backing store without
+  /// copying, or returns an error and leaves `out_tensor` unmodified.
+  ///
+  /// This is the zero-copy feed path: the resulting tensor can be passed to
+  /// `Session::Run()` (or any other consumer) and the data is never
+  /// memcpy'd. In exchange, the caller must guarantee that:
+  ///
+  ///   * `data` is aligned to `Allocator::kAllocatorAlignment` (64 bytes),
+  ///     as CPU kernels assume Eigen-compatible alignment;
+  ///   * `len` is exactly `shape.num_elements() * DataTypeSize(type)`; and
+  ///   * the buffer stays valid until `deleter(data, len)` is invoked, which
+  ///     happens when the last tensor referencing it is destroyed.
+  ///
+  /// Only dtypes with a fixed element size (`DataTypeCanUseMemcpy`) are
+  /// supported; in particular DT_STRING, DT_VARIANT and DT_RESOURCE are not.
+  static Status FromCallerOwnedBuffer(
+      DataType type, const TensorShape& shape, void* data, size_t len,
+      std::function<void(void* data, size_t len)> deleter, Tensor* out_tensor);
+
  private:
   // A tag type for selecting the `Tensor` constructor overload that creates a
   // scalar tensor in host memory.
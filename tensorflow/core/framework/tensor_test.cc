@@ -1173,6 +1173,72 @@ TEST(Tensor, SharesBufferWith) {
   EXPECT_TRUE(a.SharesBufferWith(copy));
 }
 
+TEST(Tensor, SmallTensorFastPath) {
+  // Scalars and tiny rank-1 tensors are backed by recycled small buffers;
+  // they must still behave exactly like allocator-backed tensors.
+  for (int i = 0; i < 1000; ++i) {
+    Tensor scalar(DT_INT32, TensorShape({}));
+    scalar.scalar<int32>()() = i;
+    EXPECT_EQ(scalar.scalar<int32>()(), i);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(scalar.flat<int32>().data()) %
+                  Allocator::kAllocatorAlignment,
+              0);
+    Tensor copy(scalar);
+    EXPECT_TRUE(scalar.SharesBufferWith(copy));
+    EXPECT_EQ(copy.scalar<int32>()(), i);
+
+    Tensor vec(DT_INT64, TensorShape({2}));
+    vec.vec<int64_t>()(0) = i;
+    vec.vec<int64_t>()(1) = -i;
+    EXPECT_EQ(vec.vec<int64_t>()(1), -i);
+    EXPECT_EQ(vec.TotalBytes(), 2 * sizeof(int64_t));
+  }
+}
+
+TEST(Tensor, FromCallerOwnedBuffer) {
+  alignas(Allocator::kAllocatorAlignment) static float data[4] = {1.f, 2.f,
+                                                                  3.f, 4.f};
+  bool deleted = false;
+  {
+    Tensor t;
+    TF_ASSERT_OK(Tensor::FromCallerOwnedBuffer(
+        DT_FLOAT, TensorShape({4}), data, sizeof(data),
+        [&deleted](void* ptr, size_t len) {
+          EXPECT_EQ(ptr, data);
+          EXPECT_EQ(len, sizeof(data));
+          deleted = true;
+        },
+        &t));
+    // The tensor aliases the caller's memory: no copy was made.
+    EXPECT_EQ(t.flat<float>().data(), data);
+    EXPECT_EQ(t.flat<float>()(2), 3.f);
+    Tensor copy(t);
+    EXPECT_TRUE(t.SharesBufferWith(copy));
+    EXPECT_FALSE(deleted);
+  }
+  // The deleter runs once the last reference is gone.
+  EXPECT_TRUE(deleted);
+}
+
+TEST(Tensor, FromCallerOwnedBufferErrors) {
+  alignas(Allocator::kAllocatorAlignment) static float data[4];
+  Tensor t;
+  // Wrong length.
+  EXPECT_FALSE(Tensor::FromCallerOwnedBuffer(DT_FLOAT, TensorShape({5}), data,
+                                             sizeof(data), nullptr, &t)
+                   .ok());
+  // Misaligned pointer.
+  EXPECT_FALSE(Tensor::FromCallerOwnedBuffer(
+                   DT_FLOAT, TensorShape({3}),
+                   reinterpret_cast<char*>(data) + sizeof(float),
+                   3 * sizeof(float), nullptr, &t)
+                   .ok());
+  // Variable-length dtypes cannot alias flat memory.
+  EXPECT_FALSE(Tensor::FromCallerOwnedBuffer(DT_STRING, TensorShape({1}), data,
+                                             sizeof(data), nullptr, &t)
+                   .ok());
+}
+
 TEST(Tensor, FailureToAllocate) {
   TensorShape shape({1});
   DummyCPUAllocator allocator;
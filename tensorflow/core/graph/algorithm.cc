@@ -40,6 +40,9 @@ void DFSFromHelper(const Graph& g, gtl::ArraySlice<T> start,
   }
 
   std::vector<bool> visited(g.num_node_ids(), false);
+  // Reused across iterations to avoid allocating a fresh vector for every
+  // node visited with a stable comparator.
+  std::vector<Node*> nodes_sorted;
   while (!stack.empty()) {
     Work w = stack.back();
     stack.pop_back();
@@ -65,7 +68,7 @@ void DFSFromHelper(const Graph& g, gtl::ArraySlice<T> start,
     };
 
     if (stable_comparator) {
-      std::vector<Node*> nodes_sorted;
+      nodes_sorted.clear();
       for (const Edge* out_edge : n->out_edges()) {
         if (!edge_filter || edge_filter(*out_edge)) {
           nodes_sorted.emplace_back(out_edge->dst());
@@ -137,6 +140,9 @@ void ReverseDFSFromHelper(const Graph& g, gtl::ArraySlice<T> start,
   }
 
   std::vector<bool> visited(g.num_node_ids(), false);
+  // Reused across iterations to avoid allocating a fresh vector for every
+  // node visited with a stable comparator.
+  std::vector<T> nodes_sorted;
   while (!stack.empty()) {
     Work w = stack.back();
     stack.pop_back();
@@ -162,7 +168,7 @@ void ReverseDFSFromHelper(const Graph& g, gtl::ArraySlice<T> start,
     };
 
     if (stable_comparator) {
-      std::vector<T> nodes_sorted;
+      nodes_sorted.clear();
       for (const Edge* in_edge : n->in_edges()) {
         if (!edge_filter || edge_filter(*in_edge)) {
           nodes_sorted.emplace_back(in_edge->src());
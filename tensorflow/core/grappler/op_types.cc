@@ -504,6 +504,8 @@ bool IsRsqrt(const NodeDef& node) { return node.op() == "Rsqrt"; }
 
 bool IsRsqrtGrad(const NodeDef& node) { return node.op() == "RsqrtGrad"; }
 
+bool IsSegmentSum(const NodeDef& node) { return node.op() == "SegmentSum"; }
+
 bool IsSelect(const NodeDef& node) {
   return node.op() == "Select" || node.op() == "SelectV2";
 }
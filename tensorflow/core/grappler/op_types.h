@@ -160,6 +160,7 @@ bool IsReverse(const NodeDef& node);
 bool IsReverseV2(const NodeDef& node);
 bool IsRsqrt(const NodeDef& node);
 bool IsRsqrtGrad(const NodeDef& node);
+bool IsSegmentSum(const NodeDef& node);
 bool IsSelect(const NodeDef& node);
 bool IsSeluGrad(const NodeDef& node);
 bool IsSend(const NodeDef& node);
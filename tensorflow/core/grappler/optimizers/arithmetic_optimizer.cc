@@ -4225,6 +4225,111 @@ class SimplifyEmbeddingLookupStage : public ArithmeticOptimizerStage {
   }
 };
 
+// Fuses a Gather into a following sorted segment sum, eliminating the
+// materialized gather result:
+//
+//   SegmentSum(Gather(params, indices), segment_ids)
+//     => SparseSegmentSum(params, indices, segment_ids)
+//
+// This pattern is common in embedding lookups, where the intermediate gather
+// output is (num_indices x embedding_dim) and can be far larger than either
+// the output or the working set actually touched in the table.  The sparse
+// segment reduction kernels stream the gathered rows directly into the
+// segment accumulators.
+class FuseGatherIntoSegmentSumStage : public ArithmeticOptimizerStage {
+ public:
+  explicit FuseGatherIntoSegmentSumStage(
+      const GraphOptimizerContext& ctx,
+      const ArithmeticOptimizerContext& ctx_ext)
+      : ArithmeticOptimizerStage("FuseGatherIntoSegmentSumStage", ctx,
+                                 ctx_ext) {}
+  ~FuseGatherIntoSegmentSumStage() override = default;
+
+  bool IsSupported(const NodeDef* node) const override {
+    return IsSegmentSum(*node);
+  }
+
+  Status TrySimplify(NodeDef* reduction_node,
+                     string* simplified_node_name) override {
+    if (IsInPreserveSet(*reduction_node)) return OkStatus();
+
+    // SparseSegmentSum does not support complex types.
+    DataType element_type;
+    TF_RETURN_IF_ERROR(GetNodeAttr(*reduction_node, "T", &element_type));
+    if (DataTypeIsComplex(element_type) ||
+        DataTypeIsQuantized(element_type)) {
+      return OkStatus();
+    }
+
+    // Input 0 (data) of the segment sum must be a tf.gather() on the 0th
+    // axis.  Resource gathers are skipped; SimplifyEmbeddingLookupStage
+    // handles rewiring those where it applies.
+    NodeDef* gather_node = nullptr;
+    TF_RETURN_IF_ERROR(GetInputNode(reduction_node->input(0), &gather_node));
+    if (!IsGather(*gather_node) || gather_node->op() == "ResourceGather" ||
+        IsInPreserveSet(*gather_node) ||
+        gather_node->device() != reduction_node->device())
+      return OkStatus();
+    if (gather_node->op() == "GatherV2" &&
+        (!IsAxis0(*gather_node, 2) || IsBatched(*gather_node)))
+      return OkStatus();
+
+    // Only fuse when the segment sum is the sole consumer of the gather;
+    // otherwise the intermediate is materialized anyway and the fusion would
+    // just gather the rows twice.
+    if (NumNonControlOutputs(*gather_node, *ctx().node_map) > 1)
+      return OkStatus();
+
+    DataType index_type;
+    TF_RETURN_IF_ERROR(GetNodeAttr(*gather_node, "Tindices", &index_type));
+
+    // The gathered rows become a virtual input of the sparse reduction:
+    // data becomes the gather params and the gather indices move to the
+    // indices input.  The segment ids input is unchanged.
+    reduction_node->set_op("SparseSegmentSum");
+    reduction_node->add_input(reduction_node->input(1));
+    reduction_node->set_input(1, gather_node->input(1));
+    ctx().node_map->AddOutput(NodeName(gather_node->input(1)),
+                              reduction_node->name());
+    reduction_node->set_input(0, gather_node->input(0));
+    ctx().node_map->UpdateInput(reduction_node->name(), gather_node->name(),
+                                gather_node->input(0));
+
+    DataType segment_ids_type;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(*reduction_node, "Tindices", &segment_ids_type));
+    reduction_node->mutable_attr()->erase("Tindices");
+    SetDataTypeToAttr(index_type, "Tidx", reduction_node);
+    SetDataTypeToAttr(segment_ids_type, "Tsegmentids", reduction_node);
+
+    *simplified_node_name = reduction_node->name();
+    return OkStatus();
+  }
+
+ private:
+  bool IsAxis0(const NodeDef& node, int axis_input) {
+    Tensor axis_tensor;
+    if (!GetTensorFromConstNode(node.input(axis_input), &axis_tensor))
+      return false;
+    if (axis_tensor.NumElements() != 1) return false;
+    if (axis_tensor.dtype() == DT_INT32) {
+      return axis_tensor.flat<int32>()(0) == 0;
+    } else if (axis_tensor.dtype() == DT_INT64) {
+      return axis_tensor.flat<int64_t>()(0) == 0;
+    } else {
+      return false;
+    }
+  }
+
+  bool IsBatched(const NodeDef& node) {
+    int64_t batch_dims = 0;
+    if (TryGetNodeAttr(node, "batch_dims", &batch_dims)) {
+      return batch_dims != 0;
+    }
+    return false;
+  }
+};
+
 // Eliminates unnecessary casts before sparse segment reduction operations.
 //
 // Existing graphs and library code would often insert a cast from DT_INT64 to
@@ -4366,6 +4471,8 @@ Status ArithmeticOptimizer::SimplifyArithmeticOps(bool can_use_shapes) {
     pipeline.AddStage<SimplifyEmbeddingLookupStage>(ctx, ctx_ext);
   if (options_.remove_cast_into_segment_reduction)
     pipeline.AddStage<RemoveCastIntoSegmentReductionStage>(ctx, ctx_ext);
+  if (options_.fuse_gather_into_segment_sum)
+    pipeline.AddStage<FuseGatherIntoSegmentSumStage>(ctx, ctx_ext);
   if (options_.fuse_squared_diff)
     pipeline.AddStage<FuseSquaredDiffStage>(ctx, ctx_ext);
 
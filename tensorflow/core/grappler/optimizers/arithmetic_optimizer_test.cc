@@ -4833,5 +4833,82 @@ TEST_F(ArithmeticOptimizerTest, RemoveCastIntoSegmentReduction) {
   }
 }
 
+TEST_F(ArithmeticOptimizerTest, FuseGatherIntoSegmentSum) {
+  for (DataType indices_type : {DT_INT32, DT_INT64}) {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output embeddings = ops::Const(s.WithOpName("embeddings"),
+                                   {1.0f, 2.0f, 3.0f, 4.0f}, {2, 2});
+    Output indices =
+        ops::Cast(s.WithOpName("indices"),
+                  ops::Const(s.WithOpName("indices_i32"), {0, 0, 1, 0, 1}),
+                  indices_type);
+    Output segment_ids =
+        ops::Const(s.WithOpName("segment_ids"), {0, 0, 1, 2, 2});
+    Output gathered_rows =
+        ops::Gather(s.WithOpName("gathered_rows"), embeddings, indices);
+    Output result =
+        ops::SegmentSum(s.WithOpName("result"), gathered_rows, segment_ids);
+    Output id = ops::Identity(s.WithOpName("id"), result);
+
+    GrapplerItem item;
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    item.fetch = {"id"};
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch);
+    ASSERT_EQ(tensors_expected.size(), 1);
+
+    GraphDef output;
+    ArithmeticOptimizer optimizer;
+    EnableOnlyFuseGatherIntoSegmentSum(&optimizer);
+    OptimizeAndPrune(&optimizer, &item, &output);
+
+    for (const auto& node : output.node()) {
+      if (node.name() == "result") {
+        EXPECT_EQ(node.op(), "SparseSegmentSum");
+        EXPECT_EQ(node.input(0), "embeddings");
+        EXPECT_EQ(node.input(1), "indices");
+        EXPECT_EQ(node.input(2), "segment_ids");
+      }
+      EXPECT_NE(node.op(), "Gather");
+    }
+
+    auto tensors = EvaluateNodes(output, item.fetch);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectTensorEqual<float>(tensors[0], tensors_expected[0]);
+  }
+}
+
+// The fusion must not fire when the gather result has other consumers; the
+// intermediate is materialized anyway and fusing would gather the rows twice.
+TEST_F(ArithmeticOptimizerTest, DoNotFuseGatherIntoSegmentSumWithFanout) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output embeddings = ops::Const(s.WithOpName("embeddings"),
+                                 {1.0f, 2.0f, 3.0f, 4.0f}, {2, 2});
+  Output indices = ops::Const(s.WithOpName("indices"), {0, 0, 1, 0, 1});
+  Output segment_ids =
+      ops::Const(s.WithOpName("segment_ids"), {0, 0, 1, 2, 2});
+  Output gathered_rows =
+      ops::Gather(s.WithOpName("gathered_rows"), embeddings, indices);
+  Output result =
+      ops::SegmentSum(s.WithOpName("result"), gathered_rows, segment_ids);
+  Output id = ops::Identity(s.WithOpName("id"), result);
+  Output other = ops::Identity(s.WithOpName("other"), gathered_rows);
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"id", "other"};
+
+  GraphDef output;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyFuseGatherIntoSegmentSum(&optimizer);
+  OptimizeAndPrune(&optimizer, &item, &output);
+
+  for (const auto& node : output.node()) {
+    if (node.name() == "result") {
+      EXPECT_EQ(node.op(), "SegmentSum");
+      EXPECT_EQ(node.input(0), "gathered_rows");
+    }
+  }
+}
+
 }  // namespace grappler
 }  // namespace tensorflow
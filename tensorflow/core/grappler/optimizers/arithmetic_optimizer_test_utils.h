@@ -249,6 +249,11 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     optimizer->options_.remove_cast_into_segment_reduction = true;
   }
 
+  void EnableOnlyFuseGatherIntoSegmentSum(ArithmeticOptimizer* optimizer) {
+    DisableAllStages(optimizer);
+    optimizer->options_.fuse_gather_into_segment_sum = true;
+  }
+
  private:
   void DisableAllStages(ArithmeticOptimizer* optimizer) {
     ArithmeticOptimizer::ArithmeticOptimizerOptions options;
@@ -279,6 +284,7 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     options.unary_ops_composition = false;
     options.simplify_embedding_lookup = false;
     options.remove_cast_into_segment_reduction = false;
+    options.fuse_gather_into_segment_sum = false;
     optimizer->options_ = options;
   }
 };
@@ -376,6 +376,7 @@ class AutoMixedPrecisionListsMkl : public AutoMixedPrecisionLists {
                                      "MatMul",
                                      "BatchMatMul",
                                      "BatchMatMulV2",
+                                     "_FusedAttention",
 #ifndef DNNL_AARCH64_USE_ACL
                                      "Einsum"
 #endif  // DNNL_AARCH64_USE_ACL
@@ -410,8 +411,11 @@ class AutoMixedPrecisionListsMkl : public AutoMixedPrecisionLists {
                                      "Sub",
                                      "Elu",
                                      "EluGrad",
+                                     "Erf",
                                      "FloorDiv",
                                      "_FusedBatchNormEx",
+                                     "_FusedGelu",
+                                     "_FusedLayerNorm",
                                      "Log",
                                      "Log1p",
                                      "LogSoftmax",
@@ -429,7 +433,12 @@ class AutoMixedPrecisionListsMkl : public AutoMixedPrecisionLists {
                                      "Softsign",
                                      "SoftsignGrad",
                                      "Sqrt",
+                                     "Square",
                                      "SquaredDifference",
+                                     // CPU sum reductions accumulate in
+                                     // float (see reduction_ops.h), so bf16
+                                     // inputs do not lose accuracy.
+                                     "Sum",
                                      "Tanh",
                                      "TanhGrad"};
     UpdateList("INFERLIST", &list);
@@ -448,7 +457,6 @@ class AutoMixedPrecisionListsMkl : public AutoMixedPrecisionLists {
         "SaveV2",
         "SoftmaxCrossEntropyWithLogits",
         "SparseSoftmaxCrossEntropyWithLogits",
-        "Sum",
     };
     UpdateList("DENYLIST", &list);
     // For backwards compatibility, keeping the original env variable here.
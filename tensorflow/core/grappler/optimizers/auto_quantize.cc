@@ -0,0 +1,279 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/auto_quantize.h"
+
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/util/util.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+// A float MatMul+BiasAdd pair whose weights come from a Const node.
+struct FusedLayer {
+  NodeDef* bias_add;
+  NodeDef* matmul;
+  const NodeDef* weights;
+};
+
+bool IsFloatAttr(const NodeDef& node, const string& attr) {
+  auto iter = node.attr().find(attr);
+  return iter != node.attr().end() && iter->second.type() == DT_FLOAT;
+}
+
+NodeDef* AddConstNode(GraphDef* graph, const string& name,
+                      const string& device, const Tensor& value) {
+  NodeDef* node = graph->add_node();
+  node->set_name(name);
+  node->set_op("Const");
+  node->set_device(device);
+  (*node->mutable_attr())["dtype"].set_type(value.dtype());
+  value.AsProtoTensorContent(
+      (*node->mutable_attr())["value"].mutable_tensor());
+  return node;
+}
+
+NodeDef* AddScalarConstNode(GraphDef* graph, const string& name,
+                            const string& device, float value) {
+  Tensor tensor(DT_FLOAT, TensorShape({}));
+  tensor.scalar<float>()() = value;
+  return AddConstNode(graph, name, device, tensor);
+}
+
+// Quantizes `weights` to symmetric qint8, as expected by the oneDNN
+// inner-product primitive.  Returns false (leaving the layer in fp32) when
+// the weights are degenerate: all zero, or containing non-finite values.
+bool QuantizeWeights(const Tensor& weights, Tensor* quantized,
+                     float* max_abs_value) {
+  const auto flat = weights.flat<float>();
+  float max_abs = 0.0f;
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    if (!std::isfinite(flat(i))) return false;
+    max_abs = std::max(max_abs, std::abs(flat(i)));
+  }
+  if (max_abs == 0.0f) return false;
+
+  *quantized = Tensor(DT_QINT8, weights.shape());
+  auto quantized_flat = quantized->flat<qint8>();
+  const float scale = 127.0f / max_abs;
+  for (int64_t i = 0; i < flat.size(); ++i) {
+    quantized_flat(i) =
+        static_cast<int8>(std::lround(flat(i) * scale));
+  }
+  *max_abs_value = max_abs;
+  return true;
+}
+
+}  // namespace
+
+Status AutoQuantize::Optimize(Cluster* cluster, const GrapplerItem& item,
+                              GraphDef* output) {
+  if (!IsMKLEnabled()) {
+    // The quantized kernels below are backed by oneDNN only; without it the
+    // whole graph falls back to fp32.
+    return errors::Aborted("oneDNN is not enabled.");
+  }
+  *output = item.graph;
+  NodeMap node_map(output);
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // Collects MatMul+BiasAdd pairs first: the rewrite below appends nodes to
+  // the graph, which would invalidate iteration.  NodeDef pointers stay valid
+  // across add_node().
+  std::vector<FusedLayer> layers;
+  absl::flat_hash_set<string> matched_matmuls;
+  for (NodeDef& node : *output->mutable_node()) {
+    if (node.op() != "BiasAdd" || !IsFloatAttr(node, "T")) continue;
+    auto data_format = node.attr().find("data_format");
+    if (data_format != node.attr().end() && data_format->second.s() == "NCHW") {
+      continue;
+    }
+    if (node.input_size() < 2 || IsControlInput(node.input(0)) ||
+        IsControlInput(node.input(1))) {
+      continue;
+    }
+    NodeDef* matmul = node_map.GetNode(node.input(0));
+    if (matmul == nullptr || matmul->op() != "MatMul" ||
+        !IsFloatAttr(*matmul, "T")) {
+      continue;
+    }
+    // The quantized op consumes an activation quantized with MIN_FIRST, which
+    // the oneDNN kernel only dequantizes correctly for a non-transposed a.
+    auto transpose_a = matmul->attr().find("transpose_a");
+    if (transpose_a != matmul->attr().end() && transpose_a->second.b()) {
+      continue;
+    }
+    if (nodes_to_preserve.count(matmul->name()) > 0) continue;
+    // The MatMul disappears into the fused op, so the BiasAdd must be its
+    // only consumer.
+    if (node_map.GetOutputs(matmul->name()).size() != 1) continue;
+    if (matmul->device() != node.device()) continue;
+    if (!matched_matmuls.insert(matmul->name()).second) continue;
+
+    const TensorId weights_id = ParseTensorName(matmul->input(1));
+    if (weights_id.index() != 0) continue;
+    const NodeDef* weights = node_map.GetNode(matmul->input(1));
+    if (weights == nullptr || weights->op() != "Const" ||
+        weights->attr().at("dtype").type() != DT_FLOAT) {
+      continue;
+    }
+    layers.push_back({&node, matmul, weights});
+  }
+
+  std::set<string> nodes_to_delete;
+  for (const FusedLayer& layer : layers) {
+    Tensor weights;
+    if (!weights.FromProto(layer.weights->attr().at("value").tensor()) ||
+        weights.dims() != 2) {
+      continue;
+    }
+    Tensor quantized_weights;
+    float max_abs = 0.0f;
+    if (!QuantizeWeights(weights, &quantized_weights, &max_abs)) continue;
+
+    const string base = strings::StrCat(layer.matmul->name(), "/quantized");
+    const string& device = layer.matmul->device();
+    const string activation = layer.matmul->input(0);
+
+    AddConstNode(output, strings::StrCat(base, "/weights"), device,
+                 quantized_weights);
+    AddScalarConstNode(output, strings::StrCat(base, "/min_weight"), device,
+                       -max_abs);
+    AddScalarConstNode(output, strings::StrCat(base, "/max_weight"), device,
+                       max_abs);
+
+    // The activation range is computed per batch: flatten the activation and
+    // reduce it to scalar min/max feeding QuantizeV2.
+    Tensor flat_shape(DT_INT32, TensorShape({1}));
+    flat_shape.vec<int32>()(0) = -1;
+    AddConstNode(output, strings::StrCat(base, "/flat_shape"), device,
+                 flat_shape);
+    NodeDef* reshape = output->add_node();
+    reshape->set_name(strings::StrCat(base, "/flatten"));
+    reshape->set_op("Reshape");
+    reshape->set_device(device);
+    (*reshape->mutable_attr())["T"].set_type(DT_FLOAT);
+    (*reshape->mutable_attr())["Tshape"].set_type(DT_INT32);
+    reshape->add_input(activation);
+    reshape->add_input(strings::StrCat(base, "/flat_shape"));
+
+    Tensor reduce_dim(DT_INT32, TensorShape({}));
+    reduce_dim.scalar<int32>()() = 0;
+    AddConstNode(output, strings::StrCat(base, "/reduce_dim"), device,
+                 reduce_dim);
+    for (const char* reduction : {"Min", "Max"}) {
+      NodeDef* reduce = output->add_node();
+      reduce->set_name(strings::StrCat(base, "/", reduction, "_input"));
+      reduce->set_op(reduction);
+      reduce->set_device(device);
+      (*reduce->mutable_attr())["T"].set_type(DT_FLOAT);
+      (*reduce->mutable_attr())["Tidx"].set_type(DT_INT32);
+      (*reduce->mutable_attr())["keep_dims"].set_b(false);
+      reduce->add_input(reshape->name());
+      reduce->add_input(strings::StrCat(base, "/reduce_dim"));
+    }
+
+    NodeDef* quantize = output->add_node();
+    quantize->set_name(strings::StrCat(base, "/quantize"));
+    quantize->set_op("QuantizeV2");
+    quantize->set_device(device);
+    (*quantize->mutable_attr())["T"].set_type(DT_QUINT8);
+    (*quantize->mutable_attr())["mode"].set_s("MIN_FIRST");
+    (*quantize->mutable_attr())["round_mode"].set_s("HALF_AWAY_FROM_ZERO");
+    (*quantize->mutable_attr())["narrow_range"].set_b(false);
+    (*quantize->mutable_attr())["axis"].set_i(-1);
+    (*quantize->mutable_attr())["ensure_minimum_range"].set_f(0.01f);
+    quantize->add_input(activation);
+    quantize->add_input(strings::StrCat(base, "/Min_input"));
+    quantize->add_input(strings::StrCat(base, "/Max_input"));
+
+    // The fused op requantizes to the frozen output range only when its
+    // output is itself quantized; with a float output these two inputs are
+    // required by the signature but do not affect the result.
+    AddScalarConstNode(output, strings::StrCat(base, "/min_frozen"), device,
+                       0.0f);
+    AddScalarConstNode(output, strings::StrCat(base, "/max_frozen"), device,
+                       0.0f);
+
+    // Replaces the BiasAdd in place so that its fanout (and any fetch of its
+    // name) now reads the dequantized int8 product.
+    NodeDef* fused = layer.bias_add;
+    const string bias = fused->input(1);
+    std::vector<string> control_inputs;
+    for (const NodeDef* source : {layer.matmul, layer.bias_add}) {
+      for (const string& input : source->input()) {
+        if (IsControlInput(input)) control_inputs.push_back(input);
+      }
+    }
+    fused->set_op("QuantizedMatMulWithBiasAndDequantize");
+    fused->clear_input();
+    fused->add_input(quantize->name());
+    fused->add_input(strings::StrCat(base, "/weights"));
+    fused->add_input(bias);
+    fused->add_input(strings::StrCat(quantize->name(), ":1"));
+    fused->add_input(strings::StrCat(quantize->name(), ":2"));
+    fused->add_input(strings::StrCat(base, "/min_weight"));
+    fused->add_input(strings::StrCat(base, "/max_weight"));
+    fused->add_input(strings::StrCat(base, "/min_frozen"));
+    fused->add_input(strings::StrCat(base, "/max_frozen"));
+    for (const string& input : control_inputs) fused->add_input(input);
+    fused->clear_attr();
+    (*fused->mutable_attr())["T1"].set_type(DT_QUINT8);
+    (*fused->mutable_attr())["T2"].set_type(DT_QINT8);
+    (*fused->mutable_attr())["Tbias"].set_type(DT_FLOAT);
+    (*fused->mutable_attr())["Toutput"].set_type(DT_FLOAT);
+    (*fused->mutable_attr())["transpose_a"].set_b(false);
+    auto transpose_b = layer.matmul->attr().find("transpose_b");
+    (*fused->mutable_attr())["transpose_b"].set_b(
+        transpose_b != layer.matmul->attr().end() && transpose_b->second.b());
+    (*fused->mutable_attr())["input_quant_mode"].set_s("MIN_FIRST");
+
+    nodes_to_delete.insert(layer.matmul->name());
+    // The fp32 weights are dead unless some other node shares them.
+    if (node_map.GetOutputs(layer.weights->name()).size() == 1 &&
+        nodes_to_preserve.count(layer.weights->name()) == 0) {
+      nodes_to_delete.insert(layer.weights->name());
+    }
+  }
+
+  if (nodes_to_delete.empty()) {
+    return errors::Aborted("Nothing to do.");
+  }
+  EraseNodesFromGraph(nodes_to_delete, output);
+
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(AutoQuantize, "auto_quantize");
+
+}  // end namespace grappler
+}  // end namespace tensorflow
@@ -0,0 +1,60 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_AUTO_QUANTIZE_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_AUTO_QUANTIZE_H_
+
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// AutoQuantize rewrites fp32 MatMul+BiasAdd pairs with constant weights into
+// the int8 oneDNN inference path.  Weights are quantized at rewrite time to
+// symmetric qint8, activations are quantized dynamically per batch (a Min/Max
+// pair feeding QuantizeV2 in MIN_FIRST mode), and the product is computed and
+// dequantized in one QuantizedMatMulWithBiasAndDequantize op, which the oneDNN
+// graph rewrite lowers to a VNNI-capable inner-product primitive.
+//
+// Dynamic activation ranges make this a post-training rewrite that needs no
+// calibration data, at the cost of a range reduction per batch.  Layers whose
+// weights are not constant (or are degenerate) are left in fp32, and the pass
+// is a no-op in builds without oneDNN, so unquantizable graphs fall back to
+// the float path untouched.
+//
+// This is an opt-in optimization: enable it by adding "auto_quantize" to
+// RewriterConfig.custom_optimizers.
+class AutoQuantize : public CustomGraphOptimizer {
+ public:
+  AutoQuantize() {}
+  ~AutoQuantize() override {}
+
+  string name() const override { return "auto_quantize"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Init(const tensorflow::RewriterConfig_CustomGraphOptimizer* config =
+                  nullptr) override {
+    return OkStatus();
+  }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* output) override;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_AUTO_QUANTIZE_H_
@@ -0,0 +1,107 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#if defined(INTEL_MKL) && defined(ENABLE_MKL)
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/auto_quantize.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+
+class AutoQuantizeTest : public GrapplerTest {};
+
+TEST_F(AutoQuantizeTest, QuantizeMatMulWithBias) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                ops::Placeholder::Shape({4, 3}));
+  auto weights = ops::Const(s.WithOpName("weights"),
+                            {-1.0f, 0.25f, 0.5f, -0.75f, 1.0f, 0.125f,
+                             -0.5f, 0.75f, -0.25f, 0.375f, -0.125f, 0.625f},
+                            {3, 4});
+  auto bias = ops::Const(s.WithOpName("bias"), {0.1f, -0.2f, 0.3f, -0.4f});
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights);
+  auto bias_add = ops::BiasAdd(s.WithOpName("bias_add"), matmul, bias);
+
+  GrapplerItem item;
+  item.fetch = {"bias_add"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  GraphDef output;
+  AutoQuantize optimizer;
+  TF_EXPECT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  bool found_fused = false;
+  bool found_quantized_weights = false;
+  for (const NodeDef& node : output.node()) {
+    EXPECT_NE(node.op(), "MatMul");
+    if (node.name() == "bias_add") {
+      EXPECT_EQ(node.op(), "QuantizedMatMulWithBiasAndDequantize");
+      EXPECT_EQ(node.attr().at("T1").type(), DT_QUINT8);
+      EXPECT_EQ(node.attr().at("T2").type(), DT_QINT8);
+      EXPECT_EQ(node.attr().at("Toutput").type(), DT_FLOAT);
+      EXPECT_EQ(node.input(2), "bias");
+      found_fused = true;
+    } else if (node.name() == "matmul/quantized/weights") {
+      EXPECT_EQ(node.op(), "Const");
+      EXPECT_EQ(node.attr().at("dtype").type(), DT_QINT8);
+      found_quantized_weights = true;
+    }
+  }
+  EXPECT_TRUE(found_fused);
+  EXPECT_TRUE(found_quantized_weights);
+
+  auto feed =
+      test::AsTensor<float>({0.5f, -0.5f, 1.0f, -1.0f, 0.25f, 0.75f, 0.0f,
+                             0.125f, -0.25f, 0.875f, -0.75f, 0.375f},
+                            {4, 3});
+  auto tensors_expected =
+      EvaluateNodes(item.graph, item.fetch, {{"input", feed}});
+  auto tensors = EvaluateNodes(output, item.fetch, {{"input", feed}});
+  ASSERT_EQ(tensors_expected.size(), 1);
+  ASSERT_EQ(tensors.size(), 1);
+  // Dynamic-range uint8 activations and int8 weights resolve roughly 1/255
+  // of the respective ranges, so the product is only accurate to ~1e-2.
+  test::ExpectClose(tensors_expected[0], tensors[0], /*atol=*/1e-1);
+}
+
+TEST_F(AutoQuantizeTest, NonConstWeightsAreLeftAlone) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                ops::Placeholder::Shape({4, 3}));
+  auto weights = ops::Placeholder(s.WithOpName("weights"), DT_FLOAT,
+                                  ops::Placeholder::Shape({3, 4}));
+  auto bias = ops::Const(s.WithOpName("bias"), {0.1f, -0.2f, 0.3f, -0.4f});
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights);
+  auto bias_add = ops::BiasAdd(s.WithOpName("bias_add"), matmul, bias);
+
+  GrapplerItem item;
+  item.fetch = {"bias_add"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  GraphDef output;
+  AutoQuantize optimizer;
+  // Nothing matches, so the optimizer reports that it has nothing to do.
+  EXPECT_TRUE(errors::IsAborted(optimizer.Optimize(nullptr, item, &output)));
+}
+
+}  // namespace grappler
+}  // namespace tensorflow
+#endif  // INTEL_MKL && ENABLE_MKL
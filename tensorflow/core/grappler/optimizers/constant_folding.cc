@@ -17,12 +17,18 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/constant_folding.h"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/op.h"
@@ -49,6 +55,8 @@ limitations under the License.
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/denormal.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/setround.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/public/version.h"
@@ -78,6 +86,87 @@ bool AllValuesAre(const TensorProto& proto, const T& value) {
   return true;
 }
 
+// Process-level cache of folded tensors, keyed by the op, its attributes and
+// the exact values of its constant inputs. Models loaded into the same
+// process often share their preprocessing constants, so every load after the
+// first can skip the kernel evaluation and reuse the constant node
+// definitions computed by an earlier load. Only side-effect-free nodes reach
+// the folding path, so identical keys imply identical results.
+//
+// Entries are bucketed by a 64-bit hash of the key material, but the
+// material itself is stored and compared on every lookup: a hash collision
+// degrades to a cache miss instead of silently substituting another fold's
+// constants.
+class FoldedSubgraphCache {
+ public:
+  static FoldedSubgraphCache* Global() {
+    static FoldedSubgraphCache* cache = new FoldedSubgraphCache;
+    return cache;
+  }
+
+  // Returns the folded outputs cached under `key` (with empty node names),
+  // or nullptr on a miss.
+  std::shared_ptr<const std::vector<NodeDef>> Lookup(const string& key) {
+    mutex_lock lock(mu_);
+    auto it = entries_.find(Hash64(key));
+    if (it == entries_.end() || it->second.key != key) {
+      return nullptr;
+    }
+    return it->second.outputs;
+  }
+
+  void Insert(const string& key,
+              std::shared_ptr<const std::vector<NodeDef>> outputs) {
+    int64_t size = key.size();
+    for (const NodeDef& node : *outputs) {
+      size += node.ByteSizeLong();
+    }
+    mutex_lock lock(mu_);
+    // Keeping every fold ever computed would leak in long-lived processes
+    // that churn through unrelated models, so stop inserting past a fixed
+    // budget; existing entries keep being shared.
+    if (bytes_ + size > kMaxBytes) {
+      return;
+    }
+    if (entries_.emplace(Hash64(key), Entry{key, std::move(outputs)}).second) {
+      bytes_ += size;
+    }
+  }
+
+ private:
+  static constexpr int64_t kMaxBytes = 64 << 20;
+
+  struct Entry {
+    string key;
+    std::shared_ptr<const std::vector<NodeDef>> outputs;
+  };
+
+  mutex mu_;
+  absl::flat_hash_map<uint64, Entry> entries_ TF_GUARDED_BY(mu_);
+  int64_t bytes_ TF_GUARDED_BY(mu_) = 0;
+};
+
+// Appends `piece` to `key`, length-delimited so that distinct sequences of
+// pieces can never produce the same key bytes.
+void AppendToCacheKey(absl::string_view piece, string* key) {
+  strings::StrAppend(key, piece.size(), ":", piece);
+}
+
+// Appends the attributes of `node` to `key`, visited in a deterministic
+// order.
+void AppendAttrsToCacheKey(const NodeDef& node, string* key) {
+  std::vector<std::pair<absl::string_view, const AttrValue*>> attrs;
+  attrs.reserve(node.attr().size());
+  for (const auto& attr : node.attr()) {
+    attrs.emplace_back(attr.first, &attr.second);
+  }
+  std::sort(attrs.begin(), attrs.end());
+  for (const auto& attr : attrs) {
+    AppendToCacheKey(attr.first, key);
+    AppendToCacheKey(attr.second->SerializeAsString(), key);
+  }
+}
+
 // Add new_input as a control input to node if it does not already depend on it.
 // TODO(rmlarsen): Move the following two utility functions to utils.{h,cc} and
 // clean up code that should be using them.
@@ -1346,6 +1435,13 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     }
   });
 
+  // Key of the constant subgraph being folded: the op, its attributes and
+  // the exact values of its constant inputs determine the result, so the key
+  // is shared across graphs and sessions.
+  string cache_key;
+  AppendToCacheKey(node.op(), &cache_key);
+  AppendAttrsToCacheKey(node, &cache_key);
+
   size_t total_inputs_size = 0;
   for (const auto& input : node.input()) {
     const TensorId input_tensor = ParseTensorName(input);
@@ -1382,6 +1478,22 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     }
     inputs.emplace_back(value);
     total_inputs_size += value->TotalBytes();
+    AppendToCacheKey(raw_val.SerializeAsString(), &cache_key);
+  }
+
+  FoldedSubgraphCache* cache = FoldedSubgraphCache::Global();
+  if (std::shared_ptr<const std::vector<NodeDef>> cached =
+          cache->Lookup(cache_key)) {
+    outputs->resize(cached->size());
+    for (size_t i = 0; i < cached->size(); i++) {
+      string node_name = OptimizedNodeName(node, "-folded");
+      if (cached->size() > 1) {
+        node_name = strings::StrCat(node_name, "-", i);
+      }
+      outputs->at(i) = (*cached)[i];
+      outputs->at(i).set_name(node_name);
+    }
+    return OkStatus();
   }
 
   TF_RETURN_IF_ERROR(EvaluateNode(node, inputs, &output_tensors));
@@ -1389,6 +1501,7 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     return Status(error::INVALID_ARGUMENT, "Expected at least one output.");
   }
 
+  bool cacheable = true;
   outputs->resize(output_tensors.size());
   for (size_t i = 0; i < output_tensors.size(); i++) {
     string node_name = OptimizedNodeName(node, "-folded");
@@ -1406,7 +1519,17 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
       // Create an empty NodeDef to identify dead outputs (e.g. the output of a
       // switch that's not selected by the switch predicate).
       outputs->at(i) = NodeDef();
+      // A dead output is indistinguishable from an unset one in the cache, so
+      // don't cache folds that produced any.
+      cacheable = false;
+    }
+  }
+  if (cacheable) {
+    auto cached_outputs = std::make_shared<std::vector<NodeDef>>(*outputs);
+    for (NodeDef& output : *cached_outputs) {
+      output.clear_name();
     }
+    cache->Insert(cache_key, std::move(cached_outputs));
   }
   return OkStatus();
 }
@@ -308,6 +308,40 @@ TEST_F(ConstantFoldingTest, SimpleFolding) {
   test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
 }
 
+TEST_F(ConstantFoldingTest, FoldCacheSharedAcrossInstances) {
+  // Two separate optimizer instances fold the same constant subgraph; the
+  // second is served from the process-level fold cache and must produce the
+  // same graph and values as the first.
+  auto build_item = [] {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output a = ops::Const(s.WithOpName("a"), 3.0f, {2});
+    Output b = ops::Const(s.WithOpName("b"), 4.0f, {2});
+    Output c = ops::Mul(s.WithOpName("c"), a, b);
+    GrapplerItem item;
+    item.fetch.push_back("c");
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    return item;
+  };
+
+  GrapplerItem item = build_item();
+  ConstantFolding optimizer1(/*cpu_device=*/nullptr);
+  GraphDef output1;
+  TF_EXPECT_OK(optimizer1.Optimize(/*cluster=*/nullptr, item, &output1));
+
+  GrapplerItem item2 = build_item();
+  ConstantFolding optimizer2(/*cpu_device=*/nullptr);
+  GraphDef output2;
+  TF_EXPECT_OK(optimizer2.Optimize(/*cluster=*/nullptr, item2, &output2));
+
+  CompareGraphs(output1, output2);
+  std::vector<string> fetch = {"c"};
+  auto tensors_expected = EvaluateNodes(item.graph, fetch);
+  auto tensors = EvaluateNodes(output2, fetch);
+  ASSERT_EQ(1, tensors_expected.size());
+  ASSERT_EQ(1, tensors.size());
+  test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
+}
+
 TEST_F(ConstantFoldingTest, AddTree) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
 
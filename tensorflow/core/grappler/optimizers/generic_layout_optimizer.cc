@@ -272,6 +272,67 @@ Status EraseCancellableNodes(TransposeContext* context) {
   return mutation->Apply();
 }
 
+// Erases cancellable Transpose pairs already present in the input graph, e.g.
+// layout conversions inserted by earlier passes or written by the user. Such
+// pairs are pure overhead for format agnostic CPU kernels, so this is run on
+// the CPU path when no layout conversion takes place. The transposes are
+// rewritten to Identity instead of being removed so control dependencies and
+// fanouts of the pair stay intact; the dependency optimizer cleans up the
+// resulting Identity nodes.
+Status EraseCancellableTransposePairs(TransposeContext* context) {
+  utils::MutableGraphView* graph_view = context->graph_view.get();
+  utils::Mutation* mutation = graph_view->GetMutationBuilder();
+
+  absl::flat_hash_set<utils::MutableNodeView*> cancelled_transposes;
+
+  const int num_nodes = graph_view->NumNodes();
+  for (int i = 0; i < num_nodes; ++i) {
+    auto* transpose_after = graph_view->GetNode(i);
+    if (!IsTranspose(*transpose_after->node()) ||
+        transpose_after->NumRegularFanins() < 1 ||
+        cancelled_transposes.contains(transpose_after)) {
+      continue;
+    }
+
+    const auto& transpose_after_fanin = transpose_after->GetRegularFanin(0);
+    auto* transpose_before = transpose_after_fanin.node_view();
+    if (!IsTranspose(*transpose_before->node()) ||
+        transpose_before->NumRegularFanins() < 1 ||
+        cancelled_transposes.contains(transpose_before)) {
+      continue;
+    }
+
+    // The first transpose must only feed the second one: rewriting it to
+    // Identity changes the value any other consumer would observe. For the
+    // same reason a fetched first transpose must keep producing the
+    // transposed value. The second transpose's output is unchanged by the
+    // cancellation, so its fanouts need no restrictions.
+    if (transpose_before->NumRegularFanouts() != 1 ||
+        context->nodes_to_preserve.contains(transpose_before->GetName())) {
+      continue;
+    }
+
+    if (!IsCancellableConstPermTransposeNodePair(*transpose_after,
+                                                 *transpose_before)) {
+      continue;
+    }
+
+    const auto transpose_to_identity =
+        [&cancelled_transposes,
+         &mutation](utils::MutableNodeView* transpose) -> void {
+      mutation->UpdateNodeOp(transpose, "Identity");
+      mutation->RemoveNodeAttr(transpose, "Tperm");
+      mutation->RemoveRegularFanin(transpose, 1);
+      cancelled_transposes.insert(transpose);
+    };
+
+    transpose_to_identity(transpose_before);
+    transpose_to_identity(transpose_after);
+  }
+
+  return mutation->Apply();
+}
+
 // TODO(ezhulenev): This is a temporary workaround for a graph pattern
 // in Resnet models. We should be able to push down transpose nodes across Pad
 // and many other ops, and then rely on cancellation to remove them.
@@ -452,7 +513,12 @@ Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
             "Conversion from NHWC to NCHW is currently not  available for "
             "CPU.");
       default:
-        *output = item.graph;
+        // Even without a layout conversion, pairs of mutually cancelling
+        // transposes left in the graph by earlier passes are pure overhead
+        // for the format-agnostic CPU kernels; erase them.
+        TF_RETURN_IF_ERROR(EraseCancellableTransposePairs(&context));
+        TF_RETURN_IF_ERROR(EraseOutputShapeAttrs(&context));
+        *output = context.graph;
         VLOG(2) << "No layout conversion will take place for CPU.";
         return OkStatus();
     }
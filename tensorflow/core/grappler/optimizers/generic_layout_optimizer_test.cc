@@ -645,6 +645,68 @@ TEST_F(GenericLayoutOptimizerTest, CancelTransposeAroundPad) {
   test::ExpectTensorEqual<float>(tensors_expected[1], tensors[1]);
 }
 
+TEST_F(GenericLayoutOptimizerTest, CancelTransposePairOnCpuWithoutConversion) {
+  using test::function::NDef;
+
+  GenericLayoutOptimizer optimizer(
+      RewriterConfig::DEFAULT,
+      RewriterConfig::NO_CONVERSION_ON_CPU /* CPU settings*/);
+
+  const Tensor kPermuteNhwcToNchw = test::AsTensor<int32>({0, 3, 1, 2});
+  const Tensor kPermuteNchwToNhwc = test::AsTensor<int32>({0, 2, 3, 1});
+
+  GrapplerItem item;
+  item.graph = test::function::GDef({
+      NDef("x", "Placeholder", {}, {{"dtype", DT_FLOAT}}),
+
+      NDef("perm_nhwc_to_nchw", "Const", {},
+           {{"dtype", DT_INT32}, {"value", kPermuteNhwcToNchw}}),
+      NDef("perm_nchw_to_nhwc", "Const", {},
+           {{"dtype", DT_INT32}, {"value", kPermuteNchwToNhwc}}),
+
+      NDef("transpose_0", "Transpose", {"x", "perm_nhwc_to_nchw"},
+           {{"T", DT_FLOAT}, {"Tperm", DT_INT32}}),
+      NDef("transpose_1", "Transpose", {"transpose_0", "perm_nchw_to_nhwc"},
+           {{"T", DT_FLOAT}, {"Tperm", DT_INT32}}),
+      NDef("relu", "Relu", {"transpose_1"}, {{"T", DT_FLOAT}}),
+  });
+  item.fetch = {"relu"};
+
+  // Use a CPU only cluster so that no layout conversion takes place and the
+  // graph is only rewritten to cancel the transpose pair.
+  DeviceProperties cpu_device;
+  cpu_device.set_type("CPU");
+  VirtualCluster cpu_cluster({{"/CPU:0", cpu_device}});
+
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(&cpu_cluster, item, &output));
+
+  GraphDef expected = test::function::GDef({
+      NDef("x", "Placeholder", {}, {{"dtype", DT_FLOAT}}),
+
+      NDef("perm_nhwc_to_nchw", "Const", {},
+           {{"dtype", DT_INT32}, {"value", kPermuteNhwcToNchw}}),
+      NDef("perm_nchw_to_nhwc", "Const", {},
+           {{"dtype", DT_INT32}, {"value", kPermuteNchwToNhwc}}),
+
+      // Transpose nodes replaced by Identity nodes.
+      NDef("transpose_0", "Identity", {"x"}, {{"T", DT_FLOAT}}),
+      NDef("transpose_1", "Identity", {"transpose_0"}, {{"T", DT_FLOAT}}),
+      NDef("relu", "Relu", {"transpose_1"}, {{"T", DT_FLOAT}}),
+  });
+
+  CompareGraphs(expected, output);
+
+  Tensor x = GenerateRandomTensor<DT_FLOAT>({2, 6, 6, 8});
+  item.feed.emplace_back("x", x);
+  auto tensors_expected = EvaluateFetchNodes(item);
+  GrapplerItem optimized = item.WithGraph(std::move(output));
+  auto tensors = EvaluateFetchNodes(optimized);
+  ASSERT_EQ(tensors.size(), 1);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
+}
+
 TEST_F(GenericLayoutOptimizerTest, PreserveInputShapes) {
   using test::function::NDef;
 
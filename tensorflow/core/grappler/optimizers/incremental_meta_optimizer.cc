@@ -0,0 +1,235 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/incremental_meta_optimizer.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/transitive_fanin.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+namespace grappler {
+
+namespace {
+
+// Returns true if every input of every node resolves to a node in the graph.
+bool AllInputsResolve(const GraphDef& graph) {
+  std::unordered_set<string> names;
+  names.reserve(graph.node_size());
+  for (const NodeDef& node : graph.node()) {
+    names.insert(node.name());
+  }
+  for (const NodeDef& node : graph.node()) {
+    for (const string& input : node.input()) {
+      if (names.find(NodeName(input)) == names.end()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+IncrementalMetaOptimizer::IncrementalMetaOptimizer(DeviceBase* cpu_device,
+                                                   const ConfigProto& cfg)
+    : optimizer_(cpu_device, cfg) {}
+
+Status IncrementalMetaOptimizer::OptimizeFully(Cluster* cluster,
+                                               const GrapplerItem& item,
+                                               GraphDef* optimized_graph) {
+  last_run_was_incremental_ = false;
+  TF_RETURN_IF_ERROR(optimizer_.Optimize(cluster, item, optimized_graph));
+  cached_input_graph_ = item.graph;
+  cached_optimized_graph_ = *optimized_graph;
+  cached_fetch_ = item.fetch;
+  has_cached_result_ = true;
+  return OkStatus();
+}
+
+std::unordered_set<string> IncrementalMetaOptimizer::ComputeDirtyNodes(
+    const GraphDef& graph) const {
+  // Serialized comparison may flag a node whose attrs merely reserialized
+  // differently; that only costs extra work, never correctness.
+  absl::flat_hash_map<string, string> previous;
+  previous.reserve(cached_input_graph_.node_size());
+  for (const NodeDef& node : cached_input_graph_.node()) {
+    previous[node.name()] = node.SerializeAsString();
+  }
+  std::unordered_set<string> dirty;
+  for (const NodeDef& node : graph.node()) {
+    auto it = previous.find(node.name());
+    if (it == previous.end() || it->second != node.SerializeAsString()) {
+      dirty.insert(node.name());
+    }
+  }
+  return dirty;
+}
+
+Status IncrementalMetaOptimizer::Optimize(Cluster* cluster,
+                                          const GrapplerItem& item,
+                                          GraphDef* optimized_graph) {
+  last_dirty_node_count_ = 0;
+  if (!has_cached_result_ || item.fetch != cached_fetch_ ||
+      item.graph.library().SerializeAsString() !=
+          cached_input_graph_.library().SerializeAsString()) {
+    return OptimizeFully(cluster, item, optimized_graph);
+  }
+
+  const std::unordered_set<string> dirty = ComputeDirtyNodes(item.graph);
+  last_dirty_node_count_ = dirty.size();
+
+  std::unordered_set<string> previous_names;
+  previous_names.reserve(cached_input_graph_.node_size());
+  for (const NodeDef& node : cached_input_graph_.node()) {
+    previous_names.insert(node.name());
+  }
+  std::unordered_set<string> current_names;
+  current_names.reserve(item.graph.node_size());
+  for (const NodeDef& node : item.graph.node()) {
+    current_names.insert(node.name());
+  }
+  std::unordered_set<string> deleted_names;
+  for (const string& name : previous_names) {
+    if (current_names.find(name) == current_names.end()) {
+      deleted_names.insert(name);
+    }
+  }
+
+  if (dirty.empty() && deleted_names.empty()) {
+    // Nothing changed; serve the cache as-is.
+    *optimized_graph = cached_optimized_graph_;
+    last_run_was_incremental_ = true;
+    return OkStatus();
+  }
+  if (dirty.size() >
+      static_cast<double>(item.graph.node_size()) * kMaxDirtyFraction) {
+    return OptimizeFully(cluster, item, optimized_graph);
+  }
+
+  // Grow the dirty set by a few hops in both directions so fusions and
+  // rewrites that span the boundary of the change are re-examined.
+  ImmutableNodeMap node_map(&item.graph);
+  std::unordered_set<string> neighborhood = dirty;
+  std::vector<string> frontier(dirty.begin(), dirty.end());
+  for (int hop = 0; hop < kNeighborhoodHops && !frontier.empty(); ++hop) {
+    std::vector<string> next_frontier;
+    for (const string& name : frontier) {
+      const NodeDef* node = node_map.GetNode(name);
+      if (node == nullptr) continue;
+      for (const string& input : node->input()) {
+        const string input_name = NodeName(input);
+        if (neighborhood.insert(input_name).second) {
+          next_frontier.push_back(input_name);
+        }
+      }
+      for (const NodeDef* output : node_map.GetOutputs(name)) {
+        if (neighborhood.insert(output->name()).second) {
+          next_frontier.push_back(output->name());
+        }
+      }
+    }
+    frontier.swap(next_frontier);
+  }
+
+  // Close the neighborhood under fanin so every input inside the subgraph
+  // resolves, then pin nodes consumed from outside (and fetched nodes) as
+  // fetches so they survive optimization under their own names.
+  GraphDef subgraph;
+  std::vector<string> terminal_nodes(neighborhood.begin(), neighborhood.end());
+  Status fanin_status =
+      SetTransitiveFaninGraph(item.graph, &subgraph, terminal_nodes);
+  if (!fanin_status.ok()) {
+    return OptimizeFully(cluster, item, optimized_graph);
+  }
+  std::unordered_set<string> subgraph_names;
+  subgraph_names.reserve(subgraph.node_size());
+  for (const NodeDef& node : subgraph.node()) {
+    subgraph_names.insert(node.name());
+  }
+
+  std::unordered_set<string> boundary;
+  for (const string& fetch : item.fetch) {
+    if (subgraph_names.count(NodeName(fetch)) > 0) boundary.insert(fetch);
+  }
+  for (const NodeDef& node : item.graph.node()) {
+    if (subgraph_names.count(node.name()) > 0) continue;
+    for (const string& input : node.input()) {
+      const string input_name = NodeName(input);
+      if (subgraph_names.count(input_name) > 0) boundary.insert(input_name);
+    }
+  }
+
+  GrapplerItem sub_item = item.WithGraph(std::move(subgraph));
+  sub_item.fetch.assign(boundary.begin(), boundary.end());
+  sub_item.feed.clear();
+  for (const auto& feed : item.feed) {
+    if (subgraph_names.count(NodeName(feed.first)) > 0) {
+      sub_item.feed.push_back(feed);
+    }
+  }
+  sub_item.keep_ops.clear();
+  for (const string& keep : item.keep_ops) {
+    if (subgraph_names.count(keep) > 0) sub_item.keep_ops.push_back(keep);
+  }
+
+  GraphDef optimized_sub;
+  Status sub_status = optimizer_.Optimize(cluster, sub_item, &optimized_sub);
+  if (!sub_status.ok()) {
+    return OptimizeFully(cluster, item, optimized_graph);
+  }
+
+  // Splice the re-optimized subgraph into the cached optimized graph in place
+  // of the nodes it covered, dropping nodes deleted from the input. A name
+  // synthesized by this run that collides with a surviving cached node, or a
+  // dangling reference into the replaced region, forces a full optimization.
+  std::unordered_set<string> new_names;
+  new_names.reserve(optimized_sub.node_size());
+  for (const NodeDef& node : optimized_sub.node()) {
+    new_names.insert(node.name());
+  }
+
+  GraphDef merged;
+  *merged.mutable_versions() = item.graph.versions();
+  *merged.mutable_library() = optimized_sub.library();
+  for (const NodeDef& node : cached_optimized_graph_.node()) {
+    if (subgraph_names.count(node.name()) > 0) continue;
+    if (deleted_names.count(node.name()) > 0) continue;
+    if (new_names.count(node.name()) > 0) {
+      return OptimizeFully(cluster, item, optimized_graph);
+    }
+    *merged.add_node() = node;
+  }
+  for (const NodeDef& node : optimized_sub.node()) {
+    *merged.add_node() = node;
+  }
+  if (!AllInputsResolve(merged)) {
+    return OptimizeFully(cluster, item, optimized_graph);
+  }
+
+  *optimized_graph = std::move(merged);
+  cached_input_graph_ = item.graph;
+  cached_optimized_graph_ = *optimized_graph;
+  last_run_was_incremental_ = true;
+  return OkStatus();
+}
+
+}  // namespace grappler
+}  // namespace tensorflow
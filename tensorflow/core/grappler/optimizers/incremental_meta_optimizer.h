@@ -0,0 +1,92 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INCREMENTAL_META_OPTIMIZER_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INCREMENTAL_META_OPTIMIZER_H_
+
+#include <unordered_set>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/grappler/optimizers/meta_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Incremental front end for the MetaOptimizer, for callers that repeatedly
+// optimize small mutations of the same graph (e.g. dynamic graph stitching).
+//
+// The first call optimizes the full graph and caches both the input and the
+// result. Subsequent calls diff the new graph against the cached input,
+// expand the changed nodes by a few hops in both directions, re-run the
+// MetaOptimizer on just the transitive fanin of that dirty neighborhood (with
+// nodes consumed from outside pinned as fetches so they survive under their
+// own names), and splice the re-optimized subgraph into the cached optimized
+// graph in place of the nodes it covered.
+//
+// The class falls back to a full optimization whenever incrementality could
+// be unsound or unprofitable: on the first call, when fetches / feeds / the
+// function library changed, when too large a fraction of the graph is dirty,
+// when the spliced result has name collisions, or when it references nodes
+// that no longer exist.
+//
+// Not thread-safe: callers must serialize Optimize() calls, as each call
+// reads and replaces the cached graphs.
+class IncrementalMetaOptimizer {
+ public:
+  IncrementalMetaOptimizer(DeviceBase* cpu_device, const ConfigProto& cfg);
+
+  // Fraction of changed nodes above which a full optimization is cheaper than
+  // diffing, splicing and validating.
+  static constexpr double kMaxDirtyFraction = 0.25;
+
+  // Number of fanin/fanout hops by which changed nodes are expanded, so that
+  // patterns spanning the boundary of the change are still seen whole.
+  static constexpr int kNeighborhoodHops = 2;
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph);
+
+  // True if the most recent Optimize() call reused the cache; false if it ran
+  // a full optimization.
+  bool last_run_was_incremental() const { return last_run_was_incremental_; }
+
+  // Number of changed nodes detected by the most recent Optimize() call
+  // (before neighborhood expansion); zero for full runs.
+  int last_dirty_node_count() const { return last_dirty_node_count_; }
+
+ private:
+  // Runs a full optimization and replaces the cache.
+  Status OptimizeFully(Cluster* cluster, const GrapplerItem& item,
+                       GraphDef* optimized_graph);
+
+  // Returns the names of nodes in `item.graph` that are new or differ from
+  // the cached input graph.
+  std::unordered_set<string> ComputeDirtyNodes(const GraphDef& graph) const;
+
+  MetaOptimizer optimizer_;
+
+  bool has_cached_result_ = false;
+  GraphDef cached_input_graph_;
+  GraphDef cached_optimized_graph_;
+  std::vector<string> cached_fetch_;
+
+  bool last_run_was_incremental_ = false;
+  int last_dirty_node_count_ = 0;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_INCREMENTAL_META_OPTIMIZER_H_
@@ -0,0 +1,106 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/incremental_meta_optimizer.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+class IncrementalMetaOptimizerTest : public GrapplerTest {
+ protected:
+  // A small graph with a constant subexpression the meta optimizer folds.
+  GrapplerItem CreateItem(float scale_value) {
+    Scope s = Scope::NewRootScope();
+    auto x = ops::Const(s.WithOpName("x"), 3.0f, {2, 2});
+    auto scale = ops::Const(s.WithOpName("scale"), scale_value, {});
+    auto mul = ops::Mul(s.WithOpName("mul"), x, scale);
+    auto add = ops::Add(s.WithOpName("add"), mul, mul);
+    auto out = ops::Identity(s.WithOpName("out"), add);
+
+    GrapplerItem item;
+    item.fetch = {"out"};
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    return item;
+  }
+};
+
+TEST_F(IncrementalMetaOptimizerTest, ReusesCacheAcrossCalls) {
+  IncrementalMetaOptimizer optimizer(nullptr, ConfigProto());
+
+  GrapplerItem item = CreateItem(2.0f);
+  GraphDef first_output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &first_output));
+  EXPECT_FALSE(optimizer.last_run_was_incremental());
+
+  // An identical graph is served straight from the cache.
+  GraphDef second_output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &second_output));
+  EXPECT_TRUE(optimizer.last_run_was_incremental());
+  EXPECT_EQ(optimizer.last_dirty_node_count(), 0);
+  CompareGraphs(first_output, second_output);
+}
+
+TEST_F(IncrementalMetaOptimizerTest, ReoptimizesOnlyDirtyNeighborhood) {
+  IncrementalMetaOptimizer optimizer(nullptr, ConfigProto());
+
+  GrapplerItem item = CreateItem(2.0f);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  EXPECT_FALSE(optimizer.last_run_was_incremental());
+
+  // Change one constant; only its neighborhood needs re-optimization, and the
+  // spliced result must match a full optimization of the mutated graph.
+  GrapplerItem mutated_item = CreateItem(5.0f);
+  GraphDef incremental_output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, mutated_item, &incremental_output));
+  EXPECT_TRUE(optimizer.last_run_was_incremental());
+  EXPECT_EQ(optimizer.last_dirty_node_count(), 1);
+
+  IncrementalMetaOptimizer fresh_optimizer(nullptr, ConfigProto());
+  GraphDef full_output;
+  TF_ASSERT_OK(fresh_optimizer.Optimize(nullptr, mutated_item, &full_output));
+
+  auto incremental_tensors =
+      EvaluateNodes(incremental_output, mutated_item.fetch, {});
+  auto full_tensors = EvaluateNodes(full_output, mutated_item.fetch, {});
+  ASSERT_EQ(incremental_tensors.size(), 1);
+  ASSERT_EQ(full_tensors.size(), 1);
+  test::ExpectTensorEqual<float>(incremental_tensors[0], full_tensors[0]);
+}
+
+TEST_F(IncrementalMetaOptimizerTest, FallsBackWhenFetchChanges) {
+  IncrementalMetaOptimizer optimizer(nullptr, ConfigProto());
+
+  GrapplerItem item = CreateItem(2.0f);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  GrapplerItem refetched_item = item;
+  refetched_item.fetch = {"add"};
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, refetched_item, &output));
+  EXPECT_FALSE(optimizer.last_run_was_incremental());
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
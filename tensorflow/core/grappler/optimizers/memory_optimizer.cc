@@ -681,17 +681,10 @@ bool SchedulingPass(Cluster* cluster, std::unique_ptr<GraphMemory>* memory_ptr,
     for (const string& ctrl_dep : pre_ctrl_deps) {
       *tmp_var->add_input() = ctrl_dep;
     }
-    *tmp_var->add_input() =
-        AsControlDependency(NodeName(node->input(min_input_id)));
-
-    // Initialize it to zero
-    NodeDef* zeros = item->graph.add_node();
-    zeros->set_name(strings::StrCat(node->name(), "/tmp_var_zeros"));
-    zeros->set_op("ZerosLike");
-    zeros->set_device(device);
-    (*zeros->mutable_attr())["T"].set_type(dtype);
-    *zeros->add_input() = node->input(min_input_id);
 
+    // Initialize the variable with the topologically earliest input instead
+    // of zeros: this skips materializing a zero tensor and saves one full
+    // accumulation pass over the buffer.
     NodeDef* initialize = item->graph.add_node();
     initialize->set_name(strings::StrCat(node->name(), "/tmp_var_initializer"));
     initialize->set_op("Assign");
@@ -700,13 +693,13 @@ bool SchedulingPass(Cluster* cluster, std::unique_ptr<GraphMemory>* memory_ptr,
     (*initialize->mutable_attr())["use_locking"].set_b(false);
     (*initialize->mutable_attr())["validate_shape"].set_b(false);
     *initialize->add_input() = tmp_var->name();
-    *initialize->add_input() = zeros->name();
+    *initialize->add_input() = node->input(min_input_id);
 
-    // Add the assignadd nodes
+    // Add the assignadd nodes for the remaining inputs
     std::vector<NodeDef*> accumulates;
     for (int i = 0; i < node->input_size(); ++i) {
       const string& input = node->input(i);
-      if (!IsControlInput(input)) {
+      if (!IsControlInput(input) && i != min_input_id) {
         NodeDef* accumulate = item->graph.add_node();
         accumulate->set_name(
             strings::StrCat(node->name(), "/tmp_var_accum_", i));
@@ -421,6 +421,8 @@ TEST_F(MemoryOptimizerTest, AccumulationRewrites) {
       count++;
     } else if (node.name() == "d/tmp_var_initializer") {
       EXPECT_EQ("Assign", node.op());
+      // The variable is seeded with the first input, not with zeros.
+      EXPECT_EQ("a", node.input(1));
       count++;
     } else if (node.name() == "d/tmp_var") {
       EXPECT_EQ("TemporaryVariable", node.op());
@@ -430,6 +432,7 @@ TEST_F(MemoryOptimizerTest, AccumulationRewrites) {
       EXPECT_EQ("d", node.input(0));
       count++;
     }
+    EXPECT_NE("ZerosLike", node.op());
   }
   EXPECT_EQ(4, count);
 
@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/loop_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/memory_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/model_pruner.h"
+#include "tensorflow/core/grappler/optimizers/parallelism_advisor.h"
 #include "tensorflow/core/grappler/optimizers/pin_to_host_optimizer.h"
 #include "tensorflow/core/grappler/optimizers/remapper.h"
 #include "tensorflow/core/grappler/optimizers/scoped_allocator_optimizer.h"
@@ -256,6 +257,8 @@ std::unique_ptr<GraphOptimizer> MetaOptimizer::MakeNewOptimizer(
                                       cfg_.scoped_allocator_opts()));
   MK_OPT("pin_to_host", "pin_to_host_optimization",
          new PinToHostOptimizer(cfg_.pin_to_host_optimization()));
+  MK_OPT("parallelism_advisor", "parallelism_advisor",
+         new ParallelismAdvisor(cfg_.parallelism_advisor()));
 
   return std::unique_ptr<GraphOptimizer>();
 }
@@ -403,6 +406,8 @@ Status MetaOptimizer::InitializeOptimizers(
   else if (BOTH_ARE_EXPERIMENTAL_MLIR(pin_to_host_optimization) ||
            BOTH_ARE_EXPERIMENTAL_BOTH(pin_to_host_optimization))
     VLOG(2) << "pin_to_host_optimization is not implemented in TFG yet";
+  if (BOTH_ARE_ON(parallelism_advisor))
+    optimizers->push_back(MakeUnique<ParallelismAdvisor>());
   if (BOTH_NOT_OFF(arithmetic_optimization)) {
     if (USER_IS_EXPERIMENTAL_MLIR(arithmetic_optimization) ||
         USER_IS_EXPERIMENTAL_BOTH(arithmetic_optimization)) {
@@ -625,6 +630,7 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
     PRINT_CFG(constant_folding)
     PRINT_CFG(shape_optimization)
     PRINT_CFG(pin_to_host_optimization)
+    PRINT_CFG(parallelism_advisor)
     PRINT_CFG(layout_optimizer)
     PRINT_CFG(remapping)
     PRINT_CFG(loop_optimization)
@@ -678,6 +684,7 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
       PRINT_CFG("auto_mixed_precision_mkl", "auto_mixed_precision_mkl")
       PRINT_CFG("auto_mixed_precision_cpu", "auto_mixed_precision_cpu")
       PRINT_CFG("pin_to_host", "pin_to_host_optimization")
+      PRINT_CFG("parallelism_advisor", "parallelism_advisor")
       PRINT_CFG("layout", "layout_optimizer")
       PRINT_CFG("remap", "remapping")
       PRINT_CFG("loop", "loop_optimization")
@@ -719,6 +726,7 @@ void MetaOptimizer::PrintUserAndPluginConfigs(
         pair.first == "auto_mixed_precision_mkl" ||
         pair.first == "auto_mixed_precision_cpu" ||
         pair.first == "pin_to_host_optimization" ||
+        pair.first == "parallelism_advisor" ||
         pair.first == "scoped_allocator_optimization") {
       // These optimizers are turned off by default.
       // TODO(penporn): Remove the hard-coded length and change it to max length
@@ -0,0 +1,151 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/parallelism_advisor.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/step_stats.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/virtual_placer.h"
+#include "tensorflow/core/grappler/costs/virtual_scheduler.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/topological_sort.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+Status ParallelismAdvisor::Optimize(Cluster* cluster, const GrapplerItem& item,
+                                    GraphDef* optimized_graph) {
+  if (cluster == nullptr || cluster->GetDevices().empty()) {
+    return errors::Aborted(
+        "Parallelism advisor requires a cluster with known devices.");
+  }
+
+  // Simulate one step of the graph on the virtual devices.
+  std::unique_ptr<ReadyNodeManager> node_manager =
+      ReadyNodeManagerFactory("FirstReady");
+  VirtualScheduler scheduler(
+      /*use_static_shapes=*/true, /*use_aggressive_shape_inference=*/true,
+      cluster, node_manager.get(),
+      std::make_unique<VirtualPlacer>(cluster->GetDevices()));
+  Status status = scheduler.Init(&item);
+  if (!status.ok()) {
+    return errors::Aborted("Failed to simulate the graph: ",
+                           status.error_message());
+  }
+
+  OpLevelCostEstimator cost_estimator;
+  Costs node_costs;
+  do {
+    OpContext op_context = scheduler.GetCurrNode();
+    node_costs = cost_estimator.PredictCosts(op_context);
+  } while (scheduler.MarkCurrNodeExecuted(node_costs));
+
+  RunMetadata metadata;
+  scheduler.Summary(&metadata);
+
+  // Pull per-node simulated durations off the virtual timeline and total up
+  // the work placed on CPU devices.
+  absl::flat_hash_map<string, int64_t> duration_micros;
+  int64_t cpu_work_micros = 0;
+  for (const DeviceStepStats& dev_stats : metadata.step_stats().dev_stats()) {
+    const bool on_cpu = dev_stats.device().find("CPU") != string::npos ||
+                        dev_stats.device().find("cpu") != string::npos;
+    for (const NodeExecStats& node_stats : dev_stats.node_stats()) {
+      duration_micros[node_stats.node_name()] = node_stats.op_end_rel_micros();
+      if (on_cpu) cpu_work_micros += node_stats.op_end_rel_micros();
+    }
+  }
+
+  // Compute every node's critical-path tail time: its own duration plus the
+  // longest chain of dependent work after it. Consumers are processed before
+  // their producers (reverse topological order), so each node's downstream
+  // tail is final when the node is reached.
+  *optimized_graph = item.graph;
+  std::vector<const NodeDef*> topo_order;
+  TF_RETURN_IF_ERROR(ComputeTopologicalOrder(*optimized_graph, &topo_order));
+
+  NodeMap node_map(optimized_graph);
+  absl::flat_hash_map<const NodeDef*, int64_t> tail_micros;
+  int64_t critical_path_micros = 0;
+  for (auto it = topo_order.rbegin(); it != topo_order.rend(); ++it) {
+    const NodeDef* node = *it;
+    int64_t duration = 0;
+    auto duration_it = duration_micros.find(node->name());
+    if (duration_it != duration_micros.end()) duration = duration_it->second;
+    const int64_t tail = tail_micros[node] + duration;
+    tail_micros[node] = tail;
+    critical_path_micros = std::max(critical_path_micros, tail);
+    for (const string& input : node->input()) {
+      NodeDef* input_node = node_map.GetNode(NodeName(input));
+      if (input_node == nullptr) continue;
+      tail_micros[input_node] = std::max(tail_micros[input_node], tail);
+    }
+  }
+
+  // The step cannot finish faster than the critical path, so the inter-op
+  // pool only profits from work / span threads (the average parallelism of
+  // the dependency structure); the remaining cores are better spent inside
+  // kernels. Note that per-device serialization in the virtual schedule does
+  // not limit this measure, as it is derived from dependencies alone.
+  int64_t num_cpu_cores = 0;
+  for (const auto& device_and_properties : cluster->GetDevices()) {
+    if (device_and_properties.second.type() == "CPU") {
+      num_cpu_cores += device_and_properties.second.num_cores();
+    }
+  }
+  int64_t average_parallelism = 1;
+  if (critical_path_micros > 0) {
+    average_parallelism =
+        (cpu_work_micros + critical_path_micros - 1) / critical_path_micros;
+  }
+  recommended_inter_op_parallelism_ =
+      std::max<int64_t>(1, average_parallelism);
+  if (num_cpu_cores > 0) {
+    recommended_inter_op_parallelism_ =
+        std::min<int64_t>(recommended_inter_op_parallelism_, num_cpu_cores);
+    recommended_intra_op_parallelism_ = std::max<int64_t>(
+        1, num_cpu_cores / recommended_inter_op_parallelism_);
+  } else {
+    recommended_intra_op_parallelism_ = 1;
+  }
+  LOG(INFO) << "Parallelism advisor: recommended inter-op parallelism "
+            << recommended_inter_op_parallelism_ << ", intra-op parallelism "
+            << recommended_intra_op_parallelism_ << " (simulated CPU work "
+            << cpu_work_micros << "us, critical path " << critical_path_micros
+            << "us, " << num_cpu_cores << " cores).";
+
+  // Annotate nodes with their tail times so the executor can favor the
+  // critical path when several expensive nodes are ready at once.
+  for (const auto& node_and_tail : tail_micros) {
+    if (node_and_tail.second <= 0) continue;
+    NodeDef* node = node_map.GetNode(node_and_tail.first->name());
+    (*node->mutable_attr())[kSchedulingPriorityAttr].set_i(
+        node_and_tail.second);
+  }
+
+  return OkStatus();
+}
+
+}  // end namespace grappler
+}  // end namespace tensorflow
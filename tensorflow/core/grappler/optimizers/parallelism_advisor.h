@@ -0,0 +1,79 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_PARALLELISM_ADVISOR_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_PARALLELISM_ADVISOR_H_
+
+#include "tensorflow/core/grappler/optimizers/graph_optimizer.h"
+#include "tensorflow/core/protobuf/rewriter_config.pb.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// Attribute written on every node with an estimated execution cost. Its value
+// is the critical-path tail time of the node in microseconds, i.e. the
+// simulated time from the start of the node to the end of the step along the
+// longest dependent chain. The executor uses it as a scheduling priority:
+// among ready expensive nodes, the one with the largest tail time is kept on
+// the current thread so the critical path is never parked behind pool
+// dispatch latency.
+constexpr char kSchedulingPriorityAttr[] = "_scheduling_priority";
+
+// Simulates one step of the graph with the virtual scheduler and the
+// analytical op-level cost model, then feeds the result back into runtime
+// scheduling:
+//
+//  * every scheduled node is annotated with kSchedulingPriorityAttr; and
+//  * the peak number of concurrently executing CPU ops observed on the
+//    virtual timeline is reported as the recommended inter-op parallelism
+//    (with the remaining cores going to intra-op), so sessions do not have to
+//    hand-tune inter_op_parallelism_threads per model.
+//
+// Thread pools are sized before any graph is seen, so the pool split is
+// surfaced through the log and recommended_inter_op_parallelism() rather than
+// applied in place. The pass needs a cluster with known devices and does
+// nothing (returns errors::Aborted) without one.
+class ParallelismAdvisor : public GraphOptimizer {
+ public:
+  ParallelismAdvisor() {}
+  explicit ParallelismAdvisor(RewriterConfig::Toggle opt_level) {}
+
+  ~ParallelismAdvisor() override {}
+
+  string name() const override { return "parallelism_advisor"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* optimized_graph) override;
+
+  // Recommendation computed by the most recent successful Optimize() call, or
+  // 0 if Optimize() has not run.
+  int recommended_inter_op_parallelism() const {
+    return recommended_inter_op_parallelism_;
+  }
+  int recommended_intra_op_parallelism() const {
+    return recommended_intra_op_parallelism_;
+  }
+
+ private:
+  int recommended_inter_op_parallelism_ = 0;
+  int recommended_intra_op_parallelism_ = 0;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_PARALLELISM_ADVISOR_H_
@@ -0,0 +1,109 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/parallelism_advisor.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/grappler/clusters/virtual_cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+class ParallelismAdvisorTest : public GrapplerTest {
+ protected:
+  void SetUp() override {
+    std::unordered_map<string, DeviceProperties> devices;
+    DeviceProperties cpu_device;
+    cpu_device.set_type("CPU");
+    cpu_device.set_num_cores(4);
+    cpu_device.set_frequency(2600);
+    cpu_device.set_bandwidth(24 * 1024 * 1024);
+    devices["/job:localhost/replica:0/task:0/cpu:0"] = cpu_device;
+    cluster_.reset(new VirtualCluster(devices));
+  }
+
+  // Two independent MatMul chains joined by an Add.
+  GrapplerItem CreateItem() {
+    Scope s = Scope::NewRootScope();
+    auto a = ops::RandomUniform(s.WithOpName("a"), {256, 256}, DT_FLOAT);
+    auto b = ops::RandomUniform(s.WithOpName("b"), {256, 256}, DT_FLOAT);
+    auto matmul1 = ops::MatMul(s.WithOpName("matmul1"), a, a);
+    auto matmul2 = ops::MatMul(s.WithOpName("matmul2"), matmul1, a);
+    auto matmul3 = ops::MatMul(s.WithOpName("matmul3"), b, b);
+    auto add = ops::Add(s.WithOpName("add"), matmul2, matmul3);
+
+    GrapplerItem item;
+    item.fetch = {"add"};
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    return item;
+  }
+
+  std::unique_ptr<VirtualCluster> cluster_;
+};
+
+TEST_F(ParallelismAdvisorTest, AnnotatesSchedulingPriorities) {
+  GrapplerItem item = CreateItem();
+
+  ParallelismAdvisor optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(cluster_.get(), item, &output));
+
+  std::unordered_map<string, int64_t> priorities;
+  for (const NodeDef& node : output.node()) {
+    auto it = node.attr().find(kSchedulingPriorityAttr);
+    if (it != node.attr().end()) {
+      priorities[node.name()] = it->second.i();
+    }
+  }
+
+  // Every node with simulated cost feeds the fetch node, so all of them carry
+  // a tail time.
+  for (const char* name : {"matmul1", "matmul2", "matmul3", "add"}) {
+    ASSERT_TRUE(priorities.count(name) > 0) << name;
+    EXPECT_GT(priorities[name], 0) << name;
+  }
+
+  // Tail times may not increase along an edge: a producer's remaining work
+  // includes its consumer's.
+  EXPECT_GE(priorities["matmul1"], priorities["matmul2"]);
+  EXPECT_GE(priorities["matmul2"], priorities["add"]);
+  EXPECT_GE(priorities["matmul3"], priorities["add"]);
+  // The two-matmul chain has more work behind it than the single matmul.
+  EXPECT_GT(priorities["matmul1"], priorities["matmul3"]);
+
+  // The recommendation is filled in and bounded by the core count.
+  EXPECT_GE(optimizer.recommended_inter_op_parallelism(), 1);
+  EXPECT_LE(optimizer.recommended_inter_op_parallelism(), 4);
+  EXPECT_GE(optimizer.recommended_intra_op_parallelism(), 1);
+  EXPECT_LE(optimizer.recommended_intra_op_parallelism(), 4);
+}
+
+TEST_F(ParallelismAdvisorTest, RequiresCluster) {
+  GrapplerItem item = CreateItem();
+
+  ParallelismAdvisor optimizer;
+  GraphDef output;
+  const Status status = optimizer.Optimize(nullptr, item, &output);
+  EXPECT_EQ(status.code(), error::ABORTED);
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/remapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include "absl/container/flat_hash_set.h"
@@ -62,6 +63,8 @@ namespace grappler {
 //
 // Sigmoid + Mul -> _MklSwish  // This fusion only works on Intel CPU.
 //
+// Chains of unary / scalar-binary cwise ops -> _FusedCwiseChain  // CPU only.
+//
 //
 // In all cases, the supported activation functions are Relu, Relu6, and Elu.
 //
@@ -76,6 +79,7 @@ constexpr char kFusedDepthwiseConv2dNative[] = "_FusedDepthwiseConv2dNative";
 constexpr char kFusedBatchNormEx[] = "_FusedBatchNormEx";
 constexpr char kFusedBatchNormGradEx[] = "_FusedBatchNormGradEx";
 constexpr char kTensorToHashBucket[] = "_TensorToHashBucketFast";
+constexpr char kFusedCwiseChain[] = "_FusedCwiseChain";
 
 constexpr char kDataFormat[] = "data_format";
 constexpr char kIsTraining[] = "is_training";
@@ -146,6 +150,18 @@ struct TensorToHashBucket {
   int string_to_hash_bucket = kMissingIndex;
 };
 
+// Linear chain of unary and scalar-binary element-wise ops that can be
+// collapsed into a single _FusedCwiseChain node.
+struct CwiseChain {
+  // Node indices in execution order: nodes.front() consumes the chain's
+  // external input, nodes.back() is the root whose fanouts survive the fusion.
+  std::vector<int> nodes;
+  // For each entry in `nodes`, the input port carrying the chained value
+  // (always 0 for unary ops; 0 or 1 for binary ops, the other port being a
+  // scalar constant).
+  std::vector<int> chain_ports;
+};
+
 // Pad followed by Conv3D/FusedConv3D
 struct PadWithConv3D {
   PadWithConv3D() = default;
@@ -1406,6 +1422,509 @@ bool FindMatMulBiasAddAndGelu(RemapperContext* ctx, int node_index,
   return (found_gelu_exact || found_gelu_approximate);
 }
 
+// Finds a gelu-subgraph that is not preceded by a contraction the
+// MatMul+BiasAdd+Gelu fusion can absorb, e.g. when gelu follows an Add or a
+// LayerNorm. The subgraph is collapsed into the standalone _FusedGelu op,
+// which is implemented on CPU only.
+bool FindGelu(RemapperContext* ctx, int node_index,
+              std::map<string, int>* matched_nodes_map,
+              std::set<int>* remove_node_indices, bool* is_gelu_approximate) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+
+  // clang-format off
+  utils::OpTypePattern gelu_exact_pattern =
+    {"Mul", "output", NodeStatus::kReplace,
+      {
+        {"Mul", "erf_plus_one_times_one_half", NodeStatus::kRemove,
+          {
+            {"AddV2", "erf_plus_one", NodeStatus::kRemove,
+              {
+                {"Erf", "erf", NodeStatus::kRemove,
+                  {
+                    {"Mul", "input_times_square_root_one_half",
+                     NodeStatus::kRemove,
+                      {
+                        {"*", "input", NodeStatus::kRemain},
+                        {"Const", "square_root_one_half", NodeStatus::kRemain}
+                      }
+                    }
+                  }
+                },
+                {"Const", "one", NodeStatus::kRemain}
+              }
+            },
+            {"Const", "one_half", NodeStatus::kRemain}
+          }
+        },
+        {"*", "input", NodeStatus::kRemain}
+      }
+    };
+
+  utils::OpTypePattern gelu_approximate_pattern =
+    {"Mul", "output", NodeStatus::kReplace,
+      {
+        {"Mul", "tanh_plus_one_times_one_half", NodeStatus::kRemove,
+          {
+            {"AddV2", "tanh_plus_one", NodeStatus::kRemove,
+              {
+                {"Tanh", "tanh", NodeStatus::kRemove,
+                  {
+                    {"Mul", "input_plus_mul_times_square_root_two_over_pi",
+                     NodeStatus::kRemove,
+                      {
+                        {"AddV2", "input_plus_mul", NodeStatus::kRemove,
+                          {
+                            {"*", "input", NodeStatus::kRemain},
+                            {"Mul", "mul", NodeStatus::kRemove,
+                              {
+                                {"Pow", "pow", NodeStatus::kRemove,
+                                  {
+                                    {"*", "input", NodeStatus::kRemain},
+                                    {"Const", "three", NodeStatus::kRemain}
+                                  }
+                                },
+                                {"Const", "empirical_const",
+                                 NodeStatus::kRemain}
+                              }
+                            }
+                          }
+                        },
+                        {"Const", "square_root_two_over_pi",
+                         NodeStatus::kRemain}
+                      }
+                    }
+                  }
+                },
+                {"Const", "one", NodeStatus::kRemain}
+              }
+            },
+            {"Const", "one_half", NodeStatus::kRemain}
+          }
+        },
+        {"*", "input", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  auto* node_view = ctx->graph_view.GetNode(node_index);
+
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  bool found_gelu_exact =
+      graph_matcher.GetMatchedNodes(gelu_exact_pattern, ctx->nodes_to_preserve,
+                                    node_view, matched_nodes_map,
+                                    remove_node_indices);
+  bool found_gelu_approximate = false;
+  if (!found_gelu_exact) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    found_gelu_approximate = graph_matcher.GetMatchedNodes(
+        gelu_approximate_pattern, ctx->nodes_to_preserve, node_view,
+        matched_nodes_map, remove_node_indices);
+  }
+  if (!found_gelu_exact && !found_gelu_approximate) return false;
+
+  // The standalone kernel is CPU only; on GPU the gelu-subgraph is fused
+  // into the preceding contraction instead.
+  NodeDef* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  if (!NodeIsOnCpu(output_node)) return false;
+  if (!HasDataType(output_node, DT_FLOAT) &&
+      !HasDataType(output_node, DT_BFLOAT16))
+    return false;
+
+  // Check if the matched constants have desired values.
+  std::map<string, float> values_map = {{"one", 1.0}, {"one_half", 0.5}};
+  if (found_gelu_exact) {
+    values_map["square_root_one_half"] = 0.707106;
+  } else {
+    values_map["square_root_two_over_pi"] = 0.797884;
+    values_map["empirical_const"] = 0.044715;
+    values_map["three"] = 3.0;
+  }
+  if (!VerifyConstants(ctx, matched_nodes_map, &values_map)) return false;
+
+  *is_gelu_approximate = found_gelu_approximate;
+  return true;
+}
+
+// Keras layer normalization, when it cannot use the fused batch-norm based
+// decomposition handled by FindMklLayerNorm, lowers to two Mean reductions, a
+// SquaredDifference, a Rsqrt and a handful of elementwise ops:
+//
+//   mean = Mean(x); var = Mean(SquaredDifference(x, StopGradient?(mean)))
+//   inv  = Mul(Rsqrt(AddV2(var, epsilon)), gamma)
+//   y    = AddV2(Mul(inv, x), Sub(beta, Mul(mean, inv)))
+//
+// The whole subgraph is collapsed into the single-pass _FusedLayerNorm
+// kernel, which is implemented on CPU only.
+bool FindFusedLayerNorm(RemapperContext* ctx, int node_index,
+                        std::map<string, int>* matched_nodes_map,
+                        std::set<int>* remove_node_indices) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+
+  // clang-format off
+  utils::OpTypePattern mean_pattern =
+    {"Mean", "mean", NodeStatus::kRemove,
+      {
+        {"*", "input", NodeStatus::kRemain},
+        {"Const", "mean_axes", NodeStatus::kRemain}
+      }
+    };
+
+  // tf.nn.moments emits a StopGradient between the mean and the
+  // SquaredDifference; it may have been pruned by the time the remapper
+  // runs, so both forms are matched.
+  utils::OpTypePattern variance_pattern =
+    {"Mean", "variance", NodeStatus::kRemove,
+      {
+        {"SquaredDifference", "squared_difference", NodeStatus::kRemove,
+          {
+            {"*", "input", NodeStatus::kRemain},
+            mean_pattern
+          }
+        },
+        {"Const", "variance_axes", NodeStatus::kRemain}
+      }
+    };
+  utils::OpTypePattern variance_with_stop_grad_pattern =
+    {"Mean", "variance", NodeStatus::kRemove,
+      {
+        {"SquaredDifference", "squared_difference", NodeStatus::kRemove,
+          {
+            {"*", "input", NodeStatus::kRemain},
+            {"StopGradient", "stop_gradient", NodeStatus::kRemove,
+              {
+                mean_pattern
+              }
+            }
+          }
+        },
+        {"Const", "variance_axes", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  auto make_layer_norm_pattern = [](const utils::OpTypePattern& variance) {
+    using utils::NodeStatus;
+    // clang-format off
+    return utils::OpTypePattern
+      {"AddV2", "output", NodeStatus::kReplace,
+        {
+          {"Mul", "input_times_scaled_rsqrt", NodeStatus::kRemove,
+            {
+              {"Mul", "scaled_rsqrt", NodeStatus::kRemove,
+                {
+                  {"Rsqrt", "rsqrt", NodeStatus::kRemove,
+                    {
+                      {"AddV2", "variance_plus_epsilon", NodeStatus::kRemove,
+                        {
+                          variance,
+                          {"Const", "epsilon", NodeStatus::kRemain}
+                        }
+                      }
+                    }
+                  },
+                  {"*", "gamma", NodeStatus::kRemain}
+                }
+              },
+              {"*", "input", NodeStatus::kRemain}
+            }
+          },
+          {"Sub", "beta_minus_scaled_mean", NodeStatus::kRemove,
+            {
+              {"*", "beta", NodeStatus::kRemain},
+              {"Mul", "scaled_mean", NodeStatus::kRemove,
+                {
+                  {"Mean", "mean", NodeStatus::kRemove},
+                  {"Mul", "scaled_rsqrt", NodeStatus::kRemove}
+                }
+              }
+            }
+          }
+        }
+      };
+    // clang-format on
+  };
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  bool found_op_type_match = false;
+  for (const utils::OpTypePattern& variance :
+       {variance_pattern, variance_with_stop_grad_pattern}) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    utils::OpTypePattern layer_norm_pattern =
+        make_layer_norm_pattern(variance);
+    if (graph_matcher.GetMatchedNodes(
+            layer_norm_pattern, ctx->nodes_to_preserve,
+            ctx->graph_view.GetNode(node_index), matched_nodes_map,
+            remove_node_indices)) {
+      found_op_type_match = true;
+      break;
+    }
+  }
+  if (!found_op_type_match) return false;
+
+  NodeDef* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  if (!NodeIsOnCpu(output_node)) return false;
+  if (!HasDataType(output_node, DT_FLOAT) &&
+      !HasDataType(output_node, DT_BFLOAT16))
+    return false;
+
+  // Both reductions must keep the reduced dimension, otherwise the
+  // broadcasts in the matched subgraph would not line up.
+  for (const char* label : {"mean", "variance"}) {
+    NodeDef* node =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    bool keep_dims = false;
+    if (!TryGetNodeAttr(*node, "keep_dims", &keep_dims) || !keep_dims)
+      return false;
+  }
+
+  // Epsilon must be a scalar constant so it can be folded into the fused
+  // node's attribute.
+  NodeDef* epsilon_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("epsilon"))->node();
+  Tensor epsilon_tensor;
+  if (epsilon_node->op() != "Const" ||
+      !epsilon_tensor.FromProto(epsilon_node->attr().at("value").tensor()) ||
+      epsilon_tensor.NumElements() != 1 ||
+      epsilon_tensor.dtype() != DT_FLOAT) {
+    return false;
+  }
+
+  // The kernel only supports normalization over the innermost dimension with
+  // 1D scale and offset, so the shapes need to be checked statically.
+  if (!ctx->inferred_graph_properties) {
+    Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/true,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/true,
+        /*include_output_tensor_values=*/false);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+  NodeDef* input_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("input"))->node();
+  auto input_props =
+      ctx->graph_properties.GetOutputProperties(input_node->name());
+  if (input_props.empty()) return false;
+  const TensorShapeProto& input_shape = input_props[0].shape();
+  if (input_shape.unknown_rank()) return false;
+  const int rank = Rank(input_shape);
+  if (rank < 2 || !IsKnown(input_shape.dim(rank - 1))) return false;
+  const int64_t last_dim = input_shape.dim(rank - 1).size();
+
+  auto is_innermost_axes = [&](const char* label) -> bool {
+    NodeDef* axes_node =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    Tensor axes_tensor;
+    if (axes_node->op() != "Const" ||
+        !axes_tensor.FromProto(axes_node->attr().at("value").tensor()) ||
+        axes_tensor.NumElements() != 1) {
+      return false;
+    }
+    int64_t axis;
+    if (axes_tensor.dtype() == DT_INT32) {
+      axis = axes_tensor.flat<int32>()(0);
+    } else if (axes_tensor.dtype() == DT_INT64) {
+      axis = axes_tensor.flat<int64_t>()(0);
+    } else {
+      return false;
+    }
+    return axis == -1 || axis == rank - 1;
+  };
+  if (!is_innermost_axes("mean_axes") || !is_innermost_axes("variance_axes"))
+    return false;
+
+  for (const char* label : {"gamma", "beta"}) {
+    NodeDef* node =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    auto props = ctx->graph_properties.GetOutputProperties(node->name());
+    if (props.empty()) return false;
+    const TensorShapeProto& shape = props[0].shape();
+    if (Rank(shape) != 1 || !IsKnown(shape.dim(0)) ||
+        shape.dim(0).size() != last_dim) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Finds the scaled dot-product attention block
+//
+//   BatchMatMulV2(Softmax(Mul?(BatchMatMulV2(q, k, adj_y=true), scale)), v)
+//
+// so it can be collapsed into the tiled _FusedAttention kernel, which never
+// materializes the [batch, heads, seq, seq] score matrix. The optional Mul
+// carries the 1/sqrt(depth) scaling; its constant is folded into the fused
+// node's attribute.
+bool FindFusedAttention(RemapperContext* ctx, int node_index,
+                        std::map<string, int>* matched_nodes_map,
+                        std::set<int>* remove_node_indices) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+
+  // clang-format off
+  utils::OpTypePattern scores_pattern =
+    {"BatchMatMulV2", "scores", NodeStatus::kRemove,
+      {
+        {"*", "query", NodeStatus::kRemain},
+        {"*", "key", NodeStatus::kRemain}
+      }
+    };
+
+  utils::OpTypePattern scaled_attention_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul", "scaled_scores", NodeStatus::kRemove,
+              {
+                scores_pattern,
+                {"Const", "scale", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  utils::OpTypePattern unscaled_attention_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            scores_pattern
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  bool found_op_type_match = false;
+  for (const utils::OpTypePattern& attention_pattern :
+       {scaled_attention_pattern, unscaled_attention_pattern}) {
+    matched_nodes_map->clear();
+    remove_node_indices->clear();
+    if (graph_matcher.GetMatchedNodes(
+            attention_pattern, ctx->nodes_to_preserve,
+            ctx->graph_view.GetNode(node_index), matched_nodes_map,
+            remove_node_indices)) {
+      found_op_type_match = true;
+      break;
+    }
+  }
+  if (!found_op_type_match) return false;
+
+  NodeDef* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  if (!NodeIsOnCpu(output_node)) return false;
+  if (!HasDataType(output_node, DT_FLOAT) &&
+      !HasDataType(output_node, DT_BFLOAT16))
+    return false;
+
+  // The kernel computes q x k^T and softmax x v in their natural layouts.
+  auto get_bool_attr = [](const NodeDef& node, const char* name) {
+    bool value = false;
+    TryGetNodeAttr(node, name, &value);
+    return value;
+  };
+  NodeDef* scores_node =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scores"))->node();
+  if (get_bool_attr(*scores_node, "adj_x") ||
+      !get_bool_attr(*scores_node, "adj_y"))
+    return false;
+  if (get_bool_attr(*output_node, "adj_x") ||
+      get_bool_attr(*output_node, "adj_y"))
+    return false;
+
+  // The scaling factor must be a scalar constant so it can be folded into
+  // the fused node's attribute.
+  if (matched_nodes_map->count("scale") > 0) {
+    NodeDef* scale_node =
+        ctx->graph_view.GetNode(matched_nodes_map->at("scale"))->node();
+    Tensor scale_tensor;
+    if (scale_node->op() != "Const" ||
+        !scale_tensor.FromProto(scale_node->attr().at("value").tensor()) ||
+        scale_tensor.NumElements() != 1 ||
+        scale_tensor.dtype() != DT_FLOAT) {
+      return false;
+    }
+  }
+
+  // The kernel does not broadcast leading dimensions, so query, key and
+  // value must agree on them statically.
+  if (!ctx->inferred_graph_properties) {
+    Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/true,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/true,
+        /*include_output_tensor_values=*/false);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+  auto get_shape = [&](const char* label, TensorShapeProto* shape) {
+    NodeDef* node =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    auto props = ctx->graph_properties.GetOutputProperties(node->name());
+    if (props.empty()) return false;
+    *shape = props[0].shape();
+    return !shape->unknown_rank();
+  };
+  TensorShapeProto query_shape;
+  TensorShapeProto key_shape;
+  TensorShapeProto value_shape;
+  if (!get_shape("query", &query_shape) || !get_shape("key", &key_shape) ||
+      !get_shape("value", &value_shape)) {
+    return false;
+  }
+  const int rank = Rank(query_shape);
+  if (rank < 3 || Rank(key_shape) != rank || Rank(value_shape) != rank)
+    return false;
+  auto dims_equal = [](const TensorShapeProto& a, const TensorShapeProto& b,
+                       int a_index, int b_index) {
+    TensorShapeProto a_dim;
+    *a_dim.add_dim() = a.dim(a_index);
+    TensorShapeProto b_dim;
+    *b_dim.add_dim() = b.dim(b_index);
+    return ShapesSymbolicallyEqual(a_dim, b_dim);
+  };
+  for (int i = 0; i < rank - 2; ++i) {
+    if (!dims_equal(query_shape, key_shape, i, i) ||
+        !dims_equal(query_shape, value_shape, i, i)) {
+      return false;
+    }
+  }
+  // Query and key must agree on the depth, key and value on the row count.
+  if (!dims_equal(query_shape, key_shape, rank - 1, rank - 1)) return false;
+  if (!dims_equal(key_shape, value_shape, rank - 2, rank - 2)) return false;
+  return true;
+}
+
+// Finds a SparseSoftmaxCrossEntropyWithLogits node whose backprop output has
+// no consumers, as in forward-only graphs. Such a node can be replaced with
+// the loss-only _SparseSoftmaxCrossEntropyLoss, which streams over the
+// logits without materializing the probability matrix.
+bool FindSparseXentLossOnly(RemapperContext* ctx, int node_index) {
+  const auto* node_view = ctx->graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+  if (node_def->op() != "SparseSoftmaxCrossEntropyWithLogits") return false;
+  if (!NodeIsOnCpu(node_def)) return false;
+  // A preserved node may be fetched through its backprop output.
+  if (ctx->nodes_to_preserve.count(node_def->name()) > 0) return false;
+  return node_view->GetRegularFanout(1).empty();
+}
+
 bool FindMulAndMaximum(RemapperContext* ctx, int node_index,
                        std::map<string, int>* matched_nodes_map,
                        std::set<int>* remove_node_indices) {
@@ -2062,6 +2581,109 @@ bool FindTensorToHashBucket(const RemapperContext& ctx, int node_index,
   return true;
 }
 
+// Ops that _FusedCwiseChain can interpret as a unary stage. Must be kept in
+// sync with the kernel in core/kernels/fused_cwise_chain_op.cc.
+bool IsFusibleUnaryCwise(const NodeDef& node) {
+  static const auto* const kUnaryOps = new absl::flat_hash_set<string>{
+      "Abs",   "Ceil",  "Exp",     "Floor", "Log",    "Neg",  "Relu",
+      "Relu6", "Rsqrt", "Sigmoid", "Sqrt",  "Square", "Tanh"};
+  return kUnaryOps->contains(node.op());
+}
+
+// Ops that _FusedCwiseChain can interpret as a binary stage combining the
+// chained value with a scalar constant.
+bool IsFusibleBinaryCwise(const NodeDef& node) {
+  static const auto* const kBinaryOps = new absl::flat_hash_set<string>{
+      "Add", "AddV2", "Sub", "Mul", "Div", "RealDiv", "Maximum", "Minimum"};
+  return kBinaryOps->contains(node.op());
+}
+
+// Returns true if the node is a Const holding exactly one element.
+bool IsScalarConst(const NodeDef& node) {
+  if (!IsConstant(node)) return false;
+  auto it = node.attr().find("value");
+  if (it == node.attr().end()) return false;
+  const TensorShapeProto& shape = it->second.tensor().tensor_shape();
+  if (shape.unknown_rank()) return false;
+  int64_t num_elements = 1;
+  for (const auto& dim : shape.dim()) {
+    if (dim.size() < 0) return false;
+    num_elements *= dim.size();
+  }
+  return num_elements == 1;
+}
+
+// Walks up from the root at `node_index` collecting the longest linear chain
+// of fusible element-wise ops. Only the root may have extra consumers; every
+// other chain member feeds the next one exclusively. Matches chains of at
+// least three ops, since shorter runs do not amortize the interpreted
+// dispatch of _FusedCwiseChain.
+bool FindCwiseChain(const RemapperContext& ctx, int node_index,
+                    CwiseChain* matched) {
+  constexpr int kMinChainLength = 3;
+
+  const auto* root_view = ctx.graph_view.GetNode(node_index);
+  const auto* root_def = root_view->node();
+  // TODO(lyandy): Forward controls for patterns with control dependencies.
+  if (HasControlFaninOrFanout(*root_view)) return false;
+  if (!NodeIsOnCpu(root_def)) return false;
+
+  // The interpreted kernel only supports float and double.
+  const DataType dtype = GetDataTypeFromAttr(*root_def, "T");
+  if (dtype != DT_FLOAT && dtype != DT_DOUBLE) return false;
+
+  std::vector<int> nodes;
+  std::vector<int> chain_ports;
+  const auto* node_view = root_view;
+  while (true) {
+    const auto* node_def = node_view->node();
+    int chain_port;
+    if (IsFusibleUnaryCwise(*node_def)) {
+      if (node_view->NumRegularFanins() != 1) break;
+      chain_port = 0;
+    } else if (IsFusibleBinaryCwise(*node_def)) {
+      if (node_view->NumRegularFanins() != 2) break;
+      // Exactly one operand must be a scalar constant; the other port carries
+      // the chained value.
+      const bool scalar_const_0 =
+          IsScalarConst(*node_view->GetRegularFanin(0).node_view()->node());
+      const bool scalar_const_1 =
+          IsScalarConst(*node_view->GetRegularFanin(1).node_view()->node());
+      if (scalar_const_0 == scalar_const_1) break;
+      chain_port = scalar_const_0 ? 1 : 0;
+    } else {
+      break;
+    }
+    nodes.push_back(node_view->node_index());
+    chain_ports.push_back(chain_port);
+
+    // The candidate feeding the chained value may only extend the chain if it
+    // is consumed by this chain alone, keeps the data type, and stays on CPU;
+    // otherwise it becomes the chain's external input.
+    const auto& chain_fanin = node_view->GetRegularFanin(chain_port);
+    if (chain_fanin.index() != 0) break;
+    const auto* fanin_view = chain_fanin.node_view();
+    const auto* fanin_def = fanin_view->node();
+    if (HasControlFaninOrFanout(*fanin_view) ||
+        !HasAtMostOneFanoutAtPort0(*fanin_view) ||
+        IsInPreserveSet(ctx, fanin_def) ||
+        !HaveSameDataType(root_def, fanin_def) || !NodeIsOnCpu(fanin_def)) {
+      break;
+    }
+    node_view = fanin_view;
+  }
+
+  if (static_cast<int>(nodes.size()) < kMinChainLength) return false;
+
+  // The walk collected the chain root-first; flip it into execution order.
+  std::reverse(nodes.begin(), nodes.end());
+  std::reverse(chain_ports.begin(), chain_ports.end());
+  matched->nodes = std::move(nodes);
+  matched->chain_ports = std::move(chain_ports);
+
+  return true;
+}
+
 bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
                           std::map<string, int>* matched_nodes_map,
                           std::set<int>* remove_node_indices) {
@@ -2769,6 +3391,173 @@ Status AddMklLayerNorm(RemapperContext* ctx,
   return OkStatus();
 }
 
+Status AddFusedLayerNorm(RemapperContext* ctx,
+                         const std::map<string, int>& matched_nodes_map,
+                         const std::set<int>& remove_node_indices,
+                         std::vector<bool>* invalidated_nodes,
+                         std::vector<bool>* nodes_to_delete) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+  auto* input_times_scaled_rsqrt_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("input_times_scaled_rsqrt"))
+          ->node();
+  auto* scaled_rsqrt_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("scaled_rsqrt"))->node();
+  auto* rsqrt_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("rsqrt"))->node();
+  auto* beta_minus_scaled_mean_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("beta_minus_scaled_mean"))
+          ->node();
+  auto* epsilon_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("epsilon"))->node();
+
+  // The pattern matcher tolerates swapped inputs of commutative ops, so the
+  // interesting operand of a matched Mul is found by excluding the matched
+  // sibling instead of by position.
+  auto other_input = [](const NodeDef* node, const NodeDef* sibling) {
+    return NodeName(node->input(0)) == sibling->name() ? node->input(1)
+                                                       : node->input(0);
+  };
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op("_FusedLayerNorm");
+  fused_node.set_device(output_node->device());
+  fused_node.add_input(
+      other_input(input_times_scaled_rsqrt_node, scaled_rsqrt_node));  // x
+  fused_node.add_input(other_input(scaled_rsqrt_node, rsqrt_node));  // gamma
+  fused_node.add_input(beta_minus_scaled_mean_node->input(0));       // beta
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = output_node->attr().at("T");
+  Tensor epsilon_tensor;
+  CHECK(epsilon_tensor.FromProto(  // Crash OK: checked during matching.
+      epsilon_node->attr().at("value").tensor()));
+  SetAttrValue(epsilon_tensor.flat<float>()(0), &(*attr)["epsilon"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return OkStatus();
+}
+
+Status AddFusedGelu(RemapperContext* ctx,
+                    const std::map<string, int>& matched_nodes_map,
+                    const std::set<int>& remove_node_indices,
+                    std::vector<bool>* invalidated_nodes,
+                    std::vector<bool>* nodes_to_delete,
+                    bool is_gelu_approximate) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+  auto* inner_mul_node =
+      ctx->graph_view
+          .GetNode(matched_nodes_map.at(
+              is_gelu_approximate ? "tanh_plus_one_times_one_half"
+                                  : "erf_plus_one_times_one_half"))
+          ->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op("_FusedGelu");
+  fused_node.set_device(output_node->device());
+  // The root Mul is commutative, so pick the operand that is not the matched
+  // inner Mul as the input.
+  fused_node.add_input(NodeName(output_node->input(0)) ==
+                               inner_mul_node->name()
+                           ? output_node->input(1)
+                           : output_node->input(0));
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = output_node->attr().at("T");
+  SetAttrValue(is_gelu_approximate, &(*attr)["approximate"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return OkStatus();
+}
+
+Status AddFusedAttention(RemapperContext* ctx,
+                         const std::map<string, int>& matched_nodes_map,
+                         const std::set<int>& remove_node_indices,
+                         std::vector<bool>* invalidated_nodes,
+                         std::vector<bool>* nodes_to_delete) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+  auto* scores_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("scores"))->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op("_FusedAttention");
+  fused_node.set_device(output_node->device());
+  fused_node.add_input(scores_node->input(0));  // query
+  fused_node.add_input(scores_node->input(1));  // key
+  fused_node.add_input(output_node->input(1));  // value
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = output_node->attr().at("T");
+  float scale_value = 1.0f;
+  if (matched_nodes_map.count("scale") > 0) {
+    auto* scale_node =
+        ctx->graph_view.GetNode(matched_nodes_map.at("scale"))->node();
+    Tensor scale_tensor;
+    CHECK(scale_tensor.FromProto(  // Crash OK: checked during matching.
+        scale_node->attr().at("value").tensor()));
+    scale_value = scale_tensor.flat<float>()(0);
+  }
+  SetAttrValue(scale_value, &(*attr)["scale"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return OkStatus();
+}
+
+Status AddSparseXentLossOnly(RemapperContext* ctx, int node_index,
+                             std::vector<bool>* invalidated_nodes) {
+  const NodeDef* node = ctx->graph_view.GetNode(node_index)->node();
+
+  // The replacement keeps the node's name, inputs and loss output (port 0);
+  // only the unused backprop output disappears.
+  NodeDef loss_only;
+  loss_only.set_name(node->name());
+  loss_only.set_op("_SparseSoftmaxCrossEntropyLoss");
+  loss_only.set_device(node->device());
+  for (const string& input : node->input()) {
+    loss_only.add_input(input);
+  }
+  auto* attr = loss_only.mutable_attr();
+  (*attr)["T"] = node->attr().at("T");
+  (*attr)["Tlabels"] = node->attr().at("Tlabels");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(loss_only), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[node_index] = true;
+  return OkStatus();
+}
+
 Status ReplaceMulMaximumWithLeakyRelu(
     RemapperContext* ctx, const std::map<string, int>& matched_nodes_map,
     const std::set<int>& remove_node_indices,
@@ -3232,6 +4021,55 @@ Status AddTensorToHashBucketNode(RemapperContext* ctx,
   return OkStatus();
 }
 
+Status AddFusedCwiseChainNode(RemapperContext* ctx, const CwiseChain& matched,
+                              std::vector<bool>* invalidated_nodes,
+                              std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& first = graph->node(matched.nodes.front());
+  const NodeDef& root = graph->node(matched.nodes.back());
+  VLOG(2) << "Fuse cwise chain of " << matched.nodes.size()
+          << " ops: first=" << first.name() << " root=" << root.name();
+
+  NodeDef fused_op;
+  fused_op.set_name(root.name());
+  fused_op.set_op(kFusedCwiseChain);
+  fused_op.set_device(root.device());
+  fused_op.add_input(first.input(matched.chain_ports.front()));  // 0: x
+
+  std::vector<string> fused_ops;
+  std::vector<bool> swapped_inputs;
+  int num_args = 0;
+  for (int i = 0; i < static_cast<int>(matched.nodes.size()); ++i) {
+    const NodeDef& node = graph->node(matched.nodes[i]);
+    fused_ops.push_back(node.op());
+    swapped_inputs.push_back(matched.chain_ports[i] == 1);
+    // Binary stages carry their scalar constant over as an extra argument.
+    if (ctx->graph_view.GetNode(matched.nodes[i])->NumRegularFanins() == 2) {
+      fused_op.add_input(node.input(1 - matched.chain_ports[i]));
+      ++num_args;
+    }
+  }
+
+  auto* attr = fused_op.mutable_attr();
+  (*attr)["T"] = root.attr().at("T");
+  SetAttrValue(num_args, &(*attr)["num_args"]);
+  SetAttrValue(fused_ops, &(*attr)["fused_ops"]);
+  SetAttrValue(swapped_inputs, &(*attr)["swapped_inputs"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.nodes.back()] = true;
+  for (int i = 0; i < static_cast<int>(matched.nodes.size()) - 1; ++i) {
+    (*nodes_to_delete)[matched.nodes[i]] = true;
+  }
+
+  return OkStatus();
+}
+
 Status AddFusedBatchMatMul(RemapperContext* ctx,
                            const std::map<string, int>& matched_nodes_map,
                            const std::set<int>& remove_node_indices,
@@ -3729,6 +4567,47 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap a gelu-subgraph that is not preceded by a fusable contraction
+    // into the standalone _FusedGelu.
+    if (allow_non_differentiable_rewrites &&
+        FindGelu(&ctx, i, &matched_nodes_map, &remove_node_indices,
+                 &is_gelu_approximate)) {
+      TF_RETURN_IF_ERROR(AddFusedGelu(&ctx, matched_nodes_map,
+                                      remove_node_indices, &invalidated_nodes,
+                                      &nodes_to_delete, is_gelu_approximate));
+      continue;
+    }
+
+    // Remap the layer-norm subgraph emitted by the python api into the
+    // single-pass _FusedLayerNorm.
+    if (allow_non_differentiable_rewrites &&
+        FindFusedLayerNorm(&ctx, i, &matched_nodes_map,
+                           &remove_node_indices)) {
+      TF_RETURN_IF_ERROR(
+          AddFusedLayerNorm(&ctx, matched_nodes_map, remove_node_indices,
+                            &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Remap BatchMatMulV2+Softmax+BatchMatMulV2 attention blocks into the
+    // tiled _FusedAttention, which avoids materializing the score matrix.
+    if (allow_non_differentiable_rewrites &&
+        FindFusedAttention(&ctx, i, &matched_nodes_map,
+                           &remove_node_indices)) {
+      TF_RETURN_IF_ERROR(
+          AddFusedAttention(&ctx, matched_nodes_map, remove_node_indices,
+                            &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Drop the backprop computation from SparseSoftmaxCrossEntropyWithLogits
+    // nodes whose backprop output is unused, as in forward-only graphs.
+    if (allow_non_differentiable_rewrites && FindSparseXentLossOnly(&ctx, i)) {
+      TF_RETURN_IF_ERROR(
+          AddSparseXentLossOnly(&ctx, i, &invalidated_nodes));
+      continue;
+    }
+
     // Remap {Conv2D,DepthwiseConv2D,MatMul}+BiasAdd into the
     // _Fused{Conv2D,DepthwiseConv2dNative,MatMul}
     ContractionWithBiasAdd contract_with_bias;
@@ -3816,6 +4695,16 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Collapse chains of unary / scalar-binary element-wise ops into a single
+    // _FusedCwiseChain that makes one pass over memory.
+    CwiseChain cwise_chain;
+    if (allow_non_differentiable_rewrites &&
+        FindCwiseChain(ctx, i, &cwise_chain)) {
+      TF_RETURN_IF_ERROR(AddFusedCwiseChainNode(
+          &ctx, cwise_chain, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
     // During inference, most of the inputs to FusedBatchNorm are constant, and
     // we can therefore replace the op with a much cheaper set of primitives.
     FusedBatchNorm fused_batch_norm;
@@ -1414,6 +1414,80 @@ TEST_F(RemapperTensorToHashBucketTest, I32) { RunTest<DT_INT32>(); }
 
 TEST_F(RemapperTensorToHashBucketTest, I64) { RunTest<DT_INT64>(); }
 
+class RemapperFuseCwiseChainTest : public RemapperTest {
+ public:
+  template <DataType DTYPE>
+  void RunTest() {
+    using ::tensorflow::ops::Placeholder;
+
+    if (GetNumAvailableGPUs() > 0) {
+      GTEST_SKIP() << "_FusedCwiseChain is CPU-only";
+    }
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    auto input_shape = ops::Placeholder::Shape({8, 32});
+    auto input = Placeholder(s.WithOpName("input"), DTYPE, input_shape);
+
+    // input * 2 -> 1 - (input * 2) -> Relu. The Sub puts the chained value on
+    // its second port to exercise the swapped_inputs attribute.
+    auto scale = ops::Const(s.WithOpName("scale"), 2.0f);
+    auto offset = ops::Const(s.WithOpName("offset"), 1.0f);
+    auto mul = ops::Mul(s.WithOpName("mul"), input, scale);
+    auto sub = ops::Sub(s.WithOpName("sub"), offset, mul);
+    auto relu = ops::Relu(s.WithOpName("relu"), sub);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), relu);
+
+    auto input_t = GenerateRandomTensor<DTYPE>({8, 32});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"input", input_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+    int found = 0;
+    for (const NodeDef& node : output.node()) {
+      EXPECT_NE(node.name(), "mul");
+      EXPECT_NE(node.name(), "sub");
+      if (node.name() == "relu") {
+        EXPECT_EQ(node.op(), "_FusedCwiseChain");
+        ASSERT_EQ(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "input");
+        EXPECT_EQ(node.input(1), "scale");
+        EXPECT_EQ(node.input(2), "offset");
+        const auto& fused_ops = node.attr().at("fused_ops").list();
+        ASSERT_EQ(fused_ops.s_size(), 3);
+        EXPECT_EQ(fused_ops.s(0), "Mul");
+        EXPECT_EQ(fused_ops.s(1), "Sub");
+        EXPECT_EQ(fused_ops.s(2), "Relu");
+        const auto& swapped = node.attr().at("swapped_inputs").list();
+        ASSERT_EQ(swapped.b_size(), 3);
+        EXPECT_FALSE(swapped.b(0));
+        EXPECT_TRUE(swapped.b(1));
+        EXPECT_FALSE(swapped.b(2));
+        found++;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+  }
+};
+
+TEST_F(RemapperFuseCwiseChainTest, F32) { RunTest<DT_FLOAT>(); }
+
 class RemapperFuseMatMulWithBiasTest : public RemapperTest {
  public:
   template <DataType DTYPE>
@@ -2506,5 +2580,302 @@ class RemapperLeakyReluTest : public GrapplerTest {
 TEST_F(RemapperLeakyReluTest, F32) { RunTest<DT_FLOAT>(); }
 TEST_F(RemapperLeakyReluTest, BF16) { RunTest<DT_BFLOAT16>(); }
 
+class RemapperFuseGeluTest : public RemapperTest {
+ public:
+  void RunTest(bool approximate) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    auto input_shape = ops::Placeholder::Shape({8, 64});
+    auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+    auto one = ops::Const(s.WithOpName("one"), 1.0f, {});
+    auto one_half = ops::Const(s.WithOpName("one_half"), 0.5f, {});
+    Output inner;
+    if (approximate) {
+      auto three = ops::Const(s.WithOpName("three"), 3.0f, {});
+      auto empirical_const =
+          ops::Const(s.WithOpName("empirical_const"), 0.044715f, {});
+      auto square_root_two_over_pi = ops::Const(
+          s.WithOpName("square_root_two_over_pi"), 0.7978845608028654f, {});
+      auto pow = ops::Pow(s.WithOpName("pow"), input, three);
+      auto mul = ops::Mul(s.WithOpName("mul"), pow, empirical_const);
+      auto input_plus_mul =
+          ops::AddV2(s.WithOpName("input_plus_mul"), input, mul);
+      auto scaled = ops::Mul(s.WithOpName("scaled"), input_plus_mul,
+                             square_root_two_over_pi);
+      auto tanh = ops::Tanh(s.WithOpName("tanh"), scaled);
+      auto tanh_plus_one =
+          ops::AddV2(s.WithOpName("tanh_plus_one"), tanh, one);
+      inner = ops::Mul(s.WithOpName("inner"), tanh_plus_one, one_half);
+    } else {
+      auto square_root_one_half = ops::Const(
+          s.WithOpName("square_root_one_half"), 0.7071067811865476f, {});
+      auto scaled =
+          ops::Mul(s.WithOpName("scaled"), input, square_root_one_half);
+      auto erf = ops::Erf(s.WithOpName("erf"), scaled);
+      auto erf_plus_one = ops::AddV2(s.WithOpName("erf_plus_one"), erf, one);
+      inner = ops::Mul(s.WithOpName("inner"), erf_plus_one, one_half);
+    }
+    auto output = ops::Mul(s.WithOpName("output"), inner, input);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+    auto input_t = GenerateTensorWithSetRandom<DT_FLOAT>({8, 64});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"input", input_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef optimized_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized_graph));
+
+    int found = 0;
+    for (const NodeDef& node : optimized_graph.node()) {
+      if (node.name() == "output") {
+        EXPECT_EQ(node.op(), "_FusedGelu");
+        ASSERT_EQ(node.input_size(), 1);
+        EXPECT_EQ(node.input(0), "input");
+        EXPECT_EQ(node.attr().at("approximate").b(), approximate);
+        ++found;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(optimized_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+  }
+};
+
+TEST_F(RemapperFuseGeluTest, Exact) { RunTest(false); }
+TEST_F(RemapperFuseGeluTest, Approximate) { RunTest(true); }
+
+class RemapperFuseLayerNormTest : public RemapperTest {
+ public:
+  void RunTest(bool use_stop_gradient) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    auto input_shape = ops::Placeholder::Shape({8, 128});
+    auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+    auto gamma = ops::Const(s.WithOpName("gamma"), 1.5f, {128});
+    auto beta = ops::Const(s.WithOpName("beta"), 0.5f, {128});
+    auto axes = ops::Const(s.WithOpName("axes"), {-1}, {1});
+
+    auto mean =
+        ops::Mean(s.WithOpName("mean"), input, axes, ops::Mean::KeepDims(true));
+    Output mean_for_variance = mean;
+    if (use_stop_gradient) {
+      mean_for_variance =
+          ops::StopGradient(s.WithOpName("stop_gradient"), mean);
+    }
+    auto squared_difference = ops::SquaredDifference(
+        s.WithOpName("squared_difference"), input, mean_for_variance);
+    auto variance = ops::Mean(s.WithOpName("variance"), squared_difference,
+                              axes, ops::Mean::KeepDims(true));
+    auto epsilon = ops::Const(s.WithOpName("epsilon"), 0.001f, {});
+    auto variance_plus_epsilon =
+        ops::AddV2(s.WithOpName("variance_plus_epsilon"), variance, epsilon);
+    auto rsqrt = ops::Rsqrt(s.WithOpName("rsqrt"), variance_plus_epsilon);
+    auto scaled_rsqrt = ops::Mul(s.WithOpName("scaled_rsqrt"), rsqrt, gamma);
+    auto scaled_input =
+        ops::Mul(s.WithOpName("scaled_input"), scaled_rsqrt, input);
+    auto scaled_mean =
+        ops::Mul(s.WithOpName("scaled_mean"), mean, scaled_rsqrt);
+    auto shift = ops::Sub(s.WithOpName("shift"), beta, scaled_mean);
+    auto output = ops::AddV2(s.WithOpName("output"), scaled_input, shift);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+    auto input_t = GenerateTensorWithSetRandom<DT_FLOAT>({8, 128});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"input", input_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef optimized_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized_graph));
+
+    int found = 0;
+    for (const NodeDef& node : optimized_graph.node()) {
+      if (node.name() == "output") {
+        EXPECT_EQ(node.op(), "_FusedLayerNorm");
+        ASSERT_EQ(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "input");
+        EXPECT_EQ(node.input(1), "gamma");
+        EXPECT_EQ(node.input(2), "beta");
+        EXPECT_NEAR(node.attr().at("epsilon").f(), 0.001f, 1e-6);
+        ++found;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(optimized_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-5, 1e-5);
+  }
+};
+
+TEST_F(RemapperFuseLayerNormTest, F32) { RunTest(/*use_stop_gradient=*/false); }
+TEST_F(RemapperFuseLayerNormTest, F32WithStopGradient) {
+  RunTest(/*use_stop_gradient=*/true);
+}
+
+class RemapperFuseAttentionTest : public RemapperTest {
+ public:
+  void RunTest(bool with_scale) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    auto qkv_shape = ops::Placeholder::Shape({2, 4, 64, 32});
+    auto query = Placeholder(s.WithOpName("query"), DT_FLOAT, qkv_shape);
+    auto key = Placeholder(s.WithOpName("key"), DT_FLOAT, qkv_shape);
+    auto value = Placeholder(s.WithOpName("value"), DT_FLOAT, qkv_shape);
+
+    auto scores = ops::BatchMatMulV2(s.WithOpName("scores"), query, key,
+                                     ops::BatchMatMulV2::AdjY(true));
+    Output logits = scores;
+    if (with_scale) {
+      // 1 / sqrt(32)
+      auto scale = ops::Const(s.WithOpName("scale"), 0.17677669529663687f, {});
+      logits = ops::Mul(s.WithOpName("scaled_scores"), scores, scale);
+    }
+    auto softmax = ops::Softmax(s.WithOpName("softmax"), logits);
+    auto output = ops::BatchMatMulV2(s.WithOpName("output"), softmax, value);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+    auto query_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 64, 32});
+    auto key_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 64, 32});
+    auto value_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 64, 32});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef optimized_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized_graph));
+
+    int found = 0;
+    for (const NodeDef& node : optimized_graph.node()) {
+      if (node.name() == "output") {
+        EXPECT_EQ(node.op(), "_FusedAttention");
+        ASSERT_EQ(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "query");
+        EXPECT_EQ(node.input(1), "key");
+        EXPECT_EQ(node.input(2), "value");
+        EXPECT_NEAR(node.attr().at("scale").f(),
+                    with_scale ? 0.17677669529663687f : 1.0f, 1e-6);
+        ++found;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(optimized_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-5, 1e-5);
+  }
+};
+
+TEST_F(RemapperFuseAttentionTest, F32) { RunTest(/*with_scale=*/true); }
+TEST_F(RemapperFuseAttentionTest, F32NoScale) { RunTest(/*with_scale=*/false); }
+
+class RemapperSparseXentLossOnlyTest : public RemapperTest {
+ public:
+  void RunTest(bool fetch_backprop) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    auto logits = Placeholder(s.WithOpName("logits"), DT_FLOAT,
+                              ops::Placeholder::Shape({8, 32}));
+    auto labels = Placeholder(s.WithOpName("labels"), DT_INT32,
+                              ops::Placeholder::Shape({8}));
+    auto xent = ops::SparseSoftmaxCrossEntropyWithLogits(s.WithOpName("xent"),
+                                                         logits, labels);
+    auto fetch = ops::Identity(s.WithOpName("fetch"), xent.loss);
+
+    auto logits_t = GenerateTensorWithSetRandom<DT_FLOAT>({8, 32});
+    Tensor labels_t(DT_INT32, TensorShape({8}));
+    for (int i = 0; i < 8; ++i) {
+      labels_t.flat<int32>()(i) = (i * 5) % 32;
+    }
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    if (fetch_backprop) {
+      auto backprop_fetch =
+          ops::Identity(s.WithOpName("backprop_fetch"), xent.backprop);
+      item.fetch.push_back("backprop_fetch");
+    }
+    item.feed = {{"logits", logits_t}, {"labels", labels_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef optimized_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &optimized_graph));
+
+    int found = 0;
+    for (const NodeDef& node : optimized_graph.node()) {
+      if (node.name() == "xent") {
+        // The loss-only kernel may replace the node only when the backprop
+        // output is unused.
+        if (fetch_backprop) {
+          EXPECT_EQ(node.op(), "SparseSoftmaxCrossEntropyWithLogits");
+        } else {
+          EXPECT_EQ(node.op(), "_SparseSoftmaxCrossEntropyLoss");
+          ASSERT_EQ(node.input_size(), 2);
+          EXPECT_EQ(node.input(0), "logits");
+          EXPECT_EQ(node.input(1), "labels");
+        }
+        ++found;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    auto tensors = EvaluateNodes(optimized_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), tensors_expected.size());
+    for (int i = 0; i < tensors.size(); ++i) {
+      test::ExpectClose(tensors[i], tensors_expected[i], 1e-6);
+    }
+  }
+};
+
+TEST_F(RemapperSparseXentLossOnlyTest, LossOnly) {
+  RunTest(/*fetch_backprop=*/false);
+}
+TEST_F(RemapperSparseXentLossOnlyTest, BackpropUsed) {
+  RunTest(/*fetch_backprop=*/true);
+}
+
 }  // namespace grappler
 }  // namespace tensorflow
@@ -19,6 +19,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
 #include "tensorflow/core/grappler/grappler_item.h"
@@ -333,6 +334,33 @@ Status GetDataInputs(GraphDef* graph, NodeMap* node_map, NodeDef* op,
   return OkStatus();
 }
 
+// Returns the set of all nodes that are transitively reachable via data or
+// control edges starting at `source_nodes`.  Stop at the boundary of a frame.
+Status TransitiveFanoutWithinFrame(
+    GraphDef* graph, NodeMap* node_map,
+    const std::vector<const NodeDef*>& source_nodes,
+    absl::flat_hash_set<const NodeDef*>* fanout) {
+  std::deque<const NodeDef*> queue(source_nodes.begin(), source_nodes.end());
+  absl::flat_hash_set<const NodeDef*> visited;
+  while (!queue.empty()) {
+    const NodeDef* node = queue.front();
+    queue.pop_front();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    fanout->insert(node);
+    for (const NodeDef* output : node_map->GetOutputs(node->name())) {
+      if (!ModifiesFrameInfo(*output)) {
+        queue.push_back(output);
+      }
+      VLOG(2) << "TransitiveFanout parent: " << node->name()
+              << " child: " << output->name() << " of type " << output->op();
+    }
+  }
+
+  return OkStatus();
+}
+
 void DumpGraphToVLOG(const GraphDef& graph, int log_level) {
   if (VLOG_IS_ON(log_level)) {
     // VLOG may truncate lines so we print line by line.
@@ -478,33 +506,6 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
     return OkStatus();
   }
 
-  // Returns the set of all nodes that are transitively reachable via data or
-  // control edges starting at `source_nodes`.  Stop at the boundary of a frame.
-  Status TransitiveFanoutWithinFrame(
-      GraphDef* graph, NodeMap* node_map,
-      const std::vector<const NodeDef*>& source_nodes,
-      absl::flat_hash_set<const NodeDef*>* fanout) {
-    std::deque<const NodeDef*> queue(source_nodes.begin(), source_nodes.end());
-    absl::flat_hash_set<const NodeDef*> visited;
-    while (!queue.empty()) {
-      const NodeDef* node = queue.front();
-      queue.pop_front();
-      if (!visited.insert(node).second) {
-        continue;
-      }
-      fanout->insert(node);
-      for (const NodeDef* output : node_map->GetOutputs(node->name())) {
-        if (!ModifiesFrameInfo(*output)) {
-          queue.push_back(output);
-        }
-        VLOG(2) << "TransitiveFanout parent: " << node->name()
-                << " child: " << output->name() << " of type " << output->op();
-      }
-    }
-
-    return OkStatus();
-  }
-
   // Build the ScopedAllocator node that will be assigned to allocate
   // the output tensors of the input node set.
   Status ConstructScopedAllocatorNode(
@@ -886,22 +887,453 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
   }
 };
 
+// Rewrites a ConcatV2 over the leading axis into a no-op view of a
+// ScopedAllocator backing tensor.  The ops producing the concat inputs are
+// directed to allocate their outputs contiguously, in concat order, inside
+// the backing tensor, and the ConcatV2 is replaced by a
+// _ScopedAllocatorConcat that merely reinterprets the backing tensor with the
+// concatenated shape, eliminating the copy:
+//
+//    a   b   c               _ScopedAllocator
+//     \  |  /                  ^    ^    ^     (allocation of a, b, c)
+//      concat      =>          a    b    c
+//        |                      \   |   /
+//    consumers             _ScopedAllocatorConcat
+//                                   |
+//                               consumers
+//
+// Unlike UnaryElementwiseRewriter this does not coalesce parallel instances
+// of the enabled op; each ConcatV2 is rewritten independently, and ones that
+// do not qualify are simply left alone.
+class ConcatOutputRewriter : public ScopedAllocatorOptimizer::Rewriter {
+ public:
+  ~ConcatOutputRewriter() override {}
+
+  bool CanRewriteSingleInstance() const override { return true; }
+
+  Status Rewrite(ScopedAllocatorOptimizer* sa_opti, int64_t invocation_count,
+                 GraphDef* graph, const string& op_name,
+                 const std::vector<NodeDef*>& ops, bool* applied) override {
+    for (NodeDef* concat : ops) {
+      // Rewriting is best-effort per concat: an ineligible one costs us the
+      // optimization, not the pass.
+      Status s =
+          MaybeRewriteConcat(sa_opti, invocation_count, graph, concat,
+                             applied);
+      if (!s.ok()) {
+        VLOG(1) << "Not coalescing inputs of " << concat->name() << ": "
+                << s.error_message();
+      }
+    }
+    return OkStatus();
+  }
+
+ private:
+  // Returns non-OK if `concat` does not concatenate over its leading axis,
+  // i.e. its axis input is not a constant scalar 0.
+  Status CheckAxisIsZero(NodeMap* node_map, NodeDef* concat, int num_inputs) {
+    // The axis is data input `num_inputs` of ConcatV2.
+    if (concat->input_size() <= num_inputs) {
+      return errors::Internal("Node ", concat->name(), " has ",
+                              concat->input_size(), " inputs but N = ",
+                              num_inputs);
+    }
+    NodeDef* axis_node = node_map->GetNode(concat->input(num_inputs));
+    if (axis_node == nullptr) {
+      return errors::Internal("Did not find node ",
+                              concat->input(num_inputs));
+    }
+    if (!IsConstant(*axis_node)) {
+      return errors::Aborted("concat axis ", axis_node->name(),
+                             " is not a constant");
+    }
+    Tensor axis_tensor;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(AttrSlice(*axis_node), "value", &axis_tensor));
+    if (axis_tensor.NumElements() != 1) {
+      return errors::Aborted("concat axis ", axis_node->name(),
+                             " is not a scalar");
+    }
+    int64_t axis = -1;
+    if (axis_tensor.dtype() == DT_INT32) {
+      axis = axis_tensor.scalar<int32>()();
+    } else if (axis_tensor.dtype() == DT_INT64) {
+      axis = axis_tensor.scalar<int64_t>()();
+    } else {
+      return errors::Aborted("concat axis ", axis_node->name(),
+                             " has unexpected type ",
+                             DataTypeString(axis_tensor.dtype()));
+    }
+    if (axis != 0) {
+      // Only leading-axis concatenation corresponds to laying the inputs out
+      // back to back in memory.
+      return errors::Aborted("only concat over axis 0 can become a view, ",
+                             "found axis ", axis);
+    }
+    return OkStatus();
+  }
+
+  // Gathers the producers of the data inputs of `concat` along with their
+  // output shapes, checking for any consideration that prevents allocating
+  // all of those outputs from a single ScopedAllocator.  On success
+  // *concat_shape is the statically known shape of the concat output.
+  Status AnalyzeConcatInputs(NodeMap* node_map, NodeDef* concat,
+                             int num_inputs, DataType dtype,
+                             std::vector<InputDesc>* inputs,
+                             std::vector<TensorShape>* input_shapes,
+                             TensorShape* concat_shape) {
+    std::set<std::pair<string, int>> seen_producers;
+    int64_t leading_dim = 0;
+    for (int i = 0; i < num_inputs; ++i) {
+      const string& input_name = concat->input(i);
+      int output_slot = 0;
+      ParseNodeName(input_name, &output_slot);
+      NodeDef* producer = node_map->GetNode(input_name);
+      if (producer == nullptr) {
+        return errors::Internal("Did not find node ", input_name);
+      }
+      if (producer->device() != concat->device()) {
+        return errors::Aborted("input ", producer->name(),
+                               " is on a different device");
+      }
+      // The producer must honor the AllocatorAttributes the executor gives
+      // it.  Constants are allocated at initialization time, and forwarding
+      // ops like Identity and Reshape pass through their input buffer, so
+      // none of them can be directed into the backing tensor.
+      if (IsConstant(*producer) || IsArg(*producer) || IsIdentity(*producer) ||
+          IsReshape(*producer) || IsExit(*producer) ||
+          ModifiesFrameInfo(*producer)) {
+        return errors::Aborted("input ", producer->name(), " is a ",
+                               producer->op(),
+                               " op, which does not allocate its output with "
+                               "the AllocatorAttributes set by the executor");
+      }
+      if (!seen_producers.insert({producer->name(), output_slot}).second) {
+        return errors::Aborted("output ", input_name,
+                               " feeds the concat more than once");
+      }
+      // An output can be committed to at most one scope id.
+      AttrSlice n_attrs = AttrSlice(*producer);
+      std::vector<int32> scope_ids;
+      if (GetNodeAttr(n_attrs, kScopedAllocatorAttrName, &scope_ids).ok()) {
+        for (int si = 0; si + 1 < static_cast<int>(scope_ids.size());
+             si += 2) {
+          if (scope_ids[si] == output_slot) {
+            return errors::Aborted("output ", input_name,
+                                   " is already assigned to scope_id ",
+                                   scope_ids[si + 1]);
+          }
+        }
+      }
+      if (!graph_properties_->HasOutputProperties(producer->name())) {
+        return errors::Aborted("input ", producer->name(),
+                               " lacks output shape");
+      }
+      const std::vector<OpInfo::TensorProperties>& prop_list =
+          graph_properties_->GetOutputProperties(producer->name());
+      DataType producer_dtype = DT_INVALID;
+      TF_RETURN_IF_ERROR(
+          GetOutputDataType(prop_list, output_slot, &producer_dtype));
+      if (producer_dtype != dtype) {
+        return errors::Aborted("input ", input_name, " has type ",
+                               DataTypeString(producer_dtype),
+                               " but the concat expects ",
+                               DataTypeString(dtype));
+      }
+      const TensorShapeProto& shape_proto = prop_list[output_slot].shape();
+      if (!TensorShape::IsValid(shape_proto) || shape_proto.unknown_rank()) {
+        return errors::Aborted("complete shape not known for ", input_name);
+      }
+      TensorShape shape(shape_proto);
+      if (shape.dims() < 1) {
+        return errors::Aborted("input ", input_name, " is a scalar");
+      }
+      // ScopedAllocatorMgr pads every field up to kAllocatorAlignment, so
+      // unless each input except the last already ends on an alignment
+      // boundary the backing tensor would contain padding holes and could
+      // not be viewed as the concatenated tensor.
+      const int64_t input_bytes = shape.num_elements() * DataTypeSize(dtype);
+      if (i < num_inputs - 1 &&
+          input_bytes % Allocator::kAllocatorAlignment != 0) {
+        return errors::Aborted(
+            "input ", input_name, " occupies ", input_bytes,
+            " bytes, which is not a multiple of kAllocatorAlignment, so the "
+            "backing tensor would contain alignment padding");
+      }
+      if (i == 0) {
+        *concat_shape = shape;
+      } else if (shape.dims() != concat_shape->dims()) {
+        return errors::Aborted("concat inputs disagree on rank");
+      } else {
+        for (int d = 1; d < shape.dims(); ++d) {
+          if (shape.dim_size(d) != concat_shape->dim_size(d)) {
+            return errors::Aborted("concat inputs disagree on dimension ", d);
+          }
+        }
+      }
+      leading_dim += shape.dim_size(0);
+      inputs->emplace_back(producer, output_slot, concat);
+      input_shapes->push_back(shape);
+    }
+    concat_shape->set_dim(0, leading_dim);
+    return OkStatus();
+  }
+
+  Status MaybeRewriteConcat(ScopedAllocatorOptimizer* sa_opti,
+                            int64_t invocation_count, GraphDef* graph,
+                            NodeDef* concat, bool* applied) {
+    NodeMap* node_map = sa_opti->node_map();
+    if (sa_opti->nodes_to_preserve().find(concat->name()) !=
+        sa_opti->nodes_to_preserve().end()) {
+      return errors::Aborted("concat must be preserved");
+    }
+    if (concat->device().empty()) {
+      return errors::Aborted("concat has no assigned device");
+    }
+    AttrSlice concat_attrs = AttrSlice(*concat);
+    DataType dtype;
+    TF_RETURN_IF_ERROR(GetNodeAttr(concat_attrs, "T", &dtype));
+    if (IsRefType(dtype) || !DataTypeCanUseMemcpy(dtype) ||
+        Allocator::kAllocatorAlignment % DataTypeSize(dtype) != 0) {
+      return errors::Aborted("type ", DataTypeString(dtype),
+                             " cannot be allocated from a ScopedAllocator");
+    }
+    int32_t num_inputs;
+    TF_RETURN_IF_ERROR(GetNodeAttr(concat_attrs, "N", &num_inputs));
+    if (num_inputs < 2) {
+      return errors::Aborted("nothing to coalesce for a single input");
+    }
+    TF_RETURN_IF_ERROR(CheckAxisIsZero(node_map, concat, num_inputs));
+
+    std::vector<InputDesc> inputs;
+    std::vector<TensorShape> input_shapes;
+    TensorShape concat_shape;
+    TF_RETURN_IF_ERROR(AnalyzeConcatInputs(node_map, concat, num_inputs,
+                                           dtype, &inputs, &input_shapes,
+                                           &concat_shape));
+
+    // Compute the backing tensor size.  Thanks to the alignment check in
+    // AnalyzeConcatInputs the fields are contiguous, so the backing tensor
+    // holds exactly the elements of the concat output.
+    std::vector<ScopedAllocator::Field> sa_fields;
+    int64_t num_bytes = ScopedAllocatorMgr::PopulateFields(
+        0 /*scope_id*/, input_shapes, dtype, &sa_fields);
+    int64_t num_elts = num_bytes / DataTypeSize(dtype);
+    if (num_elts != concat_shape.num_elements()) {
+      return errors::Internal("backing tensor has ", num_elts,
+                              " elements but the concat output has ",
+                              concat_shape.num_elements());
+    }
+    TensorShape sa_shape({num_elts});
+
+    // From here on the graph is modified; failures are no longer benign.
+    int sa_id = sa_opti->NewScopedAllocatorId(num_inputs);
+    string sa_name =
+        strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
+    TF_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
+        graph, node_map, concat, dtype, sa_id, sa_name, input_shapes, inputs,
+        sa_shape));
+
+    string sac_name = strings::StrCat("scoped_allocator_concat_", sa_id, "_",
+                                      invocation_count);
+    TF_RETURN_IF_ERROR(BuildSAConcatNode(graph, node_map, concat, num_inputs,
+                                         dtype, sa_id, sa_name, sac_name,
+                                         concat_shape));
+
+    TF_RETURN_IF_ERROR(RewireConsumers(graph, node_map, concat, sac_name));
+
+    *applied = true;
+    return OkStatus();
+  }
+
+  // Build the ScopedAllocator node that will be assigned to allocate the
+  // inputs of `concat`.
+  Status ConstructScopedAllocatorNode(
+      GraphDef* graph, NodeMap* node_map, NodeDef* concat, DataType dtype,
+      int sa_id, const string& sa_name,
+      const std::vector<TensorShape>& input_shapes,
+      const std::vector<InputDesc>& inputs, const TensorShape& sa_shape) {
+    VLOG(2) << "ConstructScopedAllocatorNode " << sa_name;
+    NodeDefBuilder sa_builder(sa_name, "_ScopedAllocator");
+    sa_builder.Device(concat->device());
+    sa_builder.Attr("sa_name", sa_name);
+    sa_builder.Attr("T", dtype);
+    sa_builder.Attr("id", sa_id);
+    sa_builder.Attr("shapes", input_shapes);
+    sa_builder.Attr("shape", sa_shape);
+    sa_builder.Attr("expected_call_count", static_cast<int64_t>(
+                                               input_shapes.size()));
+    NodeDef* sa_node = graph->add_node();
+    LOG_WARNING_AND_RETURN_IF_ERROR(sa_builder.Finalize(sa_node));
+    node_map->AddNode(sa_name, sa_node);
+
+    std::vector<const NodeDef*> fanout_sources;
+    fanout_sources.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      fanout_sources.push_back(input.from_node_def);
+    }
+    absl::flat_hash_set<const NodeDef*> fanout;
+    TF_RETURN_IF_ERROR(
+        TransitiveFanoutWithinFrame(graph, node_map, fanout_sources, &fanout));
+
+    // Add control edges from the ScopedAllocatorOp to all of the
+    // producers and mark them for allocation from the backing tensor.
+    for (int i = 0, end = inputs.size(); i < end; ++i) {
+      const auto& nd = inputs[i];
+      VLOG(2) << "To input " << i << ": " << nd.from_node_def->name()
+              << " add control input "
+              << "^" << sa_name;
+      nd.from_node_def->add_input(strings::StrCat("^", sa_name));
+      // This attribute says: allocate output_slot from
+      // ScopedAllocator instance sa_id + 1 + i.
+      ScopedAllocatorOptimizer::ExtendNodeAttr(kScopedAllocatorAttrName,
+                                               {nd.output_slot, sa_id + 1 + i},
+                                               nd.from_node_def);
+      node_map->AddOutput(sa_name, nd.from_node_def->name());
+    }
+
+    // We add control edges in order to (1) delay execution of the
+    // ScopedAllocatorOp until just before first use in order to conserve
+    // memory (2) ensure correctness in the presence of control flow related
+    // ops.
+    bool added_delay_edge = false;
+    for (const auto& nd : inputs) {
+      std::vector<InputDesc> inputs_to_first;
+      LOG_WARNING_AND_RETURN_IF_ERROR(GetDataInputs(
+          graph, node_map, nd.from_node_def, &inputs_to_first));
+      for (int i = 0, end = inputs_to_first.size(); i < end; ++i) {
+        if (fanout.find(inputs_to_first[i].from_node_def) != fanout.end()) {
+          VLOG(2) << "Found node " << inputs_to_first[i].from_node_def->name()
+                  << " in the fanout of " << sa_name;
+          continue;
+        }
+        sa_node->add_input(
+            strings::StrCat("^", inputs_to_first[i].from_node_def->name()));
+        node_map->AddOutput(inputs_to_first[i].from_node_def->name(), sa_name);
+        added_delay_edge = true;
+        VLOG(2) << "Adding control dependency from "
+                << inputs_to_first[i].from_node_def->name() << " to "
+                << sa_node->name();
+        break;
+      }
+      if (added_delay_edge) {
+        break;
+      }
+    }
+
+    if (!added_delay_edge) {
+      LOG(WARNING) << "Found no node from which a control edge can be added to "
+                      "scoped allocator node.  If you run into issues with "
+                      "graphs that contain control flow, turn off the "
+                      "ScopedAllocatorOptimizer and file a bug.";
+    }
+
+    return OkStatus();
+  }
+
+  // Build the _ScopedAllocatorConcat node that replaces `concat`.  It takes
+  // the backing tensor as its first input, keeps the data inputs of the old
+  // concat as ordering dependencies, and outputs the backing tensor reshaped
+  // to the concat output shape.
+  Status BuildSAConcatNode(GraphDef* graph, NodeMap* node_map, NodeDef* concat,
+                           int num_inputs, DataType dtype, int sa_id,
+                           const string& sa_name, const string& sac_name,
+                           const TensorShape& concat_shape) {
+    VLOG(2) << "BuildSAConcatNode " << sac_name;
+    NodeDefBuilder sac_builder(sac_name, "_ScopedAllocatorConcat");
+    sac_builder.Device(concat->device());
+    sac_builder.Attr("sa_name", sa_name);
+    sac_builder.Attr("id", sa_id);
+    sac_builder.Attr("T", dtype);
+    sac_builder.Attr("shape", concat_shape);
+    sac_builder.Attr("reshape", true);
+    sac_builder.Attr("N", num_inputs);
+    sac_builder.Input(NodeDefBuilder::NodeOut(sa_name, 0, dtype));
+    std::vector<NodeDefBuilder::NodeOut> sac_inputs;
+    sac_inputs.reserve(num_inputs);
+    for (int i = 0; i < num_inputs; ++i) {
+      int output_slot = 0;
+      string input_name = ParseNodeName(concat->input(i), &output_slot);
+      sac_inputs.push_back(
+          NodeDefBuilder::NodeOut(input_name, output_slot, dtype));
+    }
+    sac_builder.Input(sac_inputs);
+    NodeDef* sac_node = graph->add_node();
+    LOG_WARNING_AND_RETURN_IF_ERROR(sac_builder.Finalize(sac_node));
+    node_map->AddNode(sac_name, sac_node);
+    node_map->AddOutput(sa_name, sac_name);
+    for (const auto& sac_input : sac_inputs) {
+      node_map->AddOutput(sac_input.node, sac_name);
+    }
+
+    // Carry over the control inputs of the old concat.  Its axis input is
+    // dropped: the axis was consumed at rewrite time, and the dead constant
+    // gets cleaned up by the dependency optimizer.
+    for (const string& old_input : concat->input()) {
+      if (IsControlInput(old_input)) {
+        int position = 0;
+        string input_name = ParseNodeName(old_input, &position);
+        sac_node->add_input(old_input);
+        node_map->AddOutput(input_name, sac_name);
+      }
+    }
+    return OkStatus();
+  }
+
+  // Moves all output edges of `concat` over to the _ScopedAllocatorConcat
+  // node, then removes `concat` from the graph.
+  Status RewireConsumers(GraphDef* graph, NodeMap* node_map, NodeDef* concat,
+                         const string& sac_name) {
+    VLOG(2) << "RewireConsumers of " << concat->name();
+    // Copy the output node set since we'll be modifying the version
+    // maintained by NodeMap in the loop.
+    auto output_nodes = node_map->GetOutputs(concat->name());
+    for (NodeDef* n : output_nodes) {
+      for (int i = 0; i < n->input_size(); ++i) {
+        int position = 0;
+        string input_node = ParseNodeName(n->input(i), &position);
+        if (input_node != concat->name()) {
+          continue;
+        }
+        if (position == -1) {
+          *n->mutable_input(i) = strings::StrCat("^", sac_name);
+        } else {
+          CHECK_EQ(0, position)
+              << "name " << n->input(i) << " pos " << position;
+          *n->mutable_input(i) = sac_name;
+        }
+        node_map->UpdateInput(n->name(), concat->name(), sac_name);
+      }
+    }
+    node_map->RemoveInputs(concat->name());
+    concat->clear_input();
+    node_map->RemoveOutputs(concat->name());
+    RemoveNode(concat, graph, node_map);
+    return OkStatus();
+  }
+};
+
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
     : opt_level_(opt_level) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
   Rewriter* r = new UnaryElementwiseRewriter();
   to_delete_.push_back(r);
+  Rewriter* concat_rewriter = new ConcatOutputRewriter();
+  to_delete_.push_back(concat_rewriter);
+  const auto rewriter_for = [r, concat_rewriter](const string& op_name) {
+    return op_name == "ConcatV2" ? concat_rewriter : r;
+  };
   if (opts.enable_op_size() == 0) {
     // Opts handled by default:
     for (const auto& op_name : {"CollectiveReduce"}) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      rewriters_[op_name] = rewriter_for(op_name);
     }
   } else {
     for (const auto& op_name : opts.enable_op()) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      rewriters_[op_name] = rewriter_for(op_name);
     }
   }
 }
@@ -1124,11 +1556,12 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
                                          &op_name, invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
-          if (t->nodes_.size() > 1) {
+          const bool singleton_ok = rewriter->CanRewriteSingleInstance();
+          if (t->nodes_.size() > 1 || (singleton_ok && !t->nodes_.empty())) {
             std::vector<std::vector<NodeDef*>> loop_groups;
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
-              if (lg.size() > 1) {
+              if (lg.size() > 1 || singleton_ok) {
                 bool applied = false;
                 Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
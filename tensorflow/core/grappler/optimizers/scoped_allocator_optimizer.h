@@ -76,6 +76,10 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
     return repeated_outputs_;
   }
 
+  const std::unordered_set<string>& nodes_to_preserve() const {
+    return nodes_to_preserve_;
+  }
+
   // Appends values to the attr value under name in node_def, if present.
   // If not present does an assignment.
   static void ExtendNodeAttr(StringPiece name, const std::vector<int32>& values,
@@ -93,6 +97,10 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
                            const std::vector<NodeDef*>& nodes,
                            bool* applied) = 0;
 
+    // Whether Rewrite may usefully be called with a single node, as opposed
+    // to requiring a group of parallel instances.
+    virtual bool CanRewriteSingleInstance() const { return false; }
+
     void SetGraphProperties(const GraphProperties& graph_properties) {
       graph_properties_ = &graph_properties;
       CHECK(graph_properties_);
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/grappler/optimizers/scoped_allocator_optimizer.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "tensorflow/cc/ops/array_ops.h"
@@ -267,6 +268,40 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     TF_CHECK_OK(s.ToGraphDef(graph_def));
   }
 
+  // Constructs the following graph.
+  //
+  // a and b are Const ops.  a1 and a2 are Abs ops feeding an axis-`axis`
+  // ConcatV2, whose output is read through the Identity op r.
+  //
+  // After the ConcatOutputRewriter runs (for axis 0), we expect a1 and a2 to
+  // allocate from a new ScopedAllocator and the ConcatV2 to be replaced by a
+  // _ScopedAllocatorConcat view of the backing tensor.
+  /*
+          a    b
+          |    |
+          a1   a2
+           \   /
+          concat
+            |
+            r
+  */
+  void BuildConcatGraph(GraphDef* graph_def, int axis) {
+    Scope s = Scope::NewRootScope();
+    s = s.WithDevice("/job:localhost/replica:0/task:0/device:CPU:0");
+
+    // Each input occupies 2 * 8 * sizeof(float) = 64 bytes, a multiple of
+    // kAllocatorAlignment, so the inputs can be laid out contiguously.
+    Output a = ops::Const<float>(s.WithOpName("a"), -2.0, {2, 8});
+    Output b = ops::Const<float>(s.WithOpName("b"), 3.0, {2, 8});
+    Output a1 = ops::Abs(s.WithOpName("a1"), a);
+    Output a2 = ops::Abs(s.WithOpName("a2"), b);
+    Output axis_op = ops::Const<int32>(s.WithOpName("axis"), axis, {});
+    Output concat =
+        ops::Concat(s.WithOpName("concat"), {a1, a2}, axis_op);
+    Output r = ops::Identity(s.WithOpName("r"), concat);
+    TF_CHECK_OK(s.ToGraphDef(graph_def));
+  }
+
   void SetShapes(GraphDef* graph_def) {
     TensorShapeProto shape_proto;
     shape_proto.add_dim()->set_size(2);
@@ -279,11 +314,13 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     }
   }
 
-  // Invokes ScopedAllocatorOptimizer on `graph_def`, then executes it and
-  // returns the outputs specified by `output_names` in `outputs`.
+  // Invokes ScopedAllocatorOptimizer on `graph_def` with `enable_op` enabled,
+  // then executes it and returns the outputs specified by `output_names` in
+  // `outputs`.
   void ExecuteGraph(const GraphDef& graph_def,
                     const std::vector<string>& output_names,
-                    std::vector<Tensor>* outputs) {
+                    std::vector<Tensor>* outputs,
+                    const string& enable_op = "Abs") {
     // Turn off all optimization except the ScopedAllocatorOptimizer
     // to avoid anything that would alter the expected graph input/output,
     // e.g. by constant folding away all calculations.
@@ -297,7 +334,7 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     RewriterConfig* rwcfg = gopt->mutable_rewrite_options();
     rwcfg->clear_optimizers();
     (*rwcfg->add_optimizers()) = "scoped_allocator";
-    rwcfg->mutable_scoped_allocator_opts()->add_enable_op("Abs");
+    rwcfg->mutable_scoped_allocator_opts()->add_enable_op(enable_op);
     std::unique_ptr<Session> session(CreateSession(graph_def, config));
 
     std::vector<std::pair<string, Tensor>> inputs;
@@ -596,6 +633,86 @@ TEST_F(ScopedAllocatorOptimizerTest, ConstInput) {
   }
   EXPECT_EQ(num_identity_ops, 2);
 }
+
+// Tests that an axis-0 ConcatV2 whose inputs can be allocated contiguously is
+// replaced by a no-op view of a ScopedAllocator backing tensor.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatRewriteOnly) {
+  GrapplerItem item;
+  BuildConcatGraph(&item.graph, /*axis=*/0);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("ConcatV2");
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(nullptr /*cluster*/, item, &optimized_graph));
+
+  // Examine the resulting graphdef.  The ConcatV2 is gone, replaced by a
+  // _ScopedAllocatorConcat.
+  NodeMap node_map(&optimized_graph);
+  EXPECT_EQ(node_map.GetNode("concat"), nullptr);
+  const NodeDef* sac_node = nullptr;
+  for (const NodeDef& node : optimized_graph.node()) {
+    if (node.op() == "_ScopedAllocatorConcat") {
+      sac_node = &node;
+      break;
+    }
+  }
+  ASSERT_NE(sac_node, nullptr);
+
+  // Both producers are committed to fields of the same ScopedAllocator.
+  NodeDef* sa_node = ValidateSAControlInput(&optimized_graph, &node_map, "a1");
+  EXPECT_EQ(ValidateSAControlInput(&optimized_graph, &node_map, "a2"),
+            sa_node);
+  NodeDef* a1 = nullptr;
+  GetNode(&node_map, "a1", &a1);
+  EXPECT_TRUE(HasNodeAttr(*a1, "_scoped_allocator"));
+  NodeDef* a2 = nullptr;
+  GetNode(&node_map, "a2", &a2);
+  EXPECT_TRUE(HasNodeAttr(*a2, "_scoped_allocator"));
+
+  // The consumer of the old ConcatV2 now reads the backing tensor view.
+  NodeDef* r = nullptr;
+  GetNode(&node_map, "r", &r);
+  ASSERT_EQ(r->input_size(), 1);
+  EXPECT_EQ(r->input(0), sac_node->name());
+}
+
+// Builds the same graph as ConcatRewriteOnly but also executes it and
+// validates the output.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatExecute) {
+  GraphDef graph_def;
+  BuildConcatGraph(&graph_def, /*axis=*/0);
+  std::vector<Tensor> outputs;
+  ExecuteGraph(graph_def, /*output_names=*/{"r:0"}, &outputs,
+               /*enable_op=*/"ConcatV2");
+  ASSERT_EQ(outputs[0].shape(), TensorShape({4, 8}));
+  std::vector<float> expected(32, 2.0);
+  std::fill(expected.begin() + 16, expected.end(), 3.0);
+  ValidateValues(outputs, {expected});
+}
+
+// Tests that a ConcatV2 over a non-leading axis, which does not correspond to
+// a contiguous layout of its inputs, is left alone.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatNonZeroAxisUnchanged) {
+  GrapplerItem item;
+  BuildConcatGraph(&item.graph, /*axis=*/1);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("ConcatV2");
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(nullptr /*cluster*/, item, &optimized_graph));
+
+  NodeMap node_map(&optimized_graph);
+  NodeDef* concat = nullptr;
+  GetNode(&node_map, "concat", &concat);
+  EXPECT_EQ(concat->op(), "ConcatV2");
+  for (const NodeDef& node : optimized_graph.node()) {
+    EXPECT_NE(node.op(), "_ScopedAllocator");
+  }
+}
 #endif  // ENABLE_MKL
 
 }  // namespace
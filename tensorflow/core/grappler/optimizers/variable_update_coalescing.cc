@@ -0,0 +1,182 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/variable_update_coalescing.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+bool IsCoalescableUpdate(const NodeDef& node) {
+  return node.op() == "AssignAddVariableOp" ||
+         node.op() == "AssignSubVariableOp";
+}
+
+}  // namespace
+
+Status VariableUpdateCoalescing::Optimize(Cluster* cluster,
+                                          const GrapplerItem& item,
+                                          GraphDef* output) {
+  *output = item.graph;
+  NodeMap node_map(output);
+  const std::unordered_set<string> nodes_to_preserve = item.NodesToPreserve();
+
+  // Groups updates by op, device and the resource tensor they update.  Only
+  // updates of the same flavor (all adds or all subs) commute with each
+  // other, and the coalesced nodes must live where the originals did.
+  absl::flat_hash_map<string, std::vector<NodeDef*>> groups;
+  for (NodeDef& node : *output->mutable_node()) {
+    if (!IsCoalescableUpdate(node)) continue;
+    if (nodes_to_preserve.count(node.name()) > 0) continue;
+    if (node.input_size() < 2 || IsControlInput(node.input(0)) ||
+        IsControlInput(node.input(1))) {
+      continue;
+    }
+    const TensorId resource = ParseTensorName(node.input(0));
+    groups[strings::StrCat(node.op(), "|", node.device(), "|",
+                           resource.ToString())]
+        .push_back(&node);
+  }
+
+  std::set<string> nodes_to_delete;
+  // Maps each coalesced member to its replacement, for rewriting the control
+  // edges that hang off the members.
+  absl::flat_hash_map<string, string> replacements;
+
+  for (auto& group : groups) {
+    const std::vector<NodeDef*>& members = group.second;
+    if (members.size() < 2) continue;
+
+    absl::flat_hash_set<string> member_names;
+    for (const NodeDef* member : members) member_names.insert(member->name());
+
+    // Collects everything downstream of the group.  If a member consumes a
+    // value (or control trigger) produced downstream of another member, some
+    // node is ordered strictly between two members and could observe the
+    // variable in its partially updated state, so the group must stay as is.
+    absl::flat_hash_set<string> downstream;
+    std::vector<const NodeDef*> frontier(members.begin(), members.end());
+    while (!frontier.empty()) {
+      const NodeDef* node = frontier.back();
+      frontier.pop_back();
+      for (const NodeDef* fanout : node_map.GetOutputs(node->name())) {
+        if (downstream.insert(fanout->name()).second) {
+          frontier.push_back(fanout);
+        }
+      }
+    }
+    bool eligible = true;
+    for (const NodeDef* member : members) {
+      for (const string& input : member->input()) {
+        const string input_node = NodeName(input);
+        if (member_names.count(input_node) == 0 &&
+            downstream.count(input_node) > 0) {
+          eligible = false;
+          break;
+        }
+      }
+      if (!eligible) break;
+    }
+    if (!eligible) continue;
+
+    // Sums the member updates once, then applies them with a single locked
+    // assign.
+    const NodeDef& first = *members[0];
+    NodeDef* add_n = output->add_node();
+    add_n->set_name(strings::StrCat(first.name(), "/coalesced/add_n"));
+    add_n->set_op("AddN");
+    add_n->set_device(first.device());
+    (*add_n->mutable_attr())["N"].set_i(members.size());
+    (*add_n->mutable_attr())["T"] = first.attr().at("dtype");
+
+    NodeDef* coalesced = output->add_node();
+    coalesced->set_name(strings::StrCat(first.name(), "/coalesced"));
+    coalesced->set_op(first.op());
+    coalesced->set_device(first.device());
+    (*coalesced->mutable_attr())["dtype"] = first.attr().at("dtype");
+    coalesced->add_input(first.input(0));
+    coalesced->add_input(add_n->name());
+
+    absl::flat_hash_set<string> control_inputs;
+    for (const NodeDef* member : members) {
+      add_n->add_input(member->input(1));
+      for (int i = 2; i < member->input_size(); ++i) {
+        const string& input = member->input(i);
+        if (member_names.count(NodeName(input)) > 0) continue;
+        if (control_inputs.insert(input).second) {
+          coalesced->add_input(input);
+        }
+      }
+      nodes_to_delete.insert(member->name());
+      replacements[member->name()] = coalesced->name();
+    }
+  }
+
+  if (nodes_to_delete.empty()) {
+    return errors::Aborted("Nothing to do.");
+  }
+
+  // Retargets control edges that depended on individual members to the
+  // coalesced update, deduplicating edges that referenced several members.
+  for (NodeDef& node : *output->mutable_node()) {
+    if (nodes_to_delete.count(node.name()) > 0) continue;
+    bool rewritten = false;
+    for (string& input : *node.mutable_input()) {
+      if (!IsControlInput(input)) continue;
+      auto iter = replacements.find(NodeName(input));
+      if (iter != replacements.end()) {
+        input = AsControlDependency(iter->second);
+        rewritten = true;
+      }
+    }
+    if (rewritten) {
+      protobuf::RepeatedPtrField<string> deduped_inputs;
+      absl::flat_hash_set<string> seen_control_inputs;
+      for (const string& input : node.input()) {
+        if (IsControlInput(input) &&
+            !seen_control_inputs.insert(input).second) {
+          continue;
+        }
+        *deduped_inputs.Add() = input;
+      }
+      node.mutable_input()->Swap(&deduped_inputs);
+    }
+  }
+  EraseNodesFromGraph(nodes_to_delete, output);
+
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(VariableUpdateCoalescing,
+                            "variable_update_coalescing");
+
+}  // end namespace grappler
+}  // end namespace tensorflow
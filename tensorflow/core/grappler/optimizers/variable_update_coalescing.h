@@ -0,0 +1,56 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_VARIABLE_UPDATE_COALESCING_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_VARIABLE_UPDATE_COALESCING_H_
+
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer.h"
+
+namespace tensorflow {
+namespace grappler {
+
+// VariableUpdateCoalescing merges groups of AssignAddVariableOp (or
+// AssignSubVariableOp) nodes that update the same resource variable into a
+// single AddN followed by one assign, so the variable's mutex is taken once
+// per group instead of once per update.  Because the updates are commutative,
+// the rewrite picks one of the execution orders the original graph already
+// allowed; a group is left alone whenever some other consumer of the variable
+// is ordered strictly between two of its members, since that consumer could
+// observe the partially updated value.
+//
+// This is an opt-in optimization: enable it by adding
+// "variable_update_coalescing" to RewriterConfig.custom_optimizers.
+class VariableUpdateCoalescing : public CustomGraphOptimizer {
+ public:
+  VariableUpdateCoalescing() {}
+  ~VariableUpdateCoalescing() override {}
+
+  string name() const override { return "variable_update_coalescing"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Init(const tensorflow::RewriterConfig_CustomGraphOptimizer* config =
+                  nullptr) override {
+    return OkStatus();
+  }
+
+  Status Optimize(Cluster* cluster, const GrapplerItem& item,
+                  GraphDef* output) override;
+};
+
+}  // end namespace grappler
+}  // end namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_VARIABLE_UPDATE_COALESCING_H_
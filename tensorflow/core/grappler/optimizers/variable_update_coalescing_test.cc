@@ -0,0 +1,115 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/variable_update_coalescing.h"
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/utils/grappler_test.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+class VariableUpdateCoalescingTest : public GrapplerTest {};
+
+int CountOps(const GraphDef& graph, const string& op) {
+  int count = 0;
+  for (const NodeDef& node : graph.node()) {
+    if (node.op() == op) ++count;
+  }
+  return count;
+}
+
+TEST_F(VariableUpdateCoalescingTest, CoalesceAssignAdds) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto var = ops::VarHandleOp(s.WithOpName("var"), DT_FLOAT, TensorShape({}));
+  Output c1 = ops::Const(s.WithOpName("c1"), 1.0f, {});
+  Output c2 = ops::Const(s.WithOpName("c2"), 2.0f, {});
+  Output c3 = ops::Const(s.WithOpName("c3"), 3.0f, {});
+  auto a1 = ops::AssignAddVariableOp(s.WithOpName("a1"), var, c1);
+  auto a2 = ops::AssignAddVariableOp(s.WithOpName("a2"), var, c2);
+  auto a3 = ops::AssignAddVariableOp(s.WithOpName("a3"), var, c3);
+  // A node that waits for one of the updates; its control edge must be
+  // retargeted to the coalesced update.
+  Output done = ops::Const(
+      s.WithOpName("done").WithControlDependencies(a2.operation), 0.0f, {});
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  VariableUpdateCoalescing optimizer;
+  GraphDef output;
+  TF_EXPECT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  // The three updates collapse into one AddN feeding one assign.
+  EXPECT_EQ(CountOps(output, "AssignAddVariableOp"), 1);
+  EXPECT_EQ(CountOps(output, "AddN"), 1);
+  for (const NodeDef& node : output.node()) {
+    if (node.op() == "AddN") {
+      EXPECT_EQ(node.input_size(), 3);
+    } else if (node.name() == "done") {
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "^a1/coalesced");
+    }
+  }
+}
+
+TEST_F(VariableUpdateCoalescingTest, ObserverBetweenUpdates) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto var = ops::VarHandleOp(s.WithOpName("var"), DT_FLOAT, TensorShape({}));
+  Output c1 = ops::Const(s.WithOpName("c1"), 1.0f, {});
+  Output c2 = ops::Const(s.WithOpName("c2"), 2.0f, {});
+  auto a1 = ops::AssignAddVariableOp(s.WithOpName("a1"), var, c1);
+  // A read ordered after the first update and before the second observes the
+  // intermediate value, so the updates must not be coalesced.
+  auto read = ops::ReadVariableOp(
+      s.WithOpName("read").WithControlDependencies(a1.operation), var,
+      DT_FLOAT);
+  auto a2 = ops::AssignAddVariableOp(
+      s.WithOpName("a2").WithControlDependencies(read.operation), var, c2);
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  VariableUpdateCoalescing optimizer;
+  GraphDef output;
+  EXPECT_EQ(optimizer.Optimize(nullptr, item, &output),
+            errors::Aborted("Nothing to do."));
+}
+
+TEST_F(VariableUpdateCoalescingTest, PreservedNodesAreKept) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  auto var = ops::VarHandleOp(s.WithOpName("var"), DT_FLOAT, TensorShape({}));
+  Output c1 = ops::Const(s.WithOpName("c1"), 1.0f, {});
+  Output c2 = ops::Const(s.WithOpName("c2"), 2.0f, {});
+  auto a1 = ops::AssignAddVariableOp(s.WithOpName("a1"), var, c1);
+  auto a2 = ops::AssignAddVariableOp(s.WithOpName("a2"), var, c2);
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch.push_back("a1");
+
+  VariableUpdateCoalescing optimizer;
+  GraphDef output;
+  EXPECT_EQ(optimizer.Optimize(nullptr, item, &output),
+            errors::Aborted("Nothing to do."));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
@@ -49,6 +49,11 @@ constexpr char kInitialInflightBatchesAttr[] = "_initial_inflight_batches";
 constexpr char kMaxInflightBatchesAttr[] = "_max_inflight_batches";
 constexpr char kBatchesToAverageOverAttr[] = "_batches_to_average_over";
 
+// Experimental node attributes configuring shape bucketing; see
+// `BatchResourceBase::ShapeBucketingOptions`.
+constexpr char kShapeBucketBoundariesAttr[] = "_shape_bucket_boundaries";
+constexpr char kShapeBucketPaddingValueAttr[] = "_shape_bucket_padding_value";
+
 // Default thread count in the per-process batching thread pool.
 constexpr int64_t kBatchThreadPoolSize = 128;
 }  // namespace
@@ -257,6 +262,27 @@ BatchFunctionKernel::BatchFunctionKernel(OpKernelConstruction* c)
     has_attribute_enable_large_batch_splitting_ = false;
   }
 
+  // Shape bucketing is configured through experimental node attributes, so
+  // that models can opt in without an op-definition change.
+  if (c->HasAttr(kShapeBucketBoundariesAttr)) {
+    OP_REQUIRES_OK(c, c->GetAttr(kShapeBucketBoundariesAttr,
+                                 &shape_bucketing_options_.bucket_boundaries));
+    shape_bucketing_options_.enabled =
+        !shape_bucketing_options_.bucket_boundaries.empty();
+    int32_t last_boundary = 0;
+    for (const int32_t boundary : shape_bucketing_options_.bucket_boundaries) {
+      OP_REQUIRES(c, boundary > last_boundary,
+                  errors::InvalidArgument(
+                      "_shape_bucket_boundaries entries must be positive and "
+                      "monotonically increasing"));
+      last_boundary = boundary;
+    }
+  }
+  if (c->HasAttr(kShapeBucketPaddingValueAttr)) {
+    OP_REQUIRES_OK(c, c->GetAttr(kShapeBucketPaddingValueAttr,
+                                 &shape_bucketing_options_.padding_value));
+  }
+
   // Helper function `SetAdaptiveBatchSchedulerOptions` calls
   // `OP_REQUIRES_OK`, which exits the current function upon error.
   // So validate status of `op-kernel-construction`.
@@ -333,6 +359,7 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
           adaptive_shared_batch_scheduler_options, max_batch_size_,
           batch_timeout_micros_, max_enqueued_batches_, allowed_batch_sizes_,
           handle, flib_, &new_resource));
+      new_resource->set_shape_bucketing_options(shape_bucketing_options_);
       *r = new_resource.release();
       return OkStatus();
     };
@@ -343,6 +370,7 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
           num_batch_threads_, max_batch_size_, batch_timeout_micros_,
           max_enqueued_batches_, allowed_batch_sizes_, handle, flib_,
           enable_large_batch_splitting_, &new_resource));
+      new_resource->set_shape_bucketing_options(shape_bucketing_options_);
       *r = new_resource.release();
       return OkStatus();
     };
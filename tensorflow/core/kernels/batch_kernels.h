@@ -19,6 +19,7 @@ limitations under the License.
 #include "absl/types/optional.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/kernels/batching_util/batch_resource_base.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 
@@ -96,6 +97,10 @@ class BatchFunctionKernel : public AsyncOpKernel {
   bool has_attribute_enable_large_batch_splitting_;
   bool enable_adaptive_batch_threads_ = false;
 
+  // Options for bucketing tasks by trailing shape, read from experimental
+  // node attributes. Disabled unless bucket boundaries are supplied.
+  serving::BatchResourceBase::ShapeBucketingOptions shape_bucketing_options_;
+
   mutex mu_;
 
   // Parameters for adaptive batch scheduler only.
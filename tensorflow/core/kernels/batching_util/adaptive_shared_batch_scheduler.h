@@ -132,6 +132,19 @@ class AdaptiveSharedBatchScheduler
     // full_batch_scheduling_boost_micros==zero) for backward compatibility of
     // API.
     bool fifo_scheduling = false;
+
+    // If set, called when in_flight_batches_limit_ is adjusted to obtain the
+    // current device occupancy as a fraction in [0, 1]. Typical sources are
+    // stream_executor device activity or an estimate derived from the
+    // CostMeasurement registry. While the reported occupancy is at least
+    // max_device_occupancy, the limit is only walked downward, preventing the
+    // latency-driven random walk from piling batches onto a saturated device.
+    // Called while holding the scheduler's lock, so it must be cheap and must
+    // not block.
+    std::function<double()> occupancy_func = nullptr;
+    // Occupancy at or above which in_flight_batches_limit_ will not be
+    // raised. Only consulted when occupancy_func is set; must be in (0, 1].
+    double max_device_occupancy = 0.9;
   };
 
   // Ownership is shared between the caller of Create() and any queues created
@@ -417,6 +430,11 @@ Status AdaptiveSharedBatchScheduler<TaskType>::Create(
         "greater than or equal to 1; was ",
         options.batches_to_average_over);
   }
+  if (options.occupancy_func != nullptr &&
+      (options.max_device_occupancy <= 0 || options.max_device_occupancy > 1)) {
+    return errors::InvalidArgument("max_device_occupancy must be in (0, 1]; ",
+                                   "was ", options.max_device_occupancy);
+  }
   scheduler->reset(new AdaptiveSharedBatchScheduler<TaskType>(options));
   return OkStatus();
 }
@@ -681,6 +699,13 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeAdjustInflightLimit() {
       // there before decreasing step size.
       batch_delay_stats_.step_direction = -batch_delay_stats_.step_direction;
     }
+    if (options_.occupancy_func != nullptr &&
+        batch_delay_stats_.step_direction > 0 &&
+        options_.occupancy_func() >= options_.max_device_occupancy) {
+      // The device is saturated; raising concurrency would grow queues without
+      // adding throughput. Walk the limit downward until headroom reappears.
+      batch_delay_stats_.step_direction = -1;
+    }
     in_flight_batches_limit_ += batch_delay_stats_.step_direction *
                                 in_flight_batches_limit_ *
                                 step_size_multiplier_;
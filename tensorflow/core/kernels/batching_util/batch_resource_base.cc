@@ -218,6 +218,7 @@ BatchResourceBase::BatchTask::CreateSplitTask(
   task->propagated_context = Context(ContextKind::kThread);
   task->inputs.reserve(this->inputs.size());
   task->captured_inputs = this->captured_inputs;
+  task->unpadded_shapes = this->unpadded_shapes;
   task->context = this->context;
   task->done_callback = done_callback;
   task->split_index = split_index;
@@ -336,9 +337,15 @@ Status BatchResourceBase::RegisterInput(
     batch_components->request_cost = request_cost_accessor->GetRequestCost();
   }
 
+  string batcher_queue_key = batcher_queue_name;
+  if (shape_bucketing_options_.enabled) {
+    TF_RETURN_IF_ERROR(PadInputsToShapeBucket(context, batch_components.get(),
+                                              &batcher_queue_key));
+  }
+
   BatcherQueueT* batcher_queue;
   TF_RETURN_IF_ERROR(
-      LookupOrCreateBatcherQueue(batcher_queue_name, &batcher_queue));
+      LookupOrCreateBatcherQueue(batcher_queue_key, &batcher_queue));
   return batcher_queue->Schedule(&batch_components);
 }
 
@@ -434,6 +441,73 @@ int BatchResourceBase::RoundToLowestAllowedBatchSize(int batch_size) const {
   return batch_size;
 }
 
+TensorShape BatchResourceBase::BucketedShape(const TensorShape& shape) const {
+  TensorShape bucketed_shape(shape);
+  for (int d = 1; d < shape.dims(); ++d) {
+    const int64_t size = shape.dim_size(d);
+    for (const int32_t boundary : shape_bucketing_options_.bucket_boundaries) {
+      if (boundary >= size) {
+        bucketed_shape.set_dim(d, boundary);
+        break;
+      }
+    }
+  }
+  return bucketed_shape;
+}
+
+Status BatchResourceBase::PadInputsToShapeBucket(
+    OpKernelContext* context, BatchTask* task,
+    string* queue_name_suffix) const {
+  task->unpadded_shapes.reserve(task->inputs.size());
+  for (int i = 0, iter_limit = task->inputs.size(); i < iter_limit; ++i) {
+    const Tensor& input = task->inputs[i];
+    const TensorShape bucketed_shape = BucketedShape(input.shape());
+    task->unpadded_shapes.push_back(input.shape());
+    if (bucketed_shape != input.shape()) {
+      Tensor padded_input;
+      TF_RETURN_IF_ERROR(concat_split_util::PadTrailingDims(
+          context, input, bucketed_shape,
+          shape_bucketing_options_.padding_value, &padded_input));
+      task->inputs[i] = std::move(padded_input);
+    }
+    // Key the batcher queue on the bucketed trailing shape, so that only
+    // tasks padded to the same shapes are batched together.
+    absl::StrAppend(queue_name_suffix, "/");
+    for (int d = 1; d < bucketed_shape.dims(); ++d) {
+      absl::StrAppend(queue_name_suffix, bucketed_shape.dim_size(d), "x");
+    }
+  }
+  return OkStatus();
+}
+
+Status BatchResourceBase::MaybeUnpadOutputTensor(const BatchTask& task,
+                                                 int output_index,
+                                                 Tensor* tensor) const {
+  if (output_index >= static_cast<int>(task.unpadded_shapes.size())) {
+    return OkStatus();
+  }
+  const TensorShape& unpadded_shape = task.unpadded_shapes[output_index];
+  const TensorShape& padded_shape = task.inputs[output_index].shape();
+  if (tensor->dims() != padded_shape.dims() ||
+      padded_shape == unpadded_shape) {
+    return OkStatus();
+  }
+  // Only outputs that mirror the trailing shape their input was padded to can
+  // be attributed to the padding; leave others untouched.
+  for (int d = 1; d < tensor->dims(); ++d) {
+    if (tensor->dim_size(d) != padded_shape.dim_size(d)) {
+      return OkStatus();
+    }
+  }
+  TensorShape target_shape(unpadded_shape);
+  target_shape.set_dim(0, tensor->dim_size(0));
+  Tensor unpadded_tensor;
+  TF_RETURN_IF_ERROR(concat_split_util::UnpadTrailingDims(
+      task.context, *tensor, target_shape, &unpadded_tensor));
+  *tensor = std::move(unpadded_tensor);
+  return OkStatus();
+}
+
 Status BatchResourceBase::ConcatInputTensors(
     const BatchT& batch, OpKernelContext* context,
     std::vector<Tensor>* concatenated_tensors) const {
@@ -459,6 +533,14 @@ Status BatchResourceBase::ConcatInputTensors(
   RecordBatchSize(batch.size(), GetModelName(context),
                   context->op_kernel().name());
 
+  // Fast path: a batch holding one task with no padding can execute directly
+  // on views of the task's tensors; gathering them into a freshly allocated
+  // batch tensor would only add a copy.
+  if (batch.num_tasks() == 1 && padding_amount == 0) {
+    *concatenated_tensors = batch.task(0).inputs;
+    return OkStatus();
+  }
+
   // All tasks should have the same number of input edges.
   const int num_inputs = batch.task(0).inputs.size();
   concatenated_tensors->reserve(num_inputs);
@@ -640,24 +722,33 @@ Status BatchResourceBase::SplitOutputTensors(
     }
 
     std::vector<Tensor> split_tensor;
-    const Status split_status = tensor::Split(
-        output_tensor, task_sizes_plus_optional_padding, &split_tensor);
-    DCHECK(split_status.ok()) << split_status.ToString();
-    if (!split_status.ok()) {
-      return errors::Internal("Tensor split operation failed: ",
-                              split_status.error_message());
-    }
-    DCHECK_EQ(split_tensor.size(), task_sizes_plus_optional_padding.size());
-    if (split_tensor.size() != task_sizes_plus_optional_padding.size()) {
-      return errors::Internal(
-          "Tensor split operation did not work as expected; got ",
-          split_tensor.size(), " splits; expected ",
-          task_sizes_plus_optional_padding.size());
+    if (task_sizes_plus_optional_padding.size() == 1) {
+      // One task and no padding: the task owns every row of the combined
+      // output, so emit a view of it rather than a split copy.
+      split_tensor.push_back(output_tensor);
+    } else {
+      const Status split_status = tensor::Split(
+          output_tensor, task_sizes_plus_optional_padding, &split_tensor);
+      DCHECK(split_status.ok()) << split_status.ToString();
+      if (!split_status.ok()) {
+        return errors::Internal("Tensor split operation failed: ",
+                                split_status.error_message());
+      }
+      DCHECK_EQ(split_tensor.size(), task_sizes_plus_optional_padding.size());
+      if (split_tensor.size() != task_sizes_plus_optional_padding.size()) {
+        return errors::Internal(
+            "Tensor split operation did not work as expected; got ",
+            split_tensor.size(), " splits; expected ",
+            task_sizes_plus_optional_padding.size());
+      }
     }
 
     // Ignore a possible final split_tensors entry containing the padding.
     for (int j = 0; j < batch->num_tasks(); ++j) {
       BatchTask& task = *(batch->mutable_task(j));
+      if (shape_bucketing_options_.enabled) {
+        TF_RETURN_IF_ERROR(MaybeUnpadOutputTensor(task, i, &split_tensor[j]));
+      }
       if (task.is_partial) {
         std::vector<Tensor>& tensor_vector = (*task.output)[task.split_index];
         tensor_vector[i] = std::move(split_tensor[j]);
@@ -919,6 +1010,19 @@ Status BatchResourceBase::CreateBatchTask(
 void BatchResourceBase::SplitBatchCosts(
     std::vector<std::unique_ptr<CostMeasurement>>& batch_cost_measurements,
     const int64_t processed_size, BatchT& batch) {
+  // Record the batching shape of each task, so that consumers of the
+  // per-request costs can tell how much of a request's cost is padding and
+  // how large the batch it rode in was.
+  for (int i = 0; i < batch.num_tasks(); i++) {
+    RequestCost* request_cost = batch.task(i).request_cost;
+    if (!request_cost) continue;
+    request_cost->RecordMetrics(
+        {{kProcessedSizeMetricName, static_cast<double>(processed_size)},
+         {kInputSizeMetricName, static_cast<double>(batch.task(i).size())},
+         {kPaddingSizeMetricName,
+          static_cast<double>(processed_size - batch.size())}});
+  }
+
   for (auto& batch_cost_measurement : batch_cost_measurements) {
     if (batch_cost_measurement->GetTotalCost() <= absl::ZeroDuration()) {
       continue;
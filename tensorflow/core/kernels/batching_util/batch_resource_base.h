@@ -70,6 +70,11 @@ class BatchResourceBase : public ResourceBase {
 
     std::vector<Tensor> inputs;
     std::vector<Tensor> captured_inputs;
+
+    // When shape bucketing is enabled, the original (pre-padding) shapes of
+    // `inputs`; empty otherwise.
+    std::vector<TensorShape> unpadded_shapes;
+
     OpKernelContext* context;
     AsyncOpKernel::DoneCallback done_callback;
 
@@ -126,6 +131,24 @@ class BatchResourceBase : public ResourceBase {
   using BatcherQueueT = BatchScheduler<BatchResourceBase::BatchTask>;
   using BatchT = Batch<BatchResourceBase::BatchTask>;
 
+  // Options for bucketing tasks by the shape of their non-zeroth dimensions.
+  // Each input is padded up to its bucket boundary at enqueue time and tasks
+  // are routed to a per-bucket batcher queue, so that tasks with diverse
+  // trailing shapes can share a batch instead of each forming its own.
+  struct ShapeBucketingOptions {
+    // Whether shape bucketing is enabled.
+    bool enabled = false;
+
+    // Candidate sizes for bucketed dimensions, in increasing order. Each
+    // non-zeroth dimension is padded up to the smallest boundary that fits
+    // it; dimensions exceeding the largest boundary are left unpadded.
+    std::vector<int32> bucket_boundaries;
+
+    // The value padding elements are filled with, converted to the element
+    // type of the tensor being padded.
+    float padding_value = 0;
+  };
+
   BatchResourceBase(bool has_process_batch_function,
                     std::shared_ptr<BatcherT> batcher,
                     const BatcherT::QueueOptions& batcher_queue_options,
@@ -192,10 +215,18 @@ class BatchResourceBase : public ResourceBase {
   //    and paddings do not share any cost;
   // 2) non-smeared cost: batch cost is split proportionally to each task or
   //    padding's size. Here padding's cost is not assigned to any tasks.
+  //
+  // In addition, the batching shape of each task (processed size, input size
+  // and padding size) is recorded as request metrics, regardless of whether
+  // any cost measurement is active.
   static void SplitBatchCosts(
       std::vector<std::unique_ptr<CostMeasurement>>& batch_cost_measurements,
       const int64_t processed_size, BatchT& batch);
 
+  void set_shape_bucketing_options(const ShapeBucketingOptions& options) {
+    shape_bucketing_options_ = options;
+  }
+
  private:
   // Implementation of calling the process batch function.
   virtual void ProcessFuncBatchImpl(
@@ -217,6 +248,24 @@ class BatchResourceBase : public ResourceBase {
   // returns 'batch_size'.
   int RoundToLowestAllowedBatchSize(int batch_size) const;
 
+  // Returns the shape tensors of shape 'shape' are padded up to: each
+  // non-zeroth dimension is rounded up to the smallest bucket boundary that
+  // fits it. Dimensions exceeding the largest boundary are left unchanged.
+  TensorShape BucketedShape(const TensorShape& shape) const;
+
+  // Pads each input of 'task' up to its shape bucket and records the original
+  // shapes in 'task->unpadded_shapes'. Appends a per-bucket key to
+  // '*queue_name_suffix' so that only tasks padded to the same shapes share a
+  // batcher queue.
+  Status PadInputsToShapeBucket(OpKernelContext* context, BatchTask* task,
+                                string* queue_name_suffix) const;
+
+  // Restores a task's split output at 'output_index' to the task's
+  // pre-bucketing trailing shape, when the output mirrors the trailing shape
+  // the corresponding input was padded to; leaves other outputs untouched.
+  Status MaybeUnpadOutputTensor(const BatchTask& task, int output_index,
+                                Tensor* tensor) const;
+
   Status ConcatInputTensors(const BatchT& batch, OpKernelContext* context,
                             std::vector<Tensor>* concatenated_tensors) const;
 
@@ -264,6 +313,9 @@ class BatchResourceBase : public ResourceBase {
   // A concatenated string of <allowed_batch_sizes_>, separated by ",". This is
   // used to record batching parameter.
   string allowed_batch_sizes_str_;
+
+  // Options for bucketing tasks by trailing shape. Disabled by default.
+  ShapeBucketingOptions shape_bucketing_options_;
 };
 
 }  // namespace serving
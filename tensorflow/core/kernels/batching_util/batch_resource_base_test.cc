@@ -164,6 +164,28 @@ TEST(SplitBatchCostTest, SplitMultiCostTypes) {
                            Pair("test_gcu_no_smear", absl::Milliseconds(90))));
 }
 
+TEST(SplitBatchCostTest, RecordsBatchingMetrics) {
+  BatchResourceBase::BatchT batch;
+  RequestCost cost1, cost2;
+  batch.AddTask(MakeBatchTask(/*task_size=*/1, &cost1));
+  batch.AddTask(MakeBatchTask(/*task_size=*/9, &cost2));
+  batch.Close();
+
+  // Batching metrics are recorded even when no cost measurement is active.
+  std::vector<std::unique_ptr<CostMeasurement>> batch_cost_measurements;
+  BatchResourceBase::SplitBatchCosts(batch_cost_measurements,
+                                     /*processed_size=*/16, batch);
+
+  EXPECT_THAT(
+      batch.task(0).request_cost->GetMetrics(),
+      UnorderedElementsAre(Pair("processed_size", 16), Pair("input_size", 1),
+                           Pair("padding_size", 6)));
+  EXPECT_THAT(
+      batch.task(1).request_cost->GetMetrics(),
+      UnorderedElementsAre(Pair("processed_size", 16), Pair("input_size", 9),
+                           Pair("padding_size", 6)));
+}
+
 TEST(SplitBatchCostTest, SplitOnlyNonZeroCostTypes) {
   BatchResourceBase::BatchT batch;
   RequestCost cost1, cost2;
@@ -30,6 +30,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -59,11 +60,21 @@ namespace serving {
 // (see below) and it may be deleted as soon as it is done executing.
 class BatchTask {
  public:
+  // The deadline value returned by tasks that have no deadline.
+  static constexpr uint64 kNoDeadlineMicros =
+      std::numeric_limits<uint64>::max();
+
   virtual ~BatchTask() = default;
 
   // Returns the size of the task, in terms of how much it contributes to the
   // size of a batch. (A batch's size is the sum of its task sizes.)
   virtual size_t size() const = 0;
+
+  // Returns the absolute time (in microseconds, on the clock of
+  // `Env::NowMicros`) by which processing of this task should start, or
+  // `kNoDeadlineMicros` if the task has no deadline. Deadline-aware schedulers
+  // may use this to prioritize urgent tasks; other schedulers ignore it.
+  virtual uint64 deadline_micros() const { return kNoDeadlineMicros; }
 };
 
 // A thread-safe collection of BatchTasks, to be executed together in some
@@ -37,6 +37,12 @@ typedef Eigen::GpuDevice GPUDevice;
 template <typename T>
 Status Concat(OpKernelContext* context, const gtl::ArraySlice<Tensor> inputs,
               Tensor* output) {
+  // Trivial 1-way concat; emit a view of the input instead of copying it.
+  if (inputs.size() == 1) {
+    *output = inputs[0];
+    return OkStatus();
+  }
+
   const int input_dims = inputs[0].dims();
   const TensorShape& input_shape = inputs[0].shape();
 
@@ -246,6 +252,188 @@ inline Status Split(OpKernelContext* context, const Tensor& input,
   return split_status;
 }
 
+// The PadTrailingDims()/UnpadTrailingDims() functions grow and shrink the
+// non-zeroth dimensions of a tensor, for batching code that buckets tasks by
+// shape and pads every task up to its bucket boundary so that tasks with
+// diverse trailing shapes can share a batch.
+
+// Copies 'input' into the leading sub-block of 'output', which must have the
+// same rank and no smaller dimensions. The remaining elements of 'output' are
+// left untouched.
+template <typename T, int NDIMS>
+void CopyToLeadingBlock(OpKernelContext* context, const Tensor& input,
+                        Tensor* output) {
+  Eigen::DSizes<Eigen::DenseIndex, NDIMS> offsets;
+  Eigen::DSizes<Eigen::DenseIndex, NDIMS> sizes;
+  for (int d = 0; d < NDIMS; ++d) {
+    offsets[d] = 0;
+    sizes[d] = input.dim_size(d);
+  }
+  output->tensor<T, NDIMS>()
+      .slice(offsets, sizes)
+      .device(context->eigen_device<CPUDevice>()) = input.tensor<T, NDIMS>();
+}
+
+// Extracts the leading sub-block of 'input' whose shape matches 'output',
+// which must have the same rank and no larger dimensions.
+template <typename T, int NDIMS>
+void ExtractLeadingBlock(OpKernelContext* context, const Tensor& input,
+                         Tensor* output) {
+  Eigen::DSizes<Eigen::DenseIndex, NDIMS> offsets;
+  Eigen::DSizes<Eigen::DenseIndex, NDIMS> sizes;
+  for (int d = 0; d < NDIMS; ++d) {
+    offsets[d] = 0;
+    sizes[d] = output->dim_size(d);
+  }
+  output->tensor<T, NDIMS>().device(context->eigen_device<CPUDevice>()) =
+      input.tensor<T, NDIMS>().slice(offsets, sizes);
+}
+
+// Validates that 'from' can be padded or sliced to 'to': equal ranks, equal
+// zeroth dimensions, and every non-zeroth dimension growing (when 'growing'
+// is true) or shrinking otherwise.
+inline Status ValidateTrailingDims(const TensorShape& from,
+                                   const TensorShape& to, bool growing) {
+  if (from.dims() != to.dims() || from.dim_size(0) != to.dim_size(0)) {
+    return errors::InvalidArgument(
+        "Target shape must have the same rank and 0th dimension: ",
+        from.DebugString(), " vs. ", to.DebugString());
+  }
+  for (int d = 1; d < from.dims(); ++d) {
+    const bool valid = growing ? from.dim_size(d) <= to.dim_size(d)
+                               : from.dim_size(d) >= to.dim_size(d);
+    if (!valid) {
+      return errors::InvalidArgument("Non-zeroth dimensions must not ",
+                                     growing ? "shrink: " : "grow: ",
+                                     from.DebugString(), " vs. ",
+                                     to.DebugString());
+    }
+  }
+  return OkStatus();
+}
+
+// Pads 'input' with element type T up to 'padded_shape' along its non-zeroth
+// dimensions, filling the new elements with 'padding_value' converted to T.
+// Writes to 'output' using 'context' for the allocation.
+template <typename T>
+Status PadTrailingDims(OpKernelContext* context, const Tensor& input,
+                       const TensorShape& padded_shape, float padding_value,
+                       Tensor* output) {
+  TF_RETURN_IF_ERROR(
+      ValidateTrailingDims(input.shape(), padded_shape, /*growing=*/true));
+  if (padded_shape == input.shape()) {
+    *output = input;
+    return OkStatus();
+  }
+  AllocatorAttributes attr;
+  attr.set_on_host(true);
+  TF_RETURN_IF_ERROR(context->allocate_temp(DataTypeToEnum<T>::value,
+                                            padded_shape, output, attr));
+  output->flat<T>().setConstant(static_cast<T>(padding_value));
+  if (input.NumElements() == 0) {
+    return OkStatus();
+  }
+  switch (input.dims()) {
+#define CASE(NDIMS)                                       \
+  case NDIMS:                                             \
+    CopyToLeadingBlock<T, NDIMS>(context, input, output); \
+    break;
+    CASE(2);
+    CASE(3);
+    CASE(4);
+    CASE(5);
+    CASE(6);
+#undef CASE
+    default:
+      return errors::Unimplemented(
+          "PadTrailingDims is not implemented for tensors of rank ",
+          input.dims());
+  }
+  return OkStatus();
+}
+
+// Same as 'PadTrailingDims' above, but handles Tensor dtype automatically.
+inline Status PadTrailingDims(OpKernelContext* context, const Tensor& input,
+                              const TensorShape& padded_shape,
+                              float padding_value, Tensor* output) {
+  const DataType type = input.dtype();
+  Status pad_status;
+  switch (type) {
+#define CASE(type)                                                   \
+  case DataTypeToEnum<type>::value:                                  \
+    pad_status = PadTrailingDims<type>(context, input, padded_shape, \
+                                       padding_value, output);       \
+    break;
+    TF_CALL_REAL_NUMBER_TYPES(CASE);
+    TF_CALL_bool(CASE);
+#undef CASE
+    default:
+      pad_status = errors::InvalidArgument("Unsupported data type: ", type);
+      break;
+  }
+  return pad_status;
+}
+
+// Slices 'input' with element type T down to 'unpadded_shape' along its
+// non-zeroth dimensions, dropping the padding elements. Writes to 'output'
+// using 'context' for the allocation.
+template <typename T>
+Status UnpadTrailingDims(OpKernelContext* context, const Tensor& input,
+                         const TensorShape& unpadded_shape, Tensor* output) {
+  TF_RETURN_IF_ERROR(
+      ValidateTrailingDims(input.shape(), unpadded_shape, /*growing=*/false));
+  if (unpadded_shape == input.shape()) {
+    *output = input;
+    return OkStatus();
+  }
+  AllocatorAttributes attr;
+  attr.set_on_host(true);
+  TF_RETURN_IF_ERROR(context->allocate_temp(DataTypeToEnum<T>::value,
+                                            unpadded_shape, output, attr));
+  if (output->NumElements() == 0) {
+    return OkStatus();
+  }
+  switch (input.dims()) {
+#define CASE(NDIMS)                                        \
+  case NDIMS:                                              \
+    ExtractLeadingBlock<T, NDIMS>(context, input, output); \
+    break;
+    CASE(2);
+    CASE(3);
+    CASE(4);
+    CASE(5);
+    CASE(6);
+#undef CASE
+    default:
+      return errors::Unimplemented(
+          "UnpadTrailingDims is not implemented for tensors of rank ",
+          input.dims());
+  }
+  return OkStatus();
+}
+
+// Same as 'UnpadTrailingDims' above, but handles Tensor dtype automatically.
+inline Status UnpadTrailingDims(OpKernelContext* context, const Tensor& input,
+                                const TensorShape& unpadded_shape,
+                                Tensor* output) {
+  const DataType type = input.dtype();
+  Status unpad_status;
+  switch (type) {
+#define CASE(type)                                                       \
+  case DataTypeToEnum<type>::value:                                      \
+    unpad_status =                                                       \
+        UnpadTrailingDims<type>(context, input, unpadded_shape, output); \
+    break;
+    TF_CALL_REAL_NUMBER_TYPES(CASE);
+    TF_CALL_bool(CASE);
+#undef CASE
+    default:
+      unpad_status = errors::InvalidArgument("Unsupported data type: ", type);
+      break;
+  }
+  return unpad_status;
+}
+
 }  // namespace concat_split_util
 }  // namespace tensorflow
 
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <deque>
 #include <functional>
 #include <list>
@@ -125,6 +126,12 @@ class SharedBatchScheduler
     // Must be >= 1, and should be tuned carefully.
     int num_batch_threads = port::MaxParallelism();
 
+    // If true, an available batch thread picks the queue whose earliest
+    // enqueued task deadline (see `BatchTask::deadline_micros`) is soonest,
+    // and falls back to round-robin among the queues whose tasks carry no
+    // deadlines. If false, all queues are serviced round-robin.
+    bool rank_queues_by_deadline = false;
+
     // The environment to use.
     // (Typically only overridden by test code.)
     Env* env = Env::Default();
@@ -218,6 +225,16 @@ class SharedBatchScheduler
     // submit batches whose size is in a small set of allowed sizes, that can be
     // done by adding padding in the process-batch callback.
     size_t max_execution_batch_size = 1000;
+
+    // If true, the open batch becomes schedulable as soon as the slack of its
+    // earliest task deadline (see `BatchTask::deadline_micros`) drops below
+    // the queue's moving estimate of batch processing time, so that a partial
+    // batch is launched early rather than waiting out 'batch_timeout_micros'
+    // and missing the deadline.
+    //
+    // Must be false if `enable_lazy_split` is true; elsewise errors will be
+    // returned at queue creation time.
+    bool enable_deadline_aware_early_dispatch = false;
   };
   Status AddQueue(const QueueOptions& options,
                   std::function<void(std::unique_ptr<Batch<TaskType>>)>
@@ -344,6 +361,12 @@ class Queue {
   // size that's provided by caller of batch scheduler.
   size_t max_execution_batch_size() const { return max_execution_batch_size_; }
 
+  // Returns the earliest deadline (see `BatchTask::deadline_micros`) among
+  // the enqueued tasks, or `BatchTask::kNoDeadlineMicros` if no enqueued task
+  // carries a deadline. Always returns `BatchTask::kNoDeadlineMicros` when
+  // lazy split is enabled.
+  uint64 EarliestTaskDeadlineMicros() const;
+
   // Called by a thread that is ready to process a batch, to request one from
   // this queue. Either returns a batch that is ready to be processed, or
   // nullptr if the queue declines to schedule a batch at this time. If it
@@ -462,6 +485,16 @@ class Queue {
   std::deque<std::unique_ptr<Batch<BatchInputTaskHandle<TaskType>>>>
       task_handle_batches_ TF_GUARDED_BY(mu_);
 
+  // The earliest task deadline in each element of 'batches_'; the deques are
+  // parallel.
+  //
+  // Used iff `QueueOptions.enable_lazy_split` is false.
+  std::deque<uint64> batch_earliest_deadlines_ TF_GUARDED_BY(mu_);
+
+  // A moving average of the recent batch processing times, used by
+  // deadline-aware early dispatch. Zero until the first batch completes.
+  uint64 processing_time_estimate_micros_ TF_GUARDED_BY(mu_) = 0;
+
   // The counter of the TraceMe context ids.
   uint64 traceme_context_id_counter_ TF_GUARDED_BY(mu_) = 0;
 
@@ -603,6 +636,13 @@ Status SharedBatchScheduler<TaskType>::AddQueueAfterRewritingOptions(
         "enable_large_batch_splitting is enabled.");
   }
 
+  if (options.enable_deadline_aware_early_dispatch &&
+      options.enable_lazy_split) {
+    return errors::InvalidArgument(
+        "enable_deadline_aware_early_dispatch is not supported when "
+        "enable_lazy_split is enabled.");
+  }
+
   if (options.enable_large_batch_splitting &&
       (options.input_batch_size_limit < options.max_execution_batch_size)) {
     return errors::InvalidArgument(
@@ -665,6 +705,29 @@ void SharedBatchScheduler<TaskType>::GetNextWorkItem_Locked(
     BatchUniquePtr* batch_to_process_out) {
   BatchUniquePtr batch_to_process;
   internal::Queue<TaskType>* queue_for_batch = nullptr;
+  if (options_.rank_queues_by_deadline) {
+    // Service the queue with the most urgent task deadline first. Fall
+    // through to round-robin if no queue reports a deadline, or if the chosen
+    // queue declines to schedule a batch at this time.
+    typename QueueList::iterator edf_queue = queues_.end();
+    uint64 earliest_deadline = BatchTask::kNoDeadlineMicros;
+    for (typename QueueList::iterator it = queues_.begin();
+         it != queues_.end(); ++it) {
+      const uint64 deadline = (*it)->EarliestTaskDeadlineMicros();
+      if (deadline < earliest_deadline) {
+        earliest_deadline = deadline;
+        edf_queue = it;
+      }
+    }
+    if (edf_queue != queues_.end()) {
+      batch_to_process = (*edf_queue)->ScheduleBatch();
+      if (BatchExists(batch_to_process)) {
+        *queue_for_batch_out = edf_queue->get();
+        *batch_to_process_out = std::move(batch_to_process);
+        return;
+      }
+    }
+  }
   const int num_queues = queues_.size();
   for (int num_queues_tried = 0;
        !BatchExists(batch_to_process) && num_queues_tried < num_queues;
@@ -773,6 +836,7 @@ Queue<TaskType>::Queue(
         new Batch<BatchInputTaskHandle<TaskType>>);
   } else {
     batches_.emplace_back(new Batch<TaskType>);
+    batch_earliest_deadlines_.push_back(BatchTask::kNoDeadlineMicros);
   }
 }
 
@@ -928,6 +992,8 @@ Status Queue<TaskType>::ScheduleWithoutOrEagerSplit(
           },
           profiler::ContextType::kSharedBatchScheduler,
           batches_.back()->traceme_context_id());
+      batch_earliest_deadlines_.back() = std::min(
+          batch_earliest_deadlines_.back(), output_tasks[i]->deadline_micros());
       batches_.back()->AddTask(std::move(output_tasks[i]));
     }
 
@@ -969,6 +1035,19 @@ size_t Queue<TaskType>::SchedulingCapacity() const {
   return SchedulingCapacityInternal();
 }
 
+template <typename TaskType>
+uint64 Queue<TaskType>::EarliestTaskDeadlineMicros() const {
+  mutex_lock l(mu_);
+  if (options_.enable_lazy_split) {
+    return BatchTask::kNoDeadlineMicros;
+  }
+  uint64 earliest_deadline = BatchTask::kNoDeadlineMicros;
+  for (const uint64 deadline : batch_earliest_deadlines_) {
+    earliest_deadline = std::min(earliest_deadline, deadline);
+  }
+  return earliest_deadline;
+}
+
 template <typename TaskType>
 size_t Queue<TaskType>::SchedulingCapacityInternal() const {
   const int64 num_new_batches_schedulable =
@@ -1030,6 +1109,7 @@ Queue<TaskType>::ScheduleBatchWithEagerSplit() {
       ++num_batches_being_processed_;
       batch_to_schedule = std::move(batches_.front());
       batches_.pop_front();
+      batch_earliest_deadlines_.pop_front();
     } else {
       schedulable_batch_ = false;
     }
@@ -1080,10 +1160,28 @@ void Queue<TaskType>::ProcessBatch(std::unique_ptr<Batch<TaskType>> batch) {
       },
       profiler::ContextType::kSharedBatchScheduler,
       batch->traceme_context_id());
-  process_batch_callback_(std::move(batch));
+  uint64 processing_time_micros = 0;
+  if (options_.enable_deadline_aware_early_dispatch) {
+    const uint64 start_time_micros = env_->NowMicros();
+    process_batch_callback_(std::move(batch));
+    processing_time_micros = env_->NowMicros() - start_time_micros;
+  } else {
+    process_batch_callback_(std::move(batch));
+  }
 
   {
     mutex_lock l(mu_);
+    if (options_.enable_deadline_aware_early_dispatch) {
+      // An exponential moving average that weights the most recent batch at
+      // one quarter, so the estimate adapts without chasing outliers.
+      if (processing_time_estimate_micros_ == 0) {
+        processing_time_estimate_micros_ = processing_time_micros;
+      } else {
+        processing_time_estimate_micros_ =
+            (3 * processing_time_estimate_micros_ + processing_time_micros) /
+            4;
+      }
+    }
     --num_batches_being_processed_;
     if (empty_notification_ != nullptr && IsEmptyInternal()) {
       empty_notification_->Notify();
@@ -1134,6 +1232,7 @@ void Queue<TaskType>::StartNewBatch() {
   }
   batches_.back()->Close();
   batches_.emplace_back(new Batch<TaskType>(++traceme_context_id_counter_));
+  batch_earliest_deadlines_.push_back(BatchTask::kNoDeadlineMicros);
 }
 
 template <typename TaskType>
@@ -1153,9 +1252,19 @@ bool Queue<TaskType>::IsOpenBatchSchedulableAfterEagerSplit() const {
   if (open_batch->empty()) {
     return false;
   }
-  return closed_ || open_batch->size() >= max_execution_batch_size() ||
-         env_->NowMicros() >=
-             open_batch_start_time_micros_ + options_.batch_timeout_micros;
+  if (closed_ || open_batch->size() >= max_execution_batch_size() ||
+      env_->NowMicros() >=
+          open_batch_start_time_micros_ + options_.batch_timeout_micros) {
+    return true;
+  }
+  // Launch the partial batch early if waiting out the timeout would likely
+  // make its most urgent task miss its deadline.
+  if (options_.enable_deadline_aware_early_dispatch &&
+      batch_earliest_deadlines_.back() != BatchTask::kNoDeadlineMicros) {
+    return env_->NowMicros() + processing_time_estimate_micros_ >=
+           batch_earliest_deadlines_.back();
+  }
+  return false;
 }
 
 template <typename TaskType>
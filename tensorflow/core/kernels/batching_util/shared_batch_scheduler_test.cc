@@ -62,6 +62,18 @@ using SplitFunc =
                          int first_output_task_size, int input_batch_size_limit,
                          std::vector<std::unique_ptr<FakeTask>>* output_tasks)>;
 
+// A FakeTask with a deadline, for testing deadline-aware scheduling.
+class DeadlineTask : public FakeTask {
+ public:
+  DeadlineTask(size_t size, uint64 deadline_micros)
+      : FakeTask(size), deadline_micros_(deadline_micros) {}
+
+  uint64 deadline_micros() const override { return deadline_micros_; }
+
+ private:
+  const uint64 deadline_micros_;
+};
+
 // Creates a FakeTask of size 'task_size', and calls 'scheduler->Schedule()' on
 // that task. Returns the resulting status.
 Status ScheduleTask(size_t task_size, BatchScheduler<FakeTask>* scheduler) {
@@ -72,6 +84,16 @@ Status ScheduleTask(size_t task_size, BatchScheduler<FakeTask>* scheduler) {
   return status;
 }
 
+// Like ScheduleTask(), but the task's deadline is 'deadline_micros'.
+Status ScheduleTaskWithDeadline(size_t task_size, uint64 deadline_micros,
+                                BatchScheduler<FakeTask>* scheduler) {
+  std::unique_ptr<FakeTask> task(new DeadlineTask(task_size, deadline_micros));
+  Status status = scheduler->Schedule(&task);
+  // Schedule() should have consumed 'task' iff it returned Status::OK.
+  CHECK_EQ(status.ok(), task == nullptr);
+  return status;
+}
+
 // Creates a thread that waits on 'start' and then advances the fake clock in
 // 'env' in a loop until 'stop' is notified. Useful for allowing objects that
 // use the clock to be destroyed.
@@ -791,6 +813,137 @@ TEST_P(SharedBatchSchedulerTest, ZeroQueueRewrittenToOneQueue) {
   }
 }
 
+TEST(SharedBatchSchedulerDeadlineTest, LaunchesPartialBatchBeforeDeadline) {
+  // Set up a fake clock, which only advances when we explicitly tell it to.
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+
+  {
+    Notification first_batch_processed, second_batch_processed;
+    auto callback = [&](std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      if (!first_batch_processed.HasBeenNotified()) {
+        // Consume fake time, so the queue observes a processing-time estimate
+        // of 500 microseconds.
+        env.AdvanceByMicroseconds(500);
+        first_batch_processed.Notify();
+        return;
+      }
+      second_batch_processed.Notify();
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+
+    QueueOptions queue_options = tensorflow::serving::CreateQueueOptions(
+        10 /* max_execution_batch_size */, 10 /* input_batch_size_limit */,
+        10 * 1000 /* batch_timeout_micros */, 2 /* max_enqueued_batches */,
+        false /* enable_large_batch_splitting */, false /* enable_lazy_split */,
+        nullptr /* no split function */);
+    queue_options.enable_deadline_aware_early_dispatch = true;
+    auto queue = CreateQueue(scheduler, queue_options, callback);
+
+    // Create an underfull batch whose task's deadline is well below the batch
+    // timeout. Nothing is processed while the deadline is in the future (the
+    // processing-time estimate is still zero), and the batch launches as soon
+    // as the deadline is reached.
+    TF_ASSERT_OK(
+        ScheduleTaskWithDeadline(1, 100 /* deadline_micros */, queue.get()));
+    env.AdvanceByMicroseconds(99);
+    Env::Default()->SleepForMicroseconds(10 * 1000 /* 10 milliseconds */);
+    EXPECT_FALSE(first_batch_processed.HasBeenNotified());
+    env.AdvanceByMicroseconds(1);
+    first_batch_processed.WaitForNotification();
+
+    // The clock reads 600 and the processing-time estimate is 500. A task
+    // whose deadline leaves only 400 microseconds of slack is launched
+    // immediately, without any further clock advance.
+    TF_ASSERT_OK(
+        ScheduleTaskWithDeadline(1, 1000 /* deadline_micros */, queue.get()));
+    second_batch_processed.WaitForNotification();
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, RanksQueuesByDeadline) {
+  Notification blocker_entered, blocker_proceed;
+  auto blocker_callback = [&](std::unique_ptr<Batch<FakeTask>> batch) {
+    blocker_entered.Notify();
+    blocker_proceed.WaitForNotification();
+  };
+  mutex mu;
+  std::vector<int> processing_order;
+  Notification all_processed;
+  auto make_callback = [&](int queue_id) {
+    return [&, queue_id](std::unique_ptr<Batch<FakeTask>> batch) {
+      mutex_lock l(mu);
+      processing_order.push_back(queue_id);
+      if (processing_order.size() == 2) {
+        all_processed.Notify();
+      }
+    };
+  };
+
+  Scheduler::Options options;
+  options.num_batch_threads = 1;
+  options.rank_queues_by_deadline = true;
+  std::shared_ptr<Scheduler> scheduler;
+  TF_CHECK_OK(Scheduler::Create(options, &scheduler));
+
+  const QueueOptions queue_options = tensorflow::serving::CreateQueueOptions(
+      5 /* max_execution_batch_size */, 5 /* input_batch_size_limit */,
+      1 * 1000 * 1000 /* batch_timeout_micros */, 2 /* max_enqueued_batches */,
+      false /* enable_large_batch_splitting */, false /* enable_lazy_split */,
+      nullptr /* no split function */);
+  auto blocker_queue = CreateQueue(scheduler, queue_options, blocker_callback);
+  auto no_deadline_queue =
+      CreateQueue(scheduler, queue_options, make_callback(1));
+  auto deadline_queue = CreateQueue(scheduler, queue_options, make_callback(2));
+
+  // Occupy the single batch thread, then fill a batch in each of the other
+  // two queues while it is busy.
+  TF_ASSERT_OK(ScheduleTask(5, blocker_queue.get()));
+  blocker_entered.WaitForNotification();
+  TF_ASSERT_OK(ScheduleTask(5, no_deadline_queue.get()));
+  TF_ASSERT_OK(ScheduleTaskWithDeadline(5, 1 /* deadline_micros */,
+                                        deadline_queue.get()));
+  blocker_proceed.Notify();
+
+  all_processed.WaitForNotification();
+  // Round-robin would service the no-deadline queue first; deadline ranking
+  // must pick the queue holding the urgent task.
+  EXPECT_EQ(processing_order, std::vector<int>({2, 1}));
+}
+
+TEST(SharedBatchSchedulerDeadlineTest, InvalidEarlyDispatchOptions) {
+  auto callback = [](std::unique_ptr<Batch<FakeTask>> batch) {
+    // do nothing.
+  };
+
+  auto scheduler = CreateSharedBatchScheduler(2);
+
+  QueueOptions queue_options = tensorflow::serving::CreateQueueOptions(
+      10 /* max_execution_batch_size */, 10 /* input_batch_size_limit */,
+      100 * 1000 /* batch_timeout_micros */, 2 /* max_enqueued_batches */,
+      true /* enable_large_batch_splitting */, true /* enable_lazy_split */,
+      [](std::unique_ptr<FakeTask>* input_task, int open_batch_remaining_slot,
+         int max_batch_size,
+         std::vector<std::unique_ptr<FakeTask>>* output_tasks) -> Status {
+        output_tasks->push_back(std::move(*input_task));
+        return OkStatus();
+      });
+  queue_options.enable_deadline_aware_early_dispatch = true;
+  std::unique_ptr<Queue> queue;
+  EXPECT_THAT(
+      scheduler->AddQueue(queue_options, callback, &queue),
+      testing::StatusIs(error::INVALID_ARGUMENT,
+                        "enable_deadline_aware_early_dispatch is not "
+                        "supported when enable_lazy_split is enabled."));
+}
+
 // TODO(b/161857471):
 // Add test coverage when input-split and no-split returns differently.
 INSTANTIATE_TEST_SUITE_P(
@@ -57,6 +57,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/framework/scratch_buffer.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_slice.h"
@@ -303,26 +304,16 @@ class Im2ColConvFunctor {
         kMaxChunkSize / (filter_value_count * sizeof(T1));
     const int64_t chunk_value_count =
         (kMaxChunkSize + (sizeof(T1) - 1)) / sizeof(T1);
-    // Because memory allocation is very expensive on mobile platforms, try to
-    // allocate a persistent buffer that will be kept around between calls. We
-    // use TensorFlow's resource management to ensure that the memory will be
-    // released when the session is over.
-    Im2ColBufferResource<T1, chunk_value_count>* im2col_buffer_resource;
-    std::function<Status(Im2ColBufferResource<T1, chunk_value_count>**)>
-        creator = [](Im2ColBufferResource<T1, chunk_value_count>** resource) {
-          *resource = new Im2ColBufferResource<T1, chunk_value_count>();
-          return OkStatus();
-        };
-    OP_REQUIRES_OK(context, context->resource_manager()->LookupOrCreate(
-                                "Conv2d", "im2col_buffer",
-                                &im2col_buffer_resource, creator));
-    // This means that multiple ops can't be run simultaneously on different
-    // threads, because we have a single shared resource. The platforms this is
-    // aimed at have intra-op parallelism as their focus though, so it shouldn't
-    // be an issue.
-    mutex_lock lock_buffer(im2col_buffer_resource->mu);
-    core::ScopedUnref unref_buffer(im2col_buffer_resource);
-    T1* im2col_buffer = im2col_buffer_resource->data;
+    // Because memory allocation is very expensive on mobile platforms, use a
+    // persistent scratch buffer that is kept around between calls and
+    // released through TensorFlow's resource management when the session is
+    // over. The buffer is cached per kernel, so different convolution nodes
+    // no longer contend on one shared chunk.
+    ScratchBufferHandle<T1> im2col_scratch;
+    OP_REQUIRES_OK(context, GetScratchBuffer<T1>(context, "im2col",
+                                                 chunk_value_count,
+                                                 &im2col_scratch));
+    T1* im2col_buffer = im2col_scratch.data();
 
     const int64_t patch_count = (input_batches * output_height * output_width);
     const int64_t chunk_count =
@@ -191,6 +191,18 @@ class SelectV2Op : public OpKernel {
       return;
     }
 
+    // Fast path: when no input actually needs broadcasting, evaluate the
+    // select element-wise over the flattened tensors.  The Eigen broadcast
+    // evaluator used below defeats packet vectorization, while the flat
+    // select lowers to vectorized blends driven by the condition mask.
+    if (cond->shape() == output_shape && then->shape() == output_shape &&
+        else_->shape() == output_shape) {
+      functor::SelectFunctor<Device, T> func;
+      func(ctx->eigen_device<Device>(), output->flat<T>(), cond->flat<bool>(),
+           then->flat<T>(), else_->flat<T>());
+      return;
+    }
+
 #define HANDLE_DIM(NDIMS)                                            \
   {                                                                  \
     functor::BCastSelectFunctor<Device, T, NDIMS> func;              \
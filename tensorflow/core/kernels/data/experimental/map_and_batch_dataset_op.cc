@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/input_colocation_exemption_registry.h"
+#include "tensorflow/core/data/captured_function.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/stats_utils.h"
@@ -424,6 +425,26 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
         return;
       }
 
+      // When the mapped function is a pure projection of its inputs, write
+      // the projected components directly into the batch slices instead of
+      // producing an intermediate element through the function runtime. The
+      // write runs on a threadpool thread so that slice writes for different
+      // offsets proceed concurrently.
+      if (!dataset()->captured_func_->short_circuit_info().indices.empty()) {
+        (*ctx->runner())([this, ctx, result, offset,
+                          element = std::move(input_element)]() mutable {
+          Status status =
+              WriteProjectionToBatch(ctx, result, offset, std::move(element));
+          result->UpdateStatus(status, offset);
+          if (status.ok()) {
+            mutex_lock l(result->mu);
+            result->num_elements++;
+          }
+          CallCompleted(ctx, result);
+        });
+        return;
+      }
+
       std::shared_ptr<std::vector<Tensor>> return_values =
           std::make_shared<std::vector<Tensor>>();
       auto done = [this, ctx, result, return_values, offset](Status status) {
@@ -505,6 +526,61 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // Projects `element` through the function's short-circuit mapping and
+    // copies the projected components directly into the batch slices at
+    // `offset`, allocating the batch output if needed. Components whose last
+    // use this is are moved rather than copied, which lets the slice write
+    // steal string buffers.
+    Status WriteProjectionToBatch(const std::shared_ptr<IteratorContext>& ctx,
+                                  const std::shared_ptr<BatchResult>& result,
+                                  int64_t offset,
+                                  std::vector<Tensor>&& element) {
+      const ShortCircuitInfo& info =
+          dataset()->captured_func_->short_circuit_info();
+      const std::vector<Tensor>& captured_inputs =
+          dataset()->captured_func_->captured_inputs();
+      const int num_args = element.size();
+      auto return_values = std::make_shared<std::vector<Tensor>>();
+      return_values->reserve(info.indices.size());
+      for (size_t i = 0; i < info.indices.size(); ++i) {
+        if (info.indices[i] < num_args) {
+          if (info.can_move[i]) {
+            return_values->push_back(std::move(element[info.indices[i]]));
+          } else {
+            return_values->push_back(element[info.indices[i]]);
+          }
+        } else {
+          const int captured_index = info.indices[i] - num_args;
+          if (captured_index >= static_cast<int>(captured_inputs.size())) {
+            return errors::OutOfRange(
+                "Out of range access to captured inputs for function ",
+                dataset()->captured_func_->func().name(),
+                ". Index: ", captured_index,
+                ". Num captured inputs: ", captured_inputs.size());
+          }
+          return_values->push_back(captured_inputs[captured_index]);
+        }
+      }
+      TF_RETURN_IF_ERROR(EnsureOutputAllocated(ctx, result, return_values));
+      for (size_t i = 0; i < return_values->size(); ++i) {
+        Tensor& tensor = return_values->at(i);
+        Tensor* batch = &(result->output)[i];
+        if (tensor.NumElements() !=
+            (batch->NumElements() / batch->dim_size(0))) {
+          TensorShape batch_shape = batch->shape();
+          batch_shape.RemoveDim(0);
+          return errors::InvalidArgument(
+              "Cannot add tensor to the batch: number of elements does not "
+              "match. Shapes are: [tensor]: ",
+              tensor.shape().DebugString(),
+              ", [batch]: ", batch_shape.DebugString());
+        }
+        TF_RETURN_IF_ERROR(
+            batch_util::CopyElementToSlice(std::move(tensor), batch, offset));
+      }
+      return OkStatus();
+    }
+
     Status EnsureOutputAllocated(
         const std::shared_ptr<IteratorContext>& ctx,
         const std::shared_ptr<BatchResult>& result,
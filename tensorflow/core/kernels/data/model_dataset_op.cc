@@ -145,7 +145,12 @@ class ModelDatasetOp::Dataset : public DatasetBase {
     Status GetNextInternal(IteratorContext* ctx,
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
-      if (!ctx->model()) {
+      if (ctx->model()) {
+        // The upstream context already carries a model, so it can be forwarded
+        // as is without copying the per-call parameters.
+        return input_impl_->GetNext(ctx, out_tensors, end_of_sequence);
+      }
+      {
         mutex_lock l(mu_);
         TF_RETURN_IF_ERROR(EnsureOptimizationLoopThreadStarted(ctx));
       }
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/data/prefetch_autotuner.h"
 
+#include <algorithm>
+
 #include "tensorflow/core/framework/model.h"
 
 namespace tensorflow {
@@ -58,5 +60,35 @@ void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
   }
 }
 
+PrefetchStallTuner::PrefetchStallTuner(int64_t buffer_size_max)
+    : buffer_size_max_(buffer_size_max) {}
+
+void PrefetchStallTuner::RecordProduce(int64_t produce_us) {
+  ewma_produce_us_ = kAlpha * produce_us + (1 - kAlpha) * ewma_produce_us_;
+}
+
+int64_t PrefetchStallTuner::RecordConsume(int64_t now_us, int64_t stall_us,
+                                          int64_t current_size) {
+  ewma_stall_us_ = kAlpha * stall_us + (1 - kAlpha) * ewma_stall_us_;
+  if (current_size <= 0 || current_size >= buffer_size_max_) {
+    return current_size;
+  }
+  // Require the stall to be sustained (EWMA over threshold), non-trivial
+  // relative to the producer latency, and the producer to have proven it can
+  // fill the current buffer; rate-limit increases with a cooldown.
+  const double threshold =
+      std::max<double>(kStallThresholdUs, 0.05 * ewma_produce_us_);
+  if (stall_us > 0 && ewma_stall_us_ >= threshold && buffer_filled_ &&
+      now_us - last_increase_us_ >= kCooldownUs) {
+    last_increase_us_ = now_us;
+    buffer_filled_ = false;
+    // Restart the stall measurement at the new size.
+    ewma_stall_us_ = 0.0;
+    const int64_t increment = std::max<int64_t>(1, current_size / 2);
+    return std::min(buffer_size_max_, current_size + increment);
+  }
+  return current_size;
+}
+
 }  // namespace data
 }  // namespace tensorflow
@@ -66,6 +66,55 @@ class PrefetchAutotuner {
   Mode mode_ = Mode::kDisabled;
 };
 
+// Fast-path feedback controller for the prefetch buffer size.
+//
+// The model-based autotuner revisits buffer sizes at coarse optimization
+// intervals, which reacts too slowly to sources with bursty latency (e.g.
+// object store reads). PrefetchStallTuner supplements it between
+// optimization rounds: it tracks an EWMA of the producer latency and of the
+// consumer stall time observed per GetNext call, and recommends a larger
+// buffer as soon as sustained stalls indicate that the producer cannot hide
+// its latency at the current size.
+//
+// To guard against throughput-bound pipelines (where no amount of buffering
+// helps), the tuner only recommends growth if the producer managed to fill
+// the buffer since the last increase, mirroring PrefetchAutotuner. The tuner
+// never shrinks the buffer; the model optimization loop remains free to
+// lower the size at its next round, which then becomes the new baseline.
+//
+// PrefetchStallTuner is NOT thread safe.
+class PrefetchStallTuner {
+ public:
+  explicit PrefetchStallTuner(int64_t buffer_size_max);
+
+  // Records the latency of producing one element.
+  void RecordProduce(int64_t produce_us);
+
+  // Records that the producer filled the buffer to its current limit.
+  void RecordBufferFull() { buffer_filled_ = true; }
+
+  // Records one consumer GetNext call that stalled for `stall_us` (zero if an
+  // element was immediately available) and returns the recommended buffer
+  // size given the currently configured `current_size`. The recommendation
+  // is always >= `current_size` and <= the configured maximum.
+  int64_t RecordConsume(int64_t now_us, int64_t stall_us,
+                        int64_t current_size);
+
+ private:
+  // EWMA smoothing factor for the stall and producer-latency estimates.
+  static constexpr double kAlpha = 0.3;
+  // Minimum time between two buffer size increases.
+  static constexpr int64_t kCooldownUs = 1000;
+  // Stalls below this are treated as scheduling noise.
+  static constexpr int64_t kStallThresholdUs = 50;
+
+  const int64_t buffer_size_max_;
+  double ewma_produce_us_ = 0.0;
+  double ewma_stall_us_ = 0.0;
+  int64_t last_increase_us_ = 0;
+  bool buffer_filled_ = false;
+};
+
 }  // namespace data
 }  // namespace tensorflow
 
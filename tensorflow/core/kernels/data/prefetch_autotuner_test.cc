@@ -103,6 +103,56 @@ TEST(PrefetchAutotuner, StartWithMin) {
   }
 }
 
+TEST(PrefetchStallTuner, GrowsOnSustainedStalls) {
+  PrefetchStallTuner t(/*buffer_size_max=*/16);
+  t.RecordProduce(1000);
+  t.RecordBufferFull();
+  // No stall: no change.
+  EXPECT_EQ(2, t.RecordConsume(/*now_us=*/1000, /*stall_us=*/0,
+                               /*current_size=*/2));
+  // A stall with a full buffer: grow by half (rounded up to at least one).
+  EXPECT_EQ(3, t.RecordConsume(/*now_us=*/3000, /*stall_us=*/500,
+                               /*current_size=*/2));
+  // After an increase the buffer has to fill again before further growth.
+  t.RecordBufferFull();
+  // Still inside the cooldown window: no growth.
+  EXPECT_EQ(3, t.RecordConsume(/*now_us=*/3500, /*stall_us=*/500,
+                               /*current_size=*/3));
+  // Cooldown elapsed: grow again.
+  EXPECT_EQ(4, t.RecordConsume(/*now_us=*/5000, /*stall_us=*/500,
+                               /*current_size=*/3));
+}
+
+TEST(PrefetchStallTuner, RequiresFullBuffer) {
+  PrefetchStallTuner t(/*buffer_size_max=*/16);
+  int64_t now_us = 0;
+  // Without the producer ever filling the buffer, stalls indicate a
+  // throughput-bound pipeline and must not grow the buffer.
+  for (int i = 0; i < 10; ++i) {
+    now_us += 2000;
+    EXPECT_EQ(4, t.RecordConsume(now_us, /*stall_us=*/1000,
+                                 /*current_size=*/4));
+  }
+  t.RecordBufferFull();
+  now_us += 2000;
+  EXPECT_EQ(6, t.RecordConsume(now_us, /*stall_us=*/1000,
+                               /*current_size=*/4));
+}
+
+TEST(PrefetchStallTuner, RespectsMax) {
+  PrefetchStallTuner t(/*buffer_size_max=*/4);
+  t.RecordBufferFull();
+  int64_t now_us = 0;
+  for (int i = 0; i < 10; ++i) {
+    now_us += 2000;
+    t.RecordConsume(now_us, /*stall_us=*/1000, /*current_size=*/3);
+  }
+  t.RecordBufferFull();
+  now_us += 2000;
+  EXPECT_EQ(4, t.RecordConsume(now_us, /*stall_us=*/1000,
+                               /*current_size=*/4));
+}
+
 }  // namespace
 }  // namespace data
 }  // namespace tensorflow
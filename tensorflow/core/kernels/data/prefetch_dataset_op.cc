@@ -149,6 +149,9 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           buffer_size_min_(params.dataset->buffer_size_min_),
           auto_tuner_(params.dataset->buffer_size_, buffer_size_min_),
           legacy_autotune_(params.dataset->legacy_autotune_),
+          fast_autotune_(!params.dataset->legacy_autotune_ &&
+                         params.dataset->buffer_size_ == model::kAutotune),
+          stall_tuner_(std::numeric_limits<int64_t>::max()),
           // If `legacy_autotune_`, initialize the `buffer_size_` value to be 0
           // to avoid the created node to be collected as tunable nodes in the
           // autotuning optimization.
@@ -189,18 +192,35 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         TF_RETURN_IF_ERROR(EnsurePrefetchThreadStarted(ctx));
         // Wait until the next element in the buffer has been
         // produced, or we are shutting down.
+        int64_t stall_start_us = 0;
         while (buffer_.empty() && !prefetch_thread_finished_ &&
                buffer_limit() != 0) {
           if (legacy_autotune_) {
             auto_tuner_.RecordEmpty();
             buffer_size_->value = auto_tuner_.buffer_limit();
           }
+          if (fast_autotune_ && stall_start_us == 0) {
+            stall_start_us = EnvTime::NowMicros();
+          }
           RecordStop(ctx);
           cond_var_->wait(l);
           RecordStart(ctx);
         }
 
         if (!buffer_.empty()) {
+          if (fast_autotune_) {
+            const int64_t now_us = EnvTime::NowMicros();
+            const int64_t stall_us =
+                stall_start_us != 0 ? now_us - stall_start_us : 0;
+            const int64_t new_size =
+                stall_tuner_.RecordConsume(now_us, stall_us,
+                                           buffer_size_->value);
+            if (new_size != buffer_size_->value) {
+              VLOG(2) << "Growing prefetch buffer size to " << new_size
+                      << " after a " << stall_us << "us consumer stall";
+              buffer_size_->value = new_size;
+            }
+          }
           return Consume(ctx, out_tensors, end_of_sequence);
         }
 
@@ -468,6 +488,10 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         // 1. Wait for a slot in the buffer.
         {
           mutex_lock l(*mu_);
+          if (fast_autotune_ && buffer_limit() > 0 &&
+              buffer_.size() >= buffer_limit()) {
+            stall_tuner_.RecordBufferFull();
+          }
           while (!cancelled_ && buffer_.size() >= buffer_limit()) {
             RecordStop(ctx.get());
             cond_var_->wait(l);
@@ -497,6 +521,7 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         mutex_lock input_l(input_mu_);
         bool end_of_sequence = false;
         BufferElement buffer_element;
+        const int64_t produce_start_us = EnvTime::NowMicros();
         {
           profiler::TraceMe traceme(
               [&] {
@@ -517,6 +542,10 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         // 3. Signal that the element has been produced.
         {
           mutex_lock l(*mu_);
+          if (fast_autotune_) {
+            stall_tuner_.RecordProduce(EnvTime::NowMicros() -
+                                       produce_start_us);
+          }
           RecordBufferEnqueue(ctx.get(), buffer_element.value);
           buffer_element.created_us = EnvTime::NowMicros();
           buffer_.push_back(std::move(buffer_element));
@@ -584,6 +613,10 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
     bool cancelled_ TF_GUARDED_BY(*mu_) = false;
     bool prefetch_thread_finished_ TF_GUARDED_BY(*mu_) = false;
     const bool legacy_autotune_;
+    // Whether the per-GetNext stall feedback controller is active; only used
+    // with model-based autotuning of the buffer size.
+    const bool fast_autotune_;
+    PrefetchStallTuner stall_tuner_ TF_GUARDED_BY(*mu_);
 
     std::atomic<int64_t> slack_us_;
 
@@ -23,6 +23,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "tensorflow/core/data/arena_shuffle_buffer.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
@@ -37,6 +38,7 @@ limitations under the License.
 #include "tensorflow/core/lib/random/random_distributions.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -62,6 +64,19 @@ namespace data {
 const int64_t kLogIntervalMicros = 10 * 1000000;  // 10 seconds.
 const int64_t kMaxEpochsInBuffer = 3;
 
+// When set to a positive number of bytes, the shuffle buffer stores elements
+// in serialized form inside contiguous arena blocks of that size instead of
+// buffering them as tensors, trading CPU for a much smaller and less
+// fragmented memory footprint.
+constexpr char kArenaBlockBytesEnv[] = "TF_DATA_SHUFFLE_ARENA_BLOCK_BYTES";
+// Directory to which cold arena blocks are spilled. Spilling is disabled when
+// the variable is unset or empty.
+constexpr char kArenaSpillDirEnv[] = "TF_DATA_SHUFFLE_ARENA_SPILL_DIR";
+// Maximum number of sealed arena blocks kept in memory when spilling.
+constexpr char kArenaResidentBlocksEnv[] =
+    "TF_DATA_SHUFFLE_ARENA_RESIDENT_BLOCKS";
+constexpr int64_t kDefaultArenaResidentBlocks = 16;
+
 constexpr char kNumRandomSamples[] = "num_random_samples";
 constexpr char kDataProduced[] = "data_produced";
 constexpr char kEndOfInputSequence[] = "end_of_input_sequence";
@@ -198,8 +213,33 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
           seed_generator_(seed_generator),
           parent_generator_(seed_generator->seed(), seed_generator->seed2()),
           generator_(&parent_generator_) {
-      buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>(
-          params.dataset->buffer_size_);
+      int64_t arena_block_bytes = 0;
+      Status s =
+          ReadInt64FromEnvVar(kArenaBlockBytesEnv, 0, &arena_block_bytes);
+      if (!s.ok()) {
+        LOG(WARNING) << "Failed to read the shuffle buffer arena block size: "
+                     << s;
+      }
+      if (arena_block_bytes > 0) {
+        arena_ = std::make_unique<ArenaShuffleBuffer>(
+            params.dataset->buffer_size_, arena_block_bytes);
+        string spill_dir;
+        s = ReadStringFromEnvVar(kArenaSpillDirEnv, "", &spill_dir);
+        if (s.ok() && !spill_dir.empty()) {
+          int64_t resident_blocks = kDefaultArenaResidentBlocks;
+          ReadInt64FromEnvVar(kArenaResidentBlocksEnv,
+                              kDefaultArenaResidentBlocks, &resident_blocks)
+              .IgnoreError();
+          s = arena_->EnableSpilling(Env::Default(), spill_dir,
+                                     resident_blocks);
+        }
+        if (!s.ok()) {
+          LOG(WARNING) << "Failed to enable shuffle buffer spilling: " << s;
+        }
+      } else {
+        buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>(
+            params.dataset->buffer_size_);
+      }
     }
 
     Status Initialize(IteratorContext* ctx) override {
@@ -227,11 +267,17 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       // slice, and then remove the element from the slice.
       int64_t offset =
           Random() % (slices_.front()->end - slices_.front()->start);
-      int64_t index = (slices_.front()->start + offset) % buffer_->size();
-      *out_tensors = std::move(buffer_->at(index));
-      this->RecordBufferDequeue(ctx, *out_tensors);
-      std::swap(buffer_->at(index),
-                buffer_->at(slices_.front()->start % buffer_->size()));
+      int64_t index = (slices_.front()->start + offset) % BufferSize();
+      if (arena_) {
+        TF_RETURN_IF_ERROR(arena_->Extract(index, out_tensors));
+        this->RecordBufferDequeue(ctx, *out_tensors);
+        arena_->Swap(index, slices_.front()->start % BufferSize());
+      } else {
+        *out_tensors = std::move(buffer_->at(index));
+        this->RecordBufferDequeue(ctx, *out_tensors);
+        std::swap(buffer_->at(index),
+                  buffer_->at(slices_.front()->start % BufferSize()));
+      }
       slices_.front()->start++;
       num_elements_--;
       return OkStatus();
@@ -277,7 +323,20 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       TF_RETURN_IF_ERROR(writer->WriteScalar(this->full_name(kEpoch), epoch_));
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(this->full_name(kNumElements), num_elements_));
-      TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(writer, prefix(), *buffer_));
+      if (arena_) {
+        // Materialize the arena contents so that the checkpoint format is the
+        // same regardless of how the buffer is stored.
+        std::vector<std::vector<Tensor>> elements(BufferSize());
+        for (size_t i = 0; i < elements.size(); ++i) {
+          if (arena_->Contains(i)) {
+            TF_RETURN_IF_ERROR(arena_->Get(i, &elements[i]));
+          }
+        }
+        TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(writer, prefix(), elements));
+      } else {
+        TF_RETURN_IF_ERROR(
+            WriteElementsToCheckpoint(writer, prefix(), *buffer_));
+      }
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(this->full_name(kSlicesSize), slices_.size()));
       for (size_t i = 0; i < slices_.size(); ++i) {
@@ -332,13 +391,24 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
             reader->ReadScalar(this->full_name(kSlicesSize), &temp));
         slices_size = static_cast<size_t>(temp);
       }
-      buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>();
-      TF_RETURN_IF_ERROR(
-          ReadElementsFromCheckpoint(ctx, reader, prefix(), buffer_.get()));
-      for (const auto& element : *buffer_) {
-        RecordBufferEnqueue(ctx, element);
+      if (arena_) {
+        std::vector<std::vector<Tensor>> elements;
+        TF_RETURN_IF_ERROR(
+            ReadElementsFromCheckpoint(ctx, reader, prefix(), &elements));
+        for (size_t i = 0; i < elements.size() && i < arena_->num_slots();
+             ++i) {
+          RecordBufferEnqueue(ctx, elements[i]);
+          TF_RETURN_IF_ERROR(arena_->Put(i, elements[i]));
+        }
+      } else {
+        buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>();
+        TF_RETURN_IF_ERROR(
+            ReadElementsFromCheckpoint(ctx, reader, prefix(), buffer_.get()));
+        for (const auto& element : *buffer_) {
+          RecordBufferEnqueue(ctx, element);
+        }
+        buffer_->resize(dataset()->buffer_size_);
       }
-      buffer_->resize(dataset()->buffer_size_);
       slices_.clear();
       for (size_t i = 0; i < slices_size; ++i) {
         int64_t start;
@@ -400,7 +470,7 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         TF_RETURN_IF_ERROR(
             input_impl_->GetNext(ctx, &input_element, &end_of_input_sequence));
         if (!end_of_input_sequence) {
-          AddToShuffleBuffer(ctx, std::move(input_element));
+          TF_RETURN_IF_ERROR(AddToShuffleBuffer(ctx, std::move(input_element)));
           continue;
         }
         input_impl_.reset();
@@ -432,7 +502,7 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         // 1`.
         return false;
       }
-      return num_elements_ < buffer_->size();
+      return num_elements_ < static_cast<int64_t>(BufferSize());
     }
 
     Status PrepareNextEpoch(IteratorContext* ctx)
@@ -452,7 +522,8 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       return OkStatus();
     }
 
-    void AddToShuffleBuffer(IteratorContext* ctx, std::vector<Tensor>&& element)
+    Status AddToShuffleBuffer(IteratorContext* ctx,
+                              std::vector<Tensor>&& element)
         TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       data_produced_ = true;
       if (num_elements_ == 0) {
@@ -460,10 +531,15 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
                 << BufferSizeString();
       }
       this->RecordBufferEnqueue(ctx, element);
-      size_t index = slices_.back()->end % buffer_->size();
-      buffer_->at(index) = std::move(element);
+      size_t index = slices_.back()->end % BufferSize();
+      if (arena_) {
+        TF_RETURN_IF_ERROR(arena_->Put(index, element));
+      } else {
+        buffer_->at(index) = std::move(element);
+      }
       num_elements_++;
       slices_.back()->end++;
+      return OkStatus();
     }
 
     void ClearEmptySlices() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
@@ -477,14 +553,22 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       }
     }
 
+    size_t BufferSize() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      return arena_ ? arena_->num_slots() : buffer_->size();
+    }
+
     std::string BufferSizeString() {
       return absl::StrCat(dataset()->buffer_size_);
     }
 
     mutex mu_;
     SeedGenerator* const seed_generator_ TF_GUARDED_BY(mu_);  // Not owned.
+    // Exactly one of `buffer_` and `arena_` is used. The arena stores buffered
+    // elements in serialized form inside contiguous blocks and is enabled via
+    // the `TF_DATA_SHUFFLE_ARENA_BLOCK_BYTES` environment variable.
     std::unique_ptr<std::vector<std::vector<Tensor>>> buffer_
         TF_GUARDED_BY(mu_);
+    std::unique_ptr<ArenaShuffleBuffer> arena_ TF_GUARDED_BY(mu_);
     std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_) = nullptr;
     int64_t epoch_ TF_GUARDED_BY(mu_) = 0;
     int64_t num_elements_ TF_GUARDED_BY(mu_) = 0;
@@ -19,12 +19,15 @@ limitations under the License.
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/hash/crc32c.h"
 #include "tensorflow/core/lib/io/buffered_inputstream.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
 #include "tensorflow/core/lib/io/random_inputstream.h"
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tensorflow/core/platform/coding.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -52,6 +55,21 @@ bool is_cloud_tpu_gcs_fs() {
   return false;
 }
 
+// Returns true if the dataset should memory-map its files and read records
+// directly out of the mappings instead of going through a buffered stream.
+// Opt-in via TF_DATA_TFRECORD_MMAP=1; only available for uncompressed files,
+// and only on filesystems that support read-only memory regions (others fall
+// back to buffered reads per file).
+bool UseMmapForTFRecords(const string& compression_type) {
+  if (!compression_type.empty()) {
+    return false;
+  }
+  bool use_mmap = false;
+  ReadBoolFromEnvVar("TF_DATA_TFRECORD_MMAP", /*default_val=*/false, &use_mmap)
+      .IgnoreError();
+  return use_mmap;
+}
+
 class TFRecordDatasetOp::Dataset : public DatasetBase {
  public:
   explicit Dataset(OpKernelContext* ctx, std::vector<string> filenames,
@@ -60,7 +78,8 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         filenames_(std::move(filenames)),
         compression_type_(compression_type),
         options_(io::RecordReaderOptions::CreateRecordReaderOptions(
-            compression_type)) {
+            compression_type)),
+        use_mmap_(UseMmapForTFRecords(compression_type)) {
     if (buffer_size > 0) {
       options_.buffer_size = buffer_size;
     }
@@ -121,11 +140,13 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       mutex_lock l(mu_);
       do {
         // We are currently processing a file, so try to read the next record.
-        if (reader_) {
+        if (reader_ || mmap_region_) {
           out_tensors->emplace_back(ctx->allocator({}), DT_STRING,
                                     TensorShape({}));
           Status s =
-              reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
+              mmap_region_
+                  ? ReadMmapRecordLocked(&out_tensors->back().scalar<tstring>()())
+                  : reader_->ReadRecord(&out_tensors->back().scalar<tstring>()());
           if (s.ok()) {
             static monitoring::CounterCell* bytes_counter =
                 metrics::GetTFDataBytesReadCounter(kDatasetType);
@@ -167,10 +188,14 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       do {
         // We are currently processing a file, so try to skip reading
         // the next (num_to_skip - *num_skipped) record.
-        if (reader_) {
+        if (reader_ || mmap_region_) {
           int last_num_skipped;
-          Status s = reader_->SkipRecords(num_to_skip - *num_skipped,
-                                          &last_num_skipped);
+          Status s =
+              mmap_region_
+                  ? SkipMmapRecordsLocked(num_to_skip - *num_skipped,
+                                          &last_num_skipped)
+                  : reader_->SkipRecords(num_to_skip - *num_skipped,
+                                         &last_num_skipped);
           *num_skipped += last_num_skipped;
           if (s.ok()) {
             *end_of_sequence = false;
@@ -216,6 +241,9 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       if (reader_) {
         TF_RETURN_IF_ERROR(
             writer->WriteScalar(full_name(kOffset), reader_->TellOffset()));
+      } else if (mmap_region_) {
+        TF_RETURN_IF_ERROR(
+            writer->WriteScalar(full_name(kOffset), mmap_offset_));
       }
       return OkStatus();
     }
@@ -232,7 +260,16 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
         int64_t offset;
         TF_RETURN_IF_ERROR(reader->ReadScalar(full_name(kOffset), &offset));
         TF_RETURN_IF_ERROR(SetupStreamsLocked(ctx->env()));
-        TF_RETURN_IF_ERROR(reader_->SeekOffset(offset));
+        if (mmap_region_) {
+          if (static_cast<uint64>(offset) > mmap_region_->length()) {
+            return errors::DataLoss("Restored offset ", offset,
+                                    " is past the end of file ",
+                                    dataset()->filenames_[current_file_index_]);
+          }
+          mmap_offset_ = offset;
+        } else {
+          TF_RETURN_IF_ERROR(reader_->SeekOffset(offset));
+        }
       }
       return OkStatus();
     }
@@ -246,10 +283,24 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
             " >= filenames_.size():", dataset()->filenames_.size());
       }
 
+      const string translated_filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      if (dataset()->use_mmap_) {
+        std::unique_ptr<ReadOnlyMemoryRegion> region;
+        Status s =
+            env->NewReadOnlyMemoryRegionFromFile(translated_filename, &region);
+        if (s.ok()) {
+          mmap_region_ = std::move(region);
+          mmap_offset_ = 0;
+          return OkStatus();
+        }
+        VLOG(2) << "Failed to memory-map " << translated_filename << ": " << s
+                << "; falling back to buffered reads.";
+      }
+
       // Actually move on to next file.
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
+      TF_RETURN_IF_ERROR(
+          env->NewRandomAccessFile(translated_filename, &file_));
       reader_ = std::make_unique<io::SequentialRecordReader>(
           file_.get(), dataset()->options_);
       return OkStatus();
@@ -259,6 +310,80 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     void ResetStreamsLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       reader_.reset();
       file_.reset();
+      mmap_region_.reset();
+      mmap_offset_ = 0;
+    }
+
+    // Reads the record at `mmap_offset_` out of the current mapped region,
+    // copying its payload into *record, and advances `mmap_offset_` past the
+    // record. Returns OUT_OF_RANGE at a clean end of file and DATA_LOSS for
+    // a truncated or corrupted record.
+    Status ReadMmapRecordLocked(tstring* record)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      static constexpr size_t kHeaderSize = io::RecordReader::kHeaderSize;
+      static constexpr size_t kFooterSize = io::RecordReader::kFooterSize;
+      const char* base = static_cast<const char*>(mmap_region_->data());
+      const uint64 size = mmap_region_->length();
+      if (mmap_offset_ == size) {
+        return errors::OutOfRange("eof");
+      }
+      if (mmap_offset_ + kHeaderSize > size) {
+        return errors::DataLoss("truncated record at ", mmap_offset_);
+      }
+      const char* header = base + mmap_offset_;
+      if (crc32c::Unmask(core::DecodeFixed32(header + sizeof(uint64))) !=
+          crc32c::Value(header, sizeof(uint64))) {
+        return errors::DataLoss("corrupted record at ", mmap_offset_);
+      }
+      const uint64 length = core::DecodeFixed64(header);
+      const uint64 record_bytes = kHeaderSize + length + kFooterSize;
+      if (mmap_offset_ + record_bytes > size) {
+        return errors::DataLoss("truncated record at ", mmap_offset_);
+      }
+      const char* data = header + kHeaderSize;
+      if (crc32c::Unmask(core::DecodeFixed32(data + length)) !=
+          crc32c::Value(data, length)) {
+        return errors::DataLoss("corrupted record at ", mmap_offset_);
+      }
+      // Copy the payload out of the mapping: emitted tensors routinely
+      // outlive this iterator (prefetch buffers, tensors held by the caller),
+      // so they must not alias memory that is unmapped with it.
+      record->assign(data, length);
+      mmap_offset_ += record_bytes;
+      return OkStatus();
+    }
+
+    // Skips up to `num_to_skip` records in the current mapped region,
+    // validating the length checksum of each skipped record. Mirrors
+    // RecordReader::SkipRecords().
+    Status SkipMmapRecordsLocked(int num_to_skip, int* num_skipped)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      static constexpr size_t kHeaderSize = io::RecordReader::kHeaderSize;
+      static constexpr size_t kFooterSize = io::RecordReader::kFooterSize;
+      const char* base = static_cast<const char*>(mmap_region_->data());
+      const uint64 size = mmap_region_->length();
+      *num_skipped = 0;
+      for (int i = 0; i < num_to_skip; ++i) {
+        if (mmap_offset_ == size) {
+          return errors::OutOfRange("eof");
+        }
+        if (mmap_offset_ + kHeaderSize > size) {
+          return errors::DataLoss("truncated record at ", mmap_offset_);
+        }
+        const char* header = base + mmap_offset_;
+        if (crc32c::Unmask(core::DecodeFixed32(header + sizeof(uint64))) !=
+            crc32c::Value(header, sizeof(uint64))) {
+          return errors::DataLoss("corrupted record at ", mmap_offset_);
+        }
+        const uint64 length = core::DecodeFixed64(header);
+        const uint64 record_bytes = kHeaderSize + length + kFooterSize;
+        if (mmap_offset_ + record_bytes > size) {
+          return errors::DataLoss("truncated record at ", mmap_offset_);
+        }
+        mmap_offset_ += record_bytes;
+        ++*num_skipped;
+      }
+      return OkStatus();
     }
 
     mutex mu_;
@@ -268,11 +393,18 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
     // we must destroy `reader_` before `file_`.
     std::unique_ptr<RandomAccessFile> file_ TF_GUARDED_BY(mu_);
     std::unique_ptr<io::SequentialRecordReader> reader_ TF_GUARDED_BY(mu_);
+
+    // Memory-mapped state, used instead of `reader_`/`file_` when the
+    // dataset runs in mmap mode and the filesystem supports it. Holds the
+    // mapping of the file at `current_file_index_`.
+    std::unique_ptr<ReadOnlyMemoryRegion> mmap_region_ TF_GUARDED_BY(mu_);
+    uint64 mmap_offset_ TF_GUARDED_BY(mu_) = 0;
   };
 
   const std::vector<string> filenames_;
   const tstring compression_type_;
   io::RecordReaderOptions options_;
+  const bool use_mmap_;
 };
 
 TFRecordDatasetOp::TFRecordDatasetOp(OpKernelConstruction* ctx)
@@ -15,7 +15,10 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -23,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -39,9 +43,8 @@ class DynamicPartitionOp_Shared : public OpKernel {
     //   in the graph?
   }
 
-  void ValidateAndAllocateOutputs(OpKernelContext* c, const Tensor** data,
-                                  const Tensor** partitions,
-                                  OpOutputList* Tout) {
+  void ValidateInputs(OpKernelContext* c, const Tensor** data,
+                      const Tensor** partitions) {
     OP_REQUIRES_OK(c, c->input("data", data));
     OP_REQUIRES_OK(c, c->input("partitions", partitions));
     OP_REQUIRES(
@@ -51,6 +54,13 @@ class DynamicPartitionOp_Shared : public OpKernel {
             "data.shape must start with partitions.shape, ",
             "got data.shape = ", (*data)->shape().DebugString(),
             ", partitions.shape = ", (*partitions)->shape().DebugString()));
+  }
+
+  void ValidateAndAllocateOutputs(OpKernelContext* c, const Tensor** data,
+                                  const Tensor** partitions,
+                                  OpOutputList* Tout) {
+    ValidateInputs(c, data, partitions);
+    if (!c->status().ok()) return;
 
     // Count how many occurrences of each partition id we have in partitions
     gtl::InlinedVector<int, 32> partition_count(num_partitions_);
@@ -65,20 +75,94 @@ class DynamicPartitionOp_Shared : public OpKernel {
       partition_count[p]++;
     }
 
+    AllocateOutputs(c, *data, *partitions, partition_count.data(), Tout);
+  }
+
+  // Parallel variant of the counting pass.  The partition vector is split
+  // into `num_blocks` contiguous blocks of `block_size` ids and each block
+  // tallies its ids independently; exclusive prefix sums over the blocks
+  // then give every block a private, disjoint range of rows in each output.
+  // On return `(*block_offsets)[b * num_partitions_ + p]` is the first row
+  // of output `p` owned by block `b`.
+  void ValidateAndAllocateOutputsParallel(OpKernelContext* c,
+                                          const Tensor* data,
+                                          const Tensor* partitions,
+                                          int64_t num_blocks,
+                                          int64_t block_size,
+                                          std::vector<int64_t>* block_offsets,
+                                          OpOutputList* Tout) {
+    auto e_partitions = partitions->flat<int32>();
+    const int64_t N = e_partitions.dimension(0);
+    const int64_t P = num_partitions_;
+    std::vector<int64_t> block_counts(num_blocks * P, 0);
+    // Position and value of the first out-of-range id seen by each block, if
+    // any; the value is captured here because reporting re-reads from user
+    // memory that may be concurrently modified.
+    std::vector<int64_t> invalid_pos(num_blocks, -1);
+    std::vector<int32> invalid_val(num_blocks, 0);
+
+    auto worker_threads = c->device()->tensorflow_cpu_worker_threads();
+    Shard(num_blocks, worker_threads->workers, num_blocks,
+          block_size * sizeof(int32),
+          [&](int64_t begin_block, int64_t end_block) {
+            for (int64_t b = begin_block; b < end_block; b++) {
+              int64_t* counts = &block_counts[b * P];
+              const int64_t begin = b * block_size;
+              const int64_t end = std::min(N, begin + block_size);
+              for (int64_t i = begin; i < end; i++) {
+                const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+                if (!FastBoundsCheck(p, P)) {
+                  invalid_pos[b] = i;
+                  invalid_val[b] = p;
+                  break;
+                }
+                counts[p]++;
+              }
+            }
+          });
+
+    // Report the earliest invalid id with the same message as the serial
+    // counting pass.
+    for (int64_t b = 0; b < num_blocks; b++) {
+      const int64_t i = invalid_pos[b];
+      if (i >= 0) {
+        OP_REQUIRES(c, false,
+                    errors::InvalidArgument(
+                        "partitions", SliceDebugString(partitions->shape(), i),
+                        " = ", invalid_val[b], " is not in [0, ", P, ")"));
+      }
+    }
+
+    block_offsets->resize(num_blocks * P);
+    gtl::InlinedVector<int64_t, 32> partition_count(P);
+    for (int64_t b = 0; b < num_blocks; b++) {
+      for (int64_t p = 0; p < P; p++) {
+        (*block_offsets)[b * P + p] = partition_count[p];
+        partition_count[p] += block_counts[b * P + p];
+      }
+    }
+
+    AllocateOutputs(c, data, partitions, partition_count.data(), Tout);
+  }
+
+ protected:
+  template <typename CountType>
+  void AllocateOutputs(OpKernelContext* c, const Tensor* data,
+                       const Tensor* partitions,
+                       const CountType* partition_count, OpOutputList* Tout) {
     // Allocate output tensors of the right size
     OP_REQUIRES_OK(c, c->output_list("outputs", Tout));
     for (int p = 0; p < num_partitions_; p++) {
       TensorShape shape;
       shape.AddDim(partition_count[p]);
-      for (int i = (*partitions)->dims(); i < (*data)->dims(); i++) {
-        shape.AddDim((*data)->dim_size(i));
+      for (int i = partitions->dims(); i < data->dims(); i++) {
+        shape.AddDim(data->dim_size(i));
       }
       Tensor* out;
       OP_REQUIRES_OK(c, Tout->allocate(p, shape, &out));
     }
   }
 
- protected:
   int num_partitions_;
 };
 
@@ -90,6 +174,24 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
   void Compute(OpKernelContext* c) override {
     const Tensor* data;
     const Tensor* partitions;
+    ValidateInputs(c, &data, &partitions);
+    if (!c->status().ok()) return;
+
+    // For large inputs of memcpy-able types, count per block in parallel and
+    // turn exclusive prefix sums into non-overlapping output ranges so the
+    // copies can also run in parallel, instead of the serial scatter below.
+    if (num_partitions_ > 0 && data->NumElements() > 0) {
+      auto worker_threads = c->device()->tensorflow_cpu_worker_threads();
+      const int64_t N = partitions->NumElements();
+      const int64_t num_blocks =
+          std::min<int64_t>(worker_threads->num_threads,
+                            (N + kMinBlockSize - 1) / kMinBlockSize);
+      if (num_blocks > 1 && DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
+        ComputeParallel(c, data, partitions, num_blocks);
+        return;
+      }
+    }
+
     OpOutputList outputs;
     ValidateAndAllocateOutputs(c, &data, &partitions, &outputs);
     if (!c->status().ok()) return;
@@ -156,6 +258,73 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
       }
     }
   }
+
+ private:
+  // Minimum number of partition ids assigned to a block of the parallel
+  // path; below one block's worth the serial scatter is cheaper than the
+  // extra counting pass.
+  static constexpr int64_t kMinBlockSize = 1 << 12;
+
+  void ComputeParallel(OpKernelContext* c, const Tensor* data,
+                       const Tensor* partitions, int64_t num_blocks) {
+    auto e_partitions = partitions->flat<int32>();
+    const int64_t N = e_partitions.dimension(0);
+    const int64_t P = num_partitions_;
+    const int64_t block_size = (N + num_blocks - 1) / num_blocks;
+    num_blocks = (N + block_size - 1) / block_size;
+
+    std::vector<int64_t> block_offsets;
+    OpOutputList outputs;
+    ValidateAndAllocateOutputsParallel(c, data, partitions, num_blocks,
+                                       block_size, &block_offsets, &outputs);
+    if (!c->status().ok()) return;
+
+    const int64_t slice_size = data->NumElements() / N;
+    const size_t slice_bytes = slice_size * sizeof(T);
+    const T* data_base = data->flat<T>().data();
+    gtl::InlinedVector<T*, 32> out_base(P);
+    for (int64_t p = 0; p < P; p++) {
+      out_base[p] = outputs[p]->flat<T>().data();
+    }
+
+    // Each block copies into the output ranges assigned to it by the prefix
+    // sums, so no synchronization between blocks is needed.  The partition
+    // ids are read a second time here; if another thread overwrites them
+    // concurrently a block could run past its range, so bounds are
+    // re-checked like the serial path does.
+    std::atomic<bool> out_of_range(false);
+    auto worker_threads = c->device()->tensorflow_cpu_worker_threads();
+    Shard(num_blocks, worker_threads->workers, num_blocks,
+          block_size * slice_bytes,
+          [&](int64_t begin_block, int64_t end_block) {
+            for (int64_t b = begin_block; b < end_block; b++) {
+              gtl::InlinedVector<int64_t, 32> offset(P);
+              gtl::InlinedVector<int64_t, 32> limit(P);
+              for (int64_t p = 0; p < P; p++) {
+                offset[p] = block_offsets[b * P + p];
+                limit[p] = b + 1 < num_blocks
+                               ? block_offsets[(b + 1) * P + p]
+                               : outputs[p]->dim_size(0);
+              }
+              const int64_t begin = b * block_size;
+              const int64_t end = std::min(N, begin + block_size);
+              for (int64_t i = begin; i < end; i++) {
+                const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+                if (!FastBoundsCheck(p, P) || offset[p] >= limit[p]) {
+                  out_of_range = true;
+                  return;
+                }
+                memcpy(out_base[p] + offset[p] * slice_size,
+                       data_base + i * slice_size, slice_bytes);
+                offset[p]++;
+              }
+            }
+          });
+    OP_REQUIRES(
+        c, !out_of_range.load(),
+        errors::InvalidArgument("partitions have been asynchronously "
+                                "overwritten and are no longer in range!"));
+  }
 };
 
 #define REGISTER_DYNAMIC_PARTITION(T)                                     \
@@ -159,6 +159,40 @@ TEST_F(DynamicPartitionOpTest, Error_IndexOutOfRange) {
       << s;
 }
 
+TEST_F(DynamicPartitionOpTest, Large_TwoD) {
+  MakeOp();
+
+  // Large enough to take the parallel (blocked two-pass) code path.
+  const int kRows = 1 << 16;
+  AddInput<float>(TensorShape({kRows, 3}),
+                  [](int i) -> float { return i / 3; });
+  AddInput<int32>(TensorShape({kRows}), [](int i) -> int32 { return i % 4; });
+  TF_ASSERT_OK(RunOpKernel());
+
+  for (int p = 0; p < 4; p++) {
+    Tensor expected(allocator(), DT_FLOAT, TensorShape({kRows / 4, 3}));
+    test::FillFn<float>(&expected,
+                        [p](int i) -> float { return 4 * (i / 3) + p; });
+    test::ExpectTensorEqual<float>(expected, *GetOutput(p));
+  }
+}
+
+TEST_F(DynamicPartitionOpTest, Error_IndexOutOfRange_Large) {
+  MakeOp();
+
+  // Same as Error_IndexOutOfRange, but large enough to take the parallel
+  // code path.
+  const int kRows = 1 << 16;
+  AddInput<float>(TensorShape({kRows, 3}),
+                  [](int i) -> float { return i / 3; });
+  AddInput<int32>(TensorShape({kRows}),
+                  [](int i) -> int32 { return i == 12345 ? 99 : i % 4; });
+  Status s = RunOpKernel();
+  EXPECT_TRUE(absl::StrContains(s.ToString(),
+                                "partitions[12345] = 99 is not in [0, 4)"))
+      << s;
+}
+
 Node* DynamicPartitionNode(Graph* g, Node* in0, Node* in1, int num_partitions) {
   Node* ret;
   TF_CHECK_OK(NodeBuilder(g->NewName("n"), "DynamicPartition")
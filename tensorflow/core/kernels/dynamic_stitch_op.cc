@@ -15,6 +15,9 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
+#include <vector>
+
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -290,21 +293,58 @@ class DynamicStitchOpImplCPU : public DynamicStitchOpImplBase<T> {
           c->device()->tensorflow_cpu_worker_threads()->num_threads > 1) {
         auto thread_pool =
             c->device()->tensorflow_cpu_worker_threads()->workers;
-        size_t total_indices_size = 0;
+        // Cumulative slice counts, so that a range of the flattened slice
+        // index space can be mapped back to (input_num, position).
+        std::vector<int64_t> input_offsets(indices_inputs.size() + 1, 0);
         for (int input_num = 0; input_num < indices_inputs.size();
              ++input_num) {
-          total_indices_size += indices_inputs[input_num].NumElements();
+          input_offsets[input_num + 1] =
+              input_offsets[input_num] +
+              indices_inputs[input_num].NumElements();
+        }
+        const int64_t total_indices_size = input_offsets.back();
+        if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
+          // Shard over the flattened slice index space rather than over
+          // inputs, so that a few large inputs still spread across all
+          // threads.  This op makes no ordering guarantee for duplicate
+          // indices, so slices of one input may be copied concurrently.
+          T* merged_base = merged_flat.data();
+          auto LoopBody = [&](int64_t first, int64_t last) {
+            int input_num =
+                std::upper_bound(input_offsets.begin(), input_offsets.end(),
+                                 first) -
+                input_offsets.begin() - 1;
+            for (int64_t flat = first; flat < last; ++input_num) {
+              auto indices_vec = indices_inputs[input_num].flat<int32>();
+              const T* data_base =
+                  data_inputs[input_num].template flat<T>().data();
+              const int64_t input_last =
+                  std::min(last, input_offsets[input_num + 1]);
+              for (; flat < input_last; ++flat) {
+                const int64_t i = flat - input_offsets[input_num];
+                int32_t index = internal::SubtleMustCopy(indices_vec(i));
+                OP_REQUIRES(
+                    c, FastBoundsCheck(index, first_dim_size),
+                    errors::InvalidArgument("indices[", i,
+                                            "] is out of range"));
+                memcpy(merged_base + index * slice_size,
+                       data_base + i * slice_size, slice_bytes);
+              }
+            }
+          };
+          thread_pool->ParallelFor(total_indices_size, slice_bytes, LoopBody);
+        } else {
+          const double avg_indices_size =
+              static_cast<double>(total_indices_size) / indices_inputs.size();
+          auto bytes_processed = slice_bytes * avg_indices_size;
+          auto LoopBody = [&](int first, int last) {
+            for (int input_num = first; input_num < last; ++input_num) {
+              OnInputNumber(input_num);
+            }
+          };
+          thread_pool->ParallelFor(indices_inputs.size(), bytes_processed,
+                                   LoopBody);
         }
-        const double avg_indices_size =
-            static_cast<double>(total_indices_size) / indices_inputs.size();
-        auto bytes_processed = slice_bytes * avg_indices_size;
-        auto LoopBody = [&](int first, int last) {
-          for (int input_num = first; input_num < last; ++input_num) {
-            OnInputNumber(input_num);
-          }
-        };
-        thread_pool->ParallelFor(indices_inputs.size(), bytes_processed,
-                                 LoopBody);
       } else {
         for (int input_num = 0; input_num < indices_inputs.size();
              input_num++) {
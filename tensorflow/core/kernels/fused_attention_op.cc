@@ -0,0 +1,203 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Tile sizes for the streaming softmax. A kQueryBlock x kKeyBlock score tile
+// is recomputed for every key block, so only the tile, the current key and
+// value rows and the running accumulator have to stay cache resident instead
+// of the full [query_rows, key_rows] score matrix.
+constexpr int64_t kQueryBlock = 32;
+constexpr int64_t kKeyBlock = 256;
+
+}  // namespace
+
+// Scaled dot-product attention, Softmax(scale * query x key^T) x value,
+// evaluated block-wise with an online softmax so the score matrix is never
+// materialized. Created by the grappler remapper; see FindFusedAttention in
+// grappler/optimizers/remapper.cc.
+template <typename T>
+class FusedAttentionOp : public OpKernel {
+ public:
+  explicit FusedAttentionOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("scale", &scale_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& query = context->input(0);
+    const Tensor& key = context->input(1);
+    const Tensor& value = context->input(2);
+
+    OP_REQUIRES(
+        context,
+        query.dims() >= 3 && key.dims() == query.dims() &&
+            value.dims() == query.dims(),
+        errors::InvalidArgument(
+            "query, key and value must have the same rank >= 3, got ",
+            query.shape().DebugString(), ", ", key.shape().DebugString(),
+            " and ", value.shape().DebugString()));
+    const int dims = query.dims();
+    int64_t batch = 1;
+    for (int i = 0; i < dims - 2; ++i) {
+      OP_REQUIRES(context,
+                  key.dim_size(i) == query.dim_size(i) &&
+                      value.dim_size(i) == query.dim_size(i),
+                  errors::InvalidArgument(
+                      "query, key and value must have equal leading "
+                      "dimensions, got ",
+                      query.shape().DebugString(), ", ",
+                      key.shape().DebugString(), " and ",
+                      value.shape().DebugString()));
+      batch *= query.dim_size(i);
+    }
+    const int64_t q_rows = query.dim_size(dims - 2);
+    const int64_t depth = query.dim_size(dims - 1);
+    const int64_t k_rows = key.dim_size(dims - 2);
+    const int64_t v_depth = value.dim_size(dims - 1);
+    OP_REQUIRES(context, key.dim_size(dims - 1) == depth,
+                errors::InvalidArgument("key depth must match query depth (",
+                                        depth, "), got ",
+                                        key.shape().DebugString()));
+    OP_REQUIRES(context, value.dim_size(dims - 2) == k_rows,
+                errors::InvalidArgument("value must have one row per key row (",
+                                        k_rows, "), got ",
+                                        value.shape().DebugString()));
+
+    TensorShape output_shape = query.shape();
+    output_shape.set_dim(dims - 1, v_depth);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+    OP_REQUIRES(context, k_rows > 0,
+                errors::InvalidArgument(
+                    "key and value must have at least one row"));
+
+    const T* q_data = query.flat<T>().data();
+    const T* k_data = key.flat<T>().data();
+    const T* v_data = value.flat<T>().data();
+    T* out_data = output->flat<T>().data();
+    const float scale = scale_;
+    const int64_t query_blocks = (q_rows + kQueryBlock - 1) / kQueryBlock;
+    const int64_t total_blocks = batch * query_blocks;
+
+    auto compute_block = [&](int64_t begin, int64_t end) {
+      // Scratch is reused for every block handled by this shard.
+      std::vector<float> scores(kQueryBlock * kKeyBlock);
+      std::vector<float> row_max(kQueryBlock);
+      std::vector<float> row_sum(kQueryBlock);
+      std::vector<float> acc(kQueryBlock * v_depth);
+      for (int64_t block = begin; block < end; ++block) {
+        const int64_t b = block / query_blocks;
+        const int64_t q_start = (block % query_blocks) * kQueryBlock;
+        const int64_t q_count = std::min(kQueryBlock, q_rows - q_start);
+        const T* q = q_data + (b * q_rows + q_start) * depth;
+        const T* k = k_data + b * k_rows * depth;
+        const T* v = v_data + b * k_rows * v_depth;
+        T* out = out_data + (b * q_rows + q_start) * v_depth;
+
+        std::fill(row_max.begin(), row_max.end(),
+                  -std::numeric_limits<float>::infinity());
+        std::fill(row_sum.begin(), row_sum.end(), 0.0f);
+        std::fill(acc.begin(), acc.end(), 0.0f);
+
+        for (int64_t k_start = 0; k_start < k_rows; k_start += kKeyBlock) {
+          const int64_t k_count = std::min(kKeyBlock, k_rows - k_start);
+          // Score tile for the current query and key blocks.
+          for (int64_t i = 0; i < q_count; ++i) {
+            const T* qi = q + i * depth;
+            float* si = scores.data() + i * kKeyBlock;
+            for (int64_t j = 0; j < k_count; ++j) {
+              const T* kj = k + (k_start + j) * depth;
+              float dot = 0.0f;
+              for (int64_t e = 0; e < depth; ++e) {
+                dot += static_cast<float>(qi[e]) * static_cast<float>(kj[e]);
+              }
+              si[j] = scale * dot;
+            }
+          }
+          // Online softmax: when the running row maximum grows, rescale the
+          // running sum and accumulator, then fold in the current tile.
+          for (int64_t i = 0; i < q_count; ++i) {
+            const float* si = scores.data() + i * kKeyBlock;
+            float tile_max = -std::numeric_limits<float>::infinity();
+            for (int64_t j = 0; j < k_count; ++j) {
+              tile_max = std::max(tile_max, si[j]);
+            }
+            const float new_max = std::max(row_max[i], tile_max);
+            const float correction = std::exp(row_max[i] - new_max);
+            row_max[i] = new_max;
+            row_sum[i] *= correction;
+            float* acci = acc.data() + i * v_depth;
+            for (int64_t e = 0; e < v_depth; ++e) {
+              acci[e] *= correction;
+            }
+            for (int64_t j = 0; j < k_count; ++j) {
+              const float p = std::exp(si[j] - new_max);
+              row_sum[i] += p;
+              const T* vj = v + (k_start + j) * v_depth;
+              for (int64_t e = 0; e < v_depth; ++e) {
+                acci[e] += p * static_cast<float>(vj[e]);
+              }
+            }
+          }
+        }
+        for (int64_t i = 0; i < q_count; ++i) {
+          const float inv_sum = 1.0f / row_sum[i];
+          const float* acci = acc.data() + i * v_depth;
+          T* outi = out + i * v_depth;
+          for (int64_t e = 0; e < v_depth; ++e) {
+            outi[e] = static_cast<T>(acci[e] * inv_sum);
+          }
+        }
+      }
+    };
+
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t cost_per_block = kQueryBlock * k_rows * (depth + v_depth);
+    Shard(worker_threads->num_threads, worker_threads->workers, total_blocks,
+          cost_per_block, compute_block);
+  }
+
+ private:
+  float scale_;
+};
+
+#define REGISTER_FUSED_ATTENTION(T)                                      \
+  REGISTER_KERNEL_BUILDER(                                               \
+      Name("_FusedAttention").Device(DEVICE_CPU).TypeConstraint<T>("T"), \
+      FusedAttentionOp<T>);
+
+REGISTER_FUSED_ATTENTION(float);
+REGISTER_FUSED_ATTENTION(bfloat16);
+
+#undef REGISTER_FUSED_ATTENTION
+
+}  // namespace tensorflow
@@ -0,0 +1,270 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Implements _FusedCwiseChain, an interpreted single-pass executor for chains
+// of element-wise ops created by grappler's remapper (see the op registration
+// in core/ops/math_ops.cc). Instead of materializing one intermediate tensor
+// per chained op, the kernel streams the input through the whole chain one
+// cache-sized block at a time, so the tensor crosses the memory bus once.
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+
+namespace tensorflow {
+
+namespace {
+
+// One fused element-wise op. Binary stages combine the chained value with a
+// scalar side input; `swapped` marks chains where the chained value is the
+// second operand (e.g. `scalar - value`).
+enum class StageKind {
+  // Unary.
+  kAbs,
+  kCeil,
+  kExp,
+  kFloor,
+  kLog,
+  kNeg,
+  kRelu,
+  kRelu6,
+  kRsqrt,
+  kSigmoid,
+  kSqrt,
+  kSquare,
+  kTanh,
+  // Binary, with a scalar side input.
+  kAdd,
+  kSub,
+  kMul,
+  kDiv,
+  kMaximum,
+  kMinimum,
+};
+
+struct Stage {
+  StageKind kind;
+  bool is_binary;
+  bool swapped;
+};
+
+Status ParseStageKind(const string& op_name, Stage* stage) {
+  static const auto* kStageByName = new std::map<string, Stage>{
+      {"Abs", {StageKind::kAbs, false, false}},
+      {"Ceil", {StageKind::kCeil, false, false}},
+      {"Exp", {StageKind::kExp, false, false}},
+      {"Floor", {StageKind::kFloor, false, false}},
+      {"Log", {StageKind::kLog, false, false}},
+      {"Neg", {StageKind::kNeg, false, false}},
+      {"Relu", {StageKind::kRelu, false, false}},
+      {"Relu6", {StageKind::kRelu6, false, false}},
+      {"Rsqrt", {StageKind::kRsqrt, false, false}},
+      {"Sigmoid", {StageKind::kSigmoid, false, false}},
+      {"Sqrt", {StageKind::kSqrt, false, false}},
+      {"Square", {StageKind::kSquare, false, false}},
+      {"Tanh", {StageKind::kTanh, false, false}},
+      {"Add", {StageKind::kAdd, true, false}},
+      {"AddV2", {StageKind::kAdd, true, false}},
+      {"Sub", {StageKind::kSub, true, false}},
+      {"Mul", {StageKind::kMul, true, false}},
+      {"Div", {StageKind::kDiv, true, false}},
+      {"RealDiv", {StageKind::kDiv, true, false}},
+      {"Maximum", {StageKind::kMaximum, true, false}},
+      {"Minimum", {StageKind::kMinimum, true, false}},
+  };
+  auto it = kStageByName->find(op_name);
+  if (it == kStageByName->end()) {
+    return errors::InvalidArgument("Unsupported fused cwise op: ", op_name);
+  }
+  *stage = it->second;
+  return OkStatus();
+}
+
+// Applies one stage to `n` elements from `src` into `dst` (the two may
+// alias). The switch lives outside the element loop so each case is a tight
+// loop the compiler can vectorize.
+template <typename T>
+void ApplyStage(const Stage& stage, T scalar, const T* src, T* dst, int64_t n) {
+  switch (stage.kind) {
+    case StageKind::kAbs:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::abs(src[i]);
+      break;
+    case StageKind::kCeil:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::ceil(src[i]);
+      break;
+    case StageKind::kExp:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::exp(src[i]);
+      break;
+    case StageKind::kFloor:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::floor(src[i]);
+      break;
+    case StageKind::kLog:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::log(src[i]);
+      break;
+    case StageKind::kNeg:
+      for (int64_t i = 0; i < n; ++i) dst[i] = -src[i];
+      break;
+    case StageKind::kRelu:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::max(src[i], T(0));
+      break;
+    case StageKind::kRelu6:
+      for (int64_t i = 0; i < n; ++i)
+        dst[i] = std::min(std::max(src[i], T(0)), T(6));
+      break;
+    case StageKind::kRsqrt:
+      for (int64_t i = 0; i < n; ++i) dst[i] = T(1) / std::sqrt(src[i]);
+      break;
+    case StageKind::kSigmoid:
+      for (int64_t i = 0; i < n; ++i) dst[i] = T(1) / (T(1) + std::exp(-src[i]));
+      break;
+    case StageKind::kSqrt:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::sqrt(src[i]);
+      break;
+    case StageKind::kSquare:
+      for (int64_t i = 0; i < n; ++i) dst[i] = src[i] * src[i];
+      break;
+    case StageKind::kTanh:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::tanh(src[i]);
+      break;
+    case StageKind::kAdd:
+      for (int64_t i = 0; i < n; ++i) dst[i] = src[i] + scalar;
+      break;
+    case StageKind::kSub:
+      if (stage.swapped) {
+        for (int64_t i = 0; i < n; ++i) dst[i] = scalar - src[i];
+      } else {
+        for (int64_t i = 0; i < n; ++i) dst[i] = src[i] - scalar;
+      }
+      break;
+    case StageKind::kMul:
+      for (int64_t i = 0; i < n; ++i) dst[i] = src[i] * scalar;
+      break;
+    case StageKind::kDiv:
+      if (stage.swapped) {
+        for (int64_t i = 0; i < n; ++i) dst[i] = scalar / src[i];
+      } else {
+        for (int64_t i = 0; i < n; ++i) dst[i] = src[i] / scalar;
+      }
+      break;
+    case StageKind::kMaximum:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::max(src[i], scalar);
+      break;
+    case StageKind::kMinimum:
+      for (int64_t i = 0; i < n; ++i) dst[i] = std::min(src[i], scalar);
+      break;
+  }
+}
+
+template <typename T>
+class FusedCwiseChainOp : public OpKernel {
+ public:
+  explicit FusedCwiseChainOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    std::vector<string> fused_ops;
+    OP_REQUIRES_OK(context, context->GetAttr("fused_ops", &fused_ops));
+    OP_REQUIRES(context, !fused_ops.empty(),
+                errors::InvalidArgument(
+                    "_FusedCwiseChain requires at least one fused op"));
+    std::vector<bool> swapped_inputs;
+    OP_REQUIRES_OK(context,
+                   context->GetAttr("swapped_inputs", &swapped_inputs));
+    OP_REQUIRES(
+        context,
+        swapped_inputs.empty() || swapped_inputs.size() == fused_ops.size(),
+        errors::InvalidArgument("swapped_inputs must be empty or match "
+                                "fused_ops in length, got ",
+                                swapped_inputs.size(), " and ",
+                                fused_ops.size()));
+
+    num_binary_stages_ = 0;
+    for (int i = 0; i < static_cast<int>(fused_ops.size()); ++i) {
+      Stage stage;
+      OP_REQUIRES_OK(context, ParseStageKind(fused_ops[i], &stage));
+      if (stage.is_binary) {
+        if (!swapped_inputs.empty()) stage.swapped = swapped_inputs[i];
+        ++num_binary_stages_;
+      }
+      stages_.push_back(stage);
+    }
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& input = context->input(0);
+
+    OpInputList args;
+    OP_REQUIRES_OK(context, context->input_list("args", &args));
+    OP_REQUIRES(context, args.size() == num_binary_stages_,
+                errors::InvalidArgument("Expected one scalar argument per "
+                                        "binary fused op (",
+                                        num_binary_stages_, "), got ",
+                                        args.size()));
+    std::vector<T> scalars;
+    scalars.reserve(args.size());
+    for (int i = 0; i < args.size(); ++i) {
+      OP_REQUIRES(context, args[i].NumElements() == 1,
+                  errors::InvalidArgument(
+                      "Fused cwise chain arguments must be scalars, argument ",
+                      i, " has shape ", args[i].shape().DebugString()));
+      scalars.push_back(args[i].flat<T>()(0));
+    }
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, input.shape(), &output));
+
+    const T* in = input.flat<T>().data();
+    T* out = output->flat<T>().data();
+    const int64_t num_elements = input.NumElements();
+
+    // Push each block through the entire chain before moving to the next one,
+    // so intermediate values stay cache-resident. The first stage reads from
+    // the input; later stages run in place on the output.
+    for (int64_t begin = 0; begin < num_elements; begin += kBlockSize) {
+      const int64_t n = std::min(kBlockSize, num_elements - begin);
+      const T* src = in + begin;
+      T* dst = out + begin;
+      int arg_index = 0;
+      for (const Stage& stage : stages_) {
+        const T scalar = stage.is_binary ? scalars[arg_index++] : T(0);
+        ApplyStage(stage, scalar, src, dst, n);
+        src = dst;
+      }
+    }
+  }
+
+ private:
+  static constexpr int64_t kBlockSize = 4096;
+
+  std::vector<Stage> stages_;
+  int num_binary_stages_;
+};
+
+}  // namespace
+
+REGISTER_KERNEL_BUILDER(
+    Name("_FusedCwiseChain").Device(DEVICE_CPU).TypeConstraint<float>("T"),
+    FusedCwiseChainOp<float>);
+REGISTER_KERNEL_BUILDER(
+    Name("_FusedCwiseChain").Device(DEVICE_CPU).TypeConstraint<double>("T"),
+    FusedCwiseChainOp<double>);
+
+}  // namespace tensorflow
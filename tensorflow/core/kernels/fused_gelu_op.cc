@@ -0,0 +1,82 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#define EIGEN_USE_THREADS
+
+#include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+
+namespace tensorflow {
+
+typedef Eigen::ThreadPoolDevice CPUDevice;
+
+// Gaussian error linear unit evaluated in one elementwise pass instead of the
+// half dozen primitive ops the python api decomposes into. Created by the
+// grappler remapper; see FindGelu in grappler/optimizers/remapper.cc.
+template <typename T>
+class FusedGeluOp : public OpKernel {
+ public:
+  explicit FusedGeluOp(OpKernelConstruction* context) : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("approximate", &approximate_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& x = context->input(0);
+    Tensor* y = nullptr;
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, x.shape(), &y));
+    if (x.NumElements() == 0) return;
+
+    const CPUDevice& d = context->eigen_device<CPUDevice>();
+    auto output = y->flat<T>();
+    // Compute in float so the bfloat16 instantiation keeps full precision in
+    // the transcendental part.
+    auto in = x.flat<T>().template cast<float>();
+    if (approximate_) {
+      // 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+      const float kAlpha = 0.7978845608028654f;  // sqrt(2 / pi)
+      const float kCoeff = 0.044715f;
+      output.device(d) =
+          (in * in.constant(0.5f) *
+           (in.constant(1.0f) +
+            ((in + in.cube() * in.constant(kCoeff)) * in.constant(kAlpha))
+                .tanh()))
+              .template cast<T>();
+    } else {
+      // 0.5 * x * (1 + erf(x / sqrt(2)))
+      const float kRsqrtTwo = 0.7071067811865476f;  // 1 / sqrt(2)
+      output.device(d) =
+          (in * in.constant(0.5f) *
+           (in.constant(1.0f) + (in * in.constant(kRsqrtTwo)).erf()))
+              .template cast<T>();
+    }
+  }
+
+ private:
+  bool approximate_;
+};
+
+#define REGISTER_FUSED_GELU(T)                                      \
+  REGISTER_KERNEL_BUILDER(                                          \
+      Name("_FusedGelu").Device(DEVICE_CPU).TypeConstraint<T>("T"), \
+      FusedGeluOp<T>);
+
+REGISTER_FUSED_GELU(float);
+REGISTER_FUSED_GELU(bfloat16);
+
+#undef REGISTER_FUSED_GELU
+
+}  // namespace tensorflow
@@ -0,0 +1,159 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#define EIGEN_USE_THREADS
+
+#include <cmath>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+namespace {
+
+// Number of interleaved Welford accumulators carried through the reduction
+// pass. A single mean/M2 pair creates a loop-carried dependency on every
+// element; interleaving independent accumulators lets the compiler vectorize
+// the pass with whatever SIMD width the target provides.
+constexpr int kAccumulatorLanes = 16;
+
+// Computes the mean and (biased) variance of `row[0, depth)` in a single pass
+// with Welford's algorithm. The per-lane statistics and the scalar tail are
+// merged with Chan's parallel combination, which keeps the numerical
+// stability of the sequential algorithm.
+template <typename T>
+void RowMoments(const T* row, int64_t depth, float* mean_out,
+                float* variance_out) {
+  float mean[kAccumulatorLanes] = {0.0f};
+  float m2[kAccumulatorLanes] = {0.0f};
+  const int64_t chunks = depth / kAccumulatorLanes;
+  for (int64_t i = 0; i < chunks; ++i) {
+    const float inv_n = 1.0f / static_cast<float>(i + 1);
+    for (int lane = 0; lane < kAccumulatorLanes; ++lane) {
+      const float v = static_cast<float>(row[i * kAccumulatorLanes + lane]);
+      const float delta = v - mean[lane];
+      mean[lane] += delta * inv_n;
+      m2[lane] += delta * (v - mean[lane]);
+    }
+  }
+  float count = 0.0f;
+  float mean_all = 0.0f;
+  float m2_all = 0.0f;
+  if (chunks > 0) {
+    const float lane_count = static_cast<float>(chunks);
+    for (int lane = 0; lane < kAccumulatorLanes; ++lane) {
+      const float n = count + lane_count;
+      const float delta = mean[lane] - mean_all;
+      m2_all += m2[lane] + delta * delta * count * lane_count / n;
+      mean_all += delta * lane_count / n;
+      count = n;
+    }
+  }
+  for (int64_t i = chunks * kAccumulatorLanes; i < depth; ++i) {
+    const float v = static_cast<float>(row[i]);
+    count += 1.0f;
+    const float delta = v - mean_all;
+    mean_all += delta / count;
+    m2_all += delta * (v - mean_all);
+  }
+  *mean_out = mean_all;
+  *variance_out = m2_all / static_cast<float>(depth);
+}
+
+}  // namespace
+
+// Layer normalization over the innermost dimension, with the statistics
+// computed in one pass instead of the two Mean reductions plus elementwise
+// ops the python api decomposes into. Created by the grappler remapper; see
+// FindFusedLayerNorm in grappler/optimizers/remapper.cc.
+template <typename T>
+class FusedLayerNormOp : public OpKernel {
+ public:
+  explicit FusedLayerNormOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("epsilon", &epsilon_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& x = context->input(0);
+    const Tensor& scale = context->input(1);
+    const Tensor& offset = context->input(2);
+
+    OP_REQUIRES(context, x.dims() >= 1,
+                errors::InvalidArgument("input must be at least 1-D, got ",
+                                        x.shape().DebugString()));
+    const int64_t depth = x.dim_size(x.dims() - 1);
+    OP_REQUIRES(context, scale.dims() == 1 && scale.dim_size(0) == depth,
+                errors::InvalidArgument("scale must be 1-D with ", depth,
+                                        " elements, got ",
+                                        scale.shape().DebugString()));
+    OP_REQUIRES(context, offset.dims() == 1 && offset.dim_size(0) == depth,
+                errors::InvalidArgument("offset must be 1-D with ", depth,
+                                        " elements, got ",
+                                        offset.shape().DebugString()));
+
+    Tensor* y = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, x.shape(), &y));
+    if (x.NumElements() == 0) return;
+
+    const int64_t rows = x.NumElements() / depth;
+    const T* x_data = x.flat<T>().data();
+    const T* scale_data = scale.flat<T>().data();
+    const T* offset_data = offset.flat<T>().data();
+    T* y_data = y->flat<T>().data();
+    const float epsilon = epsilon_;
+
+    auto normalize_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t row = begin; row < end; ++row) {
+        const T* px = x_data + row * depth;
+        T* py = y_data + row * depth;
+        float mean;
+        float variance;
+        RowMoments(px, depth, &mean, &variance);
+        const float rstd = 1.0f / std::sqrt(variance + epsilon);
+        for (int64_t i = 0; i < depth; ++i) {
+          const float normalized = (static_cast<float>(px[i]) - mean) * rstd;
+          py[i] =
+              static_cast<T>(normalized * static_cast<float>(scale_data[i]) +
+                             static_cast<float>(offset_data[i]));
+        }
+      }
+    };
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    // One read pass for the moments plus one read/write pass to normalize.
+    const int64_t cost_per_row = 10 * depth;
+    Shard(worker_threads->num_threads, worker_threads->workers, rows,
+          cost_per_row, normalize_rows);
+  }
+
+ private:
+  float epsilon_;
+};
+
+#define REGISTER_FUSED_LAYER_NORM(T)                                     \
+  REGISTER_KERNEL_BUILDER(                                               \
+      Name("_FusedLayerNorm").Device(DEVICE_CPU).TypeConstraint<T>("T"), \
+      FusedLayerNormOp<T>);
+
+REGISTER_FUSED_LAYER_NORM(float);
+REGISTER_FUSED_LAYER_NORM(bfloat16);
+
+#undef REGISTER_FUSED_LAYER_NORM
+
+}  // namespace tensorflow
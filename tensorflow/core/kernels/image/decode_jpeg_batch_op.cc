@@ -0,0 +1,178 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/image_ops.cc
+#define EIGEN_USE_THREADS
+
+#include <limits>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/jpeg/jpeg_mem.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+// Decodes a batch of same-sized JPEG images, one image per intra-op pool
+// thread. All images must decode to the dimensions of the first one; mixed
+// sizes belong in the per-image DecodeJpeg op followed by a resize.
+class DecodeJpegBatchOp : public OpKernel {
+ public:
+  explicit DecodeJpegBatchOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("channels", &flags_.components));
+    OP_REQUIRES(
+        context,
+        flags_.components == 0 || flags_.components == 1 ||
+            flags_.components == 3,
+        errors::InvalidArgument("channels must be 0, 1, or 3, got ",
+                                flags_.components));
+    OP_REQUIRES_OK(context, context->GetAttr("ratio", &flags_.ratio));
+    OP_REQUIRES(context,
+                flags_.ratio == 1 || flags_.ratio == 2 || flags_.ratio == 4 ||
+                    flags_.ratio == 8,
+                errors::InvalidArgument("ratio must be 1, 2, 4, or 8, got ",
+                                        flags_.ratio));
+    OP_REQUIRES_OK(
+        context, context->GetAttr("fancy_upscaling", &flags_.fancy_upscaling));
+    OP_REQUIRES_OK(context,
+                   context->GetAttr("try_recover_truncated",
+                                    &flags_.try_recover_truncated_jpeg));
+    OP_REQUIRES_OK(context, context->GetAttr("acceptable_fraction",
+                                             &flags_.min_acceptable_fraction));
+    string dct_method;
+    OP_REQUIRES_OK(context, context->GetAttr("dct_method", &dct_method));
+    OP_REQUIRES(
+        context,
+        (dct_method.empty() || dct_method == "INTEGER_FAST" ||
+         dct_method == "INTEGER_ACCURATE"),
+        errors::InvalidArgument("dct_method must be one of "
+                                "{'', 'INTEGER_FAST', 'INTEGER_ACCURATE'}"));
+    // Same default as DecodeJpeg: IFAST trades image quality for speed.
+    if (dct_method.empty() || dct_method == "INTEGER_FAST") {
+      flags_.dct_method = JDCT_IFAST;
+    } else {
+      flags_.dct_method = JDCT_ISLOW;
+    }
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& contents = context->input(0);
+    OP_REQUIRES(
+        context, TensorShapeUtils::IsVector(contents.shape()),
+        errors::InvalidArgument("contents must be a vector, got shape ",
+                                contents.shape().DebugString()));
+    const int64_t batch_size = contents.dim_size(0);
+    OP_REQUIRES(context, batch_size > 0,
+                errors::InvalidArgument("contents must not be empty"));
+    auto contents_vec = contents.vec<tstring>();
+    for (int64_t i = 0; i < batch_size; ++i) {
+      OP_REQUIRES(context, !contents_vec(i).empty(),
+                  errors::InvalidArgument("Image ", i, " is empty."));
+      OP_REQUIRES(
+          context,
+          contents_vec(i).size() <=
+              static_cast<size_t>(std::numeric_limits<int>::max()),
+          errors::InvalidArgument("Image ", i, " contents are too large: ",
+                                  contents_vec(i).size()));
+    }
+
+    // Probe the first image's header to size the batched output. libjpeg
+    // rounds scaled dimensions up.
+    int width = 0, height = 0, components = 0;
+    OP_REQUIRES(context,
+                jpeg::GetImageInfo(contents_vec(0).data(),
+                                   contents_vec(0).size(), &width, &height,
+                                   &components),
+                errors::InvalidArgument(
+                    "Image 0 is not a valid JPEG: cannot read header."));
+    const int out_height = (height + flags_.ratio - 1) / flags_.ratio;
+    const int out_width = (width + flags_.ratio - 1) / flags_.ratio;
+    const int channels =
+        flags_.components != 0 ? flags_.components : components;
+    OP_REQUIRES(context, channels == 1 || channels == 3,
+                errors::InvalidArgument(
+                    "Batched JPEG decode supports 1 or 3 channels, got ",
+                    channels));
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(
+        context,
+        context->allocate_output(
+            0, TensorShape({batch_size, out_height, out_width, channels}),
+            &output));
+    uint8* output_base = output->flat<uint8>().data();
+    const int64_t image_bytes =
+        static_cast<int64_t>(out_height) * out_width * channels;
+
+    // Decode each image directly into its output slice. The first decode
+    // failure wins; remaining images are still decoded but their status is
+    // discarded.
+    mutex mu;
+    Status first_error;
+    jpeg::UncompressFlags flags = flags_;
+    flags.components = channels;
+    auto decode_images = [&](int64_t start, int64_t limit) {
+      for (int64_t i = start; i < limit; ++i) {
+        bool size_mismatch = false;
+        uint8* const buffer = jpeg::Uncompress(
+            contents_vec(i).data(), contents_vec(i).size(), flags,
+            nullptr /* nwarn */,
+            [&](int w, int h, int c) -> uint8* {
+              if (w != out_width || h != out_height || c != channels) {
+                size_mismatch = true;
+                return nullptr;
+              }
+              return output_base + i * image_bytes;
+            });
+        if (buffer == nullptr) {
+          mutex_lock l(mu);
+          if (first_error.ok()) {
+            first_error =
+                size_mismatch
+                    ? errors::InvalidArgument(
+                          "Image ", i,
+                          " does not match the batch dimensions [", out_height,
+                          ", ", out_width, ", ", channels, "].")
+                    : errors::InvalidArgument("Image ", i,
+                                              " is not a valid JPEG.");
+          }
+        }
+      }
+    };
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    // IDCT plus color conversion costs on the order of 100 cycles per output
+    // byte; what matters is one image per shard unit.
+    Shard(worker_threads.num_threads, worker_threads.workers, batch_size,
+          image_bytes * 100, decode_images);
+    OP_REQUIRES_OK(context, first_error);
+  }
+
+ private:
+  jpeg::UncompressFlags flags_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("_DecodeJpegBatch").Device(DEVICE_CPU),
+                        DecodeJpegBatchOp);
+
+}  // namespace
+}  // namespace tensorflow
@@ -0,0 +1,357 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/image_ops.cc
+#define EIGEN_USE_THREADS
+
+#ifdef __SSE4_1__
+#include <xmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/util/image_resizer_state.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+// One-dimensional interpolation indices and weight, computed once per output
+// row/column (same layout as the resize_bilinear kernel).
+struct CachedInterpolation {
+  int64_t lower;  // Lower source index used in the interpolation
+  int64_t upper;  // Upper source index used in the interpolation
+  float lerp;
+};
+
+template <typename Scaler>
+void ComputeInterpolationWeights(const Scaler scaler, const int64_t out_size,
+                                 const int64_t in_size, const float scale,
+                                 CachedInterpolation* interpolation) {
+  for (int64_t i = out_size - 1; i >= 0; --i) {
+    const float in = scaler(i, scale);
+    const float in_f = std::floor(in);
+    interpolation[i].lower =
+        std::max(static_cast<int64_t>(in_f), static_cast<int64_t>(0));
+    interpolation[i].upper =
+        std::min(static_cast<int64_t>(std::ceil(in)), in_size - 1);
+    interpolation[i].lerp = in - in_f;
+  }
+}
+
+// Bilinear interpolation of four float points, then the fused normalization
+// `v * scale + bias` (with bias = -mean * scale).
+inline float ComputeLerpNormalized(const float top_left, const float top_right,
+                                   const float bottom_left,
+                                   const float bottom_right,
+                                   const float x_lerp, const float y_lerp,
+                                   const float scale, const float bias) {
+  const float top = top_left + (top_right - top_left) * x_lerp;
+  const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
+  return (top + (bottom - top) * y_lerp) * scale + bias;
+}
+
+template <typename T>
+void InterpolateNormalizeRow(const T* const ys_input_lower_ptr,
+                             const T* const ys_input_upper_ptr,
+                             const CachedInterpolation* const xs,
+                             const float ys_lerp, const int64_t out_width,
+                             const float* scale, const float* bias,
+                             const int channels, float* out_y) {
+  for (int64_t x = 0; x < out_width; ++x) {
+    const int64_t xs_lower = xs[x].lower;
+    const int64_t xs_upper = xs[x].upper;
+    const float xs_lerp = xs[x].lerp;
+
+    for (int c = 0; c < channels; ++c) {
+      const float top_left(ys_input_lower_ptr[xs_lower + c]);
+      const float top_right(ys_input_lower_ptr[xs_upper + c]);
+      const float bottom_left(ys_input_upper_ptr[xs_lower + c]);
+      const float bottom_right(ys_input_upper_ptr[xs_upper + c]);
+
+      out_y[x * channels + c] = ComputeLerpNormalized(
+          top_left, top_right, bottom_left, bottom_right, xs_lerp, ys_lerp,
+          scale[c], bias[c]);
+    }
+  }
+}
+
+#ifdef __SSE4_1__
+// Vector version of ComputeLerpNormalized. The uint8 (or other T) -> float
+// conversion happens in the loads, so it is fused into the interpolation.
+inline __m128 ComputeLerpNormalizedV(
+    const __m128 top_left, const __m128 top_right, const __m128 bottom_left,
+    const __m128 bottom_right, const __m128 x_lerp, const __m128 y_lerp,
+    const __m128 scale, const __m128 bias) {
+  const __m128 top =
+      _mm_add_ps(top_left, _mm_mul_ps(_mm_sub_ps(top_right, top_left), x_lerp));
+  const __m128 bottom = _mm_add_ps(
+      bottom_left, _mm_mul_ps(_mm_sub_ps(bottom_right, bottom_left), x_lerp));
+  const __m128 value =
+      _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), y_lerp));
+  return _mm_add_ps(_mm_mul_ps(value, scale), bias);
+}
+
+// Load 3 floats from the given buffer, which must be of size at least 4.
+template <typename T>
+inline __m128 Load3xFloatV(const T* values) {
+  return _mm_set_ps(0.0f, static_cast<float>(values[2]),
+                    static_cast<float>(values[1]),
+                    static_cast<float>(values[0]));
+}
+
+template <>
+inline __m128 Load3xFloatV(const float* values) {
+  return _mm_loadu_ps(values);
+}
+
+template <typename T>
+void InterpolateNormalizeRow3Channels(const T* const ys_input_lower_ptr,
+                                      const T* const ys_input_upper_ptr,
+                                      const CachedInterpolation* const xs,
+                                      const float ys_lerp,
+                                      const int64_t out_width,
+                                      const float* scale, const float* bias,
+                                      float* out_y) {
+  const __m128 ys_lerp_v = _mm_set1_ps(ys_lerp);
+  const __m128 scale_v = _mm_set_ps(0.0f, scale[2], scale[1], scale[0]);
+  const __m128 bias_v = _mm_set_ps(0.0f, bias[2], bias[1], bias[0]);
+  // All pixels but the last one may overflow the row by one float, so
+  // vectorize the inside of the row only.
+  for (int64_t x = 0; x < out_width - 1; ++x) {
+    const int64_t xs_lower = xs[x].lower;
+    const int64_t xs_upper = xs[x].upper;
+    const __m128 xs_lerp_v = _mm_set1_ps(xs[x].lerp);
+
+    const __m128 top_left_v = Load3xFloatV(ys_input_lower_ptr + xs_lower);
+    const __m128 top_right_v = Load3xFloatV(ys_input_lower_ptr + xs_upper);
+    const __m128 bottom_left_v = Load3xFloatV(ys_input_upper_ptr + xs_lower);
+    const __m128 bottom_right_v = Load3xFloatV(ys_input_upper_ptr + xs_upper);
+
+    _mm_storeu_ps(out_y + x * 3,
+                  ComputeLerpNormalizedV(top_left_v, top_right_v,
+                                         bottom_left_v, bottom_right_v,
+                                         xs_lerp_v, ys_lerp_v, scale_v,
+                                         bias_v));
+  }
+  // The last pixel of each row must be done scalar because we cannot
+  // overflow past the end of the output.
+  InterpolateNormalizeRow(ys_input_lower_ptr, ys_input_upper_ptr,
+                          xs + out_width - 1, ys_lerp, 1, scale, bias, 3,
+                          out_y + (out_width - 1) * 3);
+}
+#endif
+
+template <typename T>
+class FusedCropResizeNormalizeOp : public OpKernel {
+ public:
+  explicit FusedCropResizeNormalizeOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("align_corners", &align_corners_));
+    OP_REQUIRES_OK(
+        context, context->GetAttr("half_pixel_centers", &half_pixel_centers_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& images = context->input(0);
+    OP_REQUIRES(context, images.dims() == 4,
+                errors::InvalidArgument("images must be 4-D, got shape ",
+                                        images.shape().DebugString()));
+    const int batch_size = images.dim_size(0);
+    const int64_t in_height = images.dim_size(1);
+    const int64_t in_width = images.dim_size(2);
+    const int channels = images.dim_size(3);
+
+    const Tensor& crop_window_t = context->input(1);
+    OP_REQUIRES(
+        context,
+        TensorShapeUtils::IsVector(crop_window_t.shape()) &&
+            crop_window_t.NumElements() == 4,
+        errors::InvalidArgument("crop_window must be a vector of 4 elements, "
+                                "got shape ",
+                                crop_window_t.shape().DebugString()));
+    auto crop_window = crop_window_t.vec<int32>();
+    const int64_t crop_y = crop_window(0);
+    const int64_t crop_x = crop_window(1);
+    const int64_t crop_height = crop_window(2);
+    const int64_t crop_width = crop_window(3);
+    OP_REQUIRES(context, crop_y >= 0 && crop_x >= 0,
+                errors::InvalidArgument("crop offsets must be non-negative, "
+                                        "got y=",
+                                        crop_y, ", x=", crop_x));
+    OP_REQUIRES(context, crop_height > 0 && crop_width > 0,
+                errors::InvalidArgument("crop dimensions must be positive, "
+                                        "got height=",
+                                        crop_height, ", width=", crop_width));
+    OP_REQUIRES(
+        context, crop_y + crop_height <= in_height,
+        errors::InvalidArgument("crop window exceeds image height: ", crop_y,
+                                " + ", crop_height, " > ", in_height));
+    OP_REQUIRES(
+        context, crop_x + crop_width <= in_width,
+        errors::InvalidArgument("crop window exceeds image width: ", crop_x,
+                                " + ", crop_width, " > ", in_width));
+
+    const Tensor& size_tensor = context->input(2);
+    OP_REQUIRES(
+        context,
+        TensorShapeUtils::IsVector(size_tensor.shape()) &&
+            size_tensor.NumElements() == 2,
+        errors::InvalidArgument("size must be a vector of 2 elements, got "
+                                "shape ",
+                                size_tensor.shape().DebugString()));
+    auto size_vec = size_tensor.vec<int32>();
+    const int64_t out_height = size_vec(0);
+    const int64_t out_width = size_vec(1);
+    OP_REQUIRES(context, out_height > 0 && out_width > 0,
+                errors::InvalidArgument("output dimensions must be positive, "
+                                        "got height=",
+                                        out_height, ", width=", out_width));
+
+    const Tensor& mean_t = context->input(3);
+    const Tensor& scale_t = context->input(4);
+    for (const Tensor* t : {&mean_t, &scale_t}) {
+      OP_REQUIRES(
+          context,
+          TensorShapeUtils::IsScalar(t->shape()) ||
+              (TensorShapeUtils::IsVector(t->shape()) &&
+               t->NumElements() == channels),
+          errors::InvalidArgument("mean and scale must be scalars or vectors "
+                                  "with one element per channel, got shape ",
+                                  t->shape().DebugString()));
+    }
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(
+        context,
+        context->allocate_output(
+            0, TensorShape({batch_size, out_height, out_width, channels}),
+            &output));
+    if (output->NumElements() == 0) return;
+
+    // Broadcast the normalization constants per channel, and fold the mean
+    // into a bias so each output value costs one multiply-add:
+    //   (v - mean) * scale == v * scale + (-mean * scale).
+    gtl::InlinedVector<float, 4> scale_c(channels);
+    gtl::InlinedVector<float, 4> bias_c(channels);
+    auto mean_flat = mean_t.flat<float>();
+    auto scale_flat = scale_t.flat<float>();
+    for (int c = 0; c < channels; ++c) {
+      const float mean = mean_flat(mean_t.NumElements() == 1 ? 0 : c);
+      scale_c[c] = scale_flat(scale_t.NumElements() == 1 ? 0 : c);
+      bias_c[c] = -mean * scale_c[c];
+    }
+
+    const float height_scale =
+        CalculateResizeScale(crop_height, out_height, align_corners_);
+    const float width_scale =
+        CalculateResizeScale(crop_width, out_width, align_corners_);
+
+    std::vector<CachedInterpolation> ys(out_height);
+    std::vector<CachedInterpolation> xs(out_width);
+    if (half_pixel_centers_) {
+      ComputeInterpolationWeights(HalfPixelScaler(), out_height, crop_height,
+                                  height_scale, ys.data());
+      ComputeInterpolationWeights(HalfPixelScaler(), out_width, crop_width,
+                                  width_scale, xs.data());
+    } else {
+      ComputeInterpolationWeights(LegacyScaler(), out_height, crop_height,
+                                  height_scale, ys.data());
+      ComputeInterpolationWeights(LegacyScaler(), out_width, crop_width,
+                                  width_scale, xs.data());
+    }
+    // Shift the interpolation indices into the crop window, and scale the x
+    // indices by channels to avoid a multiplication in the inner loop.
+    for (auto& y : ys) {
+      y.lower += crop_y;
+      y.upper += crop_y;
+    }
+    for (auto& x : xs) {
+      x.lower = (x.lower + crop_x) * channels;
+      x.upper = (x.upper + crop_x) * channels;
+    }
+
+    const int64_t in_row_size = in_width * channels;
+    const int64_t in_batch_num_values = in_height * in_row_size;
+    const int64_t out_row_size = out_width * channels;
+    const T* input_base = images.tensor<T, 4>().data();
+    float* output_base = output->tensor<float, 4>().data();
+    const float* scale_ptr = scale_c.data();
+    const float* bias_ptr = bias_c.data();
+
+    // One unit of work is one output row; rows are independent.
+    auto process_rows = [&](int64_t start_row, int64_t limit_row) {
+      for (int64_t r = start_row; r < limit_row; ++r) {
+        const int64_t b = r / out_height;
+        const int64_t y = r % out_height;
+        const T* input_b_ptr = input_base + b * in_batch_num_values;
+        const T* ys_input_lower_ptr = input_b_ptr + ys[y].lower * in_row_size;
+        const T* ys_input_upper_ptr = input_b_ptr + ys[y].upper * in_row_size;
+        float* out_y = output_base + r * out_row_size;
+#ifdef __SSE4_1__
+        if (channels == 3) {
+          InterpolateNormalizeRow3Channels(ys_input_lower_ptr,
+                                           ys_input_upper_ptr, xs.data(),
+                                           ys[y].lerp, out_width, scale_ptr,
+                                           bias_ptr, out_y);
+          continue;
+        }
+#endif
+        InterpolateNormalizeRow(ys_input_lower_ptr, ys_input_upper_ptr,
+                                xs.data(), ys[y].lerp, out_width, scale_ptr,
+                                bias_ptr, channels, out_y);
+      }
+    };
+    const int64_t total_rows = static_cast<int64_t>(batch_size) * out_height;
+    // Roughly 10 flops per interpolated value plus the loads.
+    const int64_t cost_per_row = out_row_size * 16;
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, total_rows,
+          cost_per_row, process_rows);
+  }
+
+ private:
+  bool align_corners_;
+  bool half_pixel_centers_;
+};
+
+}  // namespace
+
+#define REGISTER_KERNEL(T)                                       \
+  REGISTER_KERNEL_BUILDER(Name("_FusedCropResizeNormalize")      \
+                              .Device(DEVICE_CPU)                \
+                              .TypeConstraint<T>("T")            \
+                              .HostMemory("crop_window")         \
+                              .HostMemory("size"),               \
+                          FusedCropResizeNormalizeOp<T>);
+
+TF_CALL_uint8(REGISTER_KERNEL);
+TF_CALL_half(REGISTER_KERNEL);
+TF_CALL_bfloat16(REGISTER_KERNEL);
+TF_CALL_float(REGISTER_KERNEL);
+TF_CALL_double(REGISTER_KERNEL);
+#undef REGISTER_KERNEL
+
+}  // namespace tensorflow
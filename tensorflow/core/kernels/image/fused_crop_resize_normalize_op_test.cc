@@ -0,0 +1,147 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <vector>
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class FusedCropResizeNormalizeOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(DataType dtype, bool half_pixel_centers) {
+    TF_EXPECT_OK(NodeDefBuilder("fused_crop_resize_normalize",
+                                "_FusedCropResizeNormalize")
+                     .Input(FakeInput(dtype))
+                     .Input(FakeInput(DT_INT32))
+                     .Input(FakeInput(DT_INT32))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_FLOAT))
+                     .Attr("half_pixel_centers", half_pixel_centers)
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+
+  // Straightforward reference: crop, bilinear resize (legacy scaler), then
+  // normalize, all in separate scalar steps.
+  template <typename T>
+  Tensor Reference(const Tensor& images, int crop_y, int crop_x,
+                   int crop_height, int crop_width, int out_height,
+                   int out_width, const std::vector<float>& mean,
+                   const std::vector<float>& scale) {
+    const int batch_size = images.dim_size(0);
+    const int channels = images.dim_size(3);
+    auto in = images.tensor<T, 4>();
+    Tensor result(DT_FLOAT,
+                  TensorShape({batch_size, out_height, out_width, channels}));
+    auto out = result.tensor<float, 4>();
+    const float height_scale =
+        crop_height / static_cast<float>(out_height);
+    const float width_scale = crop_width / static_cast<float>(out_width);
+    for (int b = 0; b < batch_size; ++b) {
+      for (int y = 0; y < out_height; ++y) {
+        const float in_y = y * height_scale;
+        const int y0 = static_cast<int>(std::floor(in_y));
+        const int y1 = std::min(static_cast<int>(std::ceil(in_y)),
+                                crop_height - 1);
+        const float y_lerp = in_y - y0;
+        for (int x = 0; x < out_width; ++x) {
+          const float in_x = x * width_scale;
+          const int x0 = static_cast<int>(std::floor(in_x));
+          const int x1 = std::min(static_cast<int>(std::ceil(in_x)),
+                                  crop_width - 1);
+          const float x_lerp = in_x - x0;
+          for (int c = 0; c < channels; ++c) {
+            const float top_left(in(b, crop_y + y0, crop_x + x0, c));
+            const float top_right(in(b, crop_y + y0, crop_x + x1, c));
+            const float bottom_left(in(b, crop_y + y1, crop_x + x0, c));
+            const float bottom_right(in(b, crop_y + y1, crop_x + x1, c));
+            const float top = top_left + (top_right - top_left) * x_lerp;
+            const float bottom =
+                bottom_left + (bottom_right - bottom_left) * x_lerp;
+            const float value = top + (bottom - top) * y_lerp;
+            out(b, y, x, c) = (value - mean[c]) * scale[c];
+          }
+        }
+      }
+    }
+    return result;
+  }
+};
+
+TEST_F(FusedCropResizeNormalizeOpTest, IdentityResizeNormalizesOnly) {
+  MakeOp(DT_FLOAT, /*half_pixel_centers=*/false);
+  AddInputFromArray<float>(TensorShape({1, 2, 2, 1}),
+                           {1.0f, 2.0f, 3.0f, 4.0f});
+  AddInputFromArray<int32>(TensorShape({4}), {0, 0, 2, 2});
+  AddInputFromArray<int32>(TensorShape({2}), {2, 2});
+  AddInputFromArray<float>(TensorShape({}), {1.0f});
+  AddInputFromArray<float>(TensorShape({}), {0.5f});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({1, 2, 2, 1}));
+  test::FillValues<float>(&expected, {0.0f, 0.5f, 1.0f, 1.5f});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+TEST_F(FusedCropResizeNormalizeOpTest, Uint8CropResizeMatchesReference) {
+  MakeOp(DT_UINT8, /*half_pixel_centers=*/false);
+  Tensor images(DT_UINT8, TensorShape({2, 8, 10, 3}));
+  auto images_flat = images.flat<uint8>();
+  std::vector<uint8> values(images_flat.size());
+  for (int i = 0; i < images_flat.size(); ++i) {
+    values[i] = static_cast<uint8>((i * 23 + 7) % 256);
+    images_flat(i) = values[i];
+  }
+  const std::vector<float> mean = {127.5f, 100.0f, 50.0f};
+  const std::vector<float> scale = {1.0f / 127.5f, 0.01f, 0.02f};
+
+  AddInputFromArray<uint8>(images.shape(), values);
+  AddInputFromArray<int32>(TensorShape({4}), {1, 2, 6, 7});
+  AddInputFromArray<int32>(TensorShape({2}), {4, 5});
+  AddInputFromArray<float>(TensorShape({3}), mean);
+  AddInputFromArray<float>(TensorShape({3}), scale);
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected = Reference<uint8>(images, 1, 2, 6, 7, 4, 5, mean, scale);
+  test::ExpectTensorNear<float>(expected, *GetOutput(0), 1e-5);
+}
+
+TEST_F(FusedCropResizeNormalizeOpTest, InvalidCropWindow) {
+  MakeOp(DT_FLOAT, /*half_pixel_centers=*/false);
+  AddInputFromArray<float>(TensorShape({1, 2, 2, 1}),
+                           {1.0f, 2.0f, 3.0f, 4.0f});
+  AddInputFromArray<int32>(TensorShape({4}), {1, 0, 2, 2});
+  AddInputFromArray<int32>(TensorShape({2}), {2, 2});
+  AddInputFromArray<float>(TensorShape({}), {0.0f});
+  AddInputFromArray<float>(TensorShape({}), {1.0f});
+  Status s = RunOpKernel();
+  EXPECT_FALSE(s.ok());
+  EXPECT_TRUE(absl::StrContains(s.ToString(), "exceeds image height"))
+      << s.ToString();
+}
+
+}  // namespace
+}  // namespace tensorflow
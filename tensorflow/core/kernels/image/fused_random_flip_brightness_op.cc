@@ -0,0 +1,137 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/image_ops.cc
+#define EIGEN_USE_THREADS
+
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/stateless_random_ops.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/random/philox_random.h"
+#include "tensorflow/core/lib/random/random_distributions.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+// Applies a stateless per-image random horizontal flip and brightness shift
+// in a single pass over the pixels. The per-image draws come straight from
+// the Philox counter (keyed by the seed input and indexed by the image
+// position in the batch), so no mask or delta tensors are materialized, and
+// the flip is expressed purely through the read order of the copy.
+template <typename T>
+class FusedRandomFlipBrightnessOp : public OpKernel {
+ public:
+  explicit FusedRandomFlipBrightnessOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("max_delta", &max_delta_));
+    OP_REQUIRES(context, max_delta_ >= 0.0f,
+                errors::InvalidArgument("max_delta must be non-negative, got ",
+                                        max_delta_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& images = context->input(0);
+    OP_REQUIRES(context, images.dims() == 4,
+                errors::InvalidArgument("images must be 4-D, got shape ",
+                                        images.shape().DebugString()));
+    const int64_t batch_size = images.dim_size(0);
+    const int64_t height = images.dim_size(1);
+    const int64_t width = images.dim_size(2);
+    const int64_t channels = images.dim_size(3);
+
+    random::PhiloxRandom::Key key;
+    random::PhiloxRandom::ResultType counter;
+    OP_REQUIRES_OK(context, GenerateKey(context->input(1), &key, &counter));
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, images.shape(), &output));
+    if (output->NumElements() == 0) return;
+
+    // One 128-bit Philox block per image: one lane decides the flip, one
+    // lane becomes the uniform brightness delta in [-max_delta, max_delta].
+    std::vector<bool> flip(batch_size);
+    std::vector<float> delta(batch_size);
+    random::PhiloxRandom base_gen(counter, key);
+    for (int64_t b = 0; b < batch_size; ++b) {
+      random::PhiloxRandom gen = base_gen;
+      gen.Skip(b);
+      const auto sample = gen();
+      flip[b] = (sample[0] & 1) != 0;
+      delta[b] =
+          (2.0f * random::Uint32ToFloat(sample[1]) - 1.0f) * max_delta_;
+    }
+
+    const T* in = images.tensor<T, 4>().data();
+    T* out = output->tensor<T, 4>().data();
+    const int64_t row_size = width * channels;
+    const int64_t image_size = height * row_size;
+
+    // One unit of work is one output row.
+    auto process_rows = [&](int64_t start_row, int64_t limit_row) {
+      for (int64_t r = start_row; r < limit_row; ++r) {
+        const int64_t b = r / height;
+        const T* in_row = in + b * image_size + (r % height) * row_size;
+        T* out_row = out + r * row_size;
+        const float d = delta[b];
+        if (flip[b]) {
+          for (int64_t x = 0; x < width; ++x) {
+            const T* in_px = in_row + (width - 1 - x) * channels;
+            T* out_px = out_row + x * channels;
+            for (int64_t c = 0; c < channels; ++c) {
+              out_px[c] = static_cast<T>(static_cast<float>(in_px[c]) + d);
+            }
+          }
+        } else {
+          for (int64_t i = 0; i < row_size; ++i) {
+            out_row[i] = static_cast<T>(static_cast<float>(in_row[i]) + d);
+          }
+        }
+      }
+    };
+    const int64_t total_rows = batch_size * height;
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    Shard(worker_threads.num_threads, worker_threads.workers, total_rows,
+          row_size * 4 /* cost: one load, add, store per value */,
+          process_rows);
+  }
+
+ private:
+  float max_delta_;
+};
+
+#define REGISTER_KERNEL(T)                                       \
+  REGISTER_KERNEL_BUILDER(Name("_FusedRandomFlipBrightness")     \
+                              .Device(DEVICE_CPU)                \
+                              .TypeConstraint<T>("T")            \
+                              .HostMemory("seed"),               \
+                          FusedRandomFlipBrightnessOp<T>);
+
+TF_CALL_half(REGISTER_KERNEL);
+TF_CALL_bfloat16(REGISTER_KERNEL);
+TF_CALL_float(REGISTER_KERNEL);
+TF_CALL_double(REGISTER_KERNEL);
+#undef REGISTER_KERNEL
+
+}  // namespace
+}  // namespace tensorflow
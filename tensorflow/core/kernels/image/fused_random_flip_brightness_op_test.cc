@@ -0,0 +1,104 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <vector>
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class FusedRandomFlipBrightnessOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(float max_delta) {
+    TF_EXPECT_OK(NodeDefBuilder("fused_random_flip_brightness",
+                                "_FusedRandomFlipBrightness")
+                     .Input(FakeInput(DT_FLOAT))
+                     .Input(FakeInput(DT_INT32))
+                     .Attr("max_delta", max_delta)
+                     .Finalize(node_def()));
+    TF_EXPECT_OK(InitOp());
+  }
+};
+
+TEST_F(FusedRandomFlipBrightnessOpTest, PerImageFlipOrShiftOnly) {
+  constexpr float kMaxDelta = 0.25f;
+  constexpr int kBatch = 8;
+  constexpr int kHeight = 2;
+  constexpr int kWidth = 3;
+  MakeOp(kMaxDelta);
+
+  std::vector<float> input(kBatch * kHeight * kWidth);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<float>(i);
+  }
+  AddInputFromArray<float>(TensorShape({kBatch, kHeight, kWidth, 1}), input);
+  AddInputFromArray<int32>(TensorShape({2}), {7, 17});
+  TF_ASSERT_OK(RunOpKernel());
+
+  auto out = GetOutput(0)->tensor<float, 4>();
+  // Every image must be either the original or its left/right mirror, offset
+  // by one per-image constant within [-max_delta, max_delta].
+  for (int b = 0; b < kBatch; ++b) {
+    auto in_at = [&](int y, int x) {
+      return input[(b * kHeight + y) * kWidth + x];
+    };
+    const float delta_unflipped = out(b, 0, 0, 0) - in_at(0, 0);
+    const float delta_flipped = out(b, 0, 0, 0) - in_at(0, kWidth - 1);
+    const bool flipped =
+        std::abs(delta_flipped) <= std::abs(delta_unflipped);
+    const float delta = flipped ? delta_flipped : delta_unflipped;
+    EXPECT_LE(std::abs(delta), kMaxDelta);
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < kWidth; ++x) {
+        const float expected =
+            in_at(y, flipped ? kWidth - 1 - x : x) + delta;
+        EXPECT_NEAR(expected, out(b, y, x, 0), 1e-6)
+            << "b=" << b << " y=" << y << " x=" << x;
+      }
+    }
+  }
+}
+
+TEST_F(FusedRandomFlipBrightnessOpTest, DeterministicForSeed) {
+  MakeOp(0.5f);
+  std::vector<float> input(2 * 4 * 4 * 3);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = 0.01f * static_cast<float>(i);
+  }
+  AddInputFromArray<float>(TensorShape({2, 4, 4, 3}), input);
+  AddInputFromArray<int32>(TensorShape({2}), {123, 456});
+  TF_ASSERT_OK(RunOpKernel());
+  Tensor first = *GetOutput(0);
+
+  inputs_.clear();
+  AddInputFromArray<float>(TensorShape({2, 4, 4, 3}), input);
+  AddInputFromArray<int32>(TensorShape({2}), {123, 456});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorEqual<float>(first, *GetOutput(0));
+}
+
+}  // namespace
+}  // namespace tensorflow
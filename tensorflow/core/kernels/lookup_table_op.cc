@@ -16,9 +16,11 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <functional>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/types.h"
@@ -42,6 +44,10 @@ std::string UniqueNodeName(const std::string& base) {
 //
 // This table is mutable and thread safe - Insert can be called at any time.
 //
+// The map is striped over a fixed number of independently locked shards so
+// that concurrent lookups and inserts touching different shards do not
+// contend on a single table-wide mutex.
+//
 // Sample use case:
 //
 // MutableHashTableOfScalars<int64, int64> table;  // int64 -> int64.
@@ -56,8 +62,12 @@ class MutableHashTableOfScalars final : public LookupInterface {
   MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel) {}
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      ret += shard.table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
@@ -70,33 +80,56 @@ class MutableHashTableOfScalars final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      // is_full_size_default is true:
-      //   Each key has an independent default value, key_values(i)
-      //   corresponding uses default_flat(i) as its default value.
-      //
-      // is_full_size_default is false:
-      //   All keys will share the default_flat(0) as default value.
-      value_values(i) = gtl::FindWithDefault(
-          table_, SubtleMustCopyIfIntegral(key_values(i)),
-          is_full_size_default ? default_flat(i) : default_flat(0));
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      const Shard& shard = shards_[shard_idx];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        // is_full_size_default is true:
+        //   Each key has an independent default value, key_values(i)
+        //   corresponding uses default_flat(i) as its default value.
+        //
+        // is_full_size_default is false:
+        //   All keys will share the default_flat(0) as default value.
+        value_values(i) = gtl::FindWithDefault(
+            shard.table, SubtleMustCopyIfIntegral(key_values(i)),
+            is_full_size_default ? default_flat(i) : default_flat(0));
+      }
     }
 
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat<V>();
 
-    mutex_lock l(mu_);
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
     if (clear) {
-      table_.clear();
+      // Hold every shard for the whole import so that concurrent readers
+      // never observe a partially imported table.
+      std::vector<mutex_lock> locks = LockAllShardsExclusive();
+      for (Shard& shard : shards_) {
+        shard.table.clear();
+      }
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        gtl::InsertOrUpdate(&shards_[key_shards[i]].table,
+                            SubtleMustCopyIfIntegral(key_values(i)),
+                            SubtleMustCopyIfIntegral(value_values(i)));
+      }
+      return OkStatus();
     }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          SubtleMustCopyIfIntegral(value_values(i)));
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      Shard& shard = shards_[shard_idx];
+      mutex_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        gtl::InsertOrUpdate(&shard.table,
+                            SubtleMustCopyIfIntegral(key_values(i)),
+                            SubtleMustCopyIfIntegral(value_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -109,9 +142,14 @@ class MutableHashTableOfScalars final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      Shard& shard = shards_[shard_idx];
+      mutex_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        shard.table.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -122,8 +160,8 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
   Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+    std::vector<tf_shared_lock> locks = LockAllShardsShared();
+    int64_t size = SizeLocked();
 
     Tensor* keys;
     Tensor* values;
@@ -145,21 +183,23 @@ class MutableHashTableOfScalars final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      for (unsigned i = 0; i < shard.table.bucket_count(); ++i) {
+        size_t bucket_size = shard.table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfScalars) + ret;
   }
 
   Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+    std::vector<tf_shared_lock> locks = LockAllShardsShared();
+    int64_t size = SizeLocked();
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size}));
     ExportKeysAndValues(&keys, &values);
@@ -195,25 +235,84 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
  private:
+  // Number of independently locked stripes the map is spread over. Must be a
+  // power of two.
+  static constexpr int kNumShards = 16;
+
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, V> table TF_GUARDED_BY(mu);
+  };
+
+  // Returns the shard responsible for 'key'.  The multiplicative mix spreads
+  // the shard choice over the hash's high bits so striping stays balanced
+  // even for hash functions that are close to the identity on integers.
+  static uint8 ShardOf(const K& key) {
+    return static_cast<uint8>((static_cast<uint64>(std::hash<K>{}(key)) *
+                               uint64{0x9E3779B97F4A7C15}) >>
+                              60);
+  }
+
+  template <typename KeyFlat>
+  static gtl::InlinedVector<uint8, 64> ShardKeys(const KeyFlat& key_values) {
+    gtl::InlinedVector<uint8, 64> key_shards(key_values.size());
+    for (int64_t i = 0; i < key_values.size(); ++i) {
+      key_shards[i] = ShardOf(SubtleMustCopyIfIntegral(key_values(i)));
+    }
+    return key_shards;
+  }
+
+  // Acquires every shard mutex, always in shard order to avoid deadlock.
+  std::vector<tf_shared_lock> LockAllShardsShared() const
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(kNumShards);
+    for (const Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllShardsExclusive()
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<mutex_lock> locks;
+    locks.reserve(kNumShards);
+    for (Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  // The callers below must hold all shard locks.
+  int64_t SizeLocked() const TF_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t ret = 0;
+    for (const Shard& shard : shards_) {
+      ret += shard.table.size();
+    }
+    return ret;
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors of size `SizeLocked()`.
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     auto keys_data = keys->flat<K>();
     auto values_data = values->flat<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      keys_data(i) = it->first;
-      values_data(i) = it->second;
+    for (const Shard& shard : shards_) {
+      for (auto it = shard.table.begin(); it != shard.table.end(); ++it, ++i) {
+        keys_data(i) = it->first;
+        values_data(i) = it->second;
+      }
     }
   }
 
-  mutable mutex mu_;
-  std::unordered_map<K, V> table_ TF_GUARDED_BY(mu_);
+  Shard shards_[kNumShards];
 };
 
 // Lookup table that wraps an unordered_map. Behaves identical to
 // MutableHashTableOfScalars except that each value must be a vector.
+// Lock-striped over shards in the same way as MutableHashTableOfScalars.
 template <class K, class V>
 class MutableHashTableOfTensors final : public LookupInterface {
  public:
@@ -227,8 +326,12 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
   size_t size() const override {
-    tf_shared_lock l(mu_);
-    return table_.size();
+    size_t ret = 0;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      ret += shard.table.size();
+    }
+    return ret;
   }
 
   Status Find(OpKernelContext* ctx, const Tensor& key, Tensor* value,
@@ -242,24 +345,29 @@ class MutableHashTableOfTensors final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
-    tf_shared_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      ValueArray* value_vec =
-          gtl::FindOrNull(table_, SubtleMustCopyIfIntegral(key_values(i)));
-      if (value_vec != nullptr) {
-        for (int64_t j = 0; j < value_dim; j++) {
-          value_values(i, j) = value_vec->at(j);
-        }
-      } else {
-        // is_full_size_default is true:
-        //   Each key has an independent default value, key_values(i)
-        //   corresponding uses default_flat(i) as its default value.
-        //
-        // is_full_size_default is false:
-        //   All keys will share the default_flat(0) as default value.
-        for (int64_t j = 0; j < value_dim; j++) {
-          value_values(i, j) =
-              is_full_size_default ? default_flat(i, j) : default_flat(0, j);
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      const Shard& shard = shards_[shard_idx];
+      tf_shared_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        const ValueArray* value_vec = gtl::FindOrNull(
+            shard.table, SubtleMustCopyIfIntegral(key_values(i)));
+        if (value_vec != nullptr) {
+          for (int64_t j = 0; j < value_dim; j++) {
+            value_values(i, j) = value_vec->at(j);
+          }
+        } else {
+          // is_full_size_default is true:
+          //   Each key has an independent default value, key_values(i)
+          //   corresponding uses default_flat(i) as its default value.
+          //
+          // is_full_size_default is false:
+          //   All keys will share the default_flat(0) as default value.
+          for (int64_t j = 0; j < value_dim; j++) {
+            value_values(i, j) =
+                is_full_size_default ? default_flat(i, j) : default_flat(0, j);
+          }
         }
       }
     }
@@ -267,23 +375,45 @@ class MutableHashTableOfTensors final : public LookupInterface {
     return OkStatus();
   }
 
-  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values) {
+  Status DoInsert(bool clear, const Tensor& keys, const Tensor& values)
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     const auto key_values = keys.flat<K>();
     const auto value_values = values.flat_inner_dims<V, 2>();
     int64_t value_dim = value_shape_.dim_size(0);
 
-    mutex_lock l(mu_);
-    if (clear) {
-      table_.clear();
-    }
-    for (int64_t i = 0; i < key_values.size(); ++i) {
+    const auto make_value_vec = [&](int64_t i) {
       ValueArray value_vec;
       for (int64_t j = 0; j < value_dim; j++) {
         V value = value_values(i, j);
         value_vec.push_back(value);
       }
-      gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
-                          value_vec);
+      return value_vec;
+    };
+
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
+    if (clear) {
+      // Hold every shard for the whole import so that concurrent readers
+      // never observe a partially imported table.
+      std::vector<mutex_lock> locks = LockAllShardsExclusive();
+      for (Shard& shard : shards_) {
+        shard.table.clear();
+      }
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        gtl::InsertOrUpdate(&shards_[key_shards[i]].table,
+                            SubtleMustCopyIfIntegral(key_values(i)),
+                            make_value_vec(i));
+      }
+      return OkStatus();
+    }
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      Shard& shard = shards_[shard_idx];
+      mutex_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        gtl::InsertOrUpdate(&shard.table,
+                            SubtleMustCopyIfIntegral(key_values(i)),
+                            make_value_vec(i));
+      }
     }
     return OkStatus();
   }
@@ -296,9 +426,14 @@ class MutableHashTableOfTensors final : public LookupInterface {
   Status Remove(OpKernelContext* ctx, const Tensor& keys) override {
     const auto key_values = keys.flat<K>();
 
-    mutex_lock l(mu_);
-    for (int64_t i = 0; i < key_values.size(); ++i) {
-      table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
+    const gtl::InlinedVector<uint8, 64> key_shards = ShardKeys(key_values);
+    for (int shard_idx = 0; shard_idx < kNumShards; ++shard_idx) {
+      Shard& shard = shards_[shard_idx];
+      mutex_lock l(shard.mu);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        if (key_shards[i] != shard_idx) continue;
+        shard.table.erase(SubtleMustCopyIfIntegral(key_values(i)));
+      }
     }
     return OkStatus();
   }
@@ -309,8 +444,8 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
   Status ExportValues(OpKernelContext* ctx) override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+    std::vector<tf_shared_lock> locks = LockAllShardsShared();
+    int64_t size = SizeLocked();
     int64_t value_dim = value_shape_.dim_size(0);
 
     Tensor* keys;
@@ -333,21 +468,23 @@ class MutableHashTableOfTensors final : public LookupInterface {
 
   int64_t MemoryUsed() const override {
     int64_t ret = 0;
-    tf_shared_lock l(mu_);
-    for (unsigned i = 0; i < table_.bucket_count(); ++i) {
-      size_t bucket_size = table_.bucket_size(i);
-      if (bucket_size == 0) {
-        ret++;
-      } else {
-        ret += bucket_size;
+    for (const Shard& shard : shards_) {
+      tf_shared_lock l(shard.mu);
+      for (unsigned i = 0; i < shard.table.bucket_count(); ++i) {
+        size_t bucket_size = shard.table.bucket_size(i);
+        if (bucket_size == 0) {
+          ret++;
+        } else {
+          ret += bucket_size;
+        }
       }
     }
     return sizeof(MutableHashTableOfTensors) + ret;
   }
 
   Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override {
-    tf_shared_lock l(mu_);
-    int64_t size = table_.size();
+    std::vector<tf_shared_lock> locks = LockAllShardsShared();
+    int64_t size = SizeLocked();
     Tensor keys(key_dtype(), TensorShape({size}));
     Tensor values(value_dtype(), TensorShape({size, value_shape_.dim_size(0)}));
     ExportKeysAndValues(&keys, &values);
@@ -384,28 +521,87 @@ class MutableHashTableOfTensors final : public LookupInterface {
   }
 
  private:
+  typedef gtl::InlinedVector<V, 4> ValueArray;
+
+  // Number of independently locked stripes the map is spread over. Must be a
+  // power of two.
+  static constexpr int kNumShards = 16;
+
+  struct Shard {
+    mutable mutex mu;
+    std::unordered_map<K, ValueArray> table TF_GUARDED_BY(mu);
+  };
+
+  // Returns the shard responsible for 'key'.  The multiplicative mix spreads
+  // the shard choice over the hash's high bits so striping stays balanced
+  // even for hash functions that are close to the identity on integers.
+  static uint8 ShardOf(const K& key) {
+    return static_cast<uint8>((static_cast<uint64>(std::hash<K>{}(key)) *
+                               uint64{0x9E3779B97F4A7C15}) >>
+                              60);
+  }
+
+  template <typename KeyFlat>
+  static gtl::InlinedVector<uint8, 64> ShardKeys(const KeyFlat& key_values) {
+    gtl::InlinedVector<uint8, 64> key_shards(key_values.size());
+    for (int64_t i = 0; i < key_values.size(); ++i) {
+      key_shards[i] = ShardOf(SubtleMustCopyIfIntegral(key_values(i)));
+    }
+    return key_shards;
+  }
+
+  // Acquires every shard mutex, always in shard order to avoid deadlock.
+  std::vector<tf_shared_lock> LockAllShardsShared() const
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<tf_shared_lock> locks;
+    locks.reserve(kNumShards);
+    for (const Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  std::vector<mutex_lock> LockAllShardsExclusive()
+      TF_NO_THREAD_SAFETY_ANALYSIS {
+    std::vector<mutex_lock> locks;
+    locks.reserve(kNumShards);
+    for (Shard& shard : shards_) {
+      locks.emplace_back(shard.mu);
+    }
+    return locks;
+  }
+
+  // The callers below must hold all shard locks.
+  int64_t SizeLocked() const TF_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t ret = 0;
+    for (const Shard& shard : shards_) {
+      ret += shard.table.size();
+    }
+    return ret;
+  }
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
-  // must point to tensors of size `table_.size()`.
+  // must point to tensors of size `SizeLocked()`.
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) {
+      TF_NO_THREAD_SAFETY_ANALYSIS {
     int64_t value_dim = value_shape_.dim_size(0);
     auto keys_data = keys->flat<K>();
     auto values_data = values->matrix<V>();
     int64_t i = 0;
-    for (auto it = table_.begin(); it != table_.end(); ++it, ++i) {
-      K key = it->first;
-      ValueArray value = it->second;
-      keys_data(i) = key;
-      for (int64_t j = 0; j < value_dim; j++) {
-        values_data(i, j) = value[j];
+    for (const Shard& shard : shards_) {
+      for (auto it = shard.table.begin(); it != shard.table.end();
+           ++it, ++i) {
+        keys_data(i) = it->first;
+        const ValueArray& value = it->second;
+        for (int64_t j = 0; j < value_dim; j++) {
+          values_data(i, j) = value[j];
+        }
       }
     }
   }
 
   TensorShape value_shape_;
-  mutable mutex mu_;
-  typedef gtl::InlinedVector<V, 4> ValueArray;
-  std::unordered_map<K, ValueArray> table_ TF_GUARDED_BY(mu_);
+  Shard shards_[kNumShards];
 };
 
 namespace {
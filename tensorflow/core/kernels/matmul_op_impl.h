@@ -32,10 +32,12 @@ limitations under the License.
 #include "tensorflow/core/framework/type_traits.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/kernels/fill_functor.h"
+#include "tensorflow/core/kernels/packed_weight_cache.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/matmul_autotune.h"
 #include "tensorflow/core/util/matmul_bcast.h"
 #include "tensorflow/core/util/work_sharder.h"
@@ -73,6 +75,21 @@ Eigen::IndexPair<Eigen::DenseIndex> ContractionDims(bool adj_x, bool adj_y) {
   return Eigen::IndexPair<Eigen::DenseIndex>(adj_x ? 0 : 1, adj_y ? 1 : 0);
 }
 
+// Whether transposed right-hand sides should be repacked once per process
+// through PackedWeightCache rather than re-packed by every contraction.
+// Opt-in, since the cache assumes the weight buffer is never mutated in
+// place (safe for inference graphs with constant or frozen weights).
+inline bool MatMulPackedWeightCacheEnabled() {
+  static bool enabled = [] {
+    bool v = false;
+    ReadBoolFromEnvVar("TF_MATMUL_CACHE_PACKED_WEIGHTS", /*default_val=*/false,
+                       &v)
+        .IgnoreError();
+    return v;
+  }();
+  return enabled;
+}
+
 // Parallel batch matmul kernel based on the multi-threaded tensor contraction
 // in Eigen.
 template <typename Scalar, bool IsComplex = true>
@@ -250,6 +267,55 @@ struct LaunchBatchMatMul<CPUDevice, Scalar> {
     // Jan 21, 2020.
     const int64_t kMaxCostOuterParallelism = 128 * 128;  // heuristic.
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    // A transposed right-hand side makes every contraction pack the weights
+    // from strided loads on each execution. When enabled, fetch (or create) a
+    // process-wide contiguous copy of the weight matrix from the packed
+    // weight cache and run the product in non-transposed form, so constant
+    // weights pay the repacking cost once per process instead of per step.
+    if (MatMulPackedWeightCacheEnabled() && (adj_y || trans_y) &&
+        !Eigen::NumTraits<Scalar>::IsComplex && bcast.y_batch_size() == 1) {
+      auto packer = [&in_y](Tensor* packed_t) {
+        *packed_t =
+            Tensor(in_y.dtype(), TensorShape({1, in_y.dim_size(2),
+                                              in_y.dim_size(1)}));
+        auto src = in_y.tensor<Scalar, 3>();
+        auto dst = packed_t->tensor<Scalar, 3>();
+        dst = src.shuffle(Eigen::array<int, 3>{0, 2, 1});
+        return OkStatus();
+      };
+      std::shared_ptr<const Tensor> packed;
+      if (PackedWeightCache::Global()
+              ->GetOrCreate(in_y, packer, &packed)
+              .ok()) {
+        Launch(context, in_x, *packed, adj_x, /*adj_y=*/false, trans_x,
+               /*trans_y=*/false, bcast, out);
+        return;
+      }
+    }
+    // Fold a batch of matmuls that share a single right-hand side into one
+    // larger matmul: [b, M, K] x [K, N] == [(b * M), K] x [K, N]. Serving
+    // graphs issue many tiny per-request products against shared weights;
+    // executed one by one none of them can fill the FMA pipeline or amortize
+    // packing the weights, whereas the folded product packs the shared weight
+    // panel once and streams the whole group through it. Requires x to be
+    // used in row-major (non-transposed) form so that the fold is a pure
+    // reshape; conjugation of y is excluded since the contraction below only
+    // transposes.
+    if (batch_size > 1 && !adj_x && !trans_x &&
+        !(Eigen::NumTraits<Scalar>::IsComplex && adj_y) &&
+        bcast.y_batch_size() == 1 && bcast.x_batch_size() == batch_size) {
+      const Eigen::ThreadPoolDevice d = context->eigen_cpu_device();
+      Eigen::array<Eigen::IndexPair<Eigen::DenseIndex>, 1> contract_pairs;
+      contract_pairs[0] = ContractionDims(false, adj_y || trans_y);
+      const int64_t m = in_x.dim_size(1);
+      const int64_t k = in_x.dim_size(2);
+      const int64_t n = out->dim_size(2);
+      auto Tx = in_x.shaped<Scalar, 2>({batch_size * m, k});
+      auto Ty = in_y.flat_inner_dims<Scalar, 2>();
+      auto Tz = out->shaped<Scalar, 2>({batch_size * m, n});
+      Tz.device(d) = Tx.contract(Ty, contract_pairs);
+      return;
+    }
     // TODO(rmlarsen): Reconsider the heuristics now that we have asynchronous
     // evaluation in Eigen Tensor.
     if (small_dim > 1 &&
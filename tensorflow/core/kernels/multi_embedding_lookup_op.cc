@@ -0,0 +1,172 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/array_ops.cc.
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "tensorflow/core/framework/bounds_check.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/prefetch.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+// Looks up rows in many embedding tables with one work-sharded pass instead
+// of one Gather op per table. With many small tables, per-op dispatch and
+// per-op sharding overhead dominates the actual memory traffic; here the
+// (table, row) pairs of all lookups form a single flat work space that is
+// sharded once across the pool, and row prefetches are pipelined across
+// table boundaries.
+template <typename T, typename Index>
+class MultiEmbeddingLookupOp : public OpKernel {
+ public:
+  explicit MultiEmbeddingLookupOp(OpKernelConstruction* c) : OpKernel(c) {}
+
+  void Compute(OpKernelContext* ctx) override {
+    OpInputList params_list;
+    OP_REQUIRES_OK(ctx, ctx->input_list("params", &params_list));
+    OpInputList indices_list;
+    OP_REQUIRES_OK(ctx, ctx->input_list("indices", &indices_list));
+    const int num_tables = params_list.size();
+
+    // Per-table views over a flat global row space: table t covers global
+    // rows [row_begin, row_begin + num_rows).
+    struct TableSlice {
+      const T* params;
+      const Index* indices;
+      T* out;
+      int64_t num_rows;     // Number of rows to look up, i.e. indices size.
+      int64_t limit;        // Number of rows in the table.
+      int64_t slice_elems;  // Elements per row.
+      int64_t row_begin;    // First global row of this table.
+    };
+    std::vector<TableSlice> tables(num_tables);
+    int64_t total_rows = 0;
+    int64_t total_elems = 0;
+    for (int t = 0; t < num_tables; ++t) {
+      const Tensor& params = params_list[t];
+      const Tensor& indices = indices_list[t];
+      OP_REQUIRES(ctx, TensorShapeUtils::IsVectorOrHigher(params.shape()),
+                  errors::InvalidArgument("params[", t,
+                                          "] must be at least rank 1"));
+      TensorShape out_shape = indices.shape();
+      for (int d = 1; d < params.dims(); ++d) {
+        OP_REQUIRES_OK(ctx, out_shape.AddDimWithStatus(params.dim_size(d)));
+      }
+      Tensor* out = nullptr;
+      OP_REQUIRES_OK(ctx, ctx->allocate_output(t, out_shape, &out));
+      TableSlice& table = tables[t];
+      table.params = params.flat<T>().data();
+      table.indices = indices.flat<Index>().data();
+      table.out = out->flat<T>().data();
+      table.num_rows = indices.NumElements();
+      table.limit = params.dim_size(0);
+      table.slice_elems =
+          table.limit > 0 ? params.NumElements() / table.limit : 0;
+      table.row_begin = total_rows;
+      total_rows += table.num_rows;
+      total_elems += table.num_rows * table.slice_elems;
+    }
+    if (total_rows == 0) return;
+
+    // Bad-index bookkeeping shared across shards, mirroring HandleCopies in
+    // gather_functor.h.
+    mutex mu;
+    int64_t bad_table = -1;
+    int64_t bad_pos = -1;
+    Index bad_index = 0;
+
+    auto work = [&tables, &mu, &bad_table, &bad_pos, &bad_index,
+                 num_tables](int64_t start, int64_t end) {
+      // Locate the table containing the first global row of this shard.
+      int t = 0;
+      while (start >= tables[t].row_begin + tables[t].num_rows) ++t;
+      for (int64_t row = start; row < end; ++row) {
+        while (row >= tables[t].row_begin + tables[t].num_rows) ++t;
+        const TableSlice& table = tables[t];
+        const int64_t i = row - table.row_begin;
+        const Index index = internal::SubtleMustCopy(table.indices[i]);
+        if (!FastBoundsCheck(index, table.limit)) {
+          mutex_lock l(mu);
+          bad_table = t;
+          bad_pos = i;
+          bad_index = index;
+          return;
+        }
+        // Prefetch the source row of the next lookup, crossing into the
+        // next non-empty table at a boundary. Like gather, the next index
+        // is used unvalidated for address computation only; prefetching a
+        // wild address does not fault.
+        if (row + 1 < end) {
+          int t_next = t;
+          while (row + 1 >=
+                 tables[t_next].row_begin + tables[t_next].num_rows) {
+            ++t_next;
+          }
+          const TableSlice& next = tables[t_next];
+          const int64_t i_next = row + 1 - next.row_begin;
+          port::prefetch<port::PREFETCH_HINT_T0>(
+              next.params + next.indices[i_next] * next.slice_elems);
+          port::prefetch<port::PREFETCH_HINT_T0>(next.out +
+                                                 i_next * next.slice_elems);
+        }
+        memcpy(table.out + i * table.slice_elems,
+               table.params + index * table.slice_elems,
+               table.slice_elems * sizeof(T));
+      }
+    };
+
+    auto* worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+    const int64_t avg_slice_bytes =
+        total_elems * static_cast<int64_t>(sizeof(T)) / total_rows;
+    Shard(worker_threads->num_threads, worker_threads->workers, total_rows,
+          avg_slice_bytes, work);
+
+    OP_REQUIRES(ctx, bad_table < 0,
+                errors::InvalidArgument("indices[", bad_table, "][", bad_pos,
+                                        "] = ", bad_index, " is not in [0, ",
+                                        tables[bad_table].limit, ")"));
+  }
+};
+
+#define REGISTER_MULTI_EMBEDDING_LOOKUP_FULL(dev, type, index_type)         \
+  REGISTER_KERNEL_BUILDER(Name("MultiEmbeddingLookup")                      \
+                              .Device(DEVICE_##dev)                         \
+                              .TypeConstraint<type>("T")                    \
+                              .TypeConstraint<index_type>("Tindices"),      \
+                          MultiEmbeddingLookupOp<type, index_type>)
+
+#define REGISTER_MULTI_EMBEDDING_LOOKUP(type)                \
+  REGISTER_MULTI_EMBEDDING_LOOKUP_FULL(CPU, type, int32);    \
+  REGISTER_MULTI_EMBEDDING_LOOKUP_FULL(CPU, type, int64_t)
+
+TF_CALL_float(REGISTER_MULTI_EMBEDDING_LOOKUP);
+TF_CALL_double(REGISTER_MULTI_EMBEDDING_LOOKUP);
+TF_CALL_half(REGISTER_MULTI_EMBEDDING_LOOKUP);
+TF_CALL_bfloat16(REGISTER_MULTI_EMBEDDING_LOOKUP);
+
+#undef REGISTER_MULTI_EMBEDDING_LOOKUP
+#undef REGISTER_MULTI_EMBEDDING_LOOKUP_FULL
+
+}  // namespace tensorflow
@@ -0,0 +1,112 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/kernels/ops_util.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class MultiEmbeddingLookupOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(int num_tables, DataType data_type, DataType index_type) {
+    TF_ASSERT_OK(NodeDefBuilder("myop", "MultiEmbeddingLookup")
+                     .Input(FakeInput(num_tables, data_type))
+                     .Input(FakeInput(num_tables, index_type))
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+};
+
+TEST_F(MultiEmbeddingLookupOpTest, TwoTables) {
+  MakeOp(2, DT_FLOAT, DT_INT32);
+
+  // Tables with different row widths.
+  AddInputFromArray<float>(TensorShape({3, 2}), {0, 1, 2, 3, 4, 5});
+  AddInputFromArray<float>(TensorShape({4, 1}), {10, 11, 12, 13});
+  AddInputFromArray<int32>(TensorShape({2}), {2, 0});
+  AddInputFromArray<int32>(TensorShape({3}), {3, 3, 1});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected0(allocator(), DT_FLOAT, TensorShape({2, 2}));
+  test::FillValues<float>(&expected0, {4, 5, 0, 1});
+  test::ExpectTensorEqual<float>(expected0, *GetOutput(0));
+  Tensor expected1(allocator(), DT_FLOAT, TensorShape({3, 1}));
+  test::FillValues<float>(&expected1, {13, 13, 11});
+  test::ExpectTensorEqual<float>(expected1, *GetOutput(1));
+}
+
+TEST_F(MultiEmbeddingLookupOpTest, Int64Indices) {
+  MakeOp(1, DT_FLOAT, DT_INT64);
+
+  AddInputFromArray<float>(TensorShape({5}), {0, 1, 2, 3, 4});
+  AddInputFromArray<int64_t>(TensorShape({4}), {4, 2, 2, 0});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({4}));
+  test::FillValues<float>(&expected, {4, 2, 2, 0});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+TEST_F(MultiEmbeddingLookupOpTest, EmptyIndices) {
+  MakeOp(2, DT_FLOAT, DT_INT32);
+
+  AddInputFromArray<float>(TensorShape({2, 2}), {0, 1, 2, 3});
+  AddInputFromArray<float>(TensorShape({2}), {4, 5});
+  AddInputFromArray<int32>(TensorShape({0}), {});
+  AddInputFromArray<int32>(TensorShape({2}), {1, 0});
+  TF_ASSERT_OK(RunOpKernel());
+
+  EXPECT_EQ(TensorShape({0, 2}), GetOutput(0)->shape());
+  Tensor expected1(allocator(), DT_FLOAT, TensorShape({2}));
+  test::FillValues<float>(&expected1, {5, 4});
+  test::ExpectTensorEqual<float>(expected1, *GetOutput(1));
+}
+
+TEST_F(MultiEmbeddingLookupOpTest, HigherRankIndices) {
+  MakeOp(1, DT_FLOAT, DT_INT32);
+
+  AddInputFromArray<float>(TensorShape({3, 2}), {0, 1, 2, 3, 4, 5});
+  AddInputFromArray<int32>(TensorShape({2, 2}), {0, 2, 1, 1});
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor expected(allocator(), DT_FLOAT, TensorShape({2, 2, 2}));
+  test::FillValues<float>(&expected, {0, 1, 4, 5, 2, 3, 2, 3});
+  test::ExpectTensorEqual<float>(expected, *GetOutput(0));
+}
+
+TEST_F(MultiEmbeddingLookupOpTest, Error_IndexOutOfRange) {
+  MakeOp(2, DT_FLOAT, DT_INT32);
+
+  AddInputFromArray<float>(TensorShape({3, 2}), {0, 1, 2, 3, 4, 5});
+  AddInputFromArray<float>(TensorShape({2, 2}), {6, 7, 8, 9});
+  AddInputFromArray<int32>(TensorShape({2}), {0, 1});
+  AddInputFromArray<int32>(TensorShape({2}), {1, 2});
+  Status s = RunOpKernel();
+  EXPECT_TRUE(absl::StrContains(s.ToString(),
+                                "indices[1][1] = 2 is not in [0, 2)"))
+      << s;
+}
+
+}  // namespace
+}  // namespace tensorflow
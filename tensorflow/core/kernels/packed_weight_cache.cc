@@ -0,0 +1,108 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/packed_weight_cache.h"
+
+#include <utility>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+namespace {
+
+int64_t MaxCacheBytes() {
+  int64_t max_mb = 256;
+  ReadInt64FromEnvVar("TF_PACKED_WEIGHT_CACHE_MAX_MB", max_mb, &max_mb)
+      .IgnoreError();
+  return max_mb << 20;
+}
+
+}  // namespace
+
+PackedWeightCache::PackedWeightCache() : max_bytes_(MaxCacheBytes()) {}
+
+/* static */ PackedWeightCache* PackedWeightCache::Global() {
+  static PackedWeightCache* cache = new PackedWeightCache;
+  return cache;
+}
+
+/* static */ std::string PackedWeightCache::MakeKey(const Tensor& source) {
+  std::string key = strings::StrCat(
+      reinterpret_cast<uintptr_t>(source.tensor_data().data()), ",",
+      static_cast<int>(source.dtype()));
+  for (int i = 0; i < source.dims(); ++i) {
+    strings::StrAppend(&key, ",", source.dim_size(i));
+  }
+  return key;
+}
+
+Status PackedWeightCache::GetOrCreate(
+    const Tensor& source, const std::function<Status(Tensor*)>& packer,
+    std::shared_ptr<const Tensor>* packed) {
+  const std::string key = MakeKey(source);
+  {
+    mutex_lock l(mu_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      it->second.last_use = ++use_counter_;
+      *packed = it->second.packed;
+      return OkStatus();
+    }
+  }
+
+  // Pack outside the lock; concurrent misses for the same weight may pack
+  // twice, but only one result is retained.
+  Tensor packed_tensor;
+  TF_RETURN_IF_ERROR(packer(&packed_tensor));
+  auto packed_ptr = std::make_shared<const Tensor>(std::move(packed_tensor));
+
+  mutex_lock l(mu_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    it->second.last_use = ++use_counter_;
+    *packed = it->second.packed;
+    return OkStatus();
+  }
+  Entry& entry = entries_[key];
+  entry.source_ref = source;
+  entry.packed = packed_ptr;
+  entry.last_use = ++use_counter_;
+  cached_bytes_ += packed_ptr->TotalBytes();
+  *packed = std::move(packed_ptr);
+  EvictIfNeededLocked();
+  return OkStatus();
+}
+
+int64_t PackedWeightCache::CacheSizeInBytes() const {
+  mutex_lock l(mu_);
+  return cached_bytes_;
+}
+
+void PackedWeightCache::EvictIfNeededLocked() {
+  while (cached_bytes_ > max_bytes_ && entries_.size() > 1) {
+    auto lru = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+      if (it->second.last_use < lru->second.last_use) {
+        lru = it;
+      }
+    }
+    cached_bytes_ -= lru->second.packed->TotalBytes();
+    entries_.erase(lru);
+  }
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,89 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_PACKED_WEIGHT_CACHE_H_
+#define TENSORFLOW_CORE_KERNELS_PACKED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// Process-wide cache of GEMM-friendly repackings of weight tensors.
+//
+// Dense layers re-derive the packed layout of their (constant) weight matrix
+// on every execution. This cache lets a kernel pack a weight once per process
+// instead of once per step: entries are keyed by the source tensor's buffer
+// pointer, dtype and shape, hold a reference to the source buffer (so the key
+// pointer cannot be recycled while the entry lives), and hand out refcounted
+// packed tensors so an entry can be evicted while kernels still use it.
+//
+// Callers must only cache tensors whose contents are immutable for the
+// lifetime of the process (constants, frozen resource variables): the cache
+// has no way to observe in-place mutation of the source buffer.
+//
+// The total bytes of packed data are bounded; least recently used entries are
+// evicted first. The bound can be overridden with the
+// TF_PACKED_WEIGHT_CACHE_MAX_MB environment variable.
+class PackedWeightCache {
+ public:
+  // Returns the process-wide cache instance.
+  static PackedWeightCache* Global();
+
+  // Looks up the packed form of `source`, invoking `packer` to create it on a
+  // miss. `packer` receives an empty tensor to fill. On success, *packed
+  // refers to the cached tensor and remains valid for as long as the caller
+  // holds the shared_ptr, even across eviction.
+  Status GetOrCreate(const Tensor& source,
+                     const std::function<Status(Tensor*)>& packer,
+                     std::shared_ptr<const Tensor>* packed);
+
+  // Total bytes held by cached packed tensors.
+  int64_t CacheSizeInBytes() const;
+
+ private:
+  PackedWeightCache();
+
+  struct Entry {
+    // Keeps the source buffer alive so its address uniquely identifies it.
+    Tensor source_ref;
+    std::shared_ptr<const Tensor> packed;
+    int64_t last_use = 0;
+  };
+
+  static std::string MakeKey(const Tensor& source);
+
+  void EvictIfNeededLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const int64_t max_bytes_;
+  mutable mutex mu_;
+  int64_t use_counter_ TF_GUARDED_BY(mu_) = 0;
+  int64_t cached_bytes_ TF_GUARDED_BY(mu_) = 0;
+  std::unordered_map<std::string, Entry> entries_ TF_GUARDED_BY(mu_);
+
+  PackedWeightCache(const PackedWeightCache&) = delete;
+  void operator=(const PackedWeightCache&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_PACKED_WEIGHT_CACHE_H_
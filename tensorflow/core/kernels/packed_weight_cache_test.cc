@@ -0,0 +1,89 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/packed_weight_cache.h"
+
+#include <memory>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+Tensor MakeWeight(float value) {
+  Tensor t(DT_FLOAT, TensorShape({4, 4}));
+  t.flat<float>().setConstant(value);
+  return t;
+}
+
+TEST(PackedWeightCacheTest, PacksOncePerSource) {
+  PackedWeightCache* cache = PackedWeightCache::Global();
+  Tensor weight = MakeWeight(1.0f);
+  int num_packs = 0;
+  auto packer = [&num_packs](Tensor* packed) {
+    ++num_packs;
+    *packed = Tensor(DT_FLOAT, TensorShape({4, 4}));
+    packed->flat<float>().setConstant(42.0f);
+    return OkStatus();
+  };
+
+  std::shared_ptr<const Tensor> first;
+  TF_ASSERT_OK(cache->GetOrCreate(weight, packer, &first));
+  EXPECT_EQ(1, num_packs);
+  EXPECT_EQ(42.0f, first->flat<float>()(0));
+
+  std::shared_ptr<const Tensor> second;
+  TF_ASSERT_OK(cache->GetOrCreate(weight, packer, &second));
+  EXPECT_EQ(1, num_packs);  // Served from cache.
+  EXPECT_EQ(first.get(), second.get());
+}
+
+TEST(PackedWeightCacheTest, DistinctSourcesGetDistinctEntries) {
+  PackedWeightCache* cache = PackedWeightCache::Global();
+  Tensor a = MakeWeight(1.0f);
+  Tensor b = MakeWeight(2.0f);
+  auto make_packer = [](float value) {
+    return [value](Tensor* packed) {
+      *packed = Tensor(DT_FLOAT, TensorShape({4, 4}));
+      packed->flat<float>().setConstant(value);
+      return OkStatus();
+    };
+  };
+
+  std::shared_ptr<const Tensor> packed_a;
+  std::shared_ptr<const Tensor> packed_b;
+  TF_ASSERT_OK(cache->GetOrCreate(a, make_packer(1.0f), &packed_a));
+  TF_ASSERT_OK(cache->GetOrCreate(b, make_packer(2.0f), &packed_b));
+  EXPECT_NE(packed_a.get(), packed_b.get());
+  EXPECT_EQ(1.0f, packed_a->flat<float>()(0));
+  EXPECT_EQ(2.0f, packed_b->flat<float>()(0));
+}
+
+TEST(PackedWeightCacheTest, PackerErrorIsPropagated) {
+  PackedWeightCache* cache = PackedWeightCache::Global();
+  Tensor weight = MakeWeight(3.0f);
+  auto failing_packer = [](Tensor* packed) {
+    return errors::Internal("pack failed");
+  };
+  std::shared_ptr<const Tensor> packed;
+  EXPECT_FALSE(cache->GetOrCreate(weight, failing_packer, &packed).ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
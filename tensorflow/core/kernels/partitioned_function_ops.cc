@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
@@ -40,6 +41,12 @@ limitations under the License.
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
 namespace tensorflow {
+namespace {
+
+// Node attr enabling result memoization for calls to stateless functions.
+constexpr char kMemoizeMaxEntriesAttr[] = "_memoize_max_entries";
+
+}  // namespace
 
 PartitionedCallOp::PartitionedCallOp(OpKernelConstruction* ctx)
     : AsyncOpKernel(ctx),
@@ -72,6 +79,14 @@ PartitionedCallOp::PartitionedCallOp(OpKernelConstruction* ctx)
                                 "tensorflow::ConfigProto proto."));
   }
   OP_REQUIRES_OK(ctx, ctx->GetAttr("executor_type", &executor_type_));
+  if (ctx->HasAttr(kMemoizeMaxEntriesAttr)) {
+    OP_REQUIRES_OK(
+        ctx, ctx->GetAttr(kMemoizeMaxEntriesAttr, &memoize_max_entries_));
+    OP_REQUIRES(ctx, memoize_max_entries_ >= 0,
+                errors::InvalidArgument(kMemoizeMaxEntriesAttr,
+                                        " must be non-negative, but was ",
+                                        memoize_max_entries_));
+  }
 }
 
 PartitionedCallOp::~PartitionedCallOp() {
@@ -129,7 +144,15 @@ void PartitionedCallOp::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
     }
   }
 
-  RunFunction(handle, inputs, lib, ctx, done);
+  Fprint128 memo_key{0, 0};
+  const bool memoize = memoize_max_entries_ > 0 &&
+                       InputsInHostMemory(ctx) && MemoKey(inputs, &memo_key);
+  if (memoize && ServeMemoized(memo_key, ctx)) {
+    done();
+    return;
+  }
+
+  RunFunction(handle, inputs, lib, ctx, done, memoize, memo_key);
 }
 
 Status PartitionedCallOp::FillOutputDevices(
@@ -166,10 +189,110 @@ Status PartitionedCallOp::FillOutputDevices(
   return OkStatus();
 }
 
+Status PartitionedCallOp::ValidateMemoizable(
+    const FunctionLibraryRuntime& lib) {
+  const FunctionLibraryDefinition* flib = lib.GetFunctionLibraryDefinition();
+  const FunctionDef* fdef = flib->Find(func_->name());
+  if (fdef == nullptr) {
+    return errors::NotFound("Failed to find definition for function \"",
+                            func_->name(), "\"");
+  }
+  for (const OpDef::ArgDef& arg_def : fdef->signature().input_arg()) {
+    if (arg_def.type() == DT_RESOURCE) {
+      return errors::InvalidArgument(
+          "Function \"", func_->name(), "\" has ", kMemoizeMaxEntriesAttr,
+          " set but takes resource input \"", arg_def.name(),
+          "\"; memoization requires a stateless function.");
+    }
+  }
+  for (const NodeDef& node : fdef->node_def()) {
+    const OpDef* op_def = nullptr;
+    TF_RETURN_IF_ERROR(flib->LookUpOpDef(node.op(), &op_def));
+    if (op_def->is_stateful()) {
+      return errors::InvalidArgument(
+          "Function \"", func_->name(), "\" has ", kMemoizeMaxEntriesAttr,
+          " set but contains stateful op \"", node.op(),
+          "\"; memoization requires a stateless function.");
+    }
+  }
+  return OkStatus();
+}
+
+bool PartitionedCallOp::InputsInHostMemory(OpKernelContext* ctx) {
+  if (ctx->device()->tensorflow_accelerator_device_info() == nullptr) {
+    // CPU placement: all input buffers are in host memory.
+    return true;
+  }
+  for (int i = 0; i < ctx->num_inputs(); ++i) {
+    if (ctx->input_memory_type(i) != HOST_MEMORY) return false;
+  }
+  return true;
+}
+
+bool PartitionedCallOp::MemoKey(const std::vector<Tensor>& inputs,
+                                Fprint128* key) {
+  Fprint128 h{static_cast<uint64>(inputs.size()), 0};
+  const auto combine = [&h](const Fprint128& fp) {
+    h.low64 = FingerprintCat64(h.low64, fp.low64);
+    h.high64 = FingerprintCat64(h.high64, fp.high64);
+  };
+  for (const Tensor& tensor : inputs) {
+    const uint64 dtype = static_cast<uint64>(tensor.dtype());
+    combine({dtype, dtype});
+    for (int d = 0; d < tensor.dims(); ++d) {
+      const uint64 dim = static_cast<uint64>(tensor.dim_size(d));
+      combine({dim, dim});
+    }
+    if (tensor.dtype() == DT_STRING) {
+      // tensor_data() of a string tensor covers the tstring headers, not the
+      // character data, so strings are fingerprinted element-wise.
+      const auto strings = tensor.flat<tstring>();
+      for (int64_t i = 0; i < strings.size(); ++i) {
+        combine(Fingerprint128(strings(i)));
+      }
+    } else if (DataTypeCanUseMemcpy(tensor.dtype())) {
+      combine(Fingerprint128(tensor.tensor_data()));
+    } else {
+      return false;
+    }
+  }
+  *key = h;
+  return true;
+}
+
+bool PartitionedCallOp::ServeMemoized(const Fprint128& key,
+                                      OpKernelContext* ctx) {
+  mutex_lock l(memo_mu_);
+  auto it = memo_entries_.find(key);
+  if (it == memo_entries_.end()) return false;
+  memo_lru_.splice(memo_lru_.begin(), memo_lru_, it->second.lru_position);
+  for (size_t i = 0; i < it->second.rets.size(); ++i) {
+    ctx->set_output(i, it->second.rets[i]);
+  }
+  return true;
+}
+
+void PartitionedCallOp::InsertMemoized(const Fprint128& key,
+                                       const std::vector<Tensor>& rets) {
+  mutex_lock l(memo_mu_);
+  if (memo_entries_.find(key) != memo_entries_.end()) return;
+  memo_lru_.push_front(key);
+  MemoEntry& entry = memo_entries_[key];
+  entry.lru_position = memo_lru_.begin();
+  entry.rets = rets;
+  while (memo_entries_.size() > static_cast<size_t>(memoize_max_entries_)) {
+    memo_entries_.erase(memo_lru_.back());
+    memo_lru_.pop_back();
+  }
+}
+
 Status PartitionedCallOp::Instantiate(FunctionLibraryRuntime* lib,
                                       OpKernelContext* ctx,
                                       std::vector<Tensor>* inputs,
                                       FunctionLibraryRuntime::Handle* handle) {
+  if (memoize_max_entries_ > 0) {
+    TF_RETURN_IF_ERROR(ValidateMemoizable(*lib));
+  }
   FunctionLibraryRuntime::InstantiateOptions opts;
   const auto* config = (ctx->function_library())
                            ? ctx->function_library()->config_proto()
@@ -234,7 +357,8 @@ Status PartitionedCallOp::Instantiate(FunctionLibraryRuntime* lib,
 void PartitionedCallOp::RunFunction(FunctionLibraryRuntime::Handle handle,
                                     const std::vector<Tensor>& inputs,
                                     FunctionLibraryRuntime* lib,
-                                    OpKernelContext* ctx, DoneCallback done) {
+                                    OpKernelContext* ctx, DoneCallback done,
+                                    bool memoize, Fprint128 memo_key) {
   FunctionLibraryRuntime::Options run_opts;
   ResourceMgr* resource_mgr = lib->device()->resource_manager();
   ScopedStepContainer* step_container = new ScopedStepContainer(
@@ -260,8 +384,8 @@ void PartitionedCallOp::RunFunction(FunctionLibraryRuntime::Handle handle,
   const string& func_name = func_->name();
   profiler::TraceMe trace_me("PartitionedCallOp");
   lib->Run(run_opts, handle, inputs, rets,
-           [rets, done = std::move(done), ctx, func_name,
-            step_container](const Status& status) {
+           [this, rets, done = std::move(done), ctx, func_name, step_container,
+            memoize, memo_key](const Status& status) {
              if (!status.ok()) {
                const string function_and_msg =
                    strings::StrCat(errors::FormatFunctionForError(func_name),
@@ -269,6 +393,12 @@ void PartitionedCallOp::RunFunction(FunctionLibraryRuntime::Handle handle,
                ctx->SetStatus(
                    errors::CreateWithUpdatedMessage(status, function_and_msg));
              } else {
+               if (memoize) {
+                 // The cached copies keep the output buffers' refcounts above
+                 // one, which also keeps downstream kernels from forwarding
+                 // (and mutating) them.
+                 InsertMemoized(memo_key, *rets);
+               }
                for (int i = 0; i < rets->size(); ++i) {
                  ctx->set_output(i, (*rets)[i]);
                }
@@ -16,10 +16,14 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_PARTITIONED_FUNCTION_OPS_H_
 #define TENSORFLOW_CORE_KERNELS_PARTITIONED_FUNCTION_OPS_H_
 
+#include <list>
+#include <vector>
+
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/platform/fingerprint.h"
 
 namespace tensorflow {
 
@@ -52,7 +56,36 @@ class PartitionedCallOp : public AsyncOpKernel {
   void RunFunction(FunctionLibraryRuntime::Handle handle,
                    const std::vector<Tensor>& inputs,
                    FunctionLibraryRuntime* lib, OpKernelContext* ctx,
-                   DoneCallback done);
+                   DoneCallback done, bool memoize, Fprint128 memo_key);
+
+  // Returns an error unless the called function is memoizable: all of its
+  // ops must be stateless and none of its inputs may be resources.  Called
+  // functions nested inside the body are not walked; marking a function for
+  // memoization asserts that it is deterministic, and this check catches the
+  // common mistakes.
+  Status ValidateMemoizable(const FunctionLibraryRuntime& lib);
+
+  // Returns true if every input tensor resides in host memory.  MemoKey
+  // fingerprints input buffers with host-side reads, which would fault (or
+  // read garbage) on the device-resident inputs of an accelerator-placed
+  // call; such calls run uncached.
+  static bool InputsInHostMemory(OpKernelContext* ctx);
+
+  // Computes the memoization key for `inputs` as a 128-bit fingerprint over
+  // each tensor's dtype, shape, and contents; the cache serves its hits as
+  // the call's outputs, and 64 bits leave key collisions (i.e. silently
+  // wrong results) within reach of large caches.  Returns false if some
+  // input cannot be fingerprinted (e.g. variants), in which case the call
+  // runs uncached.
+  static bool MemoKey(const std::vector<Tensor>& inputs, Fprint128* key);
+
+  // Serves the outputs cached under `key`, refreshing its LRU position.
+  // Returns false on a cache miss.
+  bool ServeMemoized(const Fprint128& key, OpKernelContext* ctx);
+
+  // Caches `rets` under `key`, evicting least-recently-used entries beyond
+  // the configured capacity.
+  void InsertMemoized(const Fprint128& key, const std::vector<Tensor>& rets);
 
   // Using unique pointers to avoid including proto headers in kernel headers
   std::unique_ptr<NameAttrList> func_;
@@ -66,6 +99,22 @@ class PartitionedCallOp : public AsyncOpKernel {
   // different FLRs.
   gtl::FlatMap<FunctionLibraryRuntime*, FunctionLibraryRuntime::Handle> handles_
       TF_GUARDED_BY(mu_);
+
+  // If positive, results of this call are memoized: inputs are fingerprinted
+  // and outputs are served from a bounded LRU cache.  Configured with the
+  // "_memoize_max_entries" node attr, which may only be placed on calls to
+  // stateless functions (see ValidateMemoizable).
+  int64_t memoize_max_entries_ = 0;
+
+  struct MemoEntry {
+    std::list<Fprint128>::iterator lru_position;
+    std::vector<Tensor> rets;
+  };
+  mutex memo_mu_;
+  // Most-recently-used key at the front.
+  std::list<Fprint128> memo_lru_ TF_GUARDED_BY(memo_mu_);
+  gtl::FlatMap<Fprint128, MemoEntry, Fprint128Hasher> memo_entries_
+      TF_GUARDED_BY(memo_mu_);
 };
 
 }  // namespace tensorflow
@@ -28,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/conv_ops.h"
 #include "tensorflow/core/kernels/meta_support.h"
 #include "tensorflow/core/kernels/quantization_utils.h"
+#include "tensorflow/core/kernels/quantized_cpu_isa_dispatch.h"
 #include "tensorflow/core/kernels/reference_gemm.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/errors.h"
@@ -184,6 +185,57 @@ class ReferenceConvFunctor {
   }
 };
 
+// Signature of the uint8 * uint8 -> int32 im2col GEMM microkernels selected
+// at runtime by CPU feature. The patch matrix produced by im2col and the
+// filter matrix are both row-major and never transposed, so no transpose
+// arguments are needed.
+typedef void (*QuantizedConv2DGemmKernel)(
+    OpKernelContext* context, const quint8* im2col_data,
+    const quint8* filter_data, qint32* output_data, int m, int n, int k,
+    int input_offset, int filter_offset, int lda, int ldb, int ldc);
+
+// Returns the dispatcher that selects the im2col GEMM microkernel for the
+// host CPU. AVX512-VNNI and AMX implementations register themselves here
+// alongside the portable gemmlowp one.
+QuantizedCpuIsaDispatcher<QuantizedConv2DGemmKernel>*
+GetQuantizedConv2DGemmDispatcher() {
+  static auto* dispatcher =
+      new QuantizedCpuIsaDispatcher<QuantizedConv2DGemmKernel>;
+  return dispatcher;
+}
+
+// Portable implementation of the im2col GEMM, on top of gemmlowp.
+void GemmlowpConv2DGemm(OpKernelContext* context, const quint8* im2col_data,
+                        const quint8* filter_data, qint32* output_data, int m,
+                        int n, int k, int input_offset, int filter_offset,
+                        int lda, int ldb, int ldc) {
+  const uint8* im2col_data_as_uint8 = &(im2col_data->value);
+  const uint8* filter_data_as_uint8 = &(filter_data->value);
+  int32* output_data_as_int32 = &(output_data->value);
+  gemmlowp::MatrixMap<const std::uint8_t, gemmlowp::MapOrder::RowMajor> lhs(
+      im2col_data_as_uint8, m, k, lda);
+  gemmlowp::MatrixMap<const std::uint8_t, gemmlowp::MapOrder::RowMajor> rhs(
+      filter_data_as_uint8, k, n, ldb);
+  gemmlowp::MatrixMap<std::int32_t, gemmlowp::MapOrder::RowMajor> result(
+      output_data_as_int32, m, n, ldc);
+  const std::tuple<> empty_pipeline = {};
+
+  auto& worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+  TensorflowGemmContext gemm_context(worker_threads.num_threads,
+                                     worker_threads.workers);
+  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
+                                   gemmlowp::DefaultL8R8BitDepthParams>(
+      &gemm_context, lhs, rhs, &result, -input_offset, -filter_offset,
+      empty_pipeline);
+  // Since gemmlowp uses assembly to write to the output, msan won't
+  // detect the output buffer as written to, so we mark it manually.
+  TF_ANNOTATE_MEMORY_IS_INITIALIZED(output_data_as_int32,
+                                    m * n * sizeof(int32));
+}
+
+REGISTER_QUANTIZED_CPU_KERNEL(GetQuantizedConv2DGemmDispatcher(),
+                              QuantizedCpuIsa::kGeneric, GemmlowpConv2DGemm);
+
 // We don't want to allocate a buffer to hold all the patches if the size is
 // going to be extremely large, so break it into chunks if it's bigger than
 // a limit. Each chunk will be processed serially, so we can refill the
@@ -401,48 +453,16 @@ class Im2ColConvFunctor {
                             -input_offset, -filter_offset, lda, ldb, ldc);
       } else if (std::is_same<T1, quint8>() && std::is_same<T2, quint8>() &&
                  std::is_same<T3, qint32>() && (output_offset == 0) &&
-                 (output_mult == 1) && (output_shift == 0)) {
-        // The gemmlowp optimized library only works for a particular set of
-        // data types, so check if we meet those requirements and fall back to a
-        // slower reference implementation if not.
-        const uint8* im2col_data_as_uint8 = &(im2col_buffer->value);
-        const uint8* filter_data_as_uint8 = &(filter_data->value);
-        int32* output_data_as_int32 = &(chunk_output_data->value);
-        // All of the transpose_* variables are currently compile-time consts,
-        // so we could just hard-code these values too, but that would break if
-        // anybody changed those values in the future (e.g. to match the ability
-        // of MatMul to specify them as attributes). We're using a verbose
-        // approach of deriving the order values from the transpose variables to
-        // be able to catch any changes like that.
-        static const gemmlowp::MapOrder ResultOrder =
-            !transpose_c ? gemmlowp::MapOrder::RowMajor
-                         : gemmlowp::MapOrder::ColMajor;
-        static const gemmlowp::MapOrder LhsOrder =
-            !transpose_a ? gemmlowp::MapOrder::RowMajor
-                         : gemmlowp::MapOrder::ColMajor;
-        static const gemmlowp::MapOrder RhsOrder =
-            !transpose_b ? gemmlowp::MapOrder::RowMajor
-                         : gemmlowp::MapOrder::ColMajor;
-        gemmlowp::MatrixMap<const std::uint8_t, LhsOrder> lhs(
-            im2col_data_as_uint8, m, k, lda);
-        gemmlowp::MatrixMap<const std::uint8_t, RhsOrder> rhs(
-            filter_data_as_uint8, k, n, ldb);
-        gemmlowp::MatrixMap<std::int32_t, ResultOrder> result(
-            output_data_as_int32, m, n, ldc);
-        const std::tuple<> empty_pipeline = {};
-
-        auto& worker_threads =
-            *(context->device()->tensorflow_cpu_worker_threads());
-        TensorflowGemmContext context(worker_threads.num_threads,
-                                      worker_threads.workers);
-        gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                         gemmlowp::DefaultL8R8BitDepthParams>(
-            &context, lhs, rhs, &result, -input_offset, -filter_offset,
-            empty_pipeline);
-        // Since gemmlowp uses assembly to write to the output, msan won't
-        // detect the output buffer as written to, so we mark it manually.
-        TF_ANNOTATE_MEMORY_IS_INITIALIZED(output_data_as_int32,
-                                          m * n * sizeof(int32));
+                 (output_mult == 1) && (output_shift == 0) &&
+                 (transpose_a == false) && (transpose_b == false) &&
+                 (transpose_c == false)) {
+        // The optimized microkernels only work for a particular set of data
+        // types and layouts, so check if we meet those requirements and fall
+        // back to a slower reference implementation if not. The implementation
+        // itself is selected per the host's CPU features on first execution.
+        GetQuantizedConv2DGemmDispatcher()->Select()(
+            context, im2col_buffer, filter_data, chunk_output_data, m, n, k,
+            input_offset, filter_offset, lda, ldb, ldc);
       } else {
         ReferenceGemm<T1, T2, T3>(
             transpose_a, transpose_b, transpose_c, m, n, k, im2col_buffer,
@@ -0,0 +1,83 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/quantized_cpu_isa_dispatch.h"
+
+#include <algorithm>
+#include <string>
+
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace {
+
+QuantizedCpuIsa DetectHighestSupportedIsa() {
+  using port::TestCPUFeature;
+  if (TestCPUFeature(port::AMX_TILE) && TestCPUFeature(port::AMX_INT8)) {
+    return QuantizedCpuIsa::kAmxInt8;
+  }
+  if (TestCPUFeature(port::AVX512_VNNI)) {
+    return QuantizedCpuIsa::kAvx512Vnni;
+  }
+  if (TestCPUFeature(port::AVX2)) {
+    return QuantizedCpuIsa::kAvx2;
+  }
+  return QuantizedCpuIsa::kGeneric;
+}
+
+// Caps `detected` to the ISA named by TF_QUANTIZED_CPU_ISA, if set. The
+// environment variable can only disable extensions the host supports, never
+// enable unsupported ones.
+QuantizedCpuIsa ApplyEnvironmentCap(QuantizedCpuIsa detected) {
+  std::string cap;
+  TF_CHECK_OK(ReadStringFromEnvVar("TF_QUANTIZED_CPU_ISA", "", &cap));
+  if (cap.empty()) {
+    return detected;
+  }
+  QuantizedCpuIsa requested;
+  if (cap == "generic") {
+    requested = QuantizedCpuIsa::kGeneric;
+  } else if (cap == "avx2") {
+    requested = QuantizedCpuIsa::kAvx2;
+  } else if (cap == "avx512_vnni") {
+    requested = QuantizedCpuIsa::kAvx512Vnni;
+  } else if (cap == "amx_int8") {
+    requested = QuantizedCpuIsa::kAmxInt8;
+  } else {
+    LOG(WARNING) << "Ignoring unknown TF_QUANTIZED_CPU_ISA value \"" << cap
+                 << "\"; expected one of \"generic\", \"avx2\", "
+                    "\"avx512_vnni\" or \"amx_int8\".";
+    return detected;
+  }
+  if (static_cast<int>(requested) > static_cast<int>(detected)) {
+    LOG(WARNING) << "TF_QUANTIZED_CPU_ISA requests \"" << cap
+                 << "\" but the host CPU does not support it; quantized "
+                    "kernels will use the best supported ISA instead.";
+  }
+  return static_cast<QuantizedCpuIsa>(std::min(static_cast<int>(requested),
+                                               static_cast<int>(detected)));
+}
+
+}  // namespace
+
+QuantizedCpuIsa HighestSupportedQuantizedCpuIsa() {
+  static const QuantizedCpuIsa isa =
+      ApplyEnvironmentCap(DetectHighestSupportedIsa());
+  return isa;
+}
+
+}  // namespace tensorflow
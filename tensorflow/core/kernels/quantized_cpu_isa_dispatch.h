@@ -0,0 +1,114 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_KERNELS_QUANTIZED_CPU_ISA_DISPATCH_H_
+#define TENSORFLOW_CORE_KERNELS_QUANTIZED_CPU_ISA_DISPATCH_H_
+
+#include <atomic>
+
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+// The x86 instruction set extensions a quantized CPU microkernel may target,
+// in increasing order of capability. The quantized op kernels use these to
+// pick the fastest implementation available on the host at first execution,
+// so a single fleet binary exploits AVX512-VNNI or AMX hosts without being
+// rebuilt for them.
+enum class QuantizedCpuIsa : int {
+  kGeneric = 0,     // Portable implementation, always available.
+  kAvx2 = 1,        // AVX2.
+  kAvx512Vnni = 2,  // AVX512 vector neural network instructions.
+  kAmxInt8 = 3,     // AMX int8 tile multiplication (Sapphire Rapids).
+};
+
+constexpr int kNumQuantizedCpuIsas = 4;
+
+// Returns the most capable ISA the host CPU supports. Detection runs once per
+// process. The result can be capped with the TF_QUANTIZED_CPU_ISA environment
+// variable ("generic", "avx2", "avx512_vnni" or "amx_int8"), which helps
+// performance triage on heterogeneous fleets.
+QuantizedCpuIsa HighestSupportedQuantizedCpuIsa();
+
+// Registry of per-ISA implementations of one kernel entry point `FnT`, which
+// must be a function pointer type. Each quantized op owns one dispatcher per
+// entry point; implementations register themselves at static initialization
+// time through REGISTER_QUANTIZED_CPU_KERNEL, and the best implementation the
+// host supports is resolved once, on the op's first execution.
+template <typename FnT>
+class QuantizedCpuIsaDispatcher {
+ public:
+  void Register(QuantizedCpuIsa isa, FnT fn) {
+    impls_[static_cast<int>(isa)] = fn;
+  }
+
+  // Returns the implementation registered for the most capable ISA that does
+  // not exceed `isa`, falling back towards the generic implementation. An
+  // implementation for QuantizedCpuIsa::kGeneric must have been registered.
+  FnT Select(QuantizedCpuIsa isa) const {
+    for (int i = static_cast<int>(isa); i > 0; --i) {
+      if (impls_[i] != nullptr) {
+        return impls_[i];
+      }
+    }
+    DCHECK(impls_[0] != nullptr)
+        << "No generic quantized CPU kernel was registered.";
+    return impls_[0];
+  }
+
+  // As above for the ISA the host CPU supports. The choice is cached, so
+  // implementations registered after the first call are ignored.
+  FnT Select() {
+    FnT selected = selected_.load(std::memory_order_acquire);
+    if (selected == nullptr) {
+      selected = Select(HighestSupportedQuantizedCpuIsa());
+      selected_.store(selected, std::memory_order_release);
+    }
+    return selected;
+  }
+
+ private:
+  FnT impls_[kNumQuantizedCpuIsas] = {};
+  std::atomic<FnT> selected_{nullptr};
+};
+
+namespace internal {
+
+// Registers `fn` with `dispatcher` when constructed. Use the
+// REGISTER_QUANTIZED_CPU_KERNEL macro below instead of this directly.
+template <typename FnT>
+struct QuantizedCpuKernelRegistrar {
+  QuantizedCpuKernelRegistrar(QuantizedCpuIsaDispatcher<FnT>* dispatcher,
+                              QuantizedCpuIsa isa, FnT fn) {
+    dispatcher->Register(isa, fn);
+  }
+};
+
+}  // namespace internal
+
+// Registers `fn` as the `isa` implementation of the kernel entry point
+// dispatched through `dispatcher`, a QuantizedCpuIsaDispatcher<FnT>*. Must be
+// used at namespace scope.
+#define REGISTER_QUANTIZED_CPU_KERNEL(dispatcher, isa, fn) \
+  REGISTER_QUANTIZED_CPU_KERNEL_UNIQ_HELPER(__COUNTER__, dispatcher, isa, fn)
+#define REGISTER_QUANTIZED_CPU_KERNEL_UNIQ_HELPER(ctr, dispatcher, isa, fn) \
+  REGISTER_QUANTIZED_CPU_KERNEL_UNIQ(ctr, dispatcher, isa, fn)
+#define REGISTER_QUANTIZED_CPU_KERNEL_UNIQ(ctr, dispatcher, isa, fn) \
+  static ::tensorflow::internal::QuantizedCpuKernelRegistrar        \
+      registrar__quantized_cpu_kernel_##ctr((dispatcher), (isa), (fn))
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_KERNELS_QUANTIZED_CPU_ISA_DISPATCH_H_
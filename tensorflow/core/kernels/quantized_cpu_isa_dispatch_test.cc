@@ -0,0 +1,70 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/kernels/quantized_cpu_isa_dispatch.h"
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+typedef int (*TestKernel)();
+
+int GenericKernel() { return 0; }
+int Avx2Kernel() { return 1; }
+int AmxInt8Kernel() { return 3; }
+
+TEST(QuantizedCpuIsaDispatchTest, SelectsBestRegisteredIsa) {
+  QuantizedCpuIsaDispatcher<TestKernel> dispatcher;
+  dispatcher.Register(QuantizedCpuIsa::kGeneric, GenericKernel);
+  dispatcher.Register(QuantizedCpuIsa::kAvx2, Avx2Kernel);
+  dispatcher.Register(QuantizedCpuIsa::kAmxInt8, AmxInt8Kernel);
+
+  EXPECT_EQ(dispatcher.Select(QuantizedCpuIsa::kGeneric)(), 0);
+  EXPECT_EQ(dispatcher.Select(QuantizedCpuIsa::kAvx2)(), 1);
+  // No AVX512-VNNI implementation is registered, so the next most capable
+  // registered one is used.
+  EXPECT_EQ(dispatcher.Select(QuantizedCpuIsa::kAvx512Vnni)(), 1);
+  EXPECT_EQ(dispatcher.Select(QuantizedCpuIsa::kAmxInt8)(), 3);
+}
+
+TEST(QuantizedCpuIsaDispatchTest, FallsBackToGeneric) {
+  QuantizedCpuIsaDispatcher<TestKernel> dispatcher;
+  dispatcher.Register(QuantizedCpuIsa::kGeneric, GenericKernel);
+
+  EXPECT_EQ(dispatcher.Select(QuantizedCpuIsa::kAmxInt8)(), 0);
+  // Whatever the host supports, only the generic implementation exists.
+  EXPECT_EQ(dispatcher.Select(), GenericKernel);
+}
+
+TEST(QuantizedCpuIsaDispatchTest, HostIsaDetectionIsStable) {
+  EXPECT_EQ(HighestSupportedQuantizedCpuIsa(),
+            HighestSupportedQuantizedCpuIsa());
+}
+
+QuantizedCpuIsaDispatcher<TestKernel>* GetTestDispatcher() {
+  static auto* dispatcher = new QuantizedCpuIsaDispatcher<TestKernel>;
+  return dispatcher;
+}
+
+REGISTER_QUANTIZED_CPU_KERNEL(GetTestDispatcher(), QuantizedCpuIsa::kGeneric,
+                              GenericKernel);
+
+TEST(QuantizedCpuIsaDispatchTest, MacroRegistersAtStaticInitialization) {
+  EXPECT_EQ(GetTestDispatcher()->Select()(), 0);
+}
+
+}  // namespace
+}  // namespace tensorflow
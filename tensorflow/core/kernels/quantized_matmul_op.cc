@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/kernels/meta_support.h"
 #include "tensorflow/core/kernels/quantization_utils.h"
+#include "tensorflow/core/kernels/quantized_cpu_isa_dispatch.h"
 #include "tensorflow/core/kernels/reference_gemm.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/errors.h"
@@ -66,6 +67,58 @@ void GemmlowpMultiply(OpKernelContext* op_context, const quint8* a_data,
   TF_ANNOTATE_MEMORY_IS_INITIALIZED(c_data_as_int32, m * n * sizeof(int32));
 }
 
+// Signature of the uint8 * uint8 -> int32 matmul microkernels selected at
+// runtime by CPU feature. The transpose attributes are passed as runtime
+// values so a single implementation can be registered per ISA.
+typedef void (*QuantizedMatMulKernel)(OpKernelContext* op_context,
+                                      bool transpose_a, bool transpose_b,
+                                      const quint8* a_data,
+                                      const quint8* b_data, qint32* c_data,
+                                      int m, int n, int k, int offset_a,
+                                      int offset_b, int lda, int ldb, int ldc);
+
+// Returns the dispatcher that selects the matmul microkernel for the host
+// CPU. AVX512-VNNI and AMX implementations register themselves here alongside
+// the portable gemmlowp one.
+QuantizedCpuIsaDispatcher<QuantizedMatMulKernel>*
+GetQuantizedMatMulDispatcher() {
+  static auto* dispatcher =
+      new QuantizedCpuIsaDispatcher<QuantizedMatMulKernel>;
+  return dispatcher;
+}
+
+// Portable implementation; expands the runtime transpose attributes into the
+// compile-time constants gemmlowp needs.
+void GemmlowpMatMul(OpKernelContext* op_context, bool transpose_a,
+                    bool transpose_b, const quint8* a_data,
+                    const quint8* b_data, qint32* c_data, int m, int n, int k,
+                    int offset_a, int offset_b, int lda, int ldb, int ldc) {
+  if (transpose_a) {
+    if (transpose_b) {
+      GemmlowpMultiply<true, true, false>(op_context, a_data, b_data, c_data,
+                                          m, n, k, offset_a, offset_b, lda,
+                                          ldb, ldc);
+    } else {
+      GemmlowpMultiply<true, false, false>(op_context, a_data, b_data, c_data,
+                                           m, n, k, offset_a, offset_b, lda,
+                                           ldb, ldc);
+    }
+  } else {
+    if (transpose_b) {
+      GemmlowpMultiply<false, true, false>(op_context, a_data, b_data, c_data,
+                                           m, n, k, offset_a, offset_b, lda,
+                                           ldb, ldc);
+    } else {
+      GemmlowpMultiply<false, false, false>(op_context, a_data, b_data, c_data,
+                                            m, n, k, offset_a, offset_b, lda,
+                                            ldb, ldc);
+    }
+  }
+}
+
+REGISTER_QUANTIZED_CPU_KERNEL(GetQuantizedMatMulDispatcher(),
+                              QuantizedCpuIsa::kGeneric, GemmlowpMatMul);
+
 template <class T1, class T2, class Toutput>
 class QuantizedMatMulOp : public OpKernel {
  public:
@@ -158,30 +211,13 @@ class QuantizedMatMulOp : public OpKernel {
     } else if (std::is_same<T1, quint8>() && std::is_same<T2, quint8>() &&
                std::is_same<Toutput, qint32>() && (offset_c == 0) &&
                (mult_c == 1) && (shift_c == 0) && (transpose_c == false)) {
-      // The gemmlowp optimized library only works for a particular set of data
-      // types, so check if we meet those requirements and fall back to a slower
-      // reference implementation if not.
-      if (transpose_a_) {
-        if (transpose_b_) {
-          GemmlowpMultiply<true, true, false>(context, a_data, b_data, c_data,
-                                              m, n, k, offset_a, offset_b, lda,
-                                              ldb, ldc);
-        } else {
-          GemmlowpMultiply<true, false, false>(context, a_data, b_data, c_data,
-                                               m, n, k, offset_a, offset_b, lda,
-                                               ldb, ldc);
-        }
-      } else {
-        if (transpose_b_) {
-          GemmlowpMultiply<false, true, false>(context, a_data, b_data, c_data,
-                                               m, n, k, offset_a, offset_b, lda,
-                                               ldb, ldc);
-        } else {
-          GemmlowpMultiply<false, false, false>(context, a_data, b_data, c_data,
-                                                m, n, k, offset_a, offset_b,
-                                                lda, ldb, ldc);
-        }
-      }
+      // The optimized microkernels only work for a particular set of data
+      // types, so check if we meet those requirements and fall back to a
+      // slower reference implementation if not. The implementation itself is
+      // selected per the host's CPU features on first execution.
+      GetQuantizedMatMulDispatcher()->Select()(
+          context, transpose_a_, transpose_b_, a_data, b_data, c_data, m, n, k,
+          offset_a, offset_b, lda, ldb, ldc);
     } else {
       ReferenceGemm<T1, T2, Toutput>(
           transpose_a_, transpose_b_, transpose_c, m, n, k, a_data, offset_a,
@@ -0,0 +1,144 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <gtest/gtest.h>
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class RaggedReduceOpTest : public ::tensorflow::OpsTestBase {
+ protected:
+  // Builds the tensorflow test graph for RaggedReduceSum/RaggedReduceMean.
+  template <typename T>
+  void BuildRaggedReduceGraph(const string& op_name) {
+    const auto& dtype = DataTypeToEnum<T>::v();
+    TF_ASSERT_OK(NodeDefBuilder("tested_op", op_name)
+                     .Input(FakeInput(DT_INT64))  // rt_nested_splits
+                     .Input(FakeInput(dtype))     // rt_dense_values
+                     .Attr("T", dtype)
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+};
+
+TEST_F(RaggedReduceOpTest, SumScalarValues) {
+  BuildRaggedReduceGraph<float>("RaggedReduceSum");
+  // [[1, 2, 3], [], [4, 5]]
+  AddInputFromArray<int64_t>(TensorShape({4}), {0, 3, 3, 5});
+  AddInputFromArray<float>(TensorShape({5}), {1, 2, 3, 4, 5});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorNear<float>(*GetOutput(0),
+                                test::AsTensor<float>({6, 0, 9}), 1e-6);
+}
+
+TEST_F(RaggedReduceOpTest, SumIntValues) {
+  BuildRaggedReduceGraph<int32>("RaggedReduceSum");
+  // [[1, 2], [3]]
+  AddInputFromArray<int64_t>(TensorShape({3}), {0, 2, 3});
+  AddInputFromArray<int32>(TensorShape({3}), {1, 2, 3});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorEqual<int32>(*GetOutput(0),
+                                 test::AsTensor<int32>({3, 3}));
+}
+
+TEST_F(RaggedReduceOpTest, Sum2DValues) {
+  BuildRaggedReduceGraph<float>("RaggedReduceSum");
+  // [[[1, 2], [3, 4]], [[5, 6]]]
+  AddInputFromArray<int64_t>(TensorShape({3}), {0, 2, 3});
+  AddInputFromArray<float>(TensorShape({3, 2}), {1, 2, 3, 4, 5, 6});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorNear<float>(
+      *GetOutput(0), test::AsTensor<float>({4, 6, 5, 6}, {2, 2}), 1e-6);
+}
+
+TEST_F(RaggedReduceOpTest, MeanScalarValues) {
+  BuildRaggedReduceGraph<float>("RaggedReduceMean");
+  // [[1, 2, 3], [], [4, 5]]
+  AddInputFromArray<int64_t>(TensorShape({4}), {0, 3, 3, 5});
+  AddInputFromArray<float>(TensorShape({5}), {1, 2, 3, 4, 5});
+  TF_ASSERT_OK(RunOpKernel());
+
+  // Empty rows reduce to zero.
+  test::ExpectTensorNear<float>(*GetOutput(0),
+                                test::AsTensor<float>({2, 0, 4.5}), 1e-6);
+}
+
+TEST_F(RaggedReduceOpTest, InvalidSplits) {
+  BuildRaggedReduceGraph<float>("RaggedReduceSum");
+  AddInputFromArray<int64_t>(TensorShape({3}), {0, 4, 2});
+  AddInputFromArray<float>(TensorShape({5}), {1, 2, 3, 4, 5});
+  EXPECT_EQ(RunOpKernel().error_message(),
+            "rt_nested_splits must be sorted");
+}
+
+TEST_F(RaggedReduceOpTest, SplitsMustCoverValues) {
+  BuildRaggedReduceGraph<float>("RaggedReduceSum");
+  AddInputFromArray<int64_t>(TensorShape({3}), {0, 2, 4});
+  AddInputFromArray<float>(TensorShape({5}), {1, 2, 3, 4, 5});
+  EXPECT_EQ(RunOpKernel().error_message(),
+            "Final value of rt_nested_splits must match the length of "
+            "rt_dense_values");
+}
+
+class RaggedSoftmaxOpTest : public ::tensorflow::OpsTestBase {
+ protected:
+  template <typename T>
+  void BuildRaggedSoftmaxGraph() {
+    const auto& dtype = DataTypeToEnum<T>::v();
+    TF_ASSERT_OK(NodeDefBuilder("tested_op", "RaggedSoftmax")
+                     .Input(FakeInput(DT_INT64))  // rt_nested_splits
+                     .Input(FakeInput(dtype))     // rt_dense_values
+                     .Attr("T", dtype)
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+};
+
+TEST_F(RaggedSoftmaxOpTest, FloatValues) {
+  BuildRaggedSoftmaxGraph<float>();
+  // [[0, 0], [], [1, 1, 1]]
+  AddInputFromArray<int64_t>(TensorShape({4}), {0, 2, 2, 5});
+  AddInputFromArray<float>(TensorShape({5}), {0, 0, 1, 1, 1});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorNear<float>(
+      *GetOutput(0),
+      test::AsTensor<float>({0.5, 0.5, 1.0 / 3, 1.0 / 3, 1.0 / 3}), 1e-6);
+}
+
+TEST_F(RaggedSoftmaxOpTest, SingleRowMatchesDenseSoftmax) {
+  BuildRaggedSoftmaxGraph<float>();
+  AddInputFromArray<int64_t>(TensorShape({2}), {0, 3});
+  AddInputFromArray<float>(TensorShape({3}), {1, 2, 3});
+  TF_ASSERT_OK(RunOpKernel());
+
+  test::ExpectTensorNear<float>(
+      *GetOutput(0),
+      test::AsTensor<float>({0.09003057, 0.24472847, 0.66524096}), 1e-6);
+}
+
+}  // namespace
+}  // namespace tensorflow
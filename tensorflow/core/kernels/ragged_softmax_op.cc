@@ -0,0 +1,112 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+
+#include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+using errors::InvalidArgument;
+
+// Computes a numerically stable softmax within each row of a ragged tensor.
+// Each row of the flat values buffer is processed with vectorized max / exp /
+// normalize passes; the row splits are only consulted for row boundaries, so
+// the rows are never padded or materialized individually.
+template <typename T, typename SPLITS_TYPE>
+class RaggedSoftmaxOp : public OpKernel {
+ public:
+  using OpKernel::OpKernel;
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& splits_in = context->input(0);
+    const Tensor& values_in = context->input(1);
+
+    OP_REQUIRES(context,
+                splits_in.dims() == 1 && splits_in.NumElements() > 0,
+                InvalidArgument("rt_nested_splits must be a non-empty vector,"
+                                " got shape ",
+                                splits_in.shape().DebugString()));
+    OP_REQUIRES(context, values_in.dims() == 1,
+                InvalidArgument("rt_dense_values must be a vector"));
+
+    const auto splits = splits_in.flat<SPLITS_TYPE>();
+    const int64_t nrows = splits.size() - 1;
+    const int64_t nvals = values_in.dim_size(0);
+    OP_REQUIRES(context, splits(0) == 0,
+                InvalidArgument("First value of rt_nested_splits must be 0"));
+    for (int64_t row = 0; row < nrows; ++row) {
+      OP_REQUIRES(context, splits(row) <= splits(row + 1),
+                  InvalidArgument("rt_nested_splits must be sorted"));
+    }
+    OP_REQUIRES(context, splits(nrows) == nvals,
+                InvalidArgument("Final value of rt_nested_splits must match "
+                                "the length of rt_dense_values"));
+
+    Tensor* output_out = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, values_in.shape(),
+                                                     &output_out));
+    if (nvals == 0) return;
+
+    const T* values_base = values_in.flat<T>().data();
+    T* output_base = output_out->flat<T>().data();
+
+    // Rows are independent, so normalize them in parallel.
+    auto softmax_rows = [values_base, output_base, &splits](int64_t row_begin,
+                                                            int64_t row_end) {
+      typedef Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>> ArrayMap;
+      typedef Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>>
+          ConstArrayMap;
+      for (int64_t row = row_begin; row < row_end; ++row) {
+        const int64_t start = splits(row);
+        const int64_t size = splits(row + 1) - start;
+        if (size == 0) continue;
+        ConstArrayMap in_row(values_base + start, size);
+        ArrayMap out_row(output_base + start, size);
+        out_row = (in_row - in_row.maxCoeff()).exp();
+        out_row /= out_row.sum();
+      }
+    };
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t cost_per_row =
+        10 + (nvals * sizeof(T)) / std::max<int64_t>(nrows, 1);
+    Shard(worker_threads->num_threads, worker_threads->workers, nrows,
+          cost_per_row, softmax_rows);
+  }
+};
+
+#define REGISTER_CPU_KERNEL_WITH_SPLITS(TYPE, SPLITS_TYPE)             \
+  REGISTER_KERNEL_BUILDER(Name("RaggedSoftmax")                        \
+                              .Device(DEVICE_CPU)                      \
+                              .TypeConstraint<TYPE>("T")               \
+                              .TypeConstraint<SPLITS_TYPE>("Tsplits"), \
+                          RaggedSoftmaxOp<TYPE, SPLITS_TYPE>)
+#define REGISTER_CPU_KERNEL(TYPE)               \
+  REGISTER_CPU_KERNEL_WITH_SPLITS(TYPE, int32); \
+  REGISTER_CPU_KERNEL_WITH_SPLITS(TYPE, int64_t)
+
+TF_CALL_float(REGISTER_CPU_KERNEL);
+TF_CALL_double(REGISTER_CPU_KERNEL);
+
+#undef REGISTER_CPU_KERNEL
+#undef REGISTER_CPU_KERNEL_WITH_SPLITS
+
+}  // namespace tensorflow
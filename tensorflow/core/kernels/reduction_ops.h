@@ -78,6 +78,7 @@ struct ReduceEigenImpl {
   };
 
 CASTING_SPECIALIZATION(Eigen::internal::SumReducer, bfloat16, float);
+CASTING_SPECIALIZATION(Eigen::internal::ProdReducer, bfloat16, float);
 #undef CASTING_SPECIALIZATION
 
 template <typename Device, typename OUT_T, typename IN_T,
@@ -95,7 +96,8 @@ struct ReduceEigenImpl<Device, OUT_T, IN_T, ReductionAxes,
 };
 
 // Specialization for which we do the reduction in IntermediateType to
-// avoid integer overflow.
+// avoid integer overflow, or in the bfloat16 case to avoid losing accuracy
+// by accumulating in bfloat16.
 #define CASTING_SPECIALIZATION(ScalarType, IntermediateType)                  \
   template <typename Device, typename OUT_T, typename IN_T,                   \
             typename ReductionAxes>                                           \
@@ -120,6 +122,7 @@ CASTING_SPECIALIZATION(uint32, uint64);
 CASTING_SPECIALIZATION(int8, int64_t);
 CASTING_SPECIALIZATION(int16, int64_t);
 CASTING_SPECIALIZATION(int32, int64_t);
+CASTING_SPECIALIZATION(bfloat16, float);
 #undef CASTING_SPECIALIZATION
 
 // TODO(rmlarsen): Refactor this such that taking the sqrt can be optional
@@ -155,6 +158,23 @@ struct ReduceEigenImpl<Device, OUT_T, IN_T, ReductionAxes,
   }
 };
 
+template <typename Device, typename OUT_T, typename IN_T,
+          typename ReductionAxes>
+struct ReduceEigenImpl<Device, OUT_T, IN_T, ReductionAxes,
+                       functor::EuclideanNormReducer<bfloat16>> {
+  void operator()(const Device& d, OUT_T out, IN_T in,
+                  const ReductionAxes& reduction_axes,
+                  const functor::EuclideanNormReducer<bfloat16>& reducer) {
+    static_assert(std::is_same<bfloat16, typename OUT_T::Scalar>::value, "");
+    Eigen::internal::SumReducer<float> sum_reducer;
+    auto in_as_float = in.template cast<float>();
+    out.device(d) = (in_as_float * in_as_float.conjugate())
+                        .reduce(reduction_axes, sum_reducer)
+                        .sqrt()
+                        .template cast<bfloat16>();
+  }
+};
+
 // For most reducers, the identity is Reducer::initialize()
 template <typename Reducer>
 struct Identity {
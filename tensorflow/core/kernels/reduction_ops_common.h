@@ -23,6 +23,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <vector>
+
 #include "third_party/eigen3/Eigen/Core"
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 
@@ -36,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/determinism.h"
 
 namespace tensorflow {
 
@@ -272,6 +276,196 @@ template <typename Reducer>
 struct ReduceFunctor<CPUDevice, Reducer>
     : ReduceFunctorBase<CPUDevice, Reducer> {};
 
+// Deterministic parallel summation with compensated (Kahan) accumulation.
+//
+// The input is split into fixed-size chunks, so the partitioning depends only
+// on the shape, never on the number of threads or on how Eigen's cost model
+// shards the work.  Chunk partials are combined sequentially in index order,
+// which makes the result bitwise reproducible from run to run regardless of
+// the intra-op pool size.  The compensated accumulation typically makes the
+// result *more* accurate than a plain left-to-right sum, not less.
+template <typename T>
+struct DeterministicSumHelper {
+  // Number of input elements per partial. Large enough to amortize the
+  // per-chunk bookkeeping, small enough to parallelize medium reductions.
+  static constexpr int64_t kChunkSize = 4096;
+  // Number of independent accumulator lanes in the inner loop.  Fixed (rather
+  // than tied to the packet size) so that the reduction order is identical
+  // across builds; the compiler vectorizes the lane loop.
+  static constexpr int kLanes = 8;
+
+  static void KahanAdd(const T v, T* sum, T* comp) {
+    const T y = v - *comp;
+    const T t = *sum + y;
+    *comp = (t - *sum) - y;
+    *sum = t;
+  }
+
+  // Compensated sum of data[0, n); leaves the running compensation in *comp
+  // so callers can merge partials without losing it.
+  static void SumChunk(const T* data, const int64_t n, T* sum, T* comp) {
+    T lane_sum[kLanes];
+    T lane_comp[kLanes];
+    for (int l = 0; l < kLanes; ++l) {
+      lane_sum[l] = T(0);
+      lane_comp[l] = T(0);
+    }
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+      for (int l = 0; l < kLanes; ++l) {
+        KahanAdd(data[i + l], &lane_sum[l], &lane_comp[l]);
+      }
+    }
+    T s = T(0);
+    T c = T(0);
+    for (int l = 0; l < kLanes; ++l) {
+      KahanAdd(lane_sum[l], &s, &c);
+      KahanAdd(-lane_comp[l], &s, &c);
+    }
+    for (; i < n; ++i) {
+      KahanAdd(data[i], &s, &c);
+    }
+    *sum = s;
+    *comp = c;
+  }
+
+  // Full reduction of data[0, n) to a scalar.
+  static T Sum(const CPUDevice& d, const T* data, const int64_t n) {
+    if (n == 0) return T(0);
+    const int64_t num_chunks = (n + kChunkSize - 1) / kChunkSize;
+    if (num_chunks == 1) {
+      T sum, comp;
+      SumChunk(data, n, &sum, &comp);
+      return sum;
+    }
+    std::vector<T> sums(num_chunks);
+    std::vector<T> comps(num_chunks);
+    const Eigen::TensorOpCost cost(kChunkSize * sizeof(T), sizeof(T),
+                                   kChunkSize);
+    d.parallelFor(num_chunks, cost,
+                  [data, n, &sums, &comps](Eigen::Index begin,
+                                           Eigen::Index end) {
+                    for (Eigen::Index chunk = begin; chunk < end; ++chunk) {
+                      const int64_t start = chunk * kChunkSize;
+                      SumChunk(data + start, std::min(kChunkSize, n - start),
+                               &sums[chunk], &comps[chunk]);
+                    }
+                  });
+    // Merge partials in chunk-index order, independent of which thread
+    // produced which partial.
+    T sum = T(0);
+    T comp = T(0);
+    for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+      KahanAdd(sums[chunk], &sum, &comp);
+      KahanAdd(-comps[chunk], &sum, &comp);
+    }
+    return sum;
+  }
+
+  // out[i] = sum over j of data[i * cols + j]. Rows are independent, so the
+  // per-row sequential compensated sum is deterministic under any sharding.
+  static void RowSums(const CPUDevice& d, const T* data, const int64_t rows,
+                      const int64_t cols, T* out) {
+    const Eigen::TensorOpCost cost(cols * sizeof(T), sizeof(T), cols);
+    d.parallelFor(rows, cost,
+                  [data, cols, out](Eigen::Index begin, Eigen::Index end) {
+                    for (Eigen::Index r = begin; r < end; ++r) {
+                      T sum, comp;
+                      SumChunk(data + r * cols, cols, &sum, &comp);
+                      out[r] = sum;
+                    }
+                  });
+  }
+
+  // out[j] = sum over i of data[i * cols + j]. Each column is accumulated
+  // top to bottom by a single shard, so the order per column is fixed.
+  static void ColumnSums(const CPUDevice& d, const T* data, const int64_t rows,
+                         const int64_t cols, T* out) {
+    const Eigen::TensorOpCost cost(rows * sizeof(T), sizeof(T), rows);
+    d.parallelFor(
+        cols, cost, [data, rows, cols, out](Eigen::Index begin,
+                                            Eigen::Index end) {
+          const int64_t width = end - begin;
+          std::vector<T> sums(width, T(0));
+          std::vector<T> comps(width, T(0));
+          for (int64_t i = 0; i < rows; ++i) {
+            const T* row = data + i * cols;
+            for (int64_t j = 0; j < width; ++j) {
+              KahanAdd(row[begin + j], &sums[j], &comps[j]);
+            }
+          }
+          for (int64_t j = 0; j < width; ++j) {
+            out[begin + j] = sums[j];
+          }
+        });
+  }
+};
+
+// Dispatches the reduction shapes that ReductionOp produces to the
+// deterministic summation kernels above.  Returns false for shapes it does
+// not cover (the 3-D cases), in which case the caller falls back to Eigen.
+template <typename T>
+struct DeterministicSumDispatch {
+  static bool Reduce(OpKernelContext* ctx, typename TTypes<T, 0>::Tensor out,
+                     typename TTypes<T, 1>::ConstTensor in,
+                     const Eigen::IndexList<Eigen::type2index<0>>& /*axes*/) {
+    out() = DeterministicSumHelper<T>::Sum(ctx->eigen_cpu_device(), in.data(),
+                                           in.size());
+    return true;
+  }
+
+  static bool Reduce(OpKernelContext* ctx, typename TTypes<T, 1>::Tensor out,
+                     typename TTypes<T, 2>::ConstTensor in,
+                     const Eigen::IndexList<Eigen::type2index<0>>& /*axes*/) {
+    DeterministicSumHelper<T>::ColumnSums(ctx->eigen_cpu_device(), in.data(),
+                                          in.dimension(0), in.dimension(1),
+                                          out.data());
+    return true;
+  }
+
+  static bool Reduce(OpKernelContext* ctx, typename TTypes<T, 1>::Tensor out,
+                     typename TTypes<T, 2>::ConstTensor in,
+                     const Eigen::IndexList<Eigen::type2index<1>>& /*axes*/) {
+    DeterministicSumHelper<T>::RowSums(ctx->eigen_cpu_device(), in.data(),
+                                       in.dimension(0), in.dimension(1),
+                                       out.data());
+    return true;
+  }
+
+  template <typename OUT_T, typename IN_T, typename ReductionAxes>
+  static bool Reduce(OpKernelContext* /*ctx*/, OUT_T /*out*/, IN_T /*in*/,
+                     const ReductionAxes& /*axes*/) {
+    return false;
+  }
+};
+
+// Sum reductions get a deterministic parallel path when op determinism is
+// requested; everything else (and the shapes not covered by the dispatch
+// above) keeps using Eigen.
+template <typename T>
+struct DeterministicSumReduceFunctor
+    : ReduceFunctorBase<CPUDevice, Eigen::internal::SumReducer<T>> {
+  template <typename OUT_T, typename IN_T, typename ReductionAxes>
+  static void Reduce(OpKernelContext* ctx, OUT_T out, IN_T in,
+                     const ReductionAxes& reduction_axes,
+                     const Eigen::internal::SumReducer<T>& reducer) {
+    if (OpDeterminismRequired() &&
+        DeterministicSumDispatch<T>::Reduce(ctx, out, in, reduction_axes)) {
+      return;
+    }
+    ReduceFunctorBase<CPUDevice, Eigen::internal::SumReducer<T>>::Reduce(
+        ctx, out, in, reduction_axes, reducer);
+  }
+};
+
+template <>
+struct ReduceFunctor<CPUDevice, Eigen::internal::SumReducer<float>>
+    : DeterministicSumReduceFunctor<float> {};
+
+template <>
+struct ReduceFunctor<CPUDevice, Eigen::internal::SumReducer<double>>
+    : DeterministicSumReduceFunctor<double> {};
+
 }  // namespace functor
 }  // namespace tensorflow
 
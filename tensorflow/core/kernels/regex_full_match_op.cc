@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <memory>
 #include <string>
 
 #include "re2/re2.h"
@@ -20,11 +21,95 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/flatmap.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/util/ptr_util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
+namespace {
+
+// Matches each element of the "input" string Tensor at input_index=0 against
+// the given regex and writes the results to the "output" bool Tensor at
+// output_index=0.
+Status InternalCompute(const RE2& regex, OpKernelContext* ctx) {
+  const Tensor* input_tensor;
+  TF_RETURN_IF_ERROR(ctx->input("input", &input_tensor));
+  const auto input_flat = input_tensor->flat<tstring>();
+
+  Tensor* output_tensor = nullptr;
+  TF_RETURN_IF_ERROR(
+      ctx->allocate_output("output", input_tensor->shape(), &output_tensor));
+  auto output_flat = output_tensor->flat<bool>();
+  const int64_t batch_size = input_flat.size();
+  // Matching against a compiled RE2 object is thread-safe and the batch
+  // elements are independent, so shard the matches across the intra-op
+  // thread pool.
+  auto match_range = [&regex, &input_flat, &output_flat](int64_t start,
+                                                         int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      output_flat(i) = RE2::FullMatch(input_flat(i), regex);
+    }
+  };
+  auto* worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+  // Rough per-string matching cost; undercounting only makes sharding kick in
+  // later.
+  const int64_t kCostPerUnit = 1000;
+  Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
+        kCostPerUnit, match_range);
+  return OkStatus();
+}
+
+// A small cache of compiled patterns, so that ops whose pattern input
+// alternates between a few values (common when one op processes several log
+// streams) do not recompile on every call.  Compilation is much more
+// expensive than a lookup, so the cache is shared by all instances of the
+// op in the process and keeps a bounded number of patterns.
+class RE2Cache {
+ public:
+  static RE2Cache* Global() {
+    static RE2Cache* cache = new RE2Cache;
+    return cache;
+  }
+
+  std::shared_ptr<RE2> Lookup(const string& pattern) {
+    {
+      tf_shared_lock l(mu_);
+      auto iter = patterns_.find(pattern);
+      if (iter != patterns_.end()) {
+        return iter->second;
+      }
+    }
+    // Compile the new RE2 object before acquiring the lock.
+    auto regex = std::make_shared<RE2>(pattern);
+    gtl::FlatMap<string, std::shared_ptr<RE2>> evicted;
+    {
+      mutex_lock l(mu_);
+      auto iter = patterns_.find(pattern);
+      if (iter != patterns_.end()) {
+        // Another thread compiled the same pattern in the meantime.
+        return iter->second;
+      }
+      if (patterns_.size() >= kMaxPatterns) {
+        // Evict everything rather than tracking recency; steady-state
+        // workloads use few patterns, and the swap lets the evicted RE2
+        // objects destruct after the lock is released.
+        evicted.swap(patterns_);
+      }
+      patterns_.emplace(pattern, regex);
+    }
+    return regex;
+  }
+
+ private:
+  static constexpr int kMaxPatterns = 64;
+
+  mutex mu_;
+  gtl::FlatMap<string, std::shared_ptr<RE2>> patterns_ TF_GUARDED_BY(mu_);
+};
+}  // namespace
 
 class RegexFullMatchOp : public OpKernel {
  public:
@@ -33,52 +118,21 @@ class RegexFullMatchOp : public OpKernel {
   ~RegexFullMatchOp() override {}
 
   void Compute(OpKernelContext* ctx) override {
-    const Tensor* input_tensor;
-    OP_REQUIRES_OK(ctx, ctx->input("input", &input_tensor));
-    const auto& input_flat = input_tensor->flat<tstring>();
-
     const Tensor* pattern_tensor;
     OP_REQUIRES_OK(ctx, ctx->input("pattern", &pattern_tensor));
     OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(pattern_tensor->shape()),
                 errors::InvalidArgument("Pattern must be scalar, but received ",
                                         pattern_tensor->shape().DebugString()));
     const string pattern = pattern_tensor->flat<tstring>()(0);
-    std::shared_ptr<RE2> regex = CachedRE2(pattern);
+    std::shared_ptr<RE2> regex = RE2Cache::Global()->Lookup(pattern);
     OP_REQUIRES(ctx, regex->ok(),
                 errors::InvalidArgument("Invalid pattern: ", pattern,
                                         ", error: ", regex->error()));
 
-    Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output("output", input_tensor->shape(),
-                                             &output_tensor));
-    auto output_flat = output_tensor->flat<bool>();
-    for (size_t i = 0; i < input_flat.size(); ++i) {
-      output_flat(i) = RE2::FullMatch(input_flat(i), *regex);
-    }
+    OP_REQUIRES_OK(ctx, InternalCompute(*regex, ctx));
   }
 
  private:
-  std::shared_ptr<RE2> CachedRE2(const string& pattern) {
-    {
-      tf_shared_lock l(mu_);
-      if (regex_ != nullptr && regex_->pattern() == pattern) {
-        return regex_;
-      }
-    }
-    // Construct the new RE2 object before acquiring the lock.
-    auto regex = std::make_shared<RE2>(pattern);
-    {
-      mutex_lock l(mu_);
-      // Swap instead of assigning so that we destruct the old
-      // RE2 object (when necessary) after releasing the lock.
-      regex_.swap(regex);
-      return regex_;
-    }
-  }
-
-  mutex mu_;
-  std::shared_ptr<RE2> regex_ TF_GUARDED_BY(mu_);
-
   TF_DISALLOW_COPY_AND_ASSIGN(RegexFullMatchOp);
 };
 
@@ -97,17 +151,7 @@ class StaticRegexFullMatchOp : public OpKernel {
   }
 
   void Compute(OpKernelContext* ctx) override {
-    const Tensor* input_tensor;
-    OP_REQUIRES_OK(ctx, ctx->input("input", &input_tensor));
-    const auto& input_flat = input_tensor->flat<tstring>();
-
-    Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output("output", input_tensor->shape(),
-                                             &output_tensor));
-    auto output_flat = output_tensor->flat<bool>();
-    for (size_t i = 0; i < input_flat.size(); ++i) {
-      output_flat(i) = RE2::FullMatch(input_flat(i), *re_);
-    }
+    OP_REQUIRES_OK(ctx, InternalCompute(*re_, ctx));
   }
 
  private:
@@ -13,16 +13,21 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "re2/re2.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/gtl/flatmap.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/util/ptr_util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -49,19 +54,80 @@ Status InternalCompute(const RE2& regex, const string& rewrite,
     output_tensor->flat<tstring>() = input_tensor->flat<tstring>();
   }
   auto output_flat = output_tensor->flat<tstring>();
-  for (size_t i = 0; i < output_flat.size(); ++i) {
-    // TODO(dero): Mitigate copy; Global and GlobalReplace below currently only
-    // accept std::string.
-    string buf = output_flat(i);
-    if (replace_global) {
-      RE2::GlobalReplace(&buf, regex, rewrite);
-    } else {
-      RE2::Replace(&buf, regex, rewrite);
+  const int64_t batch_size = output_flat.size();
+  // Matching against a compiled RE2 object is thread-safe and the batch
+  // elements are independent, so shard the rewrites across the intra-op
+  // thread pool.
+  auto rewrite_range = [&regex, &rewrite, replace_global, &output_flat](
+                           int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      // TODO(dero): Mitigate copy; Global and GlobalReplace below currently
+      // only accept std::string.
+      string buf = output_flat(i);
+      if (replace_global) {
+        RE2::GlobalReplace(&buf, regex, rewrite);
+      } else {
+        RE2::Replace(&buf, regex, rewrite);
+      }
+      output_flat(i) = std::move(buf);
     }
-    output_flat(i) = std::move(buf);
-  }
+  };
+  auto* worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+  // Rough per-string rewrite cost; undercounting only makes sharding kick in
+  // later.
+  const int64_t kCostPerUnit = 1000;
+  Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
+        kCostPerUnit, rewrite_range);
   return OkStatus();
 }
+
+// A small cache of compiled patterns, so that ops whose pattern input
+// alternates between a few values (common when one op processes several log
+// streams) do not recompile on every call.  Compilation is much more
+// expensive than a lookup, so the cache is shared by all instances of the
+// op in the process and keeps a bounded number of patterns.
+class RE2Cache {
+ public:
+  static RE2Cache* Global() {
+    static RE2Cache* cache = new RE2Cache;
+    return cache;
+  }
+
+  std::shared_ptr<RE2> Lookup(const string& pattern) {
+    {
+      tf_shared_lock l(mu_);
+      auto iter = patterns_.find(pattern);
+      if (iter != patterns_.end()) {
+        return iter->second;
+      }
+    }
+    // Compile the new RE2 object before acquiring the lock.
+    auto regex = std::make_shared<RE2>(pattern);
+    gtl::FlatMap<string, std::shared_ptr<RE2>> evicted;
+    {
+      mutex_lock l(mu_);
+      auto iter = patterns_.find(pattern);
+      if (iter != patterns_.end()) {
+        // Another thread compiled the same pattern in the meantime.
+        return iter->second;
+      }
+      if (patterns_.size() >= kMaxPatterns) {
+        // Evict everything rather than tracking recency; steady-state
+        // workloads use few patterns, and the swap lets the evicted RE2
+        // objects destruct after the lock is released.
+        evicted.swap(patterns_);
+      }
+      patterns_.emplace(pattern, regex);
+    }
+    return regex;
+  }
+
+ private:
+  static constexpr int kMaxPatterns = 64;
+
+  mutex mu_;
+  gtl::FlatMap<string, std::shared_ptr<RE2>> patterns_ TF_GUARDED_BY(mu_);
+};
 }  // namespace
 
 class RegexReplaceOp : public OpKernel {
@@ -79,7 +145,7 @@ class RegexReplaceOp : public OpKernel {
                 errors::InvalidArgument("Pattern must be scalar, but received ",
                                         pattern_tensor->shape().DebugString()));
     const string& pattern = pattern_tensor->scalar<tstring>()();
-    std::shared_ptr<RE2> regex = CachedRE2(pattern);
+    std::shared_ptr<RE2> regex = RE2Cache::Global()->Lookup(pattern);
     OP_REQUIRES(ctx, regex->ok(),
                 errors::InvalidArgument("Invalid pattern: ", pattern,
                                         ", error: ", regex->error()));
@@ -94,27 +160,7 @@ class RegexReplaceOp : public OpKernel {
   }
 
  private:
-  std::shared_ptr<RE2> CachedRE2(const string& pattern) {
-    {
-      tf_shared_lock l(mu_);
-      if (regex_ != nullptr && regex_->pattern() == pattern) {
-        return regex_;
-      }
-    }
-    // Construct the new RE2 object before acquiring the lock.
-    auto regex = std::make_shared<RE2>(pattern);
-    {
-      mutex_lock l(mu_);
-      // Swap instead of assigning so that we destruct the old
-      // RE2 object (when necessary) after releasing the lock.
-      regex_.swap(regex);
-      return regex_;
-    }
-  }
-
   bool replace_global_;
-  mutex mu_;
-  std::shared_ptr<RE2> regex_ TF_GUARDED_BY(mu_);
 
   TF_DISALLOW_COPY_AND_ASSIGN(RegexReplaceOp);
 };
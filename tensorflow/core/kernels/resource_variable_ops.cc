@@ -81,6 +81,7 @@ limitations under the License.
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/determinism.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
@@ -132,6 +133,21 @@ Status CopyVariable(int output_idx, OpKernelContext* ctx, const Tensor* t) {
   return OkStatus();
 }
 
+// Opt-in for lock-free snapshot reads of resource variables; see the comment
+// on Var::snapshot(). Intended for serving processes whose variables are only
+// written by the kernels in this file: writers that bypass them leave the
+// snapshot stale (but never torn, thanks to copy-on-write) until the next
+// dense assignment.
+bool SnapshotReadsEnabled() {
+  static const bool enabled = [] {
+    bool enable = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_RESOURCE_VARIABLE_SNAPSHOT_READS",
+                                   false, &enable));
+    return enable;
+  }();
+  return enabled;
+}
+
 }  // namespace
 
 void ReadVariableOp::Compute(OpKernelContext* ctx) {
@@ -146,6 +162,23 @@ void ReadVariableOp::Compute(OpKernelContext* ctx) {
                   "Debug info: container=", handle.container(),
                   ", status error message=", status.error_message()));
 
+  if (SnapshotReadsEnabled() && !variable->copy_on_read_mode.load()) {
+    // Lock-free fast path: return the snapshot published by the last dense
+    // write. Writers install a new snapshot instead of mutating this one, and
+    // its buffer stays alive until the last reader releases it.
+    std::shared_ptr<const Tensor> snapshot = variable->snapshot();
+    if (snapshot != nullptr) {
+      OP_REQUIRES(
+          ctx, dtype_ == snapshot->dtype(),
+          errors::InvalidArgument(
+              "Trying to read variable with wrong dtype. Expected ",
+              DataTypeString(dtype_), " got ",
+              DataTypeString(snapshot->dtype())));
+      ctx->set_output(0, *snapshot);
+      return;
+    }
+  }
+
   tf_shared_lock ml(*variable->mu());
   // We're acquiring a reference to the underlying buffer while
   // holding a shared lock to guarantee ordering of reads and
@@ -196,6 +229,21 @@ void ReadVariablesOp::Compute(OpKernelContext* ctx) {
                   absl::StrJoin(uninitialized_vars, ", ")));
 
   for (size_t i = 0; i < dtypes_.size(); ++i) {
+    if (SnapshotReadsEnabled() && !variables[i]->copy_on_read_mode.load()) {
+      // Lock-free fast path, as in ReadVariableOp.
+      std::shared_ptr<const Tensor> snapshot = variables[i]->snapshot();
+      if (snapshot != nullptr) {
+        OP_REQUIRES(
+            ctx, dtypes_[i] == snapshot->dtype(),
+            errors::InvalidArgument(
+                "Trying to read variable ", handles[i]->name(),
+                " from Container: ", handles[i]->container(),
+                " with wrong dtype. Expected ", DataTypeString(dtypes_[i]),
+                " got ", DataTypeString(snapshot->dtype())));
+        ctx->set_output(i, *snapshot);
+        continue;
+      }
+    }
     // We're acquiring a reference to the underlying buffer while
     // holding a shared lock to guarantee ordering of reads and
     // writes.
@@ -463,6 +511,13 @@ class AssignVariableOp : public OpKernel {
       *variable->tensor() = value;
     }
     variable->is_initialized = true;
+    if (variable->dirty_row_tracking()) variable->RecordAllRowsDirty();
+    if (SnapshotReadsEnabled() && !variable->copy_on_read_mode.load()) {
+      // Publish the new value for lock-free reads. The snapshot aliases the
+      // buffer just assigned, so a later in-place update copies the buffer
+      // first (regular copy-on-write) and the snapshot stays immutable.
+      variable->InstallSnapshot(*variable->tensor());
+    }
   }
 
  private:
@@ -603,6 +658,10 @@ class AssignUpdateVariableOp : public OpKernel {
     functor::DenseUpdate<Device, T, Op> update_functor;
     update_functor(context->eigen_device<Device>(), var_tensor->flat<T>(),
                    value.flat<T>());
+    if (variable->dirty_row_tracking()) variable->RecordAllRowsDirty();
+    if (SnapshotReadsEnabled() && !variable->copy_on_read_mode.load()) {
+      variable->InstallSnapshot(*var_tensor);
+    }
   }
 };
 
@@ -1134,6 +1193,20 @@ class ResourceScatterUpdateOp : public OpKernel {
     if (N > 0) {
       OP_REQUIRES_OK(
           c, DoScatter<Device, T, Index, op>(c, params, indices, updates, N));
+      if (v->dirty_row_tracking()) {
+        if (isCPUDevice<Device>()) {
+          const auto indices_flat = indices.flat<Index>();
+          std::vector<int64_t> rows(N);
+          for (Index i = 0; i < N; i++) {
+            rows[i] = static_cast<int64_t>(indices_flat(i));
+          }
+          v->RecordDirtyRows(rows);
+        } else {
+          // The indices live in device memory; reading them back just for
+          // tracking is not worth a sync, so conservatively dirty all rows.
+          v->RecordAllRowsDirty();
+        }
+      }
     }
   }
 };
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <unordered_map>
@@ -33,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
@@ -250,6 +252,36 @@ namespace {
 // Tensors larger than this threshold will be restored from a thread-pool.
 const int64_t kLargeShapeThreshold = 16 << 20;  // 16M
 
+// Minimum number of small tensors assigned to each reader thread when the
+// sorted key range is partitioned. Spinning up a BundleReader (and its file
+// handles) is only worth it for a reasonably long sequential run.
+constexpr int kMinTensorsPerReaderThread = 16;
+
+// Number of reader threads used to restore a checkpoint. Each thread streams
+// a contiguous range of the bundle with its own BundleReader, so the setting
+// bounds the number of concurrent sequential reads against storage.
+int64_t RestoreReaderPoolSize() {
+  int64_t pool_size = 8;
+  ReadInt64FromEnvVar("TF_CHECKPOINT_RESTORE_THREADS", pool_size, &pool_size)
+      .IgnoreError();
+  return std::max<int64_t>(1, pool_size);
+}
+
+// When true, unsliced tensors are restored as read-only aliases of a memory
+// mapping of the checkpoint's data files instead of heap copies (see
+// BundleReader::LookupMemmapped).  Intended for inference-only processes:
+// replicas of one model on a host then share a single page-cache-backed copy
+// of the weights.  Tensors the mapping cannot represent fall back to copying.
+bool RestoreUseMmap() {
+  static const bool use_mmap = []() {
+    bool value = false;
+    ReadBoolFromEnvVar("TF_CHECKPOINT_RESTORE_USE_MMAP", false, &value)
+        .IgnoreError();
+    return value;
+  }();
+  return use_mmap;
+}
+
 // A restore operation for a single tensor.  Small tensors may be restored
 // directly from the op thread to improve read locality.  Large tensors can be
 // restored from a thread pool: this requires creating a separate BundleReader
@@ -302,6 +334,18 @@ struct RestoreOp {
             << restored_full_shape.num_elements();
     Tensor* restored_tensor;
     if (shape_and_slice.empty()) {
+      if (RestoreUseMmap()) {
+        Tensor mapped;
+        Status mmap_status = reader->LookupMemmapped(tensor_name, &mapped);
+        if (mmap_status.ok()) {
+          context->set_output(idx, mapped);
+          VLOG(1) << "Done restoring tensor " << idx << " : " << tensor_name
+                  << " as a memory-mapped alias";
+          return OkStatus();
+        }
+        VLOG(1) << "Falling back to a copying restore for " << tensor_name
+                << ": " << mmap_status.error_message();
+      }
       // Lookup the full tensor.
       TF_RETURN_IF_ERROR(
           context->allocate_output(idx, restored_full_shape, &restored_tensor));
@@ -412,21 +456,49 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     }
   }
 
+  const int64_t pool_size = RestoreReaderPoolSize();
+  // `direct_restore_ops` is sorted by file offset, so splitting it into
+  // contiguous ranges keeps each range a sequential read. When there are
+  // enough small tensors, each range is streamed by its own BundleReader on
+  // the pool, which also overlaps the crc32c verification of the ranges.
+  const int num_partitions =
+      static_cast<int>(std::min<int64_t>(
+          pool_size, direct_restore_ops.size() / kMinTensorsPerReaderThread));
   {
     // Schedule any threaded operations first, skipping thread pool creation if
     // we don't have any expensive operations.
     std::unique_ptr<thread::ThreadPool> reader_pool;
-    if (!pool_restore_ops.empty()) {
-      reader_pool.reset(
-          new thread::ThreadPool(Env::Default(), "restore_tensors", 8));
+    if (!pool_restore_ops.empty() || num_partitions > 1) {
+      reader_pool.reset(new thread::ThreadPool(
+          Env::Default(), "restore_tensors", static_cast<int>(pool_size)));
       for (auto* op : pool_restore_ops) {
         reader_pool->Schedule([op]() { op->run_with_new_reader(); });
       }
     }
 
-    // Read small tensors from the op thread
-    for (auto* op : direct_restore_ops) {
-      TF_RETURN_IF_ERROR(op->run(&default_reader));
+    if (num_partitions > 1) {
+      const size_t ops_per_partition =
+          (direct_restore_ops.size() + num_partitions - 1) / num_partitions;
+      for (int p = 0; p < num_partitions; ++p) {
+        const size_t begin = p * ops_per_partition;
+        const size_t end = std::min(direct_restore_ops.size(),
+                                    begin + ops_per_partition);
+        if (begin >= end) break;
+        reader_pool->Schedule([&direct_restore_ops, &prefix_string, begin,
+                               end]() {
+          BundleReader reader(Env::Default(), prefix_string);
+          for (size_t i = begin; i < end; ++i) {
+            RestoreOp* op = direct_restore_ops[i];
+            op->status =
+                reader.status().ok() ? op->run(&reader) : reader.status();
+          }
+        });
+      }
+    } else {
+      // Read small tensors from the op thread
+      for (auto* op : direct_restore_ops) {
+        TF_RETURN_IF_ERROR(op->run(&default_reader));
+      }
     }
   }
 
@@ -434,6 +506,11 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
   for (auto* op : pool_restore_ops) {
     TF_RETURN_IF_ERROR(op->status);
   }
+  if (num_partitions > 1) {
+    for (auto* op : direct_restore_ops) {
+      TF_RETURN_IF_ERROR(op->status);
+    }
+  }
 
   for (const RestoreOp& restore_op : restore_ops) {
     if (restore_op.dtype != context->mutable_output(restore_op.idx)->dtype()) {
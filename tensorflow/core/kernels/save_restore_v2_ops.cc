@@ -15,6 +15,8 @@ limitations under the License.
 
 // See docs in ../ops/io_ops.cc.
 
+#include <algorithm>
+#include <numeric>
 #include <string>
 #include <vector>
 
@@ -28,9 +30,12 @@ limitations under the License.
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
@@ -87,6 +92,102 @@ void ValidateInputs(bool is_save_op, OpKernelContext* context,
   }
 }
 
+// Number of concurrent shard writers used by SaveV2, read from
+// TF_SAVEV2_PARALLEL_SHARDS.  The default of 1 preserves the single-writer
+// path.
+int64_t ParallelSaveShards() {
+  int64_t shards = 1;
+  Status s = ReadInt64FromEnvVar("TF_SAVEV2_PARALLEL_SHARDS", 1, &shards);
+  if (!s.ok() || shards < 1) return 1;
+  return shards;
+}
+
+// Adds one tensor (or one slice of a partitioned tensor, if "shape_spec" is
+// non-empty) to "writer" under "tensor_name".
+Status AddTensorToWriter(BundleWriter* writer, const string& tensor_name,
+                         const string& shape_spec, const Tensor& tensor) {
+  if (!shape_spec.empty()) {
+    TensorShape shape;
+    TensorSlice slice(tensor.dims());
+    TensorShape slice_shape;
+    TF_RETURN_IF_ERROR(checkpoint::ParseShapeAndSlice(shape_spec, &shape,
+                                                      &slice, &slice_shape));
+    if (!slice_shape.IsSameSize(tensor.shape())) {
+      return errors::InvalidArgument(
+          "Slice in shape_and_slice specification does not match the "
+          "shape of the tensor to  save: ",
+          shape_spec, ", tensor: ", tensor.shape().DebugString());
+    }
+    return writer->AddSlice(tensor_name, shape, slice, tensor);
+  }
+  return writer->Add(tensor_name, tensor);
+}
+
+// Writes the tensors as "num_shards" temporary bundles concurrently, one
+// writer per shard on the device's worker threads, then merges them into a
+// single bundle at "prefix" (a metadata-only step that renames the shard
+// data files).  Each writer streams tensor bytes straight from the op's
+// inputs through its own bounded write buffer, so no extra gather copy is
+// made and peak memory stays bounded.
+Status ParallelShardedSave(OpKernelContext* context, const string& prefix,
+                           int num_tensors, int num_shards) {
+  constexpr int kFixedInputs = 3;
+  const auto& tensor_names_flat = context->input(1).flat<tstring>();
+  const auto& shape_and_slices_flat = context->input(2).flat<tstring>();
+
+  // Greedy size balance: largest tensors first, each to the least-loaded
+  // shard, so the workers stream a similar number of bytes.
+  std::vector<int> order(num_tensors);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [context](int a, int b) {
+    return context->input(a + kFixedInputs).TotalBytes() >
+           context->input(b + kFixedInputs).TotalBytes();
+  });
+  std::vector<std::vector<int>> shard_tensors(num_shards);
+  std::vector<int64_t> shard_bytes(num_shards, 0);
+  for (int idx : order) {
+    const int shard =
+        std::min_element(shard_bytes.begin(), shard_bytes.end()) -
+        shard_bytes.begin();
+    shard_tensors[shard].push_back(idx);
+    shard_bytes[shard] += context->input(idx + kFixedInputs).TotalBytes();
+  }
+
+  std::vector<tstring> shard_prefixes;
+  shard_prefixes.reserve(num_shards);
+  for (int i = 0; i < num_shards; ++i) {
+    shard_prefixes.push_back(
+        strings::StrCat(prefix, ".shard-", i, "-of-", num_shards));
+  }
+
+  thread::ThreadPool* workers =
+      context->device()->tensorflow_cpu_worker_threads()->workers;
+  std::vector<Status> statuses(num_shards);
+  BlockingCounter counter(num_shards);
+  for (int shard = 0; shard < num_shards; ++shard) {
+    workers->Schedule([context, shard, &shard_tensors, &shard_prefixes,
+                       &tensor_names_flat, &shape_and_slices_flat, &statuses,
+                       &counter] {
+      BundleWriter writer(Env::Default(), shard_prefixes[shard]);
+      Status s = writer.status();
+      for (int idx : shard_tensors[shard]) {
+        if (!s.ok()) break;
+        s = AddTensorToWriter(&writer, tensor_names_flat(idx),
+                              shape_and_slices_flat(idx),
+                              context->input(idx + kFixedInputs));
+      }
+      if (s.ok()) s = writer.Finish();
+      statuses[shard] = s;
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  for (const Status& s : statuses) {
+    TF_RETURN_IF_ERROR(s);
+  }
+  return MergeBundles(Env::Default(), shard_prefixes, prefix);
+}
+
 }  // namespace
 
 // Saves a list of named tensors using the tensor bundle library.
@@ -108,57 +209,51 @@ class SaveV2 : public OpKernel {
     const auto& tensor_names_flat = tensor_names.flat<tstring>();
     const auto& shape_and_slices_flat = shape_and_slices.flat<tstring>();
 
-    BundleWriter writer(Env::Default(), prefix_string);
-    OP_REQUIRES_OK(context, writer.status());
-    VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
-
-    for (int i = 0; i < num_tensors; ++i) {
-      const string& tensor_name = tensor_names_flat(i);
-      const Tensor& tensor = context->input(i + kFixedInputs);
-      VLOG(2) << "Starting save of " << tensor_name;
-
-      if (!shape_and_slices_flat(i).empty()) {
-        const string& shape_spec = shape_and_slices_flat(i);
-        TensorShape shape;
-        TensorSlice slice(tensor.dims());
-        TensorShape slice_shape;
-
-        OP_REQUIRES_OK(context, checkpoint::ParseShapeAndSlice(
-                                    shape_spec, &shape, &slice, &slice_shape));
-        OP_REQUIRES(context, slice_shape.IsSameSize(tensor.shape()),
-                    errors::InvalidArgument("Slice in shape_and_slice "
-                                            "specification does not match the "
-                                            "shape of the tensor to  save: ",
-                                            shape_spec, ", tensor: ",
-                                            tensor.shape().DebugString()));
+    const int num_shards = static_cast<int>(std::min<int64_t>(
+        ParallelSaveShards(), std::max(num_tensors, 1)));
+    if (num_shards > 1) {
+      VLOG(1) << "Parallel sharded save with " << num_shards
+              << " shards, prefix_string: " << prefix_string;
+      OP_REQUIRES_OK(context, ParallelShardedSave(context, prefix_string,
+                                                  num_tensors, num_shards));
+      VLOG(1) << "Done parallel sharded save, prefix_string: "
+              << prefix_string;
+    } else {
+      BundleWriter writer(Env::Default(), prefix_string);
+      OP_REQUIRES_OK(context, writer.status());
+      VLOG(1) << "BundleWriter, prefix_string: " << prefix_string;
+
+      for (int i = 0; i < num_tensors; ++i) {
+        const string& tensor_name = tensor_names_flat(i);
+        const Tensor& tensor = context->input(i + kFixedInputs);
+        VLOG(2) << "Starting save of " << tensor_name;
 
         OP_REQUIRES_OK(context,
-                       writer.AddSlice(tensor_name, shape, slice, tensor));
-      } else {
-        OP_REQUIRES_OK(context, writer.Add(tensor_name, tensor));
-      }
-
-      if (VLOG_IS_ON(5)) {
-        if (tensor.dtype() == DT_FLOAT) {
-          const float* t_data = tensor.flat<float>().data();
-          float min = std::numeric_limits<float>::infinity();
-          float max = -std::numeric_limits<float>::infinity();
-          double avg = 0.0;
-          for (int i = 0; i < tensor.NumElements(); ++i) {
-            if (t_data[i] < min) min = t_data[i];
-            if (t_data[i] > max) max = t_data[i];
-            avg += t_data[i];
+                       AddTensorToWriter(&writer, tensor_name,
+                                         shape_and_slices_flat(i), tensor));
+
+        if (VLOG_IS_ON(5)) {
+          if (tensor.dtype() == DT_FLOAT) {
+            const float* t_data = tensor.flat<float>().data();
+            float min = std::numeric_limits<float>::infinity();
+            float max = -std::numeric_limits<float>::infinity();
+            double avg = 0.0;
+            for (int i = 0; i < tensor.NumElements(); ++i) {
+              if (t_data[i] < min) min = t_data[i];
+              if (t_data[i] > max) max = t_data[i];
+              avg += t_data[i];
+            }
+            VLOG(5) << " min " << min << " max " << max << " avg "
+                    << avg / tensor.NumElements() << " total elts "
+                    << tensor.NumElements();
           }
-          VLOG(5) << " min " << min << " max " << max << " avg "
-                  << avg / tensor.NumElements() << " total elts "
-                  << tensor.NumElements();
         }
-      }
 
-      VLOG(2) << "Done save of " << tensor_name;
+        VLOG(2) << "Done save of " << tensor_name;
+      }
+      OP_REQUIRES_OK(context, writer.Finish());
+      VLOG(1) << "Done BundleWriter, prefix_string: " << prefix_string;
     }
-    OP_REQUIRES_OK(context, writer.Finish());
-    VLOG(1) << "Done BundleWriter, prefix_string: " << prefix_string;
 
     ResourceMgr* resource_manager = context->resource_manager();
     if (resource_manager != nullptr) {
@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/types.h"
@@ -340,5 +341,62 @@ TEST_F(SaveV2OpTest, Simple) {
   }
 }
 
+class SaveV2ParallelOpTest : public OpsTestBase {
+ protected:
+  void MakeOp(int num_tensors) {
+    TF_ASSERT_OK(NodeDefBuilder("myop", "SaveV2")
+                     .Input(FakeInput())  // prefix
+                     .Input(FakeInput())  // tensor_names
+                     .Input(FakeInput())  // shape_and_slices
+                     .Input(FakeInput(DataTypeVector(num_tensors, DT_FLOAT)))
+                     .Finalize(node_def()));
+    TF_ASSERT_OK(InitOp());
+  }
+};
+
+TEST_F(SaveV2ParallelOpTest, ParallelShards) {
+  const string prefix = io::JoinPath(testing::TmpDir(), "tensor_parallel");
+  const int kNumTensors = 5;
+  const int kNumShards = 3;
+  setenv("TF_SAVEV2_PARALLEL_SHARDS", "3", 1 /* overwrite */);
+
+  MakeOp(kNumTensors);
+  AddInput<tstring>(TensorShape({}),
+                    [&prefix](int x) -> tstring { return prefix; });
+  AddInput<tstring>(TensorShape({kNumTensors}), [](int x) -> tstring {
+    return strings::StrCat("tensor_", x);
+  });
+  AddInput<tstring>(TensorShape({kNumTensors}),
+                    [](int x) -> tstring { return ""; });
+  for (int i = 0; i < kNumTensors; ++i) {
+    // Different sizes, to exercise the size-balanced shard assignment.
+    AddInput<float>(TensorShape({10 + 10 * i}),
+                    [i](int x) -> float { return i * 1000.f + x; });
+  }
+  TF_ASSERT_OK(RunOpKernel());
+  unsetenv("TF_SAVEV2_PARALLEL_SHARDS");
+
+  // The merged bundle has one data file per shard.
+  for (int shard = 0; shard < kNumShards; ++shard) {
+    TF_EXPECT_OK(Env::Default()->FileExists(
+        DataFilename(prefix, shard, kNumShards)));
+  }
+
+  // All tensors are readable through the merged metadata.
+  BundleReader reader(Env::Default(), prefix);
+  TF_EXPECT_OK(reader.status());
+  for (int i = 0; i < kNumTensors; ++i) {
+    const string name = strings::StrCat("tensor_", i);
+    TensorShape shape;
+    TF_EXPECT_OK(reader.LookupTensorShape(name, &shape));
+    EXPECT_TRUE(shape.IsSameSize(TensorShape({10 + 10 * i})));
+    Tensor val;
+    TF_EXPECT_OK(reader.Lookup(name, &val));
+    for (int x = 0; x < val.NumElements(); ++x) {
+      EXPECT_EQ(i * 1000.f + x, val.flat<float>()(x));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -20,6 +20,9 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/scan_ops.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/numeric_op.h"
@@ -33,6 +36,118 @@ namespace tensorflow {
 typedef Eigen::ThreadPoolDevice CPUDevice;
 typedef Eigen::GpuDevice GPUDevice;
 
+namespace functor {
+namespace {
+
+// Only scans at least this long amortize the extra pass over the data made
+// by the block decomposition below.
+constexpr Index kParallelScanMinLength = 1 << 15;
+// Lower bound on the per-block work, so shorter scans do not shatter into
+// cache-unfriendly slivers.
+constexpr Index kParallelScanMinBlockLength = 1 << 12;
+
+// Work-efficient parallel scan over a contiguous sequence, using the
+// two-pass Blelloch decomposition: pass one reduces each block to a single
+// total, a cheap serial exclusive scan over the block totals then gives
+// every block its starting accumulator, and pass two scans each block
+// independently from that seed.  Both passes shard the blocks over the
+// intra-op pool.  This reassociates the reduction, so floating point
+// results may differ from the sequential scan in the last few bits.
+template <typename Reducer, typename T>
+void ParallelScan(const CPUDevice& d, const T* in, T* out,
+                  const Index length, const Reducer& reducer,
+                  const bool reverse, const bool exclusive) {
+  const Index max_blocks = length / kParallelScanMinBlockLength;
+  const Index num_blocks =
+      std::min<Index>(d.numThreads(), std::max<Index>(max_blocks, 1));
+  const Index block_length = (length + num_blocks - 1) / num_blocks;
+
+  // in[at(i)] is the i'th element in scan order.
+  auto at = [length, reverse](Index i) {
+    return reverse ? length - 1 - i : i;
+  };
+  const Eigen::TensorOpCost block_cost(block_length * sizeof(T),
+                                       block_length * sizeof(T),
+                                       block_length);
+
+  // Pass one: reduce each block to its total.
+  std::vector<T> block_seed(num_blocks);
+  d.parallelFor(
+      num_blocks, block_cost, [&](Index block_begin, Index block_end) {
+        for (Index block = block_begin; block < block_end; ++block) {
+          const Index begin = block * block_length;
+          const Index end = std::min(begin + block_length, length);
+          T accum = reducer.initialize();
+          for (Index i = begin; i < end; ++i) {
+            reducer.reduce(in[at(i)], &accum);
+          }
+          block_seed[block] = accum;
+        }
+      });
+
+  // The serial exclusive scan over the (few) block totals seeds each block.
+  T running = reducer.initialize();
+  for (Index block = 0; block < num_blocks; ++block) {
+    const T total = block_seed[block];
+    block_seed[block] = running;
+    reducer.reduce(total, &running);
+  }
+
+  // Pass two: scan each block independently from its seed.
+  d.parallelFor(
+      num_blocks, block_cost, [&](Index block_begin, Index block_end) {
+        for (Index block = block_begin; block < block_end; ++block) {
+          const Index begin = block * block_length;
+          const Index end = std::min(begin + block_length, length);
+          T accum = block_seed[block];
+          for (Index i = begin; i < end; ++i) {
+            if (exclusive) {
+              out[at(i)] = reducer.finalize(accum);
+              reducer.reduce(in[at(i)], &accum);
+            } else {
+              reducer.reduce(in[at(i)], &accum);
+              out[at(i)] = reducer.finalize(accum);
+            }
+          }
+        }
+      });
+}
+
+}  // namespace
+
+// CPU specialization: a long contiguous scan, which the generic Eigen
+// evaluator runs on a single thread, is dispatched to the parallel scan
+// above.  Everything else falls through to the Eigen path, which already
+// distributes the independent outer and inner scan lines across threads.
+template <typename Reducer, typename T>
+struct Scan<CPUDevice, Reducer, T> {
+  void operator()(const CPUDevice& d, typename TTypes<T, 3>::ConstTensor in,
+                  typename TTypes<T, 3>::Tensor out, const Reducer& reducer,
+                  const bool reverse, const bool exclusive) {
+    const Index outer = in.dimension(0);
+    const Index length = in.dimension(1);
+    const Index inner = in.dimension(2);
+    if (outer == 1 && inner == 1 && length >= kParallelScanMinLength &&
+        d.numThreads() > 1) {
+      ParallelScan(d, in.data(), out.data(), length, reducer, reverse,
+                   exclusive);
+      return;
+    }
+    Eigen::array<bool, 3> dims;
+    dims[0] = false;
+    dims[1] = reverse;
+    dims[2] = false;
+    MaybeWith32BitIndexing<CPUDevice>(
+        [&](auto in32, auto out32) {
+          out32.device(d) =
+              in32.reverse(dims).scan(1, reducer, exclusive).reverse(dims);
+        },
+        in, out);
+  }
+};
+
+}  // namespace functor
+
 template <typename Device, class T, typename Reducer, typename Tidx>
 class ScanOp : public OpKernel {
  public:
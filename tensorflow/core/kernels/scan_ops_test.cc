@@ -114,6 +114,20 @@ static void Do3DYCumsum(::testing::benchmark::State& state,
                           num_y * sizeof(float));
 }
 
+static void BM_OneDCumsumCPU(::testing::benchmark::State& state) {
+  const int num_x = state.range(0);
+
+  LargeOneDimensional<float>(state, "cpu", num_x);
+}
+BENCHMARK(BM_OneDCumsumCPU)->Range(1, 1 << 21);
+
+static void BM_OneDCumsumCPU_reverse(::testing::benchmark::State& state) {
+  const int num_x = state.range(0);
+
+  LargeOneDimensional<float>(state, "cpu", num_x, true);
+}
+BENCHMARK(BM_OneDCumsumCPU_reverse)->Range(1, 1 << 21);
+
 static void BM_OneDCumsumGPU(::testing::benchmark::State& state) {
   const int num_x = state.range(0);
 
@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_SEGMENT_REDUCTION_OPS_IMPL_H_
 #define TENSORFLOW_CORE_KERNELS_SEGMENT_REDUCTION_OPS_IMPL_H_
 
+#include <algorithm>
 #include <cstdint>
 
 #include "tensorflow/core/framework/op_requires.h"
@@ -40,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/segment_reduction_ops.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/prefetch.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
 
@@ -822,6 +824,17 @@ class SparseSegmentReductionOpBase : public OpKernel {
         }
       }
       for (; r < num; r += 8) {
+        // Prefetch the start of the rows gathered by the next iteration so
+        // that table rows stream into the accumulator instead of stalling on
+        // cache misses; embedding lookup indices are effectively random, so
+        // the hardware prefetcher cannot anticipate them.
+        const int64_t prefetch_limit = std::min(num, r + int64_t{16});
+        for (int64_t p = r + 8; p < prefetch_limit; ++p) {
+          const auto pre_index = indices_vec(start + p);
+          if (FastBoundsCheck(pre_index, input_flat.dimension(0))) {
+            port::prefetch<port::PREFETCH_HINT_T0>(&input_flat(pre_index, 0));
+          }
+        }
         INDEX(0, r);
         INDEX(1, r + 1);
         INDEX(2, r + 2);
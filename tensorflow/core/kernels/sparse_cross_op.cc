@@ -801,8 +801,11 @@ class SparseCrossOp : public OpKernel {
     auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
     // TODO(zakaria): optimize kCostPerUnit
     const int kCostPerUnit = 5000 * indices_list_in.size();
-    Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
-          kCostPerUnit, do_work);
+    // The number of crosses per batch item depends on the number of values
+    // in its rows, so use the work-stealing sharder to keep threads busy
+    // when that distribution is skewed.
+    ShardStealing(worker_threads->num_threads, worker_threads->workers,
+                  batch_size, kCostPerUnit, do_work);
   }
 
  private:
@@ -872,8 +875,11 @@ class SparseCrossV2Op : public OpKernel {
     auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
     // TODO(zakaria): optimize kCostPerUnit
     const int kCostPerUnit = 5000 * indices_list_in.size();
-    Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
-          kCostPerUnit, do_work);
+    // The number of crosses per batch item depends on the number of values
+    // in its rows, so use the work-stealing sharder to keep threads busy
+    // when that distribution is skewed.
+    ShardStealing(worker_threads->num_threads, worker_threads->workers,
+                  batch_size, kCostPerUnit, do_work);
   }
 };
 
@@ -947,8 +953,11 @@ class SparseCrossHashedOp : public OpKernel {
     auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
     // TODO(zakaria): optimize kCostPerUnit
     const int kCostPerUnit = 5000 * indices_list_in.size();
-    Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
-          kCostPerUnit, do_work);
+    // The number of crosses per batch item depends on the number of values
+    // in its rows, so use the work-stealing sharder to keep threads busy
+    // when that distribution is skewed.
+    ShardStealing(worker_threads->num_threads, worker_threads->workers,
+                  batch_size, kCostPerUnit, do_work);
   }
 };
 
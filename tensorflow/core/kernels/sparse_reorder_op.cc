@@ -21,12 +21,14 @@ limitations under the License.
 #include <numeric>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/bits.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/util/sparse/sparse_tensor.h"
 
@@ -40,6 +42,173 @@ using GPUDevice = Eigen::GpuDevice;
 
 namespace functor {
 
+namespace {
+
+// Entry count below which the parallel bucket sort is not worth its setup and
+// extra memory, and the generic in-place Reorder() is used instead.
+constexpr int64_t kParallelReorderThreshold = 1 << 14;
+
+// Computes the per-dimension field widths for packing a multi-dimensional
+// index into a single 64-bit sort key, row-major. Returns false if the packed
+// key would not fit in 63 bits (very high rank or huge dimensions), in which
+// case the caller must fall back to comparator-based sorting.
+bool ComputeIndexKeyBits(gtl::ArraySlice<int64_t> shape,
+                         gtl::InlinedVector<int, 8>* bits) {
+  int total_bits = 0;
+  bits->resize(shape.size());
+  for (size_t d = 0; d < shape.size(); ++d) {
+    const int dim_bits =
+        std::max(1, Log2Ceiling64(static_cast<uint64>(shape[d])));
+    (*bits)[d] = dim_bits;
+    total_bits += dim_bits;
+  }
+  return total_bits <= 63;
+}
+
+// Reorders (indices, values) into freshly allocated outputs using a
+// bit-packed 64-bit key per entry and a two-phase parallel bucket sort:
+// entries are first scattered into 256 buckets by their top key byte
+// (deterministically, preserving input order within each bucket's chunk
+// layout), then the buckets are sorted independently in parallel.  Keys are
+// packed so that unsigned key order equals the row-major lexicographic order
+// the comparators would produce.  Returns false without touching the outputs
+// if the shape cannot be packed or an index value does not fit its field
+// (e.g. negative or out of range); such inputs take the generic path, which
+// tolerates them the same way DimComparator does.
+template <typename T>
+bool ParallelReorder(OpKernelContext* context, const Tensor& input_ind,
+                     const Tensor& input_val,
+                     gtl::ArraySlice<int64_t> input_shape) {
+  const int64_t num_entries = input_ind.dim_size(0);
+  const int rank = static_cast<int>(input_ind.dim_size(1));
+  if (rank != static_cast<int>(input_shape.size())) return false;
+
+  gtl::InlinedVector<int, 8> bits;
+  if (!ComputeIndexKeyBits(input_shape, &bits)) return false;
+
+  auto ix = input_ind.matrix<int64_t>();
+  auto vals = input_val.vec<T>();
+  auto* workers = context->device()->tensorflow_cpu_worker_threads()->workers;
+
+  // Phase 1: pack keys in parallel, checking that every coordinate fits its
+  // field so that key order is exactly lexicographic order.
+  std::vector<std::pair<uint64, int64_t>> keys(num_entries);
+  std::atomic<bool> packable(true);
+  workers->ParallelFor(
+      num_entries, rank * 10 /* cycles per entry, roughly */,
+      [&](int64_t begin, int64_t end) {
+        bool ok = true;
+        for (int64_t i = begin; i < end; ++i) {
+          uint64 key = 0;
+          for (int d = 0; d < rank; ++d) {
+            const int64_t coord = ix(i, d);
+            const uint64 mask = (uint64{1} << bits[d]) - 1;
+            ok = ok && coord >= 0 && static_cast<uint64>(coord) <= mask;
+            key = (key << bits[d]) | (static_cast<uint64>(coord) & mask);
+          }
+          keys[i] = {key, i};
+        }
+        if (!ok) packable.store(false, std::memory_order_relaxed);
+      });
+  if (!packable.load(std::memory_order_relaxed)) return false;
+
+  // Phase 2: scatter into 256 buckets keyed by the top byte of the used key
+  // range. Chunk boundaries are fixed functions of the input size, so the
+  // resulting layout (and hence the final order) is deterministic.
+  int total_bits = 0;
+  for (int d = 0; d < rank; ++d) total_bits += bits[d];
+  const int bucket_shift = std::max(0, total_bits - 8);
+  constexpr int kNumBuckets = 256;
+
+  const int64_t num_chunks = std::max<int64_t>(
+      1, std::min<int64_t>(workers->NumThreads(),
+                           num_entries / kParallelReorderThreshold + 1));
+  const int64_t chunk_size = (num_entries + num_chunks - 1) / num_chunks;
+
+  std::vector<std::vector<int64_t>> chunk_counts(
+      num_chunks, std::vector<int64_t>(kNumBuckets, 0));
+  workers->ParallelFor(
+      num_chunks, 100000 /* one chunk per task */,
+      [&](int64_t chunk_begin, int64_t chunk_end) {
+        for (int64_t c = chunk_begin; c < chunk_end; ++c) {
+          const int64_t begin = c * chunk_size;
+          const int64_t end = std::min(num_entries, begin + chunk_size);
+          std::vector<int64_t>& counts = chunk_counts[c];
+          for (int64_t i = begin; i < end; ++i) {
+            ++counts[keys[i].first >> bucket_shift];
+          }
+        }
+      });
+
+  // Exclusive prefix sums: offsets[c][b] is where chunk c starts writing
+  // bucket b's entries.
+  std::vector<int64_t> bucket_begin(kNumBuckets + 1, 0);
+  {
+    int64_t offset = 0;
+    for (int b = 0; b < kNumBuckets; ++b) {
+      bucket_begin[b] = offset;
+      for (int64_t c = 0; c < num_chunks; ++c) {
+        const int64_t count = chunk_counts[c][b];
+        chunk_counts[c][b] = offset;
+        offset += count;
+      }
+    }
+    bucket_begin[kNumBuckets] = offset;
+  }
+
+  std::vector<std::pair<uint64, int64_t>> sorted(num_entries);
+  workers->ParallelFor(
+      num_chunks, 100000 /* one chunk per task */,
+      [&](int64_t chunk_begin, int64_t chunk_end) {
+        for (int64_t c = chunk_begin; c < chunk_end; ++c) {
+          const int64_t begin = c * chunk_size;
+          const int64_t end = std::min(num_entries, begin + chunk_size);
+          std::vector<int64_t>& offsets = chunk_counts[c];
+          for (int64_t i = begin; i < end; ++i) {
+            sorted[offsets[keys[i].first >> bucket_shift]++] = keys[i];
+          }
+        }
+      });
+
+  // Phase 3: sort each bucket independently. Ties on the packed key are
+  // broken by the original row, which both makes the sort stable and matches
+  // what a stable comparator sort would produce for duplicate indices.
+  workers->ParallelFor(
+      kNumBuckets, (num_entries / kNumBuckets + 1) * 50 /* sort cost */,
+      [&](int64_t bucket_begin_idx, int64_t bucket_end_idx) {
+        for (int64_t b = bucket_begin_idx; b < bucket_end_idx; ++b) {
+          std::sort(sorted.begin() + bucket_begin[b],
+                    sorted.begin() + bucket_begin[b + 1]);
+        }
+      });
+
+  // Phase 4: gather the reordered indices and values straight into the
+  // outputs, skipping the deep copy and in-place cycle swaps of the generic
+  // path.
+  Tensor* out_ind = nullptr;
+  Tensor* out_val = nullptr;
+  if (!context->allocate_output(0, input_ind.shape(), &out_ind).ok() ||
+      !context->allocate_output(1, input_val.shape(), &out_val).ok()) {
+    return true;  // Status already set on the context.
+  }
+  auto out_ix = out_ind->matrix<int64_t>();
+  auto out_vals = out_val->vec<T>();
+  workers->ParallelFor(
+      num_entries, (rank + 1) * 10 /* cycles per entry, roughly */,
+      [&](int64_t begin, int64_t end) {
+        for (int64_t i = begin; i < end; ++i) {
+          const int64_t src = sorted[i].second;
+          for (int d = 0; d < rank; ++d) {
+            out_ix(i, d) = ix(src, d);
+          }
+          out_vals(i) = vals(src);
+        }
+      });
+  return true;
+}
+
+}  // namespace
+
 template <typename T>
 struct SparseReorderFunctor<CPUDevice, T> {
   void operator()(OpKernelContext* context, const Tensor& input_ind,
@@ -60,6 +229,13 @@ struct SparseReorderFunctor<CPUDevice, T> {
       context->set_output(0, input_sp.indices());
       context->set_output(1, input_sp.values());
     } else {
+      // For large inputs whose indices pack into 64-bit keys, reorder with
+      // the parallel bucket sort and write straight into the outputs.
+      if (input_ind.dim_size(0) >= kParallelReorderThreshold &&
+          ParallelReorder<T>(context, input_ind, input_val, input_shape)) {
+        return;
+      }
+
       // Deep-copy the input Tensors, then reorder in-place
       sparse::SparseTensor reordered_sp;
       OP_REQUIRES_OK(context,
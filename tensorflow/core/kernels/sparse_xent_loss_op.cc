@@ -0,0 +1,136 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "tensorflow/core/framework/bounds_check.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+// Loss-only sparse softmax cross-entropy,
+//
+//   loss[b] = log(sum_j exp(logits[b, j])) - logits[b, label[b]],
+//
+// computed with a single streaming pass per row that carries a running
+// maximum and a rescaled running sum, so neither the shifted logits nor the
+// probabilities are materialized. Created by the grappler remapper for
+// SparseSoftmaxCrossEntropyWithLogits nodes whose backprop output is unused;
+// see FindSparseXentLossOnly in grappler/optimizers/remapper.cc.
+template <typename T, typename Index>
+class SparseXentLossOp : public OpKernel {
+ public:
+  explicit SparseXentLossOp(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& logits = context->input(0);
+    const Tensor& labels = context->input(1);
+    OP_REQUIRES(context, TensorShapeUtils::IsMatrix(logits.shape()),
+                errors::InvalidArgument("logits must be 2-D, but got shape ",
+                                        logits.shape().DebugString()));
+    OP_REQUIRES(context, TensorShapeUtils::IsVector(labels.shape()),
+                errors::InvalidArgument("labels must be 1-D, but got shape ",
+                                        labels.shape().DebugString()));
+    OP_REQUIRES(context, logits.dim_size(0) == labels.dim_size(0),
+                errors::InvalidArgument(
+                    "logits and labels must have the same first dimension, "
+                    "got logits shape ",
+                    logits.shape().DebugString(), " and labels shape ",
+                    labels.shape().DebugString()));
+    OP_REQUIRES(context, logits.dim_size(1) > 0,
+                errors::InvalidArgument(
+                    "Must have at least one class, but got logits shape ",
+                    logits.shape().DebugString()));
+
+    const int64_t batch_size = logits.dim_size(0);
+    const int64_t num_classes = logits.dim_size(1);
+
+    Tensor* loss = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, labels.shape(), &loss));
+    if (batch_size == 0) return;
+
+    const auto label_values = labels.vec<Index>();
+    for (int64_t b = 0; b < batch_size; ++b) {
+      const Index label = internal::SubtleMustCopy(label_values(b));
+      OP_REQUIRES(
+          context, FastBoundsCheck(label, num_classes),
+          errors::InvalidArgument("Received a label value of ", label,
+                                  " which is outside the valid range of [0, ",
+                                  num_classes, ")."));
+    }
+
+    // Accumulate in float for the 16-bit types and double for double.
+    using AccT = typename std::conditional<std::is_same<T, double>::value,
+                                           double, float>::type;
+    const T* logit_data = logits.flat<T>().data();
+    T* loss_data = loss->flat<T>().data();
+
+    auto compute_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t b = begin; b < end; ++b) {
+        const T* row = logit_data + b * num_classes;
+        // Online softmax normalizer: when the running maximum grows, the
+        // running sum is rescaled instead of re-reading the row.
+        AccT max_logit = -std::numeric_limits<AccT>::infinity();
+        AccT sum_exp = AccT(0);
+        for (int64_t j = 0; j < num_classes; ++j) {
+          const AccT logit = static_cast<AccT>(row[j]);
+          if (logit > max_logit) {
+            sum_exp *= std::exp(max_logit - logit);
+            max_logit = logit;
+          }
+          sum_exp += std::exp(logit - max_logit);
+        }
+        const AccT label_logit =
+            static_cast<AccT>(row[internal::SubtleMustCopy(label_values(b))]);
+        loss_data[b] =
+            static_cast<T>(std::log(sum_exp) + max_logit - label_logit);
+      }
+    };
+
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
+          10 * num_classes /* cost_per_unit */, compute_rows);
+  }
+};
+
+#define REGISTER(T, Index)                                \
+  REGISTER_KERNEL_BUILDER(                                \
+      Name("_SparseSoftmaxCrossEntropyLoss")              \
+          .Device(DEVICE_CPU)                             \
+          .TypeConstraint<T>("T")                         \
+          .TypeConstraint<Index>("Tlabels"),              \
+      SparseXentLossOp<T, Index>);
+REGISTER(float, int32)
+REGISTER(float, int64_t)
+REGISTER(double, int32)
+REGISTER(double, int64_t)
+REGISTER(Eigen::half, int32)
+REGISTER(Eigen::half, int64_t)
+REGISTER(bfloat16, int32)
+REGISTER(bfloat16, int64_t)
+#undef REGISTER
+
+}  // namespace tensorflow
@@ -47,27 +47,68 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 
+// Copies a stride-1 slice as a sequence of memcpys of maximal contiguous
+// runs. A run is the first partially-taken dimension (scanning from the
+// innermost) together with all fully-taken dimensions inside it; the outer
+// sliced dimensions are walked with an odometer. The classification of the
+// slice spec is done once here, not per element. Shrink/new axes only
+// insert or remove size-1 dimensions and do not change the linear element
+// order, so copying into the flat output is correct regardless of masks.
 template <typename T>
 struct MemCpyFunctor {
   // Returns true if the copy was made with memcpy, false otherwise.
   bool Copy(const Tensor& input, const gtl::InlinedVector<int64_t, 4>& begin,
             const gtl::InlinedVector<int64_t, 4>& end, Tensor* result) {
-    if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
-      auto in = input.tensor<T, 2>();
-      auto output = result->tensor<T, 2>();
-      // TODO(agarwal): Consider multi-threading if size[0] is large
-      for (int row_in = begin[0], row_out = 0; row_in < end[0];
-           ++row_in, ++row_out) {
-        if (row_in + 1 < end[0]) {
-          port::prefetch<port::PREFETCH_HINT_T0>(&output(row_in + 1, 0));
-          port::prefetch<port::PREFETCH_HINT_T0>(&in(row_in + 1, begin[1]));
-        }
-        memcpy(&output(row_out, 0), &in(row_in, begin[1]),
-               (end[1] - begin[1]) * sizeof(T));
+    if (!DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
+      return false;
+    }
+    const int dims = input.dims();
+    // Find the outermost dimension of the contiguous run: skip over trailing
+    // dimensions that are taken in full.
+    int run_dim = dims - 1;
+    int64_t inner = 1;
+    while (run_dim >= 0 && begin[run_dim] == 0 &&
+           end[run_dim] == input.dim_size(run_dim)) {
+      inner *= input.dim_size(run_dim);
+      --run_dim;
+    }
+    // run_dim < 0 means the slice is the whole input; that is handled by the
+    // identity path before we get here.
+    if (run_dim < 0) {
+      return false;
+    }
+    const int64_t run_elems = (end[run_dim] - begin[run_dim]) * inner;
+    const size_t run_bytes = run_elems * sizeof(T);
+
+    gtl::InlinedVector<int64_t, 4> stride(dims);
+    stride[dims - 1] = 1;
+    for (int i = dims - 2; i >= 0; --i) {
+      stride[i] = stride[i + 1] * input.dim_size(i + 1);
+    }
+
+    const T* in = input.flat<T>().data();
+    T* out = result->flat<T>().data();
+    gtl::InlinedVector<int64_t, 4> coord(begin.begin(),
+                                         begin.begin() + run_dim);
+    int64_t offset = begin[run_dim] * stride[run_dim];
+    for (int i = 0; i < run_dim; ++i) {
+      offset += begin[i] * stride[i];
+    }
+    while (true) {
+      memcpy(out, in + offset, run_bytes);
+      out += run_elems;
+      // Odometer increment over the outer sliced dimensions.
+      int d = run_dim - 1;
+      for (; d >= 0; --d) {
+        offset += stride[d];
+        if (++coord[d] < end[d]) break;
+        offset -= (end[d] - begin[d]) * stride[d];
+        coord[d] = begin[d];
       }
-      return true;
+      if (d < 0) break;
+      port::prefetch<port::PREFETCH_HINT_T0>(in + offset);
     }
-    return false;
+    return true;
   }
 };
 
@@ -143,15 +184,10 @@ class StridedSliceOp : public OpKernel {
     const int processing_dims = processing_shape.dims();
 
     if (processing_shape.num_elements() > 0) {
-      // Optimization #3, slice has stride 1 in all dimensions
-      // Optimization #3A, slice has only two dimensions
-      // TODO(aselle): Here we are restricting to processing_shape and
-      // final_shape being 2D. This isn't strictly necessary, but I don't
-      // want to blow up code gen size, because to shape<> you need static
-      // NDIM and T
-      if (is_simple_slice && std::is_same<Device, CPUDevice>::value &&
-          input_dims == 2 && processing_shape.dims() == 2 &&
-          final_shape.dims() == 2 && new_axis_mask == 0) {
+      // Optimization #3, slice has stride 1 in all dimensions: copy maximal
+      // contiguous runs with memcpy instead of per-element index arithmetic.
+      // The run structure is classified once from the validated slice spec.
+      if (is_simple_slice && std::is_same<Device, CPUDevice>::value) {
         MemCpyFunctor<T> functor;
         if (functor.Copy(input, begin, end, result)) {
           return;
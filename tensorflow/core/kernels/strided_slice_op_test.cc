@@ -93,6 +93,44 @@ void BM_SliceBFloat16(::testing::benchmark::State& state) {
 
 BENCHMARK(BM_SliceBFloat16)->UseRealTime()->Arg(100)->Arg(1000)->Arg(10000);
 
+// 3-D slice that is partial in the two outer dimensions and takes the inner
+// dimension in full, so each (d0, d1) pair selects one contiguous run.
+template <typename T>
+static void SliceInnerRunHelper(::testing::benchmark::State& state) {
+  const int size = state.range(0);
+  Graph* g = new Graph(OpRegistry::Global());
+  DataType dt = DataTypeToEnum<T>::v();
+  int kDim = 100;
+  int kMaxSize = 15000;
+  CHECK_LT(size, kMaxSize);
+
+  Tensor begin = test::AsTensor<int32>({10, 10, 0});
+  Tensor end = test::AsTensor<int32>({10 + kDim, 10 + size, 32});
+  Tensor strides = test::AsTensor<int32>({1, 1, 1});
+
+  Tensor input(dt, TensorShape({2 * kDim, kMaxSize, 32}));
+  input.flat<T>().setRandom();
+
+  Node* node;
+  TF_CHECK_OK(NodeBuilder(g->NewName("n"), "StridedSlice")
+                  .Input(test::graph::Constant(g, input))
+                  .Input(test::graph::Constant(g, begin))
+                  .Input(test::graph::Constant(g, end))
+                  .Input(test::graph::Constant(g, strides))
+                  .Attr("T", dt)
+                  .Finalize(g, &node));
+
+  test::Benchmark("cpu", g, /*old_benchmark_api*/ false).Run(state);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * kDim *
+                          size * 32 * sizeof(T));
+}
+
+void BM_SliceInnerRunFloat(::testing::benchmark::State& state) {
+  SliceInnerRunHelper<float>(state);
+}
+
+BENCHMARK(BM_SliceInnerRunFloat)->UseRealTime()->Arg(100)->Arg(1000);
+
 void BM_ValidateStridedSliceOp(::testing::benchmark::State& state) {
   int kDim = 100;
   int kMaxSize = 15000;
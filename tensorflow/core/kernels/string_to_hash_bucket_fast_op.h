@@ -23,6 +23,8 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/prefetch.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -44,15 +46,31 @@ class StringToHashBucketOp : public OpKernel {
                                             &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    typedef decltype(input_flat.size()) Index;
-    for (Index i = 0; i < input_flat.size(); ++i) {
-      const uint64 input_hash = hash(input_flat(i));
-      const uint64 bucket_id = input_hash % num_buckets_;
-      // The number of buckets is always in the positive range of int64 so is
-      // the resulting bucket_id. Casting the bucket_id from uint64 to int64 is
-      // safe.
-      output_flat(i) = static_cast<int64_t>(bucket_id);
-    }
+    auto hash_range = [&input_flat, &output_flat,
+                       this](int64_t start, int64_t end) {
+      for (int64_t i = start; i < end; ++i) {
+        // The strings in a batch are heap-allocated in unrelated places, so
+        // pull the next string's bytes into cache while hashing the current
+        // one.
+        if (i + 1 < end) {
+          port::prefetch<port::PREFETCH_HINT_T0>(input_flat(i + 1).data());
+        }
+        const uint64 input_hash = hash(input_flat(i));
+        const uint64 bucket_id = input_hash % num_buckets_;
+        // The number of buckets is always in the positive range of int64 so
+        // is the resulting bucket_id. Casting the bucket_id from uint64 to
+        // int64 is safe.
+        output_flat(i) = static_cast<int64_t>(bucket_id);
+      }
+    };
+
+    const int64_t num_elements = input_flat.size();
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    // Rough cost of hashing a short string plus the modulo; longer strings
+    // only make sharding more profitable.
+    const int64_t kCostPerUnit = 100;
+    Shard(worker_threads->num_threads, worker_threads->workers, num_elements,
+          kCostPerUnit, hash_range);
   }
 
  private:
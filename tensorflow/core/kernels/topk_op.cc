@@ -109,6 +109,16 @@ class TopK : public OpKernel {
 
 namespace functor {
 
+// Selection (std::nth_element, i.e. introselect with a median-of-medians
+// fallback) beats the per-row heap when the row is wide and k is a small
+// fraction of it: the heap does ~num_cols * log2(k) ordered comparisons with
+// poor locality, while partitioning is linear over the row. For narrow rows
+// or large k/num_cols ratios the heap's smaller working set wins, so keep it.
+static bool UseSelectionForTopK(int k, int64_t num_cols) {
+  constexpr int64_t kSelectionMinCols = 1024;
+  return num_cols >= kSelectionMinCols && k <= num_cols / 8;
+}
+
 template <typename T>
 struct TopKFunctor<CPUDevice, T> {
   static EIGEN_ALWAYS_INLINE Status Compute(
@@ -142,6 +152,9 @@ struct TopKFunctor<CPUDevice, T> {
     }
 
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
+      // Scratch index array for the selection path, reused across the rows of
+      // this shard.
+      std::vector<int32> scratch;
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
         const auto stable_comp = [input_data](const int32_t a,
@@ -184,6 +197,19 @@ struct TopKFunctor<CPUDevice, T> {
             }
             run_begin = run_end;
           }
+        } else if (UseSelectionForTopK(k, num_cols)) {
+          // Partition all column indices around the k-th largest element,
+          // then order just the selected prefix if the caller asked for
+          // sorted output. stable_comp is a strict total order, so the
+          // selected set (and its sorted order) match the heap path exactly.
+          scratch.resize(num_cols);
+          std::iota(scratch.begin(), scratch.end(), 0);
+          std::nth_element(scratch.begin(), scratch.begin() + k - 1,
+                           scratch.end(), stable_comp);
+          if (sorted) {
+            std::sort(scratch.begin(), scratch.begin() + k, stable_comp);
+          }
+          std::copy(scratch.begin(), scratch.begin() + k, &indices(b, 0));
         } else {
           // Use the TopN heap object to sort.
           gtl::TopN<int32, decltype(stable_comp)> filter(k, stable_comp);
@@ -222,7 +248,15 @@ struct TopKFunctor<CPUDevice, T> {
         cmp_cost *
         static_cast<double>(num_cols *
                             Eigen::numext::log2(static_cast<float>(k + 1)));
-    const double sort_cost = (k == num_cols) ? base_cost : 4 * base_cost;
+    // The selection path is linear in num_cols plus a sort of the k winners.
+    const double sort_cost =
+        (k == num_cols) ? base_cost
+        : UseSelectionForTopK(k, num_cols)
+            ? cmp_cost * static_cast<double>(2 * num_cols) +
+                  cmp_cost * static_cast<double>(
+                                 k * Eigen::numext::log2(static_cast<float>(
+                                         k + 1)))
+            : 4 * base_cost;
     const double copy_cost = 2 * k * Eigen::TensorOpCost::AddCost<T>();
     const double total_cost = sort_cost + copy_cost;
     const int64_t final_cost = (total_cost >= static_cast<double>(kint64max))
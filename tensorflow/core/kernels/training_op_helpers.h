@@ -65,6 +65,10 @@ Status EnsureSparseVariableAccess(OpKernelContext* ctx, Var* var) {
   }
   *var->tensor() = tmp;
   var->copy_on_read_mode.store(true);
+  // Any lock-free read snapshot now refers to the detached old buffer; drop
+  // it so the buffer can be reclaimed once the last reader releases it
+  // (readers ignore snapshots while in copy-on-read mode).
+  var->ClearSnapshot();
   return OkStatus();
 }
 
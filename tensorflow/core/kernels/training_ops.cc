@@ -17,6 +17,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/training_ops.h"
 
 #include <algorithm>  // NOLINT
+#include <vector>
 
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -847,6 +848,109 @@ struct ApplyAdamNonCuda {
 template <typename T>
 struct ApplyAdam<CPUDevice, T> : ApplyAdamNonCuda<CPUDevice, T> {};
 
+template <typename T, typename Tindex>
+struct SparseApplyAdam<CPUDevice, T, Tindex> {
+  Status operator()(const CPUDevice& d, typename TTypes<T>::Matrix var,
+                    typename TTypes<T>::Matrix m, typename TTypes<T>::Matrix v,
+                    typename TTypes<T>::ConstScalar beta1_power,
+                    typename TTypes<T>::ConstScalar beta2_power,
+                    typename TTypes<T>::ConstScalar lr,
+                    typename TTypes<T>::ConstScalar beta1,
+                    typename TTypes<T>::ConstScalar beta2,
+                    typename TTypes<T>::ConstScalar epsilon,
+                    typename TTypes<T>::ConstMatrix grad,
+                    typename TTypes<Tindex>::ConstVec indices,
+                    int64_t inner_dim, bool use_nesterov) {
+    const Tindex N = static_cast<Tindex>(indices.dimension(0));
+    if (N == 0) return OkStatus();
+    const Tindex first_dim_size = static_cast<Tindex>(var.dimension(0));
+    for (Tindex i = 0; i < N; ++i) {
+      const Tindex index = internal::SubtleMustCopy(indices(i));
+      if (!FastBoundsCheck(index, first_dim_size)) {
+        return errors::InvalidArgument(strings::StrCat(
+            "Index ", index, " at offset ", i, " in indices is out of range"));
+      }
+    }
+
+    const T alpha = lr() * Eigen::numext::sqrt(T(1) - beta2_power()) /
+                    (T(1) - beta1_power());
+    const T beta1_scalar = beta1();
+    const T one_minus_beta1 = T(1) - beta1_scalar;
+    const T one_minus_beta2 = T(1) - beta2();
+    const T epsilon_scalar = epsilon();
+
+    // Each shard owns a contiguous range of variable rows, so the update for
+    // any given row happens on exactly one shard and no locking is needed.
+    // Unlike Adagrad, duplicated indices cannot simply be replayed: the
+    // second-moment update needs the square of the *summed* gradient, so each
+    // shard first accumulates the gradient rows that scatter into its range
+    // and then applies the update once per distinct row.
+    const Tindex num_shards = std::max<Tindex>(
+        1, std::min<Tindex>(static_cast<Tindex>(d.numThreads()),
+                            std::min<Tindex>(first_dim_size, N)));
+    const Tindex rows_per_shard = (first_dim_size + num_shards - 1) / num_shards;
+    const auto shard = [&](Tindex start_shard, Tindex end_shard) {
+      std::vector<Tindex> slot_of_row;
+      std::vector<Tindex> rows;
+      std::vector<T> sums;
+      for (Tindex s = start_shard; s < end_shard; ++s) {
+        const Tindex row_start = s * rows_per_shard;
+        const Tindex row_end =
+            std::min<Tindex>(first_dim_size, row_start + rows_per_shard);
+        slot_of_row.assign(row_end - row_start, -1);
+        rows.clear();
+        sums.clear();
+        for (Tindex i = 0; i < N; ++i) {
+          const Tindex index = internal::SubtleMustCopy(indices(i));
+          if (index < row_start || index >= row_end) continue;
+          Tindex& slot = slot_of_row[index - row_start];
+          const T* g_row = &grad(i, 0);
+          if (slot < 0) {
+            slot = static_cast<Tindex>(rows.size());
+            rows.push_back(index);
+            sums.insert(sums.end(), g_row, g_row + inner_dim);
+          } else {
+            T* sum_row = sums.data() + slot * inner_dim;
+            for (int64_t j = 0; j < inner_dim; ++j) sum_row[j] += g_row[j];
+          }
+        }
+        for (size_t u = 0; u < rows.size(); ++u) {
+          const Tindex row = rows[u];
+          const T* g = sums.data() + u * inner_dim;
+          T* m_row = &m(row, 0);
+          T* v_row = &v(row, 0);
+          T* var_row = &var(row, 0);
+          for (int64_t j = 0; j < inner_dim; ++j) {
+            m_row[j] += (g[j] - m_row[j]) * one_minus_beta1;
+            v_row[j] += (g[j] * g[j] - v_row[j]) * one_minus_beta2;
+            const T numerator =
+                use_nesterov
+                    ? (g[j] * one_minus_beta1 + beta1_scalar * m_row[j]) * alpha
+                    : m_row[j] * alpha;
+            var_row[j] -=
+                numerator / (Eigen::numext::sqrt(v_row[j]) + epsilon_scalar);
+          }
+        }
+      }
+    };
+
+    // Every shard scans all of the indices; only the accumulate and update
+    // work divides by the shard count.
+    const Tindex indices_per_shard = N / num_shards + 1;
+    const Eigen::TensorOpCost cost(
+        indices_per_shard * inner_dim * sizeof(T) * 4 + N * sizeof(Tindex),
+        indices_per_shard * inner_dim * sizeof(T) * 3,
+        N * Eigen::TensorOpCost::AddCost<int>() +
+            indices_per_shard * inner_dim *
+                (Eigen::TensorOpCost::AddCost<T>() * 6 +
+                 Eigen::TensorOpCost::MulCost<T>() * 5 +
+                 Eigen::TensorOpCost::DivCost<T>()));
+    d.parallelFor(num_shards, cost, shard);
+
+    return OkStatus();
+  }
+};
+
 template <typename T>
 struct ApplyAdamWithAmsgrad<CPUDevice, T> {
   void operator()(const CPUDevice& d, typename TTypes<T>::Flat var,
@@ -3654,6 +3758,136 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+template <typename Device, typename T, typename Tindex>
+class SparseApplyAdamOp : public OpKernel {
+ public:
+  explicit SparseApplyAdamOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_nesterov", &use_nesterov_));
+  }
+
+  void Compute(OpKernelContext* ctx) override TF_NO_THREAD_SAFETY_ANALYSIS {
+    const bool sparse = true;
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, {0, 1, 2});
+    Tensor var;
+    OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                            ctx, 0, use_exclusive_lock_, sparse, &var));
+    Tensor m;
+    OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                            ctx, 1, use_exclusive_lock_, sparse, &m));
+    Tensor v;
+    OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                            ctx, 2, use_exclusive_lock_, sparse, &v));
+    OP_REQUIRES(
+        ctx, var.IsInitialized(),
+        errors::FailedPrecondition(
+            "Attempting to use uninitialized variables: ", requested_input(0)));
+    OP_REQUIRES(
+        ctx, m.IsInitialized(),
+        errors::FailedPrecondition(
+            "Attempting to use uninitialized variables: ", requested_input(1)));
+    OP_REQUIRES(
+        ctx, v.IsInitialized(),
+        errors::FailedPrecondition(
+            "Attempting to use uninitialized variables: ", requested_input(2)));
+    OP_REQUIRES(ctx, var.shape().IsSameSize(m.shape()),
+                errors::InvalidArgument("var and m do not have the same shape",
+                                        var.shape().DebugString(), " ",
+                                        m.shape().DebugString()));
+    OP_REQUIRES(ctx, var.shape().IsSameSize(v.shape()),
+                errors::InvalidArgument("var and v do not have the same shape",
+                                        var.shape().DebugString(), " ",
+                                        v.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsVectorOrHigher(var.shape()),
+                errors::InvalidArgument("var must be at least 1 dimensional"));
+
+    const Tensor& beta1_power = ctx->input(3);
+    const Tensor& beta2_power = ctx->input(4);
+    const Tensor& lr = ctx->input(5);
+    const Tensor& beta1 = ctx->input(6);
+    const Tensor& beta2 = ctx->input(7);
+    const Tensor& epsilon = ctx->input(8);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1_power.shape()),
+                errors::InvalidArgument("beta1_power is not a scalar: ",
+                                        beta1_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2_power.shape()),
+                errors::InvalidArgument("beta2_power is not a scalar: ",
+                                        beta2_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(lr.shape()),
+                errors::InvalidArgument("lr is not a scalar : ",
+                                        lr.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1.shape()),
+                errors::InvalidArgument("beta1 is not a scalar: ",
+                                        beta1.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2.shape()),
+                errors::InvalidArgument("beta2 is not a scalar: ",
+                                        beta2.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(epsilon.shape()),
+                errors::InvalidArgument("epsilon is not a scalar: ",
+                                        epsilon.shape().DebugString()));
+
+    const Tensor& grad = ctx->input(9);
+    const Tensor& indices = ctx->input(10);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsVector(indices.shape()),
+                errors::InvalidArgument("indices must be one-dimensional"));
+
+    int64_t inner_dim = 1;
+    for (int d = 1; d < var.dims(); d++) {
+      OP_REQUIRES(ctx, var.dim_size(d) == grad.dim_size(d),
+                  errors::InvalidArgument(strings::StrCat(
+                      "var and grad must match in dimension ", d)));
+      inner_dim *= grad.dim_size(d);
+    }
+    const Tindex N = indices.dim_size(0);
+    OP_REQUIRES(
+        ctx, grad.dim_size(0) == N,
+        errors::InvalidArgument(
+            "grad must be the same size as indices in the first dimension."));
+
+    OP_REQUIRES(ctx, inner_dim > 0,
+                errors::InvalidArgument(
+                    "Inner dimension should be greater than zero."));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    OP_REQUIRES_OK(
+        ctx, functor::SparseApplyAdam<Device, T, Tindex>()(
+                 device, var.flat_outer_dims<T>(), m.flat_outer_dims<T>(),
+                 v.flat_outer_dims<T>(), beta1_power.scalar<T>(),
+                 beta2_power.scalar<T>(), lr.scalar<T>(), beta1.scalar<T>(),
+                 beta2.scalar<T>(), epsilon.scalar<T>(),
+                 grad.flat_outer_dims<T>(), indices.vec<Tindex>(), inner_dim,
+                 use_nesterov_));
+
+    MaybeForwardRefInputToRefOutput(ctx, 0, 0);
+  }
+
+ private:
+  bool use_exclusive_lock_;
+  bool use_nesterov_;
+};
+
+#define REGISTER_KERNELS(T, Tindices)                                 \
+  REGISTER_KERNEL_BUILDER(Name("SparseApplyAdam")                     \
+                              .Device(DEVICE_CPU)                     \
+                              .TypeConstraint<T>("T")                 \
+                              .TypeConstraint<Tindices>("Tindices"),  \
+                          SparseApplyAdamOp<CPUDevice, T, Tindices>); \
+  REGISTER_KERNEL_BUILDER(Name("ResourceSparseApplyAdam")             \
+                              .Device(DEVICE_CPU)                     \
+                              .TypeConstraint<T>("T")                 \
+                              .TypeConstraint<Tindices>("Tindices"),  \
+                          SparseApplyAdamOp<CPUDevice, T, Tindices>);
+#define REGISTER_CPU_KERNELS(T) \
+  REGISTER_KERNELS(T, int32);   \
+  REGISTER_KERNELS(T, int64_t);
+
+TF_CALL_FLOAT_TYPES(REGISTER_CPU_KERNELS);
+
+#undef REGISTER_CPU_KERNELS
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdamWithAmsgradOp : public OpKernel {
  public:
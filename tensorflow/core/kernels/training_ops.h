@@ -245,6 +245,23 @@ struct ApplyAdam {
                   typename TTypes<T>::ConstFlat grad, bool use_nesterov);
 };
 
+template <typename Device, typename T, typename Tindex>
+struct SparseApplyAdam {
+  // Accepts raw (possibly duplicated) indices; gradients for the same row
+  // are summed before the Adam update is applied.
+  Status operator()(const Device& d, typename TTypes<T>::Matrix var,
+                    typename TTypes<T>::Matrix m, typename TTypes<T>::Matrix v,
+                    typename TTypes<T>::ConstScalar beta1_power,
+                    typename TTypes<T>::ConstScalar beta2_power,
+                    typename TTypes<T>::ConstScalar lr,
+                    typename TTypes<T>::ConstScalar beta1,
+                    typename TTypes<T>::ConstScalar beta2,
+                    typename TTypes<T>::ConstScalar epsilon,
+                    typename TTypes<T>::ConstMatrix grad,
+                    typename TTypes<Tindex>::ConstVec indices,
+                    int64_t inner_dim, bool use_nesterov);
+};
+
 template <typename Device, typename T>
 struct ApplyAdamWithAmsgrad {
   void operator()(const Device& d, typename TTypes<T>::Flat var,
@@ -13,9 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -26,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -68,6 +71,132 @@ struct UniqueOpHashMap<bfloat16, TIndex> {
   using map_type = std::unordered_map<bfloat16, TIndex>;
 };
 
+// Minimum number of elements before the hash-partitioned parallel
+// implementation is used for the scalar case. Below this the single-map
+// serial loop wins on setup cost.
+constexpr int64_t kParallelUniqueMinElements = 256 * 1024;
+
+// Parallel hash-partitioned implementation of the scalar Unique case.
+// Elements are routed to one of `num_partitions` sub-problems by their hash
+// (equal elements always land in the same partition), per-partition hash maps
+// are built concurrently, and the partial results are merged with a stable
+// index remapping, so outputs are bit-identical to the serial implementation:
+// unique values in order of first occurrence.
+//
+// On return, `idx_vec` holds the final (remapped) index for every input
+// element and `first_occurrence` holds, for each unique value in output
+// order, the input position of its first occurrence.
+template <typename T, typename TIndex>
+void ParallelUnique(OpKernelContext* context,
+                    const typename TTypes<T>::ConstFlat& Tin,
+                    typename TTypes<TIndex>::Vec idx_vec,
+                    std::vector<TIndex>* first_occurrence) {
+  const int64_t N = static_cast<int64_t>(Tin.size());
+  auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+  const int num_partitions = std::min(worker_threads.num_threads, 16);
+  const int num_chunks = num_partitions;
+  const int64_t chunk_size = (N + num_chunks - 1) / num_chunks;
+
+  // Phase 1: in parallel over contiguous input chunks, bucket input positions
+  // by the hash of their value. Keeping chunks in order (and positions in
+  // order within a chunk) preserves first-occurrence order per partition.
+  std::vector<std::vector<std::vector<TIndex>>> buckets(
+      num_chunks, std::vector<std::vector<TIndex>>(num_partitions));
+  auto build_buckets = [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t c = chunk_begin; c < chunk_end; ++c) {
+      const int64_t begin = c * chunk_size;
+      const int64_t end = std::min(N, begin + chunk_size);
+      auto& chunk_buckets = buckets[c];
+      for (auto& bucket : chunk_buckets) {
+        bucket.reserve((end - begin) / num_partitions + 1);
+      }
+      for (int64_t i = begin; i < end; ++i) {
+        const size_t h = hash<T>{}(Tin(i));
+        chunk_buckets[h % num_partitions].push_back(static_cast<TIndex>(i));
+      }
+    }
+  };
+  Shard(worker_threads.num_threads, worker_threads.workers, num_chunks,
+        chunk_size * 20, build_buckets);
+
+  // Phase 2: in parallel over partitions, build a per-partition map and
+  // assign partition-local ids, recording the first occurrence of each
+  // distinct value. idx_vec entries are disjoint across partitions.
+  std::vector<std::vector<TIndex>> local_first(num_partitions);
+  auto build_tables = [&](int64_t partition_begin, int64_t partition_end) {
+    for (int64_t p = partition_begin; p < partition_end; ++p) {
+      int64_t partition_size = 0;
+      for (int c = 0; c < num_chunks; ++c) {
+        partition_size += buckets[c][p].size();
+      }
+      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+      uniq.reserve(2 * partition_size);
+      auto& first = local_first[p];
+      TIndex j = 0;
+      for (int c = 0; c < num_chunks; ++c) {
+        for (const TIndex i : buckets[c][p]) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            first.push_back(i);
+            ++j;
+          }
+        }
+      }
+    }
+  };
+  Shard(worker_threads.num_threads, worker_threads.workers, num_partitions,
+        chunk_size * 20, build_tables);
+
+  // Phase 3: merge. Order all distinct values by the input position of their
+  // first occurrence to recover the serial output order, and build the
+  // partition-local id -> global id translation.
+  struct FirstOccurrence {
+    TIndex pos;
+    int32_t partition;
+    TIndex local_id;
+  };
+  int64_t uniq_size = 0;
+  for (int p = 0; p < num_partitions; ++p) {
+    uniq_size += local_first[p].size();
+  }
+  std::vector<FirstOccurrence> merged;
+  merged.reserve(uniq_size);
+  for (int p = 0; p < num_partitions; ++p) {
+    for (size_t l = 0; l < local_first[p].size(); ++l) {
+      merged.push_back({local_first[p][l], p, static_cast<TIndex>(l)});
+    }
+  }
+  std::sort(merged.begin(), merged.end(),
+            [](const FirstOccurrence& a, const FirstOccurrence& b) {
+              return a.pos < b.pos;
+            });
+  std::vector<std::vector<TIndex>> global_id(num_partitions);
+  for (int p = 0; p < num_partitions; ++p) {
+    global_id[p].resize(local_first[p].size());
+  }
+  first_occurrence->resize(uniq_size);
+  for (int64_t g = 0; g < uniq_size; ++g) {
+    global_id[merged[g].partition][merged[g].local_id] =
+        static_cast<TIndex>(g);
+    (*first_occurrence)[g] = merged[g].pos;
+  }
+
+  // Phase 4: in parallel over partitions, rewrite the partition-local ids in
+  // idx_vec to global ids.
+  auto remap = [&](int64_t partition_begin, int64_t partition_end) {
+    for (int64_t p = partition_begin; p < partition_end; ++p) {
+      for (int c = 0; c < num_chunks; ++c) {
+        for (const TIndex i : buckets[c][p]) {
+          idx_vec(i) = global_id[p][idx_vec(i)];
+        }
+      }
+    }
+  };
+  Shard(worker_threads.num_threads, worker_threads.workers, num_partitions,
+        chunk_size * 4, remap);
+}
+
 // `UniqueOp` computes the unique elements in the input tensor.
 //
 // * `T` is the element type.
@@ -150,26 +279,45 @@ class UniqueOp : public OpKernel {
       auto Tin = input.flat<T>();
       const int64_t N = static_cast<int64_t>(Tin.size());
 
-      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      auto worker_threads =
+          *(context->device()->tensorflow_cpu_worker_threads());
+      if (N >= kParallelUniqueMinElements && worker_threads.num_threads > 1) {
+        std::vector<TIndex> first_occurrence;
+        ParallelUnique<T, TIndex>(context, Tin, idx_vec, &first_occurrence);
+
+        uniq_size = static_cast<int64_t>(first_occurrence.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
+
+        for (int64_t g = 0; g < uniq_size; ++g) {
+          Tout(g) = Tin(first_occurrence[g]);
+        }
+      } else {
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
         }
-      }
 
-      uniq_size = static_cast<int64_t>(uniq.size());
-      TensorShape output_shape(input.shape());
-      output_shape.set_dim(axis, uniq_size);
-      Tensor* output = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(0, output_shape, &output));
-      auto Tout = output->flat<T>();
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
 
-      for (const auto& it : uniq) {
-        Tout(it.second) = it.first;
+        for (const auto& it : uniq) {
+          Tout(it.second) = it.first;
+        }
       }
     } else {
       // General implementation when unique is run over multiple elements.
@@ -23,8 +23,11 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/where_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
+#include <vector>
+
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -36,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -93,10 +97,8 @@ struct Where<CPUDevice, DIMS, T, TIndex> {
     }
   }
 
-  EIGEN_ALWAYS_INLINE static Status Compute(
-      OpKernelContext* ctx, const CPUDevice& d,
-      typename TTypes<T, DIMS>::ConstTensor input,
-      typename TTypes<int64_t>::Matrix output, TIndex* found_true) {
+  EIGEN_ALWAYS_INLINE static Eigen::DSizes<TIndex, DIMS> RowMajorStrides(
+      typename TTypes<T, DIMS>::ConstTensor input) {
     Eigen::DSizes<Eigen::DenseIndex, DIMS> dims = input.dimensions();
     Eigen::DSizes<TIndex, DIMS> strides;
 
@@ -108,7 +110,14 @@ struct Where<CPUDevice, DIMS, T, TIndex> {
     for (int i = DIMS - 2; i >= 0; --i) {
       strides[i] = strides[i + 1] * dims[i + 1];
     }
+    return strides;
+  }
 
+  EIGEN_ALWAYS_INLINE static Status Compute(
+      OpKernelContext* ctx, const CPUDevice& d,
+      typename TTypes<T, DIMS>::ConstTensor input,
+      typename TTypes<int64_t>::Matrix output, TIndex* found_true) {
+    Eigen::DSizes<TIndex, DIMS> strides = RowMajorStrides(input);
     Eigen::DenseIndex output_size = output.dimension(0);
     for (Eigen::DenseIndex n = 0; n < input.size(); ++n) {
       if (input.data()[n] != T(0)) {
@@ -120,6 +129,28 @@ struct Where<CPUDevice, DIMS, T, TIndex> {
     }
     return OkStatus();
   }
+
+  // Writes the index rows for the true elements of input[begin, end),
+  // starting at output row `first_row` and never at or past `row_limit` (the
+  // rows that belong to later blocks).  Sets `*found_true` to the number of
+  // true elements seen, which only disagrees with the allotted rows if the
+  // input is mutated between the counting and compaction passes.
+  EIGEN_ALWAYS_INLINE static void ComputeBlock(
+      typename TTypes<T, DIMS>::ConstTensor input,
+      typename TTypes<int64_t>::Matrix output, TIndex begin, TIndex end,
+      TIndex first_row, TIndex row_limit, TIndex* found_true) {
+    Eigen::DSizes<TIndex, DIMS> strides = RowMajorStrides(input);
+    TIndex true_n = first_row;
+    for (TIndex n = begin; n < end; ++n) {
+      if (input.data()[n] != T(0)) {
+        if (true_n < row_limit) {
+          WriteIndexRowMajor(output, strides, true_n, n);
+        }
+        ++true_n;
+      }
+    }
+    *found_true = true_n - first_row;
+  }
 };
 
 }  // namespace functor
@@ -139,6 +170,22 @@ class WhereCPUOp : public OpKernel {
                               "creating costly copies from device."));
 
     const int input_dims = input.dims();
+    const int64_t num_elems = input.NumElements();
+
+    // For large inputs, count and compact in parallel: pass one counts the
+    // true elements of each block (a branch-free, vectorizable accumulation),
+    // and the prefix sums over the block counts give every block its own
+    // output range, so pass two writes index rows without any cross-thread
+    // coordination.
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    constexpr int64_t kMinBlockSize = 1 << 14;
+    const int64_t num_blocks =
+        std::min<int64_t>(worker_threads.num_threads,
+                          (num_elems + kMinBlockSize - 1) / kMinBlockSize);
+    if (num_blocks > 1 && input_dims >= 1 && input_dims <= 8) {
+      ComputeParallel(context, input, num_blocks);
+      return;
+    }
 
     int64_t num_true;
     TTypes<int64_t>::UnalignedScalar num_true_t(&num_true);
@@ -151,9 +198,6 @@ class WhereCPUOp : public OpKernel {
     Tensor* output = nullptr;
     OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
 
-    // TODO(ebrevdo): Replace single-threaded copy with a multithreaded block
-    // copy by getting block counts above instead of a global NumTrue, then
-    // having each block filled in separate threads below.
     int64_t found_true = 0;
 
 #define HANDLE_DIM(NDIM)                                                      \
@@ -191,6 +235,81 @@ class WhereCPUOp : public OpKernel {
   }
 
  private:
+  void ComputeParallel(OpKernelContext* context, const Tensor& input,
+                       int64_t num_blocks) {
+    const int input_dims = input.dims();
+    const int64_t num_elems = input.NumElements();
+    const int64_t block_size = (num_elems + num_blocks - 1) / num_blocks;
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    const T* flat = input.flat<T>().data();
+
+    // Pass one: per-block counts, turned into output row offsets.
+    std::vector<int64_t> block_offsets(num_blocks + 1, 0);
+    Shard(worker_threads.num_threads, worker_threads.workers, num_blocks,
+          block_size, [&](int64_t block_begin, int64_t block_end) {
+            for (int64_t b = block_begin; b < block_end; ++b) {
+              const int64_t begin = b * block_size;
+              const int64_t end = std::min(num_elems, begin + block_size);
+              block_offsets[b + 1] =
+                  functor::CountAccumulator<T>(flat + begin, flat + end);
+            }
+          });
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      block_offsets[b + 1] += block_offsets[b];
+    }
+    const int64_t num_true = block_offsets[num_blocks];
+
+    TensorShape output_shape({num_true, input_dims});
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape, &output));
+
+    // Pass two: each block compacts its true indices into its own row range.
+    std::vector<int64_t> found_per_block(num_blocks, 0);
+
+#define HANDLE_DIM(NDIM)                                                     \
+  case NDIM: {                                                               \
+    auto input_t = input.tensor<T, NDIM>();                                  \
+    auto output_t = output->matrix<int64_t>();                               \
+    Shard(worker_threads.num_threads, worker_threads.workers, num_blocks,    \
+          block_size, [&](int64_t block_begin, int64_t block_end) {          \
+            for (int64_t b = block_begin; b < block_end; ++b) {              \
+              const int64_t begin = b * block_size;                          \
+              const int64_t end = std::min(num_elems, begin + block_size);   \
+              functor::Where<CPUDevice, NDIM, T, int64_t>::ComputeBlock(     \
+                  input_t, output_t, begin, end, block_offsets[b],           \
+                  block_offsets[b + 1], &found_per_block[b]);                \
+            }                                                                \
+          });                                                                \
+  } break;
+
+    switch (input_dims) {
+      HANDLE_DIM(1);
+      HANDLE_DIM(2);
+      HANDLE_DIM(3);
+      HANDLE_DIM(4);
+      HANDLE_DIM(5);
+      HANDLE_DIM(6);
+      HANDLE_DIM(7);
+      HANDLE_DIM(8);
+
+      default:
+        OP_REQUIRES(context, false,
+                    errors::InvalidArgument(
+                        "WhereOp : Unhandled input dimensions: ", input_dims));
+    }
+#undef HANDLE_DIM
+
+    int64_t found_true = 0;
+    for (int64_t b = 0; b < num_blocks; ++b) found_true += found_per_block[b];
+    OP_REQUIRES(
+        context, found_true == num_true,
+        errors::InvalidArgument(
+            "WhereOp: Race condition between counting the number of true "
+            "elements and writing them.  When counting, saw ",
+            num_true, " elements; but when writing their indices, saw ",
+            found_true, " elements."));
+  }
+
   TF_DISALLOW_COPY_AND_ASSIGN(WhereCPUOp);
 };
 
@@ -26,6 +26,7 @@ limitations under the License.
 namespace tensorflow {
 namespace crc32c {
 // NOLINTBEGIN(misc-unused-using-decls)
+using tsl::crc32c::Combine;
 using tsl::crc32c::Extend;
 using tsl::crc32c::kMaskDelta;
 using tsl::crc32c::Mask;
@@ -264,6 +264,31 @@ string NcclManager::GenerateCommunicatorKey() {
   return string(nccl_id.internal, NCCL_UNIQUE_ID_BYTES);
 }
 
+Status NcclManager::InitCommunicator(
+    std::vector<std::unique_ptr<Participant>> participants,
+    const Context& context) {
+  if (static_cast<int>(participants.size()) != context.num_local_devices) {
+    return errors::Internal("InitCommunicator for ",
+                            context.num_local_devices,
+                            " local devices called with ",
+                            participants.size(), " participants");
+  }
+  // The collective is only used to carry the participants and communicator
+  // description into GetCommunicator; it never runs, so its type, data type
+  // and reduction op are irrelevant.
+  auto* collective =
+      new Collective(context.collective_key, DT_FLOAT, kAllReduce, ncclSum,
+                     context.num_local_devices, context.num_global_devices,
+                     context.communicator_key);
+  core::ScopedUnref collective_unref(collective);
+  if (!collective->status.ok()) {
+    return collective->status;
+  }
+  collective->participants = std::move(participants);
+  Communicator* communicator = nullptr;
+  return GetCommunicator(collective, &communicator);
+}
+
 Status NcclManager::GetCommunicator(NcclManager::Collective* collective,
                                     NcclManager::Communicator** communicator) {
   // Sort by device ID, executor, and global rank to make ordering of
@@ -346,6 +371,22 @@ Status NcclManager::GetCommunicator(NcclManager::Collective* collective,
   auto* env = Env::Default();
   std::set<NcclStream*> used_streams;
 
+#if !TENSORFLOW_USE_ROCM
+  // Claim the streams already assigned to existing communicators so that the
+  // new communicator gets its own streams, and with them its own launch
+  // queues and launcher threads.  Kernel-launch ordering only has to be
+  // consistent within a communicator, and dedicated streams let independent
+  // collectives running on different communicators proceed in parallel
+  // instead of serializing behind one launch queue.  On ROCm the
+  // communication stream is borrowed from the device context, so all
+  // communicators must keep sharing the single stream per device.
+  for (const auto& comm : communicators_) {
+    for (const CommunicatorMember& member : comm->members) {
+      used_streams.insert(member.nccl_stream);
+    }
+  }
+#endif
+
   // Create and initialize a new communicator.
   // Note that this is done under the lock; performance is not expected to
   // matter as this happens a very small number of times.
@@ -162,6 +162,29 @@ class NcclManager {
     int source_rank;
   };
 
+  // Eagerly creates and initializes the communicator connecting the devices
+  // of `participants`, including its communication streams and kernel launch
+  // threads.  `participants` must have one entry per device local to this
+  // node; only the device fields of each participant are used, so `input`,
+  // `output` and `done_callback` may be null.  `context` describes the
+  // communicator the same way it would for a collective (`source_rank` is
+  // ignored).
+  //
+  // Without this call, the communicator is built lazily when the first
+  // collective that needs it runs, which can add multi-second NCCL
+  // initialization stalls to the first step.  Setup code that knows the
+  // participating devices can call this to move that cost to startup.
+  // Calling this again, or running a collective, with the same devices (and
+  // `communicator_key`, for multi-node communicators) reuses the initialized
+  // communicator.
+  //
+  // For multi-node communicators every node has to call this concurrently
+  // with the shared `communicator_key`, since NCCL rank initialization
+  // blocks until all global ranks have joined.
+  Status InitCommunicator(
+      std::vector<std::unique_ptr<Participant>> participants,
+      const Context& context);
+
   // Adds one participant to an all-reduce.
   void AddToAllReduce(std::unique_ptr<Participant> participant,
                       const Context& context, ncclRedOp_t reduction_op);
@@ -248,8 +271,11 @@ class NcclManager {
   absl::flat_hash_map<string, Collective*> collectives_ TF_GUARDED_BY(mu_);
 
   // Maps a device to the communication streams that make up its collective.
-  // This is used to share the stream across different communicators that
-  // include the same device.
+  // On CUDA each communicator gets its own streams (and therefore its own
+  // launch queues and launcher threads), so that independent collectives
+  // running on different communicators do not serialize behind one another.
+  // On ROCm the communication stream is borrowed from the device context, so
+  // there is a single stream per device shared by all communicators.
   absl::flat_hash_map<se::StreamExecutor*, std::vector<NcclStream*>>
       device_to_comm_streams_ TF_GUARDED_BY(mu_);
 
@@ -494,6 +494,48 @@ TYPED_TEST(NcclManagerTest, BasicSumReduction) {
   }
 }
 
+// Test that communicators can be pre-constructed eagerly and are reused by
+// subsequent collectives on the same devices.
+TYPED_TEST(NcclManagerTest, InitCommunicator) {
+  const int num_ranks = this->NumGPUs();
+
+  std::vector<std::unique_ptr<NcclManager::Participant>> participants;
+  for (int rank = 0; rank < num_ranks; ++rank) {
+    auto* device = this->GetDevice(num_ranks, /*node=*/0, rank);
+    auto* info = device->tensorflow_accelerator_device_info();
+    participants.emplace_back(absl::make_unique<NcclManager::Participant>(
+        device->executor(), info->stream, info, /*input=*/nullptr,
+        /*output=*/nullptr, /*global_rank=*/-1, /*done_callback=*/nullptr));
+  }
+  TF_ASSERT_OK(NcclManager::instance()->InitCommunicator(
+      std::move(participants),
+      {"init_communicator", /*num_local_devices=*/num_ranks,
+       /*num_global_devices=*/num_ranks, /*communicator_key=*/"",
+       /*source_rank=*/-1}));
+
+  // A collective on the same devices reuses the initialized communicator.
+  std::unique_ptr<typename TestFixture::TestCase> test_case(
+      this->MakeReductionTestCase(/*num_nodes=*/1, num_ranks, ncclSum,
+                                  TensorShape({2, 3}), 0.0f));
+  for (int rank = 0; rank < num_ranks; ++rank) {
+    auto* device = this->GetDevice(num_ranks, /*node=*/0, rank);
+    auto* info = device->tensorflow_accelerator_device_info();
+    auto* stream = device->tensorflow_accelerator_device_info()->stream;
+    auto participant = absl::make_unique<NcclManager::Participant>(
+        device->executor(), stream, info, &test_case->ins[rank],
+        &test_case->outs[rank], /*global_rank=*/-1,
+        this->CreateDoneCallback(test_case.get()));
+    NcclManager::instance()->AddToAllReduce(
+        std::move(participant),
+        {"init_communicator_allreduce", /*num_local_devices=*/num_ranks,
+         /*num_global_devices=*/num_ranks, /*communicator_key=*/"",
+         /*source_rank=*/-1},
+        ncclSum);
+  }
+
+  this->VerifyResults(test_case.get());
+}
+
 // Same as the Basic test, but with multiple threads launching parts of many
 // reductions.
 //
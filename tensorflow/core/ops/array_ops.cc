@@ -1287,6 +1287,31 @@ REGISTER_OP("GatherNd")
     .Attr("Tindices: {int16, int32,int64}")
     .SetShapeFn(shape_inference::GatherNdShape);
 
+// --------------------------------------------------------------------------
+REGISTER_OP("MultiEmbeddingLookup")
+    .Input("params: N * T")
+    .Input("indices: N * Tindices")
+    .Output("outputs: N * T")
+    .Attr("N: int >= 1")
+    .Attr("T: {bfloat16, half, float, double}")
+    .Attr("Tindices: {int32, int64}")
+    .SetShapeFn([](InferenceContext* c) {
+      int32_t n;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+      for (int i = 0; i < n; ++i) {
+        ShapeHandle params_shape;
+        TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(i), 1, &params_shape));
+        ShapeHandle params_inner_subshape;
+        TF_RETURN_IF_ERROR(
+            c->Subshape(params_shape, 1, &params_inner_subshape));
+        ShapeHandle out;
+        TF_RETURN_IF_ERROR(
+            c->Concatenate(c->input(n + i), params_inner_subshape, &out));
+        c->set_output(i, out);
+      }
+      return OkStatus();
+    });
+
 // --------------------------------------------------------------------------
 REGISTER_OP("Identity")
     .Input("input: T")
@@ -305,6 +305,71 @@ REGISTER_OP("ResizeBilinear")
     .Attr("half_pixel_centers: bool = false")
     .SetShapeFn(ResizeShapeFn);
 
+// --------------------------------------------------------------------------
+REGISTER_OP("_FusedCropResizeNormalize")
+    .Input("images: T")
+    .Input("crop_window: int32")
+    .Input("size: int32")
+    .Input("mean: float")
+    .Input("scale: float")
+    .Output("output: float")
+    .Attr("T: {uint8, half, bfloat16, float, double}")
+    .Attr("align_corners: bool = false")
+    .Attr("half_pixel_centers: bool = false")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle input;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 4, &input));
+      ShapeHandle window;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &window));
+      DimensionHandle unused;
+      TF_RETURN_IF_ERROR(c->WithValue(c->Dim(window, 0), 4, &unused));
+      return SetOutputToSizedImage(c, c->Dim(input, 0), 2 /* size_input_idx */,
+                                   c->Dim(input, 3));
+    })
+    .Doc(R"doc(
+Crops, bilinearly resizes and normalizes a batch of images in one pass.
+
+`crop_window` is `[y, x, height, width]` in input pixel coordinates; the same
+window is taken from every image in the batch. The crop is resized to `size`
+(`[new_height, new_width]`) with bilinear interpolation, converting to float
+during the interpolation, and each channel value `v` is emitted as
+`(v - mean[c]) * scale[c]`. `mean` and `scale` are either scalars or vectors
+with one element per channel. No intermediate tensors are materialized.
+
+*NOTE*: Do not invoke this operator directly in Python. It is intended to be
+constructed by input-pipeline graph rewrites.
+)doc");
+
+// --------------------------------------------------------------------------
+REGISTER_OP("_FusedRandomFlipBrightness")
+    .Input("images: T")
+    .Input("seed: Tseed")
+    .Output("output: T")
+    .Attr("T: {half, bfloat16, float, double}")
+    .Attr("Tseed: {int32, int64}")
+    .Attr("max_delta: float = 0.0")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle input;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 4, &input));
+      ShapeHandle unused;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &unused));
+      c->set_output(0, input);
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Randomly flips and brightness-shifts a batch of images in a single pass.
+
+Each image in the batch is independently flipped left/right with probability
+1/2 and shifted by a brightness delta drawn uniformly from
+`[-max_delta, max_delta]`. The draws are stateless: they are produced by a
+Philox generator keyed by `seed` and indexed by the image's position in the
+batch, so no random mask or delta tensors are materialized and the same seed
+always yields the same augmentation.
+
+*NOTE*: Do not invoke this operator directly in Python. It is intended to be
+constructed by input-pipeline graph rewrites.
+)doc");
+
 // --------------------------------------------------------------------------
 REGISTER_OP("ScaleAndTranslate")
     .Input("images: T")
@@ -469,6 +534,40 @@ REGISTER_OP("DecodeJpeg")
     .Output("image: uint8")
     .SetShapeFn(DecodeImageShapeFn);
 
+// --------------------------------------------------------------------------
+REGISTER_OP("_DecodeJpegBatch")
+    .Input("contents: string")
+    .Attr("channels: int = 0")
+    .Attr("ratio: int = 1")
+    .Attr("fancy_upscaling: bool = true")
+    .Attr("try_recover_truncated: bool = false")
+    .Attr("acceptable_fraction: float = 1.0")
+    .Attr("dct_method: string = ''")
+    .Output("image: uint8")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle contents;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 1, &contents));
+      int32_t channels;
+      TF_RETURN_IF_ERROR(c->GetAttr("channels", &channels));
+      DimensionHandle channels_dim =
+          channels == 0 ? c->UnknownDim() : c->MakeDim(channels);
+      c->set_output(0,
+                    c->MakeShape({c->Dim(contents, 0), c->UnknownDim(),
+                                  c->UnknownDim(), channels_dim}));
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Decodes a batch of same-sized JPEG images into a uint8 tensor in parallel.
+
+Every element of `contents` must decode to the dimensions of the first one;
+the output is `[batch, height, width, channels]`. Images are distributed
+across the intra-op thread pool and decoded directly into the batched output.
+The attrs have the same meaning as in `DecodeJpeg`.
+
+*NOTE*: Do not invoke this operator directly in Python. It is intended to be
+constructed by input-pipeline graph rewrites.
+)doc");
+
 // --------------------------------------------------------------------------
 REGISTER_OP("DecodeAndCropJpeg")
     .Input("contents: string")
@@ -1015,6 +1015,31 @@ _FusedConv2D output.
 expected to create these operators.
 )doc");
 
+REGISTER_OP("_FusedCwiseChain")
+    .Input("x: T")
+    .Input("args: num_args * T")
+    .Output("y: T")
+    .Attr("T: {float, double}")
+    .Attr("num_args: int >= 0")
+    .Attr("fused_ops: list(string)")
+    .Attr("swapped_inputs: list(bool) = []")
+    .SetShapeFn(shape_inference::UnchangedShape)
+    .Doc(R"doc(
+Performs a chain of element-wise operations in a single pass over memory.
+
+`fused_ops` lists the names of the fused element-wise ops (e.g. "Sub", "Abs",
+"Relu"), performed in order. The chained value flows from `x` through every
+stage into `y`. Each binary stage consumes one scalar tensor from `args`, in
+order; unary stages consume no extra inputs. The i-th entry of `swapped_inputs`
+is true if the chained value is the *second* operand of the i-th stage (e.g.
+the chain computes `args[j] - value` rather than `value - args[j]`); entries
+for unary stages are ignored. When `swapped_inputs` is empty the chained value
+is the first operand of every stage.
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 // --------------------------------------------------------------------------
 
 // For operations where the output is a reduction function along some
@@ -337,6 +337,64 @@ expected to create these operators.
 )doc");
 // --------------------------------------------------------------------------
 
+REGISTER_OP("_FusedLayerNorm")
+    .Input("x: T")
+    .Input("scale: T")
+    .Input("offset: T")
+    .Output("y: T")
+    .Attr("T: {float, bfloat16}")
+    .Attr("epsilon: float = 0.001")
+    .SetShapeFn(shape_inference::UnchangedShape)
+    .Doc(R"doc(
+Internal fused LayerNorm operation: reserved for internal use.
+
+Normalizes `x` over its innermost dimension and applies the per-channel
+`scale` and `offset`. Do not invoke this operator directly in Python. A
+fusion optimization is expected to create these operators.
+)doc");
+
+REGISTER_OP("_FusedGelu")
+    .Input("x: T")
+    .Output("y: T")
+    .Attr("T: {float, bfloat16}")
+    .Attr("approximate: bool = false")
+    .SetShapeFn(shape_inference::UnchangedShape)
+    .Doc(R"doc(
+Internal fused Gelu operation: reserved for internal use.
+
+Do not invoke this operator directly in Python. A fusion optimization is
+expected to create these operators.
+)doc");
+
+REGISTER_OP("_FusedAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Output("output: T")
+    .Attr("T: {float, bfloat16}")
+    .Attr("scale: float = 1.0")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle query_shape;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 3, &query_shape));
+      ShapeHandle value_shape;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2), 3, &value_shape));
+      ShapeHandle prefix;
+      TF_RETURN_IF_ERROR(c->Subshape(query_shape, 0, -1, &prefix));
+      ShapeHandle output_shape;
+      TF_RETURN_IF_ERROR(c->Concatenate(
+          prefix, c->Vector(c->Dim(value_shape, -1)), &output_shape));
+      c->set_output(0, output_shape);
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Internal fused attention operation: reserved for internal use.
+
+Computes Softmax(scale * query x key^T) x value without materializing the
+full score matrix. Do not invoke this operator directly in Python. A fusion
+optimization is expected to create these operators.
+)doc");
+// --------------------------------------------------------------------------
+
 REGISTER_OP("BiasAdd")
     .Attr("T: numbertype")
     .Input("value: T")
@@ -1287,6 +1345,34 @@ REGISTER_OP("SparseSoftmaxCrossEntropyWithLogits")
       return OkStatus();
     });
 
+// Loss-only variant of SparseSoftmaxCrossEntropyWithLogits. The kernel
+// streams over each row of logits without materializing the backprop
+// (probability) matrix, so it is preferred when the gradient is unused.
+//
+// Internal op, reserved for internal use.
+//
+// Do not invoke this operator directly in Python. A fusion optimization is
+// expected to create these operators.
+REGISTER_OP("_SparseSoftmaxCrossEntropyLoss")
+    .Input("features: T")
+    .Input("labels: Tlabels")
+    .Output("loss: T")
+    .Attr("T: {half, bfloat16, float, double}")
+    .Attr("Tlabels: {int32, int64} = DT_INT64")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle features;
+      ShapeHandle labels;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 2, &features));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &labels));
+
+      DimensionHandle batch_size;
+      TF_RETURN_IF_ERROR(
+          c->Merge(c->Dim(features, 0), c->Dim(labels, 0), &batch_size));
+
+      c->set_output(0, c->Vector(batch_size));
+      return OkStatus();
+    });
+
 // --------------------------------------------------------------------------
 
 REGISTER_OP("InTopK")
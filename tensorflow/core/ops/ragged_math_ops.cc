@@ -23,6 +23,8 @@ using shape_inference::InferenceContext;
 using shape_inference::ShapeHandle;
 
 Status RaggedRangeShapeFn(InferenceContext* c);
+Status RaggedReduceShapeFn(InferenceContext* c);
+Status RaggedSoftmaxShapeFn(InferenceContext* c);
 
 //==============================================================================
 // Registered Ops
@@ -38,6 +40,30 @@ REGISTER_OP("RaggedRange")
     .Attr("Tsplits: {int32, int64} = DT_INT64")
     .SetShapeFn(RaggedRangeShapeFn);
 
+REGISTER_OP("RaggedReduceSum")
+    .Input("rt_nested_splits: Tsplits")
+    .Input("rt_dense_values: T")
+    .Output("output: T")
+    .Attr("T: {float, double, int32, int64}")
+    .Attr("Tsplits: {int32, int64} = DT_INT64")
+    .SetShapeFn(RaggedReduceShapeFn);
+
+REGISTER_OP("RaggedReduceMean")
+    .Input("rt_nested_splits: Tsplits")
+    .Input("rt_dense_values: T")
+    .Output("output: T")
+    .Attr("T: {float, double}")
+    .Attr("Tsplits: {int32, int64} = DT_INT64")
+    .SetShapeFn(RaggedReduceShapeFn);
+
+REGISTER_OP("RaggedSoftmax")
+    .Input("rt_nested_splits: Tsplits")
+    .Input("rt_dense_values: T")
+    .Output("output: T")
+    .Attr("T: {float, double}")
+    .Attr("Tsplits: {int32, int64} = DT_INT64")
+    .SetShapeFn(RaggedSoftmaxShapeFn);
+
 //==============================================================================
 // Shape Functions
 //==============================================================================
@@ -78,4 +104,38 @@ Status RaggedRangeShapeFn(InferenceContext* c) {
   return OkStatus();
 }
 
+Status RaggedReduceShapeFn(InferenceContext* c) {
+  // Check that rt_nested_splits is a vector and rt_dense_values has at least
+  // the ragged dimension.
+  ShapeHandle splits = c->input(0);
+  ShapeHandle values = c->input(1);
+  TF_RETURN_IF_ERROR(c->WithRank(splits, 1, &splits));
+  TF_RETURN_IF_ERROR(c->WithRankAtLeast(values, 1, &values));
+
+  // The output has one row per ragged row, followed by the inner dimensions
+  // of the values.
+  DimensionHandle nrows = c->UnknownDim();
+  DimensionHandle nsplits = c->Dim(splits, 0);
+  if (c->ValueKnown(nsplits)) {
+    nrows = c->MakeDim(c->Value(nsplits) - 1);
+  }
+  ShapeHandle inner_dims;
+  TF_RETURN_IF_ERROR(c->Subshape(values, 1, &inner_dims));
+  ShapeHandle output;
+  TF_RETURN_IF_ERROR(c->Concatenate(c->Vector(nrows), inner_dims, &output));
+  c->set_output(0, output);
+  return OkStatus();
+}
+
+Status RaggedSoftmaxShapeFn(InferenceContext* c) {
+  ShapeHandle splits = c->input(0);
+  ShapeHandle values = c->input(1);
+  TF_RETURN_IF_ERROR(c->WithRank(splits, 1, &splits));
+  TF_RETURN_IF_ERROR(c->WithRank(values, 1, &values));
+
+  // The output replaces each value with its in-row softmax.
+  c->set_output(0, values);
+  return OkStatus();
+}
+
 }  // namespace tensorflow
@@ -770,7 +770,7 @@ REGISTER_OP("ResourceSparseApplyKerasMomentum")
     .Attr("use_nesterov: bool = false")
     .SetShapeFn(ApplyMomentumShapeFn</*is_sparse=*/true, /*is_resource=*/true>);
 
-template <bool is_resource>
+template <bool is_sparse, bool is_resource>
 static Status ApplyAdamShapeFn(InferenceContext* c) {
   ShapeHandle unused;
   ShapeHandle s = ShapeOrHandleShape<is_resource>(c, 0);  // var
@@ -784,9 +784,8 @@ static Status ApplyAdamShapeFn(InferenceContext* c) {
   TF_RETURN_IF_ERROR(c->WithRank(c->input(6), 0, &unused));     // beta1
   TF_RETURN_IF_ERROR(c->WithRank(c->input(7), 0, &unused));     // beta2
   TF_RETURN_IF_ERROR(c->WithRank(c->input(8), 0, &unused));     // epsilon
-  TF_RETURN_IF_ERROR(
-      HandleGradAndIndicesInputs</*is_sparse=*/false, is_resource>(
-          c, 9 /* grad_idx */, &s));
+  TF_RETURN_IF_ERROR(HandleGradAndIndicesInputs<is_sparse, is_resource>(
+      c, 9 /* grad_idx */, &s));
   if (c->num_outputs() > 0) {
     c->set_output(0, s);
   }
@@ -808,7 +807,26 @@ REGISTER_OP("ApplyAdam")
     .Attr("T: numbertype")
     .Attr("use_locking: bool = false")
     .Attr("use_nesterov: bool = false")
-    .SetShapeFn(ApplyAdamShapeFn</*is_resource=*/false>);
+    .SetShapeFn(ApplyAdamShapeFn</*is_sparse=*/false, /*is_resource=*/false>);
+
+REGISTER_OP("SparseApplyAdam")
+    .Input("var: Ref(T)")
+    .Input("m: Ref(T)")
+    .Input("v: Ref(T)")
+    .Input("beta1_power: T")
+    .Input("beta2_power: T")
+    .Input("lr: T")
+    .Input("beta1: T")
+    .Input("beta2: T")
+    .Input("epsilon: T")
+    .Input("grad: T")
+    .Input("indices: Tindices")
+    .Output("out: Ref(T)")
+    .Attr("T: numbertype")
+    .Attr("Tindices: {int32, int64}")
+    .Attr("use_locking: bool = false")
+    .Attr("use_nesterov: bool = false")
+    .SetShapeFn(ApplyAdamShapeFn</*is_sparse=*/true, /*is_resource=*/false>);
 
 REGISTER_OP("ResourceApplyAdam")
     .Input("var: resource")
@@ -824,7 +842,25 @@ REGISTER_OP("ResourceApplyAdam")
     .Attr("T: numbertype")
     .Attr("use_locking: bool = false")
     .Attr("use_nesterov: bool = false")
-    .SetShapeFn(ApplyAdamShapeFn</*is_resource=*/true>);
+    .SetShapeFn(ApplyAdamShapeFn</*is_sparse=*/false, /*is_resource=*/true>);
+
+REGISTER_OP("ResourceSparseApplyAdam")
+    .Input("var: resource")
+    .Input("m: resource")
+    .Input("v: resource")
+    .Input("beta1_power: T")
+    .Input("beta2_power: T")
+    .Input("lr: T")
+    .Input("beta1: T")
+    .Input("beta2: T")
+    .Input("epsilon: T")
+    .Input("grad: T")
+    .Input("indices: Tindices")
+    .Attr("T: numbertype")
+    .Attr("Tindices: {int32, int64}")
+    .Attr("use_locking: bool = false")
+    .Attr("use_nesterov: bool = false")
+    .SetShapeFn(ApplyAdamShapeFn</*is_sparse=*/true, /*is_resource=*/true>);
 
 template <bool is_resource>
 static Status ApplyAdamWithAmsgradShapeFn(InferenceContext* c) {
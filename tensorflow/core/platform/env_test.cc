@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/platform/cord.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/null_file_system.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/protobuf.h"
@@ -92,6 +93,38 @@ TEST_F(DefaultEnvTest, IncompleteReadOutOfRange) {
   EXPECT_EQ(input, result);
 }
 
+TEST_F(DefaultEnvTest, ReadAsync) {
+  const string filename = io::JoinPath(BaseDir(), "read_async");
+  const string input = CreateTestFile(env_, filename, 4096);
+  std::unique_ptr<RandomAccessFile> f;
+  TF_EXPECT_OK(env_->NewRandomAccessFile(filename, &f));
+
+  std::vector<char> scratch(4096);
+  Status status;
+  StringPiece result;
+  Notification done;
+  f->ReadAsync(0, 4096, scratch.data(), [&](Status s, StringPiece r) {
+    status = std::move(s);
+    result = r;
+    done.Notify();
+  });
+  done.WaitForNotification();
+  TF_EXPECT_OK(status);
+  EXPECT_EQ(input, result);
+
+  // Reading past EOF should give an OUT_OF_RANGE error and the available
+  // prefix, matching the synchronous Read contract.
+  Notification eof_done;
+  f->ReadAsync(4000, 4096, scratch.data(), [&](Status s, StringPiece r) {
+    status = std::move(s);
+    result = r;
+    eof_done.Notify();
+  });
+  eof_done.WaitForNotification();
+  EXPECT_EQ(error::OUT_OF_RANGE, status.code());
+  EXPECT_EQ(input.substr(4000), result);
+}
+
 TEST_F(DefaultEnvTest, ReadFileToString) {
   for (const int length : {0, 1, 1212, 2553, 4928, 8196, 9000, (1 << 20) - 1,
                            1 << 20, (1 << 20) + 1, (256 << 20) + 100}) {
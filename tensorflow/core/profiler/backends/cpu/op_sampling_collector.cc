@@ -0,0 +1,139 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/common_runtime/op_sampling_profiler.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/profile_utils/cpu_utils.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/profiler_factory.h"
+#include "tensorflow/core/profiler/lib/profiler_interface.h"
+#include "tensorflow/core/profiler/profiler_options.pb.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/time_utils.h"
+#include "tensorflow/core/profiler/utils/xplane_builder.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+// Plane holding the aggregate per-op latency distribution sampled by
+// OpSamplingProfiler between Start() and Stop().
+constexpr absl::string_view kOpSamplesPlaneName = "/host:op_samples";
+
+// Exports the deltas of the OpSamplingProfiler's cumulative per-op table over
+// a profiling session as one XLine, with one XEvent per op whose duration is
+// the op's estimated total CPU time in the session.  Laying the ops out
+// back-to-back, most expensive first, renders as a width-proportional
+// flamegraph row in the trace viewer; sample_count and op_type are attached
+// as stats for the op profile tools.
+//
+// Thread-safety: This class is go/thread-compatible.
+class OpSamplingCollector : public ProfilerInterface {
+ public:
+  OpSamplingCollector() = default;
+
+  Status Start() override {
+    start_timestamp_ns_ = GetCurrentTimeNanos();
+    baseline_.clear();
+    for (OpSamplingProfiler::OpStats& stats :
+         OpSamplingProfiler::Get()->Snapshot()) {
+      baseline_[std::make_pair(std::move(stats.op_name),
+                               std::move(stats.op_type))] =
+          std::make_pair(stats.count, stats.total_cycles);
+    }
+    return OkStatus();
+  }
+
+  Status Stop() override {
+    final_ = OpSamplingProfiler::Get()->Snapshot();
+    return OkStatus();
+  }
+
+  Status CollectData(XSpace* space) override {
+    if (final_.empty()) return OkStatus();
+    XPlaneBuilder plane(
+        FindOrAddMutablePlaneWithName(space, kOpSamplesPlaneName));
+    XLineBuilder line = plane.GetOrCreateLine(0);
+    line.SetName("sampled op latency (aggregate)");
+    line.SetTimestampNs(start_timestamp_ns_);
+    const XStatMetadata* sample_count_stat =
+        plane.GetOrCreateStatMetadata("sample_count");
+    const XStatMetadata* op_type_stat =
+        plane.GetOrCreateStatMetadata("op_type");
+    const int64_t sample_rate = OpSamplingProfiler::Get()->sample_rate();
+    uint64 offset_ps = 0;
+    for (const OpSamplingProfiler::OpStats& stats : final_) {
+      uint64 count = stats.count;
+      uint64 total_cycles = stats.total_cycles;
+      auto it = baseline_.find(std::make_pair(stats.op_name, stats.op_type));
+      if (it != baseline_.end()) {
+        count -= it->second.first;
+        total_cycles -= it->second.second;
+      }
+      if (count == 0) continue;
+      // Each sample stands in for sample_rate invocations.
+      const double total_ns =
+          std::chrono::duration<double, std::nano>(
+              profile_utils::CpuUtils::ConvertClockCycleToTime(
+                  static_cast<int64_t>(total_cycles)))
+              .count() *
+          sample_rate;
+      XEventBuilder event =
+          line.AddEvent(*plane.GetOrCreateEventMetadata(stats.op_name));
+      event.SetOffsetPs(offset_ps);
+      event.SetDurationNs(static_cast<int64_t>(total_ns));
+      event.AddStatValue(*sample_count_stat, count);
+      event.AddStatValue(*op_type_stat, stats.op_type);
+      offset_ps += static_cast<uint64>(total_ns * 1000.0);
+    }
+    baseline_.clear();
+    final_.clear();
+    return OkStatus();
+  }
+
+ private:
+  int64_t start_timestamp_ns_ = 0;
+  // {op name, op type} -> {count, total cycles} at Start() time.
+  absl::flat_hash_map<std::pair<string, string>, std::pair<uint64, uint64>>
+      baseline_;
+  std::vector<OpSamplingProfiler::OpStats> final_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(OpSamplingCollector);
+};
+
+std::unique_ptr<ProfilerInterface> CreateOpSamplingCollector(
+    const ProfileOptions& options) {
+  if (OpSamplingProfiler::Get() == nullptr) return nullptr;
+  return std::make_unique<OpSamplingCollector>();
+}
+
+}  // namespace
+
+auto register_op_sampling_collector_factory = [] {
+  RegisterProfilerFactory(&CreateOpSamplingCollector);
+  return 0;
+}();
+
+}  // namespace profiler
+}  // namespace tensorflow
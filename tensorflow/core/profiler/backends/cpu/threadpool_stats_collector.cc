@@ -0,0 +1,150 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/threadpool.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/profiler_factory.h"
+#include "tensorflow/core/profiler/lib/profiler_interface.h"
+#include "tensorflow/core/profiler/profiler_options.pb.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+#include "tensorflow/core/profiler/utils/math_utils.h"
+#include "tensorflow/core/profiler/utils/time_utils.h"
+#include "tensorflow/core/profiler/utils/xplane_builder.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+// Plane holding per-pool ThreadPool scheduling statistics collected between
+// Start() and Stop().
+constexpr absl::string_view kThreadPoolStatsPlaneName = "/host:threadpools";
+
+using PoolStats = tsl::thread::ThreadPool::Stats;
+
+// Exports the deltas of each live ThreadPool's scheduling counters over a
+// profiling session as one XEvent per pool, with the counters attached as
+// stats. The event duration is the pool's total task run time in the
+// session, so pools dominating worker CPU time stand out in the trace
+// viewer; queue depth and queueing delay distinguish pool starvation (deep
+// queues, high schedule-to-start latency) from slow kernels (long run times
+// on a shallow queue).
+//
+// Only active when TF_THREADPOOL_STATS is set; the underlying counters are
+// off by default because they add a timestamp read and a few atomic updates
+// to every scheduled task.
+//
+// Thread-safety: This class is go/thread-compatible.
+class ThreadPoolStatsCollector : public ProfilerInterface {
+ public:
+  ThreadPoolStatsCollector() = default;
+
+  Status Start() override {
+    start_timestamp_ns_ = GetCurrentTimeNanos();
+    baseline_.clear();
+    for (std::pair<std::string, PoolStats>& pool :
+         tsl::thread::ThreadPool::AllPoolStats()) {
+      baseline_[std::move(pool.first)] = pool.second;
+    }
+    return OkStatus();
+  }
+
+  Status Stop() override {
+    final_ = tsl::thread::ThreadPool::AllPoolStats();
+    return OkStatus();
+  }
+
+  Status CollectData(XSpace* space) override {
+    if (final_.empty()) return OkStatus();
+    XPlaneBuilder plane(
+        FindOrAddMutablePlaneWithName(space, kThreadPoolStatsPlaneName));
+    XLineBuilder line = plane.GetOrCreateLine(0);
+    line.SetName("threadpool scheduling stats");
+    line.SetTimestampNs(start_timestamp_ns_);
+    const XStatMetadata* tasks_scheduled_stat =
+        plane.GetOrCreateStatMetadata("tasks_scheduled");
+    const XStatMetadata* tasks_started_stat =
+        plane.GetOrCreateStatMetadata("tasks_started");
+    const XStatMetadata* queue_depth_stat =
+        plane.GetOrCreateStatMetadata("queue_depth");
+    const XStatMetadata* max_queue_depth_stat =
+        plane.GetOrCreateStatMetadata("max_queue_depth");
+    const XStatMetadata* queue_time_us_stat =
+        plane.GetOrCreateStatMetadata("queue_time_us");
+    const XStatMetadata* run_time_us_stat =
+        plane.GetOrCreateStatMetadata("run_time_us");
+    uint64 offset_ps = 0;
+    for (const std::pair<std::string, PoolStats>& pool : final_) {
+      PoolStats stats = pool.second;
+      auto it = baseline_.find(pool.first);
+      if (it != baseline_.end()) {
+        // Cumulative counters become session deltas; queue_depth and
+        // max_queue_depth are reported as observed at Stop().
+        stats.tasks_scheduled -= it->second.tasks_scheduled;
+        stats.tasks_started -= it->second.tasks_started;
+        stats.queue_time_ns -= it->second.queue_time_ns;
+        stats.run_time_ns -= it->second.run_time_ns;
+      }
+      if (stats.tasks_scheduled == 0 && stats.queue_depth == 0) continue;
+      XEventBuilder event =
+          line.AddEvent(*plane.GetOrCreateEventMetadata(pool.first));
+      event.SetOffsetPs(offset_ps);
+      event.SetDurationNs(stats.run_time_ns);
+      event.AddStatValue(*tasks_scheduled_stat, stats.tasks_scheduled);
+      event.AddStatValue(*tasks_started_stat, stats.tasks_started);
+      event.AddStatValue(*queue_depth_stat, stats.queue_depth);
+      event.AddStatValue(*max_queue_depth_stat, stats.max_queue_depth);
+      event.AddStatValue(*queue_time_us_stat,
+                         NanoToMicro(stats.queue_time_ns));
+      event.AddStatValue(*run_time_us_stat, NanoToMicro(stats.run_time_ns));
+      offset_ps += NanoToPico(stats.run_time_ns);
+    }
+    baseline_.clear();
+    final_.clear();
+    return OkStatus();
+  }
+
+ private:
+  int64_t start_timestamp_ns_ = 0;
+  // Pool name -> cumulative stats at Start() time.
+  absl::flat_hash_map<std::string, PoolStats> baseline_;
+  std::vector<std::pair<std::string, PoolStats>> final_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(ThreadPoolStatsCollector);
+};
+
+std::unique_ptr<ProfilerInterface> CreateThreadPoolStatsCollector(
+    const ProfileOptions& options) {
+  if (!tsl::thread::ThreadPool::StatsEnabled()) return nullptr;
+  return std::make_unique<ThreadPoolStatsCollector>();
+}
+
+}  // namespace
+
+auto register_threadpool_stats_collector_factory = [] {
+  RegisterProfilerFactory(&CreateThreadPoolStatsCollector);
+  return 0;
+}();
+
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,186 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/continuous_profiler.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/profiler/lib/profiler_session.h"
+#include "tensorflow/core/profiler/profiler_options.pb.h"
+#include "tensorflow/core/profiler/utils/math_utils.h"
+#include "tensorflow/core/profiler/utils/time_utils.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+// Length of each capture chunk. Short enough that eviction keeps the buffer
+// close to the requested window and that a snapshot misses at most this much
+// of the most recent activity, long enough that per-session start/stop
+// overhead stays negligible.
+constexpr int64_t kChunkDurationMs = 1000;
+
+// How long to wait before retrying when a chunk session fails to start, e.g.
+// because an on-demand session grabbed the profiler lock first.
+constexpr int64_t kRetryDelayMs = 10 * 1000;
+
+ProfileOptions ContinuousOptions() {
+  ProfileOptions options = ProfilerSession::DefaultOptions();
+  // Host tracer only: device tracing is too expensive to leave always on.
+  options.set_device_tracer_level(0);
+  options.set_host_tracer_level(1);
+  options.set_python_tracer_level(0);
+  options.set_enable_hlo_proto(false);
+  return options;
+}
+
+}  // namespace
+
+/*static*/ ContinuousProfiler* ContinuousProfiler::Get() {
+  static ContinuousProfiler* singleton = new ContinuousProfiler();
+  return singleton;
+}
+
+/*static*/ int64_t ContinuousProfiler::WindowSecondsFromEnv() {
+  int64_t window_secs = 0;
+  Status status = ReadInt64FromEnvVar("TF_PROFILER_CONTINUOUS_WINDOW_SECS",
+                                      /*default_val=*/0, &window_secs);
+  if (!status.ok() || window_secs < 0) return 0;
+  return window_secs;
+}
+
+Status ContinuousProfiler::Start(int64_t window_secs) {
+  if (window_secs <= 0) {
+    return errors::InvalidArgument("Continuous profiling window must be > 0");
+  }
+  mutex_lock lock(mu_);
+  if (active_) {
+    return errors::AlreadyExists("Continuous profiling is already active");
+  }
+  active_ = true;
+  stop_requested_ = false;
+  window_secs_ = window_secs;
+  thread_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "continuous_profiler", [this]() { CaptureLoop(); }));
+  LOG(INFO) << "Continuous profiling started, retaining the last "
+            << window_secs << " seconds of trace data.";
+  return OkStatus();
+}
+
+void ContinuousProfiler::Stop() {
+  std::unique_ptr<Thread> thread;
+  {
+    mutex_lock lock(mu_);
+    if (!active_) return;
+    stop_requested_ = true;
+    stop_cv_.notify_all();
+    thread = std::move(thread_);
+  }
+  thread.reset();  // Joins the capture thread.
+  mutex_lock lock(mu_);
+  active_ = false;
+  chunks_.clear();
+  LOG(INFO) << "Continuous profiling stopped.";
+}
+
+bool ContinuousProfiler::IsActive() {
+  mutex_lock lock(mu_);
+  return active_;
+}
+
+Status ContinuousProfiler::Snapshot(uint64 duration_ms, XSpace* space) {
+  mutex_lock lock(mu_);
+  if (!active_) {
+    return errors::FailedPrecondition("Continuous profiling is not active");
+  }
+  uint64 cutoff_ns = 0;
+  if (duration_ms > 0) {
+    uint64 now_ns = GetCurrentTimeNanos();
+    uint64 duration_ns = MilliToNano(duration_ms);
+    cutoff_ns = now_ns > duration_ns ? now_ns - duration_ns : 0;
+  }
+  for (const Chunk& chunk : chunks_) {
+    if (chunk.end_time_ns < cutoff_ns) continue;
+    for (const XPlane& plane : chunk.xspace.planes()) {
+      MergePlanes(plane, FindOrAddMutablePlaneWithName(space, plane.name()));
+    }
+    for (const std::string& error : chunk.xspace.errors()) {
+      space->add_errors(error);
+    }
+    for (const std::string& warning : chunk.xspace.warnings()) {
+      space->add_warnings(warning);
+    }
+  }
+  return OkStatus();
+}
+
+void ContinuousProfiler::CaptureLoop() {
+  while (true) {
+    {
+      mutex_lock lock(mu_);
+      if (stop_requested_) return;
+    }
+    std::unique_ptr<ProfilerSession> session =
+        ProfilerSession::Create(ContinuousOptions());
+    Status status = session->Status();
+    if (!status.ok()) {
+      LOG_EVERY_N(WARNING, 60)
+          << "Continuous profiling chunk failed to start: " << status;
+      session.reset();
+      mutex_lock lock(mu_);
+      if (stop_requested_) return;
+      WaitForMilliseconds(&lock, &stop_cv_, kRetryDelayMs);
+      continue;
+    }
+
+    Chunk chunk;
+    chunk.start_time_ns = GetCurrentTimeNanos();
+    {
+      mutex_lock lock(mu_);
+      if (!stop_requested_) {
+        WaitForMilliseconds(&lock, &stop_cv_, kChunkDurationMs);
+      }
+    }
+    status = session->CollectData(&chunk.xspace);
+    chunk.end_time_ns = GetCurrentTimeNanos();
+    session.reset();
+    if (!status.ok()) {
+      LOG_EVERY_N(WARNING, 60)
+          << "Continuous profiling chunk collection failed: " << status;
+      continue;
+    }
+
+    mutex_lock lock(mu_);
+    uint64 window_ns = MilliToNano(window_secs_ * 1000);
+    chunks_.push_back(std::move(chunk));
+    uint64 horizon_ns = chunks_.back().end_time_ns > window_ns
+                            ? chunks_.back().end_time_ns - window_ns
+                            : 0;
+    while (!chunks_.empty() && chunks_.front().end_time_ns < horizon_ns) {
+      chunks_.pop_front();
+    }
+    if (stop_requested_) return;
+  }
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,101 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
+#define TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
+
+#include <deque>
+#include <memory>
+
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+
+namespace tensorflow {
+namespace profiler {
+
+// Always-on profiling with a bounded in-memory history.
+//
+// While active, a background thread captures short fixed-length trace chunks
+// back to back and keeps the most recent ones in a ring buffer covering a
+// configurable time window. When something interesting happens (e.g. an SLO
+// violation is detected), the trace leading up to it can be extracted after
+// the fact with Snapshot(), instead of re-running the workload under an
+// on-demand profiler session and hoping the problem reproduces.
+//
+// Capture is host-tracer only to keep the steady-state overhead low; device
+// tracing typically costs too much to leave enabled indefinitely. Since each
+// chunk is a regular ProfilerSession, continuous mode owns the global
+// profiler lock while active and is mutually exclusive with on-demand
+// profiling; the profiler service serves Profile requests from the ring
+// buffer instead while continuous mode is on.
+//
+// Enabled by setting TF_PROFILER_CONTINUOUS_WINDOW_SECS to the number of
+// seconds of history to retain; the profiler server starts capture
+// automatically at startup when the variable is set.
+//
+// Thread-safety: all public methods are thread-safe.
+class ContinuousProfiler {
+ public:
+  static ContinuousProfiler* Get();
+
+  // Returns the retention window requested via
+  // TF_PROFILER_CONTINUOUS_WINDOW_SECS, or 0 if unset or invalid.
+  static int64_t WindowSecondsFromEnv();
+
+  // Starts background capture retaining the last `window_secs` seconds of
+  // trace data. Returns an error if capture is already active.
+  Status Start(int64_t window_secs);
+
+  // Stops background capture and discards the buffered history.
+  void Stop();
+
+  // Whether background capture is currently active.
+  bool IsActive();
+
+  // Fills `space` with the buffered trace chunks overlapping the last
+  // `duration_ms` milliseconds (all buffered chunks if `duration_ms` is 0).
+  // Returns an error if capture is not active.
+  Status Snapshot(uint64 duration_ms, XSpace* space);
+
+ private:
+  ContinuousProfiler() = default;
+
+  // A single captured trace chunk and the interval it covers.
+  struct Chunk {
+    uint64 start_time_ns;
+    uint64 end_time_ns;
+    XSpace xspace;
+  };
+
+  // Body of the capture thread: runs back-to-back chunk sessions until
+  // stopped, appending each chunk and evicting those older than the window.
+  void CaptureLoop();
+
+  mutex mu_;
+  condition_variable stop_cv_;
+  bool active_ TF_GUARDED_BY(mu_) = false;
+  bool stop_requested_ TF_GUARDED_BY(mu_) = false;
+  int64_t window_secs_ TF_GUARDED_BY(mu_) = 0;
+  std::deque<Chunk> chunks_ TF_GUARDED_BY(mu_);
+  std::unique_ptr<Thread> thread_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
@@ -21,7 +21,9 @@ limitations under the License.
 #include "grpcpp/grpcpp.h"
 #include "absl/strings/str_cat.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/continuous_profiler.h"
 #include "tensorflow/core/profiler/profiler_service.grpc.pb.h"
 #include "tensorflow/core/profiler/rpc/profiler_service_impl.h"
 
@@ -46,6 +48,16 @@ void ProfilerServer::StartProfilerServer(int32_t port) {
     LOG(INFO) << "Profiler server listening on " << server_address
               << " selected port:" << selected_port;
   }
+
+  // When a retention window is configured, capture continuously so that
+  // Profile requests can be served from the ring buffer after the fact.
+  int64_t window_secs = ContinuousProfiler::WindowSecondsFromEnv();
+  if (window_secs > 0) {
+    Status status = ContinuousProfiler::Get()->Start(window_secs);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to start continuous profiling: " << status;
+    }
+  }
 }
 
 ProfilerServer::~ProfilerServer() {
@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/profiler/lib/continuous_profiler.h"
 #include "tensorflow/core/profiler/lib/profiler_session.h"
 #include "tensorflow/core/profiler/profiler_service.grpc.pb.h"
 #include "tensorflow/core/profiler/profiler_service.pb.h"
@@ -57,6 +58,22 @@ Status CollectDataToRepository(const ProfileRequest& request,
                     request.host_name(), xspace);
 }
 
+// Serves a profile request from the continuous profiling ring buffer: the
+// response covers the last duration_ms of already-captured data instead of
+// the next duration_ms.
+Status CollectSnapshotToRepository(const ProfileRequest& request,
+                                   ProfileResponse* response) {
+  response->set_empty_trace(true);
+  XSpace xspace;
+  TF_RETURN_IF_ERROR(ContinuousProfiler::Get()->Snapshot(
+      request.opts().duration_ms(), &xspace));
+  VLOG(3) << "Collected continuous profiling snapshot to repository.";
+  response->set_empty_trace(IsEmpty(xspace));
+
+  return SaveXSpace(request.repository_root(), request.session_id(),
+                    request.host_name(), xspace);
+}
+
 class ProfilerServiceImpl : public grpc::ProfilerService::Service {
  public:
   ::grpc::Status Monitor(::grpc::ServerContext* ctx, const MonitorRequest* req,
@@ -67,6 +84,17 @@ class ProfilerServiceImpl : public grpc::ProfilerService::Service {
   ::grpc::Status Profile(::grpc::ServerContext* ctx, const ProfileRequest* req,
                          ProfileResponse* response) override {
     VLOG(1) << "Received a profile request: " << req->DebugString();
+    // While continuous profiling is active it holds the profiler lock, so an
+    // on-demand session could not start anyway; serve the request from the
+    // ring buffer instead.
+    if (ContinuousProfiler::Get()->IsActive()) {
+      Status status = CollectSnapshotToRepository(*req, response);
+      if (!status.ok()) {
+        return ::grpc::Status(::grpc::StatusCode::INTERNAL,
+                              status.error_message());
+      }
+      return ::grpc::Status::OK;
+    }
     std::unique_ptr<ProfilerSession> profiler =
         ProfilerSession::Create(req->opts());
     Status status = profiler->Status();
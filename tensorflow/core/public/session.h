@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_PUBLIC_SESSION_H_
 #define TENSORFLOW_CORE_PUBLIC_SESSION_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -212,6 +213,35 @@ class Session {
       const std::vector<std::string>& output_names,
       std::vector<Tensor>* outputs);
 
+  /// \brief Prebuilds the execution state (pruned graphs, executors and their
+  /// kernels) for the subgraph described by `input_names`, `output_names` and
+  /// `target_nodes`, without running a step. A later `Run` with the same
+  /// signature reuses the prebuilt state, so kernel instantiation cost is
+  /// paid here instead of on the first step.
+  /// NOTE: This API is still experimental and may change.
+  virtual Status WarmupSignature(const std::vector<std::string>& input_names,
+                                 const std::vector<std::string>& output_names,
+                                 const std::vector<std::string>& target_nodes) {
+    return errors::Unimplemented(
+        "WarmupSignature is not supported for this session.");
+  }
+
+  /// \brief Creates a new session that shares this session's immutable
+  /// graph-level state.
+  ///
+  /// The clone reuses the placed and pre-optimized graph of this session,
+  /// skipping the setup work that `Create()` performs, but builds its own
+  /// executors and owns its own stateful resources (variables, iterators,
+  /// ...). This makes clones cheap to create while isolating them from this
+  /// session at run time, e.g. for per-tenant serving.
+  ///
+  /// REQUIRES: `Create()` has been called on this session, and this session
+  /// outlives the clone.
+  /// NOTE: This API is still experimental and may change.
+  virtual Status Clone(std::unique_ptr<Session>* out_clone) {
+    return errors::Unimplemented("Clone is not supported for this session.");
+  }
+
   /// \brief List devices in the session.
   ///
   /// Retrieves the list of available devices within the session, and populates
@@ -86,6 +86,8 @@ std::ostream& operator<<(std::ostream& os,
             << ", enable_grappler_function_optimizer = "
             << options.enable_grappler_function_optimizer
             << ", enable_tfrt_gpu = " << options.enable_tfrt_gpu
+            << ", enable_online_cost_analysis = "
+            << options.enable_online_cost_analysis
             << ", runtime = " << options.runtime
             << ", model_metadata = " << options.model_metadata.DebugString()
             << ", compile_options = " << options.compile_options << "}";
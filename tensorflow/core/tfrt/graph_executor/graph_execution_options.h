@@ -44,6 +44,15 @@ struct GraphExecutionOptions {
   // Whether to enable TFRT GPU.
   bool enable_tfrt_gpu = false;
 
+  // If true, the kernel costs of a client graph are measured during its first
+  // execution, and the graph is then recompiled with the measured costs so
+  // that the compiler's stream assignment balances concurrent streams using
+  // real costs instead of tensor-size heuristics. The measured costs are
+  // handed to the compiler through the file named by the
+  // TF_TFRT_MEASURED_COST_PATH environment variable; if the variable is not
+  // set, a temporary file is used.
+  bool enable_online_cost_analysis = false;
+
   // Runtime configuration. Refer to tensorflow::tfrt_stub::Runtime class for
   // more details. It must not be nullptr;
   const tensorflow::tfrt_stub::Runtime* runtime = nullptr;
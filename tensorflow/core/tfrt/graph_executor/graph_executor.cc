@@ -17,6 +17,7 @@ limitations under the License.
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -46,7 +47,9 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/runtime_fallback/kernel/kernel_fallback_execute_compat.h"
+#include "tensorflow/core/tfrt/fallback/cost_recorder.h"
 #include "tensorflow/core/tfrt/fallback/fallback_state.h"
 #include "tensorflow/core/tfrt/graph_executor/graph_execution_options.h"
 #include "tensorflow/core/tfrt/runtime/runtime.h"
@@ -399,13 +402,34 @@ tensorflow::Status GraphExecutor::Run(
     flat_inputs.push_back(inputs.at(original_index).second);
   }
 
+  // The first execution of a client graph records kernel costs when online
+  // cost analysis is enabled, so that the graph can be recompiled with the
+  // measured costs below.
+  RunOptions adjusted_run_options = run_options;
+  const bool run_cost_analysis =
+      options_.enable_online_cost_analysis &&
+      !loaded_client_graph.online_cost_analysis_done.load(
+          std::memory_order_relaxed);
+  if (run_cost_analysis) adjusted_run_options.enable_cost_measurement = true;
+
   std::vector<tensorflow::Tensor> flat_outputs;
   TF_RETURN_IF_ERROR(GraphExecutionRunOnFunction(
-      options_, run_options, loaded_client_graph.name, *func, flat_inputs,
+      options_, adjusted_run_options, loaded_client_graph.name, *func,
+      flat_inputs,
       /*captures=*/{}, &flat_outputs,
       loaded_client_graph.resource_context.get(), runtime(), fallback_state_,
       req_deadline_tracker_));
 
+  if (run_cost_analysis) {
+    bool expected = false;
+    if (loaded_client_graph.online_cost_analysis_done.compare_exchange_strong(
+            expected, true)) {
+      TF_RETURN_IF_ERROR(OnlineCostAnalysis(
+          sorted_input_names, sorted_input_dtypes, sorted_output_names,
+          sorted_target_node_names, loaded_client_graph.name));
+    }
+  }
+
   // Create the outputs from the actual function results, which are sorted
   // according to the output tensor names.
   auto flat_output_iter = flat_outputs.begin();
@@ -606,6 +630,59 @@ GraphExecutor::GetOrCreateLoadedClientGraph(
   return {*loaded_client_graph_ptr};
 }
 
+tensorflow::Status GraphExecutor::OnlineCostAnalysis(
+    absl::Span<const std::string> input_tensor_names,
+    absl::Span<const tensorflow::DataType> input_tensor_dtypes,
+    absl::Span<const std::string> output_tensor_names,
+    absl::Span<const std::string> target_tensor_names,
+    absl::string_view joined_name) {
+  auto* host = runtime().core_runtime()->GetHostContext();
+  auto& cost_recorder = host->GetOrCreateSharedContext<CostRecorder>();
+  // Nothing was measured, e.g. the graph contains no fallback kernels, so
+  // recompiling would not change the stream assignment.
+  if (cost_recorder.size() == 0) return OkStatus();
+
+  // The compiler reads the measured costs from the file named by
+  // TF_TFRT_MEASURED_COST_PATH, so point it at a temporary file when the
+  // caller has not configured one.
+  if (getenv("TF_TFRT_MEASURED_COST_PATH") == nullptr) {
+    std::string temp_file;
+    if (!tensorflow::Env::Default()->LocalTempFilename(&temp_file)) {
+      return tensorflow::errors::Internal(
+          "Failed to create a temporary file for measured costs.");
+    }
+    tensorflow::setenv("TF_TFRT_MEASURED_COST_PATH", temp_file.c_str(),
+                       /*overwrite=*/0);
+  }
+  TF_RETURN_IF_ERROR(cost_recorder.WriteToFile());
+
+  // Reload the client graph; the compiler picks up the measured costs and
+  // rebalances its stream assignment with them.
+  tensorflow::GraphImportConfig::InputArrays input_nodes;
+  DCHECK_EQ(input_tensor_names.size(), input_tensor_dtypes.size());
+  for (int i = 0; i < input_tensor_names.size(); ++i) {
+    tensorflow::ArrayInfo array_info;
+    array_info.imported_dtype = input_tensor_dtypes[i];
+    array_info.shape.set_unknown_rank(true);
+    input_nodes[input_tensor_names[i]] = array_info;
+  }
+  ClientGraph client_graph{
+      std::string(joined_name),
+      std::move(input_nodes),
+      {output_tensor_names.begin(), output_tensor_names.end()},
+      {target_tensor_names.begin(), target_tensor_names.end()}};
+  TF_ASSIGN_OR_RETURN(auto loaded_client_graph,
+                      LoadClientGraph(client_graph, /*work_queue=*/nullptr));
+  loaded_client_graph->online_cost_analysis_done.store(
+      true, std::memory_order_relaxed);
+
+  tensorflow::mutex_lock l(loaded_client_graphs_mu_);
+  auto& cache_entry = loaded_client_graphs_[client_graph.name];
+  if (cache_entry) retired_client_graphs_.push_back(std::move(cache_entry));
+  cache_entry = std::move(loaded_client_graph);
+  return OkStatus();
+}
+
 tensorflow::Status GraphExecutor::RunWithSyncInterpreter(
     const std::string& graph_name, absl::Span<tfrt::Value*> input_values,
     absl::Span<const std::string> input_names,
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTOR_H_
 #define TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTOR_H_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -88,6 +89,10 @@ class GraphExecutor {
     tfrt::BefBuffer bef;
     tfrt::RCReference<tfrt::BEFFile> bef_file;
     std::unique_ptr<tfrt::ResourceContext> resource_context;
+    // True once this graph has been recompiled with costs measured online.
+    // Mutable so that `Run()` can flip it on the cached (const) entry; it
+    // guards against repeated recompilation.
+    mutable std::atomic<bool> online_cost_analysis_done{false};
   };
 
   // A subgraph constructed by specifying input/output tensors.
@@ -186,6 +191,19 @@ class GraphExecutor {
       std::optional<const std::string> graph_name = std::nullopt)
       TF_LOCKS_EXCLUDED(loaded_client_graphs_mu_);
 
+  // Recompiles the client graph identified by `joined_name` with the kernel
+  // costs measured at execution time, so that the compiler's stream
+  // assignment is rebalanced with real costs, and replaces the cached
+  // `LoadedClientGraph`. The replaced entry is retained because in-flight
+  // requests may still reference it.
+  tensorflow::Status OnlineCostAnalysis(
+      absl::Span<const std::string> input_tensor_names,
+      absl::Span<const tensorflow::DataType> input_tensor_dtypes,
+      absl::Span<const std::string> output_tensor_names,
+      absl::Span<const std::string> target_tensor_names,
+      absl::string_view joined_name)
+      TF_LOCKS_EXCLUDED(loaded_client_graphs_mu_);
+
   Options options_;
   std::reference_wrapper<const FallbackState> fallback_state_;
   tfrt::tpu::TpuModelResource* tpu_model_resource_;  // NOT owned.
@@ -202,6 +220,10 @@ class GraphExecutor {
   absl::flat_hash_map<std::string /*joined_name*/,
                       std::unique_ptr<LoadedClientGraph>>
       loaded_client_graphs_ TF_GUARDED_BY(loaded_client_graphs_mu_);
+  // Keeps loaded client graphs that have been replaced by online cost
+  // analysis alive, because in-flight requests may still reference them.
+  std::vector<std::unique_ptr<LoadedClientGraph>> retired_client_graphs_
+      TF_GUARDED_BY(loaded_client_graphs_mu_);
 };
 
 }  // namespace tfrt_stub
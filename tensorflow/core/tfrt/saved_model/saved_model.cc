@@ -586,12 +586,22 @@ std::unique_ptr<SavedModel> SavedModelImpl::LoadSavedModel(
                               std::move(*meta_graph_def->mutable_graph_def())));
 
     // Finally, create the saved model.
-    return {std::make_unique<SavedModelImpl>(
+    const bool compile_in_background =
+        lazy_loading_enabled && options.lazy_loading_compile_in_background;
+    auto saved_model_impl = std::make_unique<SavedModelImpl>(
         std::move(options), *std::move(meta_graph_def), std::move(bef),
         std::move(bef_file),
         std::move(initializers_and_signatures.signature_map),
         std::move(fallback_state), std::move(tpu_model_resource),
-        std::move(resource_context), std::move(graph_executor))};
+        std::move(resource_context), std::move(graph_executor));
+
+    // If requested, compile the deferred signatures in the background so
+    // their first invocations do not pay the compilation cost.
+    if (compile_in_background) {
+      saved_model_impl->CompileDeferredSignaturesInBackground();
+    }
+
+    return {std::move(saved_model_impl)};
   }();
 
   if (!saved_model.ok()) {
@@ -625,7 +635,14 @@ SavedModelImpl::SavedModelImpl(
       lazy_loading_enabled_(meta_graph_def_.signature_def_size() >
                             options.lazy_loading_threshold) {}
 
-SavedModelImpl::~SavedModelImpl() = default;
+SavedModelImpl::~SavedModelImpl() {
+  // Wait for unfinished background compilation tasks as they reference
+  // `this`.
+  tensorflow::mutex_lock l(loading_result_cache_mu_);
+  while (num_pending_background_compiles_ > 0) {
+    loading_result_cv_.wait(l);
+  }
+}
 
 std::vector<std::string> SavedModelImpl::GetFunctionNames() const {
   std::vector<std::string> result;
@@ -1004,22 +1021,78 @@ SavedModelImpl::LoadJoinedSignature(const JoinedSignature& joined_signature) {
 
   // Store loading_result in cache.
   const auto* loading_result_ptr = loading_result.get();
-  loading_result_cache_[joined_signature.name] = std::move(loading_result);
+  {
+    tensorflow::mutex_lock l(loading_result_cache_mu_);
+    loading_result_cache_[joined_signature.name] = std::move(loading_result);
+  }
   return {*loading_result_ptr};
 }
 
 StatusOr<std::reference_wrapper<const SavedModelImpl::LoadingResult>>
 SavedModelImpl::GetOrCreateLoadingResult(absl::Span<const std::string> names) {
   const auto joined_name = absl::StrJoin(names, kSignatureJoiningDelimiter);
-  tensorflow::mutex_lock l(loading_result_cache_mu_);
-  const auto iter = loading_result_cache_.find(joined_name);
-  if (iter != loading_result_cache_.end()) return {*iter->second};
+  {
+    tensorflow::mutex_lock l(loading_result_cache_mu_);
+    // If another thread is compiling the same signature(s), wait for it to
+    // finish instead of compiling them again.
+    while (loading_results_in_progress_.contains(joined_name)) {
+      loading_result_cv_.wait(l);
+    }
+    const auto iter = loading_result_cache_.find(joined_name);
+    if (iter != loading_result_cache_.end()) return {*iter->second};
+    loading_results_in_progress_.insert(joined_name);
+  }
 
-  TF_ASSIGN_OR_RETURN(
-      const auto joined_signature,
-      JoinSignatures(names, signatures_, meta_graph_def_.signature_def()));
+  // Compile without the lock held so that different signatures can be
+  // compiled concurrently (e.g. by the background compilation tasks).
+  auto loading_result =
+      [&]() -> StatusOr<
+                std::reference_wrapper<const SavedModelImpl::LoadingResult>> {
+    TF_ASSIGN_OR_RETURN(
+        const auto joined_signature,
+        JoinSignatures(names, signatures_, meta_graph_def_.signature_def()));
 
-  return LoadJoinedSignature(joined_signature);
+    return LoadJoinedSignature(joined_signature);
+  }();
+
+  {
+    tensorflow::mutex_lock l(loading_result_cache_mu_);
+    loading_results_in_progress_.erase(joined_name);
+  }
+  // On failure nothing is cached, so a waiter retries the compilation.
+  loading_result_cv_.notify_all();
+
+  return loading_result;
+}
+
+void SavedModelImpl::CompileDeferredSignaturesInBackground() {
+  auto* work_queue = runtime().work_queue();
+  DCHECK(work_queue);
+  for (const auto& entry : signatures_) {
+    {
+      tensorflow::mutex_lock l(loading_result_cache_mu_);
+      ++num_pending_background_compiles_;
+    }
+    work_queue->AddTask(tfrt::TaskFunction([this, name = entry.first]() {
+      const auto start_time = absl::Now();
+      const auto loading_result = GetOrCreateLoadingResult({name});
+      if (loading_result.ok()) {
+        LOG(INFO) << "TFRT finished loading signature " << name
+                  << " in the background. Took "
+                  << absl::ToInt64Milliseconds(absl::Now() - start_time)
+                  << " ms.";
+      } else {
+        // The first invocation of the signature will retry the compilation
+        // and report the error to the client.
+        LOG(WARNING) << "TFRT failed to load signature " << name
+                     << " in the background: " << loading_result.status();
+      }
+
+      tensorflow::mutex_lock l(loading_result_cache_mu_);
+      --num_pending_background_compiles_;
+      loading_result_cv_.notify_all();
+    }));
+  }
 }
 
 }  // namespace tfrt_stub
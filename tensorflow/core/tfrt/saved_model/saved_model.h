@@ -25,6 +25,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -121,6 +122,14 @@ class SavedModel {
     // will be loaded along with the saved model.
     int32_t lazy_loading_threshold = std::numeric_limits<int32_t>::max();
 
+    // If true and lazy loading is enabled, the signatures that are deferred
+    // at loading time are compiled in the background on the runtime's work
+    // queue right after the saved model is loaded, so that their first
+    // invocations do not pay the compilation cost. An invocation that arrives
+    // before the corresponding background compilation finishes only waits for
+    // that signature's compilation.
+    bool lazy_loading_compile_in_background = false;
+
     // If true, we'll attempt to find MLArchive within the given loading path.
     // If not found, will use the path as a normal SavedModel directory.
     bool maybe_load_from_mla = false;
@@ -262,10 +271,13 @@ class SavedModelImpl final : public SavedModel {
       const std::vector<std::string>& target_nodes);
 
   // Given the joined signature, loads the subgraph and returns loading result.
+  // The compilation itself runs without `loading_result_cache_mu_` held, so
+  // that different signatures can be compiled concurrently; the lock is only
+  // taken to store the result in the cache.
   tensorflow::StatusOr<
       std::reference_wrapper<const SavedModelImpl::LoadingResult>>
   LoadJoinedSignature(const JoinedSignature& joined_signature)
-      TF_EXCLUSIVE_LOCKS_REQUIRED(loading_result_cache_mu_);
+      TF_LOCKS_EXCLUDED(loading_result_cache_mu_);
 
   // Returns the loading result given the signature names.
   tensorflow::StatusOr<
@@ -273,6 +285,13 @@ class SavedModelImpl final : public SavedModel {
   GetOrCreateLoadingResult(absl::Span<const std::string> names)
       TF_LOCKS_EXCLUDED(loading_result_cache_mu_);
 
+  // Enqueues one task per signature on the runtime's work queue that compiles
+  // the signature via `GetOrCreateLoadingResult()`. Only used when lazy
+  // loading is enabled and `options_.lazy_loading_compile_in_background` is
+  // true.
+  void CompileDeferredSignaturesInBackground()
+      TF_LOCKS_EXCLUDED(loading_result_cache_mu_);
+
   // Runs `func` with the given inputs, and outputs the result.
   tensorflow::Status RunInternal(const RunOptions& run_options,
                                  absl::string_view signature_name,
@@ -305,6 +324,17 @@ class SavedModelImpl final : public SavedModel {
   absl::flat_hash_map<std::string /*joined_name*/,
                       std::unique_ptr<LoadingResult>>
       loading_result_cache_ TF_GUARDED_BY(loading_result_cache_mu_);
+  // Signals both insertions into `loading_result_cache_` and updates to
+  // `loading_results_in_progress_` and `num_pending_background_compiles_`.
+  tensorflow::condition_variable loading_result_cv_;
+  // The joined names whose compilations are currently running without the
+  // lock held, so that the same signature(s) are never compiled twice.
+  absl::flat_hash_set<std::string> loading_results_in_progress_
+      TF_GUARDED_BY(loading_result_cache_mu_);
+  // The number of unfinished background compilation tasks. The destructor
+  // waits for it to drop to zero as the tasks reference `this`.
+  int num_pending_background_compiles_
+      TF_GUARDED_BY(loading_result_cache_mu_) = 0;
   std::unique_ptr<GraphExecutor> graph_executor_;
   bool lazy_loading_enabled_ = false;
 };
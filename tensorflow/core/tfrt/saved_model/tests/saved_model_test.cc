@@ -91,6 +91,46 @@ INSTANTIATE_TEST_SUITE_P(
         TestParams{0, 1, 1}, TestParams{1, 0, 0}, TestParams{1, 0, 1},
         TestParams{1, 1, 0}, TestParams{1, 1, 1}));
 
+TEST(SavedModelTest, LazyLoadingCompileInBackground) {
+  // SavedModel toy contains a graph of a single 'tf.AddV2' op. It is generated
+  // using the following python code:
+  //  x = tf.placeholder(tf.int32, shape=(3))
+  //  y = tf.compat.v1.get_variable(name='y', initializer=[1, 2, 3])
+  //  r = tf.matmul(x, y)
+  std::string saved_model_dir = tensorflow::GetDataDependencyFilepath(
+      "tensorflow/core/tfrt/saved_model/tests/toy_v1");
+
+  // Use multiple threads so that the background compilation tasks can make
+  // progress while a signature is invoked.
+  auto runtime = DefaultTfrtRuntime(/*num_threads=*/4);
+  auto options = DefaultSavedModelOptions(runtime.get());
+  options.lazy_loading_threshold = 0;
+  options.lazy_loading_compile_in_background = true;
+
+  tensorflow::Status status;
+  auto saved_model =
+      SavedModelImpl::LoadSavedModel(options, saved_model_dir,
+                                     /*tags=*/{"serve"}, &status);
+  TF_CHECK_OK(status);
+
+  // Set input 'x' to [[1, 1, 1]]
+  std::vector<tensorflow::Tensor> inputs;
+  inputs.push_back(
+      CreateTfTensor<int32_t>(/*shape=*/{1, 3}, /*data=*/{1, 1, 1}));
+
+  tfrt::SavedModel::RunOptions run_options;
+
+  // The invocation either waits for the background compilation of the "toy"
+  // signature or reuses its result, and must produce the same output as the
+  // on-demand compilation.
+  std::vector<tensorflow::Tensor> outputs;
+  TF_ASSERT_OK(saved_model->Run(run_options, "toy", inputs, &outputs));
+  ASSERT_EQ(outputs.size(), 1);
+
+  EXPECT_THAT(GetTfTensorData<int32_t>(outputs[0]),
+              ::testing::ElementsAreArray({6}));
+}
+
 TEST(SavedModelTest, CostMeasurementEnabled) {
   // SavedModel toy contains a graph of a single 'tf.AddV2' op. It is generated
   // using the following python code:
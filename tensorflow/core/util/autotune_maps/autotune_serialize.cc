@@ -16,13 +16,17 @@ limitations under the License.
 // For Google-internal use only.
 #include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "tensorflow/compiler/xla/stream_executor/dnn.h"
 #include "tensorflow/compiler/xla/stream_executor/dnn.pb.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/str_util.h"
 #include "tensorflow/core/util/activation_mode.h"
 #include "tensorflow/core/util/autotune_maps/autotune_map.pb.h"
@@ -208,6 +212,66 @@ Status LoadSerializedAutotuneMaps(absl::string_view s) {
   return OkStatus();
 }
 
+Status SaveAutotuneMapsToFile(const std::string &file_path) {
+  std::string serialized;
+  TF_RETURN_IF_ERROR(SerializeAutotuneMaps(&serialized));
+  Env *env = Env::Default();
+  // Write to a unique temporary file and rename it into place so that a
+  // concurrent reader (e.g. another job starting up against the same cache)
+  // never observes a partially written file.
+  std::string tmp_path = file_path;
+  if (!env->CreateUniqueFileName(&tmp_path, ".tmp")) {
+    return errors::Internal("Failed to create temporary file for ", file_path);
+  }
+  TF_RETURN_IF_ERROR(WriteStringToFile(env, tmp_path, serialized));
+  return env->RenameFile(tmp_path, file_path);
+}
+
+Status LoadAutotuneMapsFromFile(const std::string &file_path) {
+  std::string serialized;
+  TF_RETURN_IF_ERROR(ReadFileToString(Env::Default(), file_path, &serialized));
+  return LoadSerializedAutotuneMaps(serialized);
+}
+
+namespace {
+
+// Set once by EnableAutotuneCacheFromEnv and then read by the exit handler;
+// leaked intentionally since it must outlive static destructors.
+std::string *autotune_cache_path = nullptr;
+
+void SaveAutotuneCacheAtExit() {
+  Status s = SaveAutotuneMapsToFile(*autotune_cache_path);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to save autotune maps to "
+                 << *autotune_cache_path << ": " << s;
+  }
+}
+
+}  // namespace
+
+void EnableAutotuneCacheFromEnv() {
+  static absl::once_flag once;
+  absl::call_once(once, [] {
+    const char *path = std::getenv("TF_AUTOTUNE_CACHE_PATH");
+    if (path == nullptr || path[0] == '\0') {
+      return;
+    }
+    autotune_cache_path = new std::string(path);
+    if (Env::Default()->FileExists(*autotune_cache_path).ok()) {
+      Status s = LoadAutotuneMapsFromFile(*autotune_cache_path);
+      if (s.ok()) {
+        LOG(INFO) << "Loaded autotune maps from " << *autotune_cache_path;
+      } else {
+        // A cache recorded on different devices or with a different runtime
+        // version is not an error; autotuning simply starts from scratch.
+        LOG(WARNING) << "Ignoring autotune cache " << *autotune_cache_path
+                     << ": " << s;
+      }
+    }
+    std::atexit(SaveAutotuneCacheAtExit);
+  });
+}
+
 void ResetAutotuneMaps() {
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
   ConvAutotuneMap::GetInstance()->ClearMap();
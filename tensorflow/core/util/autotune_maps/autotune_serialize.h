@@ -40,6 +40,25 @@ Status LoadSerializedAutotuneMaps(absl::string_view s);
 // LoadSerializedAutotuneMaps.
 Status SerializeAutotuneMaps(std::string* output);
 
+// Serializes all the autotune maps and writes them to 'file_path'.  The file
+// is written atomically (via a temporary file and rename) so a concurrent
+// reader never observes a partial cache.
+Status SaveAutotuneMapsToFile(const std::string& file_path);
+
+// Reads a file written by SaveAutotuneMapsToFile and uses its contents to
+// update the runtime autotune maps.  Entries recorded for GPU models or
+// cuDNN/runtime versions that don't match the current process are skipped or
+// rejected by the underlying loading logic, so a stale cache degrades to
+// re-autotuning rather than wrong algorithm choices.
+Status LoadAutotuneMapsFromFile(const std::string& file_path);
+
+// If the TF_AUTOTUNE_CACHE_PATH environment variable is set, loads the
+// autotune maps from that file (when it exists) and arranges for the maps to
+// be written back to it at normal process exit, so steady-state algorithm
+// choices are available on the first step of the next run.  Only the first
+// call has any effect.
+void EnableAutotuneCacheFromEnv();
+
 // Resets all autotune maps. For test use only.
 void ResetAutotuneMaps();
 
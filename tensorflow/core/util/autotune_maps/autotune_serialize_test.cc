@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "absl/types/variant.h"
 #include "tensorflow/compiler/xla/stream_executor/gpu/gpu_driver.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/util/autotune_maps/conv_autotune_maps.h"
@@ -45,6 +46,19 @@ TEST(AutotuneSerializeTest, Empty) {
   EXPECT_EQ(ConvAutotuneMap::GetInstance()->GetMap().size(), 0);
 }
 
+// Tests writing the autotune maps to a file and reading them back.
+TEST(AutotuneSerializeTest, FileRoundTrip) {
+  TF_CHECK_OK(GpuDriver::Init());
+  ResetAutotuneMaps();
+  std::string file_path = io::JoinPath(testing::TmpDir(), "autotune_cache.pb");
+  TF_CHECK_OK(SaveAutotuneMapsToFile(file_path));
+  TF_CHECK_OK(LoadAutotuneMapsFromFile(file_path));
+  EXPECT_EQ(ConvAutotuneMap::GetInstance()->GetMap().size(), 0);
+  EXPECT_THAT(LoadAutotuneMapsFromFile(
+                  io::JoinPath(testing::TmpDir(), "missing_cache.pb")),
+              StatusIs(error::NOT_FOUND));
+}
+
 // Tests the consistency of SerializeAutotuneMaps and LoadSerializedAutotuneMaps
 // by:
 // 1. Insert predefined entries into the autotune maps.
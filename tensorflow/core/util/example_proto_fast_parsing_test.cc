@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <limits>
 #include <utility>
 
 #include "tensorflow/core/util/example_proto_fast_parsing.h"
@@ -217,6 +218,23 @@ TEST(FastParse, SingleInt64) {
   TestCorrectness(Serialize(example));
 }
 
+TEST(FastParse, PackedInt64MixedWidths) {
+  // Exercises the wide packed-varint decoder: long runs of one-byte values
+  // interleaved with multi-byte varints, including a negative value that
+  // encodes as ten bytes.
+  Example example;
+  Int64List* int64_list =
+      (*example.mutable_features()->mutable_feature())["ids"]
+          .mutable_int64_list();
+  for (int i = 0; i < 20; ++i) int64_list->add_value(i);
+  int64_list->add_value(128);
+  int64_list->add_value(1 << 20);
+  int64_list->add_value(std::numeric_limits<int64_t>::max());
+  int64_list->add_value(-1);
+  for (int i = 0; i < 20; ++i) int64_list->add_value(i % 3);
+  TestCorrectness(Serialize(example));
+}
+
 static string ExampleWithSomeFeatures() {
   Example example;
 
@@ -19,8 +19,11 @@ limitations under the License.
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <set>
 #include <utility>
+#include <vector>
 
+#include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
@@ -40,11 +43,14 @@ limitations under the License.
 #include "tensorflow/core/lib/io/table_builder.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/bfloat16.h"
 #include "tensorflow/core/platform/cord.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
@@ -70,6 +76,11 @@ static const int kBufferSize = 1024 * 1024;
 // bundle.
 const char* const kHeaderEntryKey = "";
 
+// Key suffixes for row-level delta entries.  The "/." prefix keeps them out
+// of the plain tensor-name space used by savers.
+const char* const kDeltaRowIndicesSuffix = "/.ROW_DELTA_INDICES";
+const char* const kDeltaRowValuesSuffix = "/.ROW_DELTA_VALUES";
+
 // The size threshold for multi-threaded tensor loading.
 const int64_t kLargeTensorThreshold = static_cast<int64_t>(1) << 32;
 // Maximum number of threads to load the tensor from the file.
@@ -77,6 +88,11 @@ const int kMaxFileReadThreads = 8;
 // Minimum size of a file section handled by each thread.
 const int64_t kMinSectionSize = static_cast<int64_t>(1) << 31;
 
+// Minimum size for a restored tensor to be considered for content-addressed
+// deduplication.  Smaller tensors cost more in cache bookkeeping than their
+// buffers are worth.
+const int64_t kDedupMinBytes = 4096;
+
 namespace {
 
 // Reads "num_elements" string elements from file[offset, offset+size) into the
@@ -525,6 +541,34 @@ Status BundleWriter::AddSlice(StringPiece full_tensor_key,
   return status_;
 }
 
+Status BundleWriter::AddRowDeltas(StringPiece key, const Tensor& row_indices,
+                                  const Tensor& rows) {
+  if (!status_.ok()) return status_;
+  if (row_indices.dtype() != DT_INT64 || row_indices.dims() != 1) {
+    status_ = errors::InvalidArgument(
+        "Row delta indices for key ", key, " must be an int64 vector, got ",
+        DataTypeString(row_indices.dtype()), " ",
+        row_indices.shape().DebugString());
+    return status_;
+  }
+  if (rows.dims() < 1 || rows.dim_size(0) != row_indices.dim_size(0)) {
+    status_ = errors::InvalidArgument(
+        "Row deltas for key ", key, " must have one row per index, got shape ",
+        rows.shape().DebugString(), " for ", row_indices.dim_size(0),
+        " indices");
+    return status_;
+  }
+  if (!DataTypeCanUseMemcpy(rows.dtype())) {
+    status_ = errors::InvalidArgument(
+        "Row deltas require a memcpy-able dtype, got ",
+        DataTypeString(rows.dtype()), " for key ", key);
+    return status_;
+  }
+  TF_RETURN_IF_ERROR(
+      Add(strings::StrCat(key, kDeltaRowIndicesSuffix), row_indices));
+  return Add(strings::StrCat(key, kDeltaRowValuesSuffix), rows);
+}
+
 // TODO(zongheng): on metadata write failure or !status_.ok(), consider removing
 // the orphaned data file.
 Status BundleWriter::Finish() {
@@ -580,6 +624,44 @@ Status BundleWriter::Finish() {
   return OkStatus();
 }
 
+AsyncBundleWriter::AsyncBundleWriter(Env* env, StringPiece prefix,
+                                     const BundleWriter::Options& options)
+    : writer_(env, prefix, options),
+      pool_(env, "async_bundle_writer", 1 /* num_threads */) {}
+
+void AsyncBundleWriter::Add(StringPiece key, const Tensor& val) {
+  // Capturing "val" by value bumps the buffer's refcount, which is the
+  // snapshot: in-place variable updates in snapshot-reads mode copy on write
+  // when the refcount is above one.
+  pool_.Schedule([this, key = string(key), val] {
+    // Errors are sticky in the writer and surfaced by Finish().
+    writer_.Add(key, val).IgnoreError();
+  });
+}
+
+void AsyncBundleWriter::AddSlice(StringPiece full_tensor_key,
+                                 const TensorShape& full_tensor_shape,
+                                 const TensorSlice& slice_spec,
+                                 const Tensor& slice_tensor) {
+  pool_.Schedule([this, full_tensor_key = string(full_tensor_key),
+                  full_tensor_shape, slice_spec, slice_tensor] {
+    writer_
+        .AddSlice(full_tensor_key, full_tensor_shape, slice_spec, slice_tensor)
+        .IgnoreError();
+  });
+}
+
+Status AsyncBundleWriter::Finish() {
+  Status status;
+  Notification done;
+  pool_.Schedule([this, &status, &done] {
+    status = writer_.Finish();
+    done.Notify();
+  });
+  done.WaitForNotification();
+  return status;
+}
+
 // Merging tensor bundles.
 
 // Accumulator of metadata states during a merge.
@@ -865,6 +947,58 @@ Status BundleReader::GetBundleEntryProto(StringPiece key,
   return OkStatus();
 }
 
+namespace {
+
+// Process-wide content-addressed cache of restored tensors, enabled by
+// setting TF_TENSOR_BUNDLE_DEDUP_RESTORED_TENSORS=1.  When many bundles
+// restored in one process store identical tensors (e.g. model versions that
+// share most of their weights), Lookup() hands out tensors aliasing a single
+// shared buffer instead of one freshly read buffer per bundle.  Restored
+// tensors are immutable by convention, so sharing their buffers is safe;
+// cached buffers stay resident for the lifetime of the process.
+class RestoredTensorCache {
+ public:
+  static RestoredTensorCache* Get() {
+    static RestoredTensorCache* cache = new RestoredTensorCache;
+    return cache;
+  }
+
+  // If a tensor with the same checksum, dtype, shape and contents as "*val"
+  // has been restored before, points "*val" at the cached copy, releasing the
+  // freshly restored buffer.  Otherwise caches "*val" for later restores.
+  void Deduplicate(uint32 crc32c, Tensor* val) {
+    const string key = strings::StrCat(crc32c, ":", val->dtype(), ":",
+                                       val->shape().DebugString());
+    mutex_lock l(mu_);
+    auto iter = tensors_.find(key);
+    if (iter == tensors_.end()) {
+      tensors_.emplace(key, *val);
+      return;
+    }
+    // The checksum is only 32 bits, so confirm that the contents actually
+    // match before sharing the buffer.
+    const StringPiece cached = iter->second.tensor_data();
+    const StringPiece restored = val->tensor_data();
+    if (cached.size() == restored.size() &&
+        memcmp(cached.data(), restored.data(), cached.size()) == 0) {
+      *val = iter->second;
+    }
+  }
+
+ private:
+  mutex mu_;
+  std::unordered_map<string, Tensor> tensors_ TF_GUARDED_BY(mu_);
+};
+
+bool DedupRestoredTensors() {
+  bool enable = false;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_TENSOR_BUNDLE_DEDUP_RESTORED_TENSORS",
+                                 false, &enable));
+  return enable;
+}
+
+}  // namespace
+
 Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   Tensor* ret = val;
   const TensorShape stored_shape(TensorShape(entry.shape()));
@@ -1001,6 +1135,14 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
         " vs. calculated on the restored bytes ", actual_crc32c);
   }
 
+  // Byte-swapped tensors are skipped because "actual_crc32c" describes the
+  // on-disk byte order, not the in-memory contents.
+  if (DedupRestoredTensors() && DataTypeCanUseMemcpy(entry.dtype()) &&
+      !need_to_swap_bytes_ &&
+      static_cast<int64_t>(entry.size()) >= kDedupMinBytes) {
+    RestoredTensorCache::Get()->Deduplicate(actual_crc32c, ret);
+  }
+
   *val = *ret;
   if (ret != val) delete ret;
   return OkStatus();
@@ -1020,6 +1162,125 @@ Status BundleReader::Lookup(StringPiece key, Tensor* val) {
   }
 }
 
+namespace {
+
+// A TensorBuffer that aliases a range of a read-only memory mapping of a
+// bundle data shard.  Holds a reference on the mapping so that tensors
+// returned by LookupMemmapped() stay valid after the BundleReader that
+// created them is destroyed.
+class MemmappedTensorBuffer : public TensorBuffer {
+ public:
+  MemmappedTensorBuffer(const void* data, size_t size,
+                        std::shared_ptr<ReadOnlyMemoryRegion> region)
+      : TensorBuffer(const_cast<void*>(data)),
+        size_(size),
+        region_(std::move(region)) {}
+
+  size_t size() const override { return size_; }
+
+  TensorBuffer* root_buffer() override { return this; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size_));
+    proto->set_allocator_name("memmapped_bundle");
+    proto->set_ptr(reinterpret_cast<uintptr_t>(data()));
+  }
+
+  // The file-backed pages are not charged against this process.
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t size_;
+  const std::shared_ptr<ReadOnlyMemoryRegion> region_;
+};
+
+}  // namespace
+
+Status BundleReader::GetMemmappedShard(
+    int shard_id, std::shared_ptr<ReadOnlyMemoryRegion>* region) {
+  auto iter = mmap_regions_.find(shard_id);
+  if (iter == mmap_regions_.end()) {
+    std::unique_ptr<ReadOnlyMemoryRegion> mapped;
+    TF_RETURN_IF_ERROR(env_->NewReadOnlyMemoryRegionFromFile(
+        DataFilename(prefix_, shard_id, num_shards_), &mapped));
+    iter = mmap_regions_
+               .emplace(shard_id,
+                        std::shared_ptr<ReadOnlyMemoryRegion>(mapped.release()))
+               .first;
+  }
+  *region = iter->second;
+  return OkStatus();
+}
+
+Status BundleReader::LookupMemmapped(StringPiece key, Tensor* val) {
+  CHECK(val != nullptr);
+  BundleEntryProto entry;
+  TF_RETURN_IF_ERROR(GetBundleEntryProto(key, &entry));
+
+  if (!entry.slices().empty()) {
+    return errors::Unimplemented(
+        "Memory-mapped lookup of partitioned tensor ", key,
+        " is not supported; the slices must be assembled into a new buffer");
+  }
+  if (!DataTypeCanUseMemcpy(entry.dtype())) {
+    return errors::Unimplemented("Memory-mapped lookup of tensor ", key,
+                                 " of dtype ",
+                                 DataTypeString(entry.dtype()),
+                                 " is not supported; the stored bytes are not "
+                                 "the in-memory representation");
+  }
+  if (need_to_swap_bytes_) {
+    return errors::Unimplemented(
+        "TensorBundle at ", prefix_,
+        " is of a different endianness than this machine's hardware; "
+        "byte-swapping would require writing to the mapping");
+  }
+  if (EIGEN_MAX_ALIGN_BYTES > 0 &&
+      entry.offset() % EIGEN_MAX_ALIGN_BYTES != 0) {
+    return errors::FailedPrecondition(
+        "Tensor ", key, " is stored at offset ", entry.offset(),
+        ", which is not aligned to ", EIGEN_MAX_ALIGN_BYTES,
+        " bytes; write the bundle with BundleWriter::Options::data_alignment "
+        "to make it memory-mappable");
+  }
+
+  std::shared_ptr<ReadOnlyMemoryRegion> region;
+  TF_RETURN_IF_ERROR(GetMemmappedShard(entry.shard_id(), &region));
+  if (entry.offset() + entry.size() > region->length()) {
+    return errors::DataLoss("Tensor ", key, " expects [", entry.offset(), ", ",
+                            entry.offset() + entry.size(),
+                            ") of the data file, which is only ",
+                            region->length(), " bytes");
+  }
+  const char* base = static_cast<const char*>(region->data()) + entry.offset();
+
+  // Validates the checksum on the mapped bytes.  The pages faulted in here
+  // remain in the page cache, shared across processes mapping the same shard.
+  uint32 actual_crc32c = crc32c::Value(base, entry.size());
+  if (crc32c::Unmask(entry.crc32c()) != actual_crc32c) {
+    return errors::DataLoss(
+        "TensorBundle at ", prefix_, " shard ", entry.shard_id(), " (",
+        entry.size(), " bytes): Checksum does not match: stored ",
+        strings::Printf("%08u", crc32c::Unmask(entry.crc32c())),
+        " vs. calculated on the mapped bytes ", actual_crc32c);
+  }
+
+  const TensorShape stored_shape(TensorShape(entry.shape()));
+  if (entry.size() != stored_shape.num_elements() *
+                          static_cast<int64_t>(DataTypeSize(entry.dtype()))) {
+    return errors::DataLoss("Invalid size in bundle entry: key ", key,
+                            "; stored size ", entry.size(),
+                            "; expected size ",
+                            stored_shape.num_elements() *
+                                DataTypeSize(entry.dtype()));
+  }
+
+  auto* buffer = new MemmappedTensorBuffer(base, entry.size(), region);
+  *val = Tensor(entry.dtype(), stored_shape, buffer);
+  buffer->Unref();
+  return OkStatus();
+}
+
 Status BundleReader::ReadCurrent(Tensor* val) {
   CHECK(val != nullptr);
   BundleEntryProto entry;
@@ -1208,6 +1469,133 @@ string BundleReader::DebugString() {
   return shape_str;
 }
 
+// Row-level delta overlays.
+
+namespace {
+
+// Reads the tensor keyed by "key" from "reader" into a freshly allocated
+// "*val".
+Status ReadEntireTensor(BundleReader* reader, StringPiece key, Tensor* val) {
+  DataType dtype;
+  TensorShape shape;
+  TF_RETURN_IF_ERROR(reader->LookupDtypeAndShape(key, &dtype, &shape));
+  *val = Tensor(dtype, shape);
+  return reader->Lookup(key, val);
+}
+
+// Overwrites rows of "*val" with the row deltas stored for "key" in "reader",
+// if any.
+Status ApplyRowDeltas(BundleReader* reader, StringPiece key, Tensor* val) {
+  const string indices_key = strings::StrCat(key, kDeltaRowIndicesSuffix);
+  if (!reader->Contains(indices_key)) return OkStatus();
+  Tensor indices;
+  TF_RETURN_IF_ERROR(ReadEntireTensor(reader, indices_key, &indices));
+  Tensor rows;
+  TF_RETURN_IF_ERROR(ReadEntireTensor(
+      reader, strings::StrCat(key, kDeltaRowValuesSuffix), &rows));
+
+  if (val->dims() < 1) {
+    return errors::InvalidArgument("Cannot apply row deltas to the scalar ",
+                                   "tensor keyed by ", key);
+  }
+  if (!DataTypeCanUseMemcpy(val->dtype()) || rows.dtype() != val->dtype()) {
+    return errors::InvalidArgument(
+        "Row deltas for key ", key, " of dtype ", DataTypeString(rows.dtype()),
+        " cannot be applied to a tensor of dtype ",
+        DataTypeString(val->dtype()));
+  }
+  TensorShape expected_shape = val->shape();
+  expected_shape.set_dim(0, indices.NumElements());
+  if (rows.shape() != expected_shape) {
+    return errors::InvalidArgument(
+        "Row deltas for key ", key, " have shape ",
+        rows.shape().DebugString(), ", expected ",
+        expected_shape.DebugString());
+  }
+
+  const int64_t num_rows = val->dim_size(0);
+  if (indices.NumElements() == 0) return OkStatus();
+  const int64_t row_bytes =
+      val->NumElements() / num_rows * DataTypeSize(val->dtype());
+  const auto indices_vec = indices.vec<int64_t>();
+  char* dst = static_cast<char*>(val->data());
+  const char* src = static_cast<const char*>(rows.data());
+  for (int64_t i = 0; i < indices_vec.size(); ++i) {
+    const int64_t row = indices_vec(i);
+    if (row < 0 || row >= num_rows) {
+      return errors::InvalidArgument("Row delta index ", row,
+                                     " is out of range [0, ", num_rows,
+                                     ") for key ", key);
+    }
+    memcpy(dst + row * row_bytes, src + i * row_bytes, row_bytes);
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status LookupWithRowDeltas(gtl::ArraySlice<BundleReader*> bundles,
+                           StringPiece key, Tensor* val) {
+  // Start from the newest full value of "key" in the chain; older bundles
+  // (and older deltas) are superseded by it.
+  int newest_full = -1;
+  for (int i = bundles.size() - 1; i >= 0; --i) {
+    if (bundles[i]->Contains(key)) {
+      newest_full = i;
+      break;
+    }
+  }
+  if (newest_full < 0) {
+    return errors::NotFound("No full value for key ", key,
+                            " in any bundle of the chain");
+  }
+  TF_RETURN_IF_ERROR(ReadEntireTensor(bundles[newest_full], key, val));
+  for (int i = newest_full + 1; i < static_cast<int>(bundles.size()); ++i) {
+    TF_RETURN_IF_ERROR(ApplyRowDeltas(bundles[i], key, val));
+  }
+  return OkStatus();
+}
+
+Status CompactRowDeltas(Env* env, gtl::ArraySlice<tstring> prefixes,
+                        StringPiece merged_prefix) {
+  if (prefixes.empty()) {
+    return errors::InvalidArgument(
+        "CompactRowDeltas requires at least one input bundle");
+  }
+  std::vector<std::unique_ptr<BundleReader>> readers;
+  std::vector<BundleReader*> reader_ptrs;
+  readers.reserve(prefixes.size());
+  for (const tstring& prefix : prefixes) {
+    readers.push_back(std::make_unique<BundleReader>(env, prefix));
+    TF_RETURN_IF_ERROR(readers.back()->status());
+    reader_ptrs.push_back(readers.back().get());
+  }
+
+  // Collect every key with a full value or a row delta anywhere in the chain.
+  std::set<string> keys;
+  for (auto& reader : readers) {
+    reader->Seek(kHeaderEntryKey);
+    for (reader->Next(); reader->Valid(); reader->Next()) {
+      StringPiece key = reader->key();
+      if (str_util::EndsWith(key, kDeltaRowValuesSuffix)) continue;
+      if (str_util::EndsWith(key, kDeltaRowIndicesSuffix)) {
+        key.remove_suffix(strlen(kDeltaRowIndicesSuffix));
+      }
+      keys.insert(string(key));
+    }
+  }
+
+  BundleWriter writer(env, merged_prefix);
+  TF_RETURN_IF_ERROR(writer.status());
+  // One tensor at a time, to bound peak memory by the largest tensor.
+  for (const string& key : keys) {
+    Tensor val;
+    TF_RETURN_IF_ERROR(LookupWithRowDeltas(reader_ptrs, key, &val));
+    TF_RETURN_IF_ERROR(writer.Add(key, val));
+  }
+  return writer.Finish();
+}
+
 namespace {
 inline char* AlignedMalloc(size_t size) {
   char* buffer = static_cast<char*>(port::AlignedMalloc(size, 64));
@@ -62,6 +62,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_UTIL_TENSOR_BUNDLE_TENSOR_BUNDLE_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -72,6 +73,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_slice.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/io/cache.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
@@ -103,6 +105,14 @@ extern const int kTensorBundleVersion;
 // corresponding value is a BundleHeaderProto.
 extern const char* const kHeaderEntryKey;
 
+// Key suffixes under which a delta bundle stores row-level updates of the
+// tensor keyed by "key" (see BundleWriter::AddRowDeltas):
+//   "<key>" + kDeltaRowIndicesSuffix -> int64 vector of first-dimension rows.
+//   "<key>" + kDeltaRowValuesSuffix  -> the matching rows, shape
+//                                       [num_rows] + full_shape[1:].
+extern const char* const kDeltaRowIndicesSuffix;
+extern const char* const kDeltaRowValuesSuffix;
+
 // Builds a string-string table of tensor names to BundleEntryProto (metadata).
 //
 // On construction, attempts to create a directory given by the dirname of
@@ -144,6 +154,20 @@ class BundleWriter {
                   const TensorShape& full_tensor_shape,
                   const TensorSlice& slice_spec, const Tensor& slice_tensor);
 
+  // Delta checkpointing support for sparsely updated tensors (e.g. embedding
+  // tables whose dirty rows are tracked on the variable).  Adds only the
+  // given first-dimension rows of the tensor keyed by "key", under a pair of
+  // derived keys (see kDeltaRowIndicesSuffix above).  A bundle written this
+  // way is not readable through a plain Lookup() of "key"; restore it by
+  // overlaying it onto a full checkpoint with LookupWithRowDeltas(), and
+  // periodically fold deltas back into a full bundle with
+  // CompactRowDeltas().
+  //
+  // "row_indices" must be an int64 vector; "rows" must have
+  // row_indices.dim_size(0) rows and a memcpy-able dtype.
+  Status AddRowDeltas(StringPiece key, const Tensor& row_indices,
+                      const Tensor& rows);
+
   // Finishes the writer and flushes.
   Status Finish() TF_MUST_USE_RESULT;
 
@@ -164,6 +188,49 @@ class BundleWriter {
   TF_DISALLOW_COPY_AND_ASSIGN(BundleWriter);
 };
 
+// Asynchronous wrapper around BundleWriter.
+//
+// Add() snapshots "val" by reference (copying a Tensor shares its buffer) and
+// returns immediately; serialization and file writes happen on a background
+// thread, overlapping the caller's subsequent work.  For resource variables
+// running in snapshot-reads mode (TF_RESOURCE_VARIABLE_SNAPSHOT_READS=1), the
+// reference held by the pending write raises the buffer's refcount above one,
+// so later in-place updates of the variable copy the buffer first and the
+// checkpointed value stays a consistent point-in-time snapshot.  Callers that
+// mutate a tensor's buffer in place through other means (e.g. legacy ref
+// variables) must pass a deep copy instead.
+//
+// Errors from queued writes are sticky in the underlying writer and are
+// reported by Finish(), which blocks until all pending writes complete.
+// All threads accessing the same AsyncBundleWriter must synchronize.
+class AsyncBundleWriter {
+ public:
+  AsyncBundleWriter(
+      Env* env, StringPiece prefix,
+      const BundleWriter::Options& options = BundleWriter::Options());
+
+  // Enqueues adding the tensor "val" under key "key" and returns immediately.
+  // Key requirements follow BundleWriter::Add().
+  void Add(StringPiece key, const Tensor& val);
+
+  // Enqueues adding one slice of a partitioned variable and returns
+  // immediately.  Semantics follow BundleWriter::AddSlice().
+  void AddSlice(StringPiece full_tensor_key,
+                const TensorShape& full_tensor_shape,
+                const TensorSlice& slice_spec, const Tensor& slice_tensor);
+
+  // Blocks until all queued writes are done, then finishes the underlying
+  // writer and flushes.  Returns the first error encountered, if any.
+  Status Finish() TF_MUST_USE_RESULT;
+
+ private:
+  BundleWriter writer_;
+  // A single thread, so queued writes execute in submission order.
+  thread::ThreadPool pool_;
+
+  TF_DISALLOW_COPY_AND_ASSIGN(AsyncBundleWriter);
+};
+
 // Merges a set of bundles (given their prefixes) into a single bundle with the
 // given "merged_prefix".  The merged metadata is guaranteed to be consistent.
 //
@@ -243,9 +310,33 @@ class BundleReader {
   // tensor keyed by "key" does not exist in this bundle.
   //
   // Validates the stored crc32c checksum against the restored bytes.
+  //
+  // If TF_TENSOR_BUNDLE_DEDUP_RESTORED_TENSORS=1 is set in the environment,
+  // identical tensors restored anywhere in this process share one immutable
+  // buffer: on a content match "*val" is pointed at the previously restored
+  // copy instead of a fresh allocation, and must not be written to.
   // REQUIRES: status().ok()
   Status Lookup(StringPiece key, Tensor* val) TF_MUST_USE_RESULT;
 
+  // Looks up the tensor keyed by "key" and makes "*val" an alias of a
+  // read-only memory mapping of the bundle's data shard, instead of copying
+  // the bytes into a freshly allocated buffer.  The mapping stays valid after
+  // this reader is destroyed, for as long as any aliasing tensor is alive.
+  // Because the pages are file-backed, processes restoring the same bundle on
+  // one host share a single physical copy of the data.  The returned tensor
+  // must not be written to.
+  //
+  // Requires the tensor to be unpartitioned, of a plain (memcpy-able) dtype,
+  // stored in this machine's endianness, and placed at an offset aligned to
+  // EIGEN_MAX_ALIGN_BYTES (write the bundle with
+  // BundleWriter::Options::data_alignment to guarantee this).  Returns
+  // Unimplemented or FailedPrecondition otherwise, in which case callers
+  // should fall back to Lookup().
+  //
+  // Validates the stored crc32c checksum against the mapped bytes.
+  // REQUIRES: status().ok()
+  Status LookupMemmapped(StringPiece key, Tensor* val) TF_MUST_USE_RESULT;
+
   // Looks up the tensor pointed to by the internal iterator.
   //
   // On error, "val" may contain nonsense data.
@@ -310,6 +401,12 @@ class BundleReader {
                        const TensorSlice& slice_spec,
                        Tensor* val) TF_MUST_USE_RESULT;
 
+  // Returns in "*region" a read-only memory mapping of data shard "shard_id",
+  // creating it on first use.  The mapping is shared with the tensors returned
+  // by LookupMemmapped() and may therefore outlive this reader.
+  Status GetMemmappedShard(int shard_id,
+                           std::shared_ptr<ReadOnlyMemoryRegion>* region);
+
   Env* env_;  // Not owned.
   const string prefix_;
 
@@ -321,6 +418,10 @@ class BundleReader {
   // Owned the InputBuffer objects and their underlying RandomAccessFile's.
   std::unordered_map<int32, io::InputBuffer*> data_;
 
+  // Memory mappings of the data shards, created lazily by LookupMemmapped().
+  std::unordered_map<int32, std::shared_ptr<ReadOnlyMemoryRegion>>
+      mmap_regions_;
+
   // Maps each partitioned tensor's key to its stored slices (represented in a
   // TensorSliceSet).  Populated on-demand.
   std::unordered_map<string, checkpoint::TensorSliceSet*> tensor_slices_;
@@ -340,6 +441,27 @@ class BundleReader {
   TF_DISALLOW_COPY_AND_ASSIGN(BundleReader);
 };
 
+// Restores the tensor keyed by "key" from a chain of bundles: a full base
+// checkpoint followed by delta bundles, ordered oldest to newest.  The newest
+// full value of "key" found in the chain is read first; row deltas (written
+// with BundleWriter::AddRowDeltas) from every later bundle then overwrite the
+// matching first-dimension rows, in order.  "*val" is allocated by this
+// function with the dtype and shape of that full value.
+//
+// Tensors that have row deltas must be unpartitioned and of a memcpy-able
+// dtype; tensors without deltas degenerate to a plain lookup.  Returns
+// NotFound if no bundle in the chain holds a full value for "key".
+Status LookupWithRowDeltas(gtl::ArraySlice<BundleReader*> bundles,
+                           StringPiece key, Tensor* val);
+
+// Folds a chain of bundles (ordered oldest to newest, the first typically a
+// full checkpoint) into a single full bundle at "merged_prefix", resolving
+// every row delta via LookupWithRowDeltas().  Periodic compaction keeps
+// restore-time overlay chains short and bounds the number of delta files.
+// Processes one tensor at a time, so peak memory is the largest tensor.
+Status CompactRowDeltas(Env* env, gtl::ArraySlice<tstring> prefixes,
+                        StringPiece merged_prefix);
+
 // A buffering wrapper for a WritableFile.  Useful if the caller wishes to issue
 // small writes to a file (e.g. writing out a list of small varints).
 // External synchronization must be used in the presence of concurrent callers.
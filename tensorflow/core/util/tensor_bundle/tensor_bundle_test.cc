@@ -554,6 +554,113 @@ TEST(TensorBundleTest, Basic) {
   TestBasic<bfloat16>();
 }
 
+TEST(TensorBundleTest, AsyncWriter) {
+  {
+    AsyncBundleWriter writer(Env::Default(), Prefix("async"));
+    writer.Add("foo_003", Constant_2x3(3.f));
+    writer.Add("foo_000", Constant_2x3(0.f));
+    writer.Add("foo_002", Constant_2x3(2.f));
+    writer.Add("foo_001", Constant_2x3(1.f));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleReader reader(Env::Default(), Prefix("async"));
+    TF_ASSERT_OK(reader.status());
+    EXPECT_EQ(
+        AllTensorKeys(&reader),
+        std::vector<string>({"foo_000", "foo_001", "foo_002", "foo_003"}));
+    for (int i = 0; i < 4; ++i) {
+      Expect<float>(&reader, strings::StrCat("foo_00", i),
+                    Constant_2x3(static_cast<float>(i)));
+    }
+  }
+  {  // Errors from queued writes are reported by Finish().
+    AsyncBundleWriter writer(Env::Default(), Prefix("async_dup"));
+    writer.Add("foo", Constant_2x3(1.f));
+    writer.Add("foo", Constant_2x3(2.f));
+    EXPECT_FALSE(writer.Finish().ok());
+  }
+}
+
+TEST(TensorBundleTest, RowDeltas) {
+  // A full base checkpoint with a sparsely updated "table" and a dense "bias".
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta_base"));
+    TF_EXPECT_OK(writer.Add("table", Constant(0.f, TensorShape({5, 3}))));
+    TF_EXPECT_OK(writer.Add("bias", Constant_2x3(1.f)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  // First delta: rows 1 and 4 of "table" change.
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta_0"));
+    Tensor indices(DT_INT64, TensorShape({2}));
+    indices.vec<int64_t>()(0) = 1;
+    indices.vec<int64_t>()(1) = 4;
+    TF_EXPECT_OK(writer.AddRowDeltas(
+        "table", indices, Constant(10.f, TensorShape({2, 3}))));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  // Second delta: row 1 changes again and "bias" is rewritten in full.
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta_1"));
+    Tensor indices(DT_INT64, TensorShape({1}));
+    indices.vec<int64_t>()(0) = 1;
+    TF_EXPECT_OK(writer.AddRowDeltas(
+        "table", indices, Constant(20.f, TensorShape({1, 3}))));
+    TF_EXPECT_OK(writer.Add("bias", Constant_2x3(2.f)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+
+  Tensor expected_table = Constant(0.f, TensorShape({5, 3}));
+  for (int j = 0; j < 3; ++j) {
+    expected_table.matrix<float>()(1, j) = 20.f;
+    expected_table.matrix<float>()(4, j) = 10.f;
+  }
+
+  BundleReader base(Env::Default(), Prefix("delta_base"));
+  TF_ASSERT_OK(base.status());
+  BundleReader delta_0(Env::Default(), Prefix("delta_0"));
+  TF_ASSERT_OK(delta_0.status());
+  BundleReader delta_1(Env::Default(), Prefix("delta_1"));
+  TF_ASSERT_OK(delta_1.status());
+  const std::vector<BundleReader*> chain = {&base, &delta_0, &delta_1};
+  {
+    Tensor table;
+    TF_ASSERT_OK(LookupWithRowDeltas(chain, "table", &table));
+    test::ExpectTensorEqual<float>(table, expected_table);
+    // "bias" has no deltas; the newest full value wins.
+    Tensor bias;
+    TF_ASSERT_OK(LookupWithRowDeltas(chain, "bias", &bias));
+    test::ExpectTensorEqual<float>(bias, Constant_2x3(2.f));
+    Tensor missing;
+    EXPECT_EQ(LookupWithRowDeltas(chain, "no_such_key", &missing).code(),
+              error::NOT_FOUND);
+  }
+  // Compaction folds the chain back into a plain full bundle.
+  {
+    TF_ASSERT_OK(CompactRowDeltas(
+        Env::Default(),
+        {Prefix("delta_base"), Prefix("delta_0"), Prefix("delta_1")},
+        Prefix("delta_compacted")));
+    BundleReader reader(Env::Default(), Prefix("delta_compacted"));
+    TF_ASSERT_OK(reader.status());
+    EXPECT_EQ(AllTensorKeys(&reader),
+              std::vector<string>({"bias", "table"}));
+    Expect<float>(&reader, "table", expected_table);
+    Expect<float>(&reader, "bias", Constant_2x3(2.f));
+  }
+  // Malformed deltas are rejected at write time.
+  {
+    BundleWriter writer(Env::Default(), Prefix("delta_bad"));
+    Tensor indices(DT_INT64, TensorShape({2}));
+    EXPECT_FALSE(
+        writer
+            .AddRowDeltas("table", indices,
+                          Constant(0.f, TensorShape({3, 3})))
+            .ok());
+  }
+}
+
 TEST(TensorBundleTest, Endianness) {
   TestEndianness<float>();
   TestEndianness<double>();
@@ -951,6 +1058,86 @@ TEST(TensorBundleTest, SortForSequentialAccess) {
                           "tensor-1-2", "tensor-1-1", "tensor-1-0"));
 }
 
+TEST(TensorBundleTest, Memmapped) {
+  BundleWriter::Options options;
+  options.data_alignment = EIGEN_MAX_ALIGN_BYTES;
+  BundleWriter writer(Env::Default(), Prefix("mmap"), options);
+  TF_EXPECT_OK(writer.Add("foo_003", Constant_2x3(3.f)));
+  TF_EXPECT_OK(writer.Add("foo_000", Constant_2x3(0.f)));
+  TF_EXPECT_OK(writer.Add("str", test::AsTensor<tstring>({"hello"})));
+  TF_ASSERT_OK(writer.Finish());
+
+  Tensor val;
+  {
+    BundleReader reader(Env::Default(), Prefix("mmap"));
+    TF_ASSERT_OK(reader.status());
+    TF_ASSERT_OK(reader.LookupMemmapped("foo_000", &val));
+    test::ExpectTensorEqual<float>(val, Constant_2x3(0.f));
+    Tensor val2;
+    TF_ASSERT_OK(reader.LookupMemmapped("foo_003", &val2));
+    test::ExpectTensorEqual<float>(val2, Constant_2x3(3.f));
+
+    // String tensors cannot alias the stored bytes.
+    Tensor str_val;
+    EXPECT_EQ(reader.LookupMemmapped("str", &str_val).code(),
+              error::UNIMPLEMENTED);
+  }
+  // The mapping outlives the reader.
+  test::ExpectTensorEqual<float>(val, Constant_2x3(0.f));
+}
+
+TEST(TensorBundleTest, MemmappedUnaligned) {
+  // The default data_alignment of 1 densely packs tensors, so the second
+  // tensor added is not aligned for in-place use.
+  BundleWriter writer(Env::Default(), Prefix("unaligned"));
+  TF_EXPECT_OK(writer.Add("a", Constant(1.f, TensorShape({3}))));
+  TF_EXPECT_OK(writer.Add("b", Constant_2x3(2.f)));
+  TF_ASSERT_OK(writer.Finish());
+
+  BundleReader reader(Env::Default(), Prefix("unaligned"));
+  TF_ASSERT_OK(reader.status());
+  Tensor val;
+  EXPECT_EQ(reader.LookupMemmapped("b", &val).code(),
+            error::FAILED_PRECONDITION);
+}
+
+TEST(TensorBundleTest, DedupRestoredTensors) {
+  setenv("TF_TENSOR_BUNDLE_DEDUP_RESTORED_TENSORS", "1", 1);
+  // Large enough to qualify for deduplication.
+  const Tensor big = Constant(7.f, TensorShape({2048}));
+  {
+    BundleWriter writer(Env::Default(), Prefix("dedup0"));
+    TF_EXPECT_OK(writer.Add("big", big));
+    TF_EXPECT_OK(writer.Add("other", Constant(8.f, TensorShape({2048}))));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    BundleWriter writer(Env::Default(), Prefix("dedup1"));
+    TF_EXPECT_OK(writer.Add("big_alias", big));
+    TF_ASSERT_OK(writer.Finish());
+  }
+
+  Tensor val0, val1, other;
+  {
+    BundleReader reader(Env::Default(), Prefix("dedup0"));
+    TF_ASSERT_OK(reader.status());
+    TF_ASSERT_OK(reader.Lookup("big", &val0));
+    TF_ASSERT_OK(reader.Lookup("other", &other));
+  }
+  {
+    BundleReader reader(Env::Default(), Prefix("dedup1"));
+    TF_ASSERT_OK(reader.status());
+    TF_ASSERT_OK(reader.Lookup("big_alias", &val1));
+  }
+  unsetenv("TF_TENSOR_BUNDLE_DEDUP_RESTORED_TENSORS");
+
+  test::ExpectTensorEqual<float>(val1, big);
+  // Identical contents restored from different bundles share one buffer;
+  // different contents do not.
+  EXPECT_EQ(val0.tensor_data().data(), val1.tensor_data().data());
+  EXPECT_NE(val0.tensor_data().data(), other.tensor_data().data());
+}
+
 TEST(TensorBundleTest, Error) {
   {  // Dup keys.
     BundleWriter writer(Env::Default(), Prefix("dup"));
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/util/work_sharder.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/logging.h"
 
@@ -51,6 +54,67 @@ void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
       max_parallelism);
 }
 
+void ShardStealing(int max_parallelism, thread::ThreadPool* workers,
+                   int64_t total, int64_t cost_per_unit,
+                   std::function<void(int64_t, int64_t)> work) {
+  CHECK_GE(total, 0);
+  if (total == 0) {
+    return;
+  }
+  max_parallelism = std::min(max_parallelism, GetPerThreadMaxParallelism());
+  if (max_parallelism <= 1) {
+    // Just inline the whole work since we only have 1 thread (core).
+    work(0, total);
+    return;
+  }
+  cost_per_unit = std::max(int64_t{1}, cost_per_unit);
+  // The initial chunk holds roughly kMinCostPerChunk (~10us at 1ns/unit)
+  // worth of work so that cheap units are not claimed one at a time.
+  static const int64_t kMinCostPerChunk = 10000;
+  const int64_t min_chunk =
+      std::max(int64_t{1}, kMinCostPerChunk / cost_per_unit);
+  const int num_workers = std::max<int64_t>(
+      1, std::min<int64_t>({static_cast<int64_t>(max_parallelism),
+                            workers->NumThreads() + 1,
+                            (total + min_chunk - 1) / min_chunk}));
+  if (num_workers <= 1) {
+    work(0, total);
+    return;
+  }
+
+  // Shared cursor from which every participating thread claims chunks. The
+  // chunk doubles on each successful claim but stays a small fraction of the
+  // remaining work, so late chunks are fine-grained and the tail is spread
+  // evenly across threads.
+  std::atomic<int64_t> next(0);
+  auto steal_loop = [&next, &work, total, min_chunk, num_workers]() {
+    int64_t chunk = min_chunk;
+    while (true) {
+      const int64_t start = next.fetch_add(chunk, std::memory_order_relaxed);
+      if (start >= total) {
+        return;
+      }
+      const int64_t limit = std::min(start + chunk, total);
+      work(start, limit);
+      const int64_t remaining = total - limit;
+      const int64_t max_chunk =
+          std::max(min_chunk, remaining / (4 * num_workers));
+      chunk = std::min(chunk * 2, max_chunk);
+    }
+  };
+
+  BlockingCounter counter(num_workers - 1);
+  for (int i = 1; i < num_workers; ++i) {
+    workers->Schedule([&steal_loop, &counter]() {
+      steal_loop();
+      counter.DecrementCount();
+    });
+  }
+  // Participate from the calling thread as well.
+  steal_loop();
+  counter.Wait();
+}
+
 // DEPRECATED: Prefer threadpool->ParallelFor with SchedulingStrategy, which
 // allows you to specify the strategy for choosing shard sizes, including using
 // a fixed shard size.
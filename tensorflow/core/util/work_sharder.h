@@ -59,6 +59,28 @@ namespace tensorflow {
 void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
            int64_t cost_per_unit, std::function<void(int64_t, int64_t)> work);
 
+// Like Shard(), but divides [0, total) dynamically instead of into fixed
+// equal blocks: each participating thread repeatedly claims the next chunk of
+// indices from a shared atomic cursor, doubling its chunk size on every claim
+// (capped relative to the remaining work) to amortize the claim overhead.
+//
+// Prefer this over Shard() when the per-unit cost is skewed (ragged strings,
+// variable-length sparse rows): a static split leaves all but the unlucky
+// thread idle while the most expensive block finishes, whereas here threads
+// that finish early simply claim more work.
+//
+// "cost_per_unit" is used to size the initial chunk so that cheap units are
+// not claimed one at a time; the semantics of all arguments otherwise match
+// Shard().
+//
+// REQUIRES: max_parallelism >= 0
+// REQUIRES: workers != nullptr
+// REQUIRES: total >= 0
+// REQUIRES: cost_per_unit >= 0
+void ShardStealing(int max_parallelism, thread::ThreadPool* workers,
+                   int64_t total, int64_t cost_per_unit,
+                   std::function<void(int64_t, int64_t)> work);
+
 // Each thread has an associated option to express the desired maximum
 // parallelism. Its default is a very large quantity.
 //
@@ -90,6 +90,58 @@ TEST(Shard, OverflowTest) {
   }
 }
 
+void RunStealingSharding(int64_t num_workers, int64_t total,
+                         int64_t cost_per_unit,
+                         thread::ThreadPool* threads) {
+  mutex mu;
+  int64_t num_done_work = 0;
+  std::vector<bool> work(total, false);
+  ShardStealing(num_workers, threads, total, cost_per_unit,
+                [=, &mu, &num_done_work, &work](int64_t start, int64_t limit) {
+                  EXPECT_GE(start, 0);
+                  EXPECT_LE(limit, total);
+                  mutex_lock l(mu);
+                  for (; start < limit; ++start) {
+                    EXPECT_FALSE(work[start]);  // No duplicate
+                    ++num_done_work;
+                    work[start] = true;
+                  }
+                });
+  EXPECT_EQ(num_done_work, total);
+}
+
+TEST(ShardStealing, Basic) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  for (auto workers : {0, 1, 2, 3, 5, 7, 10, 11, 15, 100, 1000}) {
+    for (auto total : {0, 1, 7, 10, 64, 100, 256, 1000, 9999}) {
+      for (auto cost_per_unit : {0, 1, 11, 102, 1003, 10005, 1000007}) {
+        for (auto maxp : {1, 2, 4, 8, 100}) {
+          ScopedPerThreadMaxParallelism s(maxp);
+          RunStealingSharding(workers, total, cost_per_unit, &threads);
+        }
+      }
+    }
+  }
+}
+
+TEST(ShardStealing, SkewedWork) {
+  thread::ThreadPool threads(Env::Default(), "test", 8);
+  // Front-loaded cost: the last few units are orders of magnitude more
+  // expensive than the rest, which a static split assigns to one thread.
+  const int64_t total = 4096;
+  std::atomic<int64_t> num_elements(0);
+  ShardStealing(8, &threads, total, 100,
+                [&num_elements, total](int64_t start, int64_t limit) {
+                  for (int64_t i = start; i < limit; ++i) {
+                    if (i >= total - 4) {
+                      Env::Default()->SleepForMicroseconds(100);
+                    }
+                    num_elements++;
+                  }
+                });
+  EXPECT_EQ(num_elements.load(), total);
+}
+
 void BM_Sharding(::testing::benchmark::State& state) {
   const int arg = state.range(0);
 
@@ -97,5 +97,12 @@ int ReduceInBfloat16MaxGroupSize() {
   return 8;
 }
 
+bool EnableTwoLevelAllReduce() {
+  char* dtensor_enable_two_level_all_reduce_str =
+      std::getenv("DTENSOR_ENABLE_TWO_LEVEL_ALL_REDUCE");
+  if (dtensor_enable_two_level_all_reduce_str == nullptr) return false;
+  return true;
+}
+
 }  // namespace dtensor
 }  // namespace tensorflow
@@ -51,6 +51,11 @@ bool DoNotFuseReduceScatter();
 // reduce op.
 int ReduceInBfloat16MaxGroupSize();
 
+// Returns whether to lower all-reduces on CPU/GPU meshes that span multiple
+// hosts into a two-level hierarchy: a reduction within each host over the
+// local interconnect followed by a reduction across hosts over the network.
+bool EnableTwoLevelAllReduce();
+
 }  // namespace dtensor
 }  // namespace tensorflow
 
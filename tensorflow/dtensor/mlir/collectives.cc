@@ -102,6 +102,46 @@ StatusOr<mlir::Value> EmitAllGather(
   return all_gather.output();
 }
 
+StatusOr<mlir::Value> EmitAllToAll(
+    mlir::OpBuilder& builder, mlir::Value input,
+    const dtensor::Layout& src_layout, const dtensor::Layout& tgt_layout,
+    llvm::SmallPtrSet<mlir::Operation*, 4>* newly_created_ops) {
+  if (src_layout.IsEquivalent(tgt_layout)) return input;
+
+  if (src_layout.rank() != tgt_layout.rank()) {
+    return errors::InvalidArgument(
+        "Expected source and target layout to have the same rank, got ",
+        src_layout.rank(), " vs ", tgt_layout.rank());
+  }
+
+  const mlir::TensorType input_type =
+      input.getType().dyn_cast<mlir::TensorType>();
+  if (!input_type) {
+    return errors::Internal(
+        llvm::formatv("Cannot cast input_type : {0} to TensorType. Shape must "
+                      "be statically known before emitting AllToAll.",
+                      input.getType())
+            .str());
+  }
+
+  TF_ASSIGN_OR_RETURN(mlir::TensorType global_type,
+                      GlobalTypeFromLocalType(src_layout, input_type));
+  TF_ASSIGN_OR_RETURN(mlir::TensorType output_type,
+                      LocalTypeFromGlobalType(tgt_layout, global_type));
+
+  mlir::Location loc = DT_LOC2(input.getLoc(), "DTensorAllToAllOp");
+  mlir::TF::DTensorAllToAllOp all_to_all =
+      builder.create<mlir::TF::DTensorAllToAllOp>(
+          loc, output_type, input,
+          mlir::dtensor::LayoutAttr::get(builder.getContext(), src_layout),
+          mlir::dtensor::LayoutAttr::get(builder.getContext(), tgt_layout));
+  SetSingleLayoutOnOp(all_to_all, tgt_layout);
+
+  if (newly_created_ops != nullptr) newly_created_ops->insert(all_to_all);
+
+  return all_to_all.output();
+}
+
 StatusOr<const mlir::Value> EmitAllScatter(
     mlir::OpBuilder& builder, const mlir::Value& original_value,
     const Layout& original_layout, const Layout& desired_layout,
@@ -229,6 +269,44 @@ StatusOr<mlir::Value> EmitRelayout(
         "Attempted to relayout to a different global shape.");
   }
 
+  // If the relayout moves the sharding of one tensor dimension to another
+  // tensor dimension on the same mesh dimension, emit a single fused
+  // all-to-all instead of the all-gather + all-scatter sequence below. The
+  // all-to-all exchanges only 1/num_shards of the data that the all-gather
+  // would move.
+  int all_to_all_gather_dim = -1;
+  int all_to_all_scatter_dim = -1;
+  bool all_to_all_compatible = true;
+  for (int i = 0; i < src_layout.rank(); ++i) {
+    if (src_layout.sharding_spec(i) == tgt_layout.sharding_spec(i)) continue;
+    if (Layout::IsShardedSpec(src_layout.dim(i)) &&
+        !Layout::IsShardedSpec(tgt_layout.dim(i)) &&
+        all_to_all_gather_dim == -1) {
+      all_to_all_gather_dim = i;
+    } else if (!Layout::IsShardedSpec(src_layout.dim(i)) &&
+               Layout::IsShardedSpec(tgt_layout.dim(i)) &&
+               all_to_all_scatter_dim == -1) {
+      all_to_all_scatter_dim = i;
+    } else {
+      all_to_all_compatible = false;
+      break;
+    }
+  }
+  if (all_to_all_compatible && all_to_all_gather_dim >= 0 &&
+      all_to_all_scatter_dim >= 0 &&
+      src_layout.sharding_spec(all_to_all_gather_dim) ==
+          tgt_layout.sharding_spec(all_to_all_scatter_dim)) {
+    mlir::OpBuilder all_to_all_builder(input.getContext());
+    TF_RETURN_IF_ERROR(
+        SetBuilderInsertionAfterValue(input, all_to_all_builder));
+    TF_ASSIGN_OR_RETURN(mlir::Value all_to_all_result,
+                        EmitAllToAll(all_to_all_builder, input, src_layout,
+                                     tgt_layout, newly_created_ops));
+    if (!is_sparse) return all_to_all_result;
+    return EmitDenseToSparseToDense(all_to_all_builder, all_to_all_result,
+                                    newly_created_ops);
+  }
+
   absl::flat_hash_set<std::string> src_sharding_dims;
   for (int i = 0; i < src_layout.rank(); ++i)
     src_sharding_dims.emplace(src_layout.sharding_spec(i));
@@ -35,6 +35,16 @@ StatusOr<mlir::Value> EmitAllGather(
     const dtensor::Layout& src_layout, const dtensor::Layout& tgt_layout,
     llvm::SmallPtrSet<mlir::Operation*, 4>* newly_created_ops = nullptr);
 
+// Emits a fused all-to-all to convert `input` from `src_layout` to
+// `tgt_layout`. The layouts must differ in exactly two dimensions: one going
+// from sharded to unsharded and one going from unsharded to sharded on the
+// same mesh dimension. This moves only 1/num_shards of the data that the
+// equivalent all-gather + slice sequence would move.
+StatusOr<mlir::Value> EmitAllToAll(
+    mlir::OpBuilder& builder, mlir::Value input,
+    const dtensor::Layout& src_layout, const dtensor::Layout& tgt_layout,
+    llvm::SmallPtrSet<mlir::Operation*, 4>* newly_created_ops = nullptr);
+
 // Given an input layout and a desired layout, inserts the necessary slice to
 // slice the original value based on the device id. All ops created by this
 // function are added to new_created_ops.
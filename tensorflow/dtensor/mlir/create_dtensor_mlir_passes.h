@@ -117,6 +117,9 @@ CreateDTensorReduceScatterLoweringPass();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 CreateDTensorAllGatherLoweringPass();
 
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+CreateDTensorAllToAllLoweringPass();
+
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 CreateDTensorAllScatterLoweringPass();
 
@@ -183,6 +183,11 @@ void CreateDTensorMLIRPass(const mlir::TF::StandardPipelineOptions &options,
   // const only had one usage) as part of layout propagation.
   pm->addPass(mlir::createCSEPass());
 
+  // Lower the AllToAll collectives. This has to happen before the AllGather
+  // lowering since on non-TPU devices AllToAll is decomposed into an
+  // AllGather followed by an AllScatter.
+  pm->addPass(CreateDTensorAllToAllLoweringPass());
+
   // Lower the AllGather collectives. This has to happen before the all reduce
   // optimizations and AllGather may emit an AllReduce.
   pm->addPass(CreateDTensorAllGatherLoweringPass());
@@ -140,6 +140,84 @@ mlir::LogicalResult DTensorAllGatherOp::verify() {
   return mlir::success();
 }
 
+mlir::LogicalResult DTensorAllToAllOp::verify() {
+  DTensorAllToAllOp op = *this;
+  const tensorflow::dtensor::Layout input_layout = op.input_layout();
+  const tensorflow::dtensor::Layout output_layout = op.output_layout();
+
+  if (input_layout.rank() != output_layout.rank())
+    return op.emitOpError()
+           << "received input and output layouts of unequal ranks "
+           << input_layout.rank() << " and " << output_layout.rank();
+
+  int32_t gather_dim = -1;
+  int32_t scatter_dim = -1;
+  for (int32_t i = 0; i < input_layout.rank(); ++i) {
+    if (input_layout.sharding_spec(i) == output_layout.sharding_spec(i))
+      continue;
+    if (tensorflow::dtensor::Layout::IsShardedDimension(
+            input_layout.sharding_spec(i)) &&
+        tensorflow::dtensor::Layout::IsUnshardedDimension(
+            output_layout.sharding_spec(i)) &&
+        gather_dim == -1) {
+      gather_dim = i;
+    } else if (tensorflow::dtensor::Layout::IsUnshardedDimension(
+                   input_layout.sharding_spec(i)) &&
+               tensorflow::dtensor::Layout::IsShardedDimension(
+                   output_layout.sharding_spec(i)) &&
+               scatter_dim == -1) {
+      scatter_dim = i;
+    } else {
+      return op.emitOpError()
+             << "layout transition from " << input_layout.ToString() << " to "
+             << output_layout.ToString()
+             << " is not a single all-to-all exchange";
+    }
+  }
+
+  if (gather_dim == -1 || scatter_dim == -1 ||
+      input_layout.sharding_spec(gather_dim) !=
+          output_layout.sharding_spec(scatter_dim))
+    return op.emitOpError()
+           << "layout transition from " << input_layout.ToString() << " to "
+           << output_layout.ToString()
+           << " must unshard one dimension and shard another dimension on the "
+              "same mesh dimension";
+
+  RankedTensorType input_type =
+      op.input().getType().dyn_cast<RankedTensorType>();
+  if (!input_type) return mlir::success();
+
+  if (input_type.getRank() != input_layout.rank())
+    return op.emitOpError()
+           << "input layout rank " << input_layout.rank()
+           << " is not equal to input rank " << input_type.getRank();
+
+  RankedTensorType output_type =
+      op.output().getType().dyn_cast<RankedTensorType>();
+  if (!output_type) return mlir::success();
+
+  if (output_type.getRank() != output_layout.rank())
+    return op.emitOpError()
+           << "output layout rank " << output_layout.rank()
+           << " is not equal to output rank " << output_type.getRank();
+
+  std::vector<int64_t> computed_output_shape =
+      output_layout.LocalShapeFromGlobalShape(
+          input_layout.GlobalShapeFromLocalShape(input_type.getShape()));
+
+  for (int32_t i = 0; i < computed_output_shape.size(); ++i) {
+    if (computed_output_shape[i] != output_type.getShape()[i]) {
+      return op.emitOpError()
+             << "computed output shape " << computed_output_shape[i]
+             << " at dimension " << i << " is not equal to actual output shape "
+             << output_type.getShape()[i];
+    }
+  }
+
+  return mlir::success();
+}
+
 mlir::LogicalResult DTensorAllScatterOp::verify() {
   DTensorAllScatterOp op = *this;
   const tensorflow::dtensor::Layout input_layout = op.input_layout();
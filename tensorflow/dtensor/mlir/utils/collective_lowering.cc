@@ -36,6 +36,7 @@ limitations under the License.
 #include "mlir/Pass/Pass.h"  // from @llvm-project
 #include "mlir/Support/DebugStringHelper.h"  // from @llvm-project
 #include "tensorflow/compiler/mlir/tensorflow/transforms/collection_ops_util.h"
+#include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/dtensor/cc/constants.h"
 #include "tensorflow/dtensor/cc/dstatus.h"
 #include "tensorflow/dtensor/cc/dtensor_utils.h"
@@ -57,6 +58,7 @@ namespace {
 #define GEN_PASS_DEF_DTENSORALLREDUCELOWERING
 #define GEN_PASS_DEF_DTENSORREDUCESCATTERLOWERING
 #define GEN_PASS_DEF_DTENSORALLGATHERLOWERING
+#define GEN_PASS_DEF_DTENSORALLTOALLLOWERING
 #define GEN_PASS_DEF_DTENSORALLSCATTERLOWERING
 #include "tensorflow/dtensor/mlir/dtensor_passes.h.inc"
 
@@ -200,6 +202,115 @@ mlir::Operation* EmitCollectiveReduce(
   return collective_reduce;
 }
 
+// Maps every device in `mesh` (keyed by its device id relative to the mesh's
+// first device id) to the host it lives on. Returns an empty vector if the
+// mesh carries no global device names, in which case the host topology is
+// unknown.
+std::vector<std::string> DeviceIdToHost(const Mesh& mesh) {
+  const std::vector<std::string>& global_devices = mesh.global_devices();
+  if (global_devices.empty()) return {};
+
+  const int64 num_devices = mesh.global_device_ids().size();
+  if (global_devices.size() != num_devices) return {};
+
+  const int64 start_device_id = mesh.min_global_device_id();
+  std::vector<std::string> hosts(num_devices);
+  for (int64 i = 0; i < num_devices; ++i) {
+    const int64 relative_id = mesh.global_device_ids()[i] - start_device_id;
+    if (relative_id < 0 || relative_id >= num_devices) return {};
+    DeviceNameUtils::ParsedName parsed;
+    if (!DeviceNameUtils::ParseFullOrLocalName(global_devices[i], &parsed))
+      return {};
+    hosts[relative_id] =
+        "/job:" + parsed.job + "/task:" + std::to_string(parsed.task);
+  }
+  return hosts;
+}
+
+// Splits `group_assignment` into an intra-host stage and a cross-host stage.
+// Every group becomes one intra-host group per participating host, followed
+// by cross-host groups in which the j-th device of every host reduces the
+// host-local partial results. Returns false if the groups do not decompose
+// into a regular two-level hierarchy: every group must span more than one
+// host and every host must contribute the same number (> 1) of devices.
+bool BuildTwoLevelGroupAssignments(
+    const mlir::DenseIntElementsAttr& group_assignment,
+    const std::vector<std::string>& device_id_to_host,
+    mlir::OpBuilder& builder,
+    mlir::DenseIntElementsAttr* intra_host_group_assignment,
+    mlir::DenseIntElementsAttr* cross_host_group_assignment) {
+  if (device_id_to_host.empty()) return false;
+
+  const auto shape = group_assignment.getType().getShape();
+  const int32 num_groups = shape[0];
+  const int32 group_size = shape[1];
+
+  std::vector<int32> intra_groups_flat;
+  std::vector<int32> cross_groups_flat;
+  int32 devices_per_host = -1;
+  int32 hosts_per_group = -1;
+
+  llvm::SmallVector<std::string, 8> host_order;
+  llvm::SmallVector<llvm::SmallVector<int32, 8>, 8> devices_by_host;
+  auto values = group_assignment.getValues<llvm::APInt>();
+  auto value_it = values.begin();
+  for (int32 group = 0; group < num_groups; ++group) {
+    host_order.clear();
+    devices_by_host.clear();
+    for (int32 i = 0; i < group_size; ++i, ++value_it) {
+      const int64 device_id = (*value_it).getSExtValue();
+      if (device_id < 0 ||
+          device_id >= static_cast<int64>(device_id_to_host.size()))
+        return false;
+      const std::string& host = device_id_to_host[device_id];
+      auto host_it = llvm::find(host_order, host);
+      if (host_it == host_order.end()) {
+        host_order.push_back(host);
+        devices_by_host.push_back({static_cast<int32>(device_id)});
+      } else {
+        devices_by_host[host_it - host_order.begin()].push_back(device_id);
+      }
+    }
+
+    // The group must span more than one host, with more than one device per
+    // host -- otherwise one of the stages would be a no-op.
+    if (host_order.size() < 2) return false;
+    const int32 local_size = static_cast<int32>(devices_by_host.front().size());
+    if (local_size < 2) return false;
+    for (const auto& local_devices : devices_by_host)
+      if (static_cast<int32>(local_devices.size()) != local_size) return false;
+
+    // All groups must agree on the stage group sizes so that each stage can
+    // be expressed as a single rectangular group assignment.
+    const int32 num_hosts = static_cast<int32>(host_order.size());
+    if (devices_per_host == -1) devices_per_host = local_size;
+    if (hosts_per_group == -1) hosts_per_group = num_hosts;
+    if (local_size != devices_per_host || num_hosts != hosts_per_group)
+      return false;
+
+    for (const auto& local_devices : devices_by_host)
+      intra_groups_flat.insert(intra_groups_flat.end(), local_devices.begin(),
+                               local_devices.end());
+    for (int32 j = 0; j < local_size; ++j)
+      for (const auto& local_devices : devices_by_host)
+        cross_groups_flat.push_back(local_devices[j]);
+  }
+
+  const mlir::IntegerType int_type =
+      mlir::IntegerType::get(builder.getContext(), 32);
+  *intra_host_group_assignment = mlir::DenseIntElementsAttr::get(
+      mlir::RankedTensorType::get({num_groups * hosts_per_group,
+                                   devices_per_host},
+                                  int_type),
+      intra_groups_flat);
+  *cross_host_group_assignment = mlir::DenseIntElementsAttr::get(
+      mlir::RankedTensorType::get({num_groups * devices_per_host,
+                                   hosts_per_group},
+                                  int_type),
+      cross_groups_flat);
+  return true;
+}
+
 mlir::LogicalResult LowerAllReduceOpImpl(
     mlir::MLIRContext& context, mlir::OpBuilder& builder,
     mlir::TF::DTensorAllReduceOp all_reduce, mlir::Value* value) {
@@ -247,10 +358,38 @@ mlir::LogicalResult LowerAllReduceOpImpl(
     mlir::Value relative_device_id =
         builder.create<mlir::TF::SubOp>(loc, device_id, start_device_id);
 
-    final_op = EmitCollectiveReduce(
-        builder, loc, all_reduce.input(), all_reduce.reduce_op().str(),
-        group_assignment_attr, key_base, relative_device_id,
-        /*host_group_size=*/group_size, all_reduce.device_type().str());
+    // If enabled, split reductions that span multiple hosts into an
+    // intra-host stage and a cross-host stage, so that the bulk of the data
+    // movement happens over the fast local interconnect and only host-local
+    // partial results cross the network.
+    mlir::DenseIntElementsAttr intra_host_groups;
+    mlir::DenseIntElementsAttr cross_host_groups;
+    if (EnableTwoLevelAllReduce() &&
+        BuildTwoLevelGroupAssignments(
+            group_assignment_attr, DeviceIdToHost((*output_layout).mesh()),
+            builder, &intra_host_groups, &cross_host_groups)) {
+      const int32 cross_host_key_base = tf_collective_key_base++;
+      const int32 intra_group_size = intra_host_groups.getType().getShape()[1];
+      const int32 cross_group_size = cross_host_groups.getType().getShape()[1];
+      mlir::Operation* local_reduce = EmitCollectiveReduce(
+          builder, loc, all_reduce.input(), all_reduce.reduce_op().str(),
+          intra_host_groups, key_base, relative_device_id,
+          /*host_group_size=*/intra_group_size,
+          all_reduce.device_type().str());
+      // Mean becomes a mean of host-local means, which is exact because
+      // every host contributes the same number of devices to its group.
+      final_op = EmitCollectiveReduce(
+          builder, loc, local_reduce->getResult(0),
+          all_reduce.reduce_op().str(), cross_host_groups,
+          cross_host_key_base, relative_device_id,
+          /*host_group_size=*/cross_group_size,
+          all_reduce.device_type().str());
+    } else {
+      final_op = EmitCollectiveReduce(
+          builder, loc, all_reduce.input(), all_reduce.reduce_op().str(),
+          group_assignment_attr, key_base, relative_device_id,
+          /*host_group_size=*/group_size, all_reduce.device_type().str());
+    }
   }
   SetSingleLayoutOnOp(final_op, *output_layout);
   *value = final_op->getResult(0);
@@ -625,6 +764,119 @@ mlir::LogicalResult LowerAllGatherOp(mlir::TF::DTensorAllGatherOp all_gather) {
   return mlir::LogicalResult::success();
 }
 
+mlir::LogicalResult LowerAllToAllOp(mlir::TF::DTensorAllToAllOp all_to_all) {
+  const Layout src_layout = all_to_all.input_layout();
+  const Layout tgt_layout = all_to_all.output_layout();
+
+  // The op verifier guarantees that exactly one dimension becomes unsharded
+  // (the concat dimension) and exactly one dimension becomes sharded (the
+  // split dimension), both on the same mesh dimension.
+  int64 concat_dimension = -1;
+  int64 split_dimension = -1;
+  for (int64 i = 0; i < src_layout.rank(); ++i) {
+    if (src_layout.sharding_spec(i) == tgt_layout.sharding_spec(i)) continue;
+    if (Layout::IsShardedDimension(src_layout.sharding_spec(i)))
+      concat_dimension = i;
+    else
+      split_dimension = i;
+  }
+  if (concat_dimension < 0 || split_dimension < 0)
+    return all_to_all.emitOpError()
+           << "is not a single all-to-all exchange from layout "
+           << src_layout.ToString() << " to " << tgt_layout.ToString();
+
+  const std::string mesh_dim = src_layout.sharding_spec(concat_dimension);
+  const int64 num_shards =
+      src_layout.num_shards_for_dim(src_layout.dim(concat_dimension));
+
+  mlir::OpBuilder builder(all_to_all);
+  builder.setInsertionPointAfter(all_to_all);
+  const mlir::Location loc = DT_LOC(all_to_all.getLoc());
+
+  if (src_layout.mesh().is_tpu_mesh()) {
+    // For TPUs, lower to a single fused XLA AllToAll. Devices exchange data
+    // within groups of devices that only differ in their `mesh_dim`
+    // coordinate.
+    auto partitions_or_status = GetAllReducePartitionsFromReducedDims(
+        src_layout, absl::flat_hash_set<std::string>({mesh_dim}));
+    if (!partitions_or_status.ok())
+      return all_to_all.emitOpError()
+             << partitions_or_status.status().error_message();
+    auto partitions = partitions_or_status.value();
+    const int32 num_partitions = partitions.size();
+
+    std::vector<int32> partitions_flat;
+    for (auto& p : partitions) {
+      if (p.second.size() != partitions.begin()->second.size())
+        return all_to_all.emitOpError() << "partitions had different sizes -- "
+                                           "this is not supported in MLIR.";
+      partitions_flat.insert(partitions_flat.end(), p.second.begin(),
+                             p.second.end());
+    }
+    const int32 partition_size = partitions.begin()->second.size();
+    const mlir::RankedTensorType shaped_type = mlir::RankedTensorType::get(
+        {num_partitions, partition_size},
+        mlir::IntegerType::get(builder.getContext(), 32));
+    const mlir::DenseIntElementsAttr group_assignment =
+        mlir::DenseIntElementsAttr::get(shaped_type, partitions_flat);
+
+    mlir::TF::AllToAllOp xla_all_to_all = builder.create<mlir::TF::AllToAllOp>(
+        loc, all_to_all.output().getType(), all_to_all.input(),
+        builder.create<mlir::TF::ConstOp>(loc, group_assignment),
+        builder.getI64IntegerAttr(concat_dimension),
+        builder.getI64IntegerAttr(split_dimension),
+        builder.getI64IntegerAttr(num_shards));
+    SetSingleLayoutOnOp(xla_all_to_all, tgt_layout);
+    all_to_all.output().replaceAllUsesWith(xla_all_to_all.output());
+  } else {
+    // For non TPU devices, decompose to DTensorAllGather+DTensorAllScatter,
+    // which have device-specific lowerings of their own.
+    std::vector<std::string> intermediate_specs =
+        src_layout.sharding_spec_strs();
+    intermediate_specs[concat_dimension] = Layout::kUnshardedDim;
+    StatusOr<Layout> intermediate_layout =
+        Layout::GetLayout(intermediate_specs, src_layout.mesh());
+    if (!intermediate_layout.ok())
+      return all_to_all.emitOpError()
+             << intermediate_layout.status().error_message();
+
+    const mlir::TensorType input_type =
+        all_to_all.input().getType().dyn_cast<mlir::TensorType>();
+    if (!input_type)
+      return all_to_all.emitOpError() << "input type is not a TensorType";
+
+    StatusOr<mlir::TensorType> global_type =
+        GlobalTypeFromLocalType(src_layout, input_type);
+    if (!global_type.ok())
+      return all_to_all.emitOpError() << global_type.status().error_message();
+    StatusOr<mlir::TensorType> intermediate_type =
+        LocalTypeFromGlobalType(*intermediate_layout, *global_type);
+    if (!intermediate_type.ok())
+      return all_to_all.emitOpError()
+             << intermediate_type.status().error_message();
+
+    mlir::TF::DTensorAllGatherOp dtensor_all_gather =
+        builder.create<mlir::TF::DTensorAllGatherOp>(
+            loc, *intermediate_type, all_to_all.input(),
+            mlir::dtensor::LayoutAttr::get(builder.getContext(), src_layout),
+            mlir::dtensor::LayoutAttr::get(builder.getContext(),
+                                           *intermediate_layout));
+    SetSingleLayoutOnOp(dtensor_all_gather, *intermediate_layout);
+
+    mlir::TF::DTensorAllScatterOp dtensor_all_scatter =
+        builder.create<mlir::TF::DTensorAllScatterOp>(
+            loc, all_to_all.output().getType(), dtensor_all_gather.output(),
+            mlir::dtensor::LayoutAttr::get(builder.getContext(),
+                                           *intermediate_layout),
+            mlir::dtensor::LayoutAttr::get(builder.getContext(), tgt_layout));
+    SetSingleLayoutOnOp(dtensor_all_scatter, tgt_layout);
+    all_to_all.output().replaceAllUsesWith(dtensor_all_scatter.output());
+  }
+
+  all_to_all.erase();
+  return mlir::LogicalResult::success();
+}
+
 mlir::LogicalResult LowerAllScatterOp(
     mlir::TF::DTensorAllScatterOp all_scatter) {
   const Layout original_layout = all_scatter.input_layout();
@@ -785,6 +1037,23 @@ struct DTensorAllGatherLowering
   }
 };
 
+struct DTensorAllToAllLowering
+    : public impl::DTensorAllToAllLoweringBase<DTensorAllToAllLowering> {
+  void runOnOperation() override {
+    mlir::ModuleOp module = getOperation();
+
+    // Process all DTensorAllToAll ops.
+    llvm::SmallVector<mlir::TF::DTensorAllToAllOp, 4> all_to_alls;
+    module.walk([&](mlir::TF::DTensorAllToAllOp all_to_all) {
+      all_to_alls.emplace_back(all_to_all);
+    });
+
+    for (mlir::TF::DTensorAllToAllOp all_to_all : all_to_alls)
+      if (mlir::failed(LowerAllToAllOp(all_to_all)))
+        return signalPassFailure();
+  }
+};
+
 struct DTensorAllScatterLowering
     : public impl::DTensorAllScatterLoweringBase<DTensorAllScatterLowering> {
   void runOnOperation() override {
@@ -819,6 +1088,11 @@ CreateDTensorAllGatherLoweringPass() {
   return std::make_unique<DTensorAllGatherLowering>();
 }
 
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+CreateDTensorAllToAllLoweringPass() {
+  return std::make_unique<DTensorAllToAllLowering>();
+}
+
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 CreateDTensorAllScatterLoweringPass() {
   return std::make_unique<DTensorAllScatterLowering>();
@@ -18,8 +18,10 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -34,6 +36,46 @@ constexpr int32_t kNodeNotAssigned = std::numeric_limits<int32_t>::max();
 constexpr int32_t kLastActiveNodeUndefined =
     std::numeric_limits<int32_t>::max();
 
+// On-disk layout of a serialized allocation plan: a header followed by one
+// SerializedPlanAlloc per tensor, in tensor index order. The layout uses
+// host byte order and padding; the plan is a per-device cache, not a
+// portable format, and the version is bumped whenever the layout changes.
+constexpr uint32_t kSerializedPlanVersion = 1;
+
+struct SerializedPlanHeader {
+  uint32_t version;
+  uint32_t num_tensors;
+  uint64_t model_fingerprint;
+  uint64_t tensor_signature;
+};
+
+struct SerializedPlanAlloc {
+  uint64_t offset;
+  uint64_t size;
+  int32_t tensor;
+  int32_t first_node;
+  int32_t last_node;
+};
+
+// Hashes the tensor count and every tensor's size and allocation type
+// (FNV-1a), so a plan is only restored onto a graph with the exact shape
+// signature it was computed for.
+uint64_t ComputeTensorSignature(GraphInfo* graph_info) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  auto mix = [&hash](uint64_t value) {
+    hash ^= value;
+    hash *= 0x100000001b3ULL;
+  };
+  const size_t num_tensors = graph_info->num_tensors();
+  const TfLiteTensor* tensors = graph_info->tensors();
+  mix(num_tensors);
+  for (size_t i = 0; i < num_tensors; ++i) {
+    mix(tensors[i].bytes);
+    mix(static_cast<uint64_t>(tensors[i].allocation_type));
+  }
+  return hash;
+}
+
 }  // namespace
 
 ArenaPlanner::ArenaPlanner(TfLiteContext* context,
@@ -63,6 +105,83 @@ std::intptr_t ArenaPlanner::BasePointer(TfLiteAllocationType type) {
   return 0;
 }
 
+std::string ArenaPlanner::SerializeAllocationPlan(uint64_t model_fingerprint) {
+  const size_t num_tensors = graph_info_->num_tensors();
+  if (allocs_.empty() || allocs_.size() != num_tensors) return std::string();
+
+  SerializedPlanHeader header;
+  header.version = kSerializedPlanVersion;
+  header.num_tensors = static_cast<uint32_t>(num_tensors);
+  header.model_fingerprint = model_fingerprint;
+  header.tensor_signature = ComputeTensorSignature(graph_info_.get());
+
+  std::string plan;
+  plan.reserve(sizeof(header) + num_tensors * sizeof(SerializedPlanAlloc));
+  plan.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (size_t i = 0; i < num_tensors; ++i) {
+    SerializedPlanAlloc serialized;
+    memset(&serialized, 0, sizeof(serialized));
+    serialized.offset = allocs_[i].offset;
+    serialized.size = allocs_[i].size;
+    serialized.tensor = allocs_[i].tensor;
+    serialized.first_node = allocs_[i].first_node;
+    serialized.last_node = allocs_[i].last_node;
+    plan.append(reinterpret_cast<const char*>(&serialized),
+                sizeof(serialized));
+  }
+  return plan;
+}
+
+TfLiteStatus ArenaPlanner::RestoreAllocationPlan(const char* data, size_t size,
+                                                 uint64_t model_fingerprint) {
+  const size_t num_tensors = graph_info_->num_tensors();
+  TF_LITE_ENSURE(context_, data != nullptr);
+  TF_LITE_ENSURE(context_, size >= sizeof(SerializedPlanHeader));
+  SerializedPlanHeader header;
+  memcpy(&header, data, sizeof(header));
+  TF_LITE_ENSURE(context_, header.version == kSerializedPlanVersion);
+  TF_LITE_ENSURE(context_, header.model_fingerprint == model_fingerprint);
+  TF_LITE_ENSURE(context_, header.num_tensors == num_tensors);
+  TF_LITE_ENSURE(context_, header.tensor_signature ==
+                               ComputeTensorSignature(graph_info_.get()));
+  TF_LITE_ENSURE(context_,
+                 size == sizeof(header) +
+                             num_tensors * sizeof(SerializedPlanAlloc));
+  // PlanAllocations() must have run so incremental re-planning after the
+  // restore sees consistent lifetimes.
+  TF_LITE_ENSURE(context_, alloc_node_.size() == num_tensors);
+  TF_LITE_ENSURE(context_, allocs_.size() == num_tensors);
+
+  const TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<ArenaAllocWithUsageInterval> restored_allocs;
+  std::vector<ArenaAllocWithUsageInterval> restored_persistent_allocs;
+  const char* serialized_data = data + sizeof(header);
+  for (size_t i = 0; i < num_tensors; ++i) {
+    SerializedPlanAlloc serialized;
+    memcpy(&serialized, serialized_data, sizeof(serialized));
+    serialized_data += sizeof(serialized);
+    ArenaAllocWithUsageInterval& alloc = allocs_[i];
+    alloc.offset = serialized.offset;
+    alloc.size = serialized.size;
+    alloc.tensor = serialized.tensor;
+    alloc.first_node = serialized.first_node;
+    alloc.last_node = serialized.last_node;
+    if (alloc.tensor < 0 || alloc.size == 0) continue;
+    if (tensors[i].allocation_type == kTfLiteArenaRw) {
+      restored_allocs.push_back(alloc);
+    } else if (tensors[i].allocation_type == kTfLiteArenaRwPersistent) {
+      restored_persistent_allocs.push_back(alloc);
+    }
+  }
+  arena_.RestoreAllocs(restored_allocs);
+  persistent_arena_.RestoreAllocs(restored_persistent_allocs);
+  // The next ExecuteAllocations() finds every restored tensor already
+  // planned, commits the arenas at the restored high water marks and only
+  // resolves pointers.
+  last_active_node_ = 0;
+  return kTfLiteOk;
+}
+
 TfLiteStatus ArenaPlanner::ResetAllocations() {
   TF_LITE_ENSURE_STATUS(arena_.ClearPlan());
   TF_LITE_ENSURE_STATUS(persistent_arena_.ClearPlan());
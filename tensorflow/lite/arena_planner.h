@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
@@ -71,6 +72,27 @@ class ArenaPlanner : public MemoryPlanner {
   // Returns the base arena location for a given allocation type.
   std::intptr_t BasePointer(TfLiteAllocationType type);
 
+  // Serializes the computed allocation plan (per-tensor arena offsets and
+  // usage intervals) so a later process start can skip the offset
+  // computation. `model_fingerprint` should identify the model contents,
+  // e.g. a hash of the model flatbuffer; it is stored in the plan and
+  // checked on restore together with a signature of the current tensor
+  // sizes. Must be called after ExecuteAllocations(); returns an empty
+  // string if no plan has been computed. The result is a flat,
+  // position-independent buffer, so callers can persist it to a file and
+  // restore straight from mmapped data.
+  std::string SerializeAllocationPlan(uint64_t model_fingerprint);
+
+  // Installs a plan produced by SerializeAllocationPlan() on a planner whose
+  // PlanAllocations() has already run, seeding both arenas with the
+  // deserialized offsets so the next ExecuteAllocations() resolves tensors
+  // without recomputing offsets. Fails without modifying the planner if the
+  // plan's version, fingerprint or tensor signature doesn't match the
+  // current graph. The serializing and restoring planners must be configured
+  // identically (e.g. same `preserve_all_tensors`).
+  TfLiteStatus RestoreAllocationPlan(const char* data, size_t size,
+                                     uint64_t model_fingerprint);
+
  private:
   // Make sure all the arenas have reserved enough memory to store all their
   // tensors.
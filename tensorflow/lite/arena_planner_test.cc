@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <initializer_list>
 #include <memory>
 #include <set>
@@ -824,6 +825,65 @@ TEST_F(ArenaPlannerTest, DebugTensors) {
   EXPECT_EQ(tensorOffsets.size(), 8);
 }
 
+TEST_F(ArenaPlannerTest, SerializeAndRestoreAllocationPlan) {
+  constexpr uint64_t kFingerprint = 0x5ca1ab1e;
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  const std::string plan = planner_->SerializeAllocationPlan(kFingerprint);
+  ASSERT_FALSE(plan.empty());
+  std::vector<std::ptrdiff_t> offsets;
+  for (int i = 0; i <= 5; ++i) offsets.push_back(GetOffset(i));
+
+  // A fresh planner restoring the plan must resolve every tensor to the
+  // offsets the serializing planner computed.
+  TestGraph restored_graph({0, 1},
+                           {
+                               {{0, 1}, {2}, {}},
+                               {{2, 0}, {4, 5}, {}},
+                               {{4, 5}, {3}, {}},
+                           },
+                           {3});
+  SetGraph(&restored_graph);
+  ASSERT_EQ(planner_->RestoreAllocationPlan(plan.data(), plan.size(),
+                                            kFingerprint),
+            kTfLiteOk);
+  Execute(0, restored_graph.nodes().size() - 1);
+  for (int i = 0; i <= 5; ++i) {
+    EXPECT_EQ(GetOffset(i), offsets[i]);
+  }
+}
+
+TEST_F(ArenaPlannerTest, RestoreAllocationPlanRejectsMismatch) {
+  TestGraph graph({0, 1}, {{{0, 1}, {2}, {}}}, {2});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  const std::string plan = planner_->SerializeAllocationPlan(/*fingerprint=*/1);
+  ASSERT_FALSE(plan.empty());
+
+  // A different fingerprint is rejected.
+  TestGraph same_graph({0, 1}, {{{0, 1}, {2}, {}}}, {2});
+  SetGraph(&same_graph);
+  EXPECT_EQ(planner_->RestoreAllocationPlan(plan.data(), plan.size(),
+                                            /*fingerprint=*/2),
+            kTfLiteError);
+
+  // A graph with a different tensor signature is rejected.
+  TestGraph other_graph({0, 1}, {{{0, 1}, {2}, {}}, {{2, 1}, {3}, {}}}, {3});
+  SetGraph(&other_graph);
+  EXPECT_EQ(planner_->RestoreAllocationPlan(plan.data(), plan.size(),
+                                            /*fingerprint=*/1),
+            kTfLiteError);
+}
+
 TEST_F(ArenaPlannerTest, SimpleProfilerTest) {
   gNumAlloc = 0;
   gNumDealloc = 0;
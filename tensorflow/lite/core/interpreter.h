@@ -713,6 +713,29 @@ class Interpreter {
       int tensor_index, const TfLiteCustomAllocation& allocation,
       int64_t flags = kTfLiteCustomAllocationFlagsNone);
 
+  /// Registers a caller-owned buffer as a persistent binding for the given
+  /// tensor and returns a handle through `binding_handle`. The buffer must
+  /// satisfy the same conditions as SetCustomAllocationForTensor and
+  /// additionally becomes the tensor's current allocation. Its size is
+  /// validated against the tensor during AllocateTensors() and the result is
+  /// cached, so switching between registered buffers with
+  /// ApplyCustomAllocationBinding() needs no revalidation. Several buffers
+  /// can be registered for the same tensor, e.g. a rotating set of DMA
+  /// buffers delivered by a camera pipeline.
+  ///
+  /// WARNING: This is an experimental interface that is subject to change.
+  TfLiteStatus RegisterCustomAllocationForTensor(
+      int tensor_index, const TfLiteCustomAllocation& allocation,
+      int* binding_handle, int64_t flags = kTfLiteCustomAllocationFlagsNone);
+
+  /// Rebinds the previously registered buffer identified by `binding_handle`
+  /// to its tensor. Once the binding has been validated by
+  /// AllocateTensors(), this is a constant-time pointer update and Invoke()
+  /// can be called directly afterwards.
+  ///
+  /// WARNING: This is an experimental interface that is subject to change.
+  TfLiteStatus ApplyCustomAllocationBinding(int binding_handle);
+
   /// Apply InterpreterOptions which tunes behavior of the interpreter.
   /// WARNING: This is an experimental interface that is subject to change.
   TfLiteStatus ApplyOptions(InterpreterOptions* options);
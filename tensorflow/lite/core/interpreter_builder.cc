@@ -296,6 +296,24 @@ std::vector<int> FlatBufferIntArrayToVector(T* flat_array) {
   return ret;
 }
 
+// A flatbuffers int32 vector and a TfLiteIntArray share the same memory
+// layout on little-endian platforms: a 32-bit element count immediately
+// followed by the elements. Returns a TfLiteIntArray view over the (possibly
+// mmap'd) vector, or nullptr when the layouts do not match on this platform.
+const TfLiteIntArray* FlatBufferIntArrayView(
+    const flatbuffers::Vector<int32_t>* flat_array) {
+#if FLATBUFFERS_LITTLEENDIAN
+  static_assert(sizeof(flatbuffers::uoffset_t) == sizeof(int),
+                "TfLiteIntArray expects a 32-bit size field.");
+  if (flat_array == nullptr) {
+    return nullptr;
+  }
+  return reinterpret_cast<const TfLiteIntArray*>(flat_array);
+#else
+  return nullptr;
+#endif
+}
+
 // Used to determine how the op data parsing function creates its working space.
 class MallocDataAllocator : public BuiltinDataAllocator {
  public:
@@ -646,9 +664,23 @@ TfLiteStatus InterpreterBuilder::ParseTensors(
         status = kTfLiteError;
       }
 
-      if (subgraph->SetTensorParametersReadOnly(
-              i, type, get_name(tensor), dims, quantization, buffer_ptr,
-              buffer_size, allocation_, sparsity) != kTfLiteOk) {
+      const TfLiteIntArray* shared_dims = nullptr;
+      if (options_.GetShareTensorMetadataWithModel()) {
+        // Serve the shape metadata directly from the flatbuffer; the model is
+        // already required to outlive every interpreter built from it.
+        shared_dims = FlatBufferIntArrayView(tensor->shape());
+      }
+      if (shared_dims != nullptr) {
+        if (subgraph->SetTensorParametersReadOnly(
+                i, type, get_name(tensor), shared_dims, quantization,
+                buffer_ptr, buffer_size, allocation_, sparsity) != kTfLiteOk) {
+          error_reporter_->Report(
+              "Tensor %d is invalidly specified in schema.\n", i);
+          status = kTfLiteError;
+        }
+      } else if (subgraph->SetTensorParametersReadOnly(
+                     i, type, get_name(tensor), dims, quantization, buffer_ptr,
+                     buffer_size, allocation_, sparsity) != kTfLiteOk) {
         error_reporter_->Report("Tensor %d is invalidly specified in schema.\n",
                                 i);
         status = kTfLiteError;
@@ -44,6 +44,17 @@ TfLiteStatus Interpreter::SetCustomAllocationForTensor(
                                                          allocation, flags);
 }
 
+TfLiteStatus Interpreter::RegisterCustomAllocationForTensor(
+    int tensor_index, const TfLiteCustomAllocation& allocation,
+    int* binding_handle, int64_t flags) {
+  return primary_subgraph().RegisterCustomAllocationForTensor(
+      tensor_index, allocation, binding_handle, flags);
+}
+
+TfLiteStatus Interpreter::ApplyCustomAllocationBinding(int binding_handle) {
+  return primary_subgraph().ApplyCustomAllocationBinding(binding_handle);
+}
+
 TfLiteStatus Interpreter::ReleaseNonPersistentMemory() {
   // TODO(b/138790287): We could do this for all subgraphs whose tensors have
   // been allocated. However, AllocateTensors() relies on Control Flow ops to
@@ -35,6 +35,7 @@ limitations under the License.
 #include "tensorflow/lite/core/api/verifier.h"
 #include "tensorflow/lite/core/interpreter.h"
 #include "tensorflow/lite/interpreter_builder.h"
+#include "tensorflow/lite/interpreter_options.h"
 #include "tensorflow/lite/interpreter_test_util.h"
 #include "tensorflow/lite/kernels/register.h"
 #include "tensorflow/lite/model_builder.h"
@@ -268,6 +269,46 @@ TEST(BasicFlatBufferModel, TestModelInInterpreter) {
   }
 }
 
+TEST(BasicFlatBufferModel, TestShareTensorMetadataWithModel) {
+  auto model = FlatBufferModel::BuildFromFile(
+      "third_party/tensorflow/lite/testdata/test_model.bin");
+  ASSERT_TRUE(model);
+  InterpreterOptions options;
+  options.SetShareTensorMetadataWithModel();
+  std::unique_ptr<Interpreter> interpreter;
+  ASSERT_EQ(InterpreterBuilder(*model, TrivialResolver(&dummy_reg),
+                               &options)(&interpreter),
+            kTfLiteOk);
+  ASSERT_NE(interpreter, nullptr);
+  ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+
+  const char* model_base =
+      reinterpret_cast<const char*>(model->allocation()->base());
+  const char* model_end = model_base + model->allocation()->bytes();
+  auto within_model = [&](const void* p) {
+    const char* c = reinterpret_cast<const char*>(p);
+    return c >= model_base && c < model_end;
+  };
+
+  // The dims of the constant tensor are served from the model buffer, while
+  // read-write tensors keep their own heap copies.
+  TfLiteTensor* i0 = interpreter->tensor(0);
+  ASSERT_EQ(i0->allocation_type, kTfLiteMmapRo);
+  EXPECT_TRUE(within_model(i0->dims));
+  TfLiteTensor* i1 = interpreter->tensor(1);
+  ASSERT_EQ(i1->allocation_type, kTfLiteArenaRw);
+  EXPECT_FALSE(within_model(i1->dims));
+
+  // The shared dims are indistinguishable from an owned copy.
+  std::unique_ptr<Interpreter> reference_interpreter;
+  ASSERT_EQ(InterpreterBuilder(*model, TrivialResolver(&dummy_reg))(
+                &reference_interpreter),
+            kTfLiteOk);
+  TfLiteTensor* ref0 = reference_interpreter->tensor(0);
+  EXPECT_FALSE(within_model(ref0->dims));
+  EXPECT_TRUE(TfLiteIntArrayEqual(i0->dims, ref0->dims));
+}
+
 TEST(BasicFlatBufferModel, TestWithNumThreads) {
   TestErrorReporter reporter;
   auto model = FlatBufferModel::BuildFromFile(
@@ -23,9 +23,12 @@ limitations under the License.
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <functional>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
@@ -276,6 +279,13 @@ Subgraph::~Subgraph() {
     CleanupNode(node_index);
   }
 
+  // Dims shared with the model buffer are not owned by the tensors; detach
+  // them before `TfLiteTensorFree` runs below.
+  for (int tensor_index : tensors_with_shared_dims_) {
+    context_.tensors[tensor_index].dims = nullptr;
+  }
+  tensors_with_shared_dims_.clear();
+
   for (size_t i = 0; i < context_.tensors_size; i++) {
     TfLiteTensor* tensor = &context_.tensors[i];
     if (tensor->buffer_handle != kTfLiteNullBufferHandle) {
@@ -803,6 +813,11 @@ TfLiteStatus Subgraph::BytesRequired(TfLiteType type, const int* dims,
         MultiplyAndCheckOverflow(old_count, dims[k], &count) == kTfLiteOk,
         "BytesRequired number of elements overflowed.\n");
   }
+  // Int4 values are packed two to a byte.
+  if (type == kTfLiteInt4) {
+    *bytes = (count + 1) / 2;
+    return kTfLiteOk;
+  }
   size_t type_size = 0;
   TF_LITE_ENSURE_OK(&context_, GetSizeOfType(&context_, type, &type_size));
   TF_LITE_ENSURE_MSG(
@@ -842,6 +857,7 @@ TfLiteStatus Subgraph::AllocateTensors() {
             context(), custom_allocations_, idx));
       }
     }
+    TF_LITE_ENSURE_STATUS(ValidateCustomAllocationBindings());
     return kTfLiteOk;
   }
 
@@ -869,6 +885,10 @@ TfLiteStatus Subgraph::AllocateTensors() {
   // index that uses the tensor.
   InitializeTensorReleaseMap();
 
+  PartitionExecutionPlanForParallelInvoke();
+
+  TF_LITE_ENSURE_STATUS(ValidateCustomAllocationBindings());
+
   return kTfLiteOk;
 }
 
@@ -1229,8 +1249,11 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
     memory_planner_.reset(new SimplePlanner(&context_, CreateGraphInfo()));
 #else
+    // Parallel invocation keeps all tensors alive so that concurrent chains
+    // never alias each other's arena regions.
     memory_planner_ = std::make_unique<ArenaPlanner>(
-        &context_, CreateGraphInfo(), ShouldPreserveAllTensors(),
+        &context_, CreateGraphInfo(),
+        ShouldPreserveAllTensors() || ShouldParallelizeInvoke(),
         kDefaultTensorAlignment, subgraph_index_);
 #endif
     memory_planner_->PlanAllocations();
@@ -1336,6 +1359,157 @@ TfLiteStatus Subgraph::RemoveUnusedInputs() {
   return kTfLiteOk;
 }
 
+void Subgraph::PartitionExecutionPlanForParallelInvoke() {
+  parallel_invoke_chains_.clear();
+  if (!ShouldParallelizeInvoke() || has_dynamic_tensors_ ||
+      !delegates_applied_.empty() || execution_plan_.size() < 2) {
+    return;
+  }
+
+  // Tensors that some node writes during Invoke() order the nodes that touch
+  // them; constant tensors and subgraph inputs are read-only and can be
+  // shared freely between chains. Variable tensors carry state from one read
+  // to the next, so they are treated as written. Control flow ops may invoke
+  // other subgraphs, which is not thread-safe, so their presence disables
+  // partitioning altogether.
+  std::vector<bool> written_during_invoke(tensors_.size(), false);
+  for (int node_index : execution_plan_) {
+    const TfLiteNode& node = nodes_and_registration_[node_index].first;
+    const TfLiteRegistration& registration =
+        nodes_and_registration_[node_index].second;
+    switch (registration.builtin_code) {
+      case kTfLiteBuiltinIf:
+      case kTfLiteBuiltinWhile:
+      case kTfLiteBuiltinCallOnce:
+        return;
+      default:
+        break;
+    }
+    for (int i = 0; i < node.outputs->size; ++i) {
+      const int tensor_index = node.outputs->data[i];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      written_during_invoke[tensor_index] = true;
+    }
+  }
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    if (tensors_[i].is_variable) written_during_invoke[i] = true;
+  }
+
+  // Union-find over execution plan positions: two nodes belong to the same
+  // chain iff they are connected through a tensor written during Invoke().
+  std::vector<int> parent(execution_plan_.size());
+  for (size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+  std::function<int(int)> find_root = [&](int i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  std::vector<int> tensor_chain(tensors_.size(), -1);
+  for (size_t position = 0; position < execution_plan_.size(); ++position) {
+    const TfLiteNode& node =
+        nodes_and_registration_[execution_plan_[position]].first;
+    for (const TfLiteIntArray* tensor_indices :
+         {node.inputs, node.outputs, node.temporaries}) {
+      if (tensor_indices == nullptr) continue;
+      for (int i = 0; i < tensor_indices->size; ++i) {
+        const int tensor_index = tensor_indices->data[i];
+        if (tensor_index == kTfLiteOptionalTensor ||
+            !written_during_invoke[tensor_index]) {
+          continue;
+        }
+        if (tensor_chain[tensor_index] < 0) {
+          tensor_chain[tensor_index] = position;
+        } else {
+          parent[find_root(tensor_chain[tensor_index])] = find_root(position);
+        }
+      }
+    }
+  }
+
+  // Group the plan into chains, preserving node order within each chain.
+  std::map<int, int> root_to_chain;
+  for (size_t position = 0; position < execution_plan_.size(); ++position) {
+    const int root = find_root(position);
+    auto it = root_to_chain.find(root);
+    if (it == root_to_chain.end()) {
+      it = root_to_chain
+               .emplace(root,
+                        static_cast<int>(parallel_invoke_chains_.size()))
+               .first;
+      parallel_invoke_chains_.emplace_back();
+    }
+    parallel_invoke_chains_[it->second].push_back(execution_plan_[position]);
+  }
+  if (parallel_invoke_chains_.size() < 2) parallel_invoke_chains_.clear();
+}
+
+TfLiteStatus Subgraph::InvokeChain(const std::vector<int>& chain,
+                                   int* failed_node_index) {
+  // Eligibility checks in PartitionExecutionPlanForParallelInvoke() and the
+  // preserve-all-tensors memory plan guarantee that every tensor the chain
+  // touches is already allocated and that no node resizes a tensor, so the
+  // dynamic tensor handling of the serial path is not needed here.
+  for (int node_index : chain) {
+    TfLiteNode& node = nodes_and_registration_[node_index].first;
+    const TfLiteRegistration& registration =
+        nodes_and_registration_[node_index].second;
+
+    if (check_cancelled_func_ != nullptr &&
+        check_cancelled_func_(cancellation_data_)) {
+      return kTfLiteError;
+    }
+    if (continue_invocation_ && !continue_invocation_->test_and_set()) {
+      return kTfLiteCancelled;
+    }
+
+    if (auto s = OpInvoke(registration, &node); s != kTfLiteOk) {
+      *failed_node_index = node_index;
+      return s;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::InvokeParallel() {
+  EnsureTensorsVectorCapacity();
+  tensor_resized_since_op_invoke_ = false;
+
+  const size_t num_chains = parallel_invoke_chains_.size();
+  std::vector<TfLiteStatus> statuses(num_chains, kTfLiteOk);
+  std::vector<int> failed_node_indices(num_chains, -1);
+  std::vector<std::thread> workers;
+  workers.reserve(num_chains - 1);
+  for (size_t i = 1; i < num_chains; ++i) {
+    workers.emplace_back([this, i, &statuses, &failed_node_indices] {
+      statuses[i] = InvokeChain(parallel_invoke_chains_[i],
+                                &failed_node_indices[i]);
+    });
+  }
+  statuses[0] =
+      InvokeChain(parallel_invoke_chains_[0], &failed_node_indices[0]);
+  for (std::thread& worker : workers) worker.join();
+
+  // Error reporting is deferred until all chains have finished so the error
+  // reporter is only used from the invoking thread.
+  for (size_t i = 0; i < num_chains; ++i) {
+    if (statuses[i] == kTfLiteOk) continue;
+    const int node_index = failed_node_indices[i];
+    if (node_index < 0) {
+      ReportError("Client requested cancel during Invoke()");
+      return statuses[i];
+    }
+    auto err = ReportOpError(
+        &context_, nodes_and_registration_[node_index].first,
+        nodes_and_registration_[node_index].second, node_index,
+        "failed to invoke");
+    return statuses[i] == kTfLiteCancelled ? statuses[i] : err;
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus Subgraph::Invoke() {
   if (!consistent_) {
     ReportError("Invoke called on model that is not consistent.");
@@ -1356,6 +1530,19 @@ TfLiteStatus Subgraph::Invoke() {
       tflite::OnTfLiteSubgraphInvoke(name_.c_str(), subgraph_index_);
 #endif  // TF_LITE_TENSORFLOW_PROFILER
 
+  // Independent chains of the plan run concurrently when the partitioning
+  // computed at AllocateTensors() time found more than one and the whole plan
+  // is already prepared. Otherwise invocations are done in node order below.
+  if (parallel_invoke_chains_.size() > 1 &&
+      next_execution_plan_index_to_prepare_ >=
+          static_cast<int>(execution_plan_.size())) {
+    status = InvokeParallel();
+#ifdef TF_LITE_TENSORFLOW_PROFILER
+    tflite::OnTfLiteSubgraphInvokeEnd(trace_subgraph);
+#endif  // TF_LITE_TENSORFLOW_PROFILER
+    return status;
+  }
+
   // Invocations are always done in node order.
   // Note that calling Invoke repeatedly will cause the original memory plan to
   // be reused, unless either ResizeInputTensor() or AllocateTensors() has been
@@ -1580,6 +1767,7 @@ TfLiteStatus Subgraph::SetTensorParametersReadOnly(
 
   TF_LITE_ENSURE(&context_,
                  tensor_index < context_.tensors_size && tensor_index >= 0);
+  MaybeReleaseSharedDims(tensor_index);
 
   // For most tensors we know exactly how much memory is necessary so we can
   // ensure the buffer is large enough. However, we need to skip string tensors
@@ -1618,6 +1806,57 @@ TfLiteStatus Subgraph::SetTensorParametersReadOnly(
   return kTfLiteOk;
 }
 
+TfLiteStatus Subgraph::SetTensorParametersReadOnly(
+    int tensor_index, TfLiteType type, const char* name,
+    const TfLiteIntArray* shared_dims, TfLiteQuantization quantization,
+    const char* buffer, size_t bytes, const Allocation* allocation,
+    TfLiteSparsity* sparsity) {
+  // Ensure quantization cleanup on failure.
+  ScopedTfLiteQuantization scoped_quantization(&quantization);
+  ScopedTfLiteSparsity scoped_sparsity(sparsity);
+  if (state_ == kStateInvokableAndImmutable) {
+    ReportError(
+        "SetTensorParametersReadOnly is disallowed when graph is immutable.");
+    return kTfLiteError;
+  }
+
+  TF_LITE_ENSURE(&context_,
+                 tensor_index < context_.tensors_size && tensor_index >= 0);
+  TF_LITE_ENSURE(&context_, shared_dims != nullptr);
+  MaybeReleaseSharedDims(tensor_index);
+
+  // See the comment on the size check in the copying variant above.
+  if (type != kTfLiteString && type != kTfLiteResource &&
+      type != kTfLiteVariant && sparsity == nullptr) {
+    size_t required_bytes;
+    TF_LITE_ENSURE_OK(
+        &context_, BytesRequired(type, shared_dims->data, shared_dims->size,
+                                 &required_bytes));
+    TF_LITE_ENSURE_EQ(&context_, required_bytes, bytes);
+  }
+
+  TfLiteTensor& tensor = context_.tensors[tensor_index];
+  state_ = kStateUninvokable;
+  // The cast is safe: read-only tensors are never resized, and the dims are
+  // detached again via `MaybeReleaseSharedDims` before anything would hand
+  // them to `TfLiteTensorFree`.
+  TfLiteTensorReset(type, name, const_cast<TfLiteIntArray*>(shared_dims),
+                    GetLegacyQuantization(quantization),
+                    const_cast<char*>(buffer), bytes, kTfLiteMmapRo, allocation,
+                    false, &tensor);
+  tensor.quantization = *scoped_quantization.release();
+  tensor.sparsity = scoped_sparsity.release();
+  tensors_with_shared_dims_.insert(tensor_index);
+  return kTfLiteOk;
+}
+
+void Subgraph::MaybeReleaseSharedDims(int tensor_index) {
+  auto it = tensors_with_shared_dims_.find(tensor_index);
+  if (it == tensors_with_shared_dims_.end()) return;
+  context_.tensors[tensor_index].dims = nullptr;
+  tensors_with_shared_dims_.erase(it);
+}
+
 // Set description of inputs/outputs/data/fptrs for node `node_index`.
 // This variant assumes an external buffer has been allocated of size
 // bytes. The lifetime of buffer must be ensured to be greater or equal
@@ -1635,6 +1874,7 @@ TfLiteStatus Subgraph::SetTensorParametersReadWrite(
   }
   TF_LITE_ENSURE(&context_,
                  tensor_index < context_.tensors_size && tensor_index >= 0);
+  MaybeReleaseSharedDims(tensor_index);
   size_t required_bytes = 0;
   if (type != kTfLiteString && type != kTfLiteResource &&
       type != kTfLiteVariant) {
@@ -2046,6 +2286,62 @@ TfLiteStatus Subgraph::SetCustomAllocationForTensor(
   return kTfLiteOk;
 }
 
+TfLiteStatus Subgraph::RegisterCustomAllocationForTensor(
+    int tensor_index, const TfLiteCustomAllocation& allocation,
+    int* binding_handle, int64_t flags) {
+  TF_LITE_ENSURE(context(), binding_handle != nullptr);
+  TF_LITE_ENSURE_STATUS(
+      SetCustomAllocationForTensor(tensor_index, allocation, flags));
+  // The size check happens in AllocateTensors(), once tensor shapes have
+  // been propagated. If the tensor is already prepared, validate right away
+  // so the binding can be applied without another AllocateTensors() call.
+  bool validated = false;
+  const TfLiteTensor* tensor = &context_.tensors[tensor_index];
+  if (state_ != kStateUninvokable) {
+    TF_LITE_ENSURE(context(), allocation.bytes >= tensor->bytes);
+    validated = true;
+  }
+  custom_allocation_bindings_.push_back(
+      {tensor_index, allocation, validated});
+  *binding_handle = static_cast<int>(custom_allocation_bindings_.size()) - 1;
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::ApplyCustomAllocationBinding(int binding_handle) {
+  TF_LITE_ENSURE(
+      context(),
+      binding_handle >= 0 &&
+          binding_handle <
+              static_cast<int>(custom_allocation_bindings_.size()));
+  CustomAllocationBinding& binding =
+      custom_allocation_bindings_[binding_handle];
+  TfLiteTensor* tensor = &context_.tensors[binding.tensor_index];
+  TF_LITE_ENSURE(context(), tensor->allocation_type == kTfLiteCustom);
+  if (!binding.validated) {
+    TF_LITE_ENSURE(context(), binding.allocation.bytes >= tensor->bytes);
+    binding.validated = true;
+  }
+  custom_allocations_[binding.tensor_index] = binding.allocation;
+  tensor->data.data = binding.allocation.data;
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::ValidateCustomAllocationBindings() {
+  for (CustomAllocationBinding& binding : custom_allocation_bindings_) {
+    const TfLiteTensor& tensor = context_.tensors[binding.tensor_index];
+    if (binding.allocation.bytes < tensor.bytes) {
+      TF_LITE_KERNEL_LOG(
+          context(),
+          "Registered custom allocation is too small for tensor idx: %d",
+          binding.tensor_index);
+      binding.validated = false;
+      return kTfLiteError;
+    }
+    binding.validated = true;
+  }
+  return kTfLiteOk;
+}
+
 void Subgraph::SetName(const char* name) {
   if (name) {
     name_ = name;
@@ -130,6 +130,16 @@ class Subgraph {
       size_t bytes, const Allocation* allocation = nullptr,
       TfLiteSparsity* sparsity = nullptr);
 
+  // Same as above, but serves `shared_dims` directly instead of copying it to
+  // the heap. `shared_dims` is not owned by the subgraph and must outlive it;
+  // this is used to share immutable shape metadata between all interpreters
+  // built from one model.
+  TfLiteStatus SetTensorParametersReadOnly(
+      int tensor_index, TfLiteType type, const char* name,
+      const TfLiteIntArray* shared_dims, TfLiteQuantization quantization,
+      const char* buffer, size_t bytes, const Allocation* allocation = nullptr,
+      TfLiteSparsity* sparsity = nullptr);
+
   // Set description of inputs/outputs/data/fptrs for node `node_index`.
   // This variant assumes an external buffer has been allocated of size
   // bytes. The lifetime of buffer must be ensured to be greater or equal
@@ -371,6 +381,27 @@ class Subgraph {
       int tensor_index, const TfLiteCustomAllocation& allocation,
       int64_t flags = kTfLiteCustomAllocationFlagsNone);
 
+  // Registers a caller-owned buffer as a persistent binding for the given
+  // tensor and returns a handle through `binding_handle`. The same checks as
+  // SetCustomAllocationForTensor apply and the buffer becomes the tensor's
+  // current custom allocation; the buffer's size is validated against the
+  // tensor during AllocateTensors() and the result is cached, so switching
+  // between registered buffers with ApplyCustomAllocationBinding() is free.
+  // Several buffers can be registered for the same tensor.
+  //
+  // WARNING: This is an experimental interface that is subject to change.
+  TfLiteStatus RegisterCustomAllocationForTensor(
+      int tensor_index, const TfLiteCustomAllocation& allocation,
+      int* binding_handle, int64_t flags = kTfLiteCustomAllocationFlagsNone);
+
+  // Rebinds the previously registered buffer identified by `binding_handle`
+  // to its tensor. O(1) and revalidation-free once the binding has been
+  // validated by AllocateTensors(); no AllocateTensors() call is needed
+  // afterwards.
+  //
+  // WARNING: This is an experimental interface that is subject to change.
+  TfLiteStatus ApplyCustomAllocationBinding(int binding_handle);
+
   void SetName(const char* name);
   const std::string& GetName() const;
 
@@ -442,6 +473,13 @@ class Subgraph {
     return (options_ && options_->GetDisableDelegateClustering());
   }
 
+  // WARNING: This is an experimental API and subject to change.
+  // True if independent chains of the execution plan should be invoked
+  // concurrently.
+  bool ShouldParallelizeInvoke() const {
+    return (options_ && options_->GetParallelInvoke());
+  }
+
  private:
   friend class InterpreterBuilder;
   friend class TestDelegate;
@@ -534,12 +572,42 @@ class Subgraph {
                                     const std::vector<int>& execution_plan,
                                     int* last_execution_plan_index_prepared);
 
+  // Checks every registered custom allocation binding against its (now
+  // prepared) tensor and caches the result, so later
+  // ApplyCustomAllocationBinding() calls skip the size check. Called from
+  // AllocateTensors().
+  TfLiteStatus ValidateCustomAllocationBindings();
+
+  // Partitions `execution_plan_` into chains of nodes that don't share any
+  // tensor written during Invoke(), so the chains can be invoked
+  // concurrently. The result is stored in `parallel_invoke_chains_`, which
+  // stays empty when parallel invocation is disabled or the graph isn't
+  // eligible (dynamic tensors, delegates or control flow ops present, or the
+  // plan forms a single chain). Called from AllocateTensors().
+  void PartitionExecutionPlanForParallelInvoke();
+
+  // Invokes every chain in `parallel_invoke_chains_` on its own thread and
+  // reports the first failure, if any. Requires the whole plan to be
+  // prepared.
+  TfLiteStatus InvokeParallel();
+
+  // Invokes the nodes of one chain in order. On failure, fills
+  // `failed_node_index` with the offending node, or leaves it at -1 when the
+  // invocation was cancelled. Error reporting is left to the caller since
+  // chains run concurrently.
+  TfLiteStatus InvokeChain(const std::vector<int>& chain,
+                           int* failed_node_index);
+
   // Tensors needed by the interpreter. Use `AddTensors` to add more blank
   // tensor entries. Note, `tensors_.data()` needs to be synchronized to the
   // `context_` whenever this std::vector is reallocated. Currently this
   // only happens in `AddTensors()`.
   std::vector<TfLiteTensor> tensors_;
 
+  // Indices of tensors whose `dims` point into memory shared with the model
+  // buffer and are therefore not owned by the tensor.
+  std::unordered_set<int> tensors_with_shared_dims_;
+
   // Check if an array of tensor indices are valid with respect to the Tensor
   // array.
   // NOTE: this changes consistent_ to be false if indices are out of bounds.
@@ -565,6 +633,11 @@ class Subgraph {
   // type kTfLiteDynamic it will also be allocated new memory.
   TfLiteStatus ResizeTensorImpl(TfLiteTensor* tensor, TfLiteIntArray* new_size);
 
+  // If the given tensor serves its dims from memory shared with the model
+  // (see the `shared_dims` variant of `SetTensorParametersReadOnly`), detaches
+  // them so that `TfLiteTensorFree` does not attempt to free them.
+  void MaybeReleaseSharedDims(int tensor_index);
+
   // Report a detailed error string (will be printed to stderr).
   void ReportErrorImpl(const char* format, va_list args);
 
@@ -858,6 +931,12 @@ class Subgraph {
   // applied. It is empty if no delegates were applied to this Subgraph.
   std::vector<int> pre_delegation_execution_plan_;
 
+  // Chains of node indices that Invoke() may execute concurrently because
+  // they share no tensor written during invocation. Computed by
+  // PartitionExecutionPlanForParallelInvoke(); empty unless parallel
+  // invocation is enabled and at least two chains were found.
+  std::vector<std::vector<int>> parallel_invoke_chains_;
+
   // Contains a list of delegates applied by the user so far, in order.
   std::vector<TfLiteDelegate*> delegates_applied_;
 
@@ -877,6 +956,20 @@ class Subgraph {
   // Maps tensor index to custom allocation for all applicable tensors.
   std::map<int, TfLiteCustomAllocation> custom_allocations_;
 
+  // A caller-owned buffer registered once for a tensor, so it can be rebound
+  // per inference without revalidation. `validated` caches whether the
+  // buffer's size has been checked against the prepared tensor; it is
+  // refreshed whenever AllocateTensors() (re)plans allocations.
+  struct CustomAllocationBinding {
+    int tensor_index;
+    TfLiteCustomAllocation allocation;
+    bool validated;
+  };
+
+  // All buffers registered through RegisterCustomAllocationForTensor, indexed
+  // by binding handle.
+  std::vector<CustomAllocationBinding> custom_allocation_bindings_;
+
   // Tracking bit for whether a tensor was resized in the course of an op
   // invocation. This is a useful hint to ensure that dynamic tensor outputs
   // trigger downstream reallocation after op invocation.
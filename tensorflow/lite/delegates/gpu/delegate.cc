@@ -49,6 +49,7 @@ using delegates::Serialization;
 using delegates::SerializationParams;
 
 constexpr char kSerializedDataPrefix[] = "gpuv2_data_";
+constexpr char kBinaryCachePrefix[] = "gpuv2_binary_cache_";
 
 InferencePriority ToPriority(int32_t priority) {
   switch (priority) {
@@ -372,6 +373,19 @@ class DelegateKernel {
       RETURN_IF_ERROR(cl_environment_->NewInferenceBuilder(
           options, std::move(*graph), builder));
     } else {
+      // Compiled program binaries persisted by an earlier run speed up shader
+      // compilation even when the serialized model itself is missing or
+      // stale. The binaries are validated against the GPU driver version when
+      // they are added to the program cache and discarded on mismatch.
+      std::string serialized_binary_cache;
+      if (MaybeLoadBinaryCache(context, delegate_params, serialization,
+                               &serialized_binary_cache)
+              .ok()) {
+        env_options.serialized_binary_cache = absl::Span<const uint8_t>{
+            reinterpret_cast<const uint8_t*>(serialized_binary_cache.data()),
+            serialized_binary_cache.size()};
+      }
+
       // If serialization data is found, initialize CL from it & return early.
       if (MaybeInitializeSerializedOpenCL(context, delegate_params, builder,
                                           &options, &env_options, &properties,
@@ -391,6 +405,7 @@ class DelegateKernel {
 
       RETURN_IF_ERROR(SaveSerializedOpenCL(context, delegate_params, &options,
                                            serialization, serialized_model));
+      RETURN_IF_ERROR(SaveBinaryCache(context, delegate_params, serialization));
     }
 
     TFLITE_LOG_PROD_ONCE(tflite::TFLITE_LOG_INFO,
@@ -455,6 +470,45 @@ class DelegateKernel {
     return absl::OkStatus();
   }
 
+  // Returns Ok only if compiled program binaries from an earlier run are
+  // successfully found. The binaries are keyed per delegate kernel like the
+  // serialized model; compatibility with the GPU and its driver version is
+  // checked by the program cache when the data is loaded into it.
+  absl::Status MaybeLoadBinaryCache(TfLiteContext* context,
+                                    const TfLiteDelegateParams* delegate_params,
+                                    Serialization* serialization,
+                                    std::string* serialized_binary_cache) {
+    if (!serialization) return absl::InvalidArgumentError("No serialization");
+    auto data_key = serialization->GetEntryForKernel(kBinaryCachePrefix,
+                                                     context, delegate_params);
+    if (data_key.GetData(context, serialized_binary_cache) != kTfLiteOk) {
+      return absl::NotFoundError("Binary cache data not found");
+    }
+    return absl::OkStatus();
+  }
+
+  // Persists the compiled program binaries of the current environment so the
+  // next cold start can skip OpenCL program compilation.
+  absl::Status SaveBinaryCache(TfLiteContext* context,
+                               const TfLiteDelegateParams* delegate_params,
+                               Serialization* serialization) {
+    if (!serialization) return absl::InvalidArgumentError("No serialization");
+    std::vector<uint8_t> binary_cache =
+        cl_environment_->GetSerializedBinaryCache();
+    // Devices without program binary support produce no data; that is not an
+    // error.
+    if (binary_cache.empty()) return absl::OkStatus();
+    auto data_key = serialization->GetEntryForKernel(kBinaryCachePrefix,
+                                                     context, delegate_params);
+    auto save_status = data_key.SetData(
+        context, reinterpret_cast<const char*>(binary_cache.data()),
+        binary_cache.size());
+    if (save_status != kTfLiteOk) {
+      return absl::InvalidArgumentError("Failed to save binary cache data");
+    }
+    return absl::OkStatus();
+  }
+
   absl::Status InitializeOpenGlApi(GraphFloat32* graph,
                                    std::unique_ptr<InferenceBuilder>* builder) {
 #ifndef CL_DELEGATE_NO_GL
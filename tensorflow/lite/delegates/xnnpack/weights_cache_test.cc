@@ -164,6 +164,49 @@ TEST(XNNPACK_WEIGHTS_CACHE, SoftFinalization) {
   ASSERT_EQ(kTfLiteOk, interpreter2->Invoke());
 }
 
+TEST(XNNPACK_WEIGHTS_CACHE, SharedByKey) {
+  std::vector<char> buffer = Conv2DTester().CreateTfLiteModel();
+  const Model* model = GetModel(buffer.data());
+  ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+
+  constexpr char kCacheKey[] = "weights_cache_test_shared_by_key";
+  TfLiteXNNPackDelegateWeightsCache* cache =
+      TfLiteXNNPackDelegateWeightsCacheAcquireShared(kCacheKey);
+  ASSERT_NE(cache, nullptr);
+  // A second acquisition under the same key resolves to the same cache.
+  ASSERT_EQ(cache, TfLiteXNNPackDelegateWeightsCacheAcquireShared(kCacheKey));
+
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.weights_cache = cache;
+
+  std::vector<std::unique_ptr<Interpreter>> interpreters;
+  std::vector<
+      std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>>
+      delegates;
+  for (int i = 0; i < 2; i++) {
+    std::unique_ptr<Interpreter> interpreter;
+    ASSERT_EQ(kTfLiteOk, InterpreterBuilder(model, resolver)(&interpreter));
+    ASSERT_EQ(kTfLiteOk, interpreter->AllocateTensors());
+    delegates.emplace_back(TfLiteXNNPackDelegateCreate(&delegate_options),
+                           TfLiteXNNPackDelegateDelete);
+    ASSERT_EQ(kTfLiteOk,
+              interpreter->ModifyGraphWithDelegate(delegates.back().get()));
+    // Shared finalization is idempotent, so every sharer can call it after
+    // building its interpreter.
+    ASSERT_TRUE(TfLiteXNNPackDelegateWeightsCacheFinalizeShared(kCacheKey));
+    interpreters.push_back(std::move(interpreter));
+  }
+  for (auto& interpreter : interpreters) {
+    ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+  }
+
+  interpreters.clear();
+  delegates.clear();
+  TfLiteXNNPackDelegateWeightsCacheReleaseShared(kCacheKey);
+  TfLiteXNNPackDelegateWeightsCacheReleaseShared(kCacheKey);
+}
+
 // Dummy class to use with parameterized test.
 class WeightsCacheTest : public testing::TestWithParam<size_t> {};
 
@@ -24,6 +24,7 @@ limitations under the License.
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -5888,6 +5889,81 @@ void TfLiteXNNPackDelegateWeightsCacheDelete(
   xnn_deinitialize();
 }
 
+namespace {
+
+// Process-wide registry of weights caches shared across delegate instances,
+// keyed by a caller-chosen model fingerprint.
+struct SharedWeightsCacheEntry {
+  TfLiteXNNPackDelegateWeightsCache* cache = nullptr;
+  int ref_count = 0;
+  bool finalized = false;
+};
+
+std::mutex& SharedWeightsCacheMutex() {
+  static std::mutex* mutex = new std::mutex;
+  return *mutex;
+}
+
+std::unordered_map<std::string, SharedWeightsCacheEntry>&
+SharedWeightsCacheRegistry() {
+  static auto* registry =
+      new std::unordered_map<std::string, SharedWeightsCacheEntry>();
+  return *registry;
+}
+
+}  // namespace
+
+TfLiteXNNPackDelegateWeightsCache*
+TfLiteXNNPackDelegateWeightsCacheAcquireShared(const char* cache_key) {
+  if (cache_key == nullptr || cache_key[0] == '\0') {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(SharedWeightsCacheMutex());
+  SharedWeightsCacheEntry& entry = SharedWeightsCacheRegistry()[cache_key];
+  if (entry.cache == nullptr) {
+    entry.cache = TfLiteXNNPackDelegateWeightsCacheCreate();
+    if (entry.cache == nullptr) {
+      SharedWeightsCacheRegistry().erase(cache_key);
+      return nullptr;
+    }
+  }
+  ++entry.ref_count;
+  return entry.cache;
+}
+
+bool TfLiteXNNPackDelegateWeightsCacheFinalizeShared(const char* cache_key) {
+  if (cache_key == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(SharedWeightsCacheMutex());
+  auto it = SharedWeightsCacheRegistry().find(cache_key);
+  if (it == SharedWeightsCacheRegistry().end() || it->second.cache == nullptr) {
+    return false;
+  }
+  if (!it->second.finalized) {
+    // Soft finalization leaves room for cache hits from interpreters that are
+    // built later, which an open-ended number of sharers requires.
+    it->second.finalized =
+        TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(it->second.cache);
+  }
+  return it->second.finalized;
+}
+
+void TfLiteXNNPackDelegateWeightsCacheReleaseShared(const char* cache_key) {
+  if (cache_key == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(SharedWeightsCacheMutex());
+  auto it = SharedWeightsCacheRegistry().find(cache_key);
+  if (it == SharedWeightsCacheRegistry().end()) {
+    return;
+  }
+  if (--it->second.ref_count <= 0) {
+    TfLiteXNNPackDelegateWeightsCacheDelete(it->second.cache);
+    SharedWeightsCacheRegistry().erase(it);
+  }
+}
+
 TfLiteXNNPackDelegateOptions TfLiteXNNPackDelegateOptionsDefault() {
   TfLiteXNNPackDelegateOptions options = {0};
 
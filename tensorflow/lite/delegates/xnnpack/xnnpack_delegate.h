@@ -102,6 +102,40 @@ TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
 TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheDelete(
     struct TfLiteXNNPackDelegateWeightsCache* cache);
 
+// Returns a process-wide weights cache shared by all delegate instances that
+// pass the same non-empty cache key, creating the cache on first use. The key
+// must identify the model contents (e.g. a fingerprint of the model
+// flatbuffer), since every sharer reuses the same packed weights. Packing is
+// copy-on-first-pack: the first interpreter built against the cache packs the
+// weights, and interpreters built afterwards under the same key reuse the
+// packed copies instead of repacking per instance.
+//
+// Each successful call adds one reference to the cache; match it with a
+// `TfLiteXNNPackDelegateWeightsCacheReleaseShared` call. Returns NULL on
+// error.
+//
+// WARNING: This API is experimental and subject to change.
+TFL_CAPI_EXPORT struct TfLiteXNNPackDelegateWeightsCache*
+TfLiteXNNPackDelegateWeightsCacheAcquireShared(const char* cache_key);
+
+// Soft-finalizes the shared weights cache registered under `cache_key`.
+// Unlike `TfLiteXNNPackDelegateWeightsCacheFinalizeSoft`, this call is
+// idempotent: every thread can call it after building its interpreter, and
+// only the first call finalizes the cache. Soft finalization is used so that
+// interpreters built later under the same key can still take cache hits.
+// Returns true if the cache is finalized when the call returns.
+//
+// WARNING: This API is experimental and subject to change.
+TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheFinalizeShared(
+    const char* cache_key);
+
+// Releases one reference on the shared weights cache registered under
+// `cache_key`. The cache is destroyed when the last reference is released.
+//
+// WARNING: This API is experimental and subject to change.
+TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheReleaseShared(
+    const char* cache_key);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
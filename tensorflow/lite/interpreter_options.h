@@ -28,7 +28,9 @@ class InterpreterOptions {
       : experimental_preserve_all_tensors_(false),
         experimental_ensure_dynamic_tensors_are_released_(false),
         experimental_optimize_memory_for_large_tensors_(0),
-        experimental_disable_delegate_clustering_(false) {}
+        experimental_disable_delegate_clustering_(false),
+        experimental_parallel_invoke_(false),
+        experimental_share_tensor_metadata_with_model_(false) {}
 
   /// Preserving all intermediates tensors for debugging.
   /// WARNING: This is an experimental API and subject to change.
@@ -92,11 +94,47 @@ class InterpreterOptions {
     experimental_disable_delegate_clustering_ = value;
   }
 
+  /// Execute independent chains of the execution plan concurrently, one
+  /// thread per chain. Chains are computed when tensors are allocated, so
+  /// this option must be applied before `AllocateTensors`. Parallel
+  /// invocation requires a fully static graph without delegates or control
+  /// flow ops, and all (custom) kernels in the model must be thread-safe.
+  /// Enabling it also disables arena sharing between tensors, which
+  /// increases memory usage.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetParallelInvoke(bool value = true) {
+    experimental_parallel_invoke_ = value;
+  }
+
+  /// Returns if the `experimental_parallel_invoke_` feature is enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetParallelInvoke() { return experimental_parallel_invoke_; }
+
+  /// Serve immutable tensor metadata (currently the shapes of constant
+  /// tensors) directly from the model flatbuffer instead of copying it into
+  /// every interpreter. This reduces startup time and per-interpreter memory
+  /// when many interpreters are built from one large model. The model must
+  /// outlive every interpreter built from it, which `InterpreterBuilder`
+  /// already requires for the tensor data itself.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetShareTensorMetadataWithModel(bool value = true) {
+    experimental_share_tensor_metadata_with_model_ = value;
+  }
+
+  /// Returns if the `experimental_share_tensor_metadata_with_model_` feature
+  /// is enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetShareTensorMetadataWithModel() {
+    return experimental_share_tensor_metadata_with_model_;
+  }
+
  private:
   bool experimental_preserve_all_tensors_;
   bool experimental_ensure_dynamic_tensors_are_released_;
   int experimental_optimize_memory_for_large_tensors_;
   bool experimental_disable_delegate_clustering_;
+  bool experimental_parallel_invoke_;
+  bool experimental_share_tensor_metadata_with_model_;
 };
 
 }  // namespace tflite
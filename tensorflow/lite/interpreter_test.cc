@@ -1121,6 +1121,51 @@ TEST(BasicInterpreter, ReleaseDynamicTensors) {
   ASSERT_EQ(interpreter.tensor(3)->bytes, sizeof(float) * 6 * 6);
 }
 
+TEST(BasicInterpreter, ParallelInvokeIndependentChains) {
+  // Assemble a graph with two fully independent chains of two add ops each:
+  // 0 -> 2 -> 4 and 1 -> 3 -> 5. With parallel invocation enabled, the two
+  // chains execute concurrently.
+  Interpreter interpreter;
+  interpreter.AddTensors(6);
+  interpreter.SetInputs({0, 1});
+  interpreter.SetOutputs({4, 5});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(interpreter.SetTensorParametersReadWrite(i, kTfLiteFloat32, "",
+                                                       {3}, quant),
+              kTfLiteOk);
+  }
+  auto* add_reg = ops::builtin::Register_ADD();
+  for (const auto& edge : std::vector<std::pair<int, int>>{
+           {0, 2}, {2, 4}, {1, 3}, {3, 5}}) {
+    TfLiteAddParams* builtin_data =
+        reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+    builtin_data->activation = kTfLiteActNone;
+    ASSERT_EQ(interpreter.AddNodeWithParameters({edge.first, edge.first},
+                                                {edge.second}, nullptr, 0,
+                                                builtin_data, add_reg),
+              kTfLiteOk);
+  }
+
+  InterpreterOptions options;
+  options.SetParallelInvoke();
+  ASSERT_EQ(interpreter.ApplyOptions(&options), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  for (int i = 0; i < 3; ++i) {
+    interpreter.typed_tensor<float>(0)[i] = i + 1.f;
+    interpreter.typed_tensor<float>(1)[i] = 10.f * (i + 1);
+  }
+  // Invoke twice to make sure the memory plan survives parallel invocation.
+  for (int run = 0; run < 2; ++run) {
+    ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(interpreter.typed_tensor<float>(4)[i], 4.f * (i + 1));
+      EXPECT_EQ(interpreter.typed_tensor<float>(5)[i], 40.f * (i + 1));
+    }
+  }
+}
+
 TEST(InterpreterTensorsCapacityTest, TestWithinHeadroom) {
   Interpreter interpreter;
   ASSERT_EQ(interpreter.AddTensors(Interpreter::kTensorsReservedCapacity),
@@ -1927,6 +1972,52 @@ TEST_F(TestCustomAllocation, CustomInputAlloc_AllocateTensorsBefore) {
   VerifyInvoke();
 }
 
+TEST_F(TestCustomAllocation, RegisteredBindings_SwitchBetweenBuffers) {
+  // Register two buffers for the same input tensor, as a camera pipeline
+  // rotating through DMA buffers would.
+  const int input_idx = interpreter_->inputs()[0];
+  const TfLiteTensor* input_tensor = interpreter_->tensor(input_idx);
+  auto first_alloc =
+      NewCustomAlloc(input_tensor->bytes, kDefaultTensorAlignment);
+  auto second_alloc =
+      NewCustomAlloc(input_tensor->bytes, kDefaultTensorAlignment);
+  int first_handle = -1;
+  int second_handle = -1;
+  ASSERT_EQ(interpreter_->RegisterCustomAllocationForTensor(
+                input_idx, first_alloc, &first_handle),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->RegisterCustomAllocationForTensor(
+                input_idx, second_alloc, &second_handle),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  // Rebinding after AllocateTensors needs no further AllocateTensors calls.
+  ASSERT_EQ(interpreter_->ApplyCustomAllocationBinding(first_handle),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->tensor(input_idx)->data.data, first_alloc.data);
+  VerifyInvoke();
+
+  ASSERT_EQ(interpreter_->ApplyCustomAllocationBinding(second_handle),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->tensor(input_idx)->data.data, second_alloc.data);
+  VerifyInvoke();
+}
+
+TEST_F(TestCustomAllocation, RegisteredBindings_InsufficientBytes) {
+  auto input_alloc = NewCustomAlloc(4, kDefaultTensorAlignment);
+  int handle = -1;
+  // Registering works, but AllocateTensors rejects the undersized buffer.
+  ASSERT_EQ(interpreter_->RegisterCustomAllocationForTensor(
+                interpreter_->inputs()[0], input_alloc, &handle),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteError);
+}
+
+TEST_F(TestCustomAllocation, RegisteredBindings_InvalidHandle) {
+  ASSERT_EQ(interpreter_->ApplyCustomAllocationBinding(0), kTfLiteError);
+  ASSERT_EQ(interpreter_->ApplyCustomAllocationBinding(-1), kTfLiteError);
+}
+
 TEST_F(TestCustomAllocation, CustomInputAndOutputAllocs) {
   // Set custom allocations for all IO tensors.
   AssignCustomAllocForTensor(interpreter_->inputs()[0],
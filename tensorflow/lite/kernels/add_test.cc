@@ -193,6 +193,26 @@ TEST(FloatAddOpModel, WithBroadcastGeneric) {
                                                0.4, 0.5, 0.5, 0.6, 0.6, 0.7})));
 }
 
+TEST(FloatAddOpModel, WithBroadcastGeneric5D) {
+  // Both inputs broadcast in alternating dimensions, which does not fit the
+  // fivefold pattern.
+  std::vector<int> test_shape1 = {2, 1, 3, 1, 2};
+  std::vector<int> test_shape2 = {1, 2, 1, 2, 1};
+  FloatAddOpModel m({TensorType_FLOAT32, test_shape1},
+                    {TensorType_FLOAT32, test_shape2}, {TensorType_FLOAT32, {}},
+                    ActivationFunctionType_NONE);
+  m.PopulateTensor<float>(m.input1(),
+                          {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12});
+  m.PopulateTensor<float>(m.input2(), {10, 20, 30, 40});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutput(),
+              ElementsAreArray(ArrayFloatNear(
+                  {11, 12, 21, 22, 13, 14, 23, 24, 15, 16, 25, 26,
+                   31, 32, 41, 42, 33, 34, 43, 44, 35, 36, 45, 46,
+                   17, 18, 27, 28, 19, 20, 29, 30, 21, 22, 31, 32,
+                   37, 38, 47, 48, 39, 40, 49, 50, 41, 42, 51, 52})));
+}
+
 TEST(FloatAddOpModel, MixedBroadcast) {
   const std::vector<int> base_shape = {2, 3, 1, 2};
   std::vector<std::vector<int>> test_shapes = {
@@ -81,6 +81,8 @@ struct OpData {
   int accum_scratch_id = kTensorNotAllocated;
   // Row sums are used to cache filter sums for hybrid zero-point calculations.
   int row_sums_id = kTensorNotAllocated;
+  // Scratch buffer to hold int4 filters unpacked to int8.
+  int filter_unpacked_id = kTensorNotAllocated;
 
   TfLitePaddingValues padding;
   // The scaling factor from input to output (aka the 'real multiplier') can
@@ -105,6 +107,7 @@ struct OpData {
   int32_t accum_scratch_index;
   int32_t input_offset_index;
   int32_t row_sums_index;
+  int32_t filter_unpacked_index;
 
   bool need_hwcn_weights = false;
   bool have_weights_been_transposed = false;
@@ -317,6 +320,17 @@ static TfLiteStatus AllocateTemporaryTensorsIfRequired(
     }
   }
 
+  // Packed int4 filters are unpacked into an int8 scratch buffer at eval time
+  // so the regular int8 kernels can be reused.
+  if (filter->type == kTfLiteInt4) {
+    data->filter_unpacked_index = temporaries_count;
+    if (data->filter_unpacked_id == kTensorNotAllocated) {
+      TF_LITE_ENSURE_OK(
+          context, context->AddTensors(context, 1, &data->filter_unpacked_id));
+    }
+    ++temporaries_count;
+  }
+
   TfLiteIntArrayFree(node->temporaries);
   node->temporaries = TfLiteIntArrayCreate(temporaries_count);
 
@@ -356,6 +370,10 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
                  input_type == kTfLiteFloat32 || input_type == kTfLiteUInt8 ||
                      input_type == kTfLiteInt8 || input_type == kTfLiteInt16);
   TF_LITE_ENSURE_TYPES_EQ(context, output->type, input_type);
+  if (filter->type == kTfLiteInt4) {
+    // Packed int4 weights are only supported with int8 activations.
+    TF_LITE_ENSURE_TYPES_EQ(context, input_type, kTfLiteInt8);
+  }
 
   if (input_type == kTfLiteInt16) {
     TF_LITE_ENSURE_EQ(context, input->params.zero_point, 0);
@@ -635,6 +653,23 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
       }
     }
   }
+
+  if (filter->type == kTfLiteInt4) {
+    node->temporaries->data[data->filter_unpacked_index] =
+        data->filter_unpacked_id;
+    TfLiteTensor* filter_unpacked;
+    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
+                                                data->filter_unpacked_index,
+                                                &filter_unpacked));
+    filter_unpacked->type = kTfLiteInt8;
+    filter_unpacked->name = "Conv_filter_unpacked";
+    filter_unpacked->allocation_type = kTfLiteArenaRw;
+    if (!TfLiteIntArrayEqual(filter_unpacked->dims, filter->dims)) {
+      TfLiteIntArray* filter_unpacked_size = TfLiteIntArrayCopy(filter->dims);
+      TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, filter_unpacked,
+                                                       filter_unpacked_size));
+    }
+  }
   return kTfLiteOk;
 }
 
@@ -751,15 +786,28 @@ void EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
     effective_kernel_type = kReference;
   }
 
+  // Unpack packed int4 filters into the int8 scratch buffer so both the
+  // reference and the optimized kernels below can be reused unchanged.
+  const int8* filter_data;
+  if (filter->type == kTfLiteInt4) {
+    TfLiteTensor* filter_unpacked =
+        &context->tensors[node->temporaries->data[data->filter_unpacked_index]];
+    tensor_utils::UnpackDenseInt4IntoInt8(
+        GetTensorData<int8_t>(filter), NumElements(filter),
+        GetTensorData<int8_t>(filter_unpacked));
+    filter_data = GetTensorData<int8>(filter_unpacked);
+  } else {
+    filter_data = GetTensorData<int8>(filter);
+  }
+
   switch (effective_kernel_type) {
     case kReference: {
       reference_integer_ops::ConvPerChannel(
           op_params, data->per_channel_output_multiplier.data(),
           data->per_channel_output_shift.data(), GetTensorShape(input),
-          GetTensorData<int8>(input), GetTensorShape(filter),
-          GetTensorData<int8>(filter), GetTensorShape(bias),
-          GetTensorData<int32>(bias), GetTensorShape(output),
-          GetTensorData<int8>(output));
+          GetTensorData<int8>(input), GetTensorShape(filter), filter_data,
+          GetTensorShape(bias), GetTensorData<int32>(bias),
+          GetTensorShape(output), GetTensorData<int8>(output));
       break;
     }
     case kGenericOptimized:
@@ -768,11 +816,10 @@ void EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
       optimized_integer_ops::ConvPerChannel(
           op_params, data->per_channel_output_multiplier.data(),
           data->per_channel_output_shift.data(), GetTensorShape(input),
-          GetTensorData<int8>(input), GetTensorShape(filter),
-          GetTensorData<int8>(filter), GetTensorShape(bias),
-          GetTensorData<int32>(bias), GetTensorShape(output),
-          GetTensorData<int8>(output), GetTensorShape(im2col),
-          GetTensorData<int8>(im2col),
+          GetTensorData<int8>(input), GetTensorShape(filter), filter_data,
+          GetTensorShape(bias), GetTensorData<int32>(bias),
+          GetTensorShape(output), GetTensorData<int8>(output),
+          GetTensorShape(im2col), GetTensorData<int8>(im2col),
           CpuBackendContext::GetFromContext(context));
       break;
     }
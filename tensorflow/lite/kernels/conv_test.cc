@@ -1792,6 +1792,48 @@ TEST_P(ConvolutionOpTest, SimplePerChannelTest) {
   EXPECT_THAT(m.GetOutput(), ElementsAreArray({61, 127, -115, -93}));
 }
 
+TEST_P(ConvolutionOpTest, SimplePerChannelInt4Test) {
+  PerChannelQuantizedConvolutionOpModel m(
+      GetRegistration(), {TensorType_INT8, {1, 2, 3, 2}, -63.5, 64, 0.5, -1},
+      {TensorType_INT4,
+       // [2 * 2 * 2 * 2] as [output_channel, y, x, input_channel]
+       {2, 2, 2, 2},
+       0,
+       0,
+       0,
+       0,
+       /*per_channel_quantization=*/true,
+       /*per_channel_quantization_scales=*/{1, 2},
+       /*per_channel_quantization_offsets=*/{0, 0},
+       /*channel_index=*/0},
+      {TensorType_INT8, {}, -63.5, 64, 0.5, -1},
+      /*stride_width=*/1, /*stride_height=*/1, Padding_VALID,
+      ActivationFunctionType_NONE,
+      /*dilation_width_factor=*/1, /*dilation_height_factor=*/1,
+      /*num_threads=*/-1,
+      // The quantized filter values below, packed two nibbles to a byte:
+      //   out channel = 0 (scale 1): 1, 2, 3, 4, 3, 4, 5, 6
+      //   out channel = 1 (scale 2): 4, -1, 3, -2, 1, -1, 2, -3
+      /*filter_data=*/{33, 67, 67, 101, -12, -29, -15, -46});
+  m.SetInput({
+      // [1 * 2 * 3 * 2] as [batch, y, x, input_channel]
+      3, 2,    // batch = 0, y = 0, x = 0
+      1, -1,   // batch = 0, y = 0, x = 1
+      -2, -3,  // batch = 0, y = 0, x = 2
+      4, 3,    // batch = 0, y = 1, x = 0
+      2, -2,   // batch = 0, y = 1, x = 1
+      -3, -4,  // batch = 0, y = 1, x = 2
+  });
+  m.SetBias({3, -2});
+
+  // Invoke and verify output.
+  // output has dimension [1 * 1 * 2 * 2] as [batch, y, x, output_channel]
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetDequantizedOutput(),
+              ElementsAreArray(ArrayFloatNear({31, 50, -57, 28})));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray({61, 99, -115, 55}));
+}
+
 class HybridPerChannelConvolutionOpModel
     : public BaseConvolutionOpModel<int8_t> {
  public:
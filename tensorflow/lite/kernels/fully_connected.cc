@@ -18,6 +18,7 @@ limitations under the License.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
@@ -33,6 +34,7 @@ limitations under the License.
 #include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
 #include "tensorflow/lite/kernels/internal/tensor_utils.h"
 #include "tensorflow/lite/kernels/internal/types.h"
+#include "tensorflow/lite/kernels/internal/utils/sparsity_format_converter.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 
 namespace tflite {
@@ -53,6 +55,21 @@ bool SupportedSparsityFormat(const TfLiteSparsity& sparsity) {
 static const int kDimMetadataSizeRandomSparse = 2;
 static const int kDimMetadataSizeBlockSparse = 3;
 
+// Random sparse float weights at or above this density are dispatched to the
+// dense kernel through a densified copy of the weights; the SIMD dense GEMM
+// outruns scattered accumulation once most of the weights are present.
+static const float kDenseDispatchDensityThreshold = 0.3f;
+
+// Returns the fraction of non-zero elements in a constant random sparse
+// filter, or 1.0 when the density cannot be determined.
+float RandomSparseDensity(const TfLiteSparsity& sparsity,
+                          const TfLiteIntArray* dims) {
+  const int dense_elements = dims->data[0] * dims->data[1];
+  if (dense_elements == 0) return 1.f;
+  return static_cast<float>(sparsity.dim_metadata[1].array_indices->size) /
+         dense_elements;
+}
+
 TfLiteStatus CreateLedgerTensor(const TfLiteSparsity* sparsity,
                                 TfLiteContext* context, TfLiteTensor* ledger) {
   TF_LITE_ENSURE(context, sparsity != nullptr);
@@ -121,6 +138,9 @@ struct OpData {
   bool compute_row_sums = false;
   // Only used for sparse hybrid fully connected kernels.
   bool ledger_initialized;
+  // Only used for sparse float kernels that dispatch to the dense kernel
+  // through a densified copy of the weights.
+  bool densified_weights_initialized = false;
 };
 
 constexpr int kInputTensor = 0;
@@ -135,8 +155,11 @@ inline TfLiteStatus CheckTypes(TfLiteContext* context,
                                const TfLiteTensor* bias, TfLiteTensor* output,
                                TfLiteFullyConnectedParams* params) {
   const bool is_quantized =
-      ((filter->type == kTfLiteUInt8) || (filter->type == kTfLiteInt8));
-  const bool is_hybrid = is_quantized && (input->type == kTfLiteFloat32);
+      ((filter->type == kTfLiteUInt8) || (filter->type == kTfLiteInt8) ||
+       (filter->type == kTfLiteInt4));
+  // There is no hybrid support for the packed int4 format.
+  const bool is_hybrid = is_quantized && (input->type == kTfLiteFloat32) &&
+                         (filter->type != kTfLiteInt4);
   const bool is_shuffled =
       is_quantized && (params->weights_format ==
                        kTfLiteFullyConnectedWeightsFormatShuffled4x16Int8);
@@ -163,6 +186,11 @@ inline TfLiteStatus CheckTypes(TfLiteContext* context,
       TF_LITE_ENSURE(context, output->type == kTfLiteUInt8 ||
                                   output->type == kTfLiteInt8 ||
                                   output->type == kTfLiteInt16);
+      if (filter->type == kTfLiteInt4) {
+        // Packed int4 weights are only supported with int8 activations.
+        TF_LITE_ENSURE_TYPES_EQ(context, input->type, kTfLiteInt8);
+        TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteInt8);
+      }
       TF_LITE_ENSURE_EQ(context, is_optional_bias_int, true);
     }
   } else {
@@ -287,7 +315,8 @@ TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node) {
       //  Currently only Int8/Int16 is supported for per channel quantization.
       TF_LITE_ENSURE(context,
                      input->type == kTfLiteInt8 || input->type == kTfLiteInt16);
-      TF_LITE_ENSURE_EQ(context, filter->type, kTfLiteInt8);
+      TF_LITE_ENSURE(context, filter->type == kTfLiteInt8 ||
+                                  filter->type == kTfLiteInt4);
       TF_LITE_ENSURE_EQ(context, affine_quantization->scale->size,
                         per_channel_quantization_size);
       TF_LITE_ENSURE_EQ(
@@ -422,6 +451,45 @@ TfLiteStatus PrepareImpl(TfLiteContext* context, TfLiteNode* node) {
           CreateLedgerTensor(filter->sparsity, context, filter_ledger);
       if (status != kTfLiteOk) return status;
     }
+  } else if (is_sparse && input->type == kTfLiteFloat32 &&
+             filter->type == kTfLiteFloat32 &&
+             SupportedSparsityFormat(*filter->sparsity) &&
+             filter->sparsity->dim_metadata_size ==
+                 kDimMetadataSizeRandomSparse &&
+             IsConstantTensor(filter) &&
+             RandomSparseDensity(*filter->sparsity, filter->dims) >=
+                 kDenseDispatchDensityThreshold) {
+    // Mostly-dense random sparse weights are densified once into a persistent
+    // temporary so Eval() can use the dense kernel instead.
+    data->densified_weights_initialized = false;
+    TfLiteIntArrayFree(node->temporaries);
+    node->temporaries = TfLiteIntArrayCreate(1);
+    node->temporaries->data[0] = data->scratch_tensor_index;
+    TfLiteTensor* dense_filter;
+    TF_LITE_ENSURE_OK(
+        context, GetTemporarySafe(context, node, /*index=*/0, &dense_filter));
+    dense_filter->name = "FC_dense_filter";
+    dense_filter->type = kTfLiteFloat32;
+    dense_filter->allocation_type = kTfLiteArenaRwPersistent;
+    TfLiteIntArray* dense_filter_size = TfLiteIntArrayCopy(filter->dims);
+    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, dense_filter,
+                                                     dense_filter_size));
+  } else if (filter->type == kTfLiteInt4) {
+    // Packed int4 weights are unpacked into an int8 scratch buffer at eval
+    // time so the regular int8 kernels can be reused.
+    TfLiteIntArrayFree(node->temporaries);
+    node->temporaries = TfLiteIntArrayCreate(1);
+    node->temporaries->data[0] = data->scratch_tensor_index;
+    TfLiteTensor* unpacked_filter;
+    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, /*index=*/0,
+                                                &unpacked_filter));
+    unpacked_filter->name = "FC_unpacked_filter";
+    unpacked_filter->type = kTfLiteInt8;
+    unpacked_filter->allocation_type = kTfLiteArenaRw;
+    unpacked_filter->params = filter->params;
+    TfLiteIntArray* unpacked_filter_size = TfLiteIntArrayCopy(filter->dims);
+    TF_LITE_ENSURE_OK(context, context->ResizeTensor(context, unpacked_filter,
+                                                     unpacked_filter_size));
   }
 
   // Resize output.
@@ -1035,6 +1103,22 @@ TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                 context, "Unsupported sparse fully-connected weight format.");
             return kTfLiteError;
           }
+        } else if (filter->type == kTfLiteInt4) {
+          // Unpack the packed nibbles into the int8 scratch buffer, then run
+          // the regular int8 kernels on the unpacked weights.
+          TfLiteTensor* unpacked_filter;
+          TF_LITE_ENSURE_OK(
+              context,
+              GetTemporarySafe(context, node, /*index=*/0, &unpacked_filter));
+          tensor_utils::UnpackDenseInt4IntoInt8(
+              GetTensorData<int8_t>(filter), NumElements(filter),
+              GetTensorData<int8_t>(unpacked_filter));
+          is_per_channel ? FullyConnectedPerChannelInt8<kernel_type>(
+                               data, input, unpacked_filter, bias, output,
+                               CpuBackendContext::GetFromContext(context))
+                         : FullyConnectedInt8<kernel_type>(
+                               data, input, unpacked_filter, bias, output,
+                               CpuBackendContext::GetFromContext(context));
         } else {
           is_per_channel ? FullyConnectedPerChannelInt8<kernel_type>(
                                data, input, filter, bias, output,
@@ -1203,14 +1287,42 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
         return kTfLiteError;
       }
 
-      if (sparsity.dim_metadata_size == kDimMetadataSizeRandomSparse) {
+      if (sparsity.dim_metadata_size == kDimMetadataSizeRandomSparse &&
+          node->temporaries != nullptr && node->temporaries->size > 0) {
+        // Random sparse weights dense enough for the dense kernel; Prepare()
+        // set up a persistent temporary holding the densified weights.
+        TfLiteTensor* dense_filter;
+        TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, /*index=*/0,
+                                                    &dense_filter));
+        if (!data->densified_weights_initialized) {
+          const std::vector<int> filter_dims(
+              filter->dims->data, filter->dims->data + filter->dims->size);
+          internal::sparsity::FormatConverter<float> converter(filter_dims,
+                                                               sparsity);
+          TF_LITE_ENSURE_OK(
+              context, converter.SparseToDense(
+                           GetTensorData<float>(filter),
+                           NumElements(dense_filter),
+                           GetTensorData<float>(dense_filter), context));
+          data->densified_weights_initialized = true;
+        }
+        op_params.lhs_cacheable = IsConstantTensor(filter);
+        op_params.rhs_cacheable = IsConstantTensor(input);
+        optimized_ops::FullyConnected(
+            op_params, input_shape, GetTensorData<float>(input), filter_shape,
+            GetTensorData<float>(dense_filter), bias_shape,
+            GetTensorData<float>(bias), output_shape,
+            GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
+      } else if (sparsity.dim_metadata_size == kDimMetadataSizeRandomSparse) {
         // Random sparse.
         optimized_ops::FullyConnectedSparseWeight(
             sparsity, op_params,                         // Disable formatting
             input_shape, GetTensorData<float>(input),    // Disable formatting
             filter_shape, GetTensorData<float>(filter),  // Disable formatting
             bias_shape, GetTensorData<float>(bias),      // Disable formatting
-            output_shape, GetTensorData<float>(output));
+            output_shape, GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
       } else if (sparsity.dim_metadata_size == kDimMetadataSizeBlockSparse &&
                  sparsity.dim_metadata[2].dense_size == 4) {
         // Block sparse with block size of 1x4.
@@ -1292,6 +1404,7 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
         TF_LITE_KERNEL_LOG(context, "Unhandled fully-connected weights format");
         return kTfLiteError;
       }
+    case kTfLiteInt4:
     case kTfLiteInt8:
       if (params->weights_format == kTfLiteFullyConnectedWeightsFormatDefault) {
         return EvalQuantized<kernel_type>(context, node, params, data, input,
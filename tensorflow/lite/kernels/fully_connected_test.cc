@@ -397,6 +397,70 @@ class PerChannelQuantizedFullyConnectedOpModel
   }
 };
 
+// In the int4 model the weights are quantized to 4 bit and packed two to a
+// byte, so they are passed in already quantized and packed here.
+class Int4FullyConnectedOpModel : public SingleOpModel {
+ public:
+  Int4FullyConnectedOpModel(TfLiteRegistration* registration, int units,
+                            int batches, const TensorData& input,
+                            const std::vector<int8_t>& quantized_weights,
+                            float weights_scale, const TensorData& output)
+      : units_(units) {
+    input_ = AddInput(input);
+
+    const int input_size = quantized_weights.size() / units_;
+    std::vector<int8_t> packed_weights((quantized_weights.size() + 1) / 2);
+    for (size_t i = 0; i < quantized_weights.size(); ++i) {
+      uint8_t byte = packed_weights[i / 2];
+      if (i % 2 == 0) {
+        byte = quantized_weights[i] & 0x0F;
+      } else {
+        byte |= (quantized_weights[i] & 0x0F) << 4;
+      }
+      packed_weights[i / 2] = static_cast<int8_t>(byte);
+    }
+    weights_ = AddConstInput<int8_t>(
+        {TensorType_INT4, {units_, input_size}, 0, 0, weights_scale, 0},
+        packed_weights);
+
+    const float bias_scale = GetScale(input_) * weights_scale;
+    bias_ = AddInput({TensorType_INT32, {units_}, 0, 0, bias_scale, 0});
+
+    output_ = AddOutput(output);
+
+    SetBuiltinOp(
+        BuiltinOperator_FULLY_CONNECTED, BuiltinOptions_FullyConnectedOptions,
+        CreateFullyConnectedOptions(builder_, ActivationFunctionType_NONE)
+            .Union());
+    resolver_ = std::make_unique<SingleOpResolver>(
+        BuiltinOperator_FULLY_CONNECTED, registration);
+    BuildInterpreter({GetShape(input_), GetShape(weights_), GetShape(bias_)});
+  }
+
+  void SetBias(const std::vector<float>& data) {
+    QuantizeAndPopulate<int32_t>(bias_, data);
+  }
+
+  void SetInput(const std::vector<float>& data) {
+    QuantizeAndPopulate<int8_t>(input_, data);
+  }
+
+  std::vector<int8_t> GetOutput() { return ExtractVector<int8_t>(output_); }
+
+  std::vector<float> GetDequantizedOutput() {
+    return Dequantize<int8_t>(ExtractVector<int8_t>(output_),
+                              GetScale(output_), GetZeroPoint(output_));
+  }
+
+ private:
+  int input_;
+  int weights_;
+  int bias_;
+  int output_;
+
+  int units_;
+};
+
 // In the hybrid model the weights are quantized (to uint8). But the bias,
 // input (and output) are expected to be in float precision.
 class HybridFullyConnectedOpModel : public SingleOpModel {
@@ -726,6 +790,33 @@ TEST_P(QuantizedFullyConnectedOpTest, SimpleTestQuantizedInt8) {
   EXPECT_THAT(m.GetOutput<int8_t>(), ElementsAre(23, 24, 25, 57, 58, 59));
 }
 
+TEST_P(QuantizedFullyConnectedOpTest, SimpleTestQuantizedInt4) {
+  Int4FullyConnectedOpModel m(
+      GetRegistration(), /*units=*/3, /*batches=*/2,
+      /*input=*/{TensorType_INT8, {2, 4}, 0, 0, 0.5, 0},
+      /*quantized_weights=*/
+      {
+          1, 2, 3, 4,      // u = 0
+          -1, -2, -3, -4,  // u = 1
+          7, -7, 6, -6,    // u = 2
+      },
+      /*weights_scale=*/1.0,
+      /*output=*/{TensorType_INT8, {}, 0, 0, 0.5, 0});
+  m.SetBias({1, 2, 3});
+
+  m.SetInput({
+      1, 2, 3, 4,        // b = 0
+      -0.5, 1.5, -2, 4,  // b = 1
+  });
+
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  EXPECT_THAT(
+      m.GetDequantizedOutput(),
+      ElementsAreArray(ArrayFloatNear({31, -28, -10, 13.5, -10.5, -47})));
+  EXPECT_THAT(m.GetOutput(), ElementsAre(62, -56, -20, 27, -21, -94));
+}
+
 TEST_P(QuantizedFullyConnectedOpTest, SimpleTestPerChannelQuantizedInt8) {
   PerChannelQuantizedFullyConnectedOpModel m(
       GetRegistration(), /*units=*/3, /*batches*/ 2,
@@ -1722,6 +1813,43 @@ TEST_P(SparseFullyConnectedOpTest, SimpleTest2) {
   EXPECT_THAT(m.GetOutput(), ElementsAre(11, 9));
 }
 
+TEST_P(SparseFullyConnectedOpTest, RandomSparseTestMultiThreaded) {
+  std::initializer_list<float> weight_data = {
+      0, 5, 0, 0, 0, 0, 0, 0, 0, 0,  // u = 0
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // u = 1
+      2, 0, 0, 0, 0, 0, 0, 0, 0, 3,  // u = 2
+  };
+  TensorData weight = {};
+  weight.type = TensorType_FLOAT32;
+  weight.shape = {3, 10};
+  weight.traversal_order = {0, 1};
+  weight.format = {kTfLiteDimDense, kTfLiteDimSparseCSR};
+  for (int num_threads = 1; num_threads <= 4; num_threads++) {
+    SparseFullyConnectedOpModel<float> m(
+        GetRegistration(), /*units=*/3, /*batches=*/4,
+        /*input=*/{TensorType_FLOAT32, {4, 10}}, weight, weight_data,
+        /*output=*/{TensorType_FLOAT32},
+        /*bias_tensor_optional=*/false, /*num_threads=*/num_threads);
+    m.SetBias({1, -2, 3});
+
+    m.SetInput({
+        1,  2,  3,  4,  5,  6,  7,  8,  9,  10,  // b = 0
+        1,  1,  1,  1,  1,  1,  1,  1,  1,  1,   // b = 1
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // b = 2
+        2,  0,  0,  0,  0,  0,  0,  0,  0,  1,   // b = 3
+    });
+
+    ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+    EXPECT_THAT(m.GetOutputShape(), ElementsAre(4, 3));
+    EXPECT_THAT(m.GetOutput(), ElementsAre(11, 0, 35,  // b = 0
+                                           6, 0, 8,    // b = 1
+                                           0, 0, 0,    // b = 2
+                                           1, 0, 10    // b = 3
+                                           ));
+  }
+}
+
 TEST_P(SparseFullyConnectedOpTest, Simple1x4Test) {
   std::initializer_list<float> weight_data = {
       1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,  // u = 0
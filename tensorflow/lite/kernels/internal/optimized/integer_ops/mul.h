@@ -250,9 +250,9 @@ inline void BroadcastMulDispatch(const ArithmeticParams& params,
                                  const RuntimeShape& output_shape,
                                  int8* output_data) {
   if (params.broadcast_category == BroadcastableOpCategory::kGenericBroadcast) {
-    return reference_integer_ops::BroadcastMul4DSlow(
+    return optimized_ops::BinaryBroadcastGeneric(
         params, input1_shape, input1_data, input2_shape, input2_data,
-        output_shape, output_data);
+        output_shape, output_data, MulElementwise, MulSimpleBroadcast);
   }
 
   optimized_ops::BinaryBroadcastFiveFold(
@@ -231,6 +231,118 @@ inline void BinaryBroadcastFiveFold(const ArithmeticParams& unswitched_params,
   }
 }
 
+// Performs a binary broadcast that does not fit the fivefold pattern by
+// decomposing it into vectorized runs over the innermost output dimension.
+// Consecutive dimensions with the same broadcast pattern are collapsed into
+// a stride program, which is then walked with an odometer loop so that every
+// innermost run is handed to `elementwise_f` (neither operand broadcast
+// within the run) or `scalar_broadcast_f` (one operand constant within the
+// run). This covers every shape pair that ProcessBroadcastShapes classifies
+// as kGenericBroadcast without falling back to per-element indexing.
+//
+// `scalar_broadcast_f` always receives the constant operand as its scalar
+// argument. When the scalar comes from the second input, the operands are
+// swapped and the switched params are passed so that quantized offsets and
+// multipliers stay attached to the right operand; the op itself must
+// therefore be commutative (add, mul).
+template <typename ElementwiseF, typename ScalarBroadcastF, typename T>
+inline void BinaryBroadcastGeneric(const ArithmeticParams& params,
+                                   const RuntimeShape& unextended_input1_shape,
+                                   const T* input1_data,
+                                   const RuntimeShape& unextended_input2_shape,
+                                   const T* input2_data,
+                                   const RuntimeShape& output_shape,
+                                   T* output_data, ElementwiseF elementwise_f,
+                                   ScalarBroadcastF scalar_broadcast_f) {
+  constexpr int kMaxDims = 8;
+  const int dims_count = output_shape.DimensionsCount();
+  TFLITE_DCHECK_LE(dims_count, kMaxDims);
+  if (output_shape.FlatSize() == 0) return;
+  const RuntimeShape input1_shape =
+      RuntimeShape::ExtendedShape(dims_count, unextended_input1_shape);
+  const RuntimeShape input2_shape =
+      RuntimeShape::ExtendedShape(dims_count, unextended_input2_shape);
+
+  ArithmeticParams switched_params = params;
+  switched_params.input1_offset = params.input2_offset;
+  switched_params.input1_multiplier = params.input2_multiplier;
+  switched_params.input1_shift = params.input2_shift;
+  switched_params.input2_offset = params.input1_offset;
+  switched_params.input2_multiplier = params.input1_multiplier;
+  switched_params.input2_shift = params.input1_shift;
+
+  // Collapse consecutive dimensions with the same broadcast pattern,
+  // innermost first. Size-1 output dimensions are dropped, so the innermost
+  // collapsed dimension is always contiguous in both non-broadcast operands.
+  // `pattern` is 0 when the extents match, 1 when input1 is broadcast and 2
+  // when input2 is broadcast.
+  int run_extent[kMaxDims];
+  int input1_stride[kMaxDims];
+  int input2_stride[kMaxDims];
+  int pattern[kMaxDims];
+  int num_dims = 0;
+  int s1 = 1;
+  int s2 = 1;
+  for (int d = dims_count - 1; d >= 0; --d) {
+    const int extent1 = input1_shape.Dims(d);
+    const int extent2 = input2_shape.Dims(d);
+    TFLITE_DCHECK(extent1 == extent2 || extent1 == 1 || extent2 == 1);
+    const int out_extent = std::max(extent1, extent2);
+    if (out_extent != 1) {
+      const int dim_pattern = extent1 == extent2 ? 0 : (extent1 == 1 ? 1 : 2);
+      if (num_dims > 0 && pattern[num_dims - 1] == dim_pattern) {
+        // Same pattern as the previous dimension, so both strides stay
+        // contiguous across the pair and the runs can be merged.
+        run_extent[num_dims - 1] *= out_extent;
+      } else {
+        pattern[num_dims] = dim_pattern;
+        run_extent[num_dims] = out_extent;
+        input1_stride[num_dims] = dim_pattern == 1 ? 0 : s1;
+        input2_stride[num_dims] = dim_pattern == 2 ? 0 : s2;
+        ++num_dims;
+      }
+    }
+    s1 *= extent1;
+    s2 *= extent2;
+  }
+
+  if (num_dims == 0) {
+    // Both operands are effectively scalars.
+    elementwise_f(output_shape.FlatSize(), params, input1_data, input2_data,
+                  output_data);
+    return;
+  }
+
+  const int inner_extent = run_extent[0];
+  const int inner_pattern = pattern[0];
+  int index[kMaxDims] = {0};
+  const T* input1_ptr = input1_data;
+  const T* input2_ptr = input2_data;
+  T* output_ptr = output_data;
+  for (;;) {
+    if (inner_pattern == 0) {
+      elementwise_f(inner_extent, params, input1_ptr, input2_ptr, output_ptr);
+    } else if (inner_pattern == 1) {
+      scalar_broadcast_f(inner_extent, params, *input1_ptr, input2_ptr,
+                         output_ptr);
+    } else {
+      scalar_broadcast_f(inner_extent, switched_params, *input2_ptr,
+                         input1_ptr, output_ptr);
+    }
+    output_ptr += inner_extent;
+    int d = 1;
+    for (; d < num_dims; ++d) {
+      input1_ptr += input1_stride[d];
+      input2_ptr += input2_stride[d];
+      if (++index[d] < run_extent[d]) break;
+      input1_ptr -= input1_stride[d] * run_extent[d];
+      input2_ptr -= input2_stride[d] * run_extent[d];
+      index[d] = 0;
+    }
+    if (d == num_dims) break;
+  }
+}
+
 #ifdef TFLITE_SOFTMAX_USE_UINT16_LUT
 
 // Looks up each element of <indices> in <table>, returns them in a vector.
@@ -1845,8 +1957,13 @@ inline void BroadcastAddDispatch(
     const T* input1_data, const RuntimeShape& input2_shape,
     const T* input2_data, const RuntimeShape& output_shape, T* output_data) {
   if (params.broadcast_category == BroadcastableOpCategory::kGenericBroadcast) {
-    return BroadcastAdd4DSlow(params, input1_shape, input1_data, input2_shape,
-                              input2_data, output_shape, output_data);
+    return BinaryBroadcastGeneric(
+        params, input1_shape, input1_data, input2_shape, input2_data,
+        output_shape, output_data,
+        static_cast<void (*)(int, const ArithmeticParams&, const T*, const T*,
+                             T*)>(AddElementwise),
+        static_cast<void (*)(int, const ArithmeticParams&, T, const T*, T*)>(
+            AddScalarBroadcast));
   }
 
   BinaryBroadcastFiveFold(
@@ -2243,8 +2360,13 @@ inline void BroadcastMulDispatch(
     const T* input1_data, const RuntimeShape& input2_shape,
     const T* input2_data, const RuntimeShape& output_shape, T* output_data) {
   if (params.broadcast_category == BroadcastableOpCategory::kGenericBroadcast) {
-    return BroadcastMul4DSlow(params, input1_shape, input1_data, input2_shape,
-                              input2_data, output_shape, output_data);
+    return BinaryBroadcastGeneric(
+        params, input1_shape, input1_data, input2_shape, input2_data,
+        output_shape, output_data,
+        static_cast<void (*)(int, const ArithmeticParams&, const T*, const T*,
+                             T*)>(MulElementwise),
+        static_cast<void (*)(int, const ArithmeticParams&, T, const T*, T*)>(
+            MulSimpleBroadcast));
   }
 
   BinaryBroadcastFiveFold(
@@ -174,6 +174,24 @@ TEST(FloatMulOpTest, WithBroadcast) {
   }
 }
 
+TEST(FloatMulOpTest, WithBroadcastGeneric5D) {
+  // Both inputs broadcast in alternating dimensions, which does not fit the
+  // fivefold pattern.
+  FloatMulOpModel m({TensorType_FLOAT32, {2, 1, 3, 1, 2}},
+                    {TensorType_FLOAT32, {1, 2, 1, 2, 1}},
+                    {TensorType_FLOAT32, {}}, ActivationFunctionType_NONE);
+  m.PopulateTensor<float>(m.input1(), {0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8,
+                                       0.9, 1.0, 1.1, 1.2});
+  m.PopulateTensor<float>(m.input2(), {10, 20, 30, 40});
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutput(),
+              ElementsAreArray(ArrayFloatNear(
+                  {1,  2,  2,  4,  3,  4,  6,  8,  5,  6,  10, 12,
+                   3,  6,  4,  8,  9,  12, 12, 16, 15, 18, 20, 24,
+                   7,  8,  14, 16, 9,  10, 18, 20, 11, 12, 22, 24,
+                   21, 24, 28, 32, 27, 30, 36, 40, 33, 36, 44, 48})));
+}
+
 TEST(FloatMulOpTest, MixedBroadcast) {
   const std::vector<int> base_shape = {2, 3, 1, 2};
   const std::vector<std::vector<int>> test_shapes = {
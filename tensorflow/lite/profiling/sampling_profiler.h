@@ -0,0 +1,156 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "tensorflow/lite/core/api/profiler.h"
+#include "tensorflow/lite/profiling/time.h"
+
+namespace tflite {
+namespace profiling {
+
+// A low-overhead profiler intended to stay attached in production builds.
+//
+// Instead of buffering every event like BufferedProfiler, it timestamps the
+// operator events of every Nth Invoke only and aggregates the observed
+// latencies into fixed-size per-node histograms, so memory use is bounded by
+// the number of nodes and unsampled invokes cost little more than an integer
+// increment. Like the other profilers in this directory it is designed to be
+// used on a single thread.
+//
+// Usage:
+//   auto profiler = std::make_unique<SamplingProfiler>(/*sample_interval=*/32);
+//   auto* profiler_ptr = profiler.get();
+//   interpreter->AddProfiler(std::move(profiler));
+//   ... invoke repeatedly ...
+//   for (const auto& node : profiler_ptr->GetNodeProfiles()) { ... }
+class SamplingProfiler : public tflite::Profiler {
+ public:
+  // Histogram bucket i counts samples with latency below 2^(i+1) usec that
+  // did not fit an earlier bucket; the last bucket absorbs everything larger.
+  static constexpr int kNumHistogramBuckets = 16;
+
+  struct NodeProfile {
+    int node_index = -1;
+    uint64_t num_samples = 0;
+    uint64_t total_usec = 0;
+    uint64_t max_usec = 0;
+    uint64_t histogram[kNumHistogramBuckets] = {};
+  };
+
+  // Samples the operator latencies of one out of every `sample_interval`
+  // invokes. Node indices at or above `max_num_nodes` are ignored so the
+  // aggregation memory stays fixed.
+  explicit SamplingProfiler(int32_t sample_interval = 10,
+                            size_t max_num_nodes = 1024)
+      : sample_interval_(sample_interval > 0 ? sample_interval : 1),
+        max_num_nodes_(max_num_nodes) {}
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override {
+    if (event_type == EventType::DEFAULT && tag != nullptr &&
+        std::strcmp(tag, "Invoke") == 0) {
+      sampling_ = (invoke_count_++ % sample_interval_) == 0;
+      return kInvokeEventHandle;
+    }
+    if (!sampling_ || event_type != EventType::OPERATOR_INVOKE_EVENT ||
+        event_metadata1 < 0 ||
+        event_metadata1 >= static_cast<int64_t>(max_num_nodes_)) {
+      return kInvalidEventHandle;
+    }
+    const uint32_t handle = next_event_handle_++;
+    PendingEvent& pending = pending_events_[handle % kMaxPendingEvents];
+    pending.node_index = static_cast<int>(event_metadata1);
+    pending.begin_usec = time::NowMicros();
+    return handle;
+  }
+
+  void EndEvent(uint32_t event_handle) override {
+    if (event_handle == kInvalidEventHandle ||
+        event_handle == kInvokeEventHandle) {
+      return;
+    }
+    const PendingEvent& pending =
+        pending_events_[event_handle % kMaxPendingEvents];
+    if (pending.node_index < 0) return;
+    const uint64_t elapsed_usec = time::NowMicros() - pending.begin_usec;
+    AddSample(pending.node_index, elapsed_usec);
+  }
+
+  // Returns the aggregated per-node statistics, ordered by node index.
+  std::vector<NodeProfile> GetNodeProfiles() const {
+    std::vector<NodeProfile> profiles;
+    for (const NodeProfile& node : node_profiles_) {
+      if (node.num_samples > 0) profiles.push_back(node);
+    }
+    return profiles;
+  }
+
+  // Number of invokes seen, sampled or not.
+  uint64_t invoke_count() const { return invoke_count_; }
+
+  // Discards all aggregated statistics but keeps the sampling cadence.
+  void Reset() { node_profiles_.clear(); }
+
+ private:
+  // Operator events do not overlap within one subgraph invoke, but control
+  // flow ops nest the events of their body subgraphs, so keep a small ring of
+  // in-flight events.
+  static constexpr int kMaxPendingEvents = 64;
+  static constexpr uint32_t kInvalidEventHandle = 0;
+  static constexpr uint32_t kInvokeEventHandle = 1;
+
+  struct PendingEvent {
+    int node_index = -1;
+    uint64_t begin_usec = 0;
+  };
+
+  void AddSample(int node_index, uint64_t elapsed_usec) {
+    if (node_profiles_.size() <= static_cast<size_t>(node_index)) {
+      node_profiles_.resize(node_index + 1);
+      for (size_t i = 0; i < node_profiles_.size(); ++i) {
+        node_profiles_[i].node_index = static_cast<int>(i);
+      }
+    }
+    NodeProfile& node = node_profiles_[node_index];
+    node.num_samples++;
+    node.total_usec += elapsed_usec;
+    if (elapsed_usec > node.max_usec) node.max_usec = elapsed_usec;
+    int bucket = 0;
+    while (bucket < kNumHistogramBuckets - 1 &&
+           (elapsed_usec >> (bucket + 1)) != 0) {
+      ++bucket;
+    }
+    node.histogram[bucket]++;
+  }
+
+  const int32_t sample_interval_;
+  const size_t max_num_nodes_;
+  uint64_t invoke_count_ = 0;
+  bool sampling_ = false;
+  uint32_t next_event_handle_ = 2;
+  PendingEvent pending_events_[kMaxPendingEvents];
+  std::vector<NodeProfile> node_profiles_;
+};
+
+}  // namespace profiling
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_PROFILING_SAMPLING_PROFILER_H_
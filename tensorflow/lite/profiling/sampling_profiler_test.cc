@@ -0,0 +1,106 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/sampling_profiler.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace profiling {
+namespace {
+
+// Mimics the event sequence Subgraph::Invoke produces: a DEFAULT "Invoke"
+// event wrapping one OPERATOR_INVOKE_EVENT per node.
+void SimulateInvoke(tflite::Profiler* profiler, int num_nodes,
+                    int sleep_usec_per_node = 0) {
+  const uint32_t invoke_handle = profiler->BeginEvent(
+      "Invoke", Profiler::EventType::DEFAULT, /*event_metadata=*/0);
+  for (int node = 0; node < num_nodes; ++node) {
+    const uint32_t op_handle = profiler->BeginEvent(
+        "OpInvoke", Profiler::EventType::OPERATOR_INVOKE_EVENT, node);
+    if (sleep_usec_per_node > 0) {
+      std::this_thread::sleep_for(
+          std::chrono::microseconds(sleep_usec_per_node));
+    }
+    profiler->EndEvent(op_handle);
+  }
+  profiler->EndEvent(invoke_handle);
+}
+
+TEST(SamplingProfilerTest, SamplesEveryNthInvoke) {
+  SamplingProfiler profiler(/*sample_interval=*/4);
+  for (int i = 0; i < 8; ++i) {
+    SimulateInvoke(&profiler, /*num_nodes=*/2);
+  }
+  EXPECT_EQ(profiler.invoke_count(), 8);
+  auto profiles = profiler.GetNodeProfiles();
+  ASSERT_EQ(profiles.size(), 2);
+  for (const auto& node : profiles) {
+    // Invokes 0 and 4 are sampled.
+    EXPECT_EQ(node.num_samples, 2);
+  }
+}
+
+TEST(SamplingProfilerTest, AggregatesPerNode) {
+  SamplingProfiler profiler(/*sample_interval=*/1);
+  SimulateInvoke(&profiler, /*num_nodes=*/3, /*sleep_usec_per_node=*/1000);
+  auto profiles = profiler.GetNodeProfiles();
+  ASSERT_EQ(profiles.size(), 3);
+  for (int node = 0; node < 3; ++node) {
+    EXPECT_EQ(profiles[node].node_index, node);
+    EXPECT_EQ(profiles[node].num_samples, 1);
+    EXPECT_GE(profiles[node].total_usec, 1000);
+    EXPECT_GE(profiles[node].max_usec, 1000);
+    uint64_t histogram_total = 0;
+    for (int b = 0; b < SamplingProfiler::kNumHistogramBuckets; ++b) {
+      histogram_total += profiles[node].histogram[b];
+    }
+    EXPECT_EQ(histogram_total, 1);
+  }
+}
+
+TEST(SamplingProfilerTest, IgnoresUnsampledInvokes) {
+  SamplingProfiler profiler(/*sample_interval=*/1000);
+  SimulateInvoke(&profiler, /*num_nodes=*/1);  // Sampled.
+  for (int i = 0; i < 10; ++i) {
+    SimulateInvoke(&profiler, /*num_nodes=*/1);  // Not sampled.
+  }
+  auto profiles = profiler.GetNodeProfiles();
+  ASSERT_EQ(profiles.size(), 1);
+  EXPECT_EQ(profiles[0].num_samples, 1);
+}
+
+TEST(SamplingProfilerTest, IgnoresNodesBeyondFixedCapacity) {
+  SamplingProfiler profiler(/*sample_interval=*/1, /*max_num_nodes=*/2);
+  SimulateInvoke(&profiler, /*num_nodes=*/5);
+  auto profiles = profiler.GetNodeProfiles();
+  EXPECT_EQ(profiles.size(), 2);
+}
+
+TEST(SamplingProfilerTest, ResetDiscardsAggregates) {
+  SamplingProfiler profiler(/*sample_interval=*/1);
+  SimulateInvoke(&profiler, /*num_nodes=*/2);
+  EXPECT_EQ(profiler.GetNodeProfiles().size(), 2);
+  profiler.Reset();
+  EXPECT_TRUE(profiler.GetNodeProfiles().empty());
+  EXPECT_EQ(profiler.invoke_count(), 1);
+}
+
+}  // namespace
+}  // namespace profiling
+}  // namespace tflite
@@ -87,6 +87,18 @@ void SimpleMemoryArena::CalculateActiveAllocs(
 
 void SimpleMemoryArena::ResetAllocs() { active_allocs_.clear(); }
 
+void SimpleMemoryArena::RestoreAllocs(
+    const std::vector<ArenaAllocWithUsageInterval>& allocs) {
+  active_allocs_.clear();
+  high_water_mark_ = 0;
+  for (const auto& alloc : allocs) {
+    if (alloc.tensor < 0 || alloc.size == 0) continue;
+    active_allocs_.push_back(alloc);
+    high_water_mark_ = std::max(high_water_mark_, alloc.offset + alloc.size);
+  }
+  std::sort(active_allocs_.begin(), active_allocs_.end());
+}
+
 TfLiteStatus SimpleMemoryArena::Allocate(
     TfLiteContext* context, size_t alignment, size_t size, int32_t tensor,
     int32_t first_node, int32_t last_node,
@@ -92,6 +92,13 @@ class SimpleMemoryArena {
   void CalculateActiveAllocs(
       const std::vector<ArenaAllocWithUsageInterval>& allocs, int32_t node);
 
+  // Seeds the arena with an externally computed set of allocations, e.g. a
+  // plan serialized by a previous run (see
+  // ArenaPlanner::SerializeAllocationPlan). Replaces the active allocs and
+  // recomputes the high water mark; Commit() must still be called to reserve
+  // the underlying buffer and resolve the allocs into pointers.
+  void RestoreAllocs(const std::vector<ArenaAllocWithUsageInterval>& allocs);
+
   // Schedule memory allocation for a tensor with a given size, assuming that it
   // needs to be allocated before the execution of first_node, and deallocated
   // after the execution of last_node.
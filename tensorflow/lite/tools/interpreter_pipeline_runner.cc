@@ -0,0 +1,164 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/tools/interpreter_pipeline_runner.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+
+namespace tflite {
+namespace tools {
+
+namespace {
+
+// Returns the byte sizes of the given tensors of `interpreter`.
+std::vector<size_t> TensorBytes(const Interpreter& interpreter,
+                                const std::vector<int>& tensor_indices) {
+  std::vector<size_t> bytes;
+  bytes.reserve(tensor_indices.size());
+  for (int tensor_index : tensor_indices) {
+    bytes.push_back(interpreter.tensor(tensor_index)->bytes);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+bool InterpreterPipelineRunner::FrameQueue::Push(Frame frame) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return closed_ || frames_.size() < capacity_; });
+  if (closed_) return false;
+  frames_.push_back(std::move(frame));
+  cv_.notify_all();
+  return true;
+}
+
+bool InterpreterPipelineRunner::FrameQueue::Pop(Frame* frame) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return closed_ || !frames_.empty(); });
+  if (closed_) return false;
+  *frame = std::move(frames_.front());
+  frames_.pop_front();
+  cv_.notify_all();
+  return true;
+}
+
+void InterpreterPipelineRunner::FrameQueue::Close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  cv_.notify_all();
+}
+
+std::unique_ptr<InterpreterPipelineRunner> InterpreterPipelineRunner::Create(
+    std::vector<std::unique_ptr<Interpreter>> stages, const Options& options) {
+  if (stages.empty() || options.boundary_depth < 1) return nullptr;
+  for (auto& stage : stages) {
+    if (stage == nullptr || stage->AllocateTensors() != kTfLiteOk) {
+      return nullptr;
+    }
+  }
+  // Every stage boundary must agree on the number and size of its tensors.
+  for (size_t i = 0; i + 1 < stages.size(); ++i) {
+    if (TensorBytes(*stages[i], stages[i]->outputs()) !=
+        TensorBytes(*stages[i + 1], stages[i + 1]->inputs())) {
+      return nullptr;
+    }
+  }
+
+  std::unique_ptr<InterpreterPipelineRunner> runner(
+      new InterpreterPipelineRunner(options));
+  runner->input_bytes_ = TensorBytes(*stages.front(), stages.front()->inputs());
+  runner->output_bytes_ =
+      TensorBytes(*stages.back(), stages.back()->outputs());
+  runner->stages_ = std::move(stages);
+  for (size_t i = 0; i < runner->stages_.size() + 1; ++i) {
+    runner->queues_.push_back(
+        std::make_unique<FrameQueue>(options.boundary_depth));
+  }
+  InterpreterPipelineRunner* self = runner.get();
+  for (size_t i = 0; i < runner->stages_.size(); ++i) {
+    const int stage_index = static_cast<int>(i);
+    runner->workers_.emplace_back(
+        [self, stage_index] { self->StageLoop(stage_index); });
+  }
+  return runner;
+}
+
+InterpreterPipelineRunner::~InterpreterPipelineRunner() {
+  for (auto& queue : queues_) {
+    queue->Close();
+  }
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+TfLiteStatus InterpreterPipelineRunner::Push(
+    const std::vector<const void*>& inputs) {
+  if (inputs.size() != input_bytes_.size()) return kTfLiteError;
+  Frame frame;
+  frame.tensors.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const char* data = reinterpret_cast<const char*>(inputs[i]);
+    frame.tensors.emplace_back(data, data + input_bytes_[i]);
+  }
+  return queues_.front()->Push(std::move(frame)) ? kTfLiteOk : kTfLiteError;
+}
+
+TfLiteStatus InterpreterPipelineRunner::Pop(
+    const std::vector<void*>& outputs) {
+  if (outputs.size() != output_bytes_.size()) return kTfLiteError;
+  Frame frame;
+  if (!queues_.back()->Pop(&frame)) return kTfLiteError;
+  if (frame.status != kTfLiteOk) return frame.status;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    std::memcpy(outputs[i], frame.tensors[i].data(), output_bytes_[i]);
+  }
+  return kTfLiteOk;
+}
+
+void InterpreterPipelineRunner::StageLoop(int stage_index) {
+  Interpreter* interpreter = stages_[stage_index].get();
+  Frame frame;
+  while (queues_[stage_index]->Pop(&frame)) {
+    // A frame that already failed in an earlier stage is passed through so
+    // the caller receives its status in submission order.
+    if (frame.status == kTfLiteOk) {
+      for (size_t i = 0; i < frame.tensors.size(); ++i) {
+        TfLiteTensor* tensor = interpreter->tensor(interpreter->inputs()[i]);
+        std::memcpy(tensor->data.raw, frame.tensors[i].data(), tensor->bytes);
+      }
+      frame.status = interpreter->Invoke();
+      if (frame.status == kTfLiteOk) {
+        frame.tensors.clear();
+        for (int output_index : interpreter->outputs()) {
+          const TfLiteTensor* tensor = interpreter->tensor(output_index);
+          frame.tensors.emplace_back(tensor->data.raw,
+                                     tensor->data.raw + tensor->bytes);
+        }
+      }
+    }
+    if (!queues_[stage_index + 1]->Push(std::move(frame))) return;
+  }
+}
+
+}  // namespace tools
+}  // namespace tflite
@@ -0,0 +1,132 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_INTERPRETER_PIPELINE_RUNNER_H_
+#define TENSORFLOW_LITE_TOOLS_INTERPRETER_PIPELINE_RUNNER_H_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>    // NOLINT(build/c++11)
+#include <thread>   // NOLINT(build/c++11)
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+
+namespace tflite {
+namespace tools {
+
+// Runs a sequence of interpreters as pipeline stages, one thread per stage,
+// so consecutive frames execute on different stages concurrently: frame N
+// runs stage 0 while frame N-1 runs stage 1. Stages are typically delegated
+// to different accelerators, e.g. an NPU-delegated feature extractor feeding
+// CPU postprocessing. Each stage boundary is a bounded frame queue whose
+// default depth of 2 double-buffers the inter-stage tensors: a stage fills
+// one slot while its consumer still reads the other.
+//
+// Usage:
+//
+//   auto runner = InterpreterPipelineRunner::Create(std::move(stages), {});
+//   runner->Push(frame0_inputs);   // Stage 0 starts on frame 0.
+//   runner->Push(frame1_inputs);   // Frames 0 and 1 now run concurrently.
+//   runner->Pop(frame0_outputs);
+//   runner->Pop(frame1_outputs);
+//
+// Frames leave the pipeline in submission order. `Push` blocks when every
+// boundary slot is full, providing backpressure; `Pop` blocks until the
+// oldest frame has left the last stage. `Push` and `Pop` may be called from
+// different threads, but each must be called from one thread at a time.
+class InterpreterPipelineRunner {
+ public:
+  struct Options {
+    // Number of frames buffered at each stage boundary. The default of 2
+    // lets a stage produce frame N while the next stage still reads
+    // frame N-1.
+    int boundary_depth = 2;
+  };
+
+  // Takes ownership of the stage interpreters. Stage i's outputs must match
+  // stage i+1's inputs in number and byte size. Returns nullptr if `stages`
+  // is empty, the options are invalid, the stages are incompatible, or a
+  // stage cannot allocate its tensors.
+  static std::unique_ptr<InterpreterPipelineRunner> Create(
+      std::vector<std::unique_ptr<Interpreter>> stages,
+      const Options& options);
+
+  // Joins the stage threads. Frames still inside the pipeline are discarded.
+  ~InterpreterPipelineRunner();
+
+  // Submits one frame. `inputs[i]` must point to `input_bytes(i)` bytes for
+  // the i-th input of the first stage; the data is copied before returning.
+  TfLiteStatus Push(const std::vector<const void*>& inputs);
+
+  // Receives the oldest in-flight frame. `outputs[i]` must have room for
+  // `output_bytes(i)` bytes of the i-th output of the last stage. Returns
+  // the frame's status; a frame that failed in some stage skips the
+  // remaining stages and reports the failure here.
+  TfLiteStatus Pop(const std::vector<void*>& outputs);
+
+  // Number of bytes one frame provides for the i-th input of the first
+  // stage.
+  size_t input_bytes(int i) const { return input_bytes_[i]; }
+  // Number of bytes one frame receives for the i-th output of the last
+  // stage.
+  size_t output_bytes(int i) const { return output_bytes_[i]; }
+
+ private:
+  struct Frame {
+    std::vector<std::vector<char>> tensors;
+    TfLiteStatus status = kTfLiteOk;
+  };
+
+  // Bounded FIFO connecting two pipeline stages. Closing it wakes all
+  // blocked producers and consumers and makes further operations fail.
+  class FrameQueue {
+   public:
+    explicit FrameQueue(size_t capacity) : capacity_(capacity) {}
+
+    // Blocks while the queue is full. Returns false once closed.
+    bool Push(Frame frame);
+    // Blocks while the queue is empty. Returns false once closed.
+    bool Pop(Frame* frame);
+    void Close();
+
+   private:
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Frame> frames_;
+    bool closed_ = false;
+  };
+
+  explicit InterpreterPipelineRunner(const Options& options)
+      : options_(options) {}
+
+  void StageLoop(int stage_index);
+
+  const Options options_;
+  std::vector<size_t> input_bytes_;
+  std::vector<size_t> output_bytes_;
+  std::vector<std::unique_ptr<Interpreter>> stages_;
+  // queues_[i] feeds stage i; queues_[stages_.size()] holds finished frames.
+  std::vector<std::unique_ptr<FrameQueue>> queues_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace tools
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_INTERPRETER_PIPELINE_RUNNER_H_
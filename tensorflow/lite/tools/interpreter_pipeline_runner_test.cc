@@ -0,0 +1,168 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/tools/interpreter_pipeline_runner.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/builtin_op_kernels.h"
+
+namespace tflite {
+namespace tools {
+namespace {
+
+constexpr int kElementCount = 4;
+
+// Builds an interpreter for a model that adds its two {1, 4} float inputs.
+std::unique_ptr<Interpreter> BuildAddInterpreter() {
+  auto interpreter = std::make_unique<Interpreter>();
+  if (interpreter->AddTensors(3) != kTfLiteOk) return nullptr;
+  interpreter->SetInputs({0, 1});
+  interpreter->SetOutputs({2});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 3; ++i) {
+    if (interpreter->SetTensorParametersReadWrite(
+            i, kTfLiteFloat32, "", {1, kElementCount}, quant) != kTfLiteOk) {
+      return nullptr;
+    }
+  }
+  auto* add_reg = ops::builtin::Register_ADD();
+  TfLiteAddParams* builtin_data =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  builtin_data->activation = kTfLiteActNone;
+  if (interpreter->AddNodeWithParameters({0, 1}, {2}, nullptr, 0, builtin_data,
+                                         add_reg) != kTfLiteOk) {
+    return nullptr;
+  }
+  return interpreter;
+}
+
+// Builds an interpreter for a model that applies RELU to its {1, 4} float
+// input.
+std::unique_ptr<Interpreter> BuildReluInterpreter() {
+  auto interpreter = std::make_unique<Interpreter>();
+  if (interpreter->AddTensors(2) != kTfLiteOk) return nullptr;
+  interpreter->SetInputs({0});
+  interpreter->SetOutputs({1});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 2; ++i) {
+    if (interpreter->SetTensorParametersReadWrite(
+            i, kTfLiteFloat32, "", {1, kElementCount}, quant) != kTfLiteOk) {
+      return nullptr;
+    }
+  }
+  if (interpreter->AddNodeWithParameters(
+          {0}, {1}, nullptr, 0, nullptr,
+          ops::builtin::Register_RELU()) != kTfLiteOk) {
+    return nullptr;
+  }
+  return interpreter;
+}
+
+std::unique_ptr<InterpreterPipelineRunner> BuildAddReluPipeline(
+    const InterpreterPipelineRunner::Options& options = {}) {
+  std::vector<std::unique_ptr<Interpreter>> stages;
+  stages.push_back(BuildAddInterpreter());
+  stages.push_back(BuildReluInterpreter());
+  return InterpreterPipelineRunner::Create(std::move(stages), options);
+}
+
+TEST(InterpreterPipelineRunnerTest, InvalidCreate) {
+  EXPECT_EQ(InterpreterPipelineRunner::Create({}, {}), nullptr);
+
+  InterpreterPipelineRunner::Options options;
+  options.boundary_depth = 0;
+  EXPECT_EQ(BuildAddReluPipeline(options), nullptr);
+
+  // Stage 0 produces one tensor but stage 1 expects two.
+  std::vector<std::unique_ptr<Interpreter>> stages;
+  stages.push_back(BuildAddInterpreter());
+  stages.push_back(BuildAddInterpreter());
+  EXPECT_EQ(InterpreterPipelineRunner::Create(std::move(stages), {}), nullptr);
+}
+
+TEST(InterpreterPipelineRunnerTest, SingleFrame) {
+  auto runner = BuildAddReluPipeline();
+  ASSERT_NE(runner, nullptr);
+  EXPECT_EQ(runner->input_bytes(0), kElementCount * sizeof(float));
+  EXPECT_EQ(runner->output_bytes(0), kElementCount * sizeof(float));
+
+  const float lhs[kElementCount] = {1, -2, 3, -4};
+  const float rhs[kElementCount] = {10, -20, 30, 2};
+  float result[kElementCount] = {};
+  ASSERT_EQ(runner->Push({lhs, rhs}), kTfLiteOk);
+  ASSERT_EQ(runner->Pop({result}), kTfLiteOk);
+  for (int i = 0; i < kElementCount; ++i) {
+    EXPECT_EQ(result[i], std::max(lhs[i] + rhs[i], 0.0f));
+  }
+}
+
+TEST(InterpreterPipelineRunnerTest, WrongArity) {
+  auto runner = BuildAddReluPipeline();
+  ASSERT_NE(runner, nullptr);
+  const float lhs[kElementCount] = {};
+  float result[kElementCount] = {};
+  EXPECT_EQ(runner->Push({lhs}), kTfLiteError);
+  EXPECT_EQ(runner->Pop({result, result}), kTfLiteError);
+}
+
+TEST(InterpreterPipelineRunnerTest, FramesStayInOrder) {
+  auto runner = BuildAddReluPipeline();
+  ASSERT_NE(runner, nullptr);
+
+  constexpr int kNumFrames = 64;
+  std::thread producer([&runner] {
+    for (int f = 0; f < kNumFrames; ++f) {
+      float lhs[kElementCount];
+      float rhs[kElementCount];
+      for (int i = 0; i < kElementCount; ++i) {
+        lhs[i] = f + i;
+        rhs[i] = f - 2 * i;
+      }
+      ASSERT_EQ(runner->Push({lhs, rhs}), kTfLiteOk);
+    }
+  });
+  for (int f = 0; f < kNumFrames; ++f) {
+    float result[kElementCount] = {};
+    ASSERT_EQ(runner->Pop({result}), kTfLiteOk);
+    for (int i = 0; i < kElementCount; ++i) {
+      EXPECT_EQ(result[i], std::max<float>(2 * f - i, 0.0f));
+    }
+  }
+  producer.join();
+}
+
+TEST(InterpreterPipelineRunnerTest, DiscardsInFlightFramesOnDestruction) {
+  auto runner = BuildAddReluPipeline();
+  ASSERT_NE(runner, nullptr);
+  const float lhs[kElementCount] = {1, 2, 3, 4};
+  const float rhs[kElementCount] = {5, 6, 7, 8};
+  ASSERT_EQ(runner->Push({lhs, rhs}), kTfLiteOk);
+  ASSERT_EQ(runner->Push({lhs, rhs}), kTfLiteOk);
+  // The destructor must join the stage threads without popping the frames.
+  runner.reset();
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace tflite
@@ -0,0 +1,199 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/tools/interpreter_pool_dispatcher.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+
+namespace tflite {
+namespace tools {
+
+namespace {
+
+// Returns the size in bytes of one batch element of `tensor`, treating
+// dimension 0 as the batch dimension, or 0 if the tensor has no positive
+// batch dimension.
+size_t ElementBytes(const TfLiteTensor* tensor) {
+  if (tensor->dims == nullptr || tensor->dims->size == 0 ||
+      tensor->dims->data[0] <= 0) {
+    return 0;
+  }
+  return tensor->bytes / tensor->dims->data[0];
+}
+
+}  // namespace
+
+std::unique_ptr<InterpreterPoolDispatcher> InterpreterPoolDispatcher::Create(
+    const InterpreterFactory& factory, const Options& options) {
+  if (options.num_interpreters < 1 || options.max_batch_size < 1 ||
+      options.batch_timeout_us < 0) {
+    return nullptr;
+  }
+  std::unique_ptr<InterpreterPoolDispatcher> dispatcher(
+      new InterpreterPoolDispatcher(options));
+  for (int i = 0; i < options.num_interpreters; ++i) {
+    std::unique_ptr<Interpreter> interpreter = factory();
+    if (interpreter == nullptr || interpreter->AllocateTensors() != kTfLiteOk) {
+      return nullptr;
+    }
+    dispatcher->interpreters_.push_back(std::move(interpreter));
+  }
+
+  const Interpreter* first = dispatcher->interpreters_.front().get();
+  for (int input : first->inputs()) {
+    const size_t bytes = ElementBytes(first->tensor(input));
+    if (bytes == 0) return nullptr;
+    dispatcher->input_bytes_.push_back(bytes);
+  }
+  for (int output : first->outputs()) {
+    const size_t bytes = ElementBytes(first->tensor(output));
+    if (bytes == 0) return nullptr;
+    dispatcher->output_bytes_.push_back(bytes);
+  }
+
+  InterpreterPoolDispatcher* self = dispatcher.get();
+  for (auto& interpreter : dispatcher->interpreters_) {
+    Interpreter* raw_interpreter = interpreter.get();
+    dispatcher->workers_.emplace_back(
+        [self, raw_interpreter] { self->WorkerLoop(raw_interpreter); });
+  }
+  return dispatcher;
+}
+
+InterpreterPoolDispatcher::~InterpreterPoolDispatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+TfLiteStatus InterpreterPoolDispatcher::Invoke(
+    const std::vector<const void*>& inputs,
+    const std::vector<void*>& outputs) {
+  if (inputs.size() != input_bytes_.size() ||
+      outputs.size() != output_bytes_.size()) {
+    return kTfLiteError;
+  }
+  Request request;
+  request.inputs = &inputs;
+  request.outputs = &outputs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_) return kTfLiteError;
+    queue_.push_back(&request);
+  }
+  queue_cv_.notify_one();
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [&request] { return request.done; });
+  return request.status;
+}
+
+void InterpreterPoolDispatcher::WorkerLoop(Interpreter* interpreter) {
+  while (true) {
+    std::vector<Request*> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queue_cv_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) return;  // Shutting down and fully drained.
+      batch.push_back(queue_.front());
+      queue_.pop_front();
+      if (options_.max_batch_size > 1) {
+        const auto deadline =
+            std::chrono::steady_clock::now() +
+            std::chrono::microseconds(options_.batch_timeout_us);
+        while (batch.size() < static_cast<size_t>(options_.max_batch_size)) {
+          if (!queue_.empty()) {
+            batch.push_back(queue_.front());
+            queue_.pop_front();
+            continue;
+          }
+          if (shutdown_ ||
+              queue_cv_.wait_until(lock, deadline) ==
+                  std::cv_status::timeout) {
+            break;
+          }
+        }
+      }
+    }
+
+    const TfLiteStatus status = RunBatch(interpreter, batch);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Request* request : batch) {
+        request->status = status;
+        request->done = true;
+      }
+    }
+    done_cv_.notify_all();
+  }
+}
+
+TfLiteStatus InterpreterPoolDispatcher::RunBatch(
+    Interpreter* interpreter, const std::vector<Request*>& batch) {
+  const int batch_size = static_cast<int>(batch.size());
+
+  // Resize the batch dimension if the previous batch had a different size.
+  bool needs_allocation = false;
+  for (size_t i = 0; i < input_bytes_.size(); ++i) {
+    const int input_index = interpreter->inputs()[i];
+    const TfLiteTensor* tensor = interpreter->tensor(input_index);
+    if (tensor->dims->data[0] == batch_size) continue;
+    std::vector<int> dims(tensor->dims->data,
+                          tensor->dims->data + tensor->dims->size);
+    dims[0] = batch_size;
+    if (interpreter->ResizeInputTensor(input_index, dims) != kTfLiteOk) {
+      return kTfLiteError;
+    }
+    needs_allocation = true;
+  }
+  if (needs_allocation && interpreter->AllocateTensors() != kTfLiteOk) {
+    return kTfLiteError;
+  }
+
+  // Gather each request's inputs into its slice of the batch.
+  for (size_t i = 0; i < input_bytes_.size(); ++i) {
+    char* data = interpreter->tensor(interpreter->inputs()[i])->data.raw;
+    for (int j = 0; j < batch_size; ++j) {
+      std::memcpy(data + j * input_bytes_[i], (*batch[j]->inputs)[i],
+                  input_bytes_[i]);
+    }
+  }
+
+  const TfLiteStatus status = interpreter->Invoke();
+  if (status != kTfLiteOk) return status;
+
+  // Scatter the outputs back to the requests.
+  for (size_t i = 0; i < output_bytes_.size(); ++i) {
+    const char* data = interpreter->tensor(interpreter->outputs()[i])->data.raw;
+    for (int j = 0; j < batch_size; ++j) {
+      std::memcpy((*batch[j]->outputs)[i], data + j * output_bytes_[i],
+                  output_bytes_[i]);
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace tools
+}  // namespace tflite
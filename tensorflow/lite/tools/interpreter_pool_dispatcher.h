@@ -0,0 +1,125 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_INTERPRETER_POOL_DISPATCHER_H_
+#define TENSORFLOW_LITE_TOOLS_INTERPRETER_POOL_DISPATCHER_H_
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>    // NOLINT(build/c++11)
+#include <thread>   // NOLINT(build/c++11)
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+
+namespace tflite {
+namespace tools {
+
+// Dispatches blocking inference requests across a pool of interpreters.
+//
+// Each worker thread owns one interpreter for the lifetime of the pool, so
+// per-interpreter state (delegate thread pools, packed weights, scratch
+// buffers) stays warm on the thread that uses it. When `max_batch_size > 1`,
+// requests that arrive close together are combined into one micro-batch: the
+// worker resizes the model's batch dimension (dimension 0 of every input)
+// with ResizeInputTensor, copies each request's inputs into its slice, runs a
+// single Invoke, and scatters the outputs back. Models must therefore accept
+// a dynamic batch dimension when micro-batching is enabled.
+//
+// Usage:
+//
+//   auto dispatcher = InterpreterPoolDispatcher::Create(
+//       [&] { return BuildInterpreter(model); }, options);
+//   // From any number of request threads:
+//   TfLiteStatus status = dispatcher->Invoke(inputs, outputs);
+//
+// All methods are thread-safe.
+class InterpreterPoolDispatcher {
+ public:
+  struct Options {
+    // Number of worker threads, each owning one interpreter.
+    int num_interpreters = 1;
+    // Maximum number of requests combined into one Invoke. 1 disables
+    // micro-batching and leaves the model's shapes untouched.
+    int max_batch_size = 1;
+    // How long a worker waits for additional requests to fill a micro-batch
+    // after picking up the first one. 0 never waits: batches are formed only
+    // from requests that are already queued.
+    int batch_timeout_us = 100;
+  };
+
+  // Builds one interpreter per worker. Every invocation must produce an
+  // interpreter for the same model.
+  using InterpreterFactory = std::function<std::unique_ptr<Interpreter>()>;
+
+  // Returns nullptr if the options are invalid, the factory fails, or the
+  // produced interpreters cannot allocate their tensors.
+  static std::unique_ptr<InterpreterPoolDispatcher> Create(
+      const InterpreterFactory& factory, const Options& options);
+
+  // Drains outstanding requests and joins the workers.
+  ~InterpreterPoolDispatcher();
+
+  // Runs one inference. `inputs[i]` must point to `input_bytes(i)` bytes for
+  // the i-th model input; `outputs[i]` must have room for `output_bytes(i)`
+  // bytes of the i-th model output. Both cover exactly one batch element.
+  // Blocks until the request has been executed and returns its status. If a
+  // micro-batch fails, every request in it receives the failure status.
+  TfLiteStatus Invoke(const std::vector<const void*>& inputs,
+                      const std::vector<void*>& outputs);
+
+  // Number of bytes one request provides for the i-th model input, i.e. one
+  // batch element of the input tensor.
+  size_t input_bytes(int i) const { return input_bytes_[i]; }
+  // Number of bytes one request receives for the i-th model output.
+  size_t output_bytes(int i) const { return output_bytes_[i]; }
+
+ private:
+  struct Request {
+    const std::vector<const void*>* inputs;
+    const std::vector<void*>* outputs;
+    TfLiteStatus status = kTfLiteError;
+    bool done = false;
+  };
+
+  explicit InterpreterPoolDispatcher(const Options& options)
+      : options_(options) {}
+
+  void WorkerLoop(Interpreter* interpreter);
+  TfLiteStatus RunBatch(Interpreter* interpreter,
+                        const std::vector<Request*>& batch);
+
+  const Options options_;
+  std::vector<size_t> input_bytes_;
+  std::vector<size_t> output_bytes_;
+  std::vector<std::unique_ptr<Interpreter>> interpreters_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  // Signals workers that requests are queued or shutdown started.
+  std::condition_variable queue_cv_;
+  // Signals requesters that their request completed.
+  std::condition_variable done_cv_;
+  std::deque<Request*> queue_;
+  bool shutdown_ = false;
+};
+
+}  // namespace tools
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_INTERPRETER_POOL_DISPATCHER_H_
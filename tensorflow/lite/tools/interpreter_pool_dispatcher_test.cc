@@ -0,0 +1,140 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/tools/interpreter_pool_dispatcher.h"
+
+#include <cstdlib>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/builtin_op_kernels.h"
+
+namespace tflite {
+namespace tools {
+namespace {
+
+constexpr int kElementCount = 4;
+
+// Builds an interpreter for a model that adds its two {1, 4} float inputs.
+// Dimension 0 is the batch dimension.
+std::unique_ptr<Interpreter> BuildAddInterpreter() {
+  auto interpreter = std::make_unique<Interpreter>();
+  if (interpreter->AddTensors(3) != kTfLiteOk) return nullptr;
+  interpreter->SetInputs({0, 1});
+  interpreter->SetOutputs({2});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 3; ++i) {
+    if (interpreter->SetTensorParametersReadWrite(
+            i, kTfLiteFloat32, "", {1, kElementCount}, quant) != kTfLiteOk) {
+      return nullptr;
+    }
+  }
+  auto* add_reg = ops::builtin::Register_ADD();
+  TfLiteAddParams* builtin_data =
+      reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+  builtin_data->activation = kTfLiteActNone;
+  if (interpreter->AddNodeWithParameters({0, 1}, {2}, nullptr, 0, builtin_data,
+                                         add_reg) != kTfLiteOk) {
+    return nullptr;
+  }
+  return interpreter;
+}
+
+TEST(InterpreterPoolDispatcherTest, InvalidOptions) {
+  InterpreterPoolDispatcher::Options options;
+  options.num_interpreters = 0;
+  EXPECT_EQ(InterpreterPoolDispatcher::Create(BuildAddInterpreter, options),
+            nullptr);
+  options = InterpreterPoolDispatcher::Options();
+  options.max_batch_size = 0;
+  EXPECT_EQ(InterpreterPoolDispatcher::Create(BuildAddInterpreter, options),
+            nullptr);
+  options = InterpreterPoolDispatcher::Options();
+  options.batch_timeout_us = -1;
+  EXPECT_EQ(InterpreterPoolDispatcher::Create(BuildAddInterpreter, options),
+            nullptr);
+}
+
+TEST(InterpreterPoolDispatcherTest, FailingFactory) {
+  EXPECT_EQ(InterpreterPoolDispatcher::Create(
+                [] { return std::unique_ptr<Interpreter>(); },
+                InterpreterPoolDispatcher::Options()),
+            nullptr);
+}
+
+TEST(InterpreterPoolDispatcherTest, SingleInvoke) {
+  auto dispatcher = InterpreterPoolDispatcher::Create(
+      BuildAddInterpreter, InterpreterPoolDispatcher::Options());
+  ASSERT_NE(dispatcher, nullptr);
+  EXPECT_EQ(dispatcher->input_bytes(0), kElementCount * sizeof(float));
+  EXPECT_EQ(dispatcher->output_bytes(0), kElementCount * sizeof(float));
+
+  const float lhs[kElementCount] = {1, 2, 3, 4};
+  const float rhs[kElementCount] = {10, 20, 30, 40};
+  float sum[kElementCount] = {};
+  ASSERT_EQ(dispatcher->Invoke({lhs, rhs}, {sum}), kTfLiteOk);
+  for (int i = 0; i < kElementCount; ++i) {
+    EXPECT_EQ(sum[i], lhs[i] + rhs[i]);
+  }
+}
+
+TEST(InterpreterPoolDispatcherTest, WrongArity) {
+  auto dispatcher = InterpreterPoolDispatcher::Create(
+      BuildAddInterpreter, InterpreterPoolDispatcher::Options());
+  ASSERT_NE(dispatcher, nullptr);
+  const float lhs[kElementCount] = {};
+  float sum[kElementCount] = {};
+  EXPECT_EQ(dispatcher->Invoke({lhs}, {sum}), kTfLiteError);
+}
+
+TEST(InterpreterPoolDispatcherTest, ConcurrentMicroBatchedInvokes) {
+  InterpreterPoolDispatcher::Options options;
+  options.num_interpreters = 2;
+  options.max_batch_size = 4;
+  options.batch_timeout_us = 1000;
+  auto dispatcher =
+      InterpreterPoolDispatcher::Create(BuildAddInterpreter, options);
+  ASSERT_NE(dispatcher, nullptr);
+
+  constexpr int kNumRequests = 32;
+  std::vector<std::thread> threads;
+  threads.reserve(kNumRequests);
+  for (int r = 0; r < kNumRequests; ++r) {
+    threads.emplace_back([r, &dispatcher] {
+      float lhs[kElementCount];
+      float rhs[kElementCount];
+      float sum[kElementCount] = {};
+      for (int i = 0; i < kElementCount; ++i) {
+        lhs[i] = r + i;
+        rhs[i] = 2 * r - i;
+      }
+      ASSERT_EQ(dispatcher->Invoke({lhs, rhs}, {sum}), kTfLiteOk);
+      for (int i = 0; i < kElementCount; ++i) {
+        EXPECT_EQ(sum[i], lhs[i] + rhs[i]);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace tflite
@@ -153,6 +153,34 @@ class SparseReorderTest(test.TestCase, parameterized.TestCase):
             x_init_value=input_val.values)
         self.assertLess(err, 1e-11)
 
+  def testLargeOutOfOrder(self):
+    # Large enough to take the parallel bucket-sort path on CPU.
+    num_entries = 50000
+    np.random.seed(7)
+    ind = np.stack(
+        [
+            np.random.randint(0, 1000, num_entries),
+            np.random.randint(0, 1000, num_entries),
+        ],
+        axis=1,
+    ).astype(np.int64)
+    val = np.arange(num_entries).astype(np.float64)
+    shape = np.array([1000, 1000]).astype(np.int64)
+
+    # lexsort is stable, so duplicate indices keep their input order, which
+    # matches the kernel's tie-breaking.
+    order = np.lexsort((ind[:, 1], ind[:, 0]))
+    expected_ind = ind[order]
+    expected_val = val[order]
+
+    input_val = sparse_tensor.SparseTensorValue(ind, val, shape)
+    sp_output = sparse_ops.sparse_reorder(input_val)
+
+    output_val = self.evaluate(sp_output)
+    self.assertAllEqual(output_val.indices, expected_ind)
+    self.assertAllEqual(output_val.values, expected_val)
+    self.assertAllEqual(output_val.dense_shape, shape)
+
   def testShapeOverflow(self):
     # Test case for GitHub issue 45392
     sp_input = sparse_tensor.SparseTensor(
@@ -0,0 +1,160 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tsl/framework/allocation_telemetry.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+#include "tensorflow/tsl/lib/core/bits.h"
+#include "tensorflow/tsl/platform/logging.h"
+#include "tensorflow/tsl/platform/numbers.h"
+#include "tensorflow/tsl/platform/strcat.h"
+#include "tensorflow/tsl/util/env_var.h"
+
+namespace tsl {
+namespace {
+
+int SizeClass(int64_t bytes) {
+  if (bytes <= 1) return 0;
+  return std::min(Log2Ceiling64(bytes),
+                  AllocationTelemetry::kNumSizeClasses - 1);
+}
+
+// Relaxed atomic max.  Simultaneous updates may retry, but the final value is
+// the maximum of all observed values.
+void UpdateMax(std::atomic<int64_t>* max, int64_t value) {
+  int64_t current = max->load(std::memory_order_relaxed);
+  while (value > current &&
+         !max->compare_exchange_weak(current, value,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+}  // namespace
+
+/* static */ AllocationTelemetry* AllocationTelemetry::Get() {
+  static AllocationTelemetry* const instance = []() -> AllocationTelemetry* {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_ALLOCATOR_TELEMETRY", false, &enabled);
+    if (!s.ok()) {
+      LOG(WARNING) << "Allocation telemetry disabled: " << s.error_message();
+      return nullptr;
+    }
+    if (!enabled) return nullptr;
+    LOG(INFO) << "Allocation telemetry enabled; per-op allocation counters "
+              << "will be maintained for all BFC allocators.";
+    return new AllocationTelemetry;
+  }();
+  return instance;
+}
+
+AllocationTelemetry::OpEntry* AllocationTelemetry::GetOpEntry(
+    const char* op_name) {
+  if (op_name == nullptr) op_name = "(unknown)";
+  OpShard& shard =
+      op_shards_[absl::HashOf(absl::string_view(op_name)) % kNumShards];
+  mutex_lock l(shard.mu);
+  std::unique_ptr<OpEntry>& entry = shard.ops[op_name];
+  if (entry == nullptr) entry = std::make_unique<OpEntry>();
+  return entry.get();
+}
+
+void AllocationTelemetry::RecordAlloc(const void* ptr, int64_t bytes) {
+  OpEntry* entry = GetOpEntry(tensorflow::profiler::
+                                  ScopedMemoryDebugAnnotation::
+                                      CurrentAnnotation()
+                                          .pending_op_name);
+  entry->num_allocs.fetch_add(1, std::memory_order_relaxed);
+  entry->alloc_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  entry->size_class_allocs[SizeClass(bytes)].fetch_add(
+      1, std::memory_order_relaxed);
+  int64_t live =
+      entry->live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  UpdateMax(&entry->peak_live_bytes, live);
+
+  LiveShard& shard = live_shards_[absl::HashOf(ptr) % kNumShards];
+  mutex_lock l(shard.mu);
+  shard.live[ptr] = Allocation{entry, bytes};
+}
+
+void AllocationTelemetry::RecordDealloc(const void* ptr) {
+  Allocation allocation;
+  {
+    LiveShard& shard = live_shards_[absl::HashOf(ptr) % kNumShards];
+    mutex_lock l(shard.mu);
+    auto it = shard.live.find(ptr);
+    if (it == shard.live.end()) return;
+    allocation = it->second;
+    shard.live.erase(it);
+  }
+  allocation.entry->live_bytes.fetch_sub(allocation.bytes,
+                                         std::memory_order_relaxed);
+}
+
+std::vector<AllocationTelemetry::OpStats> AllocationTelemetry::Snapshot() {
+  std::vector<OpStats> result;
+  for (OpShard& shard : op_shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& entry : shard.ops) {
+      OpStats stats;
+      stats.op_name = entry.first;
+      const OpEntry& counters = *entry.second;
+      stats.num_allocs = counters.num_allocs.load(std::memory_order_relaxed);
+      stats.alloc_bytes = counters.alloc_bytes.load(std::memory_order_relaxed);
+      stats.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+      stats.peak_live_bytes =
+          counters.peak_live_bytes.load(std::memory_order_relaxed);
+      for (int i = 0; i < kNumSizeClasses; ++i) {
+        stats.size_class_allocs[i] =
+            counters.size_class_allocs[i].load(std::memory_order_relaxed);
+      }
+      result.push_back(std::move(stats));
+    }
+  }
+  std::sort(result.begin(), result.end(),
+            [](const OpStats& a, const OpStats& b) {
+              if (a.live_bytes != b.live_bytes) {
+                return a.live_bytes > b.live_bytes;
+              }
+              return a.op_name < b.op_name;
+            });
+  return result;
+}
+
+std::string AllocationTelemetry::DebugString(int max_ops) {
+  std::vector<OpStats> snapshot = Snapshot();
+  std::string result =
+      strings::StrCat("Per-op allocation telemetry (top ", max_ops,
+                      " ops by live bytes):\n");
+  int printed = 0;
+  for (const OpStats& stats : snapshot) {
+    if (printed++ >= max_ops) break;
+    strings::StrAppend(
+        &result, "  ", stats.op_name, ": live ",
+        strings::HumanReadableNumBytes(stats.live_bytes), ", peak ",
+        strings::HumanReadableNumBytes(stats.peak_live_bytes), ", ",
+        stats.num_allocs, " allocs totalling ",
+        strings::HumanReadableNumBytes(stats.alloc_bytes), "\n");
+  }
+  return result;
+}
+
+}  // namespace tsl
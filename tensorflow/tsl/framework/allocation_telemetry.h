@@ -0,0 +1,132 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_FRAMEWORK_ALLOCATION_TELEMETRY_H_
+#define TENSORFLOW_TSL_FRAMEWORK_ALLOCATION_TELEMETRY_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/tsl/platform/macros.h"
+#include "tensorflow/tsl/platform/mutex.h"
+#include "tensorflow/tsl/platform/thread_annotations.h"
+#include "tensorflow/tsl/platform/types.h"
+
+namespace tsl {
+
+// Always-on allocation telemetry with per-op attribution.
+//
+// TrackingAllocator attributes allocations to ops, but only while a traced
+// step is running, so it cannot explain an OOM that happens outside of a
+// trace.  When TF_ALLOCATOR_TELEMETRY is set, BFCAllocator instead reports
+// every allocation here; the op is taken from the thread's pending
+// ScopedMemoryDebugAnnotation, which the executor installs around each kernel.
+//
+// Per op the telemetry maintains allocation counts, a power-of-two size-class
+// histogram, live bytes and the live-bytes high-water mark.  Counters are
+// plain relaxed atomics updated outside of any lock; the op and live-pointer
+// tables are sharded so concurrent allocators rarely contend on a mutex.  Op
+// entries are never deleted, so the table stays bounded by the number of
+// distinct op names in the process.
+//
+// The table can be queried at runtime through Snapshot(), and BFCAllocator
+// appends DebugString() to its memory dump when an allocation fails, so the
+// ops holding memory at OOM time appear in the log without reproducing the
+// failure under tracing.
+class AllocationTelemetry {
+ public:
+  // Allocation sizes are bucketed by ceil(log2(bytes)), saturated.
+  static constexpr int kNumSizeClasses = 40;
+
+  // Aggregate counters for one op name.
+  struct OpStats {
+    std::string op_name;
+    int64_t num_allocs = 0;
+    int64_t alloc_bytes = 0;      // cumulative bytes requested
+    int64_t live_bytes = 0;
+    int64_t peak_live_bytes = 0;  // high-water mark of live_bytes
+    int64_t size_class_allocs[kNumSizeClasses] = {};
+  };
+
+  // Returns the process-wide telemetry instance, or nullptr when disabled
+  // (TF_ALLOCATOR_TELEMETRY unset or false).  The environment variable is
+  // read once on first call.
+  static AllocationTelemetry* Get();
+
+  // Accounts an allocation of `bytes` returned at `ptr`, attributed to the
+  // calling thread's pending memory debug annotation ("(unknown)" when no
+  // annotation is active).
+  void RecordAlloc(const void* ptr, int64_t bytes);
+
+  // Accounts the deallocation of `ptr`.  Unknown pointers (allocated before
+  // telemetry was first queried, or by an allocator that does not report
+  // here) are ignored.
+  void RecordDealloc(const void* ptr);
+
+  // Returns the per-op totals accumulated since process start, ops with the
+  // largest live_bytes first.
+  std::vector<OpStats> Snapshot();
+
+  // Human-readable table of the top `max_ops` ops by live bytes, for OOM
+  // dumps and logging.
+  std::string DebugString(int max_ops);
+
+ private:
+  friend class AllocationTelemetryTest;
+
+  struct OpEntry {
+    std::atomic<int64_t> num_allocs{0};
+    std::atomic<int64_t> alloc_bytes{0};
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> peak_live_bytes{0};
+    std::atomic<int64_t> size_class_allocs[kNumSizeClasses] = {};
+  };
+
+  struct Allocation {
+    OpEntry* entry;
+    int64_t bytes;
+  };
+
+  static constexpr int kNumShards = 16;
+
+  struct alignas(64) OpShard {
+    mutex mu;
+    // Values are never deleted, so OpEntry pointers remain valid without
+    // the shard lock.
+    absl::flat_hash_map<std::string, std::unique_ptr<OpEntry>> ops
+        TF_GUARDED_BY(mu);
+  };
+
+  struct alignas(64) LiveShard {
+    mutex mu;
+    absl::flat_hash_map<const void*, Allocation> live TF_GUARDED_BY(mu);
+  };
+
+  AllocationTelemetry() = default;
+
+  OpEntry* GetOpEntry(const char* op_name);
+
+  OpShard op_shards_[kNumShards];
+  LiveShard live_shards_[kNumShards];
+
+  TF_DISALLOW_COPY_AND_ASSIGN(AllocationTelemetry);
+};
+
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_FRAMEWORK_ALLOCATION_TELEMETRY_H_
@@ -0,0 +1,90 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tsl/framework/allocation_telemetry.h"
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+#include "tensorflow/tsl/platform/test.h"
+
+namespace tsl {
+
+// Friend of AllocationTelemetry; constructs instances directly rather than
+// going through the environment-gated singleton.
+class AllocationTelemetryTest : public ::testing::Test {
+ protected:
+  static std::unique_ptr<AllocationTelemetry> MakeTelemetry() {
+    return std::unique_ptr<AllocationTelemetry>(new AllocationTelemetry);
+  }
+};
+
+TEST_F(AllocationTelemetryTest, TracksLiveBytesAndHighWaterMark) {
+  auto telemetry = MakeTelemetry();
+  char buffer[3];
+  {
+    tensorflow::profiler::ScopedMemoryDebugAnnotation annotation("matmul_1");
+    telemetry->RecordAlloc(&buffer[0], 1024);
+    telemetry->RecordAlloc(&buffer[1], 512);
+  }
+  telemetry->RecordDealloc(&buffer[0]);
+
+  std::vector<AllocationTelemetry::OpStats> snapshot = telemetry->Snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].op_name, "matmul_1");
+  EXPECT_EQ(snapshot[0].num_allocs, 2);
+  EXPECT_EQ(snapshot[0].alloc_bytes, 1536);
+  EXPECT_EQ(snapshot[0].live_bytes, 512);
+  EXPECT_EQ(snapshot[0].peak_live_bytes, 1536);
+  // 1024 -> bucket 10, 512 -> bucket 9.
+  EXPECT_EQ(snapshot[0].size_class_allocs[10], 1);
+  EXPECT_EQ(snapshot[0].size_class_allocs[9], 1);
+}
+
+TEST_F(AllocationTelemetryTest, AttributesAllocationsWithoutAnnotation) {
+  auto telemetry = MakeTelemetry();
+  int dummy;
+  telemetry->RecordAlloc(&dummy, 64);
+  std::vector<AllocationTelemetry::OpStats> snapshot = telemetry->Snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].op_name, "(unknown)");
+}
+
+TEST_F(AllocationTelemetryTest, IgnoresUnknownDeallocations) {
+  auto telemetry = MakeTelemetry();
+  int dummy;
+  telemetry->RecordDealloc(&dummy);  // Must not crash or create entries.
+  EXPECT_TRUE(telemetry->Snapshot().empty());
+}
+
+TEST_F(AllocationTelemetryTest, SortsSnapshotByLiveBytes) {
+  auto telemetry = MakeTelemetry();
+  char buffer[2];
+  {
+    tensorflow::profiler::ScopedMemoryDebugAnnotation annotation("small_op");
+    telemetry->RecordAlloc(&buffer[0], 16);
+  }
+  {
+    tensorflow::profiler::ScopedMemoryDebugAnnotation annotation("big_op");
+    telemetry->RecordAlloc(&buffer[1], 1 << 20);
+  }
+  std::vector<AllocationTelemetry::OpStats> snapshot = telemetry->Snapshot();
+  ASSERT_EQ(snapshot.size(), 2);
+  EXPECT_EQ(snapshot[0].op_name, "big_op");
+  EXPECT_EQ(snapshot[1].op_name, "small_op");
+}
+
+}  // namespace tsl
@@ -20,6 +20,7 @@ limitations under the License.
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "tensorflow/tsl/framework/allocation_telemetry.h"
 #include "tensorflow/tsl/framework/allocator_retry.h"
 #include "tensorflow/tsl/lib/core/bits.h"
 #include "tensorflow/tsl/platform/file_system.h"
@@ -304,6 +305,10 @@ void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                           allocation_attr);
     }
   }();
+  AllocationTelemetry* telemetry = AllocationTelemetry::Get();
+  if (TF_PREDICT_FALSE(telemetry != nullptr) && result != nullptr) {
+    telemetry->RecordAlloc(result, num_bytes);
+  }
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << result;
   return result;
 }
@@ -326,25 +331,7 @@ bool BFCAllocator::DeallocateFreeRegions(size_t rounded_bytes)
 
   // Searching for free regions.
   absl::flat_hash_set<void*> free_region_ptrs;
-  size_t total_free_bytes = 0;
-  for (const AllocationRegion& region : region_manager_.regions()) {
-    ChunkHandle h = region_manager_.get_handle(region.ptr());
-    bool any_use = false;
-    while (h != kInvalidChunkHandle) {
-      const Chunk* c = ChunkFromHandle(h);
-      if (c->in_use()) {
-        any_use = true;
-        break;
-      }
-      h = c->next;
-    }
-
-    if (!any_use) {
-      VLOG(2) << "Found free region with ptr = " << region.ptr();
-      free_region_ptrs.insert(region.ptr());
-      total_free_bytes += region.memory_size();
-    }
-  }
+  size_t total_free_bytes = FindFreeRegions(&free_region_ptrs);
 
   if (total_free_bytes == 0) {
     return false;
@@ -373,6 +360,53 @@ bool BFCAllocator::DeallocateFreeRegions(size_t rounded_bytes)
   return true;
 }
 
+size_t BFCAllocator::FindFreeRegions(
+    absl::flat_hash_set<void*>* free_region_ptrs)
+    TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+  size_t total_free_bytes = 0;
+  for (const AllocationRegion& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    bool any_use = false;
+    while (h != kInvalidChunkHandle) {
+      const Chunk* c = ChunkFromHandle(h);
+      if (c->in_use()) {
+        any_use = true;
+        break;
+      }
+      h = c->next;
+    }
+
+    if (!any_use) {
+      VLOG(2) << "Found free region with ptr = " << region.ptr();
+      free_region_ptrs->insert(region.ptr());
+      total_free_bytes += region.memory_size();
+    }
+  }
+  return total_free_bytes;
+}
+
+size_t BFCAllocator::ReleaseFreeRegions() {
+  mutex_lock l(lock_);
+
+  // Merge any timestamped chunks whose counts have become safe, so that
+  // regions kept apart only by held-out chunks can be recognized as free.
+  if (!timestamped_chunks_.empty()) {
+    MergeTimestampedChunks(0);
+  }
+
+  absl::flat_hash_set<void*> free_region_ptrs;
+  size_t total_free_bytes = FindFreeRegions(&free_region_ptrs);
+  if (total_free_bytes == 0) {
+    return 0;
+  }
+
+  VLOG(1) << "ReleaseFreeRegions: releasing " << total_free_bytes
+          << " bytes across " << free_region_ptrs.size()
+          << " wholly-free regions of " << Name();
+  DeallocateRegions(free_region_ptrs);
+  return total_free_bytes;
+}
+
 void BFCAllocator::DeallocateRegions(
     const absl::flat_hash_set<void*>& region_ptrs)
     TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
@@ -490,6 +524,10 @@ void* BFCAllocator::AllocateRawInternal(size_t unused_alignment,
         << "\nCurrent allocation summary follows.";
     DumpMemoryLog(rounded_bytes);
     LOG(WARNING) << RenderOccupancy();
+    AllocationTelemetry* telemetry = AllocationTelemetry::Get();
+    if (telemetry != nullptr) {
+      LOG(WARNING) << telemetry->DebugString(/*max_ops=*/20);
+    }
   }
   return nullptr;
 }
@@ -679,6 +717,10 @@ void BFCAllocator::SplitChunk(BFCAllocator::ChunkHandle h, size_t num_bytes) {
 void BFCAllocator::DeallocateRaw(void* ptr) {
   VLOG(3) << "DeallocateRaw " << Name() << " "
           << (ptr ? RequestedSize(ptr) : 0);
+  AllocationTelemetry* telemetry = AllocationTelemetry::Get();
+  if (TF_PREDICT_FALSE(telemetry != nullptr) && ptr != nullptr) {
+    telemetry->RecordDealloc(ptr);
+  }
   DeallocateRawInternal(ptr);
   retry_helper_.NotifyDealloc();
 }
@@ -107,6 +107,18 @@ class BFCAllocator : public Allocator {
 
   MemoryDump RecordMemoryMap();
 
+  // Releases any wholly-free allocation regions back to the suballocator,
+  // regardless of the garbage_collection option, and returns the number of
+  // bytes given back.  Live chunks are never moved; only regions in which no
+  // chunk is in use are released.
+  //
+  // Intended to be called at safe points (e.g. between steps) in long-running
+  // jobs with variable shapes, where external fragmentation otherwise
+  // accumulates across regions until allocation fails despite ample free
+  // bytes.  Releasing the free regions lets the suballocator re-form them
+  // into larger contiguous regions on a later Extend().
+  size_t ReleaseFreeRegions();
+
  private:
   struct Bin;
 
@@ -461,6 +473,11 @@ class BFCAllocator : public Allocator {
   // found and freed; false otherwise.
   bool DeallocateFreeRegions(size_t rounded_bytes);
 
+  // Collects the start pointers of all regions in which no chunk is in use
+  // into 'free_region_ptrs' and returns the total size of those regions.
+  size_t FindFreeRegions(absl::flat_hash_set<void*>* free_region_ptrs)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Helper function to deallocate regions.
   void DeallocateRegions(const absl::flat_hash_set<void*>& region_ptrs)
       TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
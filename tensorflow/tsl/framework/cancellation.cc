@@ -43,52 +43,66 @@ void CancellationManager::StartCancel() {
 }
 
 void CancellationManager::StartCancelWithStatus(const Status& status) {
-  gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
   std::forward_list<CancellationManager*> children_to_cancel;
   Notification* cancelled_notification = nullptr;
+  State* state = nullptr;
   {
     mutex_lock l(mu_);
-    if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+    if (is_cancelled_.load(std::memory_order_relaxed) ||
+        is_cancelling_.load(std::memory_order_relaxed)) {
       return;
     }
-    is_cancelling_ = true;
-    if (state_) {
-      std::swap(state_->callbacks, callbacks_to_run);
-
+    // Once this store is visible under a shard's mutex, no further callback
+    // can be registered with that shard.
+    is_cancelling_.store(true, std::memory_order_relaxed);
+    state = state_.get();
+    if (state) {
       // Remove all children from the list of children.
-      CancellationManager* child = state_->first_child;
+      CancellationManager* child = state->first_child;
       while (child != nullptr) {
         children_to_cancel.push_front(child);
         child->is_removed_from_parent_ = true;
         child = child->next_sibling_;
       }
-      state_->first_child = nullptr;
+      state->first_child = nullptr;
 
-      cancelled_notification = &state_->cancelled_notification;
+      cancelled_notification = &state->cancelled_notification;
     }
   }
-  // We call these callbacks without holding mu_, so that concurrent
+  // We call these callbacks without holding any mutex, so that concurrent
   // calls to DeregisterCallback, which can happen asynchronously, do
   // not block. The callbacks remain valid because any concurrent call
   // to DeregisterCallback will block until the
   // cancelled_notification_ is notified.
-  for (auto key_and_value : callbacks_to_run) {
-    CallbackConfiguration& config = key_and_value.second;
-    if (!status.ok() && config.log_error) {
-      LOG(WARNING) << "Cancellation callback \"" << config.name
-                   << "\" is triggered due to a "
-                   << (StatusGroup::IsDerived(status) ? "derived" : "root")
-                   << " error: " << status.ToString();
+  if (state) {
+    for (CallbackShard& shard : state->callback_shards) {
+      gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+      {
+        mutex_lock l(shard.mu);
+        std::swap(shard.callbacks, callbacks_to_run);
+        shard.drained = true;
+      }
+      for (auto& key_and_value : callbacks_to_run) {
+        CallbackConfiguration& config = key_and_value.second;
+        if (!status.ok() && config.log_error) {
+          LOG(WARNING) << "Cancellation callback \"" << config.name
+                       << "\" is triggered due to a "
+                       << (StatusGroup::IsDerived(status) ? "derived" : "root")
+                       << " error: " << status.ToString();
+        }
+        config.callback();
+      }
     }
-    config.callback();
   }
   for (CancellationManager* child : children_to_cancel) {
     child->StartCancelWithStatus(status);
   }
   {
     mutex_lock l(mu_);
-    is_cancelling_ = false;
+    // Mark cancelled before clearing is_cancelling_, so concurrent readers
+    // of the two flags can never observe both false mid-cancellation.
     is_cancelled_.store(true, std::memory_order_release);
+    is_cancelling_.store(false, std::memory_order_relaxed);
   }
   if (cancelled_notification) {
     cancelled_notification->Notify();
@@ -108,26 +122,60 @@ bool CancellationManager::RegisterCallbackWithErrorLogging(
       token, CallbackConfiguration{callback, std::string(callback_name), true});
 }
 
-bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
-                                                 CallbackConfiguration config) {
-  DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
-  mutex_lock l(mu_);
-  bool should_register = !is_cancelled_ && !is_cancelling_;
-  if (should_register) {
+CancellationManager::State* CancellationManager::GetOrCreateState() {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    mutex_lock l(mu_);
     if (!state_) {
       state_ = absl::make_unique<State>();
+      state_ptr_.store(state_.get(), std::memory_order_release);
     }
-    std::swap(state_->callbacks[token], config);
+    state = state_.get();
   }
-  return should_register;
+  return state;
+}
+
+bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
+                                                 CallbackConfiguration config) {
+  DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
+  if (is_cancelled_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  State* state = GetOrCreateState();
+  CallbackShard& shard = ShardForToken(state, token);
+  mutex_lock l(shard.mu);
+  // Re-check under the shard mutex: StartCancel marks the shard drained
+  // (under this mutex) before running its callbacks, so either this
+  // registration is visible to the drain or the drained flag is visible
+  // here. The global flags alone are insufficient: they are written under
+  // mu_, which is not held here, so their stores are not ordered with
+  // respect to this shard's mutex. They still cover the case where the
+  // state was created (under mu_) after a cancellation completed, in which
+  // case this shard was never drained.
+  if (shard.drained || is_cancelled_.load(std::memory_order_relaxed) ||
+      is_cancelling_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  std::swap(shard.callbacks[token], config);
+  return true;
 }
 
 bool CancellationManager::DeregisterCallback(CancellationToken token) {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state != nullptr && !is_cancelled_.load(std::memory_order_acquire)) {
+    CallbackShard& shard = ShardForToken(state, token);
+    mutex_lock l(shard.mu);
+    if (!shard.drained && !is_cancelled_.load(std::memory_order_relaxed) &&
+        !is_cancelling_.load(std::memory_order_relaxed)) {
+      shard.callbacks.erase(token);
+      return true;
+    }
+  }
   mu_.lock();
-  if (is_cancelled_) {
+  if (is_cancelled_.load(std::memory_order_relaxed)) {
     mu_.unlock();
     return false;
-  } else if (is_cancelling_) {
+  } else if (is_cancelling_.load(std::memory_order_relaxed)) {
     Notification* cancelled_notification =
         state_ ? &state_->cancelled_notification : nullptr;
     mu_.unlock();
@@ -140,9 +188,7 @@ bool CancellationManager::DeregisterCallback(CancellationToken token) {
     }
     return false;
   } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
+    // No state was ever created, so no callback was registered.
     mu_.unlock();
     return true;
   }
@@ -150,13 +196,15 @@ bool CancellationManager::DeregisterCallback(CancellationToken token) {
 
 bool CancellationManager::RegisterChild(CancellationManager* child) {
   mutex_lock l(mu_);
-  if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+  if (is_cancelled_.load(std::memory_order_relaxed) ||
+      is_cancelling_.load(std::memory_order_relaxed)) {
     child->is_removed_from_parent_ = true;
     return true;
   }
 
   if (!state_) {
     state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
   }
 
   // Push `child` onto the front of the list of children.
@@ -194,7 +242,7 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 
       child->is_removed_from_parent_ = true;
     }
-    if (is_cancelling_) {
+    if (is_cancelling_.load(std::memory_order_relaxed)) {
       cancelled_notification = &state_->cancelled_notification;
     }
   }
@@ -208,15 +256,21 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 }
 
 bool CancellationManager::TryDeregisterCallback(CancellationToken token) {
-  mutex_lock lock(mu_);
-  if (is_cancelled_ || is_cancelling_) {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    // No callback was ever registered.
+    mutex_lock lock(mu_);
+    return !is_cancelled_.load(std::memory_order_relaxed) &&
+           !is_cancelling_.load(std::memory_order_relaxed);
+  }
+  CallbackShard& shard = ShardForToken(state, token);
+  mutex_lock l(shard.mu);
+  if (shard.drained || is_cancelled_.load(std::memory_order_relaxed) ||
+      is_cancelling_.load(std::memory_order_relaxed)) {
     return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
-    return true;
   }
+  shard.callbacks.erase(token);
+  return true;
 }
 
 CancellationManager::~CancellationManager() {
@@ -229,8 +283,7 @@ CancellationManager::~CancellationManager() {
 }
 
 bool CancellationManager::IsCancelling() {
-  mutex_lock lock(mu_);
-  return is_cancelling_;
+  return is_cancelling_.load(std::memory_order_acquire);
 }
 
 Status RegisterCancellationCallback(CancellationManager* cancellation_manager,
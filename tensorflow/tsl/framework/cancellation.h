@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_FRAMEWORK_CANCELLATION_H_
 #define TENSORFLOW_TSL_FRAMEWORK_CANCELLATION_H_
 
+#include <array>
 #include <atomic>
 #include <functional>
 
@@ -167,9 +168,27 @@ class CancellationManager {
     bool log_error = false;
   };
 
+  // Number of independently locked callback map shards. Must be a power of
+  // two. Sharding by token keeps concurrent registration/deregistration from
+  // many ops (queues, RPC ops, data ops sharing one step-level manager) from
+  // serializing on a single mutex; `mu_` is only taken for lifecycle
+  // transitions and child tracking.
+  static constexpr int kCallbackShards = 8;
+
+  struct CallbackShard {
+    mutex mu;
+    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks
+        TF_GUARDED_BY(mu);
+    // Set once StartCancelWithStatus has drained this shard; no further
+    // callbacks may be registered with it afterwards. Checked instead of
+    // the is_cancelling_/is_cancelled_ flags, which are written under mu_
+    // and so are not ordered with respect to this shard's mutex.
+    bool drained TF_GUARDED_BY(mu) = false;
+  };
+
   struct State {
     Notification cancelled_notification;
-    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks;
+    std::array<CallbackShard, kCallbackShards> callback_shards;
 
     // If this CancellationManager has any children, this member points to the
     // head of a doubly-linked list of its children.
@@ -179,10 +198,17 @@ class CancellationManager {
   bool RegisterCallbackConfig(CancellationToken token,
                               CallbackConfiguration config);
 
+  // Returns the lazily created state, creating it under `mu_` if necessary.
+  State* GetOrCreateState();
+
+  static CallbackShard& ShardForToken(State* state, CancellationToken token) {
+    return state->callback_shards[token & (kCallbackShards - 1)];
+  }
+
   bool RegisterChild(CancellationManager* child);
   void DeregisterChild(CancellationManager* child);
 
-  bool is_cancelling_;
+  std::atomic_bool is_cancelling_;
   std::atomic_bool is_cancelled_;
   std::atomic<CancellationToken> next_cancellation_token_;
 
@@ -203,6 +229,9 @@ class CancellationManager {
 
   mutex mu_;
   std::unique_ptr<State> state_ TF_GUARDED_BY(mu_);
+  // Lock-free mirror of `state_.get()` so that callback registration and
+  // deregistration can reach their shard without taking `mu_`.
+  std::atomic<State*> state_ptr_{nullptr};
 };
 
 // Registers the given cancellation callback, returning a function that can be
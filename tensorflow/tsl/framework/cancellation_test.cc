@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/tsl/framework/cancellation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -281,4 +282,45 @@ TEST(Cancellation, Parent_RandomDestructionOrder) {
   }
 }
 
+TEST(Cancellation, ConcurrentRegisterDeregister) {
+  // Exercises the sharded callback maps: many threads register and
+  // deregister while one thread cancels. Every callback must either run
+  // exactly once or be successfully deregistered.
+  CancellationManager manager;
+  constexpr int kNumThreads = 8;
+  constexpr int kCallbacksPerThread = 200;
+  std::atomic<int> num_run(0);
+  std::atomic<int> num_deregistered(0);
+  std::atomic<int> num_refused(0);
+  Notification start;
+  {
+    thread::ThreadPool w(Env::Default(), "test", kNumThreads + 1);
+    for (int i = 0; i < kNumThreads; ++i) {
+      w.Schedule([&manager, &start, &num_run, &num_deregistered,
+                  &num_refused]() {
+        start.WaitForNotification();
+        for (int j = 0; j < kCallbacksPerThread; ++j) {
+          CancellationToken token = manager.get_cancellation_token();
+          if (!manager.RegisterCallback(token,
+                                        [&num_run]() { ++num_run; })) {
+            ++num_refused;
+            continue;
+          }
+          if (manager.TryDeregisterCallback(token)) {
+            ++num_deregistered;
+          }
+        }
+      });
+    }
+    w.Schedule([&manager, &start]() {
+      start.WaitForNotification();
+      manager.StartCancel();
+    });
+    start.Notify();
+  }
+  EXPECT_TRUE(manager.IsCancelled());
+  EXPECT_EQ(kNumThreads * kCallbacksPerThread,
+            num_run + num_deregistered + num_refused);
+}
+
 }  // namespace tsl
@@ -272,5 +272,63 @@ uint32 Extend(uint32 crc, const absl::Cord &cord) {
 }
 #endif
 
+// The combine implementation below follows the classic zlib crc32_combine()
+// construction: appending size_b zero bytes to A multiplies A's crc by a
+// fixed GF(2) matrix raised to the power 8 * size_b, computed by repeated
+// squaring, and the crc of the zero-extended A xors with crc_b to give the
+// crc of the concatenation.
+
+// Multiply the GF(2) 32x32 matrix "mat" by the vector "vec".
+static uint32 MatrixTimes(const uint32 *mat, uint32 vec) {
+  uint32 sum = 0;
+  int i = 0;
+  while (vec) {
+    if (vec & 1) sum ^= mat[i];
+    vec >>= 1;
+    i++;
+  }
+  return sum;
+}
+
+// Square the GF(2) matrix "mat", writing the result to "square".
+static void MatrixSquare(uint32 *square, const uint32 *mat) {
+  for (int i = 0; i < 32; i++) square[i] = MatrixTimes(mat, mat[i]);
+}
+
+uint32 Combine(uint32 crc_a, uint32 crc_b, size_t size_b) {
+  // Appending an empty B leaves the crc unchanged.
+  if (size_b == 0) return crc_a;
+
+  uint32 even[32];  // Operator for a 2^(2n+2)-zero-bit extension.
+  uint32 odd[32];   // Operator for a 2^(2n+1)-zero-bit extension.
+
+  // Operator for one zero bit: shift down one, feeding back the (reflected)
+  // crc32c polynomial when the low bit falls off.
+  odd[0] = 0x82f63b78u;
+  uint32 row = 1;
+  for (int i = 1; i < 32; i++) {
+    odd[i] = row;
+    row <<= 1;
+  }
+  // Operator for two zero bits in even, then four in odd.
+  MatrixSquare(even, odd);
+  MatrixSquare(odd, even);
+
+  // Extend crc_a by size_b zero bytes, one bit of size_b at a time, squaring
+  // the operator at each step.  The first squaring yields the one-zero-byte
+  // operator for the lowest bit.
+  uint64 len = size_b;
+  do {
+    MatrixSquare(even, odd);
+    if (len & 1) crc_a = MatrixTimes(even, crc_a);
+    len >>= 1;
+    if (len == 0) break;
+    MatrixSquare(odd, even);
+    if (len & 1) crc_a = MatrixTimes(odd, crc_a);
+    len >>= 1;
+  } while (len != 0);
+  return crc_a ^ crc_b;
+}
+
 }  // namespace crc32c
 }  // namespace tsl
@@ -37,6 +37,12 @@ extern uint32 Extend(uint32 init_crc, const absl::Cord& cord);
 // Return the crc32c of data[0,n-1]
 inline uint32 Value(const char* data, size_t n) { return Extend(0, data, n); }
 
+// Return the crc32c of concat(A, B) given crc_a = crc32c of A, crc_b = crc32c
+// of B and size_b = B's size in bytes.  Runs in O(log size_b) independent of
+// the data, so a large buffer can be checksummed in parallel chunks and the
+// partial crcs combined afterwards.
+extern uint32 Combine(uint32 crc_a, uint32 crc_b, size_t size_b);
+
 #if defined(TF_CORD_SUPPORT)
 inline uint32 Value(const absl::Cord& cord) { return Extend(0, cord); }
 #endif
@@ -62,6 +62,24 @@ TEST(CRC, Extend) {
   ASSERT_EQ(Value("hello world", 11), Extend(Value("hello ", 6), "world", 5));
 }
 
+TEST(CRC, Combine) {
+  ASSERT_EQ(Value("hello world", 11),
+            Combine(Value("hello ", 6), Value("world", 5), 5));
+  // Degenerate cases: an empty part on either side.
+  ASSERT_EQ(Value("foo", 3), Combine(Value("foo", 3), Value("", 0), 0));
+  ASSERT_EQ(Value("foo", 3), Combine(Value("", 0), Value("foo", 3), 3));
+  // A larger buffer split into uneven chunks.
+  string data(1 << 20, 0);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<char>(i * 31 + 7);
+  }
+  const size_t split = 12345;
+  ASSERT_EQ(Value(data.data(), data.size()),
+            Combine(Value(data.data(), split),
+                    Value(data.data() + split, data.size() - split),
+                    data.size() - split));
+}
+
 TEST(CRC, Mask) {
   uint32 crc = Value("foo", 3);
   ASSERT_NE(crc, Mask(crc));
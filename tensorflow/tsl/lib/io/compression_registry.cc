@@ -0,0 +1,50 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tsl/lib/io/compression_registry.h"
+
+#include <memory>
+#include <utility>
+
+#include "tensorflow/tsl/lib/io/compression.h"
+#include "tensorflow/tsl/platform/logging.h"
+
+namespace tsl {
+namespace io {
+
+CompressionRegistry* CompressionRegistry::Global() {
+  static CompressionRegistry* registry = new CompressionRegistry;
+  return registry;
+}
+
+void CompressionRegistry::Register(std::unique_ptr<CompressionCodec> codec) {
+  const string name = codec->Name();
+  CHECK(!name.empty()) << "Compression codecs must have a non-empty name";
+  CHECK(name != compression::kGzip && name != compression::kSnappy &&
+        name != compression::kZlib)
+      << "Cannot override the built-in compression codec " << name;
+  mutex_lock l(mu_);
+  CHECK(codecs_.emplace(name, std::move(codec)).second)
+      << "A compression codec named " << name << " is already registered";
+}
+
+CompressionCodec* CompressionRegistry::Lookup(const string& name) const {
+  mutex_lock l(mu_);
+  auto it = codecs_.find(name);
+  return it == codecs_.end() ? nullptr : it->second.get();
+}
+
+}  // namespace io
+}  // namespace tsl
@@ -0,0 +1,88 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_IO_COMPRESSION_REGISTRY_H_
+#define TENSORFLOW_TSL_LIB_IO_COMPRESSION_REGISTRY_H_
+
+#include <memory>
+#include <unordered_map>
+
+#include "tensorflow/tsl/lib/io/inputstream_interface.h"
+#include "tensorflow/tsl/platform/mutex.h"
+#include "tensorflow/tsl/platform/thread_annotations.h"
+#include "tensorflow/tsl/platform/types.h"
+
+namespace tsl {
+
+class WritableFile;
+
+namespace io {
+
+// A record-compression codec that can be plugged into RecordWriter and
+// RecordReader in addition to the built-in ZLIB/GZIP/SNAPPY support.
+//
+// Implementations wrap the destination file (resp. source stream) with a
+// compressing (resp. decompressing) layer. A codec may carry per-instance
+// state such as a compression dictionary or a handle to a hardware offload
+// device; such state must be safe to share between concurrently open
+// writers and readers.
+class CompressionCodec {
+ public:
+  virtual ~CompressionCodec() = default;
+
+  // The name matched against the `compression_type` string given to
+  // RecordWriterOptions / RecordReaderOptions, e.g. "ZSTD". Must not
+  // collide with the built-in names in compression.h.
+  virtual string Name() const = 0;
+
+  // Returns a file that compresses appended data and writes the result to
+  // `dest`. `dest` remains owned by the caller and must outlive the
+  // returned file. Closing the returned file must flush the codec but not
+  // close `dest`.
+  virtual std::unique_ptr<WritableFile> MakeCompressedOutput(
+      WritableFile* dest) = 0;
+
+  // Returns a stream yielding the decompressed contents of `input`. Takes
+  // ownership of `input`.
+  virtual std::unique_ptr<InputStreamInterface> MakeDecompressedInput(
+      std::unique_ptr<InputStreamInterface> input) = 0;
+};
+
+// A process-wide registry of compression codecs, consulted by
+// RecordWriterOptions::CreateRecordWriterOptions and
+// RecordReaderOptions::CreateRecordReaderOptions for compression type
+// strings that do not name a built-in codec.
+class CompressionRegistry {
+ public:
+  static CompressionRegistry* Global();
+
+  // Registers `codec` under codec->Name(). Fails a CHECK if the name is
+  // empty, names a built-in codec, or is already registered.
+  void Register(std::unique_ptr<CompressionCodec> codec);
+
+  // Returns the codec registered under `name`, or nullptr. The returned
+  // codec is owned by the registry and lives for the rest of the process.
+  CompressionCodec* Lookup(const string& name) const;
+
+ private:
+  mutable mutex mu_;
+  std::unordered_map<string, std::unique_ptr<CompressionCodec>> codecs_
+      TF_GUARDED_BY(mu_);
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_LIB_IO_COMPRESSION_REGISTRY_H_
@@ -17,6 +17,9 @@ limitations under the License.
 
 #include <limits.h>
 
+#include <algorithm>
+#include <utility>
+
 #include "tensorflow/tsl/lib/hash/crc32c.h"
 #include "tensorflow/tsl/lib/io/buffered_inputstream.h"
 #include "tensorflow/tsl/lib/io/compression.h"
@@ -47,8 +50,15 @@ RecordReaderOptions RecordReaderOptions::CreateRecordReaderOptions(
   } else if (compression_type == compression::kSnappy) {
     options.compression_type = io::RecordReaderOptions::SNAPPY_COMPRESSION;
   } else if (compression_type != compression::kNone) {
-    LOG(ERROR) << "Unsupported compression_type:" << compression_type
-               << ". No compression will be used.";
+    CompressionCodec* codec =
+        CompressionRegistry::Global()->Lookup(compression_type);
+    if (codec != nullptr) {
+      options.compression_type = io::RecordReaderOptions::CUSTOM_COMPRESSION;
+      options.custom_codec = codec;
+    } else {
+      LOG(ERROR) << "Unsupported compression_type:" << compression_type
+                 << ". No compression will be used.";
+    }
   }
 #endif
   return options;
@@ -77,12 +87,22 @@ RecordReader::RecordReader(RandomAccessFile* file,
     input_stream_.reset(
         new SnappyInputStream(input_stream_.release(),
                               options.snappy_options.output_buffer_size, true));
+  } else if (options.compression_type ==
+             RecordReaderOptions::CUSTOM_COMPRESSION) {
+    CHECK(options.custom_codec != nullptr)
+        << "CUSTOM_COMPRESSION requires a codec from the CompressionRegistry.";
+    input_stream_ =
+        options.custom_codec->MakeDecompressedInput(std::move(input_stream_));
   } else if (options.compression_type == RecordReaderOptions::NONE) {
     // Nothing to do.
   } else {
     LOG(FATAL) << "Unrecognized compression type :" << options.compression_type;
   }
 #endif
+  if (options.async_crc_verification) {
+    crc_verifier_.reset(
+        new thread::ThreadPool(Env::Default(), "record_crc_verify", 1));
+  }
 }
 
 namespace {
@@ -223,6 +243,141 @@ Status RecordReader::ReadRecord(uint64* offset, tstring* record) {
   return OkStatus();
 }
 
+Status RecordReader::FillReadaheadChunk(uint64 offset, size_t min_bytes) {
+  TF_RETURN_IF_ERROR(PositionInputStream(offset));
+  // Deferred checks reference the current chunk's bytes; drain them before
+  // the chunk is replaced.
+  TF_RETURN_IF_ERROR(WaitForDeferredCrcChecks());
+  readahead_chunk_offset_ = offset;
+  size_t want = options_.readahead_buffer_size > 0
+                    ? static_cast<size_t>(options_.readahead_buffer_size)
+                    : kDefaultReadaheadBytes;
+  want = std::max(want, min_bytes);
+  Status s = input_stream_->ReadNBytes(want, &readahead_chunk_);
+  // A short read near EOF still fills the chunk with whatever was available;
+  // the parser decides whether the remainder is a clean EOF or truncation.
+  if (!s.ok() && !errors::IsOutOfRange(s)) {
+    last_read_failed_ = true;
+    readahead_chunk_.clear();
+    return s;
+  }
+  return OkStatus();
+}
+
+void RecordReader::ScheduleDataCrcCheck(const char* data, uint64 length,
+                                        uint32 masked_crc, uint64 offset) {
+  {
+    mutex_lock l(crc_mu_);
+    ++pending_crc_checks_;
+  }
+  crc_verifier_->Schedule([this, data, length, masked_crc, offset]() {
+    const bool ok = crc32c::Unmask(masked_crc) == crc32c::Value(data, length);
+    mutex_lock l(crc_mu_);
+    if (!ok && deferred_crc_status_.ok()) {
+      deferred_crc_status_ = errors::DataLoss(
+          "corrupted record at ", offset, GetChecksumErrorSuffix(offset));
+    }
+    if (--pending_crc_checks_ == 0) {
+      crc_cv_.notify_all();
+    }
+  });
+}
+
+Status RecordReader::WaitForDeferredCrcChecks() {
+  if (crc_verifier_ == nullptr) return OkStatus();
+  mutex_lock l(crc_mu_);
+  while (pending_crc_checks_ > 0) {
+    crc_cv_.wait(l);
+  }
+  // Corruption is sticky, like last_read_failed_: the reader cannot resync
+  // after a bad record.
+  return deferred_crc_status_;
+}
+
+Status RecordReader::ReadRecords(uint64* offset, int max_records,
+                                 std::vector<tstring>* records) {
+  Status s = ReadRecordsInternal(offset, max_records, records);
+  // In async verification mode corruption surfaces here, at the batch
+  // boundary; the whole batch is suspect then, see
+  // RecordReaderOptions::async_crc_verification.
+  Status crc_status = WaitForDeferredCrcChecks();
+  if (!crc_status.ok()) {
+    last_read_failed_ = true;
+    return crc_status;
+  }
+  return s;
+}
+
+Status RecordReader::ReadRecordsInternal(uint64* offset, int max_records,
+                                         std::vector<tstring>* records) {
+  records->clear();
+  if (max_records <= 0) return OkStatus();
+
+  while (static_cast<int>(records->size()) < max_records) {
+    // Make sure the chunk covers the header of the next record.
+    uint64 pos = *offset - readahead_chunk_offset_;
+    if (*offset < readahead_chunk_offset_ ||
+        *offset + kHeaderSize > readahead_chunk_offset_ +
+                                    readahead_chunk_.size()) {
+      TF_RETURN_IF_ERROR(FillReadaheadChunk(*offset, kHeaderSize));
+      pos = 0;
+      if (readahead_chunk_.size() < kHeaderSize) {
+        last_read_failed_ = true;
+        if (!records->empty()) return OkStatus();
+        if (readahead_chunk_.empty()) {
+          return errors::OutOfRange("eof", GetChecksumErrorSuffix(*offset));
+        }
+        return errors::DataLoss("truncated record at ", *offset,
+                                GetChecksumErrorSuffix(*offset));
+      }
+    }
+
+    const char* header = readahead_chunk_.data() + pos;
+    const uint32 masked_length_crc =
+        core::DecodeFixed32(header + sizeof(uint64));
+    if (crc32c::Unmask(masked_length_crc) !=
+        crc32c::Value(header, sizeof(uint64))) {
+      last_read_failed_ = true;
+      if (!records->empty()) return OkStatus();
+      return errors::DataLoss("corrupted record at ", *offset,
+                              GetChecksumErrorSuffix(*offset));
+    }
+    const uint64 length = core::DecodeFixed64(header);
+    const uint64 record_bytes = kHeaderSize + length + kFooterSize;
+
+    // Make sure the chunk covers the payload and footer, re-reading from the
+    // record's start if it straddles the chunk boundary.
+    if (*offset + record_bytes >
+        readahead_chunk_offset_ + readahead_chunk_.size()) {
+      TF_RETURN_IF_ERROR(FillReadaheadChunk(*offset, record_bytes));
+      pos = 0;
+      if (readahead_chunk_.size() < record_bytes) {
+        last_read_failed_ = true;
+        if (!records->empty()) return OkStatus();
+        return errors::DataLoss("truncated record at ", *offset,
+                                GetChecksumErrorSuffix(*offset));
+      }
+    }
+
+    const char* data = readahead_chunk_.data() + pos + kHeaderSize;
+    const uint32 masked_data_crc = core::DecodeFixed32(data + length);
+    if (crc_verifier_ != nullptr) {
+      // Verify behind the consumer; the chunk stays valid until the next
+      // FillReadaheadChunk() drains the check.
+      ScheduleDataCrcCheck(data, length, masked_data_crc, *offset);
+    } else if (crc32c::Unmask(masked_data_crc) != crc32c::Value(data, length)) {
+      last_read_failed_ = true;
+      if (!records->empty()) return OkStatus();
+      return errors::DataLoss("corrupted record at ", *offset,
+                              GetChecksumErrorSuffix(*offset));
+    }
+
+    records->emplace_back(data, length);
+    *offset += record_bytes;
+  }
+  return OkStatus();
+}
+
 Status RecordReader::SkipRecords(uint64* offset, int num_to_skip,
                                  int* num_skipped) {
   TF_RETURN_IF_ERROR(PositionInputStream(*offset));
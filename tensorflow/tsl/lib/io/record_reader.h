@@ -16,16 +16,22 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_RECORD_READER_H_
 #define TENSORFLOW_TSL_LIB_IO_RECORD_READER_H_
 
+#include <vector>
+
 #include "tensorflow/tsl/lib/io/inputstream_interface.h"
 #include "tensorflow/tsl/platform/errors.h"
 #include "tensorflow/tsl/platform/stringpiece.h"
 #if !defined(IS_SLIM_BUILD)
+#include "tensorflow/tsl/lib/io/compression_registry.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_compression_options.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_inputstream.h"
 #include "tensorflow/tsl/lib/io/zlib_compression_options.h"
 #include "tensorflow/tsl/lib/io/zlib_inputstream.h"
 #endif  // IS_SLIM_BUILD
 #include "tensorflow/tsl/platform/macros.h"
+#include "tensorflow/tsl/platform/mutex.h"
+#include "tensorflow/tsl/platform/thread_annotations.h"
+#include "tensorflow/tsl/platform/threadpool.h"
 #include "tensorflow/tsl/platform/types.h"
 
 namespace tsl {
@@ -37,7 +43,8 @@ struct RecordReaderOptions {
   enum CompressionType {
     NONE = 0,
     ZLIB_COMPRESSION = 1,
-    SNAPPY_COMPRESSION = 2
+    SNAPPY_COMPRESSION = 2,
+    CUSTOM_COMPRESSION = 3,
   };
   CompressionType compression_type = NONE;
 
@@ -46,6 +53,21 @@ struct RecordReaderOptions {
   // compressed files.) Consider using SequentialRecordReader.
   int64_t buffer_size = 0;
 
+  // Number of bytes fetched from the file per read by ReadRecords(). Batch
+  // reads pull one readahead chunk of this size and parse as many records as
+  // fit out of it, instead of issuing per-record reads. Zero means use the
+  // default (1MB).
+  int64_t readahead_buffer_size = 0;
+
+  // If true, ReadRecords() verifies record data checksums on a sidecar
+  // thread while the calling thread parses and copies the following records,
+  // and corruption is surfaced when the batch completes rather than at the
+  // exact record. A batch that returns DATA_LOSS in this mode must be
+  // discarded as a whole, since records after the corrupt one may already
+  // have been returned. ReadRecord() and SkipRecords() always verify
+  // synchronously.
+  bool async_crc_verification = false;
+
   static RecordReaderOptions CreateRecordReaderOptions(
       const string& compression_type);
 
@@ -53,6 +75,10 @@ struct RecordReaderOptions {
   // Options specific to compression.
   ZlibCompressionOptions zlib_options;
   SnappyCompressionOptions snappy_options;
+
+  // Set iff compression_type == CUSTOM_COMPRESSION; owned by the
+  // CompressionRegistry.
+  CompressionCodec* custom_codec = nullptr;
 #endif  // IS_SLIM_BUILD
 };
 
@@ -96,6 +122,20 @@ class RecordReader {
   // OUT_OF_RANGE for end of file, or something else for an error.
   Status ReadRecord(uint64* offset, tstring* record);
 
+  // Read up to "max_records" records starting at "*offset" into *records
+  // (which is cleared first) and update *offset to point past the last record
+  // read. The records are fetched through a readahead chunk of
+  // options.readahead_buffer_size bytes and parsed in memory, so batch
+  // ingestion issues one large file read per chunk instead of several small
+  // reads per record.
+  //
+  // Returns OK if at least one record was read; end-of-file is only reported
+  // (as OUT_OF_RANGE) by the call that reads zero records. Other errors
+  // (e.g. DATA_LOSS for a corrupt or truncated record) are returned along
+  // with any records successfully read before the error.
+  Status ReadRecords(uint64* offset, int max_records,
+                     std::vector<tstring>* records);
+
   // Skip num_to_skip record starting at "*offset" and update *offset
   // to point to the offset of the next num_to_skip + 1 record.
   // Return OK on success, OUT_OF_RANGE for end of file, or something
@@ -115,15 +155,52 @@ class RecordReader {
   Status GetMetadata(Metadata* md);
 
  private:
+  static constexpr size_t kDefaultReadaheadBytes = 1 << 20;  // 1MB
+
   Status ReadChecksummed(uint64 offset, size_t n, tstring* result);
   Status PositionInputStream(uint64 offset);
 
+  // Refills the readahead chunk so that it starts at file offset "offset"
+  // and holds at least min(min_bytes, bytes-to-EOF) bytes. Drains any
+  // deferred checksum checks first, since they reference the chunk's bytes.
+  Status FillReadaheadChunk(uint64 offset, size_t min_bytes);
+
+  // The parsing loop of ReadRecords(); the public method drains the deferred
+  // checksum checks around it.
+  Status ReadRecordsInternal(uint64* offset, int max_records,
+                             std::vector<tstring>* records);
+
+  // Verifies on the sidecar thread that crc32c(data[0, length)) matches
+  // "masked_crc". "data" must stay valid until the check is drained.
+  void ScheduleDataCrcCheck(const char* data, uint64 length, uint32 masked_crc,
+                            uint64 offset);
+
+  // Blocks until all scheduled checksum checks completed, and returns the
+  // (sticky) status of the first failed one.
+  Status WaitForDeferredCrcChecks();
+
   RecordReaderOptions options_;
   std::unique_ptr<InputStreamInterface> input_stream_;
   bool last_read_failed_;
 
+  // Readahead chunk used by ReadRecords(); covers file offsets
+  // [readahead_chunk_offset_, readahead_chunk_offset_ + size).
+  tstring readahead_chunk_;
+  uint64 readahead_chunk_offset_ = 0;
+
   std::unique_ptr<Metadata> cached_metadata_;
 
+  // Deferred checksum verification state, used when
+  // options.async_crc_verification is set.
+  mutex crc_mu_;
+  condition_variable crc_cv_;
+  int pending_crc_checks_ TF_GUARDED_BY(crc_mu_) = 0;
+  Status deferred_crc_status_ TF_GUARDED_BY(crc_mu_);
+  // The sidecar verification thread. Declared last: its destructor joins
+  // pending checks, which reference the members above and the readahead
+  // chunk.
+  std::unique_ptr<thread::ThreadPool> crc_verifier_;
+
   TF_DISALLOW_COPY_AND_ASSIGN(RecordReader);
 };
 
@@ -146,6 +223,12 @@ class SequentialRecordReader {
     return underlying_.ReadRecord(&offset_, record);
   }
 
+  // Read up to "max_records" next records in the file into *records. See
+  // RecordReader::ReadRecords() for the batching and error semantics.
+  Status ReadRecords(int max_records, std::vector<tstring>* records) {
+    return underlying_.ReadRecords(&offset_, max_records, records);
+  }
+
   // Skip the next num_to_skip record in the file. Return OK on success,
   // OUT_OF_RANGE for end of file, or something else for an error.
   // "*num_skipped" records the number of records that are actually skipped.
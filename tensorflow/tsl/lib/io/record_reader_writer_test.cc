@@ -102,6 +102,74 @@ void VerifyFlush(const io::RecordWriterOptions& options) {
   }
 }
 
+// A trivial "compression" codec that inverts every byte, used to exercise
+// the CompressionRegistry plumbing. The transformation is its own inverse,
+// and guarantees that bytes on disk differ from what was written.
+string FlipBytes(StringPiece data) {
+  string flipped(data.size(), '\0');
+  for (size_t i = 0; i < data.size(); i++) {
+    flipped[i] = ~data[i];
+  }
+  return flipped;
+}
+
+class BitFlipOutput : public WritableFile {
+ public:
+  explicit BitFlipOutput(WritableFile* dest) : dest_(dest) {}
+
+  Status Append(StringPiece data) override {
+    return dest_->Append(FlipBytes(data));
+  }
+  // Close() must not close the destination file.
+  Status Close() override { return dest_->Flush(); }
+  Status Flush() override { return dest_->Flush(); }
+  Status Sync() override { return dest_->Sync(); }
+
+ private:
+  WritableFile* dest_;
+};
+
+class BitFlipInputStream : public io::InputStreamInterface {
+ public:
+  explicit BitFlipInputStream(std::unique_ptr<io::InputStreamInterface> input)
+      : input_(std::move(input)) {}
+
+  Status ReadNBytes(int64_t bytes_to_read, tstring* result) override {
+    TF_RETURN_IF_ERROR(input_->ReadNBytes(bytes_to_read, result));
+    *result = FlipBytes(*result);
+    return OkStatus();
+  }
+  int64_t Tell() const override { return input_->Tell(); }
+  Status Reset() override { return input_->Reset(); }
+
+ private:
+  std::unique_ptr<io::InputStreamInterface> input_;
+};
+
+class BitFlipCodec : public io::CompressionCodec {
+ public:
+  string Name() const override { return "BITFLIP"; }
+
+  std::unique_ptr<WritableFile> MakeCompressedOutput(
+      WritableFile* dest) override {
+    return std::make_unique<BitFlipOutput>(dest);
+  }
+
+  std::unique_ptr<io::InputStreamInterface> MakeDecompressedInput(
+      std::unique_ptr<io::InputStreamInterface> input) override {
+    return std::make_unique<BitFlipInputStream>(std::move(input));
+  }
+};
+
+void RegisterBitFlipCodec() {
+  static const bool unused = [] {
+    io::CompressionRegistry::Global()->Register(
+        std::make_unique<BitFlipCodec>());
+    return true;
+  }();
+  (void)unused;
+}
+
 }  // namespace
 
 TEST(RecordReaderWriterTest, TestFlush) {
@@ -162,6 +230,130 @@ TEST(RecordReaderWriterTest, TestBasics) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestReadRecordsBatch) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_batch_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriter writer(file.get(), io::RecordWriterOptions());
+    for (int i = 0; i < 10; i++) {
+      TF_EXPECT_OK(writer.WriteRecord(strings::StrCat("record-", i)));
+    }
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReaderOptions options;
+    // Force several readahead chunk refills by keeping the chunk smaller
+    // than a single record.
+    options.readahead_buffer_size = 8;
+    io::RecordReader reader(read_file.get(), options);
+    uint64 offset = 0;
+    std::vector<tstring> records;
+    TF_CHECK_OK(reader.ReadRecords(&offset, 4, &records));
+    ASSERT_EQ(4, records.size());
+    for (int i = 0; i < 4; i++) {
+      EXPECT_EQ(strings::StrCat("record-", i), records[i]);
+    }
+    // Ask for more records than remain in the file: we should get the tail
+    // of the file with an OK status, then OUT_OF_RANGE on the next call.
+    TF_CHECK_OK(reader.ReadRecords(&offset, 100, &records));
+    ASSERT_EQ(6, records.size());
+    for (int i = 0; i < 6; i++) {
+      EXPECT_EQ(strings::StrCat("record-", i + 4), records[i]);
+    }
+    Status s = reader.ReadRecords(&offset, 100, &records);
+    EXPECT_EQ(error::OUT_OF_RANGE, s.code());
+    EXPECT_TRUE(records.empty());
+  }
+}
+
+TEST(RecordReaderWriterTest, TestReadRecordsAsyncCrcVerification) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_async_crc_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriter writer(file.get(), io::RecordWriterOptions());
+    for (int i = 0; i < 10; i++) {
+      TF_EXPECT_OK(writer.WriteRecord(strings::StrCat("record-", i)));
+    }
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReaderOptions options;
+    options.async_crc_verification = true;
+    // Keep the chunk small so the deferred checks are also drained at chunk
+    // refills, not only at batch boundaries.
+    options.readahead_buffer_size = 8;
+    io::RecordReader reader(read_file.get(), options);
+    uint64 offset = 0;
+    std::vector<tstring> records;
+    TF_CHECK_OK(reader.ReadRecords(&offset, 10, &records));
+    ASSERT_EQ(10, records.size());
+    for (int i = 0; i < 10; i++) {
+      EXPECT_EQ(strings::StrCat("record-", i), records[i]);
+    }
+  }
+}
+
+TEST(RecordReaderWriterTest, TestAsyncCrcVerificationDetectsCorruption) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_async_corrupt_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriter writer(file.get(), io::RecordWriterOptions());
+    for (int i = 0; i < 4; i++) {
+      TF_EXPECT_OK(writer.WriteRecord(strings::StrCat("record-", i)));
+    }
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  {
+    // Flip a byte in the payload of the third record.
+    string contents;
+    TF_CHECK_OK(ReadFileToString(env, fname, &contents));
+    const size_t record_bytes = io::RecordReader::kHeaderSize + 8 /* payload */ +
+                                io::RecordReader::kFooterSize;
+    contents[2 * record_bytes + io::RecordReader::kHeaderSize] ^= 0x1;
+    TF_CHECK_OK(WriteStringToFile(env, fname, contents));
+  }
+
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReaderOptions options;
+    options.async_crc_verification = true;
+    io::RecordReader reader(read_file.get(), options);
+    uint64 offset = 0;
+    std::vector<tstring> records;
+    // The corruption surfaces at the batch boundary; the batch must be
+    // discarded as a whole.
+    Status s = reader.ReadRecords(&offset, 4, &records);
+    EXPECT_EQ(error::DATA_LOSS, s.code());
+    const size_t record_bytes = io::RecordReader::kHeaderSize + 8 /* payload */ +
+                                io::RecordReader::kFooterSize;
+    EXPECT_EQ(strings::StrCat("corrupted record at ", 2 * record_bytes),
+              s.error_message());
+    // Corruption is sticky.
+    s = reader.ReadRecords(&offset, 4, &records);
+    EXPECT_EQ(error::DATA_LOSS, s.code());
+  }
+}
+
 TEST(RecordReaderWriterTest, TestSkipBasic) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_skip_basic_test";
@@ -305,6 +497,61 @@ TEST(RecordReaderWriterTest, TestSnappy) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestCustomCodec) {
+  RegisterBitFlipCodec();
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_custom_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriterOptions options =
+        io::RecordWriterOptions::CreateRecordWriterOptions("BITFLIP");
+    EXPECT_EQ(io::RecordWriterOptions::CUSTOM_COMPRESSION,
+              options.compression_type);
+    io::RecordWriter writer(file.get(), options);
+    TF_EXPECT_OK(writer.WriteRecord("abc"));
+    TF_EXPECT_OK(writer.WriteRecord("defg"));
+    TF_CHECK_OK(writer.Close());
+  }
+
+  // The file must not be readable without the codec.
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReader reader(read_file.get(), io::RecordReaderOptions());
+    uint64 offset = 0;
+    tstring record;
+    EXPECT_FALSE(reader.ReadRecord(&offset, &record).ok());
+  }
+
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReaderOptions options =
+        io::RecordReaderOptions::CreateRecordReaderOptions("BITFLIP");
+    EXPECT_EQ(io::RecordReaderOptions::CUSTOM_COMPRESSION,
+              options.compression_type);
+    io::RecordReader reader(read_file.get(), options);
+    uint64 offset = 0;
+    tstring record;
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("abc", record);
+    TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+    EXPECT_EQ("defg", record);
+  }
+}
+
+TEST(RecordReaderWriterTest, TestUnknownCompressionType) {
+  io::RecordWriterOptions write_options =
+      io::RecordWriterOptions::CreateRecordWriterOptions("NOT-A-CODEC");
+  EXPECT_EQ(io::RecordWriterOptions::NONE, write_options.compression_type);
+  io::RecordReaderOptions read_options =
+      io::RecordReaderOptions::CreateRecordReaderOptions("NOT-A-CODEC");
+  EXPECT_EQ(io::RecordReaderOptions::NONE, read_options.compression_type);
+}
+
 TEST(RecordReaderWriterTest, TestZlib) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_zlib_test";
@@ -30,6 +30,10 @@ bool IsZlibCompressed(const RecordWriterOptions& options) {
 bool IsSnappyCompressed(const RecordWriterOptions& options) {
   return options.compression_type == RecordWriterOptions::SNAPPY_COMPRESSION;
 }
+
+bool IsCustomCompressed(const RecordWriterOptions& options) {
+  return options.compression_type == RecordWriterOptions::CUSTOM_COMPRESSION;
+}
 }  // namespace
 
 RecordWriterOptions RecordWriterOptions::CreateRecordWriterOptions(
@@ -50,8 +54,15 @@ RecordWriterOptions RecordWriterOptions::CreateRecordWriterOptions(
   } else if (compression_type == compression::kSnappy) {
     options.compression_type = io::RecordWriterOptions::SNAPPY_COMPRESSION;
   } else if (compression_type != compression::kNone) {
-    LOG(ERROR) << "Unsupported compression_type:" << compression_type
-               << ". No compression will be used.";
+    CompressionCodec* codec =
+        CompressionRegistry::Global()->Lookup(compression_type);
+    if (codec != nullptr) {
+      options.compression_type = io::RecordWriterOptions::CUSTOM_COMPRESSION;
+      options.custom_codec = codec;
+    } else {
+      LOG(ERROR) << "Unsupported compression_type:" << compression_type
+                 << ". No compression will be used.";
+    }
   }
 #endif
   return options;
@@ -79,6 +90,10 @@ RecordWriter::RecordWriter(WritableFile* dest,
     dest_ =
         new SnappyOutputBuffer(dest, options.snappy_options.input_buffer_size,
                                options.snappy_options.output_buffer_size);
+  } else if (IsCustomCompressed(options)) {
+    CHECK(options.custom_codec != nullptr)
+        << "CUSTOM_COMPRESSION requires a codec from the CompressionRegistry.";
+    dest_ = options.custom_codec->MakeCompressedOutput(dest).release();
   } else if (options.compression_type == RecordWriterOptions::NONE) {
     // Nothing to do
   } else {
@@ -138,7 +153,8 @@ Status RecordWriter::WriteRecord(const absl::Cord& data) {
 
 Status RecordWriter::Close() {
   if (dest_ == nullptr) return OkStatus();
-  if (IsZlibCompressed(options_) || IsSnappyCompressed(options_)) {
+  if (IsZlibCompressed(options_) || IsSnappyCompressed(options_) ||
+      IsCustomCompressed(options_)) {
     Status s = dest_->Close();
     delete dest_;
     dest_ = nullptr;
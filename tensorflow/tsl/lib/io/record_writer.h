@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/tsl/platform/status.h"
 #include "tensorflow/tsl/platform/stringpiece.h"
 #if !defined(IS_SLIM_BUILD)
+#include "tensorflow/tsl/lib/io/compression_registry.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_compression_options.h"
 #include "tensorflow/tsl/lib/io/snappy/snappy_outputbuffer.h"
 #include "tensorflow/tsl/lib/io/zlib_compression_options.h"
@@ -41,7 +42,8 @@ struct RecordWriterOptions {
   enum CompressionType {
     NONE = 0,
     ZLIB_COMPRESSION = 1,
-    SNAPPY_COMPRESSION = 2
+    SNAPPY_COMPRESSION = 2,
+    CUSTOM_COMPRESSION = 3,
   };
   CompressionType compression_type = NONE;
 
@@ -52,6 +54,10 @@ struct RecordWriterOptions {
   // Options specific to compression.
   io::ZlibCompressionOptions zlib_options;
   io::SnappyCompressionOptions snappy_options;
+
+  // Set iff compression_type == CUSTOM_COMPRESSION; owned by the
+  // CompressionRegistry.
+  CompressionCodec* custom_codec = nullptr;
 #endif  // IS_SLIM_BUILD
 };
 
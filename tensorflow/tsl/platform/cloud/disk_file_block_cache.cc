@@ -0,0 +1,217 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tsl/platform/cloud/disk_file_block_cache.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/tsl/platform/fingerprint.h"
+#include "tensorflow/tsl/platform/path.h"
+#include "tensorflow/tsl/platform/str_util.h"
+#include "tensorflow/tsl/platform/stringprintf.h"
+
+namespace tsl {
+
+namespace {
+// The suffix of the spilled block files, so that leftover blocks from a
+// previous process can be recognized and deleted.
+constexpr char kBlockFileSuffix[] = ".tf_block";
+}  // namespace
+
+DiskFileBlockCache::DiskFileBlockCache(size_t block_size, size_t max_ram_bytes,
+                                       uint64 max_staleness,
+                                       const string& cache_path,
+                                       size_t max_disk_bytes,
+                                       BlockFetcher block_fetcher, Env* env)
+    : cache_path_(cache_path),
+      max_disk_bytes_(max_disk_bytes),
+      block_fetcher_(std::move(block_fetcher)),
+      env_(env) {
+  if (max_disk_bytes_ > 0) {
+    Status status = env_->RecursivelyCreateDir(cache_path_);
+    if (!status.ok()) {
+      LOG(WARNING) << "Could not create block cache directory " << cache_path_
+                   << ": " << status << "; the disk cache tier is disabled";
+      max_disk_bytes_ = 0;
+    }
+  }
+  if (max_disk_bytes_ > 0) {
+    // Delete block files left behind by a previous process: their file
+    // signatures are gone, so their contents cannot be trusted.
+    std::vector<string> children;
+    if (env_->GetChildren(cache_path_, &children).ok()) {
+      for (const string& child : children) {
+        if (str_util::EndsWith(child, kBlockFileSuffix)) {
+          env_->DeleteFile(io::JoinPath(cache_path_, child)).IgnoreError();
+        }
+      }
+    }
+  }
+  ram_cache_.reset(new RamFileBlockCache(
+      block_size, max_ram_bytes, max_staleness,
+      [this](const string& filename, size_t offset, size_t buffer_size,
+             char* buffer, size_t* bytes_transferred) {
+        return Fetch(filename, offset, buffer_size, buffer, bytes_transferred);
+      },
+      env_));
+  VLOG(1) << "Disk cache tier at " << cache_path_ << " is "
+          << (max_disk_bytes_ > 0 ? "enabled" : "disabled");
+}
+
+Status DiskFileBlockCache::Read(const string& filename, size_t offset,
+                                size_t n, char* buffer,
+                                size_t* bytes_transferred) {
+  return ram_cache_->Read(filename, offset, n, buffer, bytes_transferred);
+}
+
+bool DiskFileBlockCache::ValidateAndUpdateFileSignature(
+    const string& filename, int64_t file_signature) {
+  bool unchanged =
+      ram_cache_->ValidateAndUpdateFileSignature(filename, file_signature);
+  if (!unchanged) {
+    // The remote file changed; the spilled blocks are stale too.
+    RemoveDiskFile(Fingerprint64(filename));
+  }
+  return unchanged;
+}
+
+void DiskFileBlockCache::RemoveFile(const string& filename) {
+  ram_cache_->RemoveFile(filename);
+  RemoveDiskFile(Fingerprint64(filename));
+}
+
+void DiskFileBlockCache::Flush() {
+  ram_cache_->Flush();
+  mutex_lock lock(disk_mu_);
+  for (auto it = disk_index_.begin(); it != disk_index_.end();) {
+    auto next = std::next(it);
+    RemoveDiskBlock_Locked(it);
+    it = next;
+  }
+}
+
+size_t DiskFileBlockCache::DiskCacheSize() const {
+  mutex_lock lock(disk_mu_);
+  return disk_size_;
+}
+
+Status DiskFileBlockCache::Fetch(const string& filename, size_t offset,
+                                 size_t buffer_size, char* buffer,
+                                 size_t* bytes_transferred) {
+  // Only block-aligned reads of a full block go through the disk tier; when
+  // the RAM tier is disabled or bypassed it forwards arbitrary ranges, which
+  // would not key consistently.
+  const bool spillable = max_disk_bytes_ > 0 && buffer_size == block_size() &&
+                         offset % block_size() == 0;
+  const DiskKey key = std::make_pair(Fingerprint64(filename), offset);
+  if (spillable &&
+      ReadDiskBlock(key, buffer_size, buffer, bytes_transferred)) {
+    return OkStatus();
+  }
+  TF_RETURN_IF_ERROR(
+      block_fetcher_(filename, offset, buffer_size, buffer, bytes_transferred));
+  if (spillable && *bytes_transferred > 0) {
+    WriteDiskBlock(key, StringPiece(buffer, *bytes_transferred));
+  }
+  return OkStatus();
+}
+
+string DiskFileBlockCache::BlockFilename(const DiskKey& key) const {
+  return io::JoinPath(
+      cache_path_, strings::Printf("%016llx-%016llx%s",
+                                   static_cast<unsigned long long>(key.first),
+                                   static_cast<unsigned long long>(key.second),
+                                   kBlockFileSuffix));
+}
+
+bool DiskFileBlockCache::ReadDiskBlock(const DiskKey& key, size_t buffer_size,
+                                       char* buffer,
+                                       size_t* bytes_transferred) {
+  {
+    mutex_lock lock(disk_mu_);
+    auto it = disk_index_.find(key);
+    if (it == disk_index_.end()) {
+      return false;
+    }
+    if (it->second.lru_iterator != disk_lru_.begin()) {
+      disk_lru_.erase(it->second.lru_iterator);
+      disk_lru_.push_front(key);
+      it->second.lru_iterator = disk_lru_.begin();
+    }
+  }
+  // The block file is read without holding disk_mu_; a concurrent eviction
+  // may delete it, in which case the read fails and we fall back to the
+  // remote filesystem.
+  string data;
+  Status status = ReadFileToString(env_, BlockFilename(key), &data);
+  if (!status.ok() || data.size() > buffer_size) {
+    mutex_lock lock(disk_mu_);
+    auto it = disk_index_.find(key);
+    if (it != disk_index_.end()) {
+      RemoveDiskBlock_Locked(it);
+    }
+    return false;
+  }
+  memcpy(buffer, data.data(), data.size());
+  *bytes_transferred = data.size();
+  return true;
+}
+
+void DiskFileBlockCache::WriteDiskBlock(const DiskKey& key, StringPiece data) {
+  Status status = WriteStringToFile(env_, BlockFilename(key), data);
+  if (!status.ok()) {
+    // The disk tier is an optimization; the fetched block is still served
+    // from RAM.
+    LOG(WARNING) << "Could not spill cache block to " << BlockFilename(key)
+                 << ": " << status;
+    return;
+  }
+  mutex_lock lock(disk_mu_);
+  auto it = disk_index_.find(key);
+  if (it != disk_index_.end()) {
+    disk_size_ -= it->second.size;
+    disk_size_ += data.size();
+    it->second.size = data.size();
+  } else {
+    disk_lru_.push_front(key);
+    disk_index_[key] = {data.size(), disk_lru_.begin()};
+    disk_size_ += data.size();
+  }
+  // Evict least recently used blocks until we are back under the bound.
+  while (disk_size_ > max_disk_bytes_ && !disk_lru_.empty()) {
+    RemoveDiskBlock_Locked(disk_index_.find(disk_lru_.back()));
+  }
+}
+
+void DiskFileBlockCache::RemoveDiskFile(uint64 fingerprint) {
+  mutex_lock lock(disk_mu_);
+  auto it = disk_index_.lower_bound(std::make_pair(fingerprint, 0));
+  while (it != disk_index_.end() && it->first.first == fingerprint) {
+    auto next = std::next(it);
+    RemoveDiskBlock_Locked(it);
+    it = next;
+  }
+}
+
+void DiskFileBlockCache::RemoveDiskBlock_Locked(DiskBlockMap::iterator entry) {
+  env_->DeleteFile(BlockFilename(entry->first)).IgnoreError();
+  disk_size_ -= entry->second.size;
+  disk_lru_.erase(entry->second.lru_iterator);
+  disk_index_.erase(entry);
+}
+
+}  // namespace tsl
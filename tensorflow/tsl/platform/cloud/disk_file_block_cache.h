@@ -0,0 +1,164 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_PLATFORM_CLOUD_DISK_FILE_BLOCK_CACHE_H_
+#define TENSORFLOW_TSL_PLATFORM_CLOUD_DISK_FILE_BLOCK_CACHE_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tensorflow/tsl/platform/cloud/file_block_cache.h"
+#include "tensorflow/tsl/platform/cloud/ram_file_block_cache.h"
+#include "tensorflow/tsl/platform/env.h"
+#include "tensorflow/tsl/platform/mutex.h"
+#include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/tsl/platform/stringpiece.h"
+#include "tensorflow/tsl/platform/thread_annotations.h"
+#include "tensorflow/tsl/platform/types.h"
+
+namespace tsl {
+
+/// \brief A two-tier block cache: an in-RAM LRU tier in front of a bounded
+/// directory of block files on local disk (e.g. local SSD).
+///
+/// Blocks fetched from the remote filesystem are written through to the disk
+/// tier, so a block evicted from the RAM tier can be reloaded from local disk
+/// instead of being refetched from the remote filesystem. This helps
+/// workloads that repeatedly stream over datasets larger than the RAM tier
+/// (e.g. multi-epoch training), at the cost of local disk space.
+///
+/// The disk tier is private to this process: the cache directory is emptied
+/// on construction, because the file signatures (e.g. GCS generation numbers)
+/// used to detect remote changes are only tracked in memory.
+class DiskFileBlockCache : public FileBlockCache {
+ public:
+  /// `cache_path` is the directory holding the spilled blocks; it is created
+  /// if necessary, and any block files left behind by a previous process are
+  /// deleted. `max_disk_bytes` bounds the total size of the block files;
+  /// least recently used blocks are deleted to stay under the bound. If the
+  /// cache directory cannot be created the disk tier is disabled, and the
+  /// cache degrades to the wrapped RamFileBlockCache.
+  DiskFileBlockCache(size_t block_size, size_t max_ram_bytes,
+                     uint64 max_staleness, const string& cache_path,
+                     size_t max_disk_bytes, BlockFetcher block_fetcher,
+                     Env* env = Env::Default());
+
+  /// Read `n` bytes from `filename` starting at `offset` into `buffer`, with
+  /// the same semantics as RamFileBlockCache::Read.
+  Status Read(const string& filename, size_t offset, size_t n, char* buffer,
+              size_t* bytes_transferred) override;
+
+  // Validate the given file signature with the existing file signature in the
+  // cache. If the signature changes, blocks of the file are removed from both
+  // tiers.
+  bool ValidateAndUpdateFileSignature(const string& filename,
+                                      int64_t file_signature) override
+      TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Remove all cached blocks for `filename`, in both tiers.
+  void RemoveFile(const string& filename) override TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Remove all cached data, in both tiers.
+  void Flush() override TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Accessors for cache parameters.
+  size_t block_size() const override { return ram_cache_->block_size(); }
+  size_t max_bytes() const override { return ram_cache_->max_bytes(); }
+  uint64 max_staleness() const override { return ram_cache_->max_staleness(); }
+
+  /// The current size (in bytes) of the RAM tier.
+  size_t CacheSize() const override { return ram_cache_->CacheSize(); }
+
+  bool IsCacheEnabled() const override { return ram_cache_->IsCacheEnabled(); }
+
+  /// The current total size (in bytes) of the block files in the disk tier.
+  size_t DiskCacheSize() const TF_LOCKS_EXCLUDED(disk_mu_);
+
+ private:
+  /// \brief The key type for the disk tier.
+  ///
+  /// A {filename fingerprint, offset} pair naming a spilled block. The
+  /// fingerprint keeps block filenames short and free of path separators.
+  typedef std::pair<uint64, size_t> DiskKey;
+
+  /// \brief A spilled block: its size and its position in the disk LRU list.
+  struct DiskBlock {
+    size_t size;
+    std::list<DiskKey>::iterator lru_iterator;
+  };
+
+  typedef std::map<DiskKey, DiskBlock> DiskBlockMap;
+
+  /// The fetcher installed in the RAM tier: serves block-aligned reads from
+  /// the disk tier when possible, and otherwise forwards to `block_fetcher_`,
+  /// writing the fetched block through to the disk tier.
+  Status Fetch(const string& filename, size_t offset, size_t buffer_size,
+               char* buffer, size_t* bytes_transferred)
+      TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// The path of the block file for `key`.
+  string BlockFilename(const DiskKey& key) const;
+
+  /// Reads the spilled block `key` into `buffer` and sets
+  /// `*bytes_transferred`. Returns false (after dropping the index entry) if
+  /// the block is absent, unreadable, or larger than `buffer_size`.
+  bool ReadDiskBlock(const DiskKey& key, size_t buffer_size, char* buffer,
+                     size_t* bytes_transferred) TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Writes `data` to the block file for `key` and updates the index,
+  /// evicting least recently used blocks to stay under `max_disk_bytes_`.
+  /// Write failures only log a warning: the disk tier is an optimization.
+  void WriteDiskBlock(const DiskKey& key, StringPiece data)
+      TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Removes all spilled blocks of the file with fingerprint `fingerprint`.
+  void RemoveDiskFile(uint64 fingerprint) TF_LOCKS_EXCLUDED(disk_mu_);
+
+  /// Deletes the block file for `entry` and erases it from the index.
+  void RemoveDiskBlock_Locked(DiskBlockMap::iterator entry)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(disk_mu_);
+
+  /// The directory holding the spilled block files.
+  const string cache_path_;
+  /// The maximum number of bytes allowed in the disk tier; 0 if the cache
+  /// directory turned out to be unusable.
+  size_t max_disk_bytes_;
+  /// The callback to read a block from the remote filesystem.
+  const BlockFetcher block_fetcher_;
+  /// The Env used for block file I/O.
+  Env* const env_;  // not owned
+
+  /// Guards the disk tier index. Never held while calling into `ram_cache_`
+  /// or `block_fetcher_`, and not held during block file I/O.
+  mutable mutex disk_mu_;
+  /// The index of spilled blocks, ordered so that all blocks of one file
+  /// fingerprint are contiguous.
+  DiskBlockMap disk_index_ TF_GUARDED_BY(disk_mu_);
+  /// The disk LRU list: most recently used blocks at the front.
+  std::list<DiskKey> disk_lru_ TF_GUARDED_BY(disk_mu_);
+  /// The combined size of the spilled block files.
+  size_t disk_size_ TF_GUARDED_BY(disk_mu_) = 0;
+
+  /// The RAM tier. Declared last so that its worker threads stop before the
+  /// disk tier state is destroyed.
+  std::unique_ptr<RamFileBlockCache> ram_cache_;
+};
+
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_PLATFORM_CLOUD_DISK_FILE_BLOCK_CACHE_H_
@@ -0,0 +1,168 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/tsl/platform/cloud/disk_file_block_cache.h"
+
+#include <cstring>
+
+#include "tensorflow/tsl/lib/core/status_test_util.h"
+#include "tensorflow/tsl/platform/env.h"
+#include "tensorflow/tsl/platform/path.h"
+#include "tensorflow/tsl/platform/test.h"
+
+namespace tsl {
+namespace {
+
+Status ReadCache(DiskFileBlockCache* cache, const string& filename,
+                 size_t offset, size_t n, std::vector<char>* out) {
+  out->clear();
+  out->resize(n, 0);
+  size_t bytes_transferred = 0;
+  Status status =
+      cache->Read(filename, offset, n, out->data(), &bytes_transferred);
+  EXPECT_LE(bytes_transferred, n);
+  out->resize(bytes_transferred, n);
+  return status;
+}
+
+string CachePath(const string& name) {
+  return io::JoinPath(testing::TmpDir(), name);
+}
+
+TEST(DiskFileBlockCacheTest, ServesEvictedBlocksFromDisk) {
+  int calls = 0;
+  auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred) {
+    calls++;
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  // The RAM tier holds two 8-byte blocks; the disk tier is effectively
+  // unbounded.
+  DiskFileBlockCache cache(8, 16, 0, CachePath("served_from_disk"), 1 << 20,
+                           fetcher);
+  std::vector<char> out;
+
+  // Read four distinct blocks, evicting the first two from RAM.
+  for (size_t offset = 0; offset < 32; offset += 8) {
+    TF_EXPECT_OK(ReadCache(&cache, "file", offset, 8, &out));
+  }
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(cache.DiskCacheSize(), 32);
+
+  // Rereading the evicted blocks hits the disk tier, not the fetcher.
+  TF_EXPECT_OK(ReadCache(&cache, "file", 0, 8, &out));
+  TF_EXPECT_OK(ReadCache(&cache, "file", 8, 8, &out));
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(out, std::vector<char>(8, 'x'));
+}
+
+TEST(DiskFileBlockCacheTest, BoundsDiskTier) {
+  int calls = 0;
+  auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred) {
+    calls++;
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  // The disk tier holds at most two 8-byte blocks.
+  DiskFileBlockCache cache(8, 8, 0, CachePath("bounded"), 16, fetcher);
+  std::vector<char> out;
+
+  for (size_t offset = 0; offset < 32; offset += 8) {
+    TF_EXPECT_OK(ReadCache(&cache, "file", offset, 8, &out));
+  }
+  EXPECT_EQ(calls, 4);
+  EXPECT_LE(cache.DiskCacheSize(), 16);
+
+  // The least recently used block was evicted from both tiers and must be
+  // fetched again.
+  TF_EXPECT_OK(ReadCache(&cache, "file", 0, 8, &out));
+  EXPECT_EQ(calls, 5);
+}
+
+TEST(DiskFileBlockCacheTest, SignatureChangeDropsDiskBlocks) {
+  int calls = 0;
+  auto fetcher = [&calls](const string& filename, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred) {
+    calls++;
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  DiskFileBlockCache cache(8, 8, 0, CachePath("signature"), 1 << 20, fetcher);
+  std::vector<char> out;
+
+  EXPECT_TRUE(cache.ValidateAndUpdateFileSignature("file", 123));
+  TF_EXPECT_OK(ReadCache(&cache, "file", 0, 8, &out));
+  TF_EXPECT_OK(ReadCache(&cache, "file", 8, 8, &out));
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(cache.DiskCacheSize(), 16);
+
+  // A changed signature invalidates both tiers.
+  EXPECT_FALSE(cache.ValidateAndUpdateFileSignature("file", 321));
+  EXPECT_EQ(cache.DiskCacheSize(), 0);
+  TF_EXPECT_OK(ReadCache(&cache, "file", 0, 8, &out));
+  EXPECT_EQ(calls, 3);
+}
+
+TEST(DiskFileBlockCacheTest, RemoveFileAndFlush) {
+  auto fetcher = [](const string& filename, size_t offset, size_t n,
+                    char* buffer, size_t* bytes_transferred) {
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  DiskFileBlockCache cache(8, 8, 0, CachePath("remove_flush"), 1 << 20,
+                           fetcher);
+  std::vector<char> out;
+
+  TF_EXPECT_OK(ReadCache(&cache, "a", 0, 8, &out));
+  TF_EXPECT_OK(ReadCache(&cache, "b", 0, 8, &out));
+  EXPECT_EQ(cache.DiskCacheSize(), 16);
+
+  cache.RemoveFile("a");
+  EXPECT_EQ(cache.DiskCacheSize(), 8);
+
+  cache.Flush();
+  EXPECT_EQ(cache.DiskCacheSize(), 0);
+}
+
+TEST(DiskFileBlockCacheTest, CleansLeftoverBlocksOnConstruction) {
+  auto fetcher = [](const string& filename, size_t offset, size_t n,
+                    char* buffer, size_t* bytes_transferred) {
+    memset(buffer, 'x', n);
+    *bytes_transferred = n;
+    return OkStatus();
+  };
+  const string cache_path = CachePath("leftover");
+  {
+    DiskFileBlockCache cache(8, 8, 0, cache_path, 1 << 20, fetcher);
+    std::vector<char> out;
+    TF_EXPECT_OK(ReadCache(&cache, "file", 0, 8, &out));
+    EXPECT_EQ(cache.DiskCacheSize(), 8);
+  }
+  // A new process cannot validate the leftover blocks, so they are deleted.
+  DiskFileBlockCache cache(8, 8, 0, cache_path, 1 << 20, fetcher);
+  EXPECT_EQ(cache.DiskCacheSize(), 0);
+  std::vector<string> children;
+  TF_EXPECT_OK(Env::Default()->GetChildren(cache_path, &children));
+  EXPECT_TRUE(children.empty());
+}
+
+}  // namespace
+}  // namespace tsl
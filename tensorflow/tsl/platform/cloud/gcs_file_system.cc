@@ -40,6 +40,7 @@ limitations under the License.
 #include "json/json.h"
 #include "tensorflow/tsl/lib/gtl/map_util.h"
 #include "tensorflow/tsl/platform/cloud/curl_http_request.h"
+#include "tensorflow/tsl/platform/cloud/disk_file_block_cache.h"
 #include "tensorflow/tsl/platform/cloud/file_block_cache.h"
 #include "tensorflow/tsl/platform/cloud/google_auth_provider.h"
 #include "tensorflow/tsl/platform/cloud/ram_file_block_cache.h"
@@ -123,6 +124,16 @@ constexpr char kWriteRequestTimeout[] = "GCS_WRITE_REQUEST_TIMEOUT_SECS";
 // The environment variable to configure an additional header to send with
 // all requests to GCS (format HEADERNAME:HEADERCONTENT)
 constexpr char kAdditionalRequestHeader[] = "GCS_ADDITIONAL_REQUEST_HEADER";
+// The environment variable that names a local directory (e.g. on local SSD)
+// used as a second block cache tier: blocks fetched from GCS are also written
+// there, bounded in size, so blocks evicted from the RAM cache can be reloaded
+// from local disk instead of being refetched. Empty or unset disables the
+// disk tier.
+constexpr char kDiskCachePath[] = "GCS_DISK_CACHE_PATH";
+// The environment variable that overrides the maximum size of the disk cache
+// tier. Specified in MB.
+constexpr char kDiskCacheMaxSize[] = "GCS_DISK_CACHE_MAX_SIZE_MB";
+constexpr size_t kDefaultDiskCacheMaxSize = 16384LL * 1024LL * 1024LL;
 // The environment variable to configure the throttle (format: <int64_t>)
 constexpr char kThrottleRate[] = "GCS_THROTTLE_TOKEN_RATE";
 // The environment variable to configure the token bucket size (format:
@@ -1032,13 +1043,30 @@ void GcsFileSystem::ResetFileBlockCache(size_t block_size_bytes,
 // A helper function to build a FileBlockCache for GcsFileSystem.
 std::unique_ptr<FileBlockCache> GcsFileSystem::MakeFileBlockCache(
     size_t block_size, size_t max_bytes, uint64 max_staleness) {
-  std::unique_ptr<FileBlockCache> file_block_cache(new RamFileBlockCache(
-      block_size, max_bytes, max_staleness,
+  FileBlockCache::BlockFetcher fetcher =
       [this](const string& filename, size_t offset, size_t n, char* buffer,
              size_t* bytes_transferred) {
         return LoadBufferFromGCS(filename, offset, n, buffer,
                                  bytes_transferred);
-      }));
+      };
+  std::unique_ptr<FileBlockCache> file_block_cache;
+  StringPiece disk_cache_path;
+  if (GetEnvVar(kDiskCachePath, StringPieceIdentity, &disk_cache_path) &&
+      !disk_cache_path.empty()) {
+    size_t disk_max_bytes = kDefaultDiskCacheMaxSize;
+    uint64 value;
+    if (GetEnvVar(kDiskCacheMaxSize, strings::safe_strtou64, &value)) {
+      disk_max_bytes = value * 1024 * 1024;
+    }
+    VLOG(1) << "GCS disk cache tier at " << disk_cache_path
+            << " ; max size = " << disk_max_bytes;
+    file_block_cache.reset(new DiskFileBlockCache(
+        block_size, max_bytes, max_staleness, string(disk_cache_path),
+        disk_max_bytes, std::move(fetcher)));
+  } else {
+    file_block_cache.reset(new RamFileBlockCache(
+        block_size, max_bytes, max_staleness, std::move(fetcher)));
+  }
 
   // Check if cache is enabled here to avoid unnecessary mutex contention.
   cache_enabled_ = file_block_cache->IsCacheEnabled();
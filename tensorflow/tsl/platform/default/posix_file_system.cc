@@ -22,18 +22,32 @@ limitations under the License.
 
 #if defined(__linux__)
 #include <sys/sendfile.h>
+#include <sys/syscall.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+#define TF_PLATFORM_USE_IO_URING 1
 #endif
+#endif
+#include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "tensorflow/tsl/platform/default/posix_file_system.h"
 #include "tensorflow/tsl/platform/env.h"
 #include "tensorflow/tsl/platform/errors.h"
 #include "tensorflow/tsl/platform/file_system_helper.h"
 #include "tensorflow/tsl/platform/logging.h"
+#include "tensorflow/tsl/platform/mutex.h"
 #include "tensorflow/tsl/platform/status.h"
 #include "tensorflow/tsl/platform/strcat.h"
 #include "tensorflow/tsl/protobuf/error_codes.pb.h"
@@ -45,6 +59,252 @@ using ::tsl::errors::IOError;
 // 128KB of copy buffer
 constexpr size_t kPosixCopyFileBufferSize = 128 * 1024;
 
+#if defined(TF_PLATFORM_USE_IO_URING)
+
+// Reads issued through io_uring are capped to this many bytes per submission;
+// short reads are resubmitted for the remainder. Matches the chunking used by
+// the synchronous pread() path.
+constexpr size_t kIoUringMaxReadLength = INT32_MAX;
+
+// Process-wide io_uring submission/completion context shared by all
+// PosixRandomAccessFile instances. Enabled by setting the environment
+// variable TF_IO_URING_QUEUE_DEPTH to a positive queue depth; disabled by
+// default because sandboxed environments commonly reject the io_uring
+// syscalls. Completions are reaped by a dedicated thread which invokes the
+// caller-provided callbacks.
+class IoUringContext {
+ public:
+  // Returns the shared context, or nullptr if io_uring is disabled or
+  // unavailable on this kernel.
+  static IoUringContext* Get() {
+    static IoUringContext* context = []() -> IoUringContext* {
+      const char* env = getenv("TF_IO_URING_QUEUE_DEPTH");
+      if (env == nullptr) return nullptr;
+      char* end = nullptr;
+      long depth = strtol(env, &end, 10);  // NOLINT(runtime/int)
+      if (end == env || depth <= 0) return nullptr;
+      depth = std::min<long>(depth, 4096);  // NOLINT(runtime/int)
+      auto* context = new IoUringContext();
+      if (!context->Init(static_cast<unsigned>(depth))) {
+        delete context;
+        return nullptr;
+      }
+      return context;
+    }();
+    return context;
+  }
+
+  // Submits an asynchronous read of `n` bytes at `offset`. Returns false,
+  // leaving `done` untouched, if the submission queue is full; the caller
+  // should then fall back to a synchronous read.
+  bool Read(int fd, const string& filename, uint64 offset, size_t n,
+            char* scratch, std::function<void(Status, StringPiece)>* done) {
+    Request* req = new Request;
+    req->fd = fd;
+    req->filename = filename;
+    req->scratch = scratch;
+    req->n = n;
+    req->bytes_read = 0;
+    req->offset = offset;
+    req->done = std::move(*done);
+    if (!Submit(req)) {
+      *done = std::move(req->done);
+      delete req;
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  // In-flight read tracked from submission through completion. Owned by the
+  // context until the callback is invoked.
+  struct Request {
+    int fd;
+    string filename;
+    char* scratch;
+    size_t n;           // Total bytes requested.
+    size_t bytes_read;  // Bytes completed so far.
+    uint64 offset;      // File offset of the next submission.
+    struct iovec iov;
+    std::function<void(Status, StringPiece)> done;
+  };
+
+  IoUringContext() = default;
+
+  bool Init(unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring_fd_ < 0) {
+      LOG(WARNING) << "io_uring_setup() failed, falling back to synchronous "
+                      "reads: "
+                   << strerror(errno);
+      return false;
+    }
+    const size_t sq_ring_size =
+        params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    void* sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_,
+                         IORING_OFF_SQ_RING);
+    const size_t cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    void* cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd_,
+                         IORING_OFF_CQ_RING);
+    void* sqes = mmap(nullptr, params.sq_entries * sizeof(struct io_uring_sqe),
+                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_SQES);
+    if (sq_ring == MAP_FAILED || cq_ring == MAP_FAILED || sqes == MAP_FAILED) {
+      LOG(WARNING) << "mmap() of io_uring rings failed, falling back to "
+                      "synchronous reads: "
+                   << strerror(errno);
+      if (sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+      if (cq_ring != MAP_FAILED) munmap(cq_ring, cq_ring_size);
+      if (sqes != MAP_FAILED) {
+        munmap(sqes, params.sq_entries * sizeof(struct io_uring_sqe));
+      }
+      close(ring_fd_);
+      return false;
+    }
+    char* sq = static_cast<char*>(sq_ring);
+    sq_head_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(sq + params.sq_off.head);
+    sq_tail_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    sq_entries_ = params.sq_entries;
+    char* cq = static_cast<char*>(cq_ring);
+    cq_head_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(cq + params.cq_off.head);
+    cq_tail_ =
+        reinterpret_cast<std::atomic<uint32_t>*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+    sq_tail_local_ = sq_tail_->load(std::memory_order_relaxed);
+    std::thread([this]() { CompletionLoop(); }).detach();
+    return true;
+  }
+
+  // Queues (the next chunk of) `req` and tells the kernel about it. Returns
+  // false if the submission queue is full.
+  bool Submit(Request* req) {
+    req->iov.iov_base = req->scratch + req->bytes_read;
+    req->iov.iov_len =
+        std::min(req->n - req->bytes_read, kIoUringMaxReadLength);
+    mutex_lock l(submit_mu_);
+    const uint32_t head = sq_head_->load(std::memory_order_acquire);
+    if (sq_tail_local_ - head == sq_entries_) {
+      return false;  // Submission queue is full.
+    }
+    const uint32_t index = sq_tail_local_ & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = req->fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&req->iov);
+    sqe->len = 1;
+    sqe->off = req->offset;
+    sqe->user_data = reinterpret_cast<uint64_t>(req);
+    sq_array_[index] = index;
+    ++sq_tail_local_;
+    sq_tail_->store(sq_tail_local_, std::memory_order_release);
+    if (syscall(__NR_io_uring_enter, ring_fd_, 1, 0, 0, nullptr, 0) < 0) {
+      LOG(ERROR) << "io_uring_enter() failed: " << strerror(errno);
+    }
+    return true;
+  }
+
+  void CompletionLoop() {
+    uint32_t head = cq_head_->load(std::memory_order_relaxed);
+    while (true) {
+      const uint32_t tail = cq_tail_->load(std::memory_order_acquire);
+      if (head == tail) {
+        if (syscall(__NR_io_uring_enter, ring_fd_, 0, 1,
+                    IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+            errno != EINTR) {
+          LOG(ERROR) << "io_uring_enter() failed: " << strerror(errno);
+        }
+        continue;
+      }
+      while (head != tail) {
+        const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+        Request* req = reinterpret_cast<Request*>(cqe.user_data);
+        const int32_t res = cqe.res;
+        ++head;
+        cq_head_->store(head, std::memory_order_release);
+        Complete(req, res);
+      }
+    }
+  }
+
+  // Handles one completion. Short reads and EINTR/EAGAIN are resubmitted.
+  void Complete(Request* req, int32_t res) {
+    if (res > 0) {
+      req->bytes_read += res;
+      req->offset += res;
+      if (req->bytes_read < req->n) {
+        Resubmit(req);
+        return;
+      }
+      Finish(req, OkStatus());
+    } else if (res == 0) {
+      Finish(req,
+             Status(error::OUT_OF_RANGE, "Read less bytes than requested"));
+    } else if (res == -EINTR || res == -EAGAIN) {
+      Resubmit(req);
+    } else {
+      Finish(req, IOError(req->filename, -res));
+    }
+  }
+
+  void Resubmit(Request* req) {
+    if (Submit(req)) return;
+    // The submission queue is full; finish the remainder with pread() rather
+    // than dropping the request.
+    Status s;
+    while (req->bytes_read < req->n && s.ok()) {
+      const size_t len =
+          std::min(req->n - req->bytes_read, kIoUringMaxReadLength);
+      ssize_t r = pread(req->fd, req->scratch + req->bytes_read, len,
+                        static_cast<off_t>(req->offset));
+      if (r > 0) {
+        req->bytes_read += r;
+        req->offset += r;
+      } else if (r == 0) {
+        s = Status(error::OUT_OF_RANGE, "Read less bytes than requested");
+      } else if (errno == EINTR || errno == EAGAIN) {
+        // Retry
+      } else {
+        s = IOError(req->filename, errno);
+      }
+    }
+    Finish(req, s);
+  }
+
+  void Finish(Request* req, Status s) {
+    req->done(std::move(s), StringPiece(req->scratch, req->bytes_read));
+    delete req;
+  }
+
+  int ring_fd_ = -1;
+  unsigned sq_entries_ = 0;
+  uint32_t sq_mask_ = 0;
+  uint32_t cq_mask_ = 0;
+  std::atomic<uint32_t>* sq_head_ = nullptr;
+  std::atomic<uint32_t>* sq_tail_ = nullptr;
+  uint32_t* sq_array_ = nullptr;
+  struct io_uring_sqe* sqes_ = nullptr;
+  std::atomic<uint32_t>* cq_head_ = nullptr;
+  std::atomic<uint32_t>* cq_tail_ = nullptr;
+  struct io_uring_cqe* cqes_ = nullptr;
+  mutex submit_mu_;
+  uint32_t sq_tail_local_ TF_GUARDED_BY(submit_mu_) = 0;
+};
+
+#endif  // defined(TF_PLATFORM_USE_IO_URING)
+
 // pread() based random-access
 class PosixRandomAccessFile : public RandomAccessFile {
  private:
@@ -123,6 +383,18 @@ class PosixRandomAccessFile : public RandomAccessFile {
     return s;
   }
 #endif
+
+  void ReadAsync(uint64 offset, size_t n, char* scratch,
+                 std::function<void(Status, StringPiece)> done) const override {
+#if defined(TF_PLATFORM_USE_IO_URING)
+    IoUringContext* ring = IoUringContext::Get();
+    if (n > 0 && ring != nullptr &&
+        ring->Read(fd_, filename_, offset, n, scratch, &done)) {
+      return;
+    }
+#endif
+    RandomAccessFile::ReadAsync(offset, n, scratch, std::move(done));
+  }
 };
 
 class PosixWritableFile : public WritableFile {
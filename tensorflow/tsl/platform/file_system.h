@@ -774,6 +774,26 @@ class RandomAccessFile {
   }
 #endif
 
+  /// \brief Asynchronously reads up to `n` bytes from the file starting at
+  /// `offset`, invoking `done` with the result when the read completes.
+  ///
+  /// Has the same semantics as `Read`, but allows callers to keep many reads
+  /// in flight without dedicating a blocked thread to each of them. `scratch`
+  /// must remain live until `done` is invoked. `done` may be invoked on an
+  /// internal I/O thread and must not block.
+  ///
+  /// The default implementation performs a synchronous `Read` before invoking
+  /// `done`; file systems with native asynchronous I/O override it.
+  ///
+  /// Safe for concurrent use by multiple threads.
+  virtual void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(tsl::Status, StringPiece)> done) const {
+    StringPiece result;
+    tsl::Status status = Read(offset, n, &result, scratch);
+    done(status, result);
+  }
+
  private:
   TF_DISALLOW_COPY_AND_ASSIGN(RandomAccessFile);
 };
@@ -17,6 +17,12 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "third_party/eigen3/unsupported/Eigen/CXX11/Tensor"
 #include "tensorflow/tsl/platform/blocking_counter.h"
@@ -32,12 +38,44 @@ namespace tsl {
 
 namespace thread {
 
+namespace {
+
+// Scheduling statistics shared between a ThreadPool and the EigenEnvironment
+// copy held by its Eigen pool, and tracked by a global registry of weak
+// references so that AllPoolStats() can enumerate live pools without
+// extending their lifetime. Counters use relaxed atomics; stats are
+// monitoring data and need no ordering with respect to the tasks themselves.
+struct PoolStatsCell {
+  explicit PoolStatsCell(std::string name) : name(std::move(name)) {}
+
+  const std::string name;
+  std::atomic<int64_t> tasks_scheduled{0};
+  std::atomic<int64_t> tasks_started{0};
+  std::atomic<int64_t> queue_depth{0};
+  std::atomic<int64_t> max_queue_depth{0};
+  std::atomic<int64_t> queue_time_ns{0};
+  std::atomic<int64_t> run_time_ns{0};
+};
+
+mutex* GetPoolStatsRegistryLock() {
+  static mutex* mu = new mutex;
+  return mu;
+}
+
+std::vector<std::weak_ptr<PoolStatsCell>>* GetPoolStatsRegistry() {
+  static auto* registry = new std::vector<std::weak_ptr<PoolStatsCell>>;
+  return registry;
+}
+
+}  // namespace
+
 struct EigenEnvironment {
   typedef Thread EnvThread;
   struct TaskImpl {
     std::function<void()> f;
     Context context;
     uint64 trace_id;
+    uint64 schedule_time_ns;  // 0 unless stats collection is enabled.
   };
   struct Task {
     std::unique_ptr<TaskImpl> f;
@@ -46,10 +84,16 @@ struct EigenEnvironment {
   Env* const env_;
   const ThreadOptions thread_options_;
   const string name_;
+  // Scheduling statistics for the pool; null unless collection is enabled.
+  const std::shared_ptr<PoolStatsCell> stats_;
 
   EigenEnvironment(Env* env, const ThreadOptions& thread_options,
-                   const string& name)
-      : env_(env), thread_options_(thread_options), name_(name) {}
+                   const string& name,
+                   std::shared_ptr<PoolStatsCell> stats = nullptr)
+      : env_(env),
+        thread_options_(thread_options),
+        name_(name),
+        stats_(std::move(stats)) {}
 
   EnvThread* CreateThread(std::function<void()> f) {
     return env_->StartThread(thread_options_, name_, [=]() {
@@ -70,11 +114,23 @@ struct EigenEnvironment {
       id = tracing::GetUniqueArg();
       tracing::RecordEvent(tracing::EventCategory::kScheduleClosure, id);
     }
+    uint64 schedule_time_ns = 0;
+    if (TF_PREDICT_FALSE(stats_ != nullptr)) {
+      schedule_time_ns = EnvTime::NowNanos();
+      stats_->tasks_scheduled.fetch_add(1, std::memory_order_relaxed);
+      int64_t depth =
+          stats_->queue_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+      int64_t max = stats_->max_queue_depth.load(std::memory_order_relaxed);
+      while (depth > max && !stats_->max_queue_depth.compare_exchange_weak(
+                                max, depth, std::memory_order_relaxed)) {
+      }
+    }
     return Task{
         std::unique_ptr<TaskImpl>(new TaskImpl{
             std::move(f),
             Context(ContextKind::kThread),
             id,
+            schedule_time_ns,
         }),
     };
   }
@@ -83,7 +139,18 @@ struct EigenEnvironment {
     WithContext wc(t.f->context);
     tracing::ScopedRegion region(tracing::EventCategory::kRunClosure,
                                  t.f->trace_id);
-    t.f->f();
+    if (TF_PREDICT_FALSE(t.f->schedule_time_ns != 0)) {
+      const uint64 start_time_ns = EnvTime::NowNanos();
+      stats_->tasks_started.fetch_add(1, std::memory_order_relaxed);
+      stats_->queue_depth.fetch_sub(1, std::memory_order_relaxed);
+      stats_->queue_time_ns.fetch_add(start_time_ns - t.f->schedule_time_ns,
+                                      std::memory_order_relaxed);
+      t.f->f();
+      stats_->run_time_ns.fetch_add(EnvTime::NowNanos() - start_time_ns,
+                                    std::memory_order_relaxed);
+    } else {
+      t.f->f();
+    }
   }
 };
 
@@ -94,13 +161,55 @@ ThreadPool::ThreadPool(Env* env, const ThreadOptions& thread_options,
                        const string& name, int num_threads)
     : ThreadPool(env, thread_options, name, num_threads, true, nullptr) {}
 
+bool ThreadPool::StatsEnabled() {
+  static const bool enabled = [] {
+    const char* val = std::getenv("TF_THREADPOOL_STATS");
+    return val != nullptr && val[0] != '\0' && val[0] != '0';
+  }();
+  return enabled;
+}
+
+std::vector<std::pair<std::string, ThreadPool::Stats>>
+ThreadPool::AllPoolStats() {
+  std::vector<std::pair<std::string, Stats>> result;
+  mutex_lock l(*GetPoolStatsRegistryLock());
+  auto* registry = GetPoolStatsRegistry();
+  auto it = registry->begin();
+  while (it != registry->end()) {
+    std::shared_ptr<PoolStatsCell> cell = it->lock();
+    if (cell == nullptr) {
+      // The pool was destroyed; drop its registry entry.
+      it = registry->erase(it);
+      continue;
+    }
+    Stats stats;
+    stats.tasks_scheduled =
+        cell->tasks_scheduled.load(std::memory_order_relaxed);
+    stats.tasks_started = cell->tasks_started.load(std::memory_order_relaxed);
+    stats.queue_depth = cell->queue_depth.load(std::memory_order_relaxed);
+    stats.max_queue_depth =
+        cell->max_queue_depth.load(std::memory_order_relaxed);
+    stats.queue_time_ns = cell->queue_time_ns.load(std::memory_order_relaxed);
+    stats.run_time_ns = cell->run_time_ns.load(std::memory_order_relaxed);
+    result.emplace_back(cell->name, stats);
+    ++it;
+  }
+  return result;
+}
+
 ThreadPool::ThreadPool(Env* env, const ThreadOptions& thread_options,
                        const string& name, int num_threads,
                        bool low_latency_hint, Eigen::Allocator* allocator) {
   CHECK_GE(num_threads, 1);
+  std::shared_ptr<PoolStatsCell> stats;
+  if (TF_PREDICT_FALSE(StatsEnabled())) {
+    stats = std::make_shared<PoolStatsCell>(name);
+    mutex_lock l(*GetPoolStatsRegistryLock());
+    GetPoolStatsRegistry()->push_back(stats);
+  }
   eigen_threadpool_.reset(new Eigen::ThreadPoolTempl<EigenEnvironment>(
       num_threads, low_latency_hint,
-      EigenEnvironment(env, thread_options, "tf_" + name)));
+      EigenEnvironment(env, thread_options, "tf_" + name, std::move(stats))));
   underlying_threadpool_ = eigen_threadpool_.get();
   threadpool_device_.reset(new Eigen::ThreadPoolDevice(underlying_threadpool_,
                                                        num_threads, allocator));
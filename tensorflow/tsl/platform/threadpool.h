@@ -18,6 +18,9 @@ limitations under the License.
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "tensorflow/tsl/platform/env.h"
@@ -69,6 +72,28 @@ class ThreadPool {
     kFixedBlockSize
   };
 
+  // Point-in-time scheduling statistics for a pool. All counters are
+  // cumulative since pool construction, except queue_depth which is
+  // instantaneous. Only collected when StatsEnabled() is true.
+  struct Stats {
+    int64_t tasks_scheduled = 0;  // Tasks handed to the pool.
+    int64_t tasks_started = 0;    // Tasks that began running on a worker.
+    int64_t queue_depth = 0;      // Tasks scheduled but not yet started.
+    int64_t max_queue_depth = 0;  // High-water mark of queue_depth.
+    int64_t queue_time_ns = 0;    // Total schedule-to-start latency.
+    int64_t run_time_ns = 0;      // Total task execution time.
+  };
+
+  // Whether per-pool scheduling statistics are being collected, i.e. the
+  // TF_THREADPOOL_STATS environment variable was set to a non-zero value when
+  // the process started. Collection adds a couple of timestamp reads and a
+  // few relaxed atomic updates to every task, so it is off by default.
+  static bool StatsEnabled();
+
+  // Snapshots the scheduling statistics of every live pool that owns its
+  // threads, as (pool name, stats) pairs. Empty unless StatsEnabled().
+  static std::vector<std::pair<std::string, Stats>> AllPoolStats();
+
   // Contains additional parameters for either the Adaptive or the Fixed Block
   // Size scheduling strategy.
   class SchedulingParams {